@@ -0,0 +1,1225 @@
+
+#ifndef LS_MATH_ACCURACY_H
+#define LS_MATH_ACCURACY_H
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86, LS_ARM_NEON
+
+#include "lightsky/math/vec_utils.h"
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Accuracy Tiers
+
+    The functions in "scalar_utils.h" and "vec_utils.h" use whichever
+    approximation is fastest on the current platform, so their accuracy
+    differs between x86, ARM, and the generic implementation. The namespaces
+    below provide the same functions with a documented error bound which
+    holds on every platform. Code in a hot path can opt into the fastest
+    tier while precision-sensitive code gets a guaranteed bound:
+
+        const vec4f s = ls::math::fast::sin(angles);
+        const float e = ls::math::precise::exp(x);
+
+    Maximum error of single-precision scalar & vec4 functions, in ULP from
+    the correctly-rounded result. Most fast-tier approximations have no
+    meaningful ULP bound, so their error is listed as an absolute or relative
+    difference instead.
+
+    Function     | precise | balanced | fast
+    -------------+---------+----------+---------------------------
+    sin, cos     | 1 ULP   | 2 ULP    | 2e-3 absolute
+    tan          | 1 ULP   | 4 ULP    | 2% relative, |x| < 1.5
+    asin, acos   | 1 ULP   | 3 ULP    | 0.011 radians absolute
+    atan, atan2  | 1 ULP   | 4 ULP    | 0.011 radians absolute
+    exp, exp2    | 1 ULP   | 2 ULP    | 6% relative
+    log, log2    | 1 ULP   | 2 ULP    | 1e-3 absolute
+    pow          | 1 ULP   | 1 ULP    | 6% relative, x > 0
+    sqrt         | 0 ULP   | 0 ULP    | 0 ULP
+    inversesqrt  | 1 ULP   | 1 ULP    | 6 ULP
+    rcp          | 0 ULP   | 0 ULP    | 4e-4 relative
+
+    The balanced sin & cos bounds hold for |x| <= pi. Their range reduction
+    loses precision as |x| grows, so up to |x| < 8192 they are only accurate
+    to within 1.2e-7 absolute. Results from the fast tier differ between
+    platforms, but stay within the bounds listed.
+-----------------------------------------------------------------------------*/
+
+
+
+/*-----------------------------------------------------------------------------
+    Fast Tier
+
+    Functions in "ls::math::fast" favor throughput over accuracy. Most use
+    low-order polynomial or parabolic approximations, or hardware estimates
+    refined by a single Newton-Raphson step, and are suitable for graphics,
+    audio, and other code which tolerates a small absolute error.
+-----------------------------------------------------------------------------*/
+namespace fast
+{
+
+/**
+ * @brief sin
+ * Calculate the sine of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The sine of x.
+ */
+template <typename N>
+inline N sin(N x) noexcept;
+
+/**
+ * @brief sin
+ * Calculate the sine of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The sine of x.
+ */
+template <typename N>
+inline vec4_t<N> sin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief cos
+ * Calculate the cosine of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The cosine of x.
+ */
+template <typename N>
+inline N cos(N x) noexcept;
+
+/**
+ * @brief cos
+ * Calculate the cosine of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The cosine of x.
+ */
+template <typename N>
+inline vec4_t<N> cos(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief tan
+ * Calculate the tangent of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The tangent of x.
+ */
+template <typename N>
+inline N tan(N x) noexcept;
+
+/**
+ * @brief tan
+ * Calculate the tangent of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The tangent of x.
+ */
+template <typename N>
+inline vec4_t<N> tan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief asin
+ * Calculate the arc-sine of a number.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-sine of x, in radians.
+ */
+template <typename N>
+inline N asin(N x) noexcept;
+
+/**
+ * @brief asin
+ * Calculate the arc-sine of a number, per vector component.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-sine of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> asin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief acos
+ * Calculate the arc-cosine of a number.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-cosine of x, in radians.
+ */
+template <typename N>
+inline N acos(N x) noexcept;
+
+/**
+ * @brief acos
+ * Calculate the arc-cosine of a number, per vector component.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-cosine of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> acos(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan
+ * Calculate the arc-tangent of a number.
+ *
+ * @param x
+ * The value of y/x.
+ *
+ * @return The arc-tangent of x, in radians.
+ */
+template <typename N>
+inline N atan(N x) noexcept;
+
+/**
+ * @brief atan
+ * Calculate the arc-tangent of a number, per vector component.
+ *
+ * @param x
+ * The value of y/x.
+ *
+ * @return The arc-tangent of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> atan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan2
+ * Calculate the arc-tangent of two cartesian lengths.
+ *
+ * @param y
+ * The length of the y-axis.
+ *
+ * @param x
+ * The length of the x-axis.
+ *
+ * @return The angle of the point (x, y), in radians.
+ */
+template <typename N>
+inline N atan2(N y, N x) noexcept;
+
+/**
+ * @brief atan2
+ * Calculate the arc-tangent of two cartesian lengths, per vector component.
+ *
+ * @param y
+ * The length of the y-axis.
+ *
+ * @param x
+ * The length of the x-axis.
+ *
+ * @return The angle of the point (x, y), in radians.
+ */
+template <typename N>
+inline vec4_t<N> atan2(const vec4_t<N>& y, const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief exp
+ * Calculate e, raised to a power.
+ *
+ * @param x
+ * The power to which e will be raised.
+ *
+ * @return e^x
+ */
+template <typename N>
+inline N exp(N x) noexcept;
+
+/**
+ * @brief exp
+ * Calculate e, raised to a power, per vector component.
+ *
+ * @param x
+ * The power to which e will be raised.
+ *
+ * @return e^x
+ */
+template <typename N>
+inline vec4_t<N> exp(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief exp2
+ * Calculate 2, raised to a power.
+ *
+ * @param x
+ * The power to which 2 will be raised.
+ *
+ * @return 2^x
+ */
+template <typename N>
+inline N exp2(N x) noexcept;
+
+/**
+ * @brief exp2
+ * Calculate 2, raised to a power, per vector component.
+ *
+ * @param x
+ * The power to which 2 will be raised.
+ *
+ * @return 2^x
+ */
+template <typename N>
+inline vec4_t<N> exp2(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief log
+ * Calculate the natural logarithm of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return ln(x)
+ */
+template <typename N>
+inline N log(N x) noexcept;
+
+/**
+ * @brief log
+ * Calculate the natural logarithm of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return ln(x)
+ */
+template <typename N>
+inline vec4_t<N> log(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief log2
+ * Calculate the base-2 logarithm of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return log2(x)
+ */
+template <typename N>
+inline N log2(N x) noexcept;
+
+/**
+ * @brief log2
+ * Calculate the base-2 logarithm of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return log2(x)
+ */
+template <typename N>
+inline vec4_t<N> log2(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief pow
+ * Calculate a number raised to a power.
+ *
+ * @param x
+ * The base.
+ *
+ * @param y
+ * The exponent.
+ *
+ * @return x^y
+ */
+template <typename N>
+inline N pow(N x, N y) noexcept;
+
+/**
+ * @brief pow
+ * Calculate a number raised to a power, per vector component.
+ *
+ * @param x
+ * The base.
+ *
+ * @param y
+ * The exponent.
+ *
+ * @return x^y
+ */
+template <typename N>
+inline vec4_t<N> pow(const vec4_t<N>& x, const vec4_t<N>& y) noexcept;
+
+/**
+ * @brief sqrt
+ * Calculate the square root of a number.
+ *
+ * @param x
+ * A non-negative number.
+ *
+ * @return The square root of x.
+ */
+template <typename N>
+inline N sqrt(N x) noexcept;
+
+/**
+ * @brief sqrt
+ * Calculate the square root of a number, per vector component.
+ *
+ * @param x
+ * A non-negative number.
+ *
+ * @return The square root of x.
+ */
+template <typename N>
+inline vec4_t<N> sqrt(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief inversesqrt
+ * Calculate the reciprocal square root of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return 1 / sqrt(x)
+ */
+template <typename N>
+inline N inversesqrt(N x) noexcept;
+
+/**
+ * @brief inversesqrt
+ * Calculate the reciprocal square root of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return 1 / sqrt(x)
+ */
+template <typename N>
+inline vec4_t<N> inversesqrt(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief rcp
+ * Calculate the reciprocal of a number.
+ *
+ * @param x
+ * A non-zero number.
+ *
+ * @return 1 / x
+ */
+template <typename N>
+inline N rcp(N x) noexcept;
+
+/**
+ * @brief rcp
+ * Calculate the reciprocal of a number, per vector component.
+ *
+ * @param x
+ * A non-zero number.
+ *
+ * @return 1 / x
+ */
+template <typename N>
+inline vec4_t<N> rcp(const vec4_t<N>& x) noexcept;
+
+} // end fast namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Balanced Tier
+
+    Functions in "ls::math::balanced" use minimax polynomials with full
+    range reduction. They are accurate to within a few ULP while still
+    evaluating all four components of a vector in parallel with SIMD
+    instructions.
+-----------------------------------------------------------------------------*/
+namespace balanced
+{
+
+/**
+ * @brief sin
+ * Calculate the sine of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The sine of x.
+ */
+template <typename N>
+inline N sin(N x) noexcept;
+
+/**
+ * @brief sin
+ * Calculate the sine of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The sine of x.
+ */
+template <typename N>
+inline vec4_t<N> sin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief cos
+ * Calculate the cosine of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The cosine of x.
+ */
+template <typename N>
+inline N cos(N x) noexcept;
+
+/**
+ * @brief cos
+ * Calculate the cosine of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The cosine of x.
+ */
+template <typename N>
+inline vec4_t<N> cos(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief tan
+ * Calculate the tangent of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The tangent of x.
+ */
+template <typename N>
+inline N tan(N x) noexcept;
+
+/**
+ * @brief tan
+ * Calculate the tangent of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The tangent of x.
+ */
+template <typename N>
+inline vec4_t<N> tan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief asin
+ * Calculate the arc-sine of a number.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-sine of x, in radians.
+ */
+template <typename N>
+inline N asin(N x) noexcept;
+
+/**
+ * @brief asin
+ * Calculate the arc-sine of a number, per vector component.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-sine of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> asin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief acos
+ * Calculate the arc-cosine of a number.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-cosine of x, in radians.
+ */
+template <typename N>
+inline N acos(N x) noexcept;
+
+/**
+ * @brief acos
+ * Calculate the arc-cosine of a number, per vector component.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-cosine of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> acos(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan
+ * Calculate the arc-tangent of a number.
+ *
+ * @param x
+ * The value of y/x.
+ *
+ * @return The arc-tangent of x, in radians.
+ */
+template <typename N>
+inline N atan(N x) noexcept;
+
+/**
+ * @brief atan
+ * Calculate the arc-tangent of a number, per vector component.
+ *
+ * @param x
+ * The value of y/x.
+ *
+ * @return The arc-tangent of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> atan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan2
+ * Calculate the arc-tangent of two cartesian lengths.
+ *
+ * @param y
+ * The length of the y-axis.
+ *
+ * @param x
+ * The length of the x-axis.
+ *
+ * @return The angle of the point (x, y), in radians.
+ */
+template <typename N>
+inline N atan2(N y, N x) noexcept;
+
+/**
+ * @brief atan2
+ * Calculate the arc-tangent of two cartesian lengths, per vector component.
+ *
+ * @param y
+ * The length of the y-axis.
+ *
+ * @param x
+ * The length of the x-axis.
+ *
+ * @return The angle of the point (x, y), in radians.
+ */
+template <typename N>
+inline vec4_t<N> atan2(const vec4_t<N>& y, const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief exp
+ * Calculate e, raised to a power.
+ *
+ * @param x
+ * The power to which e will be raised.
+ *
+ * @return e^x
+ */
+template <typename N>
+inline N exp(N x) noexcept;
+
+/**
+ * @brief exp
+ * Calculate e, raised to a power, per vector component.
+ *
+ * @param x
+ * The power to which e will be raised.
+ *
+ * @return e^x
+ */
+template <typename N>
+inline vec4_t<N> exp(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief exp2
+ * Calculate 2, raised to a power.
+ *
+ * @param x
+ * The power to which 2 will be raised.
+ *
+ * @return 2^x
+ */
+template <typename N>
+inline N exp2(N x) noexcept;
+
+/**
+ * @brief exp2
+ * Calculate 2, raised to a power, per vector component.
+ *
+ * @param x
+ * The power to which 2 will be raised.
+ *
+ * @return 2^x
+ */
+template <typename N>
+inline vec4_t<N> exp2(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief log
+ * Calculate the natural logarithm of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return ln(x)
+ */
+template <typename N>
+inline N log(N x) noexcept;
+
+/**
+ * @brief log
+ * Calculate the natural logarithm of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return ln(x)
+ */
+template <typename N>
+inline vec4_t<N> log(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief log2
+ * Calculate the base-2 logarithm of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return log2(x)
+ */
+template <typename N>
+inline N log2(N x) noexcept;
+
+/**
+ * @brief log2
+ * Calculate the base-2 logarithm of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return log2(x)
+ */
+template <typename N>
+inline vec4_t<N> log2(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief pow
+ * Calculate a number raised to a power.
+ *
+ * @param x
+ * The base.
+ *
+ * @param y
+ * The exponent.
+ *
+ * @return x^y
+ */
+template <typename N>
+inline N pow(N x, N y) noexcept;
+
+/**
+ * @brief pow
+ * Calculate a number raised to a power, per vector component.
+ *
+ * @param x
+ * The base.
+ *
+ * @param y
+ * The exponent.
+ *
+ * @return x^y
+ */
+template <typename N>
+inline vec4_t<N> pow(const vec4_t<N>& x, const vec4_t<N>& y) noexcept;
+
+/**
+ * @brief sqrt
+ * Calculate the square root of a number.
+ *
+ * @param x
+ * A non-negative number.
+ *
+ * @return The square root of x.
+ */
+template <typename N>
+inline N sqrt(N x) noexcept;
+
+/**
+ * @brief sqrt
+ * Calculate the square root of a number, per vector component.
+ *
+ * @param x
+ * A non-negative number.
+ *
+ * @return The square root of x.
+ */
+template <typename N>
+inline vec4_t<N> sqrt(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief inversesqrt
+ * Calculate the reciprocal square root of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return 1 / sqrt(x)
+ */
+template <typename N>
+inline N inversesqrt(N x) noexcept;
+
+/**
+ * @brief inversesqrt
+ * Calculate the reciprocal square root of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return 1 / sqrt(x)
+ */
+template <typename N>
+inline vec4_t<N> inversesqrt(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief rcp
+ * Calculate the reciprocal of a number.
+ *
+ * @param x
+ * A non-zero number.
+ *
+ * @return 1 / x
+ */
+template <typename N>
+inline N rcp(N x) noexcept;
+
+/**
+ * @brief rcp
+ * Calculate the reciprocal of a number, per vector component.
+ *
+ * @param x
+ * A non-zero number.
+ *
+ * @return 1 / x
+ */
+template <typename N>
+inline vec4_t<N> rcp(const vec4_t<N>& x) noexcept;
+
+} // end balanced namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Precise Tier
+
+    Functions in "ls::math::precise" forward to the standard library.
+    Single-precision inputs are evaluated in double-precision then rounded,
+    so results are correctly rounded in all but a vanishing number of cases.
+    This tier is the slowest, but is identical on every platform.
+-----------------------------------------------------------------------------*/
+namespace precise
+{
+
+/**
+ * @brief sin
+ * Calculate the sine of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The sine of x.
+ */
+template <typename N>
+inline N sin(N x) noexcept;
+
+/**
+ * @brief sin
+ * Calculate the sine of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The sine of x.
+ */
+template <typename N>
+inline vec4_t<N> sin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief cos
+ * Calculate the cosine of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The cosine of x.
+ */
+template <typename N>
+inline N cos(N x) noexcept;
+
+/**
+ * @brief cos
+ * Calculate the cosine of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The cosine of x.
+ */
+template <typename N>
+inline vec4_t<N> cos(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief tan
+ * Calculate the tangent of an angle.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The tangent of x.
+ */
+template <typename N>
+inline N tan(N x) noexcept;
+
+/**
+ * @brief tan
+ * Calculate the tangent of an angle, per vector component.
+ *
+ * @param x
+ * An angle, in radians.
+ *
+ * @return The tangent of x.
+ */
+template <typename N>
+inline vec4_t<N> tan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief asin
+ * Calculate the arc-sine of a number.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-sine of x, in radians.
+ */
+template <typename N>
+inline N asin(N x) noexcept;
+
+/**
+ * @brief asin
+ * Calculate the arc-sine of a number, per vector component.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-sine of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> asin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief acos
+ * Calculate the arc-cosine of a number.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-cosine of x, in radians.
+ */
+template <typename N>
+inline N acos(N x) noexcept;
+
+/**
+ * @brief acos
+ * Calculate the arc-cosine of a number, per vector component.
+ *
+ * @param x
+ * A number within the range [-1, 1].
+ *
+ * @return The arc-cosine of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> acos(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan
+ * Calculate the arc-tangent of a number.
+ *
+ * @param x
+ * The value of y/x.
+ *
+ * @return The arc-tangent of x, in radians.
+ */
+template <typename N>
+inline N atan(N x) noexcept;
+
+/**
+ * @brief atan
+ * Calculate the arc-tangent of a number, per vector component.
+ *
+ * @param x
+ * The value of y/x.
+ *
+ * @return The arc-tangent of x, in radians.
+ */
+template <typename N>
+inline vec4_t<N> atan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan2
+ * Calculate the arc-tangent of two cartesian lengths.
+ *
+ * @param y
+ * The length of the y-axis.
+ *
+ * @param x
+ * The length of the x-axis.
+ *
+ * @return The angle of the point (x, y), in radians.
+ */
+template <typename N>
+inline N atan2(N y, N x) noexcept;
+
+/**
+ * @brief atan2
+ * Calculate the arc-tangent of two cartesian lengths, per vector component.
+ *
+ * @param y
+ * The length of the y-axis.
+ *
+ * @param x
+ * The length of the x-axis.
+ *
+ * @return The angle of the point (x, y), in radians.
+ */
+template <typename N>
+inline vec4_t<N> atan2(const vec4_t<N>& y, const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief exp
+ * Calculate e, raised to a power.
+ *
+ * @param x
+ * The power to which e will be raised.
+ *
+ * @return e^x
+ */
+template <typename N>
+inline N exp(N x) noexcept;
+
+/**
+ * @brief exp
+ * Calculate e, raised to a power, per vector component.
+ *
+ * @param x
+ * The power to which e will be raised.
+ *
+ * @return e^x
+ */
+template <typename N>
+inline vec4_t<N> exp(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief exp2
+ * Calculate 2, raised to a power.
+ *
+ * @param x
+ * The power to which 2 will be raised.
+ *
+ * @return 2^x
+ */
+template <typename N>
+inline N exp2(N x) noexcept;
+
+/**
+ * @brief exp2
+ * Calculate 2, raised to a power, per vector component.
+ *
+ * @param x
+ * The power to which 2 will be raised.
+ *
+ * @return 2^x
+ */
+template <typename N>
+inline vec4_t<N> exp2(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief log
+ * Calculate the natural logarithm of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return ln(x)
+ */
+template <typename N>
+inline N log(N x) noexcept;
+
+/**
+ * @brief log
+ * Calculate the natural logarithm of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return ln(x)
+ */
+template <typename N>
+inline vec4_t<N> log(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief log2
+ * Calculate the base-2 logarithm of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return log2(x)
+ */
+template <typename N>
+inline N log2(N x) noexcept;
+
+/**
+ * @brief log2
+ * Calculate the base-2 logarithm of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return log2(x)
+ */
+template <typename N>
+inline vec4_t<N> log2(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief pow
+ * Calculate a number raised to a power.
+ *
+ * @param x
+ * The base.
+ *
+ * @param y
+ * The exponent.
+ *
+ * @return x^y
+ */
+template <typename N>
+inline N pow(N x, N y) noexcept;
+
+/**
+ * @brief pow
+ * Calculate a number raised to a power, per vector component.
+ *
+ * @param x
+ * The base.
+ *
+ * @param y
+ * The exponent.
+ *
+ * @return x^y
+ */
+template <typename N>
+inline vec4_t<N> pow(const vec4_t<N>& x, const vec4_t<N>& y) noexcept;
+
+/**
+ * @brief sqrt
+ * Calculate the square root of a number.
+ *
+ * @param x
+ * A non-negative number.
+ *
+ * @return The square root of x.
+ */
+template <typename N>
+inline N sqrt(N x) noexcept;
+
+/**
+ * @brief sqrt
+ * Calculate the square root of a number, per vector component.
+ *
+ * @param x
+ * A non-negative number.
+ *
+ * @return The square root of x.
+ */
+template <typename N>
+inline vec4_t<N> sqrt(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief inversesqrt
+ * Calculate the reciprocal square root of a number.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return 1 / sqrt(x)
+ */
+template <typename N>
+inline N inversesqrt(N x) noexcept;
+
+/**
+ * @brief inversesqrt
+ * Calculate the reciprocal square root of a number, per vector component.
+ *
+ * @param x
+ * A positive number.
+ *
+ * @return 1 / sqrt(x)
+ */
+template <typename N>
+inline vec4_t<N> inversesqrt(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief rcp
+ * Calculate the reciprocal of a number.
+ *
+ * @param x
+ * A non-zero number.
+ *
+ * @return 1 / x
+ */
+template <typename N>
+inline N rcp(N x) noexcept;
+
+/**
+ * @brief rcp
+ * Calculate the reciprocal of a number, per vector component.
+ *
+ * @param x
+ * A non-zero number.
+ *
+ * @return 1 / x
+ */
+template <typename N>
+inline vec4_t<N> rcp(const vec4_t<N>& x) noexcept;
+
+} // end precise namespace
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/accuracy_impl.h"
+
+#ifdef LS_ARCH_X86
+    #include "lightsky/math/x86/accuracyf_impl.h"
+#elif defined(LS_ARM_NEON)
+    #include "lightsky/math/arm/accuracyf_impl.h"
+#endif
+
+#endif /* LS_MATH_ACCURACY_H */
@@ -0,0 +1,438 @@
+
+#ifndef LS_MATH_ANIMATION_H
+#define LS_MATH_ANIMATION_H
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <vector>
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86, LS_ARM_NEON
+
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/quat.h"
+#include "lightsky/math/vec3.h"
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Keyframe Animation
+
+    An animation clip contains a translation, rotation, and scale track for
+    every bone of a skeleton. Keyframes of the same type are packed into a
+    pair of contiguous arrays: one holding the time of each keyframe and one
+    holding its value. Tracks are stored in bone order and their keyframes
+    are sorted by time. Key searches only read the array of times, and
+    sampling every bone of a clip reads each array from front to back.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Methods of interpolating between two keyframes of a track.
+ */
+enum AnimInterpolation : uint8_t
+{
+    ANIM_INTERP_STEP,   // Hold each keyframe until the next one is reached
+    ANIM_INTERP_LINEAR, // Linear interpolation, or slerp for rotations
+    ANIM_INTERP_CUBIC   // Catmull-Rom spline through each keyframe
+};
+
+
+
+/**
+ * @brief Description of a single keyframe track, used to initialize an
+ * AnimationClip.
+ *
+ * The times and values of a track are copied into an AnimationClip and need
+ * not remain valid afterwards. Times do not need to be sorted.
+ */
+template <typename num_t, typename key_t>
+struct AnimationChannel
+{
+    const num_t* times;
+    const key_t* keys;
+    std::size_t count;
+    AnimInterpolation interpolation;
+};
+
+
+
+/**
+ * @brief Range of keyframes belonging to a single track of a clip.
+ */
+struct AnimationTrack
+{
+    uint32_t firstKey;
+    uint32_t numKeys;
+    AnimInterpolation interpolation;
+};
+
+
+
+/**
+ * @brief Packed keyframes of a single type, for every bone in a clip.
+ */
+template <typename num_t, typename key_t>
+struct AnimationKeys
+{
+    std::vector<num_t> times;
+    std::vector<key_t> values;
+    std::vector<AnimationTrack> tracks;
+
+    /**
+     * Remove all tracks & keyframes.
+     */
+    void clear() noexcept;
+};
+
+
+
+/**
+ * @brief The local translation, rotation, and scale of every bone in a
+ * skeleton.
+ */
+template <typename num_t>
+struct AnimationPose
+{
+    std::vector<vec3_t<num_t>> positions;
+    std::vector<quat_t<num_t>> rotations;
+    std::vector<vec3_t<num_t>> scales;
+
+    /**
+     * Resize the pose to contain "numBones" bones. Any new bones are given
+     * an identity transform.
+     */
+    void resize(unsigned numBones) noexcept;
+
+    /**
+     * Retrieve the number of bones in the pose.
+     */
+    unsigned num_bones() const noexcept;
+};
+
+
+
+/**
+ * @brief Playback state of an AnimationClip.
+ *
+ * A cursor remembers the most recent keyframe sampled from every track, so
+ * sampling a clip at increasing times only needs to look at the next few
+ * keyframes rather than searching each track. Sampling at an earlier time
+ * (such as when looping or seeking backwards) falls back to a binary search.
+ * Each instance of an animation being played should use its own cursor.
+ */
+template <typename num_t>
+struct AnimationCursor
+{
+    // Most recent keyframe of each bone's translation, rotation, and scale
+    // track, stored consecutively in blocks of "numBones"
+    std::vector<uint32_t> keys;
+
+    // Scratch space for interpolating rotations in a batch
+    std::vector<quat_t<num_t>> fromRotations;
+    std::vector<quat_t<num_t>> toRotations;
+    std::vector<num_t> percents;
+
+    /**
+     * Discard all cached keyframes and prepare the cursor to sample a clip
+     * containing "numBones" bones.
+     */
+    void reset(unsigned numBones) noexcept;
+};
+
+
+
+/**
+ * @brief A set of translation, rotation, and scale keyframe tracks for every
+ * bone in a skeleton.
+ */
+template <typename num_t = float>
+class AnimationClip
+{
+  private:
+    /**
+     * The number of bones animated by *this.
+     */
+    unsigned numBones;
+
+    /**
+     * The time of the last keyframe in any track.
+     */
+    num_t length;
+
+    /**
+     * Translation keyframes.
+     */
+    AnimationKeys<num_t, vec3_t<num_t>> positions;
+
+    /**
+     * Rotation keyframes.
+     */
+    AnimationKeys<num_t, quat_t<num_t>> rotations;
+
+    /**
+     * Scale keyframes.
+     */
+    AnimationKeys<num_t, vec3_t<num_t>> scales;
+
+  public:
+    /**
+     * Destructor
+     */
+    ~AnimationClip() noexcept = default;
+
+    /**
+     * Constructor
+     * Creates an empty clip.
+     */
+    AnimationClip() noexcept;
+
+    /**
+     * Copy Constructor
+     */
+    AnimationClip(const AnimationClip&) = default;
+
+    /**
+     * Move Constructor
+     */
+    AnimationClip(AnimationClip&&) noexcept = default;
+
+    /**
+     * Copy Operator
+     */
+    AnimationClip& operator=(const AnimationClip&) = default;
+
+    /**
+     * Move Operator
+     */
+    AnimationClip& operator=(AnimationClip&&) noexcept = default;
+
+    /**
+     * @brief Pack the keyframe tracks of every bone into *this, replacing
+     * any previous contents.
+     *
+     * @param boneCount
+     * The number of bones in the clip.
+     *
+     * @param positionTracks
+     * An array of "boneCount" translation tracks, or NULL if no bones are
+     * translated.
+     *
+     * @param rotationTracks
+     * An array of "boneCount" rotation tracks, or NULL if no bones are
+     * rotated. Rotations should be unit quaternions.
+     *
+     * @param scaleTracks
+     * An array of "boneCount" scale tracks, or NULL if no bones are scaled.
+     */
+    void init(
+        unsigned boneCount,
+        const AnimationChannel<num_t, vec3_t<num_t>>* positionTracks,
+        const AnimationChannel<num_t, quat_t<num_t>>* rotationTracks,
+        const AnimationChannel<num_t, vec3_t<num_t>>* scaleTracks) noexcept;
+
+    /**
+     * @brief Remove all bones & keyframes from *this.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Retrieve the number of bones animated by *this.
+     */
+    unsigned num_bones() const noexcept;
+
+    /**
+     * @brief Retrieve the time of the last keyframe in any track.
+     */
+    num_t duration() const noexcept;
+
+    /**
+     * @brief Sample the translation, rotation, and scale of every bone.
+     *
+     * Times before the first keyframe of a track, or after its last, are
+     * clamped to that track's first or last keyframe. Tracks without any
+     * keyframes produce a translation of 0, the identity rotation, and a
+     * scale of 1. Looping clips should wrap the time, such as with
+     * "std::fmod(t, duration())", before calling this function.
+     *
+     * @param t
+     * The time to sample each track at.
+     *
+     * @param cursor
+     * The playback state of the clip. The cursor is reset automatically if
+     * it was last used with a clip containing a different number of bones.
+     *
+     * @param outPositions
+     * An array of at least "num_bones()" elements which will contain each
+     * bone's translation.
+     *
+     * @param outRotations
+     * An array of at least "num_bones()" elements which will contain each
+     * bone's rotation.
+     *
+     * @param outScales
+     * An array of at least "num_bones()" elements which will contain each
+     * bone's scale.
+     */
+    void sample(
+        num_t t,
+        AnimationCursor<num_t>& cursor,
+        vec3_t<num_t>* outPositions,
+        quat_t<num_t>* outRotations,
+        vec3_t<num_t>* outScales) const noexcept;
+
+    /**
+     * @brief Sample every bone into a pose, resizing the pose to contain
+     * "num_bones()" bones.
+     *
+     * @see sample()
+     */
+    void sample(num_t t, AnimationCursor<num_t>& cursor, AnimationPose<num_t>& outPose) const noexcept;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+    Pose Blending
+
+    Poses are blended one bone at a time, with each bone weighted by the
+    weight of its pose and an optional per-bone mask. Single-precision
+    versions blend four bones at a time using SIMD registers. Output poses
+    are resized to match their inputs and may alias any input pose.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Move each quaternion of an array into the same hemisphere as a
+ * reference quaternion, such that dot(reference[i], rotations[i]) >= 0.
+ *
+ * Quaternions q and -q represent the same rotation, but blending two
+ * quaternions from opposite hemispheres takes the longest path between
+ * them.
+ *
+ * @param reference
+ * An array of at least "count" quaternions to align with.
+ *
+ * @param rotations
+ * An array of at least "count" quaternions which will be negated if they lie
+ * in the opposite hemisphere of their reference quaternion.
+ *
+ * @param count
+ * The number of quaternions to align.
+ */
+template <typename N>
+void align_hemispheres(const quat_t<N>* reference, quat_t<N>* rotations, std::size_t count) noexcept;
+
+/**
+ * @brief Blend any number of poses by weight.
+ *
+ * Translations and scales are averaged by weight. Rotations are summed by
+ * weight after aligning them with the first pose, then normalized. Bones
+ * with a total weight of 0 are given an identity transform.
+ *
+ * @param poses
+ * An array of "numPoses" pointers to poses, each with the same number of
+ * bones.
+ *
+ * @param weights
+ * An array of "numPoses" weights applied to each pose. Weights are
+ * normalized for each bone and need not sum to 1.
+ *
+ * @param boneMasks
+ * NULL, or an array of "numPoses" pointers to per-bone weights which scale
+ * the weight of each pose. A NULL mask applies a weight of 1 to every bone.
+ *
+ * @param numPoses
+ * The number of poses to blend.
+ *
+ * @param outPose
+ * The pose which will contain the blended result.
+ */
+template <typename N>
+void blend_poses(
+    const AnimationPose<N>* const* poses,
+    const N* weights,
+    const typename vec3_t<N>::value_type* const* boneMasks,
+    unsigned numPoses,
+    AnimationPose<N>& outPose) noexcept;
+
+/**
+ * @brief Calculate the difference between a pose and a reference pose, for
+ * use as an additive layer.
+ *
+ * The additive pose contains the translation offset, local rotation
+ * (conjugate(reference) * pose), and scale ratio of each bone. Rotations
+ * must be unit quaternions.
+ *
+ * @param pose
+ * The pose to subtract the reference pose from.
+ *
+ * @param reference
+ * The reference pose, containing the same number of bones as "pose".
+ *
+ * @param outAdditive
+ * The pose which will contain the difference of each bone.
+ */
+template <typename N>
+void make_additive_pose(
+    const AnimationPose<N>& pose,
+    const AnimationPose<N>& reference,
+    AnimationPose<N>& outAdditive) noexcept;
+
+/**
+ * @brief Apply an additive layer to a pose.
+ *
+ * Each bone is offset by its additive translation scaled by the layer's
+ * weight, rotated by its additive rotation partially applied with nlerp,
+ * and scaled by its additive scale partially applied with mix. Applying a
+ * pose created by make_additive_pose() with a weight of 1 onto its
+ * reference pose will reproduce the original pose.
+ *
+ * @param base
+ * The pose to apply the additive layer to.
+ *
+ * @param additive
+ * A pose of differences from make_additive_pose(), containing the same
+ * number of bones as "base".
+ *
+ * @param weight
+ * The amount of the additive layer to apply, usually within [0, 1].
+ *
+ * @param boneMask
+ * NULL, or an array of per-bone weights which scale "weight" for each bone.
+ *
+ * @param outPose
+ * The pose which will contain the layered result.
+ */
+template <typename N>
+void apply_additive_pose(
+    const AnimationPose<N>& base,
+    const AnimationPose<N>& additive,
+    typename vec3_t<N>::value_type weight,
+    const typename vec3_t<N>::value_type* boneMask,
+    AnimationPose<N>& outPose) noexcept;
+
+/**
+ * @brief Convert the local transform of each bone in a pose into a 4x4 affine
+ * matrix, equivalent to translate * rotate * scale.
+ *
+ * @param pose
+ * The pose to convert. Rotations must be unit quaternions.
+ *
+ * @param outMatrices
+ * An array of at least "pose.num_bones()" matrices which will contain the
+ * transform of each bone.
+ */
+template <typename N>
+void pose_to_matrices(const AnimationPose<N>& pose, mat4_t<N>* outMatrices) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/animation_impl.h"
+
+#if defined(LS_ARCH_X86) || defined(LS_ARM_NEON)
+    #include "lightsky/math/generic/animationf_impl.h"
+#endif
+
+#endif /* LS_MATH_ANIMATION_H */
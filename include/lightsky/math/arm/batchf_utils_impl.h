@@ -0,0 +1,230 @@
+
+#ifndef LS_MATH_BATCHF_UTILS_IMPL_H
+#define LS_MATH_BATCHF_UTILS_IMPL_H
+
+#include "lightsky/math/generic/simd_slerp_impl.h"
+#include "lightsky/math/generic/simd_trig_impl.h"
+#include "lightsky/math/generic/simd_trs_impl.h"
+#include "lightsky/math/arm/simdf_traits_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Widest Available Registers
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+typedef SimdTraits128 BatchTraits;
+
+} // end impl namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Trigonometric Functions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    sin_batch
+-------------------------------------*/
+inline void sin_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_sin<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    cos_batch
+-------------------------------------*/
+inline void cos_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_cos<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    sincos_batch
+-------------------------------------*/
+inline void sincos_batch(const float* x, float* outSin, float* outCos, std::size_t count) noexcept
+{
+    impl::simd_sincos_array<impl::BatchTraits>(x, outSin, outCos, count);
+}
+
+
+
+/*-------------------------------------
+    tan_batch
+-------------------------------------*/
+inline void tan_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_tan<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    atan_batch
+-------------------------------------*/
+inline void atan_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_atan<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    atan2_batch
+-------------------------------------*/
+inline void atan2_batch(const float* y, const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_binary<impl::BatchTraits>(y, x, out, count, [](impl::BatchTraits::float_t a, impl::BatchTraits::float_t b) noexcept
+    {
+        return impl::simd_atan2<impl::BatchTraits>(a, b);
+    });
+}
+
+
+
+/*-------------------------------------
+    asin_batch
+-------------------------------------*/
+inline void asin_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_asin<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    acos_batch
+-------------------------------------*/
+inline void acos_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_acos<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Matrix Operations
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    mat3_transform_batch
+-------------------------------------*/
+inline void mat3_transform_batch(const mat3_t<float>& m, const vec3_t<float>* v, vec3_t<float>* out, std::size_t count) noexcept
+{
+    const float* const pM = m.m[0].v;
+    const float* pIn = v[0].v;
+    float* pOut = out[0].v;
+    std::size_t i = 0;
+
+    // De-interleaving loads place the X, Y, and Z components of four
+    // vectors into separate registers.
+    for (; i+4 <= count; i += 4, pIn += 12, pOut += 12)
+    {
+        const float32x4x3_t xyz = vld3q_f32(pIn);
+        float32x4x3_t ret;
+
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            float32x4_t r = vmulq_n_f32(xyz.val[0], pM[j]);
+            r = vmlaq_n_f32(r, xyz.val[1], pM[j+3]);
+            ret.val[j] = vmlaq_n_f32(r, xyz.val[2], pM[j+6]);
+        }
+
+        vst3q_f32(pOut, ret);
+    }
+
+    for (; i < count; ++i)
+    {
+        out[i] = m * v[i];
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Quaternion Interpolation
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    slerp_batch
+-------------------------------------*/
+inline void slerp_batch(const quat_t<float>* a, const quat_t<float>* b, const float* t, quat_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_quat_interpolate<impl::BatchTraits, false>(a->q, b->q, t, out->q, count, impl::simd_slerp_weights<impl::BatchTraits>);
+}
+
+
+
+/*-------------------------------------
+    fast_slerp_batch
+-------------------------------------*/
+inline void fast_slerp_batch(const quat_t<float>* a, const quat_t<float>* b, const float* t, quat_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_quat_interpolate<impl::BatchTraits, false>(a->q, b->q, t, out->q, count, impl::simd_fast_slerp_weights<impl::BatchTraits>);
+}
+
+
+
+/*-------------------------------------
+    nlerp_batch
+-------------------------------------*/
+inline void nlerp_batch(const quat_t<float>* a, const quat_t<float>* b, const float* t, quat_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_quat_interpolate<impl::BatchTraits, true>(a->q, b->q, t, out->q, count, impl::simd_lerp_weights<impl::BatchTraits>);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Transform Composition
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    compose_trs_batch
+-------------------------------------*/
+inline void compose_trs_batch(const vec3_t<float>* t, const quat_t<float>* r, const vec3_t<float>* s, mat4_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_compose_trs<impl::SimdTraits128>(t, r, s, out, count);
+}
+
+
+
+/*-------------------------------------
+    decompose_batch
+-------------------------------------*/
+inline void decompose_batch(const mat4_t<float>* m, vec3_t<float>* outT, quat_t<float>* outR, vec3_t<float>* outS, std::size_t count) noexcept
+{
+    impl::simd_decompose_trs<impl::SimdTraits128>(m, outT, outR, outS, count);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_BATCHF_UTILS_IMPL_H */
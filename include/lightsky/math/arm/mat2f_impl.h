@@ -0,0 +1,54 @@
+
+#ifndef LS_MATH_MAT2F_IMPL_H
+#define LS_MATH_MAT2F_IMPL_H
+
+#include <arm_neon.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+
+
+/*-------------------------------------
+    Matrix-Matrix Math Operations
+-------------------------------------*/
+template <>
+inline LS_INLINE mat2_t<float> mat2_t<float>::operator*(const mat2_t<float>& n) const
+{
+    mat2_t<float> ret;
+
+    const float32x2_t col0 = vld1_f32(this->m[0].v);
+    const float32x2_t col1 = vld1_f32(this->m[1].v);
+    const float32x2_t n0 = vld1_f32(n.m[0].v);
+    const float32x2_t n1 = vld1_f32(n.m[1].v);
+
+    vst1_f32(ret.m[0].v, vmla_lane_f32(vmul_lane_f32(col0, n0, 0), col1, n0, 1));
+    vst1_f32(ret.m[1].v, vmla_lane_f32(vmul_lane_f32(col0, n1, 0), col1, n1, 1));
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Vector-Matrix Math Operations (Declared in the 2D Vector header)
+-------------------------------------*/
+template <>
+inline LS_INLINE vec2_t<float> mat2_t<float>::operator*(const vec2_t<float>& v) const
+{
+    vec2_t<float> ret;
+
+    const float32x2_t s = vld1_f32(v.v);
+    vst1_f32(ret.v, vmla_lane_f32(vmul_lane_f32(vld1_f32(this->m[0].v), s, 0), vld1_f32(this->m[1].v), s, 1));
+
+    return ret;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MAT2F_IMPL_H */
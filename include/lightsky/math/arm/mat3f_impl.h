@@ -0,0 +1,115 @@
+
+#ifndef LS_MATH_MAT3F_IMPL_H
+#define LS_MATH_MAT3F_IMPL_H
+
+#include <arm_neon.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+
+    A 3x3 matrix occupies 9 contiguous floats. The first two columns are
+    loaded with 4 elements each, picking up the first element of the
+    following column in their W component. The last column is loaded from
+    one element earlier, then rotated, so no read extends past the end of
+    the matrix. The W component of any result is therefore meaningless and
+    never stored.
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Load the columns of a 3x3 matrix
+-------------------------------------*/
+inline LS_INLINE void mat3f_load(const mat3_t<float>& m, float32x4_t& c0, float32x4_t& c1, float32x4_t& c2) noexcept
+{
+    const float32x4_t last = vld1q_f32(m.m[1].v+2);
+
+    c0 = vld1q_f32(m.m[0].v);
+    c1 = vld1q_f32(m.m[1].v);
+    c2 = vextq_f32(last, last, 1);
+}
+
+/*-------------------------------------
+    Store the XYZ components of a register
+-------------------------------------*/
+inline LS_INLINE void vec3f_store(float* p, float32x4_t v) noexcept
+{
+    vst1_f32(p, vget_low_f32(v));
+    vst1q_lane_f32(p+2, v, 2);
+}
+
+/*-------------------------------------
+    Linear combination of three columns
+-------------------------------------*/
+inline LS_INLINE float32x4_t mat3f_mul_vec(float32x4_t c0, float32x4_t c1, float32x4_t c2, float32x4_t v) noexcept
+{
+    #if defined(LS_ARCH_AARCH64)
+        float32x4_t r = vmulq_laneq_f32(c0, v, 0);
+        r = vfmaq_laneq_f32(r, c1, v, 1);
+        return vfmaq_laneq_f32(r, c2, v, 2);
+    #else
+        float32x4_t r = vmulq_lane_f32(c0, vget_low_f32(v), 0);
+        r = vmlaq_lane_f32(r, c1, vget_low_f32(v), 1);
+        return vmlaq_lane_f32(r, c2, vget_high_f32(v), 0);
+    #endif
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    Matrix-Matrix Math Operations
+-------------------------------------*/
+template <>
+inline LS_INLINE mat3_t<float> mat3_t<float>::operator*(const mat3_t<float>& n) const
+{
+    mat3_t<float> ret;
+    float32x4_t c0, c1, c2;
+    float32x4_t n0, n1, n2;
+
+    impl::mat3f_load(*this, c0, c1, c2);
+    impl::mat3f_load(n, n0, n1, n2);
+
+    // The W component of each column is overwritten by the next store
+    vst1q_f32(ret.m[0].v, impl::mat3f_mul_vec(c0, c1, c2, n0));
+    vst1q_f32(ret.m[1].v, impl::mat3f_mul_vec(c0, c1, c2, n1));
+    impl::vec3f_store(ret.m[2].v, impl::mat3f_mul_vec(c0, c1, c2, n2));
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Vector-Matrix Math Operations (Declared in the 3D Vector header)
+-------------------------------------*/
+template <>
+inline LS_INLINE vec3_t<float> mat3_t<float>::operator*(const vec3_t<float>& v) const
+{
+    vec3_t<float> ret;
+    float32x4_t c0, c1, c2;
+
+    // Build (x, y, z, z) without reading past the vector
+    const float32x2_t xy = vld1_f32(v.v);
+    const float32x2_t zz = vld1_dup_f32(v.v+2);
+
+    impl::mat3f_load(*this, c0, c1, c2);
+    impl::vec3f_store(ret.v, impl::mat3f_mul_vec(c0, c1, c2, vcombine_f32(xy, zz)));
+
+    return ret;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MAT3F_IMPL_H */
@@ -0,0 +1,86 @@
+
+#ifndef LS_MATH_MAT4D_IMPL_H
+#define LS_MATH_MAT4D_IMPL_H
+
+#include <arm_neon.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+
+
+#if defined(LS_ARCH_AARCH64)
+
+/*-------------------------------------
+    Matrix-Matrix Math Operations
+-------------------------------------*/
+template <>
+inline LS_INLINE mat4_t<double> mat4_t<double>::operator*(const mat4_t<double>& n) const
+{
+    mat4_t<double> ret;
+
+    // Each column is held in a pair of registers: (x, y) and (z, w)
+    const float64x2_t col0[2] = {vld1q_f64(this->m[0].v), vld1q_f64(this->m[0].v+2)};
+    const float64x2_t col1[2] = {vld1q_f64(this->m[1].v), vld1q_f64(this->m[1].v+2)};
+    const float64x2_t col2[2] = {vld1q_f64(this->m[2].v), vld1q_f64(this->m[2].v+2)};
+    const float64x2_t col3[2] = {vld1q_f64(this->m[3].v), vld1q_f64(this->m[3].v+2)};
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        const float64x2_t s01 = vld1q_f64(n.m[i].v);
+        const float64x2_t s23 = vld1q_f64(n.m[i].v+2);
+
+        float64x2_t lo = vmulq_laneq_f64(    col0[0], s01, 0);
+        float64x2_t hi = vmulq_laneq_f64(    col0[1], s01, 0);
+        lo             = vfmaq_laneq_f64(lo, col1[0], s01, 1);
+        hi             = vfmaq_laneq_f64(hi, col1[1], s01, 1);
+        lo             = vfmaq_laneq_f64(lo, col2[0], s23, 0);
+        hi             = vfmaq_laneq_f64(hi, col2[1], s23, 0);
+        lo             = vfmaq_laneq_f64(lo, col3[0], s23, 1);
+        hi             = vfmaq_laneq_f64(hi, col3[1], s23, 1);
+
+        vst1q_f64(ret.m[i].v,   lo);
+        vst1q_f64(ret.m[i].v+2, hi);
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Vector-Matrix Math Operations (Declared in the 4D Vector header)
+-------------------------------------*/
+template <> inline LS_INLINE
+vec4_t<double> mat4_t<double>::operator*(const vec4_t<double>& v) const
+{
+    vec4_t<double> ret;
+
+    const float64x2_t s01 = vld1q_f64(v.v);
+    const float64x2_t s23 = vld1q_f64(v.v+2);
+
+    float64x2_t lo = vmulq_laneq_f64(    vld1q_f64(this->m[0].v),   s01, 0);
+    float64x2_t hi = vmulq_laneq_f64(    vld1q_f64(this->m[0].v+2), s01, 0);
+    lo             = vfmaq_laneq_f64(lo, vld1q_f64(this->m[1].v),   s01, 1);
+    hi             = vfmaq_laneq_f64(hi, vld1q_f64(this->m[1].v+2), s01, 1);
+    lo             = vfmaq_laneq_f64(lo, vld1q_f64(this->m[2].v),   s23, 0);
+    hi             = vfmaq_laneq_f64(hi, vld1q_f64(this->m[2].v+2), s23, 0);
+    lo             = vfmaq_laneq_f64(lo, vld1q_f64(this->m[3].v),   s23, 1);
+    hi             = vfmaq_laneq_f64(hi, vld1q_f64(this->m[3].v+2), s23, 1);
+
+    vst1q_f64(ret.v,   lo);
+    vst1q_f64(ret.v+2, hi);
+
+    return ret;
+}
+
+#endif /* LS_ARCH_AARCH64 */
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MAT4D_IMPL_H */
@@ -0,0 +1,169 @@
+
+#ifndef LS_MATH_MATD_UTILS_IMPL_H
+#define LS_MATH_MATD_UTILS_IMPL_H
+
+#include <arm_neon.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+namespace math
+{
+
+
+
+#if defined(LS_ARCH_AARCH64)
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+
+    The 4x4 inverse and determinant are computed from the six 2x2 minors of
+    the first two rows (s0-s5) and the last two rows (c0-c5). Inverting the
+    transpose of a matrix yields the transpose of its inverse, so the same
+    code works on columns as well as rows.
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    2x2 Minors of two rows, as (m01, m23), (m02, m03), and (m12, m13)
+-------------------------------------*/
+inline LS_INLINE void mat4d_minors(const double* r0, const double* r1, float64x2_t minors[3]) noexcept
+{
+    const float64x2_t lo0 = vld1q_f64(r0);
+    const float64x2_t hi0 = vld1q_f64(r0+2);
+    const float64x2_t lo1 = vld1q_f64(r1);
+    const float64x2_t hi1 = vld1q_f64(r1+2);
+
+    const float64x2_t a = vmulq_f64(lo0, vextq_f64(lo1, lo1, 1));
+    const float64x2_t b = vmulq_f64(hi0, vextq_f64(hi1, hi1, 1));
+
+    minors[0] = vsubq_f64(vuzp1q_f64(a, b), vuzp2q_f64(a, b));
+    minors[1] = vfmsq_laneq_f64(vmulq_laneq_f64(hi1, lo0, 0), hi0, lo1, 0);
+    minors[2] = vfmsq_laneq_f64(vmulq_laneq_f64(hi1, lo0, 1), hi0, lo1, 1);
+}
+
+/*-------------------------------------
+    Determinant from the minors of the upper (s) and lower (c) rows
+-------------------------------------*/
+inline LS_INLINE double mat4d_det(const float64x2_t s[3], const float64x2_t c[3]) noexcept
+{
+    // s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0
+    const float64x2_t c50 = vextq_f64(c[0], c[0], 1);
+    const float64x2_t c43 = vmulq_f64(vextq_f64(c[2], c[2], 1), float64x2_t{-1.0, 1.0});
+    const float64x2_t c21 = vmulq_f64(vextq_f64(c[1], c[1], 1), float64x2_t{1.0, -1.0});
+
+    const float64x2_t d = vfmaq_f64(vfmaq_f64(vmulq_f64(s[0], c50), s[1], c43), s[2], c21);
+    return vaddvq_f64(d);
+}
+
+/*-------------------------------------
+    One half of each row of the inverse, before applying alternating signs:
+    r[0] = p1*m5 - p2*m4 + p3*m3
+    r[1] = p0*m5 - p2*m2 + p3*m1
+    r[2] = p0*m4 - p1*m2 + p3*m0
+    r[3] = p0*m3 - p1*m1 + p2*m0
+-------------------------------------*/
+inline LS_INLINE void mat4d_adjugate_half(const double* r0, const double* r1, const float64x2_t m[3], float64x2_t ret[4]) noexcept
+{
+    // p[j] = (r1[j], r0[j])
+    const float64x2_t lo0 = vld1q_f64(r0);
+    const float64x2_t hi0 = vld1q_f64(r0+2);
+    const float64x2_t lo1 = vld1q_f64(r1);
+    const float64x2_t hi1 = vld1q_f64(r1+2);
+
+    const float64x2_t p0 = vzip1q_f64(lo1, lo0);
+    const float64x2_t p1 = vzip2q_f64(lo1, lo0);
+    const float64x2_t p2 = vzip1q_f64(hi1, hi0);
+    const float64x2_t p3 = vzip2q_f64(hi1, hi0);
+
+    ret[0] = vfmaq_laneq_f64(vfmsq_laneq_f64(vmulq_laneq_f64(p1, m[0], 1), p2, m[2], 1), p3, m[2], 0);
+    ret[1] = vfmaq_laneq_f64(vfmsq_laneq_f64(vmulq_laneq_f64(p0, m[0], 1), p2, m[1], 1), p3, m[1], 0);
+    ret[2] = vfmaq_laneq_f64(vfmsq_laneq_f64(vmulq_laneq_f64(p0, m[2], 1), p1, m[1], 1), p3, m[0], 0);
+    ret[3] = vfmaq_laneq_f64(vfmsq_laneq_f64(vmulq_laneq_f64(p0, m[2], 0), p1, m[1], 0), p2, m[0], 0);
+}
+
+} // end impl namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    4x4 Matrices
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    4x4 Determinant
+-------------------------------------*/
+inline LS_INLINE double determinant(const mat4_t<double>& m4x4) noexcept
+{
+    float64x2_t s[3];
+    float64x2_t c[3];
+
+    impl::mat4d_minors(m4x4.m[0].v, m4x4.m[1].v, s);
+    impl::mat4d_minors(m4x4.m[2].v, m4x4.m[3].v, c);
+
+    return impl::mat4d_det(s, c);
+}
+
+/*-------------------------------------
+    4x4 Inverse
+-------------------------------------*/
+inline LS_INLINE mat4_t<double> inverse(const mat4_t<double>& m4x4) noexcept
+{
+    mat4_t<double> ret;
+    float64x2_t s[3];
+    float64x2_t c[3];
+    float64x2_t lo[4];
+    float64x2_t hi[4];
+
+    impl::mat4d_minors(m4x4.m[0].v, m4x4.m[1].v, s);
+    impl::mat4d_minors(m4x4.m[2].v, m4x4.m[3].v, c);
+
+    // The first half of each row is built from the upper rows and lower
+    // minors, the second half from the lower rows and upper minors.
+    impl::mat4d_adjugate_half(m4x4.m[0].v, m4x4.m[1].v, c, lo);
+    impl::mat4d_adjugate_half(m4x4.m[2].v, m4x4.m[3].v, s, hi);
+
+    const double invDet = 1.0 / impl::mat4d_det(s, c);
+    const float64x2_t scale[2] = {
+        vmulq_n_f64(float64x2_t{1.0, -1.0}, invDet),
+        vmulq_n_f64(float64x2_t{-1.0, 1.0}, invDet)
+    };
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        vst1q_f64(ret.m[i].v,   vmulq_f64(lo[i], scale[i & 1u]));
+        vst1q_f64(ret.m[i].v+2, vmulq_f64(hi[i], scale[i & 1u]));
+    }
+
+    return ret;
+}
+
+/*-------------------------------------
+    4x4 Transpose
+-------------------------------------*/
+inline LS_INLINE mat4_t<double> transpose(const mat4_t<double>& m4x4)
+{
+    mat4_t<double> ret;
+
+    // Each de-interleaved load gathers half of every output column
+    const float64x2x4_t t01 = vld4q_f64(m4x4.m[0].v);
+    const float64x2x4_t t23 = vld4q_f64(m4x4.m[2].v);
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        vst1q_f64(ret.m[i].v,   t01.val[i]);
+        vst1q_f64(ret.m[i].v+2, t23.val[i]);
+    }
+
+    return ret;
+}
+
+#endif /* LS_ARCH_AARCH64 */
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MATD_UTILS_IMPL_H */
@@ -0,0 +1,328 @@
+
+#ifndef LS_MATH_QUATF_IMPL_H
+#define LS_MATH_QUATF_IMPL_H
+
+#include <arm_neon.h>
+
+#include <type_traits>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Flip the sign of selected elements. Each 64-bit mask contains the sign
+    bits of two adjacent elements.
+-------------------------------------*/
+inline LS_INLINE float32x4_t quatf_flip_signs(const float32x4_t q, uint64_t lo, uint64_t hi) noexcept
+{
+    const uint32x4_t mask = vcombine_u32(vcreate_u32(lo), vcreate_u32(hi));
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(q), mask));
+}
+
+} // end impl namespace
+
+
+
+template<>
+union alignas(alignof(float32x4_t)) quat_t<float>
+{
+    // data
+    float q[4];
+
+    float32x4_t simd;
+
+    ~quat_t() = default;
+
+    quat_t() = default;
+
+    constexpr quat_t(float inX, float inY, float inZ, float inW);
+
+    constexpr quat_t(float xyz, float w);
+
+    explicit constexpr quat_t(float32x4_t n);
+
+    quat_t(const quat_t<float>&) = default;
+
+    quat_t(quat_t<float>&&) = default;
+
+    // Conversions & Casting
+    template <typename other_t>
+    inline explicit operator quat_t<other_t>() const;
+
+    inline const float* operator&() const;
+
+    inline float* operator&();
+
+    // Subscripting Operators
+    template <typename index_t>
+    constexpr float operator[](index_t i) const;
+
+    template <typename index_t>
+    inline float& operator[](index_t i);
+
+    //quaternion-quaternion operators
+    quat_t& operator++(); //prefix operators
+    quat_t& operator--();
+    quat_t operator++(int); //postfix operators
+    quat_t operator--(int);
+    quat_t operator-() const;
+    quat_t operator+(const quat_t<float>& input) const;
+    quat_t operator-(const quat_t<float>& input) const;
+    quat_t operator*(const quat_t<float>& input) const;
+    quat_t& operator=(const quat_t<float>&) = default;
+    quat_t& operator=(quat_t<float>&&) = default;
+    quat_t& operator+=(const quat_t<float>& input);
+    quat_t& operator-=(const quat_t<float>& input);
+    quat_t& operator*=(const quat_t<float>& input);
+    bool operator==(const quat_t<float>& input) const;
+    bool operator!=(const quat_t<float>& input) const;
+
+    //quaternion-scalar operators
+    quat_t operator+(float) const;
+    quat_t operator-(float) const;
+    quat_t operator*(float) const;
+    quat_t operator/(float) const;
+    quat_t& operator=(float);
+    quat_t& operator+=(float);
+    quat_t& operator-=(float);
+    quat_t& operator*=(float);
+    quat_t& operator/=(float);
+};
+
+static_assert(std::is_trivial<quat_t<float>>::value, "Quatf must be trivial.");
+
+
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+constexpr LS_INLINE quat_t<float>::quat_t(float inX, float inY, float inZ, float inW) :
+    q{inX, inY, inZ, inW}
+{}
+
+constexpr LS_INLINE quat_t<float>::quat_t(float xyz, float w) :
+    q{xyz, xyz, xyz, w}
+{}
+
+constexpr LS_INLINE quat_t<float>::quat_t(float32x4_t n) :
+    simd(n)
+{}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template <typename other_t>
+inline LS_INLINE quat_t<float>::operator quat_t<other_t>() const
+{
+    return quat_t<other_t>{(other_t)q[0], (other_t)q[1], (other_t)q[2], (other_t)q[3]};
+}
+
+inline LS_INLINE const float* quat_t<float>::operator&() const
+{
+    return q;
+}
+
+inline LS_INLINE float* quat_t<float>::operator&()
+{
+    return q;
+}
+
+/*-------------------------------------
+    Subscripting Operators
+-------------------------------------*/
+template <typename index_t>
+constexpr LS_INLINE float quat_t<float>::operator[](index_t i) const
+{
+    return q[i];
+}
+
+template <typename index_t>
+inline LS_INLINE float& quat_t<float>::operator[](index_t i)
+{
+    return q[i];
+}
+
+/*-------------------------------------
+    Quaternion-Quaternion Operators
+-------------------------------------*/
+// prefix operators
+inline LS_INLINE quat_t<float>& quat_t<float>::operator++()
+{
+    simd = vaddq_f32(simd, vdupq_n_f32(1.f));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator--()
+{
+    simd = vsubq_f32(simd, vdupq_n_f32(1.f));
+    return *this;
+}
+
+// postfix operators, which match the generic implementation by returning
+// the modified value
+inline LS_INLINE quat_t<float> quat_t<float>::operator++(int)
+{
+    simd = vaddq_f32(simd, vdupq_n_f32(1.f));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator--(int)
+{
+    simd = vsubq_f32(simd, vdupq_n_f32(1.f));
+    return *this;
+}
+
+// conjugate
+inline LS_INLINE quat_t<float> quat_t<float>::operator-() const
+{
+    return quat_t<float>{impl::quatf_flip_signs(simd, 0x8000000080000000ull, 0x0000000080000000ull)};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator+(const quat_t<float>& input) const
+{
+    return quat_t<float>{vaddq_f32(simd, input.simd)};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator-(const quat_t<float>& input) const
+{
+    return quat_t<float>{vsubq_f32(simd, input.simd)};
+}
+
+// Hamilton product. Each lane of the left-hand quaternion is broadcast and
+// multiplied by a permutation of the right-hand quaternion with its signs
+// flipped to match the scalar expansion.
+inline LS_INLINE quat_t<float> quat_t<float>::operator*(const quat_t<float>& input) const
+{
+    const float32x4_t a = simd;
+    const float32x4_t b = input.simd;
+    const float32x4_t rev = vrev64q_f32(b);
+
+    const float32x4_t wzyx = impl::quatf_flip_signs(vextq_f32(rev, rev, 2), 0x8000000000000000ull, 0x8000000000000000ull);
+    const float32x4_t zwxy = impl::quatf_flip_signs(vextq_f32(b, b, 2), 0x0000000000000000ull, 0x8000000080000000ull);
+    const float32x4_t yxwz = impl::quatf_flip_signs(rev, 0x0000000080000000ull, 0x8000000000000000ull);
+
+    #if defined(LS_ARCH_AARCH64)
+        float32x4_t ret = vmulq_laneq_f32(b, a, 3);
+        ret = vfmaq_laneq_f32(ret, wzyx, a, 0);
+        ret = vfmaq_laneq_f32(ret, zwxy, a, 1);
+        ret = vfmaq_laneq_f32(ret, yxwz, a, 2);
+    #else
+        float32x4_t ret = vmulq_lane_f32(b, vget_high_f32(a), 1);
+        ret = vmlaq_lane_f32(ret, wzyx, vget_low_f32(a), 0);
+        ret = vmlaq_lane_f32(ret, zwxy, vget_low_f32(a), 1);
+        ret = vmlaq_lane_f32(ret, yxwz, vget_high_f32(a), 0);
+    #endif
+
+    return quat_t<float>{ret};
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator+=(const quat_t<float>& input)
+{
+    simd = vaddq_f32(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator-=(const quat_t<float>& input)
+{
+    simd = vsubq_f32(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator*=(const quat_t<float>& input)
+{
+    return *this = *this * input;
+}
+
+inline LS_INLINE bool quat_t<float>::operator==(const quat_t<float>& compare) const
+{
+    const uint32x4_t cmp = vceqq_f32(simd, compare.simd);
+    const uint32x2_t ret = vand_u32(vget_low_u32(cmp), vget_high_u32(cmp));
+    return (vget_lane_u32(ret, 0) & vget_lane_u32(ret, 1)) != 0;
+}
+
+inline LS_INLINE bool quat_t<float>::operator!=(const quat_t<float>& compare) const
+{
+    return !(*this == compare);
+}
+
+/*-------------------------------------
+    Quaternion-Scalar Operators
+-------------------------------------*/
+inline LS_INLINE quat_t<float> quat_t<float>::operator+(float input) const
+{
+    return quat_t<float>{vaddq_f32(simd, vdupq_n_f32(input))};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator-(float input) const
+{
+    return quat_t<float>{vsubq_f32(simd, vdupq_n_f32(input))};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator*(float input) const
+{
+    return quat_t<float>{vmulq_n_f32(simd, input)};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator/(float input) const
+{
+    #ifdef LS_ARCH_AARCH64
+        return quat_t<float>{vdivq_f32(simd, vdupq_n_f32(input))};
+    #else
+        return quat_t<float>{vmulq_n_f32(simd, 1.f / input)};
+    #endif
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator=(float input)
+{
+    simd = vdupq_n_f32(input);
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator+=(float input)
+{
+    simd = vaddq_f32(simd, vdupq_n_f32(input));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator-=(float input)
+{
+    simd = vsubq_f32(simd, vdupq_n_f32(input));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator*=(float input)
+{
+    simd = vmulq_n_f32(simd, input);
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator/=(float input)
+{
+    #ifdef LS_ARCH_AARCH64
+        simd = vdivq_f32(simd, vdupq_n_f32(input));
+    #else
+        simd = vmulq_n_f32(simd, 1.f / input);
+    #endif
+    return *this;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_QUATF_IMPL_H */
@@ -4,6 +4,8 @@
 
 #include <arm_neon.h>
 
+#include <cmath>
+
 #include "lightsky/setup/Api.h" // LS_INLINE
 
 namespace ls
@@ -13,6 +15,170 @@ namespace math
 
 
 
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    4D dot product, broadcast to every element
+-------------------------------------*/
+inline LS_INLINE float32x4_t quatf_dot(const float32x4_t q1, const float32x4_t q2) noexcept
+{
+    const float32x4_t a = vmulq_f32(q1, q2);
+    const float32x2_t b = vadd_f32(vget_high_f32(a), vget_low_f32(a));
+    const float32x2_t c = vpadd_f32(b, b);
+
+    return vcombine_f32(c, c);
+}
+
+/*-------------------------------------
+    Full-precision division by a vector of positive numbers
+-------------------------------------*/
+inline LS_INLINE float32x4_t quatf_div(const float32x4_t n, const float32x4_t d) noexcept
+{
+    #ifdef LS_ARCH_AARCH64
+        return vdivq_f32(n, d);
+    #else
+        float32x4_t r = vrecpeq_f32(d);
+        r = vmulq_f32(vrecpsq_f32(d, r), r);
+        r = vmulq_f32(vrecpsq_f32(d, r), r);
+        return vmulq_f32(n, r);
+    #endif
+}
+
+/*-------------------------------------
+    Rotate the XYZ elements of a vector by a quaternion
+
+    v' = v + w*t + cross(q, t), where t = cross(2q, v)
+-------------------------------------*/
+inline LS_INLINE float32x4_t quatf_rotate(const float32x4_t v, const float32x4_t q) noexcept
+{
+    const float32x4_t u = vsetq_lane_f32(0.f, q, 3);
+    const float32x4_t t = math::cross(vec4_t<float>{vaddq_f32(u, u)}, vec4_t<float>{v}).simd;
+    const float32x4_t ut = math::cross(vec4_t<float>{u}, vec4_t<float>{t}).simd;
+
+    #if defined(LS_ARCH_AARCH64)
+        return vaddq_f32(vfmaq_laneq_f32(v, t, q, 3), ut);
+    #else
+        return vaddq_f32(vmlaq_lane_f32(v, t, vget_high_f32(q), 1), ut);
+    #endif
+}
+
+/*-------------------------------------
+    Columns of a rotation matrix. The W element of each column is
+    meaningless.
+-------------------------------------*/
+inline LS_INLINE void quatf_to_cols(const float32x4_t q, float32x4_t& c0, float32x4_t& c1, float32x4_t& c2) noexcept
+{
+    const float32x4_t q2 = vaddq_f32(q, q);
+
+    // Each element of the symmetric product 2*q*q^T
+    const float32x4_t xq = vmulq_lane_f32(q2, vget_low_f32(q), 0);  // (xx, xy, xz, xw)
+    const float32x4_t yq = vmulq_lane_f32(q2, vget_low_f32(q), 1);  // (xy, yy, yz, yw)
+    const float32x4_t zq = vmulq_lane_f32(q2, vget_high_f32(q), 0); // (xz, yz, zz, zw)
+
+    // u = (xy, xz, yz), v = (zw, yw, xw)
+    const float32x4_t u = vsetq_lane_f32(vgetq_lane_f32(yq, 2), vextq_f32(xq, xq, 1), 2);
+    float32x4_t v = vdupq_n_f32(vgetq_lane_f32(zq, 3));
+    v = vsetq_lane_f32(vgetq_lane_f32(yq, 3), v, 1);
+    v = vsetq_lane_f32(vgetq_lane_f32(xq, 3), v, 2);
+
+    // diag = 1 - (yy + zz, xx + zz, xx + yy)
+    float32x4_t a = vdupq_n_f32(vgetq_lane_f32(yq, 1));
+    a = vsetq_lane_f32(vgetq_lane_f32(xq, 0), a, 1);
+    a = vsetq_lane_f32(vgetq_lane_f32(xq, 0), a, 2);
+
+    float32x4_t b = vdupq_n_f32(vgetq_lane_f32(zq, 2));
+    b = vsetq_lane_f32(vgetq_lane_f32(yq, 1), b, 2);
+
+    const float32x4_t diag = vsubq_f32(vdupq_n_f32(1.f), vaddq_f32(a, b));
+    const float32x4_t plus = vaddq_f32(u, v);
+    const float32x4_t minus = vsubq_f32(u, v);
+
+    // c0 = (diag0, plus0, minus1)
+    c0 = vsetq_lane_f32(vgetq_lane_f32(plus, 0), diag, 1);
+    c0 = vsetq_lane_f32(vgetq_lane_f32(minus, 1), c0, 2);
+
+    // c1 = (minus0, diag1, plus2)
+    c1 = vsetq_lane_f32(vgetq_lane_f32(minus, 0), diag, 0);
+    c1 = vsetq_lane_f32(vgetq_lane_f32(plus, 2), c1, 2);
+
+    // c2 = (plus1, minus2, diag2)
+    c2 = vsetq_lane_f32(vgetq_lane_f32(plus, 1), diag, 0);
+    c2 = vsetq_lane_f32(vgetq_lane_f32(minus, 2), c2, 1);
+}
+
+/*-------------------------------------
+    Quaternion from the columns of a rotation matrix
+
+    The branch taken matches the generic implementation. Each branch
+    gathers one of the four candidate quaternions (scaled by 4 times its
+    largest element) from the sums and differences of opposing elements.
+-------------------------------------*/
+inline LS_INLINE float32x4_t quatf_from_cols(const float* c0, const float* c1, const float* c2) noexcept
+{
+    // a = (m12, m20, m01), b = (m21, m02, m10)
+    float32x4_t a = vdupq_n_f32(c1[2]);
+    a = vsetq_lane_f32(c2[0], a, 1);
+    a = vsetq_lane_f32(c0[1], a, 2);
+
+    float32x4_t b = vdupq_n_f32(c2[1]);
+    b = vsetq_lane_f32(c0[2], b, 1);
+    b = vsetq_lane_f32(c1[0], b, 2);
+
+    const float32x4_t d = vsubq_f32(a, b);
+    const float32x4_t s = vaddq_f32(a, b);
+
+    // t = 1 + (m00 - m11 - m22, m11 - m00 - m22, m22 - m00 - m11, m00 + m11 + m22)
+    const float m00 = c0[0];
+    const float m11 = c1[1];
+    const float m22 = c2[2];
+    const float32x4_t d0 = impl::quatf_flip_signs(vdupq_n_f32(m00), 0x8000000000000000ull, 0x0000000080000000ull);
+    const float32x4_t d1 = impl::quatf_flip_signs(vdupq_n_f32(m11), 0x0000000080000000ull, 0x0000000080000000ull);
+    const float32x4_t d2 = impl::quatf_flip_signs(vdupq_n_f32(m22), 0x8000000080000000ull, 0x0000000000000000ull);
+    const float32x4_t t = vaddq_f32(vaddq_f32(d0, d1), vaddq_f32(d2, vdupq_n_f32(1.f)));
+
+    float32x4_t q;
+    float ti;
+
+    if (m00 + m11 + m22 > 0.f)
+    {
+        // (d0, d1, d2, tw)
+        ti = vgetq_lane_f32(t, 3);
+        q = vsetq_lane_f32(ti, d, 3);
+    }
+    else if (m22 > m00 && m22 > m11)
+    {
+        // (s1, s0, tz, d2)
+        ti = vgetq_lane_f32(t, 2);
+        q = vsetq_lane_f32(ti, vrev64q_f32(s), 2);
+        q = vsetq_lane_f32(vgetq_lane_f32(d, 2), q, 3);
+    }
+    else if (m11 > m00)
+    {
+        // (s2, ty, s0, d1)
+        ti = vgetq_lane_f32(t, 1);
+        q = vsetq_lane_f32(ti, vextq_f32(s, s, 2), 1);
+        q = vsetq_lane_f32(vgetq_lane_f32(d, 1), q, 3);
+    }
+    else
+    {
+        // (tx, s2, s1, d0)
+        const float32x4_t r = vrev64q_f32(s);
+        ti = vgetq_lane_f32(t, 0);
+        q = vsetq_lane_f32(ti, vextq_f32(r, r, 2), 0);
+        q = vsetq_lane_f32(vgetq_lane_f32(d, 0), q, 3);
+    }
+
+    return vmulq_n_f32(q, 0.5f / std::sqrt(ti));
+}
+
+} // end impl namespace
+
+
+
 /*-----------------------------------------------------------------------------
     Quaternion Utilities
 -----------------------------------------------------------------------------*/
@@ -21,11 +187,15 @@ namespace math
 -------------------------------------*/
 inline LS_INLINE float dot(const quat_t<float>& q1, const quat_t<float>& q2)
 {
-    const float32x4_t a = vmulq_f32(vld1q_f32(q1.q), vld1q_f32(q2.q));
-    const float32x2_t b = vadd_f32(vget_high_f32(a), vget_low_f32(a));
-    const float32x2_t c = vpadd_f32(b, b);
+    return vgetq_lane_f32(impl::quatf_dot(q1.simd, q2.simd), 0);
+}
 
-    return vget_lane_f32(c, 0);
+/*-------------------------------------
+    4D Magnitude-Squared
+-------------------------------------*/
+inline LS_INLINE float length_squared(const quat_t<float>& q)
+{
+    return vgetq_lane_f32(impl::quatf_dot(q.simd, q.simd), 0);
 }
 
 /*-------------------------------------
@@ -33,21 +203,16 @@ inline LS_INLINE float dot(const quat_t<float>& q1, const quat_t<float>& q2)
 -------------------------------------*/
 inline LS_INLINE float length(const quat_t<float>& q)
 {
-    const float32x4_t s = vld1q_f32(q.q);
-
-    // sum, squared
-    const float32x4_t a = vmulq_f32(s, s);
-    const float32x2_t b = vadd_f32(vget_high_f32(a), vget_low_f32(a));
-    const float32x2_t c = vpadd_f32(b, b);
-
-    float32x2_t d = vrsqrte_f32(c);
-    d = vmul_f32(vrsqrts_f32(vmul_f32(c, d), d), d);
-    //d = vmul_f32(vrsqrts_f32(vmul_f32(c, d), d), d);
+    const float32x2_t c = vget_low_f32(impl::quatf_dot(q.simd, q.simd));
 
     #ifdef LS_ARCH_AARCH64
-        const float32x2_t e = vdiv_f32(vdup_n_f32(1.f), d);
+        const float32x2_t e = vsqrt_f32(c);
 
     #else
+        float32x2_t d = vrsqrte_f32(c);
+        d = vmul_f32(vrsqrts_f32(vmul_f32(c, d), d), d);
+        d = vmul_f32(vrsqrts_f32(vmul_f32(c, d), d), d);
+
         float32x2_t e = vrecpe_f32(d);
         e = vmul_f32(vrecps_f32(d, e), e);
         e = vmul_f32(vrecps_f32(d, e), e);
@@ -56,28 +221,143 @@ inline LS_INLINE float length(const quat_t<float>& q)
     return vget_lane_f32(e, 0);
 }
 
+/*-------------------------------------
+    Inverse
+-------------------------------------*/
+inline LS_INLINE quat_t<float> inverse(const quat_t<float>& q)
+{
+    const float32x4_t conj = impl::quatf_flip_signs(q.simd, 0x8000000080000000ull, 0x0000000080000000ull);
+    return quat_t<float>{impl::quatf_div(conj, impl::quatf_dot(q.simd, q.simd))};
+}
+
+/*-------------------------------------
+    Conjugate
+-------------------------------------*/
+inline LS_INLINE quat_t<float> conjugate(const quat_t<float>& q)
+{
+    return quat_t<float>{impl::quatf_flip_signs(q.simd, 0x8000000080000000ull, 0x0000000080000000ull)};
+}
+
 /*-------------------------------------
     normalize
 -------------------------------------*/
 inline LS_INLINE quat_t<float> normalize(const quat_t<float>& q)
 {
-    const float32x4_t s = vld1q_f32(q.q);
-    const float32x4_t a = vmulq_f32(s, s);
-    const float32x2_t b = vadd_f32(vget_high_f32(a), vget_low_f32(a));
-    const float32x2_t c = vpadd_f32(b, b);
+    const float32x4_t d = impl::quatf_dot(q.simd, q.simd);
+
+    #ifdef LS_ARCH_AARCH64
+        return quat_t<float>{vdivq_f32(q.simd, vsqrtq_f32(d))};
+
+    #else
+        // A single refinement of the reciprocal square root estimate is only
+        // accurate to about 16 bits.
+        float32x4_t e = vrsqrteq_f32(d);
+        e = vmulq_f32(vrsqrtsq_f32(vmulq_f32(d, e), e), e);
+        e = vmulq_f32(vrsqrtsq_f32(vmulq_f32(d, e), e), e);
+
+        return quat_t<float>{vmulq_f32(q.simd, e)};
+    #endif
+}
 
-    float32x4_t d = vcombine_f32(c, c);
 
-    // normalization
-    float32x4_t e = vrsqrteq_f32(d);
-    e = vmulq_f32(vrsqrtsq_f32(vmulq_f32(d, e), e), e);
-    //e = vmulq_f32(vrsqrtsq_f32(vmulq_f32(d, e), e), e);
 
-    quat_t<float> ret;
-    vst1q_f32(ret.q, vmulq_f32(s, e));
+/*-----------------------------------------------------------------------------
+    Quaternions & Vectors
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    reorient
+-------------------------------------*/
+inline LS_INLINE vec3_t<float> reorient(const quat_t<float>& q, const vec3_t<float>& v)
+{
+    vec3_t<float> ret;
+    const float32x4_t v4 = vcombine_f32(vld1_f32(v.v), vdup_n_f32(v.v[2]));
+    impl::vec3f_store(ret.v, impl::quatf_rotate(v4, q.simd));
     return ret;
 }
 
+/*-------------------------------------
+    reorient
+-------------------------------------*/
+inline LS_INLINE vec3_t<float> reorient(const vec3_t<float>& v, const quat_t<float>& q)
+{
+    return math::reorient(math::inverse(q), v);
+}
+
+/*-------------------------------------
+    Vector rotation using a Quaternion
+-------------------------------------*/
+inline LS_INLINE vec3_t<float> rotate(const vec3_t<float>& v, const quat_t<float>& q)
+{
+    vec3_t<float> ret;
+    const float32x4_t v4 = vcombine_f32(vld1_f32(v.v), vdup_n_f32(v.v[2]));
+    impl::vec3f_store(ret.v, impl::quatf_rotate(v4, q.simd));
+    return ret;
+}
+
+/*-------------------------------------
+    Vector rotation using a Quaternion
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> rotate(const vec4_t<float>& v, const quat_t<float>& q)
+{
+    return vec4_t<float>{impl::quatf_rotate(v.simd, q.simd)};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Quaternions & Matrices
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Quaternion to 3x3 Matrix
+-------------------------------------*/
+inline LS_INLINE mat3_t<float> quat_to_mat3(const quat_t<float>& q)
+{
+    mat3_t<float> ret;
+    float32x4_t c0, c1, c2;
+
+    impl::quatf_to_cols(q.simd, c0, c1, c2);
+
+    // The W component of each column is overwritten by the next store
+    vst1q_f32(ret.m[0].v, c0);
+    vst1q_f32(ret.m[1].v, c1);
+    impl::vec3f_store(ret.m[2].v, c2);
+
+    return ret;
+}
+
+/*-------------------------------------
+    Quaternion to 4x4 Matrix
+-------------------------------------*/
+inline LS_INLINE mat4_t<float> quat_to_mat4(const quat_t<float>& q)
+{
+    float32x4_t c0, c1, c2;
+
+    impl::quatf_to_cols(q.simd, c0, c1, c2);
+
+    return mat4_t<float>{
+        vec4_t<float>{vsetq_lane_f32(0.f, c0, 3)},
+        vec4_t<float>{vsetq_lane_f32(0.f, c1, 3)},
+        vec4_t<float>{vsetq_lane_f32(0.f, c2, 3)},
+        vec4_t<float>{0.f, 0.f, 0.f, 1.f}
+    };
+}
+
+/*-------------------------------------
+    3x3 Matrix to Quaternion
+-------------------------------------*/
+inline LS_INLINE quat_t<float> mat_to_quat(const mat3_t<float>& m)
+{
+    return quat_t<float>{impl::quatf_from_cols(m.m[0].v, m.m[1].v, m.m[2].v)};
+}
+
+/*-------------------------------------
+    4x4 Matrix to Quaternion
+-------------------------------------*/
+inline LS_INLINE quat_t<float> mat_to_quat(const mat4_t<float>& m)
+{
+    return quat_t<float>{impl::quatf_from_cols(m.m[0].v, m.m[1].v, m.m[2].v)};
+}
+
 
 
 } // end math namespace
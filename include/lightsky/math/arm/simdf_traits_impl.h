@@ -0,0 +1,193 @@
+
+#ifndef LS_MATH_SIMDF_TRAITS_IMPL_H
+#define LS_MATH_SIMDF_TRAITS_IMPL_H
+
+#include <arm_neon.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    NEON Register Traits (4 floats)
+-----------------------------------------------------------------------------*/
+struct SimdTraits128
+{
+    typedef float32x4_t float_t;
+    typedef int32x4_t   int_t;
+    typedef uint32x4_t  mask_t;
+
+    static constexpr unsigned width = 4;
+
+    static LS_INLINE float_t set1(float x) noexcept { return vdupq_n_f32(x); }
+    static LS_INLINE float_t add(float_t a, float_t b) noexcept { return vaddq_f32(a, b); }
+    static LS_INLINE float_t sub(float_t a, float_t b) noexcept { return vsubq_f32(a, b); }
+    static LS_INLINE float_t mul(float_t a, float_t b) noexcept { return vmulq_f32(a, b); }
+    static LS_INLINE float_t min(float_t a, float_t b) noexcept { return vminq_f32(a, b); }
+    static LS_INLINE float_t max(float_t a, float_t b) noexcept { return vmaxq_f32(a, b); }
+
+    static LS_INLINE float_t div(float_t a, float_t b) noexcept
+    {
+        #if defined(LS_ARCH_AARCH64)
+            return vdivq_f32(a, b);
+        #else
+            float32x4_t r = vrecpeq_f32(b);
+            r = vmulq_f32(vrecpsq_f32(b, r), r);
+            r = vmulq_f32(vrecpsq_f32(b, r), r);
+            return vmulq_f32(a, r);
+        #endif
+    }
+
+    static LS_INLINE float_t sqrt(float_t x) noexcept
+    {
+        #if defined(LS_ARCH_AARCH64)
+            return vsqrtq_f32(x);
+        #else
+            float32x4_t r = vrsqrteq_f32(x);
+            r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+            r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+            return vbslq_f32(vceqq_f32(x, vdupq_n_f32(0.f)), x, vmulq_f32(x, r));
+        #endif
+    }
+
+    static LS_INLINE float_t fmadd(float_t a, float_t b, float_t c) noexcept
+    {
+        #if defined(LS_ARCH_AARCH64)
+            return vfmaq_f32(c, a, b);
+        #else
+            return vmlaq_f32(c, a, b);
+        #endif
+    }
+
+    static LS_INLINE float_t abs(float_t x) noexcept { return vabsq_f32(x); }
+    static LS_INLINE float_t sign(float_t x) noexcept { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000u))); }
+    static LS_INLINE float_t bit_xor(float_t a, float_t b) noexcept { return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+    static LS_INLINE float_t bit_or(float_t a, float_t b) noexcept { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+
+    static LS_INLINE mask_t cmp_lt(float_t a, float_t b) noexcept { return vcltq_f32(a, b); }
+    static LS_INLINE mask_t cmp_gt(float_t a, float_t b) noexcept { return vcgtq_f32(a, b); }
+    static LS_INLINE mask_t cmp_eq(float_t a, float_t b) noexcept { return vceqq_f32(a, b); }
+    static LS_INLINE mask_t cmp_unord(float_t a, float_t b) noexcept { return vmvnq_u32(vandq_u32(vceqq_f32(a, a), vceqq_f32(b, b))); }
+    static LS_INLINE mask_t cmp_signbit(float_t x) noexcept { return vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_f32(x), 31)); }
+    static LS_INLINE float_t select(mask_t m, float_t a, float_t b) noexcept { return vbslq_f32(m, a, b); }
+
+    static LS_INLINE int_t cvtt(float_t x) noexcept { return vcvtq_s32_f32(x); }
+    static LS_INLINE float_t cvt(int_t x) noexcept { return vcvtq_f32_s32(x); }
+    static LS_INLINE int_t iset1(int x) noexcept { return vdupq_n_s32(x); }
+    static LS_INLINE int_t iadd(int_t a, int_t b) noexcept { return vaddq_s32(a, b); }
+    static LS_INLINE int_t isub(int_t a, int_t b) noexcept { return vsubq_s32(a, b); }
+    static LS_INLINE int_t iand(int_t a, int_t b) noexcept { return vandq_s32(a, b); }
+    static LS_INLINE int_t ior(int_t a, int_t b) noexcept { return vorrq_s32(a, b); }
+    static LS_INLINE mask_t ieq(int_t a, int_t b) noexcept { return vceqq_s32(a, b); }
+    static LS_INLINE float_t as_float(int_t x) noexcept { return vreinterpretq_f32_s32(x); }
+    static LS_INLINE int_t as_int(float_t x) noexcept { return vreinterpretq_s32_f32(x); }
+
+    template <int n>
+    static LS_INLINE int_t ishl(int_t x) noexcept { return vshlq_n_s32(x, n); }
+
+    template <int n>
+    static LS_INLINE int_t ishr(int_t x) noexcept { return vshrq_n_s32(x, n); }
+
+    static LS_INLINE float_t load(const float* p) noexcept { return vld1q_f32(p); }
+    static LS_INLINE void store(float* p, float_t x) noexcept { vst1q_f32(p, x); }
+
+    static LS_INLINE float reduce_add(float_t x) noexcept
+    {
+        #if defined(LS_ARCH_AARCH64)
+            return vaddvq_f32(x);
+        #else
+            const float32x2_t s = vadd_f32(vget_low_f32(x), vget_high_f32(x));
+            return vget_lane_f32(vpadd_f32(s, s), 0);
+        #endif
+    }
+
+    // Transpose four registers as rows of a 4x4 matrix
+    static LS_INLINE void transpose(float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        const float32x4x2_t ab = vtrnq_f32(a, b);
+        const float32x4x2_t cd = vtrnq_f32(c, d);
+        a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+        b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+        c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+        d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+    }
+
+    // Load "width" 4-component vectors from separate addresses, transposed so
+    // each register holds one component
+    static LS_INLINE void gather_soa4(const float* const* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        a = vld1q_f32(p[0]);
+        b = vld1q_f32(p[1]);
+        c = vld1q_f32(p[2]);
+        d = vld1q_f32(p[3]);
+        transpose(a, b, c, d);
+    }
+
+    // Load "width" consecutive 4-component vectors, transposed so each
+    // register holds one component
+    static LS_INLINE void load_soa4(const float* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        const float32x4x4_t v = vld4q_f32(p);
+        a = v.val[0];
+        b = v.val[1];
+        c = v.val[2];
+        d = v.val[3];
+    }
+
+    static LS_INLINE void store_soa4(float* p, float_t a, float_t b, float_t c, float_t d) noexcept
+    {
+        const float32x4x4_t v = {{a, b, c, d}};
+        vst4q_f32(p, v);
+    }
+
+    // Load four consecutive 3-component vectors, de-interleaved so each
+    // register holds one component
+    static LS_INLINE void load_soa3(const float* p, float_t& x, float_t& y, float_t& z) noexcept
+    {
+        const float32x4x3_t v = vld3q_f32(p);
+        x = v.val[0];
+        y = v.val[1];
+        z = v.val[2];
+    }
+
+    static LS_INLINE void store_soa3(float* p, float_t x, float_t y, float_t z) noexcept
+    {
+        const float32x4x3_t v = {{x, y, z}};
+        vst3q_f32(p, v);
+    }
+
+    static LS_INLINE float_t load_partial(const float* p, unsigned n) noexcept
+    {
+        float temp[4] = {0.f, 0.f, 0.f, 0.f};
+        for (unsigned i = 0; i < n; ++i)
+        {
+            temp[i] = p[i];
+        }
+        return vld1q_f32(temp);
+    }
+
+    static LS_INLINE void store_partial(float* p, float_t x, unsigned n) noexcept
+    {
+        float temp[4];
+        vst1q_f32(temp, x);
+        for (unsigned i = 0; i < n; ++i)
+        {
+            p[i] = temp[i];
+        }
+    }
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMDF_TRAITS_IMPL_H */
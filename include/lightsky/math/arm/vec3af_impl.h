@@ -0,0 +1,422 @@
+
+#ifndef LS_MATH_VEC3AF_IMPL_H
+#define LS_MATH_VEC3AF_IMPL_H
+
+#include <type_traits>
+
+#include <arm_neon.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+
+
+namespace ls
+{
+namespace math
+{
+
+
+
+template<>
+union alignas(alignof(float32x4_t)) vec3a_t<float>
+{
+    typedef float value_type;
+    static constexpr unsigned num_components() noexcept { return 3; }
+
+    // data
+    float v[4];
+
+    float32x4_t simd;
+
+    // Main Constructor
+    constexpr vec3a_t(float inX, float inY, float inZ);
+
+    // Delegated Constructors
+    vec3a_t() = default;
+
+    explicit constexpr vec3a_t(float32x4_t n);
+
+    vec3a_t(float n);
+
+    vec3a_t(const vec3a_t<float>& input) = default;
+
+    vec3a_t(vec3a_t<float>&& input) = default;
+
+    ~vec3a_t() = default;
+
+    // Conversions & Casting
+    template<typename other_t>
+    inline explicit operator vec3a_t<other_t>() const;
+
+    const float* operator&() const;
+
+    inline float* operator&();
+
+    // Subscripting Operators
+    template <typename index_t>
+    inline float operator[](index_t i) const;
+
+    template <typename index_t>
+    inline float& operator[](index_t i);
+
+    // vector-vector operators
+    vec3a_t operator+(const vec3a_t<float>&) const;
+
+    vec3a_t operator-(const vec3a_t<float>&) const;
+
+    vec3a_t operator-() const;
+
+    vec3a_t operator*(const vec3a_t<float>&) const;
+
+    vec3a_t operator/(const vec3a_t<float>&) const;
+
+    vec3a_t& operator=(const vec3a_t<float>&) noexcept = default;
+
+    vec3a_t& operator=(vec3a_t<float>&&) noexcept = default;
+
+    vec3a_t& operator+=(const vec3a_t<float>&);
+
+    vec3a_t& operator-=(const vec3a_t<float>&);
+
+    vec3a_t& operator*=(const vec3a_t<float>&);
+
+    vec3a_t& operator/=(const vec3a_t<float>&);
+
+    vec3a_t& operator++(); //prefix operators
+    vec3a_t& operator--();
+
+    vec3a_t operator++(int); //postfix operators
+    vec3a_t operator--(int);
+
+    inline bool operator==(const vec3a_t<float>& compare) const; //comparisons
+
+    inline bool operator!=(const vec3a_t<float>& compare) const;
+
+    inline bool operator<(const vec3a_t<float>& compare) const;
+
+    inline bool operator>(const vec3a_t<float>& compare) const;
+
+    inline bool operator<=(const vec3a_t<float>& compare) const;
+
+    inline bool operator>=(const vec3a_t<float>& compare) const;
+
+    // vector-scalar operators
+    vec3a_t operator=(float);
+
+    inline vec3a_t operator+(float) const;
+
+    inline vec3a_t operator-(float) const;
+
+    inline vec3a_t operator*(float) const;
+
+    inline vec3a_t operator/(float) const;
+
+    vec3a_t& operator+=(float);
+
+    vec3a_t& operator-=(float);
+
+    vec3a_t& operator*=(float);
+
+    vec3a_t& operator/=(float);
+};
+
+static_assert(std::is_trivial<vec3a_t<float>>::value, "Vec3af must be trivial.");
+static_assert(sizeof(vec3a_t<float>) == sizeof(float32x4_t), "Vec3af must fill a SIMD register.");
+
+namespace impl
+{
+
+/*-------------------------------------
+    Division of all lanes
+-------------------------------------*/
+inline LS_INLINE float32x4_t vec3af_div(const float32x4_t a, const float32x4_t b) noexcept
+{
+    #ifdef LS_ARCH_AARCH64
+        return vdivq_f32(a, b);
+    #else
+        const float32x4_t recip = vrecpeq_f32(b);
+        return vmulq_f32(a, vmulq_f32(vrecpsq_f32(b, recip), recip));
+    #endif
+}
+
+} // end impl namespace
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+// Main Constructor
+constexpr LS_INLINE vec3a_t<float>::vec3a_t(float inX, float inY, float inZ) :
+    v{inX, inY, inZ, 0.f}
+{
+}
+
+inline LS_INLINE vec3a_t<float>::vec3a_t(float n) :
+    simd(vdupq_n_f32(n))
+{
+}
+
+constexpr LS_INLINE vec3a_t<float>::vec3a_t(const float32x4_t n) :
+    simd(n)
+{
+}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template<typename other_t>
+inline LS_INLINE vec3a_t<float>::operator vec3a_t<other_t>() const
+{
+    return vec3a_t<other_t>{(other_t)v[0], (other_t)v[1], (other_t)v[2]};
+}
+
+inline LS_INLINE const float* vec3a_t<float>::operator&() const
+{
+    return reinterpret_cast<const float*>(this);
+}
+
+inline LS_INLINE float* vec3a_t<float>::operator&()
+{
+    return reinterpret_cast<float*>(this);
+}
+
+/*-------------------------------------
+    Subscripting Operators
+-------------------------------------*/
+template <typename index_t>
+inline LS_INLINE float vec3a_t<float>::operator[](index_t i) const
+{
+    return v[i];
+}
+
+template <typename index_t>
+inline LS_INLINE float& vec3a_t<float>::operator[](index_t i)
+{
+    return v[i];
+}
+
+/*-------------------------------------
+    Vector-Vector Math Operations
+-------------------------------------*/
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator+(const vec3a_t<float>& input) const
+{
+    return vec3a_t{vaddq_f32(simd, input.simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator-(const vec3a_t<float>& input) const
+{
+    return vec3a_t{vsubq_f32(simd, input.simd)};
+}
+
+//for operations like "vectA = -vectB"
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator-() const
+{
+    return vec3a_t{vnegq_f32(simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator*(const vec3a_t<float>& input) const
+{
+    return vec3a_t{vmulq_f32(simd, input.simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator/(const vec3a_t<float>& input) const
+{
+    return vec3a_t{impl::vec3af_div(simd, input.simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator+=(const vec3a_t<float>& input)
+{
+    this->simd = vaddq_f32(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator-=(const vec3a_t<float>& input)
+{
+    this->simd = vsubq_f32(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator*=(const vec3a_t<float>& input)
+{
+    this->simd = vmulq_f32(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator/=(const vec3a_t<float>& input)
+{
+    this->simd = impl::vec3af_div(simd, input.simd);
+    return *this;
+}
+
+// prefix operations
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator++()
+{
+    this->simd = vaddq_f32(simd, vdupq_n_f32(1.f));
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator--()
+{
+    this->simd = vsubq_f32(simd, vdupq_n_f32(1.f));
+    return *this;
+}
+
+//postfix operations
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator++(int)
+{
+    const float32x4_t ret = simd;
+    this->simd = vaddq_f32(simd, vdupq_n_f32(1.f));
+    return vec3a_t<float>{ret};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator--(int)
+{
+    const float32x4_t ret = simd;
+    this->simd = vsubq_f32(simd, vdupq_n_f32(1.f));
+    return vec3a_t<float>{ret};
+}
+
+//comparisons, with the padding element masked off
+
+namespace impl
+{
+
+/*-------------------------------------
+    Test that the XYZ lanes of a comparison are all set
+-------------------------------------*/
+inline LS_INLINE bool vec3af_all(const uint32x4_t cmp) noexcept
+{
+    const uint32x4_t xyz = vsetq_lane_u32(0xFFFFFFFFu, cmp, 3);
+
+    #ifdef LS_ARCH_AARCH64
+        return vminvq_u32(xyz) != 0;
+    #else
+        const uint32x2_t m = vand_u32(vget_low_u32(xyz), vget_high_u32(xyz));
+        return (vget_lane_u32(m, 0) & vget_lane_u32(m, 1)) != 0;
+    #endif
+}
+
+} // end impl namespace
+
+inline LS_INLINE bool vec3a_t<float>::operator==(const vec3a_t<float>& compare) const
+{
+    return impl::vec3af_all(vceqq_f32(simd, compare.simd));
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator!=(const vec3a_t<float>& compare) const
+{
+    return !impl::vec3af_all(vceqq_f32(simd, compare.simd));
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator<(const vec3a_t<float>& compare) const
+{
+    return impl::vec3af_all(vcltq_f32(simd, compare.simd));
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator>(const vec3a_t<float>& compare) const
+{
+    return impl::vec3af_all(vcgtq_f32(simd, compare.simd));
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator<=(const vec3a_t<float>& compare) const
+{
+    return impl::vec3af_all(vcleq_f32(simd, compare.simd));
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator>=(const vec3a_t<float>& compare) const
+{
+    return impl::vec3af_all(vcgeq_f32(simd, compare.simd));
+}
+
+/*-------------------------------------
+    Vector-Scalar Math Operations
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator=(float input)
+{
+    this->simd = vdupq_n_f32(input);
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator+(float input) const
+{
+    return vec3a_t<float>{vaddq_f32(simd, vdupq_n_f32(input))};
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator-(float input) const
+{
+    return vec3a_t<float>{vsubq_f32(simd, vdupq_n_f32(input))};
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator*(float input) const
+{
+    return vec3a_t<float>{vmulq_f32(simd, vdupq_n_f32(input))};
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator/(float input) const
+{
+    return vec3a_t<float>{impl::vec3af_div(simd, vdupq_n_f32(input))};
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator+=(float input)
+{
+    this->simd = vaddq_f32(simd, vdupq_n_f32(input));
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator-=(float input)
+{
+    this->simd = vsubq_f32(simd, vdupq_n_f32(input));
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator*=(float input)
+{
+    this->simd = vmulq_f32(simd, vdupq_n_f32(input));
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator/=(float input)
+{
+    this->simd = impl::vec3af_div(simd, vdupq_n_f32(input));
+    return *this;
+}
+
+/*-------------------------------------
+    Non-Member Vector-Scalar operations
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> operator+(float n, const vec3a_t<float>& v)
+{
+    return v + n;
+}
+
+inline LS_INLINE vec3a_t<float> operator-(float n, const vec3a_t<float>& v)
+{
+    return vec3a_t<float>{vsubq_f32(vdupq_n_f32(n), v.simd)};
+}
+
+inline LS_INLINE vec3a_t<float> operator*(float n, const vec3a_t<float>& v)
+{
+    return v * n;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_VEC3AF_IMPL_H */
@@ -0,0 +1,100 @@
+
+#ifndef LS_MATH_VECD_UTILS_IMPL_H
+#define LS_MATH_VECD_UTILS_IMPL_H
+
+#include <arm_neon.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+namespace math
+{
+
+
+
+#if defined(LS_ARCH_AARCH64)
+
+/*-----------------------------------------------------------------------------
+    4D Vectors
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    4D Cross
+-------------------------------------*/
+inline LS_INLINE vec4_t<double> cross(const vec4_t<double>& v1, const vec4_t<double>& v2) noexcept
+{
+    vec4_t<double> ret;
+
+    const float64x2_t xyA = vld1q_f64(v1.v);
+    const float64x2_t zwA = vld1q_f64(v1.v+2);
+    const float64x2_t xyB = vld1q_f64(v2.v);
+    const float64x2_t zwB = vld1q_f64(v2.v+2);
+
+    // (y, z) and (x, w) of each input
+    const float64x2_t yzA = vextq_f64(xyA, zwA, 1);
+    const float64x2_t xwA = vcopyq_laneq_f64(zwA, 0, xyA, 0);
+    const float64x2_t yzB = vextq_f64(xyB, zwB, 1);
+    const float64x2_t xwB = vcopyq_laneq_f64(zwB, 0, xyB, 0);
+
+    const float64x2_t lo = vfmsq_f64(vmulq_f64(xyA, yzB), yzA, xyB);
+    const float64x2_t hi = vfmsq_f64(vmulq_f64(zwA, xwB), xwA, zwB);
+
+    vst1q_f64(ret.v,   vextq_f64(lo, hi, 1));
+    vst1q_f64(ret.v+2, vcopyq_laneq_f64(hi, 0, lo, 0));
+
+    return ret;
+}
+
+/*-------------------------------------
+    4D Dot
+-------------------------------------*/
+inline LS_INLINE double dot(const vec4_t<double>& v1, const vec4_t<double>& v2) noexcept
+{
+    const float64x2_t a = vmulq_f64(vld1q_f64(v1.v), vld1q_f64(v2.v));
+    const float64x2_t b = vfmaq_f64(a, vld1q_f64(v1.v+2), vld1q_f64(v2.v+2));
+    return vaddvq_f64(b);
+}
+
+/*-------------------------------------
+    4D Magnitude (squared)
+-------------------------------------*/
+inline LS_INLINE double length_squared(const vec4_t<double>& v) noexcept
+{
+    return math::dot(v, v);
+}
+
+/*-------------------------------------
+    4D Magnitude
+-------------------------------------*/
+inline LS_INLINE double length(const vec4_t<double>& v) noexcept
+{
+    return vget_lane_f64(vsqrt_f64(vdup_n_f64(math::dot(v, v))), 0);
+}
+
+/*-------------------------------------
+    4D Normalize
+-------------------------------------*/
+inline LS_INLINE vec4_t<double> normalize(const vec4_t<double>& v) noexcept
+{
+    // Full-precision square root & division, matching the generic version
+    vec4_t<double> ret;
+
+    const float64x2_t lo = vld1q_f64(v.v);
+    const float64x2_t hi = vld1q_f64(v.v+2);
+    const float64x2_t l2 = vdupq_n_f64(vaddvq_f64(vfmaq_f64(vmulq_f64(lo, lo), hi, hi)));
+    const float64x2_t len = vsqrtq_f64(l2);
+
+    vst1q_f64(ret.v,   vdivq_f64(lo, len));
+    vst1q_f64(ret.v+2, vdivq_f64(hi, len));
+
+    return ret;
+}
+
+#endif /* LS_ARCH_AARCH64 */
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_VECD_UTILS_IMPL_H */
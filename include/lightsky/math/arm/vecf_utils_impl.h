@@ -6,6 +6,9 @@
 
 #include "lightsky/setup/Api.h" // LS_INLINE
 
+#include "lightsky/math/generic/simd_trig_impl.h"
+#include "lightsky/math/arm/simdf_traits_impl.h"
+
 namespace ls
 {
 namespace math
@@ -348,13 +351,311 @@ inline LS_INLINE vec4_t<float> fmadd(const vec4_t<float>& x, const vec4_t<float>
 inline LS_INLINE vec4_t<float> fmsub(const vec4_t<float>& x, const vec4_t<float>& m, const vec4_t<float>& a) noexcept
 {
     #if defined(LS_ARCH_AARCH64)
-        return vec4_t<float>{vfmsq_f32(a.simd, m.simd, x.simd)};
+        return vec4_t<float>{vnegq_f32(vfmsq_f32(a.simd, m.simd, x.simd))};
     #else
         return vec4_t<float>{vmlaq_f32(vnegq_f32(a.simd), m.simd, x.simd)};
     #endif
 }
 
 
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> sin(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_sin<impl::SimdTraits128>(x.simd)};
+}
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> cos(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_cos<impl::SimdTraits128>(x.simd)};
+}
+
+/*-------------------------------------
+    4D sincos
+-------------------------------------*/
+inline LS_INLINE void sincos(const vec4_t<float>& x, vec4_t<float>& outSin, vec4_t<float>& outCos) noexcept
+{
+    impl::simd_sincos<impl::SimdTraits128>(x.simd, outSin.simd, outCos.simd);
+}
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> tan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_tan<impl::SimdTraits128>(x.simd)};
+}
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_atan<impl::SimdTraits128>(x.simd)};
+}
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan2(const vec4_t<float>& y, const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_atan2<impl::SimdTraits128>(y.simd, x.simd)};
+}
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> asin(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_asin<impl::SimdTraits128>(x.simd)};
+}
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> acos(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_acos<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    3D Aligned Vectors
+
+    The padding element of each register must be masked out of horizontal
+    operations. Element-wise operations reuse the 4D implementations.
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Sum of the X, Y, and Z elements
+-------------------------------------*/
+inline LS_INLINE float vec3af_sum(const float32x4_t a) noexcept
+{
+    const float32x2_t xy = vget_low_f32(a);
+    return vget_lane_f32(vpadd_f32(xy, xy), 0) + vgetq_lane_f32(a, 2);
+}
+
+} // end impl namespace
+
+/*-------------------------------------
+    Aligned 3D Sum
+-------------------------------------*/
+inline LS_INLINE float sum(const vec3a_t<float>& v) noexcept
+{
+    return impl::vec3af_sum(v.simd);
+}
+
+/*-------------------------------------
+    Aligned 3D Reciprocal Sum
+-------------------------------------*/
+inline LS_INLINE float sum_inv(const vec3a_t<float>& v) noexcept
+{
+    return 1.f / impl::vec3af_sum(v.simd);
+}
+
+/*-------------------------------------
+    Aligned 3D Dot
+-------------------------------------*/
+inline LS_INLINE float dot(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return impl::vec3af_sum(vmulq_f32(v1.simd, v2.simd));
+}
+
+/*-------------------------------------
+    Aligned 3D Cross
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> cross(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return vec3a_t<float>{math::cross(vec4_t<float>{v1.simd}, vec4_t<float>{v2.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Magnitude (squared)
+-------------------------------------*/
+inline LS_INLINE float length_squared(const vec3a_t<float>& v) noexcept
+{
+    return impl::vec3af_sum(vmulq_f32(v.simd, v.simd));
+}
+
+/*-------------------------------------
+    Aligned 3D Magnitude
+-------------------------------------*/
+inline LS_INLINE float length(const vec3a_t<float>& v) noexcept
+{
+    return std::sqrt(impl::vec3af_sum(vmulq_f32(v.simd, v.simd)));
+}
+
+/*-------------------------------------
+    Aligned 3D Normalize
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> normalize(const vec3a_t<float>& v) noexcept
+{
+    // Full-precision square root & division, matching the packed 3D version
+    return v / std::sqrt(impl::vec3af_sum(vmulq_f32(v.simd, v.simd)));
+}
+
+/*-------------------------------------
+    Aligned 3D Reflect
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> reflect(const vec3a_t<float>& v, const vec3a_t<float>& norm) noexcept
+{
+    const float d = impl::vec3af_sum(vmulq_f32(v.simd, norm.simd));
+    return vec3a_t<float>{vmlsq_n_f32(v.simd, norm.simd, d + d)};
+}
+
+/*-------------------------------------
+    Aligned 3D Sign Bits
+-------------------------------------*/
+inline LS_INLINE int sign_mask(const vec3a_t<float>& x) noexcept
+{
+    return math::sign_mask(vec4_t<float>{x.simd}) & 0x07;
+}
+
+/*-------------------------------------
+    Aligned 3D Min
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> min(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return vec3a_t<float>{math::min(vec4_t<float>{v1.simd}, vec4_t<float>{v2.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Max
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> max(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return vec3a_t<float>{math::max(vec4_t<float>{v1.simd}, vec4_t<float>{v2.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Clamp
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> clamp(const vec3a_t<float>& v, const vec3a_t<float>& minVals, const vec3a_t<float>& maxVals) noexcept
+{
+    return vec3a_t<float>{math::clamp(vec4_t<float>{v.simd}, vec4_t<float>{minVals.simd}, vec4_t<float>{maxVals.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Saturate
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> saturate(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::saturate(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Step
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> step(const vec3a_t<float>& edge, const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::step(vec4_t<float>{edge.simd}, vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D RCP
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> rcp(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::rcp(vec4_t<float>{v.simd}).simd};
+}
+
+#if defined(LS_ARCH_AARCH64)
+/*-------------------------------------
+    Aligned 3D floor
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> floor(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::floor(vec4_t<float>{v.simd}).simd};
+}
+#endif
+
+#if defined(LS_ARCH_AARCH64)
+/*-------------------------------------
+    Aligned 3D ceil
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> ceil(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::ceil(vec4_t<float>{v.simd}).simd};
+}
+#endif
+
+#if defined(LS_ARCH_AARCH64)
+/*-------------------------------------
+    Aligned 3D round
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> round(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::round(vec4_t<float>{v.simd}).simd};
+}
+#endif
+
+/*-------------------------------------
+    Aligned 3D abs
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> abs(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::abs(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D FMA
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> fmadd(const vec3a_t<float>& x, const vec3a_t<float>& m, const vec3a_t<float>& a) noexcept
+{
+    return vec3a_t<float>{math::fmadd(vec4_t<float>{x.simd}, vec4_t<float>{m.simd}, vec4_t<float>{a.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D FMS
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> fmsub(const vec3a_t<float>& x, const vec3a_t<float>& m, const vec3a_t<float>& a) noexcept
+{
+    return vec3a_t<float>{math::fmsub(vec4_t<float>{x.simd}, vec4_t<float>{m.simd}, vec4_t<float>{a.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Vector from 3D
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> vec3a_cast(const vec3_t<float>& v) noexcept
+{
+    return vec3a_t<float>{vcombine_f32(vld1_f32(v.v), vld1_dup_f32(v.v+2))};
+}
+
+/*-------------------------------------
+    Aligned 3D Vector from 4D
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> vec3a_cast(const vec4_t<float>& v) noexcept
+{
+    return vec3a_t<float>{v.simd};
+}
+
+/*-------------------------------------
+    3D Vector from Aligned 3D
+-------------------------------------*/
+inline LS_INLINE vec3_t<float> vec3_cast(const vec3a_t<float>& v) noexcept
+{
+    vec3_t<float> ret;
+    vst1_f32(ret.v, vget_low_f32(v.simd));
+    vst1q_lane_f32(ret.v+2, v.simd, 2);
+    return ret;
+}
+
+/*-------------------------------------
+    4D Vector from Aligned 3D & Scalar
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> vec4_cast(const vec3a_t<float>& v, const float& s) noexcept
+{
+    return vec4_t<float>{vsetq_lane_f32(s, v.simd, 3)};
+}
+
+
 
 } // end math namespace
 } // end ls namespace
@@ -0,0 +1,44 @@
+
+#ifndef LS_MATH_VECNF_IMPL_H
+#define LS_MATH_VECNF_IMPL_H
+
+#include <type_traits> // std::conditional_t
+
+#include "lightsky/math/generic/simd_vecn_impl.h"
+#include "lightsky/math/arm/simdf_traits_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-------------------------------------
+    Select the widest register which fits within N floats
+-------------------------------------*/
+struct VecNSelectf
+{
+    template <unsigned N>
+    using traits = std::conditional_t<(N >= 4), SimdTraits128, SimdTraitsScalar>;
+};
+
+
+
+/*-------------------------------------
+    Single-precision N-dimensional vectors
+-------------------------------------*/
+template <>
+struct VecNSimd<float> : VecNSimdKernels<VecNSelectf>
+{
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_VECNF_IMPL_H */
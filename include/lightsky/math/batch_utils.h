@@ -0,0 +1,368 @@
+
+#ifndef LS_MATH_BATCH_UTILS_H
+#define LS_MATH_BATCH_UTILS_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86, LS_ARM_NEON
+
+#include "lightsky/math/mat3.h"
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/quat_utils.h"
+#include "lightsky/math/vec_utils.h"
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Trigonometric Functions
+
+    Each of these functions evaluates an entire array of numbers. Single-
+    precision versions use the widest SIMD registers available (16 floats
+    with AVX-512, 8 with AVX2, 4 with SSE or NEON) and handle array lengths
+    which are not a multiple of the SIMD width without reading or writing
+    beyond the end of any array. Input and output arrays may alias each other
+    exactly, but must not otherwise overlap.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Calculate the sine of every number in an array.
+ *
+ * @param x
+ * An array of angles, in radians.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain the sine of each
+ * angle.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void sin_batch(const N* x, N* out, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the cosine of every number in an array.
+ *
+ * @param x
+ * An array of angles, in radians.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain the cosine of each
+ * angle.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void cos_batch(const N* x, N* out, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the sine & cosine of every number in an array.
+ *
+ * @param x
+ * An array of angles, in radians.
+ *
+ * @param outSin
+ * An array of at least "count" elements which will contain the sine of each
+ * angle.
+ *
+ * @param outCos
+ * An array of at least "count" elements which will contain the cosine of each
+ * angle.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void sincos_batch(const N* x, N* outSin, N* outCos, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the tangent of every number in an array.
+ *
+ * @param x
+ * An array of angles, in radians.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain the tangent of each
+ * angle.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void tan_batch(const N* x, N* out, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the arc-tangent of every number in an array.
+ *
+ * @param x
+ * An array of tangent values.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain the arc-tangent of
+ * each value.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void atan_batch(const N* x, N* out, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the arc-tangent of y/x for every pair of numbers in two
+ * arrays.
+ *
+ * @param y
+ * An array of lengths along the y-axis.
+ *
+ * @param x
+ * An array of lengths along the x-axis.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain each angle.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void atan2_batch(const N* y, const N* x, N* out, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the arc-sine of every number in an array.
+ *
+ * @param x
+ * An array of values within [-1, 1].
+ *
+ * @param out
+ * An array of at least "count" elements which will contain the arc-sine of
+ * each value.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void asin_batch(const N* x, N* out, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the arc-cosine of every number in an array.
+ *
+ * @param x
+ * An array of values within [-1, 1].
+ *
+ * @param out
+ * An array of at least "count" elements which will contain the arc-cosine of
+ * each value.
+ *
+ * @param count
+ * The number of elements to evaluate.
+ */
+template <typename N>
+void acos_batch(const N* x, N* out, std::size_t count) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Matrix Operations
+
+    3x3 matrices are used to transform normals, tangents, and 2D points, often
+    many thousands at a time. These functions have the same aliasing rules as
+    the batched trigonometric functions.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Multiply two arrays of 3x3 matrices, such that out[i] = a[i] * b[i].
+ *
+ * @param a
+ * An array of at least "count" matrices on the left-hand side of each product.
+ *
+ * @param b
+ * An array of at least "count" matrices on the right-hand side of each product.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain each product.
+ *
+ * @param count
+ * The number of matrices to multiply.
+ */
+template <typename N>
+void mat3_mul_batch(const mat3_t<N>* a, const mat3_t<N>* b, mat3_t<N>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Transform an array of 3D vectors by a single 3x3 matrix, such that
+ * out[i] = m * v[i].
+ *
+ * @param m
+ * The matrix to transform each vector by.
+ *
+ * @param v
+ * An array of at least "count" vectors.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain each transformed
+ * vector.
+ *
+ * @param count
+ * The number of vectors to transform.
+ */
+template <typename N>
+void mat3_transform_batch(const mat3_t<N>& m, const vec3_t<N>* v, vec3_t<N>* out, std::size_t count) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Quaternion Interpolation
+
+    Animation tracks are sampled by interpolating many pairs of keyframes at
+    once. Each function interpolates out[i] from a[i] towards b[i] by t[i],
+    following the shortest path between the two rotations. These functions
+    have the same aliasing rules as the batched trigonometric functions.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Spherically interpolate two arrays of quaternions.
+ *
+ * Single-precision results are within 1e-6 of the exact interpolation of
+ * two unit quaternions.
+ *
+ * @param a
+ * An array of at least "count" quaternions to interpolate from.
+ *
+ * @param b
+ * An array of at least "count" quaternions to interpolate towards.
+ *
+ * @param t
+ * An array of at least "count" interpolation percentages, within [0, 1].
+ *
+ * @param out
+ * An array of at least "count" elements which will contain each
+ * interpolated quaternion.
+ *
+ * @param count
+ * The number of quaternions to interpolate.
+ */
+template <typename N>
+void slerp_batch(const quat_t<N>* a, const quat_t<N>* b, const N* t, quat_t<N>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Spherically interpolate two arrays of quaternions using a
+ * polynomial approximation, without trigonometric functions or branches.
+ *
+ * The approximation is from David Eberly's "A Fast and Accurate Algorithm
+ * for Computing SLERP". Results are within 3e-5 of the exact interpolation
+ * of two unit quaternions, and within 2e-6 when the rotations are within 120
+ * degrees of each other (a dot product of at least 0.5).
+ *
+ * @param a
+ * An array of at least "count" quaternions to interpolate from.
+ *
+ * @param b
+ * An array of at least "count" quaternions to interpolate towards.
+ *
+ * @param t
+ * An array of at least "count" interpolation percentages, within [0, 1].
+ *
+ * @param out
+ * An array of at least "count" elements which will contain each
+ * interpolated quaternion.
+ *
+ * @param count
+ * The number of quaternions to interpolate.
+ */
+template <typename N>
+void fast_slerp_batch(const quat_t<N>* a, const quat_t<N>* b, const N* t, quat_t<N>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Linearly interpolate & normalize two arrays of quaternions.
+ *
+ * Unlike nlerp(), the second quaternion of each pair is negated when
+ * necessary so interpolation follows the shortest path. Results always lie
+ * on the same arc as slerp_batch(), but do not rotate at a constant speed.
+ *
+ * @param a
+ * An array of at least "count" quaternions to interpolate from.
+ *
+ * @param b
+ * An array of at least "count" quaternions to interpolate towards.
+ *
+ * @param t
+ * An array of at least "count" interpolation percentages, within [0, 1].
+ *
+ * @param out
+ * An array of at least "count" elements which will contain each
+ * interpolated quaternion.
+ *
+ * @param count
+ * The number of quaternions to interpolate.
+ */
+template <typename N>
+void nlerp_batch(const quat_t<N>* a, const quat_t<N>* b, const N* t, quat_t<N>* out, std::size_t count) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Transform Composition
+
+    Editors and network code convert between matrices and separate
+    translation, rotation, & scale values for many objects at once. These
+    functions have the same aliasing rules as the batched trigonometric
+    functions, and single-precision versions process four transforms at a
+    time using SIMD registers.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Create an array of matrices using compose_trs(), such that
+ * out[i] = translate(t[i]) * rotate(r[i]) * scale(s[i]).
+ *
+ * @param t
+ * An array of at least "count" translations.
+ *
+ * @param r
+ * An array of at least "count" unit quaternions.
+ *
+ * @param s
+ * An array of at least "count" scales.
+ *
+ * @param out
+ * An array of at least "count" elements which will contain each matrix.
+ *
+ * @param count
+ * The number of matrices to create.
+ */
+template <typename N>
+void compose_trs_batch(const vec3_t<N>* t, const quat_t<N>* r, const vec3_t<N>* s, mat4_t<N>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Split an array of affine matrices into translations, rotations, and
+ * scales using decompose().
+ *
+ * @param m
+ * An array of at least "count" affine matrices.
+ *
+ * @param outT
+ * An array of at least "count" elements which will contain each translation.
+ *
+ * @param outR
+ * An array of at least "count" elements which will contain each rotation.
+ *
+ * @param outS
+ * An array of at least "count" elements which will contain each scale.
+ *
+ * @param count
+ * The number of matrices to decompose.
+ */
+template <typename N>
+void decompose_batch(const mat4_t<N>* m, vec3_t<N>* outT, quat_t<N>* outR, vec3_t<N>* outS, std::size_t count) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/batch_utils_impl.h"
+
+#ifdef LS_ARCH_X86
+    #include "lightsky/math/x86/batchf_utils_impl.h"
+#elif defined(LS_ARM_NEON)
+    #include "lightsky/math/arm/batchf_utils_impl.h"
+#endif
+
+#endif /* LS_MATH_BATCH_UTILS_H */
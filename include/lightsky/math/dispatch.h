@@ -0,0 +1,212 @@
+
+#ifndef LS_MATH_DISPATCH_H
+#define LS_MATH_DISPATCH_H
+
+#include <cstddef> // std::size_t
+#include <cstdint> // uint32_t, uint16_t
+
+namespace ls {
+namespace math {
+
+struct half;
+
+template <typename num_t>
+union vec4_t;
+
+template <typename num_t>
+struct mat4_t;
+
+
+
+/*-----------------------------------------------------------------------------
+    Runtime CPU Feature Dispatch
+
+    The inline math functions in this library are compiled for whichever
+    instruction set the application was built with. The functions in this
+    header are instead compiled once for each supported instruction set and
+    the fastest variant available on the running CPU is selected the first
+    time any of them are called. Applications may therefore be built for a
+    conservative baseline (such as SSE2) while still running AVX2 or AVX-512
+    code on capable hardware.
+
+    The environment variable "LS_MATH_SIMD_LEVEL" may contain the name of a
+    SIMD level (see simd_level_name()) to cap the variant selected at
+    startup.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Instruction set levels which batch kernels can be dispatched to.
+ *
+ * Levels are ordered such that a higher level implies support for all
+ * previous levels on the same architecture.
+ */
+enum SimdLevel : unsigned
+{
+    SIMD_LEVEL_GENERIC, // Inline library code, as compiled by the application
+    SIMD_LEVEL_SSE2,
+    SIMD_LEVEL_SSE4_1,
+    SIMD_LEVEL_AVX2,    // AVX2 + FMA + F16C
+    SIMD_LEVEL_AVX512,  // AVX-512 F + VL + BW + DQ
+    SIMD_LEVEL_NEON
+};
+
+/**
+ * @brief Individual CPU features, reported as bit flags by cpu_features().
+ */
+enum CpuFeature : uint32_t
+{
+    CPU_FEATURE_SSE2        = 0x00000001u,
+    CPU_FEATURE_SSE4_1      = 0x00000002u,
+    CPU_FEATURE_AVX         = 0x00000004u,
+    CPU_FEATURE_AVX2        = 0x00000008u,
+    CPU_FEATURE_FMA         = 0x00000010u,
+    CPU_FEATURE_F16C        = 0x00000020u,
+    CPU_FEATURE_AVX512F     = 0x00000040u,
+    CPU_FEATURE_AVX512VL    = 0x00000080u,
+    CPU_FEATURE_AVX512BW    = 0x00000100u,
+    CPU_FEATURE_AVX512DQ    = 0x00000200u,
+    CPU_FEATURE_AVX512_FP16 = 0x00000400u,
+    CPU_FEATURE_NEON        = 0x00000800u
+};
+
+/**
+ * @brief Retrieve the features supported by the running CPU.
+ *
+ * CPU detection is performed once and cached. Features which require
+ * operating system support (such as saving the AVX or AVX-512 register
+ * state) are only reported when the OS has enabled them.
+ *
+ * @return A bitwise combination of CpuFeature flags.
+ */
+uint32_t cpu_features() noexcept;
+
+/**
+ * @brief Retrieve the SIMD level which the batch kernels in this header are
+ * currently dispatched to.
+ */
+SimdLevel simd_level() noexcept;
+
+/**
+ * @brief Retrieve the highest SIMD level both compiled into this library and
+ * supported by the running CPU.
+ */
+SimdLevel simd_level_max() noexcept;
+
+/**
+ * @brief Determine if a SIMD level can be dispatched to on the running CPU.
+ */
+bool simd_level_supported(SimdLevel level) noexcept;
+
+/**
+ * @brief Change the SIMD level which batch kernels are dispatched to.
+ *
+ * This is primarily useful for testing and benchmarking each variant.
+ * Changing levels while another thread is calling a dispatched function is
+ * safe, though that call may use either variant.
+ *
+ * @param level
+ * The SIMD level to dispatch to.
+ *
+ * @return TRUE if the requested level is supported and is now active, FALSE
+ * if not, in which case the active level remains unchanged.
+ */
+bool set_simd_level(SimdLevel level) noexcept;
+
+/**
+ * @brief Retrieve a human-readable name for a SIMD level, such as "avx2".
+ */
+const char* simd_level_name(SimdLevel level) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+    Dispatched Batch Kernels
+
+    Arrays have no alignment requirements beyond those of their element
+    types. Output arrays may alias an input array exactly, but must not
+    otherwise overlap.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Multiply arrays of matrices, such that out[i] = a[i] * b[i].
+ */
+void mat4_mul_batch(
+    const mat4_t<float>* a,
+    const mat4_t<float>* b,
+    mat4_t<float>* out,
+    std::size_t count) noexcept;
+
+/**
+ * @brief Transform an array of vectors by a single matrix, such that
+ * out[i] = m * v[i].
+ */
+void mat4_transform_batch(
+    const mat4_t<float>& m,
+    const vec4_t<float>* v,
+    vec4_t<float>* out,
+    std::size_t count) noexcept;
+
+/**
+ * @brief Normalize an array of vectors.
+ *
+ * Unlike ls::math::normalize(), dispatched variants use a full-precision
+ * square root and division rather than a reciprocal estimate.
+ */
+void vec4_normalize_batch(const vec4_t<float>* v, vec4_t<float>* out, std::size_t count) noexcept;
+
+/**
+ * @brief Calculate the dot products of two arrays of vectors, such that
+ * out[i] = dot(a[i], b[i]).
+ */
+void vec4_dot_batch(
+    const vec4_t<float>* a,
+    const vec4_t<float>* b,
+    float* out,
+    std::size_t count) noexcept;
+
+/**
+ * @brief Convert an array of single-precision floats to half-precision,
+ * rounding to the nearest even number.
+ */
+void half_from_float_batch(const float* in, half* out, std::size_t count) noexcept;
+
+/**
+ * @brief Convert an array of half-precision floats to single-precision.
+ */
+void float_from_half_batch(const half* in, float* out, std::size_t count) noexcept;
+
+
+
+namespace impl
+{
+
+/**
+ * @brief Table of kernels compiled for a single SIMD level.
+ *
+ * Each variant is compiled in its own translation unit, using only raw
+ * floats & intrinsics, so no inline library code is ever compiled with an
+ * instruction set the running CPU may not support.
+ */
+struct SimdDispatchTable
+{
+    SimdLevel level;
+
+    void (*mat4_mul)(const float* a, const float* b, float* out, std::size_t count) noexcept;
+    void (*mat4_transform)(const float* m, const float* v, float* out, std::size_t count) noexcept;
+    void (*vec4_normalize)(const float* v, float* out, std::size_t count) noexcept;
+    void (*vec4_dot)(const float* a, const float* b, float* out, std::size_t count) noexcept;
+    void (*half_from_float)(const float* in, uint16_t* out, std::size_t count) noexcept;
+    void (*float_from_half)(const uint16_t* in, float* out, std::size_t count) noexcept;
+};
+
+extern const SimdDispatchTable SIMD_DISPATCH_SSE2;
+extern const SimdDispatchTable SIMD_DISPATCH_SSE4_1;
+extern const SimdDispatchTable SIMD_DISPATCH_AVX2;
+extern const SimdDispatchTable SIMD_DISPATCH_AVX512;
+
+} // end impl namespace
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_DISPATCH_H */
@@ -0,0 +1,86 @@
+
+#ifndef LS_MATH_DUALQUAT_H
+#define LS_MATH_DUALQUAT_H
+
+#include "lightsky/math/quat.h"
+
+namespace ls {
+namespace math {
+
+
+
+/**
+ *  @brief Dual Quaternion Structure
+ *
+ *  A dual quaternion is a pair of quaternions, r + εd, where ε*ε = 0. A unit
+ *  dual quaternion stores a rigid transformation: the real part contains a
+ *  rotation and the dual part contains a translation which has been rotated
+ *  by it (d = 0.5 * t * r). Unlike matrices, dual quaternions can be blended
+ *  linearly without introducing any scale or shear, which makes them suitable
+ *  for skinning.
+ *
+ *  Recommended for use with non-integral types
+ *
+ *  @note
+ *  The functions in "dualquat_utils.h" can be used to convert to and from
+ *  rotations, translations, and matrices.
+ */
+template <typename num_t>
+struct dualquat_t
+{
+    // data
+    quat_t<num_t> real;
+    quat_t<num_t> dual;
+
+    ~dualquat_t() = default;
+
+    constexpr dualquat_t() = default;
+    constexpr dualquat_t(const quat_t<num_t>& inReal, const quat_t<num_t>& inDual);
+
+    dualquat_t(const dualquat_t<num_t>&) = default;
+    dualquat_t(dualquat_t<num_t>&&) = default;
+
+    // Conversions & Casting
+    template <typename other_t>
+    inline explicit operator dualquat_t<other_t>() const;
+
+    //dualquat-dualquat operators
+    constexpr dualquat_t operator-() const;
+    constexpr dualquat_t operator+(const dualquat_t<num_t>& input) const;
+    constexpr dualquat_t operator-(const dualquat_t<num_t>& input) const;
+    constexpr dualquat_t operator*(const dualquat_t<num_t>& input) const;
+    dualquat_t& operator=(const dualquat_t<num_t>&) = default;
+    dualquat_t& operator=(dualquat_t<num_t>&&) = default;
+    dualquat_t& operator+=(const dualquat_t<num_t>& input);
+    dualquat_t& operator-=(const dualquat_t<num_t>& input);
+    dualquat_t& operator*=(const dualquat_t<num_t>& input);
+    constexpr bool operator==(const dualquat_t<num_t>& input) const;
+    constexpr bool operator!=(const dualquat_t<num_t>& input) const;
+
+    //dualquat-scalar operators
+    constexpr dualquat_t operator*(num_t) const;
+    constexpr dualquat_t operator/(num_t) const;
+    dualquat_t& operator*=(num_t);
+    dualquat_t& operator/=(num_t);
+};
+
+/*-------------------------------------
+    Non-Member Dual Quaternion-Scalar operations
+-------------------------------------*/
+template <typename num_t> constexpr
+dualquat_t<num_t> operator*(num_t n, const dualquat_t<num_t>& dq);
+
+/*-------------------------------------
+    Dual Quaternion Template Specializations
+-------------------------------------*/
+typedef dualquat_t<float>  dualquatf;
+typedef dualquat_t<double> dualquatd;
+
+typedef dualquat_t<float> dualquat;
+
+} //end math namespace
+} //end ls namespace
+
+#include "lightsky/math/generic/dualquat_impl.h"
+
+#endif /* LS_MATH_DUALQUAT_H */
@@ -0,0 +1,239 @@
+
+#ifndef LS_MATH_DUALQUAT_UTILS_H
+#define LS_MATH_DUALQUAT_UTILS_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86, LS_ARM_NEON
+
+#include "lightsky/math/batch_utils.h"
+#include "lightsky/math/dualquat.h"
+#include "lightsky/math/quat_utils.h"
+
+namespace ls {
+namespace math {
+
+/*-----------------------------------------------------------------------------
+    Dual Quaternion-Specific Functions
+-----------------------------------------------------------------------------*/
+/**
+ *  @brief Retrieve the dot product of the real parts of two dual quaternions.
+ *
+ *  A negative result means the two rotations lie in opposite hemispheres and
+ *  one of them should be negated before the two are blended.
+ *
+ *  @param dq1
+ *
+ *  @param dq2
+ *
+ *  @return the dot product of the real parts of dq1 & dq2.
+ */
+template <typename N> constexpr
+N dot(const dualquat_t<N>& dq1, const dualquat_t<N>& dq2);
+
+/**
+ *  @brief Get the quaternion-conjugate of a dual quaternion.
+ *
+ *  The conjugate of a unit dual quaternion is its inverse.
+ *
+ *  @param dq
+ *
+ *  @return a dual quaternion containing the conjugates of both the real and
+ *  dual parts of dq.
+ */
+template <typename N> constexpr
+dualquat_t<N> conjugate(const dualquat_t<N>& dq);
+
+/**
+ *  @brief Normalize a dual quaternion so that its real part has unit length.
+ *
+ *  Both parts are divided by the length of the real part. This is sufficient
+ *  to make a weighted sum of unit dual quaternions represent a rigid
+ *  transformation again.
+ *
+ *  @param dq
+ *
+ *  @return a normalized dual quaternion.
+ */
+template <typename N> inline
+dualquat_t<N> normalize(const dualquat_t<N>& dq);
+
+/**
+ *  @brief Linearly blend two unit dual quaternions and normalize the result.
+ *
+ *  The second dual quaternion is negated if it lies in the opposite
+ *  hemisphere of the first, so the blend follows the shortest path.
+ *
+ *  @param dq1
+ *  The dual quaternion to be interpolated.
+ *
+ *  @param dq2
+ *  The reference dual quaternion that dq1 should interpolate to.
+ *
+ *  @param percent
+ *  The percentage that dq1 should move towards dq2.
+ *
+ *  @return a normalized linear blend of dq1 & dq2.
+ */
+template <typename N> inline
+dualquat_t<N> nlerp(const dualquat_t<N>& dq1, const dualquat_t<N>& dq2, N percent);
+
+/*-----------------------------------------------------------------------------
+    Dual Quaternions & Rigid Transformations
+-----------------------------------------------------------------------------*/
+/**
+ *  @brief Create a unit dual quaternion from a rotation and a translation.
+ *
+ *  The resulting transformation rotates a point, then translates it.
+ *
+ *  @param rotation
+ *  A unit quaternion.
+ *
+ *  @param translation
+ *  A 3D vector which will be applied after rotation.
+ *
+ *  @return A unit dual quaternion representing the rigid transformation.
+ */
+template <typename N> inline
+dualquat_t<N> quat_to_dualquat(const quat_t<N>& rotation, const vec3_t<N>& translation);
+
+/**
+ *  @brief Convert a rigid 4x4 matrix into a unit dual quaternion.
+ *
+ *  @param m
+ *  An affine matrix containing only a rotation and a translation. Any scale
+ *  or shear will be lost.
+ *
+ *  @return A unit dual quaternion representing the same transformation as m.
+ */
+template <typename N> inline
+dualquat_t<N> mat_to_dualquat(const mat4_t<N>& m);
+
+/**
+ *  @brief Convert a unit dual quaternion into an affine 4x4 matrix.
+ *
+ *  @param dq
+ *  A unit dual quaternion.
+ *
+ *  @return A 4x4 rotation & translation matrix.
+ */
+template <typename N> inline
+mat4_t<N> dualquat_to_mat4(const dualquat_t<N>& dq);
+
+/**
+ *  @brief Retrieve the rotation stored within a unit dual quaternion.
+ *
+ *  @param dq
+ *
+ *  @return The real part of dq.
+ */
+template <typename N> constexpr
+quat_t<N> get_rotation(const dualquat_t<N>& dq);
+
+/**
+ *  @brief Retrieve the translation stored within a unit dual quaternion.
+ *
+ *  @param dq
+ *
+ *  @return The translation which dq applies after its rotation.
+ */
+template <typename N> inline
+vec3_t<N> get_translation(const dualquat_t<N>& dq);
+
+/**
+ *  @brief Transform a point by a unit dual quaternion.
+ *
+ *  @param p
+ *  The point to be rotated, then translated.
+ *
+ *  @param dq
+ *  A unit dual quaternion.
+ *
+ *  @return The point "p", transformed by "dq".
+ */
+template <typename N> inline
+vec3_t<N> transform_point(const vec3_t<N>& p, const dualquat_t<N>& dq);
+
+/**
+ *  @brief Transform a normal or direction by a unit dual quaternion.
+ *
+ *  Only the rotation of "dq" is applied.
+ *
+ *  @param n
+ *  The direction to be rotated.
+ *
+ *  @param dq
+ *  A unit dual quaternion.
+ *
+ *  @return The direction "n", rotated by "dq".
+ */
+template <typename N> inline
+vec3_t<N> transform_normal(const vec3_t<N>& n, const dualquat_t<N>& dq);
+
+/*-----------------------------------------------------------------------------
+    Dual Quaternion Skinning
+-----------------------------------------------------------------------------*/
+/**
+ *  @brief Skin an array of vertices using dual quaternion linear blending.
+ *
+ *  For each vertex, the dual quaternions of up to four bones are summed by
+ *  weight, normalized, then used to transform the vertex position and
+ *  normal. Each bone is negated before blending if its rotation lies in the
+ *  opposite hemisphere of the vertex's first bone. Bones which do not
+ *  influence a vertex should be given a weight of 0.
+ *
+ *  Single-precision versions transform four vertices at a time using SIMD
+ *  registers. Input and output arrays may alias each other exactly, but must
+ *  not otherwise overlap.
+ *
+ *  @param palette
+ *  An array of unit dual quaternions, one per bone.
+ *
+ *  @param positions
+ *  An array of at least "count" vertex positions.
+ *
+ *  @param normals
+ *  An array of at least "count" vertex normals, or NULL to skip transforming
+ *  normals.
+ *
+ *  @param boneIds
+ *  An array of at least "count" sets of four indices into "palette".
+ *
+ *  @param weights
+ *  An array of at least "count" sets of four bone weights. The weights of
+ *  each vertex should sum to 1.
+ *
+ *  @param outPositions
+ *  An array of at least "count" elements which will contain each skinned
+ *  position.
+ *
+ *  @param outNormals
+ *  An array of at least "count" elements which will contain each skinned
+ *  normal. This is ignored if "normals" is NULL.
+ *
+ *  @param count
+ *  The number of vertices to skin.
+ */
+template <typename N, typename index_t>
+void dualquat_skin_batch(
+    const dualquat_t<N>* palette,
+    const vec3_t<N>* positions,
+    const vec3_t<N>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<N>* weights,
+    vec3_t<N>* outPositions,
+    vec3_t<N>* outNormals,
+    std::size_t count) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/dualquat_utils_impl.h"
+
+#if defined(LS_ARCH_X86) || defined(LS_ARM_NEON)
+    #include "lightsky/math/generic/dualquatf_utils_impl.h"
+#endif
+
+#endif /* LS_MATH_DUALQUAT_UTILS_H */
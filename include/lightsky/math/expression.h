@@ -0,0 +1,135 @@
+
+#ifndef LS_MATH_EXPRESSION_H
+#define LS_MATH_EXPRESSION_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86, LS_ARM_NEON
+
+#include "lightsky/math/batch_utils.h"
+#include "lightsky/math/half.h"
+#include "lightsky/math/mat_utils.h"
+#include "lightsky/math/vec_utils.h"
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Lazy Expressions
+
+    Arithmetic such as "a * b + c * d - e" normally creates a temporary
+    vector or matrix for every operator. Wrapping any operand with "lazy()"
+    instead records the entire expression, which is then evaluated in a
+    single pass once it's converted to a vector or matrix, or passed to
+    "eval()". Evaluation follows these rules:
+
+    - Products which are immediately added to or subtracted from are
+      evaluated using fmadd() or fmsub(). Results may differ from the
+      regular operators by the rounding of one multiplication.
+    - Types with SIMD specializations (such as vec4_t<float>, mat4_t<float>,
+      and vecN_t<N, float>) evaluate each vector, or each column of a
+      matrix, using SIMD registers.
+    - All other types evaluate the expression once for each component, so
+      no intermediate vectors are created. Half-floats are evaluated using
+      single-precision floats, then converted once.
+
+    Vectors & matrices can be added, subtracted, and negated. Vectors can be
+    multiplied or divided with each other, while matrices may only be
+    multiplied or divided by scalars. Matrix products should be calculated
+    before they're used within an expression.
+
+    Expressions refer to their operands rather than copying them. They must
+    be evaluated within the statement which creates them, and should never be
+    stored using "auto".
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+template <typename value_t>
+struct ExprValue;
+
+template <typename value_t>
+struct ExprArray;
+
+} // end impl namespace
+
+
+
+/**
+ * @brief Begin a lazily-evaluated expression.
+ *
+ * @param x
+ * A vector, matrix, or scalar which will be used within an expression.
+ *
+ * @return A reference to "x" which can be combined with other vectors,
+ * matrices, scalars, and expressions.
+ */
+template <typename T>
+constexpr impl::ExprValue<T> lazy(const T& x) noexcept;
+
+/**
+ * @brief Begin a lazily-evaluated expression over entire arrays.
+ *
+ * The expression must be evaluated using "eval_batch()".
+ *
+ * @param x
+ * An array of vectors, matrices, or scalars. All arrays within the same
+ * expression must contain the same number of elements.
+ *
+ * @return A reference to "x" which can be combined with other arrays,
+ * vectors, matrices, scalars, and expressions.
+ */
+template <typename T>
+constexpr impl::ExprArray<T> lazy_batch(const T* x) noexcept;
+
+/**
+ * @brief Evaluate a lazy expression.
+ *
+ * Expressions are also evaluated when they're converted to the type of
+ * vector or matrix which they produce.
+ *
+ * @param e
+ * An expression created using "lazy()".
+ *
+ * @return The result of the expression.
+ */
+template <typename expr_t>
+typename expr_t::value_type eval(const expr_t& e) noexcept;
+
+/**
+ * @brief Evaluate a lazy expression for every element of the arrays within
+ * it.
+ *
+ * The entire expression is evaluated for one element at a time, or for one
+ * SIMD register of single-precision floats at a time. No intermediate
+ * arrays are written, so each input is read from memory only once. The
+ * output array may alias an input array exactly, but must not otherwise
+ * overlap it.
+ *
+ * @param e
+ * An expression created using "lazy_batch()".
+ *
+ * @param out
+ * An array of at least "count" elements which will contain the result of
+ * each evaluation.
+ *
+ * @param count
+ * The number of elements within each array of the expression.
+ */
+template <typename expr_t>
+void eval_batch(const expr_t& e, typename expr_t::value_type* out, std::size_t count) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/expression_impl.h"
+
+#if defined(LS_ARCH_X86) || defined(LS_ARM_NEON)
+    #include "lightsky/math/generic/expressionf_impl.h"
+#endif
+
+#endif /* LS_MATH_EXPRESSION_H */
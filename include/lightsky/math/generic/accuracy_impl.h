@@ -0,0 +1,1295 @@
+
+#ifndef LS_MATH_ACCURACY_IMPL_H
+#define LS_MATH_ACCURACY_IMPL_H
+
+#include <cmath>
+
+#include "lightsky/math/generic/simd_exp_impl.h"
+#include "lightsky/math/generic/simd_traits_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Precise Tier
+-----------------------------------------------------------------------------*/
+namespace precise
+{
+
+/*-------------------------------------
+    sin
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t sin(scalar_t x) noexcept
+{
+    return (scalar_t)std::sin(x);
+}
+
+/*-------------------------------------
+    sin, single-precision
+-------------------------------------*/
+inline LS_INLINE float sin(float x) noexcept
+{
+    return (float)std::sin((double)x);
+}
+
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> sin(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::sin(x.v[0]),
+        precise::sin(x.v[1]),
+        precise::sin(x.v[2]),
+        precise::sin(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    cos
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t cos(scalar_t x) noexcept
+{
+    return (scalar_t)std::cos(x);
+}
+
+/*-------------------------------------
+    cos, single-precision
+-------------------------------------*/
+inline LS_INLINE float cos(float x) noexcept
+{
+    return (float)std::cos((double)x);
+}
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> cos(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::cos(x.v[0]),
+        precise::cos(x.v[1]),
+        precise::cos(x.v[2]),
+        precise::cos(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    tan
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t tan(scalar_t x) noexcept
+{
+    return (scalar_t)std::tan(x);
+}
+
+/*-------------------------------------
+    tan, single-precision
+-------------------------------------*/
+inline LS_INLINE float tan(float x) noexcept
+{
+    return (float)std::tan((double)x);
+}
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> tan(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::tan(x.v[0]),
+        precise::tan(x.v[1]),
+        precise::tan(x.v[2]),
+        precise::tan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    asin
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t asin(scalar_t x) noexcept
+{
+    return (scalar_t)std::asin(x);
+}
+
+/*-------------------------------------
+    asin, single-precision
+-------------------------------------*/
+inline LS_INLINE float asin(float x) noexcept
+{
+    return (float)std::asin((double)x);
+}
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> asin(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::asin(x.v[0]),
+        precise::asin(x.v[1]),
+        precise::asin(x.v[2]),
+        precise::asin(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    acos
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t acos(scalar_t x) noexcept
+{
+    return (scalar_t)std::acos(x);
+}
+
+/*-------------------------------------
+    acos, single-precision
+-------------------------------------*/
+inline LS_INLINE float acos(float x) noexcept
+{
+    return (float)std::acos((double)x);
+}
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> acos(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::acos(x.v[0]),
+        precise::acos(x.v[1]),
+        precise::acos(x.v[2]),
+        precise::acos(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    atan
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t atan(scalar_t x) noexcept
+{
+    return (scalar_t)std::atan(x);
+}
+
+/*-------------------------------------
+    atan, single-precision
+-------------------------------------*/
+inline LS_INLINE float atan(float x) noexcept
+{
+    return (float)std::atan((double)x);
+}
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> atan(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::atan(x.v[0]),
+        precise::atan(x.v[1]),
+        precise::atan(x.v[2]),
+        precise::atan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    atan2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t atan2(scalar_t y, scalar_t x) noexcept
+{
+    return (scalar_t)std::atan2(y, x);
+}
+
+/*-------------------------------------
+    atan2, single-precision
+-------------------------------------*/
+inline LS_INLINE float atan2(float y, float x) noexcept
+{
+    return (float)std::atan2((double)y, (double)x);
+}
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> atan2(const vec4_t<num_t>& y, const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::atan2(y.v[0], x.v[0]),
+        precise::atan2(y.v[1], x.v[1]),
+        precise::atan2(y.v[2], x.v[2]),
+        precise::atan2(y.v[3], x.v[3])
+    };
+}
+
+/*-------------------------------------
+    exp
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t exp(scalar_t x) noexcept
+{
+    return (scalar_t)std::exp(x);
+}
+
+/*-------------------------------------
+    exp, single-precision
+-------------------------------------*/
+inline LS_INLINE float exp(float x) noexcept
+{
+    return (float)std::exp((double)x);
+}
+
+/*-------------------------------------
+    4D exp
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> exp(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::exp(x.v[0]),
+        precise::exp(x.v[1]),
+        precise::exp(x.v[2]),
+        precise::exp(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    exp2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t exp2(scalar_t x) noexcept
+{
+    return (scalar_t)std::exp2(x);
+}
+
+/*-------------------------------------
+    exp2, single-precision
+-------------------------------------*/
+inline LS_INLINE float exp2(float x) noexcept
+{
+    return (float)std::exp2((double)x);
+}
+
+/*-------------------------------------
+    4D exp2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> exp2(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::exp2(x.v[0]),
+        precise::exp2(x.v[1]),
+        precise::exp2(x.v[2]),
+        precise::exp2(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    log
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t log(scalar_t x) noexcept
+{
+    return (scalar_t)std::log(x);
+}
+
+/*-------------------------------------
+    log, single-precision
+-------------------------------------*/
+inline LS_INLINE float log(float x) noexcept
+{
+    return (float)std::log((double)x);
+}
+
+/*-------------------------------------
+    4D log
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> log(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::log(x.v[0]),
+        precise::log(x.v[1]),
+        precise::log(x.v[2]),
+        precise::log(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    log2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t log2(scalar_t x) noexcept
+{
+    return (scalar_t)std::log2(x);
+}
+
+/*-------------------------------------
+    log2, single-precision
+-------------------------------------*/
+inline LS_INLINE float log2(float x) noexcept
+{
+    return (float)std::log2((double)x);
+}
+
+/*-------------------------------------
+    4D log2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> log2(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::log2(x.v[0]),
+        precise::log2(x.v[1]),
+        precise::log2(x.v[2]),
+        precise::log2(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    pow
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t pow(scalar_t x, scalar_t y) noexcept
+{
+    return (scalar_t)std::pow(x, y);
+}
+
+/*-------------------------------------
+    pow, single-precision
+-------------------------------------*/
+inline LS_INLINE float pow(float x, float y) noexcept
+{
+    return (float)std::pow((double)x, (double)y);
+}
+
+/*-------------------------------------
+    4D pow
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> pow(const vec4_t<num_t>& x, const vec4_t<num_t>& y) noexcept
+{
+    return vec4_t<num_t>{
+        precise::pow(x.v[0], y.v[0]),
+        precise::pow(x.v[1], y.v[1]),
+        precise::pow(x.v[2], y.v[2]),
+        precise::pow(x.v[3], y.v[3])
+    };
+}
+
+/*-------------------------------------
+    sqrt
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t sqrt(scalar_t x) noexcept
+{
+    return (scalar_t)std::sqrt(x);
+}
+
+/*-------------------------------------
+    sqrt, single-precision
+-------------------------------------*/
+inline LS_INLINE float sqrt(float x) noexcept
+{
+    return std::sqrt(x);
+}
+
+/*-------------------------------------
+    4D sqrt
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> sqrt(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::sqrt(x.v[0]),
+        precise::sqrt(x.v[1]),
+        precise::sqrt(x.v[2]),
+        precise::sqrt(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    inversesqrt
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t inversesqrt(scalar_t x) noexcept
+{
+    return scalar_t{1} / (scalar_t)std::sqrt(x);
+}
+
+/*-------------------------------------
+    inversesqrt, single-precision
+-------------------------------------*/
+inline LS_INLINE float inversesqrt(float x) noexcept
+{
+    return (float)(1.0 / std::sqrt((double)x));
+}
+
+/*-------------------------------------
+    4D inversesqrt
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> inversesqrt(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::inversesqrt(x.v[0]),
+        precise::inversesqrt(x.v[1]),
+        precise::inversesqrt(x.v[2]),
+        precise::inversesqrt(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    rcp
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t rcp(scalar_t x) noexcept
+{
+    return scalar_t{1} / x;
+}
+
+/*-------------------------------------
+    rcp, single-precision
+-------------------------------------*/
+inline LS_INLINE float rcp(float x) noexcept
+{
+    return 1.f / x;
+}
+
+/*-------------------------------------
+    4D rcp
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> rcp(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        precise::rcp(x.v[0]),
+        precise::rcp(x.v[1]),
+        precise::rcp(x.v[2]),
+        precise::rcp(x.v[3])
+    };
+}
+
+} // end precise namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Balanced Tier
+-----------------------------------------------------------------------------*/
+namespace balanced
+{
+
+/*-------------------------------------
+    sin
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t sin(scalar_t x) noexcept
+{
+    return precise::sin(x);
+}
+
+/*-------------------------------------
+    sin, single-precision
+-------------------------------------*/
+inline LS_INLINE float sin(float x) noexcept
+{
+    return impl::simd_sin<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> sin(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::sin(x.v[0]),
+        balanced::sin(x.v[1]),
+        balanced::sin(x.v[2]),
+        balanced::sin(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    cos
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t cos(scalar_t x) noexcept
+{
+    return precise::cos(x);
+}
+
+/*-------------------------------------
+    cos, single-precision
+-------------------------------------*/
+inline LS_INLINE float cos(float x) noexcept
+{
+    return impl::simd_cos<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> cos(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::cos(x.v[0]),
+        balanced::cos(x.v[1]),
+        balanced::cos(x.v[2]),
+        balanced::cos(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    tan
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t tan(scalar_t x) noexcept
+{
+    return precise::tan(x);
+}
+
+/*-------------------------------------
+    tan, single-precision
+-------------------------------------*/
+inline LS_INLINE float tan(float x) noexcept
+{
+    return impl::simd_tan<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> tan(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::tan(x.v[0]),
+        balanced::tan(x.v[1]),
+        balanced::tan(x.v[2]),
+        balanced::tan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    asin
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t asin(scalar_t x) noexcept
+{
+    return precise::asin(x);
+}
+
+/*-------------------------------------
+    asin, single-precision
+-------------------------------------*/
+inline LS_INLINE float asin(float x) noexcept
+{
+    return impl::simd_asin<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> asin(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::asin(x.v[0]),
+        balanced::asin(x.v[1]),
+        balanced::asin(x.v[2]),
+        balanced::asin(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    acos
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t acos(scalar_t x) noexcept
+{
+    return precise::acos(x);
+}
+
+/*-------------------------------------
+    acos, single-precision
+-------------------------------------*/
+inline LS_INLINE float acos(float x) noexcept
+{
+    return impl::simd_acos<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> acos(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::acos(x.v[0]),
+        balanced::acos(x.v[1]),
+        balanced::acos(x.v[2]),
+        balanced::acos(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    atan
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t atan(scalar_t x) noexcept
+{
+    return precise::atan(x);
+}
+
+/*-------------------------------------
+    atan, single-precision
+-------------------------------------*/
+inline LS_INLINE float atan(float x) noexcept
+{
+    return impl::simd_atan<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> atan(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::atan(x.v[0]),
+        balanced::atan(x.v[1]),
+        balanced::atan(x.v[2]),
+        balanced::atan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    atan2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t atan2(scalar_t y, scalar_t x) noexcept
+{
+    return precise::atan2(y, x);
+}
+
+/*-------------------------------------
+    atan2, single-precision
+-------------------------------------*/
+inline LS_INLINE float atan2(float y, float x) noexcept
+{
+    return impl::simd_atan2<impl::SimdTraitsScalar>(y, x);
+}
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> atan2(const vec4_t<num_t>& y, const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::atan2(y.v[0], x.v[0]),
+        balanced::atan2(y.v[1], x.v[1]),
+        balanced::atan2(y.v[2], x.v[2]),
+        balanced::atan2(y.v[3], x.v[3])
+    };
+}
+
+/*-------------------------------------
+    exp
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t exp(scalar_t x) noexcept
+{
+    return precise::exp(x);
+}
+
+/*-------------------------------------
+    exp, single-precision
+-------------------------------------*/
+inline LS_INLINE float exp(float x) noexcept
+{
+    return impl::simd_exp<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D exp
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> exp(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::exp(x.v[0]),
+        balanced::exp(x.v[1]),
+        balanced::exp(x.v[2]),
+        balanced::exp(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    exp2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t exp2(scalar_t x) noexcept
+{
+    return precise::exp2(x);
+}
+
+/*-------------------------------------
+    exp2, single-precision
+-------------------------------------*/
+inline LS_INLINE float exp2(float x) noexcept
+{
+    return impl::simd_exp2<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D exp2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> exp2(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::exp2(x.v[0]),
+        balanced::exp2(x.v[1]),
+        balanced::exp2(x.v[2]),
+        balanced::exp2(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    log
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t log(scalar_t x) noexcept
+{
+    return precise::log(x);
+}
+
+/*-------------------------------------
+    log, single-precision
+-------------------------------------*/
+inline LS_INLINE float log(float x) noexcept
+{
+    return impl::simd_log<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D log
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> log(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::log(x.v[0]),
+        balanced::log(x.v[1]),
+        balanced::log(x.v[2]),
+        balanced::log(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    log2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t log2(scalar_t x) noexcept
+{
+    return precise::log2(x);
+}
+
+/*-------------------------------------
+    log2, single-precision
+-------------------------------------*/
+inline LS_INLINE float log2(float x) noexcept
+{
+    return impl::simd_log2<impl::SimdTraitsScalar>(x);
+}
+
+/*-------------------------------------
+    4D log2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> log2(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::log2(x.v[0]),
+        balanced::log2(x.v[1]),
+        balanced::log2(x.v[2]),
+        balanced::log2(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    pow
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t pow(scalar_t x, scalar_t y) noexcept
+{
+    return precise::pow(x, y);
+}
+
+/*-------------------------------------
+    pow, single-precision
+-------------------------------------*/
+inline LS_INLINE float pow(float x, float y) noexcept
+{
+    return precise::pow(x, y);
+}
+
+/*-------------------------------------
+    4D pow
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> pow(const vec4_t<num_t>& x, const vec4_t<num_t>& y) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::pow(x.v[0], y.v[0]),
+        balanced::pow(x.v[1], y.v[1]),
+        balanced::pow(x.v[2], y.v[2]),
+        balanced::pow(x.v[3], y.v[3])
+    };
+}
+
+/*-------------------------------------
+    sqrt
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t sqrt(scalar_t x) noexcept
+{
+    return precise::sqrt(x);
+}
+
+/*-------------------------------------
+    sqrt, single-precision
+-------------------------------------*/
+inline LS_INLINE float sqrt(float x) noexcept
+{
+    return std::sqrt(x);
+}
+
+/*-------------------------------------
+    4D sqrt
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> sqrt(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::sqrt(x.v[0]),
+        balanced::sqrt(x.v[1]),
+        balanced::sqrt(x.v[2]),
+        balanced::sqrt(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    inversesqrt
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t inversesqrt(scalar_t x) noexcept
+{
+    return precise::inversesqrt(x);
+}
+
+/*-------------------------------------
+    inversesqrt, single-precision
+-------------------------------------*/
+inline LS_INLINE float inversesqrt(float x) noexcept
+{
+    return 1.f / std::sqrt(x);
+}
+
+/*-------------------------------------
+    4D inversesqrt
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> inversesqrt(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::inversesqrt(x.v[0]),
+        balanced::inversesqrt(x.v[1]),
+        balanced::inversesqrt(x.v[2]),
+        balanced::inversesqrt(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    rcp
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t rcp(scalar_t x) noexcept
+{
+    return precise::rcp(x);
+}
+
+/*-------------------------------------
+    rcp, single-precision
+-------------------------------------*/
+inline LS_INLINE float rcp(float x) noexcept
+{
+    return 1.f / x;
+}
+
+/*-------------------------------------
+    4D rcp
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> rcp(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        balanced::rcp(x.v[0]),
+        balanced::rcp(x.v[1]),
+        balanced::rcp(x.v[2]),
+        balanced::rcp(x.v[3])
+    };
+}
+
+} // end balanced namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Fast Tier
+-----------------------------------------------------------------------------*/
+namespace fast
+{
+
+/*-------------------------------------
+    sin
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t sin(scalar_t x) noexcept
+{
+    return ls::math::sin(x);
+}
+
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> sin(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::sin(x.v[0]),
+        fast::sin(x.v[1]),
+        fast::sin(x.v[2]),
+        fast::sin(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    cos
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t cos(scalar_t x) noexcept
+{
+    return ls::math::cos(x);
+}
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> cos(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::cos(x.v[0]),
+        fast::cos(x.v[1]),
+        fast::cos(x.v[2]),
+        fast::cos(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    tan
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t tan(scalar_t x) noexcept
+{
+    return ls::math::tan(x);
+}
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> tan(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::tan(x.v[0]),
+        fast::tan(x.v[1]),
+        fast::tan(x.v[2]),
+        fast::tan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    asin
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t asin(scalar_t x) noexcept
+{
+    return ls::math::asin(x);
+}
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> asin(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::asin(x.v[0]),
+        fast::asin(x.v[1]),
+        fast::asin(x.v[2]),
+        fast::asin(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    acos
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t acos(scalar_t x) noexcept
+{
+    return ls::math::acos(x);
+}
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> acos(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::acos(x.v[0]),
+        fast::acos(x.v[1]),
+        fast::acos(x.v[2]),
+        fast::acos(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    atan
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t atan(scalar_t x) noexcept
+{
+    return ls::math::atan(x);
+}
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> atan(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::atan(x.v[0]),
+        fast::atan(x.v[1]),
+        fast::atan(x.v[2]),
+        fast::atan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    atan2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t atan2(scalar_t y, scalar_t x) noexcept
+{
+    return ls::math::atan2(y, x);
+}
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> atan2(const vec4_t<num_t>& y, const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::atan2(y.v[0], x.v[0]),
+        fast::atan2(y.v[1], x.v[1]),
+        fast::atan2(y.v[2], x.v[2]),
+        fast::atan2(y.v[3], x.v[3])
+    };
+}
+
+/*-------------------------------------
+    exp
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t exp(scalar_t x) noexcept
+{
+    return ls::math::exp(x);
+}
+
+/*-------------------------------------
+    4D exp
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> exp(const vec4_t<num_t>& x) noexcept
+{
+    return ls::math::exp(x);
+}
+
+/*-------------------------------------
+    exp2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t exp2(scalar_t x) noexcept
+{
+    return ls::math::exp2(x);
+}
+
+/*-------------------------------------
+    4D exp2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> exp2(const vec4_t<num_t>& x) noexcept
+{
+    return ls::math::exp2(x);
+}
+
+/*-------------------------------------
+    log
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t log(scalar_t x) noexcept
+{
+    return ls::math::log(x);
+}
+
+/*-------------------------------------
+    4D log
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> log(const vec4_t<num_t>& x) noexcept
+{
+    return ls::math::log(x);
+}
+
+/*-------------------------------------
+    log2
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t log2(scalar_t x) noexcept
+{
+    return ls::math::log2(x);
+}
+
+/*-------------------------------------
+    4D log2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> log2(const vec4_t<num_t>& x) noexcept
+{
+    return ls::math::log2(x);
+}
+
+/*-------------------------------------
+    pow
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t pow(scalar_t x, scalar_t y) noexcept
+{
+    return ls::math::pow(x, y);
+}
+
+/*-------------------------------------
+    4D pow
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> pow(const vec4_t<num_t>& x, const vec4_t<num_t>& y) noexcept
+{
+    return ls::math::pow(x, y);
+}
+
+/*-------------------------------------
+    sqrt
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t sqrt(scalar_t x) noexcept
+{
+    return ls::math::fast_sqrt(x);
+}
+
+/*-------------------------------------
+    4D sqrt
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> sqrt(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::sqrt(x.v[0]),
+        fast::sqrt(x.v[1]),
+        fast::sqrt(x.v[2]),
+        fast::sqrt(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    inversesqrt
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t inversesqrt(scalar_t x) noexcept
+{
+    return ls::math::inversesqrt(x);
+}
+
+/*-------------------------------------
+    4D inversesqrt
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> inversesqrt(const vec4_t<num_t>& x) noexcept
+{
+    return vec4_t<num_t>{
+        fast::inversesqrt(x.v[0]),
+        fast::inversesqrt(x.v[1]),
+        fast::inversesqrt(x.v[2]),
+        fast::inversesqrt(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    rcp
+-------------------------------------*/
+template <typename scalar_t>
+inline LS_INLINE scalar_t rcp(scalar_t x) noexcept
+{
+    return ls::math::rcp(x);
+}
+
+/*-------------------------------------
+    4D rcp
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE vec4_t<num_t> rcp(const vec4_t<num_t>& x) noexcept
+{
+    return ls::math::rcp(x);
+}
+
+} // end fast namespace
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_ACCURACY_IMPL_H */
@@ -0,0 +1,667 @@
+
+#ifndef LS_MATH_ANIMATION_IMPL_H
+#define LS_MATH_ANIMATION_IMPL_H
+
+#include <algorithm> // std::upper_bound, std::stable_sort
+#include <cmath> // std::sqrt
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/batch_utils.h"
+#include "lightsky/math/quat_utils.h"
+#include "lightsky/math/vec_utils.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Keyframe Search & Interpolation
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Find the last keyframe at or before "t", starting from the keyframe
+    found by a previous search. Tracks must contain at least one keyframe.
+-------------------------------------*/
+template <typename num_t>
+inline uint32_t anim_find_key(const num_t* times, uint32_t count, uint32_t hint, num_t t) noexcept
+{
+    if (hint >= count || t < times[hint])
+    {
+        const num_t* const upper = std::upper_bound(times, times+count, t);
+        return (upper == times) ? 0u : (uint32_t)(upper - times - 1);
+    }
+
+    while (hint+1 < count && !(t < times[hint+1]))
+    {
+        ++hint;
+    }
+
+    return hint;
+}
+
+
+
+/*-------------------------------------
+    Move a keyframe into the same hemisphere as its neighbor. Only
+    quaternions need to be adjusted since q and -q are the same rotation.
+-------------------------------------*/
+template <typename key_t>
+constexpr LS_INLINE const key_t& anim_align(const key_t&, const key_t& k) noexcept
+{
+    return k;
+}
+
+template <typename num_t>
+inline LS_INLINE quat_t<num_t> anim_align(const quat_t<num_t>& ref, const quat_t<num_t>& q) noexcept
+{
+    return (dot(ref, q) < num_t{0}) ? (q * num_t{-1}) : q;
+}
+
+
+
+/*-------------------------------------
+    Catmull-Rom interpolation between keyframes "k" and "k+1". Tangents are
+    scaled by the length of each segment so keyframes need not be evenly
+    spaced, and the first & last segments of a track use one-sided tangents.
+-------------------------------------*/
+template <typename num_t, typename key_t>
+inline key_t anim_cubic(const num_t* times, const key_t* keys, uint32_t count, uint32_t k, num_t u) noexcept
+{
+    const key_t p1 = keys[k];
+    const key_t p2 = anim_align(p1, keys[k+1]);
+    const num_t dt = times[k+1] - times[k];
+
+    key_t m1 = p2 - p1;
+    key_t m2 = p2 - p1;
+
+    if (k > 0)
+    {
+        const key_t p0 = anim_align(p1, keys[k-1]);
+        m1 = (p2 - p0) * (dt / (times[k+1] - times[k-1]));
+    }
+
+    if (k+2 < count)
+    {
+        const key_t p3 = anim_align(p2, keys[k+2]);
+        m2 = (p3 - p1) * (dt / (times[k+2] - times[k]));
+    }
+
+    // Cubic Hermite basis
+    const num_t u2  = u * u;
+    const num_t u3  = u2 * u;
+    const num_t h01 = num_t{3} * u2 - num_t{2} * u3;
+    const num_t h00 = num_t{1} - h01;
+    const num_t h10 = u3 - num_t{2} * u2 + u;
+    const num_t h11 = u3 - u2;
+
+    return (p1 * h00) + (m1 * h10) + (p2 * h01) + (m2 * h11);
+}
+
+
+
+/*-------------------------------------
+    Locate the keyframes surrounding "t" within a track. Returns true if "t"
+    lies between two keyframes, along with the percentage between them.
+-------------------------------------*/
+template <typename num_t>
+inline bool anim_locate(const num_t* times, const AnimationTrack& track, uint32_t& key, num_t t, num_t& percent) noexcept
+{
+    key = anim_find_key(times, track.numKeys, key, t);
+
+    if (key+1 >= track.numKeys || !(times[key] < t) || track.interpolation == ANIM_INTERP_STEP)
+    {
+        return false;
+    }
+
+    percent = (t - times[key]) / (times[key+1] - times[key]);
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Sample every translation or scale track
+-------------------------------------*/
+template <typename num_t>
+void anim_sample_vec3(
+    const AnimationKeys<num_t, vec3_t<num_t>>& keys,
+    num_t t,
+    uint32_t* cursor,
+    const vec3_t<num_t>& defaultValue,
+    vec3_t<num_t>* out) noexcept
+{
+    const std::size_t numBones = keys.tracks.size();
+
+    for (std::size_t i = 0; i < numBones; ++i)
+    {
+        const AnimationTrack& track = keys.tracks[i];
+        if (!track.numKeys)
+        {
+            out[i] = defaultValue;
+            continue;
+        }
+
+        const num_t* const times = keys.times.data() + track.firstKey;
+        const vec3_t<num_t>* const values = keys.values.data() + track.firstKey;
+        num_t percent;
+
+        if (!anim_locate(times, track, cursor[i], t, percent))
+        {
+            out[i] = values[cursor[i]];
+        }
+        else if (track.interpolation == ANIM_INTERP_LINEAR)
+        {
+            out[i] = mix(values[cursor[i]], values[cursor[i]+1], percent);
+        }
+        else
+        {
+            out[i] = anim_cubic(times, values, track.numKeys, cursor[i], percent);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Copy a single track into a clip, sorting keyframes by time
+-------------------------------------*/
+template <typename num_t, typename key_t>
+void anim_pack_track(AnimationKeys<num_t, key_t>& keys, const AnimationChannel<num_t, key_t>* channel) noexcept
+{
+    AnimationTrack track;
+    track.firstKey = (uint32_t)keys.times.size();
+    track.numKeys = channel ? (uint32_t)channel->count : 0u;
+    track.interpolation = channel ? channel->interpolation : ANIM_INTERP_STEP;
+
+    if (track.numKeys)
+    {
+        std::vector<uint32_t> order(track.numKeys);
+        for (uint32_t i = 0; i < track.numKeys; ++i)
+        {
+            order[i] = i;
+        }
+
+        const num_t* const times = channel->times;
+        std::stable_sort(order.begin(), order.end(), [times](uint32_t a, uint32_t b) noexcept->bool
+        {
+            return times[a] < times[b];
+        });
+
+        for (uint32_t i : order)
+        {
+            keys.times.push_back(channel->times[i]);
+            keys.values.push_back(channel->keys[i]);
+        }
+    }
+
+    keys.tracks.push_back(track);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Per-Bone Pose Operations
+
+    Each function operates on the bones in the range [first, last), reading
+    every input of a bone before writing its output so poses may alias.
+    SIMD versions use these for bones which don't fill a register.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Normalize a quaternion, falling back to the identity rotation if its
+    length is 0.
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE quat_t<num_t> pose_normalize(const quat_t<num_t>& q) noexcept
+{
+    const num_t len = std::sqrt(dot(q, q));
+    return (len > num_t{0})
+        ? quat_t<num_t>{q[0] / len, q[1] / len, q[2] / len, q[3] / len}
+        : quat_t<num_t>{num_t{0}, num_t{0}, num_t{0}, num_t{1}};
+}
+
+
+
+/*-------------------------------------
+    Weighted blend of several poses
+-------------------------------------*/
+template <typename num_t>
+void pose_blend_bones(
+    const AnimationPose<num_t>* const* poses,
+    const num_t* weights,
+    const num_t* const* boneMasks,
+    unsigned numPoses,
+    AnimationPose<num_t>& outPose,
+    std::size_t first,
+    std::size_t last) noexcept
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const quat_t<num_t> reference = poses[0]->rotations[i];
+        vec3_t<num_t> position{num_t{0}};
+        vec3_t<num_t> scale{num_t{0}};
+        quat_t<num_t> rotation{num_t{0}, num_t{0}, num_t{0}, num_t{0}};
+        num_t total = num_t{0};
+
+        for (unsigned p = 0; p < numPoses; ++p)
+        {
+            const AnimationPose<num_t>& pose = *poses[p];
+            const num_t w = (boneMasks && boneMasks[p]) ? (weights[p] * boneMasks[p][i]) : weights[p];
+            const quat_t<num_t>& r = pose.rotations[i];
+            const num_t wr = (dot(reference, r) < num_t{0}) ? -w : w;
+
+            position += pose.positions[i] * w;
+            scale += pose.scales[i] * w;
+            rotation = quat_t<num_t>{
+                rotation[0] + r[0] * wr,
+                rotation[1] + r[1] * wr,
+                rotation[2] + r[2] * wr,
+                rotation[3] + r[3] * wr
+            };
+            total += w;
+        }
+
+        if (total == num_t{0})
+        {
+            outPose.positions[i] = vec3_t<num_t>{num_t{0}};
+            outPose.rotations[i] = quat_t<num_t>{num_t{0}, num_t{0}, num_t{0}, num_t{1}};
+            outPose.scales[i] = vec3_t<num_t>{num_t{1}};
+        }
+        else
+        {
+            outPose.positions[i] = position / total;
+            outPose.rotations[i] = pose_normalize(rotation);
+            outPose.scales[i] = scale / total;
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Difference between a pose and a reference pose
+-------------------------------------*/
+template <typename num_t>
+void pose_make_additive_bones(
+    const AnimationPose<num_t>& pose,
+    const AnimationPose<num_t>& reference,
+    AnimationPose<num_t>& outAdditive,
+    std::size_t first,
+    std::size_t last) noexcept
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const vec3_t<num_t> position = pose.positions[i] - reference.positions[i];
+        const quat_t<num_t> rotation = conjugate(reference.rotations[i]) * pose.rotations[i];
+        const vec3_t<num_t> scale = pose.scales[i] / reference.scales[i];
+
+        outAdditive.positions[i] = position;
+        outAdditive.rotations[i] = rotation;
+        outAdditive.scales[i] = scale;
+    }
+}
+
+
+
+/*-------------------------------------
+    Weighted application of an additive pose
+-------------------------------------*/
+template <typename num_t>
+void pose_apply_additive_bones(
+    const AnimationPose<num_t>& base,
+    const AnimationPose<num_t>& additive,
+    num_t weight,
+    const num_t* boneMask,
+    AnimationPose<num_t>& outPose,
+    std::size_t first,
+    std::size_t last) noexcept
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const num_t w = boneMask ? (weight * boneMask[i]) : weight;
+
+        // nlerp from the identity rotation, taking the shortest path
+        const quat_t<num_t>& d = additive.rotations[i];
+        const num_t dw = (d[3] < num_t{0}) ? -w : w;
+        const quat_t<num_t> delta = pose_normalize(quat_t<num_t>{
+            d[0] * dw,
+            d[1] * dw,
+            d[2] * dw,
+            (num_t{1} - w) + d[3] * dw
+        });
+
+        const vec3_t<num_t> position = base.positions[i] + additive.positions[i] * w;
+        const quat_t<num_t> rotation = base.rotations[i] * delta;
+        const vec3_t<num_t> scale = base.scales[i] * ((additive.scales[i] - num_t{1}) * w + num_t{1});
+
+        outPose.positions[i] = position;
+        outPose.rotations[i] = rotation;
+        outPose.scales[i] = scale;
+    }
+}
+
+} // end impl namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    AnimationKeys Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Clear
+-------------------------------------*/
+template <typename num_t, typename key_t>
+inline void AnimationKeys<num_t, key_t>::clear() noexcept
+{
+    times.clear();
+    values.clear();
+    tracks.clear();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    AnimationPose Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Resize
+-------------------------------------*/
+template <typename num_t>
+inline void AnimationPose<num_t>::resize(unsigned numBones) noexcept
+{
+    positions.resize(numBones, vec3_t<num_t>{num_t{0}});
+    rotations.resize(numBones, quat_t<num_t>{num_t{0}, num_t{0}, num_t{0}, num_t{1}});
+    scales.resize(numBones, vec3_t<num_t>{num_t{1}});
+}
+
+
+
+/*-------------------------------------
+    Bone Count
+-------------------------------------*/
+template <typename num_t>
+inline unsigned AnimationPose<num_t>::num_bones() const noexcept
+{
+    return (unsigned)positions.size();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    AnimationCursor Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Reset
+-------------------------------------*/
+template <typename num_t>
+inline void AnimationCursor<num_t>::reset(unsigned numBones) noexcept
+{
+    keys.assign(numBones * 3u, 0u);
+    fromRotations.resize(numBones);
+    toRotations.resize(numBones);
+    percents.resize(numBones);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    AnimationClip Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Constructor
+-------------------------------------*/
+template <typename num_t>
+AnimationClip<num_t>::AnimationClip() noexcept :
+    numBones{0},
+    length{0},
+    positions{},
+    rotations{},
+    scales{}
+{}
+
+
+
+/*-------------------------------------
+    Initialize
+-------------------------------------*/
+template <typename num_t>
+void AnimationClip<num_t>::init(
+    unsigned boneCount,
+    const AnimationChannel<num_t, vec3_t<num_t>>* positionTracks,
+    const AnimationChannel<num_t, quat_t<num_t>>* rotationTracks,
+    const AnimationChannel<num_t, vec3_t<num_t>>* scaleTracks) noexcept
+{
+    clear();
+    numBones = boneCount;
+
+    for (unsigned i = 0; i < boneCount; ++i)
+    {
+        impl::anim_pack_track(positions, positionTracks ? (positionTracks+i) : nullptr);
+        impl::anim_pack_track(rotations, rotationTracks ? (rotationTracks+i) : nullptr);
+        impl::anim_pack_track(scales, scaleTracks ? (scaleTracks+i) : nullptr);
+    }
+
+    // tracks are sorted, so the last key of each track is its latest
+    const auto track_end = [](const auto& keys, const AnimationTrack& track) noexcept->num_t
+    {
+        return track.numKeys ? keys.times[track.firstKey + track.numKeys - 1] : num_t{0};
+    };
+
+    for (unsigned i = 0; i < boneCount; ++i)
+    {
+        length = math::max(
+            length,
+            track_end(positions, positions.tracks[i]),
+            track_end(rotations, rotations.tracks[i]),
+            track_end(scales, scales.tracks[i]));
+    }
+}
+
+
+
+/*-------------------------------------
+    Clear
+-------------------------------------*/
+template <typename num_t>
+void AnimationClip<num_t>::clear() noexcept
+{
+    numBones = 0;
+    length = num_t{0};
+    positions.clear();
+    rotations.clear();
+    scales.clear();
+}
+
+
+
+/*-------------------------------------
+    Bone Count
+-------------------------------------*/
+template <typename num_t>
+inline unsigned AnimationClip<num_t>::num_bones() const noexcept
+{
+    return numBones;
+}
+
+
+
+/*-------------------------------------
+    Duration
+-------------------------------------*/
+template <typename num_t>
+inline num_t AnimationClip<num_t>::duration() const noexcept
+{
+    return length;
+}
+
+
+
+/*-------------------------------------
+    Sample all tracks
+-------------------------------------*/
+template <typename num_t>
+void AnimationClip<num_t>::sample(
+    num_t t,
+    AnimationCursor<num_t>& cursor,
+    vec3_t<num_t>* outPositions,
+    quat_t<num_t>* outRotations,
+    vec3_t<num_t>* outScales) const noexcept
+{
+    if (cursor.keys.size() != numBones * 3u)
+    {
+        cursor.reset(numBones);
+    }
+
+    impl::anim_sample_vec3(positions, t, cursor.keys.data(), vec3_t<num_t>{num_t{0}}, outPositions);
+    impl::anim_sample_vec3(scales, t, cursor.keys.data() + 2u*numBones, vec3_t<num_t>{num_t{1}}, outScales);
+
+    // Rotations are gathered into pairs and interpolated together. Stepped
+    // and cubic tracks are evaluated here, then passed through unchanged by
+    // using the same quaternion for both ends of a pair.
+    uint32_t* const rotationKeys = cursor.keys.data() + numBones;
+    quat_t<num_t>* const from = cursor.fromRotations.data();
+    quat_t<num_t>* const to = cursor.toRotations.data();
+    num_t* const percents = cursor.percents.data();
+
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        const AnimationTrack& track = rotations.tracks[i];
+        percents[i] = num_t{0};
+
+        if (!track.numKeys)
+        {
+            from[i] = to[i] = quat_t<num_t>{num_t{0}, num_t{0}, num_t{0}, num_t{1}};
+            continue;
+        }
+
+        const num_t* const times = rotations.times.data() + track.firstKey;
+        const quat_t<num_t>* const values = rotations.values.data() + track.firstKey;
+        num_t percent;
+
+        if (!impl::anim_locate(times, track, rotationKeys[i], t, percent))
+        {
+            from[i] = to[i] = values[rotationKeys[i]];
+        }
+        else if (track.interpolation == ANIM_INTERP_LINEAR)
+        {
+            from[i] = values[rotationKeys[i]];
+            to[i] = values[rotationKeys[i]+1];
+            percents[i] = percent;
+        }
+        else
+        {
+            from[i] = to[i] = normalize(impl::anim_cubic(times, values, track.numKeys, rotationKeys[i], percent));
+        }
+    }
+
+    slerp_batch(from, to, percents, outRotations, numBones);
+}
+
+
+
+/*-------------------------------------
+    Sample all tracks into a pose
+-------------------------------------*/
+template <typename num_t>
+inline void AnimationClip<num_t>::sample(num_t t, AnimationCursor<num_t>& cursor, AnimationPose<num_t>& outPose) const noexcept
+{
+    outPose.resize(numBones);
+    sample(t, cursor, outPose.positions.data(), outPose.rotations.data(), outPose.scales.data());
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Pose Blending
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    align_hemispheres
+-------------------------------------*/
+template <typename N>
+inline void align_hemispheres(const quat_t<N>* reference, quat_t<N>* rotations, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        rotations[i] = impl::anim_align(reference[i], rotations[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    blend_poses
+-------------------------------------*/
+template <typename N>
+inline void blend_poses(
+    const AnimationPose<N>* const* poses,
+    const N* weights,
+    const typename vec3_t<N>::value_type* const* boneMasks,
+    unsigned numPoses,
+    AnimationPose<N>& outPose) noexcept
+{
+    if (!numPoses)
+    {
+        return;
+    }
+
+    const unsigned numBones = poses[0]->num_bones();
+    outPose.resize(numBones);
+    impl::pose_blend_bones(poses, weights, boneMasks, numPoses, outPose, 0, numBones);
+}
+
+
+
+/*-------------------------------------
+    make_additive_pose
+-------------------------------------*/
+template <typename N>
+inline void make_additive_pose(
+    const AnimationPose<N>& pose,
+    const AnimationPose<N>& reference,
+    AnimationPose<N>& outAdditive) noexcept
+{
+    const unsigned numBones = pose.num_bones();
+    outAdditive.resize(numBones);
+    impl::pose_make_additive_bones(pose, reference, outAdditive, 0, numBones);
+}
+
+
+
+/*-------------------------------------
+    apply_additive_pose
+-------------------------------------*/
+template <typename N>
+inline void apply_additive_pose(
+    const AnimationPose<N>& base,
+    const AnimationPose<N>& additive,
+    typename vec3_t<N>::value_type weight,
+    const typename vec3_t<N>::value_type* boneMask,
+    AnimationPose<N>& outPose) noexcept
+{
+    const unsigned numBones = base.num_bones();
+    outPose.resize(numBones);
+    impl::pose_apply_additive_bones(base, additive, weight, boneMask, outPose, 0, numBones);
+}
+
+
+
+/*-------------------------------------
+    pose_to_matrices
+-------------------------------------*/
+template <typename N>
+inline void pose_to_matrices(const AnimationPose<N>& pose, mat4_t<N>* outMatrices) noexcept
+{
+    compose_trs_batch(pose.positions.data(), pose.rotations.data(), pose.scales.data(), outMatrices, pose.num_bones());
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_ANIMATION_IMPL_H */
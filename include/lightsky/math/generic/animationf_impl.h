@@ -0,0 +1,73 @@
+#ifndef LS_MATH_ANIMATIONF_IMPL_H
+#define LS_MATH_ANIMATIONF_IMPL_H
+
+#include "lightsky/math/generic/simd_animation_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Pose Blending
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    blend_poses
+-------------------------------------*/
+inline void blend_poses(
+    const AnimationPose<float>* const* poses,
+    const float* weights,
+    const float* const* boneMasks,
+    unsigned numPoses,
+    AnimationPose<float>& outPose) noexcept
+{
+    if (!numPoses)
+    {
+        return;
+    }
+
+    const unsigned numBones = poses[0]->num_bones();
+    outPose.resize(numBones);
+    impl::simd_blend_poses<impl::SimdTraits128>(poses, weights, boneMasks, numPoses, outPose, numBones);
+}
+
+
+
+/*-------------------------------------
+    make_additive_pose
+-------------------------------------*/
+inline void make_additive_pose(
+    const AnimationPose<float>& pose,
+    const AnimationPose<float>& reference,
+    AnimationPose<float>& outAdditive) noexcept
+{
+    const unsigned numBones = pose.num_bones();
+    outAdditive.resize(numBones);
+    impl::simd_make_additive_pose<impl::SimdTraits128>(pose, reference, outAdditive, numBones);
+}
+
+
+
+/*-------------------------------------
+    apply_additive_pose
+-------------------------------------*/
+inline void apply_additive_pose(
+    const AnimationPose<float>& base,
+    const AnimationPose<float>& additive,
+    float weight,
+    const float* boneMask,
+    AnimationPose<float>& outPose) noexcept
+{
+    const unsigned numBones = base.num_bones();
+    outPose.resize(numBones);
+    impl::simd_apply_additive_pose<impl::SimdTraits128>(base, additive, weight, boneMask, outPose, numBones);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_ANIMATIONF_IMPL_H */
@@ -0,0 +1,257 @@
+
+#ifndef LS_MATH_BATCH_UTILS_IMPL_H
+#define LS_MATH_BATCH_UTILS_IMPL_H
+
+namespace ls
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Trigonometric Functions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    sin_batch
+-------------------------------------*/
+template <typename num_t>
+void math::sin_batch(const num_t* x, num_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::sin(x[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    cos_batch
+-------------------------------------*/
+template <typename num_t>
+void math::cos_batch(const num_t* x, num_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::cos(x[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    sincos_batch
+-------------------------------------*/
+template <typename num_t>
+void math::sincos_batch(const num_t* x, num_t* outSin, num_t* outCos, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const num_t angle = x[i];
+        outSin[i] = ls::math::sin(angle);
+        outCos[i] = ls::math::cos(angle);
+    }
+}
+
+
+
+/*-------------------------------------
+    tan_batch
+-------------------------------------*/
+template <typename num_t>
+void math::tan_batch(const num_t* x, num_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::tan(x[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    atan_batch
+-------------------------------------*/
+template <typename num_t>
+void math::atan_batch(const num_t* x, num_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::atan(x[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    atan2_batch
+-------------------------------------*/
+template <typename num_t>
+void math::atan2_batch(const num_t* y, const num_t* x, num_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::atan2(y[i], x[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    asin_batch
+-------------------------------------*/
+template <typename num_t>
+void math::asin_batch(const num_t* x, num_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::asin(x[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    acos_batch
+-------------------------------------*/
+template <typename num_t>
+void math::acos_batch(const num_t* x, num_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::acos(x[i]);
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Matrix Operations
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    mat3_mul_batch
+-------------------------------------*/
+template <typename num_t>
+void math::mat3_mul_batch(const mat3_t<num_t>* a, const mat3_t<num_t>* b, mat3_t<num_t>* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+
+
+/*-------------------------------------
+    mat3_transform_batch
+-------------------------------------*/
+template <typename num_t>
+void math::mat3_transform_batch(const mat3_t<num_t>& m, const vec3_t<num_t>* v, vec3_t<num_t>* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = m * v[i];
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Quaternion Interpolation
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    slerp_batch
+-------------------------------------*/
+template <typename num_t>
+void math::slerp_batch(const quat_t<num_t>* a, const quat_t<num_t>* b, const num_t* t, quat_t<num_t>* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::slerp(a[i], b[i], t[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    fast_slerp_batch
+-------------------------------------*/
+template <typename num_t>
+void math::fast_slerp_batch(const quat_t<num_t>* a, const quat_t<num_t>* b, const num_t* t, quat_t<num_t>* out, std::size_t count) noexcept
+{
+    // See "simd_fast_slerp_weights()" for a description of these constants
+    constexpr num_t mu = num_t{1.85298109240830};
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const num_t d    = ls::math::dot(a[i], b[i]);
+        const num_t xm1  = (d < num_t{0} ? -d : d) - num_t{1};
+        const num_t t1   = t[i];
+        const num_t t0   = num_t{1} - t1;
+        num_t c0 = num_t{1};
+        num_t c1 = num_t{1};
+
+        for (int j = 8; j >= 1; --j)
+        {
+            const num_t scale = (j == 8) ? mu : num_t{1};
+            const num_t u = scale / num_t(j*(2*j+1));
+            const num_t v = scale * num_t(j) / num_t(2*j+1);
+            c0 = num_t{1} + (u*t0*t0 - v) * xm1 * c0;
+            c1 = num_t{1} + (u*t1*t1 - v) * xm1 * c1;
+        }
+
+        const num_t w1 = (d < num_t{0}) ? -(t1*c1) : (t1*c1);
+        out[i] = (a[i] * (t0*c0)) + (b[i] * w1);
+    }
+}
+
+
+
+/*-------------------------------------
+    nlerp_batch
+-------------------------------------*/
+template <typename num_t>
+void math::nlerp_batch(const quat_t<num_t>* a, const quat_t<num_t>* b, const num_t* t, quat_t<num_t>* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const num_t w1 = (ls::math::dot(a[i], b[i]) < num_t{0}) ? -t[i] : t[i];
+        out[i] = ls::math::normalize((a[i] * (num_t{1} - t[i])) + (b[i] * w1));
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Transform Composition
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    compose_trs_batch
+-------------------------------------*/
+template <typename num_t>
+void math::compose_trs_batch(const vec3_t<num_t>* t, const quat_t<num_t>* r, const vec3_t<num_t>* s, mat4_t<num_t>* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = ls::math::compose_trs(t[i], r[i], s[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    decompose_batch
+-------------------------------------*/
+template <typename num_t>
+void math::decompose_batch(const mat4_t<num_t>* m, vec3_t<num_t>* outT, quat_t<num_t>* outR, vec3_t<num_t>* outS, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ls::math::decompose(m[i], outT[i], outR[i], outS[i]);
+    }
+}
+
+
+
+} // end ls namespace
+
+#endif /* LS_MATH_BATCH_UTILS_IMPL_H */
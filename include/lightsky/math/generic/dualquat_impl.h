@@ -0,0 +1,123 @@
+
+#ifndef LS_MATH_DUALQUAT_IMPL_H
+#define LS_MATH_DUALQUAT_IMPL_H
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+template <typename num_t>
+constexpr LS_INLINE dualquat_t<num_t>::dualquat_t(const quat_t<num_t>& inReal, const quat_t<num_t>& inDual) :
+    real{inReal},
+    dual{inDual}
+{}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template <typename num_t>
+template <typename other_t>
+inline LS_INLINE dualquat_t<num_t>::operator dualquat_t<other_t>() const {
+    return dualquat_t<other_t>{(quat_t<other_t>)real, (quat_t<other_t>)dual};
+}
+
+/*-------------------------------------
+    Dual Quaternion-Dual Quaternion Operators
+-------------------------------------*/
+// quaternion conjugate of both parts
+template <typename num_t> constexpr LS_INLINE
+dualquat_t<num_t> dualquat_t<num_t>::operator-() const {
+    return dualquat_t<num_t>{-real, -dual};
+}
+
+template <typename num_t> constexpr LS_INLINE
+dualquat_t<num_t> dualquat_t<num_t>::operator+(const dualquat_t<num_t>& input) const {
+    return dualquat_t<num_t>{real + input.real, dual + input.dual};
+}
+
+template <typename num_t> constexpr LS_INLINE
+dualquat_t<num_t> dualquat_t<num_t>::operator-(const dualquat_t<num_t>& input) const {
+    return dualquat_t<num_t>{real - input.real, dual - input.dual};
+}
+
+// (r1 + εd1)(r2 + εd2) = r1r2 + ε(r1d2 + d1r2)
+template <typename num_t> constexpr LS_INLINE
+dualquat_t<num_t> dualquat_t<num_t>::operator*(const dualquat_t<num_t>& input) const {
+    return dualquat_t<num_t>{
+        real * input.real,
+        (real * input.dual) + (dual * input.real)
+    };
+}
+
+template <typename num_t> inline LS_INLINE
+dualquat_t<num_t>& dualquat_t<num_t>::operator+=(const dualquat_t<num_t>& input) {
+    real += input.real;
+    dual += input.dual;
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+dualquat_t<num_t>& dualquat_t<num_t>::operator-=(const dualquat_t<num_t>& input) {
+    real -= input.real;
+    dual -= input.dual;
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+dualquat_t<num_t>& dualquat_t<num_t>::operator*=(const dualquat_t<num_t>& input) {
+    return *this = *this * input;
+}
+
+template <typename num_t> constexpr LS_INLINE
+bool dualquat_t<num_t>::operator==(const dualquat_t<num_t>& compare) const {
+    return real == compare.real && dual == compare.dual;
+}
+
+template <typename num_t> constexpr LS_INLINE
+bool dualquat_t<num_t>::operator!=(const dualquat_t<num_t>& compare) const {
+    return real != compare.real || dual != compare.dual;
+}
+
+/*-------------------------------------
+    Dual Quaternion-Scalar Operators
+-------------------------------------*/
+template <typename num_t> constexpr LS_INLINE
+dualquat_t<num_t> dualquat_t<num_t>::operator*(num_t input) const {
+    return dualquat_t<num_t>{real * input, dual * input};
+}
+
+template <typename num_t> constexpr LS_INLINE
+dualquat_t<num_t> dualquat_t<num_t>::operator/(num_t input) const {
+    return dualquat_t<num_t>{real / input, dual / input};
+}
+
+template <typename num_t> inline LS_INLINE
+dualquat_t<num_t>& dualquat_t<num_t>::operator*=(num_t input) {
+    real *= input;
+    dual *= input;
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+dualquat_t<num_t>& dualquat_t<num_t>::operator/=(num_t input) {
+    real /= input;
+    dual /= input;
+    return *this;
+}
+
+/*-------------------------------------
+    Non-Member Dual Quaternion-Scalar operations
+-------------------------------------*/
+template <typename num_t> constexpr LS_INLINE
+dualquat_t<num_t> operator*(num_t n, const dualquat_t<num_t>& dq) {
+    return dq * n;
+}
+
+} //end math namespace
+} //end ls namespace
+
+#endif /* LS_MATH_DUALQUAT_IMPL_H */
@@ -0,0 +1,178 @@
+
+#ifndef LS_MATH_DUALQUAT_UTILS_IMPL_H
+#define LS_MATH_DUALQUAT_UTILS_IMPL_H
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Dual Quaternion Functions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    dot
+-------------------------------------*/
+template <typename num_t> constexpr LS_INLINE
+num_t math::dot(const dualquat_t<num_t>& dq1, const dualquat_t<num_t>& dq2)
+{
+    return math::dot(dq1.real, dq2.real);
+}
+
+/*-------------------------------------
+    conjugate
+-------------------------------------*/
+template <typename num_t> constexpr LS_INLINE
+math::dualquat_t<num_t> math::conjugate(const dualquat_t<num_t>& dq)
+{
+    return dualquat_t<num_t>{math::conjugate(dq.real), math::conjugate(dq.dual)};
+}
+
+/*-------------------------------------
+    normalize
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::dualquat_t<num_t> math::normalize(const dualquat_t<num_t>& dq)
+{
+    const num_t&& magInv = inversesqrt(length_squared(dq.real));
+    return dualquat_t<num_t>{dq.real * magInv, dq.dual * magInv};
+}
+
+/*-------------------------------------
+    nlerp
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::dualquat_t<num_t> math::nlerp(const dualquat_t<num_t>& dq1, const dualquat_t<num_t>& dq2, num_t percent)
+{
+    const num_t w2 = math::dot(dq1, dq2) < num_t{0} ? -percent : percent;
+    return math::normalize((dq1 * (num_t{1} - percent)) + (dq2 * w2));
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Dual Quaternions & Rigid Transformations
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Rotation & Translation to Dual Quaternion
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::dualquat_t<num_t> math::quat_to_dualquat(const quat_t<num_t>& rotation, const vec3_t<num_t>& translation)
+{
+    const quat_t<num_t> t{translation[0], translation[1], translation[2], num_t{0}};
+    return dualquat_t<num_t>{rotation, (t * rotation) * num_t{0.5}};
+}
+
+/*-------------------------------------
+    4x4 Matrix to Dual Quaternion
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::dualquat_t<num_t> math::mat_to_dualquat(const mat4_t<num_t>& m)
+{
+    const vec3_t<num_t> t{m.m[3][0], m.m[3][1], m.m[3][2]};
+    return math::quat_to_dualquat(math::normalize(math::mat_to_quat(m)), t);
+}
+
+/*-------------------------------------
+    Dual Quaternion to 4x4 Matrix
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::mat4_t<num_t> math::dualquat_to_mat4(const dualquat_t<num_t>& dq)
+{
+    const vec3_t<num_t>&& t = math::get_translation(dq);
+    mat4_t<num_t> ret = math::quat_to_mat4(dq.real);
+    ret.m[3] = vec4_t<num_t>{t[0], t[1], t[2], num_t{1}};
+    return ret;
+}
+
+/*-------------------------------------
+    Rotation
+-------------------------------------*/
+template <typename num_t> constexpr LS_INLINE
+math::quat_t<num_t> math::get_rotation(const dualquat_t<num_t>& dq)
+{
+    return dq.real;
+}
+
+/*-------------------------------------
+    Translation
+
+    t = 2 * d * conjugate(r), which only has a vector part.
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3_t<num_t> math::get_translation(const dualquat_t<num_t>& dq)
+{
+    const vec3_t<num_t> rv{dq.real[0], dq.real[1], dq.real[2]};
+    const vec3_t<num_t> dv{dq.dual[0], dq.dual[1], dq.dual[2]};
+    const vec3_t<num_t>&& t = (dv * dq.real[3]) - (rv * dq.dual[3]) + math::cross(rv, dv);
+    return t * num_t{2};
+}
+
+/*-------------------------------------
+    Point Transformation
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3_t<num_t> math::transform_point(const vec3_t<num_t>& p, const dualquat_t<num_t>& dq)
+{
+    return math::rotate(p, dq.real) + math::get_translation(dq);
+}
+
+/*-------------------------------------
+    Normal Transformation
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3_t<num_t> math::transform_normal(const vec3_t<num_t>& n, const dualquat_t<num_t>& dq)
+{
+    return math::rotate(n, dq.real);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Dual Quaternion Skinning
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    dualquat_skin_batch
+-------------------------------------*/
+template <typename num_t, typename index_t>
+void math::dualquat_skin_batch(
+    const dualquat_t<num_t>* palette,
+    const vec3_t<num_t>* positions,
+    const vec3_t<num_t>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<num_t>* weights,
+    vec3_t<num_t>* outPositions,
+    vec3_t<num_t>* outNormals,
+    std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const vec4_t<index_t>& ids = boneIds[i];
+        const vec4_t<num_t>& w = weights[i];
+        const dualquat_t<num_t>& pivot = palette[ids[0]];
+        dualquat_t<num_t> blended = pivot * w[0];
+
+        for (unsigned k = 1; k < 4; ++k)
+        {
+            const dualquat_t<num_t>& dq = palette[ids[k]];
+            blended += dq * (math::dot(pivot, dq) < num_t{0} ? -w[k] : w[k]);
+        }
+
+        blended = math::normalize(blended);
+
+        if (normals)
+        {
+            outNormals[i] = math::transform_normal(normals[i], blended);
+        }
+
+        outPositions[i] = math::transform_point(positions[i], blended);
+    }
+}
+
+
+
+} // end ls namespace
+
+#endif /* LS_MATH_DUALQUAT_UTILS_IMPL_H */
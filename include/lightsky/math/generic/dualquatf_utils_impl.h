@@ -0,0 +1,42 @@
+
+#ifndef LS_MATH_DUALQUATF_UTILS_IMPL_H
+#define LS_MATH_DUALQUATF_UTILS_IMPL_H
+
+#include "lightsky/math/generic/simd_skinning_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Dual Quaternion Skinning
+
+    Shared by the x86 and NEON builds, which only differ in the width of
+    impl::BatchTraits.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    dualquat_skin_batch
+-------------------------------------*/
+template <typename index_t>
+inline void dualquat_skin_batch(
+    const dualquat_t<float>* palette,
+    const vec3_t<float>* positions,
+    const vec3_t<float>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<float>* weights,
+    vec3_t<float>* outPositions,
+    vec3_t<float>* outNormals,
+    std::size_t count) noexcept
+{
+    impl::simd_dualquat_skin<impl::BatchTraits>(palette, positions, normals, boneIds, weights, outPositions, outNormals, count);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_DUALQUATF_UTILS_IMPL_H */
@@ -0,0 +1,771 @@
+
+#ifndef LS_MATH_EXPRESSION_IMPL_H
+#define LS_MATH_EXPRESSION_IMPL_H
+
+#include <type_traits> // std::conditional, std::is_same, std::is_void
+#include <utility> // std::integer_sequence
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+#include "lightsky/setup/Types.h" // setup::EnableIf
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Expression Type Information
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Scalars contain a single component
+-------------------------------------*/
+template <typename value_t>
+struct ExprTraits
+{
+    typedef value_t num_type;
+    typedef value_t chunk_type;
+
+    static constexpr bool is_scalar = true;
+    static constexpr bool is_matrix = false;
+    static constexpr unsigned num_components = 1;
+    static constexpr unsigned num_chunks = 1;
+
+    static LS_INLINE const num_type& component(const value_t& x, unsigned) noexcept { return x; }
+    static LS_INLINE num_type& component(value_t& x, unsigned) noexcept { return x; }
+    static LS_INLINE const chunk_type& chunk(const value_t& x, unsigned) noexcept { return x; }
+    static LS_INLINE chunk_type& chunk(value_t& x, unsigned) noexcept { return x; }
+};
+
+
+
+/*-------------------------------------
+    Vectors are evaluated as a single chunk
+-------------------------------------*/
+template <typename vec_t, typename num_t, unsigned N>
+struct ExprVecTraits
+{
+    typedef num_t num_type;
+    typedef vec_t chunk_type;
+
+    static constexpr bool is_scalar = false;
+    static constexpr bool is_matrix = false;
+    static constexpr unsigned num_components = N;
+    static constexpr unsigned num_chunks = 1;
+
+    static LS_INLINE const num_type& component(const vec_t& x, unsigned i) noexcept { return x.v[i]; }
+    static LS_INLINE num_type& component(vec_t& x, unsigned i) noexcept { return x.v[i]; }
+    static LS_INLINE const chunk_type& chunk(const vec_t& x, unsigned) noexcept { return x; }
+    static LS_INLINE chunk_type& chunk(vec_t& x, unsigned) noexcept { return x; }
+};
+
+template <typename num_t>
+struct ExprTraits<vec2_t<num_t>> : ExprVecTraits<vec2_t<num_t>, num_t, 2>
+{};
+
+template <typename num_t>
+struct ExprTraits<vec3_t<num_t>> : ExprVecTraits<vec3_t<num_t>, num_t, 3>
+{};
+
+template <typename num_t>
+struct ExprTraits<vec4_t<num_t>> : ExprVecTraits<vec4_t<num_t>, num_t, 4>
+{};
+
+template <unsigned N, typename num_t>
+struct ExprTraits<vecN_t<N, num_t>> : ExprVecTraits<vecN_t<N, num_t>, num_t, N>
+{};
+
+
+
+/*-------------------------------------
+    Matrices are evaluated one column at a time
+-------------------------------------*/
+template <typename mat_t, typename col_t, typename num_t, unsigned R, unsigned C>
+struct ExprMatTraits
+{
+    typedef num_t num_type;
+    typedef col_t chunk_type;
+
+    static constexpr bool is_scalar = false;
+    static constexpr bool is_matrix = true;
+    static constexpr unsigned num_components = R * C;
+    static constexpr unsigned num_chunks = C;
+
+    static LS_INLINE const num_type& component(const mat_t& x, unsigned i) noexcept { return x.m[i / R].v[i % R]; }
+    static LS_INLINE num_type& component(mat_t& x, unsigned i) noexcept { return x.m[i / R].v[i % R]; }
+    static LS_INLINE const chunk_type& chunk(const mat_t& x, unsigned i) noexcept { return x.m[i]; }
+    static LS_INLINE chunk_type& chunk(mat_t& x, unsigned i) noexcept { return x.m[i]; }
+};
+
+template <typename num_t>
+struct ExprTraits<mat2_t<num_t>> : ExprMatTraits<mat2_t<num_t>, vec2_t<num_t>, num_t, 2, 2>
+{};
+
+template <typename num_t>
+struct ExprTraits<mat3_t<num_t>> : ExprMatTraits<mat3_t<num_t>, vec3_t<num_t>, num_t, 3, 3>
+{};
+
+template <typename num_t>
+struct ExprTraits<mat4_t<num_t>> : ExprMatTraits<mat4_t<num_t>, vec4_t<num_t>, num_t, 4, 4>
+{};
+
+template <unsigned R, unsigned C, typename num_t>
+struct ExprTraits<matMxN_t<R, C, num_t>> : ExprMatTraits<matMxN_t<R, C, num_t>, vec_t<R, num_t>, num_t, R, C>
+{};
+
+
+
+/*-------------------------------------
+    Types which are evaluated one chunk at a time, using their own SIMD
+    operators. Specialized by each platform.
+-------------------------------------*/
+template <typename value_t>
+struct ExprSimd
+{
+    static constexpr bool value = false;
+};
+
+template <unsigned N, typename num_t>
+struct ExprSimd<vecN_t<N, num_t>>
+{
+    static constexpr bool value = VecNSimd<num_t>::value;
+};
+
+template <typename num_t>
+struct ExprSimd<mat2_t<num_t>> : ExprSimd<vec2_t<num_t>>
+{};
+
+template <typename num_t>
+struct ExprSimd<mat3_t<num_t>> : ExprSimd<vec3_t<num_t>>
+{};
+
+template <typename num_t>
+struct ExprSimd<mat4_t<num_t>> : ExprSimd<vec4_t<num_t>>
+{};
+
+template <unsigned R, unsigned C, typename num_t>
+struct ExprSimd<matMxN_t<R, C, num_t>> : ExprSimd<vec_t<R, num_t>>
+{};
+
+
+
+/*-------------------------------------
+    Scalar arrays which are evaluated one SIMD register at a time.
+    Specialized by each platform.
+-------------------------------------*/
+template <typename value_t>
+struct ExprBatchSimd
+{
+    static constexpr bool value = false;
+};
+
+
+
+/*-------------------------------------
+    Precision used to evaluate each component
+-------------------------------------*/
+template <typename num_t>
+struct ExprScalar
+{
+    typedef num_t type;
+};
+
+template <>
+struct ExprScalar<half>
+{
+    typedef float type;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+    Expression Operands
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Reference to a vector, matrix, or scalar
+-------------------------------------*/
+template <typename value_t>
+struct ExprValue
+{
+    typedef value_t value_type;
+    static constexpr bool is_batch = false;
+
+    const value_t& value;
+
+    template <typename ctx_t>
+    LS_INLINE auto get(const ctx_t& ctx) const noexcept { return ctx.load(value); }
+
+    LS_INLINE operator value_t() const noexcept { return math::eval(*this); }
+};
+
+
+
+/*-------------------------------------
+    Reference to an array
+-------------------------------------*/
+template <typename value_t>
+struct ExprArray
+{
+    typedef value_t value_type;
+    static constexpr bool is_batch = true;
+
+    const value_t* values;
+
+    template <typename ctx_t>
+    LS_INLINE auto get(const ctx_t& ctx) const noexcept { return ctx.load_batch(values); }
+};
+
+
+
+/*-------------------------------------
+    Scalar which is applied to every component
+-------------------------------------*/
+template <typename num_t>
+struct ExprConstant
+{
+    typedef void value_type;
+    static constexpr bool is_batch = false;
+
+    num_t value;
+
+    template <typename ctx_t>
+    LS_INLINE auto get(const ctx_t& ctx) const noexcept { return ctx.broadcast(value); }
+};
+
+
+
+/*-------------------------------------
+    Type produced by two operands. Scalar operands produce "void".
+-------------------------------------*/
+template <typename lhs_t, typename rhs_t>
+struct ExprResult
+{
+    static_assert(std::is_same<lhs_t, rhs_t>::value, "Expressions can only combine vectors or matrices of the same type.");
+    typedef lhs_t type;
+};
+
+template <typename lhs_t>
+struct ExprResult<lhs_t, void>
+{
+    typedef lhs_t type;
+};
+
+template <typename rhs_t>
+struct ExprResult<void, rhs_t>
+{
+    typedef rhs_t type;
+};
+
+template <>
+struct ExprResult<void, void>
+{
+    typedef void type;
+};
+
+
+
+/*-------------------------------------
+    Binary operation
+-------------------------------------*/
+template <typename op_t, typename lhs_t, typename rhs_t>
+struct ExprBinary
+{
+    typedef typename ExprResult<typename lhs_t::value_type, typename rhs_t::value_type>::type value_type;
+    static constexpr bool is_batch = lhs_t::is_batch || rhs_t::is_batch;
+
+    lhs_t lhs;
+    rhs_t rhs;
+
+    template <typename ctx_t>
+    LS_INLINE auto get(const ctx_t& ctx) const noexcept { return op_t::apply(ctx, lhs, rhs); }
+
+    LS_INLINE operator value_type() const noexcept { return math::eval(*this); }
+};
+
+
+
+/*-------------------------------------
+    Negation
+-------------------------------------*/
+template <typename arg_t>
+struct ExprNegate
+{
+    typedef typename arg_t::value_type value_type;
+    static constexpr bool is_batch = arg_t::is_batch;
+
+    arg_t arg;
+
+    template <typename ctx_t>
+    LS_INLINE auto get(const ctx_t& ctx) const noexcept { return ctx.negate(arg.get(ctx)); }
+
+    LS_INLINE operator value_type() const noexcept { return math::eval(*this); }
+};
+
+
+
+/*-------------------------------------
+    Expression Detection
+-------------------------------------*/
+template <typename T>
+struct IsExpr
+{
+    static constexpr bool value = false;
+};
+
+template <typename value_t>
+struct IsExpr<ExprValue<value_t>>
+{
+    static constexpr bool value = true;
+};
+
+template <typename value_t>
+struct IsExpr<ExprArray<value_t>>
+{
+    static constexpr bool value = true;
+};
+
+template <typename num_t>
+struct IsExpr<ExprConstant<num_t>>
+{
+    static constexpr bool value = true;
+};
+
+template <typename op_t, typename lhs_t, typename rhs_t>
+struct IsExpr<ExprBinary<op_t, lhs_t, rhs_t>>
+{
+    static constexpr bool value = true;
+};
+
+template <typename arg_t>
+struct IsExpr<ExprNegate<arg_t>>
+{
+    static constexpr bool value = true;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+    Operations
+
+    Each operation receives its operands unevaluated so products can be
+    fused with an addition or subtraction.
+-----------------------------------------------------------------------------*/
+struct ExprMul
+{
+    template <typename ctx_t, typename lhs_t, typename rhs_t>
+    static LS_INLINE auto apply(const ctx_t& ctx, const lhs_t& lhs, const rhs_t& rhs) noexcept
+    {
+        return ctx.mul(lhs.get(ctx), rhs.get(ctx));
+    }
+};
+
+struct ExprDiv
+{
+    template <typename ctx_t, typename lhs_t, typename rhs_t>
+    static LS_INLINE auto apply(const ctx_t& ctx, const lhs_t& lhs, const rhs_t& rhs) noexcept
+    {
+        return ctx.div(lhs.get(ctx), rhs.get(ctx));
+    }
+};
+
+template <typename T>
+struct IsExprProduct
+{
+    static constexpr bool value = false;
+};
+
+template <typename lhs_t, typename rhs_t>
+struct IsExprProduct<ExprBinary<ExprMul, lhs_t, rhs_t>>
+{
+    static constexpr bool value = true;
+};
+
+struct ExprAdd
+{
+    template <typename ctx_t, typename lhs_t, typename rhs_t>
+    static LS_INLINE auto apply(const ctx_t& ctx, const lhs_t& lhs, const rhs_t& rhs) noexcept
+    {
+        if constexpr (IsExprProduct<lhs_t>::value)
+        {
+            return ctx.fmadd(lhs.lhs.get(ctx), lhs.rhs.get(ctx), rhs.get(ctx));
+        }
+        else if constexpr (IsExprProduct<rhs_t>::value)
+        {
+            return ctx.fmadd(rhs.lhs.get(ctx), rhs.rhs.get(ctx), lhs.get(ctx));
+        }
+        else
+        {
+            return ctx.add(lhs.get(ctx), rhs.get(ctx));
+        }
+    }
+};
+
+struct ExprSub
+{
+    template <typename ctx_t, typename lhs_t, typename rhs_t>
+    static LS_INLINE auto apply(const ctx_t& ctx, const lhs_t& lhs, const rhs_t& rhs) noexcept
+    {
+        if constexpr (IsExprProduct<lhs_t>::value)
+        {
+            return ctx.fmsub(lhs.lhs.get(ctx), lhs.rhs.get(ctx), rhs.get(ctx));
+        }
+        else if constexpr (IsExprProduct<rhs_t>::value)
+        {
+            // a - (b*c) == (-b*c) + a
+            return ctx.fmadd(ctx.negate(rhs.lhs.get(ctx)), rhs.rhs.get(ctx), lhs.get(ctx));
+        }
+        else
+        {
+            return ctx.sub(lhs.get(ctx), rhs.get(ctx));
+        }
+    }
+};
+
+
+
+/*-----------------------------------------------------------------------------
+    Operators
+
+    Only available when at least one operand is an expression, so they never
+    replace the regular vector & matrix operators.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Type produced by any operand
+-------------------------------------*/
+template <typename arg_t, bool = IsExpr<arg_t>::value>
+struct ExprOperandValue
+{
+    typedef typename std::conditional<ExprTraits<arg_t>::is_scalar, void, arg_t>::type type;
+};
+
+template <typename arg_t>
+struct ExprOperandValue<arg_t, true>
+{
+    typedef typename arg_t::value_type type;
+};
+
+
+
+/*-------------------------------------
+    Wrap vectors, matrices, & scalars which aren't already expressions
+-------------------------------------*/
+template <typename num_t, typename arg_t>
+constexpr LS_INLINE auto expr_operand(const arg_t& x) noexcept
+{
+    if constexpr (IsExpr<arg_t>::value)
+    {
+        return x;
+    }
+    else if constexpr (ExprTraits<arg_t>::is_scalar)
+    {
+        return ExprConstant<num_t>{(num_t)x};
+    }
+    else
+    {
+        return ExprValue<arg_t>{x};
+    }
+}
+
+
+
+/*-------------------------------------
+    Create a binary expression
+-------------------------------------*/
+template <typename op_t, typename lhs_t, typename rhs_t>
+constexpr LS_INLINE auto expr_binary(const lhs_t& lhs, const rhs_t& rhs) noexcept
+{
+    typedef typename ExprOperandValue<lhs_t>::type lhs_value_t;
+    typedef typename ExprOperandValue<rhs_t>::type rhs_value_t;
+    typedef typename ExprResult<lhs_value_t, rhs_value_t>::type value_t;
+    typedef typename ExprTraits<value_t>::num_type num_t;
+
+    static_assert(
+        std::is_same<op_t, ExprAdd>::value || std::is_same<op_t, ExprSub>::value || !ExprTraits<value_t>::is_matrix || std::is_void<lhs_value_t>::value || std::is_void<rhs_value_t>::value,
+        "Matrices may only be multiplied or divided by scalars within an expression."
+    );
+
+    const auto l = expr_operand<num_t>(lhs);
+    const auto r = expr_operand<num_t>(rhs);
+    return ExprBinary<op_t, decltype(l), decltype(r)>{l, r};
+}
+
+
+
+/*-------------------------------------
+    Addition
+-------------------------------------*/
+template <typename lhs_t, typename rhs_t, typename setup::EnableIf<IsExpr<lhs_t>::value || IsExpr<rhs_t>::value, bool>::type = true>
+constexpr LS_INLINE auto operator+(const lhs_t& lhs, const rhs_t& rhs) noexcept
+{
+    return expr_binary<ExprAdd>(lhs, rhs);
+}
+
+
+
+/*-------------------------------------
+    Subtraction
+-------------------------------------*/
+template <typename lhs_t, typename rhs_t, typename setup::EnableIf<IsExpr<lhs_t>::value || IsExpr<rhs_t>::value, bool>::type = true>
+constexpr LS_INLINE auto operator-(const lhs_t& lhs, const rhs_t& rhs) noexcept
+{
+    return expr_binary<ExprSub>(lhs, rhs);
+}
+
+
+
+/*-------------------------------------
+    Multiplication
+-------------------------------------*/
+template <typename lhs_t, typename rhs_t, typename setup::EnableIf<IsExpr<lhs_t>::value || IsExpr<rhs_t>::value, bool>::type = true>
+constexpr LS_INLINE auto operator*(const lhs_t& lhs, const rhs_t& rhs) noexcept
+{
+    return expr_binary<ExprMul>(lhs, rhs);
+}
+
+
+
+/*-------------------------------------
+    Division
+-------------------------------------*/
+template <typename lhs_t, typename rhs_t, typename setup::EnableIf<IsExpr<lhs_t>::value || IsExpr<rhs_t>::value, bool>::type = true>
+constexpr LS_INLINE auto operator/(const lhs_t& lhs, const rhs_t& rhs) noexcept
+{
+    return expr_binary<ExprDiv>(lhs, rhs);
+}
+
+
+
+/*-------------------------------------
+    Negation
+-------------------------------------*/
+template <typename arg_t, typename setup::EnableIf<IsExpr<arg_t>::value, bool>::type = true>
+constexpr LS_INLINE ExprNegate<arg_t> operator-(const arg_t& arg) noexcept
+{
+    return ExprNegate<arg_t>{arg};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Evaluation Contexts
+
+    Each operand of an expression loads its value through a context, which
+    also provides the arithmetic used between operands.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    A single component of every vector or matrix, evaluated in
+    "compute_t" precision
+-------------------------------------*/
+template <typename compute_t>
+struct ExprComponentCtx
+{
+    std::size_t index; // element within each array
+    unsigned component;
+
+    template <typename value_t>
+    LS_INLINE compute_t load(const value_t& x) const noexcept { return (compute_t)ExprTraits<value_t>::component(x, component); }
+
+    template <typename value_t>
+    LS_INLINE compute_t load_batch(const value_t* x) const noexcept { return load(x[index]); }
+
+    template <typename num_t>
+    LS_INLINE compute_t broadcast(num_t n) const noexcept { return (compute_t)n; }
+
+    static LS_INLINE compute_t add(compute_t a, compute_t b) noexcept { return a + b; }
+    static LS_INLINE compute_t sub(compute_t a, compute_t b) noexcept { return a - b; }
+    static LS_INLINE compute_t mul(compute_t a, compute_t b) noexcept { return a * b; }
+    static LS_INLINE compute_t div(compute_t a, compute_t b) noexcept { return a / b; }
+    static LS_INLINE compute_t negate(compute_t a) noexcept { return -a; }
+    static LS_INLINE compute_t fmadd(compute_t x, compute_t m, compute_t a) noexcept { return math::fmadd(x, m, a); }
+    static LS_INLINE compute_t fmsub(compute_t x, compute_t m, compute_t a) noexcept { return math::fmsub(x, m, a); }
+};
+
+
+
+/*-------------------------------------
+    An entire vector, or a single column of every matrix, evaluated using
+    the SIMD operators of "chunk_t"
+-------------------------------------*/
+template <typename chunk_t>
+struct ExprChunkCtx
+{
+    std::size_t index; // element within each array
+    unsigned chunk;
+
+    template <typename value_t>
+    LS_INLINE chunk_t load(const value_t& x) const noexcept { return ExprTraits<value_t>::chunk(x, chunk); }
+
+    template <typename value_t>
+    LS_INLINE chunk_t load_batch(const value_t* x) const noexcept { return load(x[index]); }
+
+    template <typename num_t>
+    LS_INLINE chunk_t broadcast(num_t n) const noexcept { return chunk_t{n}; }
+
+    static LS_INLINE chunk_t add(const chunk_t& a, const chunk_t& b) noexcept { return a + b; }
+    static LS_INLINE chunk_t sub(const chunk_t& a, const chunk_t& b) noexcept { return a - b; }
+    static LS_INLINE chunk_t mul(const chunk_t& a, const chunk_t& b) noexcept { return a * b; }
+    static LS_INLINE chunk_t div(const chunk_t& a, const chunk_t& b) noexcept { return a / b; }
+    static LS_INLINE chunk_t negate(const chunk_t& a) noexcept { return -a; }
+    static LS_INLINE chunk_t fmadd(const chunk_t& x, const chunk_t& m, const chunk_t& a) noexcept { return math::fmadd(x, m, a); }
+    static LS_INLINE chunk_t fmsub(const chunk_t& x, const chunk_t& m, const chunk_t& a) noexcept { return math::fmsub(x, m, a); }
+};
+
+
+
+/*-------------------------------------
+    Consecutive elements of single-precision arrays, evaluated using a
+    SIMD register. The final register of an array may be partially filled.
+-------------------------------------*/
+template <typename traits_t, bool partial>
+struct ExprRegisterCtx
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    std::size_t index; // first element within each array
+    unsigned count; // number of elements when "partial" is true
+
+    LS_INLINE float_t load(float x) const noexcept { return T::set1(x); }
+
+    LS_INLINE float_t load_batch(const float* x) const noexcept
+    {
+        if constexpr (partial)
+        {
+            return T::load_partial(x + index, count);
+        }
+        else
+        {
+            return T::load(x + index);
+        }
+    }
+
+    LS_INLINE float_t broadcast(float n) const noexcept { return T::set1(n); }
+
+    static LS_INLINE float_t add(float_t a, float_t b) noexcept { return T::add(a, b); }
+    static LS_INLINE float_t sub(float_t a, float_t b) noexcept { return T::sub(a, b); }
+    static LS_INLINE float_t mul(float_t a, float_t b) noexcept { return T::mul(a, b); }
+    static LS_INLINE float_t div(float_t a, float_t b) noexcept { return T::div(a, b); }
+    static LS_INLINE float_t negate(float_t a) noexcept { return T::bit_xor(a, T::set1(-0.f)); }
+    static LS_INLINE float_t fmadd(float_t x, float_t m, float_t a) noexcept { return T::fmadd(x, m, a); }
+    static LS_INLINE float_t fmsub(float_t x, float_t m, float_t a) noexcept { return T::fmadd(x, m, negate(a)); }
+};
+
+
+
+/*-------------------------------------
+    Evaluate an expression for a single element of its arrays
+-------------------------------------*/
+template <typename expr_t, typename value_t>
+inline LS_INLINE void expr_evaluate(const expr_t& e, value_t& ret, std::size_t index) noexcept
+{
+    typedef ExprTraits<value_t> traits;
+
+    if constexpr (ExprSimd<value_t>::value)
+    {
+        typedef ExprChunkCtx<typename traits::chunk_type> ctx_t;
+
+        [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) noexcept
+        {
+            ((traits::chunk(ret, i) = e.get(ctx_t{index, i})), ...);
+        }(std::make_integer_sequence<unsigned, traits::num_chunks>{});
+    }
+    else
+    {
+        typedef typename traits::num_type num_t;
+        typedef ExprComponentCtx<typename ExprScalar<num_t>::type> ctx_t;
+
+        [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) noexcept
+        {
+            ((traits::component(ret, i) = (num_t)e.get(ctx_t{index, i})), ...);
+        }(std::make_integer_sequence<unsigned, traits::num_components>{});
+    }
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Lazy Expressions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    lazy
+-------------------------------------*/
+template <typename T>
+constexpr LS_INLINE math::impl::ExprValue<T> math::lazy(const T& x) noexcept
+{
+    return math::impl::ExprValue<T>{x};
+}
+
+
+
+/*-------------------------------------
+    lazy_batch
+-------------------------------------*/
+template <typename T>
+constexpr LS_INLINE math::impl::ExprArray<T> math::lazy_batch(const T* x) noexcept
+{
+    return math::impl::ExprArray<T>{x};
+}
+
+
+
+/*-------------------------------------
+    eval
+-------------------------------------*/
+template <typename expr_t>
+inline LS_INLINE typename expr_t::value_type math::eval(const expr_t& e) noexcept
+{
+    static_assert(!expr_t::is_batch, "Expressions containing arrays must be evaluated using eval_batch().");
+
+    typename expr_t::value_type ret;
+    math::impl::expr_evaluate(e, ret, 0);
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    eval_batch
+-------------------------------------*/
+template <typename expr_t>
+inline void math::eval_batch(const expr_t& e, typename expr_t::value_type* out, std::size_t count) noexcept
+{
+    typedef typename expr_t::value_type value_t;
+
+    if constexpr (math::impl::ExprBatchSimd<value_t>::value)
+    {
+        typedef typename math::impl::ExprBatchSimd<value_t>::traits T;
+        std::size_t i = 0;
+
+        for (; i + T::width <= count; i += T::width)
+        {
+            T::store(out+i, e.get(math::impl::ExprRegisterCtx<T, false>{i, T::width}));
+        }
+
+        if (i < count)
+        {
+            const unsigned n = (unsigned)(count - i);
+            T::store_partial(out+i, e.get(math::impl::ExprRegisterCtx<T, true>{i, n}), n);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            math::impl::expr_evaluate(e, out[i], i);
+        }
+    }
+}
+
+
+
+} // end ls namespace
+
+#endif /* LS_MATH_EXPRESSION_IMPL_H */
@@ -0,0 +1,45 @@
+
+#ifndef LS_MATH_EXPRESSIONF_IMPL_H
+#define LS_MATH_EXPRESSIONF_IMPL_H
+
+#include "lightsky/math/batch_utils.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-------------------------------------
+    Single-precision 4D vectors, and the columns of 4x4 matrices, are
+    evaluated using their own SIMD operators
+-------------------------------------*/
+template <>
+struct ExprSimd<vec4_t<float>>
+{
+    static constexpr bool value = true;
+};
+
+
+
+/*-------------------------------------
+    Single-precision arrays are evaluated using the widest available
+    registers
+-------------------------------------*/
+template <>
+struct ExprBatchSimd<float>
+{
+    static constexpr bool value = true;
+    typedef BatchTraits traits;
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_EXPRESSIONF_IMPL_H */
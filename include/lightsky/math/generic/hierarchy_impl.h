@@ -0,0 +1,366 @@
+
+#ifndef LS_MATH_HIERARCHY_IMPL_H
+#define LS_MATH_HIERARCHY_IMPL_H
+
+#include <atomic>
+#include <thread> // std::this_thread::yield()
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Hierarchy Traversal
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Nodes are split into chunks which never span two levels of a hierarchy.
+    Chunks are handed out in order, and a chunk is only processed once every
+    chunk of the previous levels has completed. Since earlier chunks never
+    wait on later ones, threads can't deadlock.
+-------------------------------------*/
+constexpr std::size_t hierarchy_chunk_size = 1024;
+
+template <typename kernel_t>
+void hierarchy_traverse(const TransformHierarchy& hierarchy, unsigned numThreads, const kernel_t& kernel) noexcept
+{
+    const std::size_t numNodes = hierarchy.size();
+    const unsigned numLevels = hierarchy.num_levels();
+
+    numThreads = parallel_thread_count(numThreads);
+    if (numThreads <= 1 || numNodes <= hierarchy_chunk_size)
+    {
+        // parents always precede their children
+        kernel(0, numNodes);
+        return;
+    }
+
+    // index of the first chunk in each level
+    std::vector<std::size_t> levelChunks(numLevels + 1u);
+    levelChunks[0] = 0;
+
+    for (unsigned level = 0; level < numLevels; ++level)
+    {
+        std::size_t first, last;
+        hierarchy.level_range(level, first, last);
+        levelChunks[level+1] = levelChunks[level] + (last - first + hierarchy_chunk_size - 1) / hierarchy_chunk_size;
+    }
+
+    const std::size_t numChunks = levelChunks[numLevels];
+    std::atomic_size_t nextChunk{0};
+    std::atomic_size_t completedChunks{0};
+
+    if ((std::size_t)numThreads > numChunks)
+    {
+        numThreads = (unsigned)numChunks;
+    }
+
+    parallel_for(numThreads, numThreads, [&](std::size_t, unsigned)->void
+    {
+        unsigned level = 0;
+
+        for (std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < numChunks; chunk = nextChunk.fetch_add(1, std::memory_order_relaxed))
+        {
+            while (levelChunks[level+1] <= chunk)
+            {
+                ++level;
+            }
+
+            while (completedChunks.load(std::memory_order_acquire) < levelChunks[level])
+            {
+                std::this_thread::yield();
+            }
+
+            std::size_t levelFirst, levelLast;
+            hierarchy.level_range(level, levelFirst, levelLast);
+
+            const std::size_t first = levelFirst + (chunk - levelChunks[level]) * hierarchy_chunk_size;
+            const std::size_t last = (levelLast - first < hierarchy_chunk_size) ? levelLast : (first + hierarchy_chunk_size);
+            kernel(first, last);
+
+            completedChunks.fetch_add(1, std::memory_order_release);
+        }
+    });
+}
+
+
+
+/*-------------------------------------
+    Update the world transform of each node in the range [first, last),
+    skipping nodes whose local transform and ancestors are unchanged.
+-------------------------------------*/
+template <typename num_t, typename local_t>
+inline void hierarchy_update_range(
+    const uint32_t* parents,
+    uint8_t* dirtyFlags,
+    mat4_t<num_t>* outWorld,
+    std::size_t first,
+    std::size_t last,
+    const local_t& local_transform) noexcept
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const uint32_t p = parents[i];
+
+        if (dirtyFlags)
+        {
+            if (!dirtyFlags[i] && (p == HIERARCHY_ROOT || !dirtyFlags[p]))
+            {
+                continue;
+            }
+
+            dirtyFlags[i] = 1;
+        }
+
+        outWorld[i] = (p == HIERARCHY_ROOT) ? local_transform(i) : (outWorld[p] * local_transform(i));
+    }
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    sort_hierarchy
+-------------------------------------*/
+inline bool sort_hierarchy(const uint32_t* parents, std::size_t count, uint32_t* outOrder, uint32_t* outParents) noexcept
+{
+    // Find the depth of each node by walking up to the nearest node of known
+    // depth. "outParents" temporarily holds each depth, offset by 1 so 0
+    // marks a node which hasn't been visited.
+    uint32_t* const depths = outParents;
+    uint32_t maxDepth = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        depths[i] = 0;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // count the number of unvisited ancestors
+        std::size_t n = 0;
+        uint32_t node = (uint32_t)i;
+
+        while (node != HIERARCHY_ROOT && !depths[node])
+        {
+            if (n++ >= count || (parents[node] >= count && parents[node] != HIERARCHY_ROOT))
+            {
+                return false;
+            }
+            node = parents[node];
+        }
+
+        uint32_t depth = (node == HIERARCHY_ROOT) ? 0u : depths[node];
+        maxDepth = (depth + (uint32_t)n > maxDepth) ? (depth + (uint32_t)n) : maxDepth;
+
+        // assign depths on the way down, using outOrder as a stack
+        node = (uint32_t)i;
+        for (std::size_t j = n; j--;)
+        {
+            outOrder[j] = node;
+            node = parents[node];
+        }
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            depths[outOrder[j]] = ++depth;
+        }
+    }
+
+    // Counting sort by depth, which keeps nodes of the same depth in order
+    std::vector<uint32_t> levelStarts(maxDepth + 1u, 0u);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ++levelStarts[depths[i] - 1u];
+    }
+
+    uint32_t total = 0;
+    for (uint32_t& start : levelStarts)
+    {
+        const uint32_t n = start;
+        start = total;
+        total += n;
+    }
+
+    std::vector<uint32_t> sortedIds(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const uint32_t sortedId = levelStarts[depths[i] - 1u]++;
+        outOrder[sortedId] = (uint32_t)i;
+        sortedIds[i] = sortedId;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const uint32_t p = parents[outOrder[i]];
+        outParents[i] = (p == HIERARCHY_ROOT) ? p : sortedIds[p];
+    }
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    TransformHierarchy Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Initialize
+-------------------------------------*/
+inline bool TransformHierarchy::init(const uint32_t* parentIds, std::size_t count) noexcept
+{
+    clear();
+
+    std::vector<uint32_t> depths(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const uint32_t p = parentIds[i];
+
+        if (p != HIERARCHY_ROOT && p >= i)
+        {
+            levels.clear();
+            return false;
+        }
+
+        depths[i] = (p == HIERARCHY_ROOT) ? 0u : (depths[p] + 1u);
+
+        if (!i || depths[i] != depths[i-1])
+        {
+            if (i && depths[i] < depths[i-1])
+            {
+                levels.clear();
+                return false;
+            }
+
+            levels.push_back((uint32_t)i);
+        }
+    }
+
+    levels.push_back((uint32_t)count);
+    parents.assign(parentIds, parentIds + count);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Clear
+-------------------------------------*/
+inline void TransformHierarchy::clear() noexcept
+{
+    parents.clear();
+    levels.clear();
+}
+
+
+
+/*-------------------------------------
+    Node Count
+-------------------------------------*/
+inline std::size_t TransformHierarchy::size() const noexcept
+{
+    return parents.size();
+}
+
+
+
+/*-------------------------------------
+    Level Count
+-------------------------------------*/
+inline unsigned TransformHierarchy::num_levels() const noexcept
+{
+    return levels.empty() ? 0u : (unsigned)(levels.size() - 1u);
+}
+
+
+
+/*-------------------------------------
+    Nodes in a level
+-------------------------------------*/
+inline void TransformHierarchy::level_range(unsigned level, std::size_t& outFirst, std::size_t& outLast) const noexcept
+{
+    outFirst = levels[level];
+    outLast = levels[level+1];
+}
+
+
+
+/*-------------------------------------
+    Parent Indices
+-------------------------------------*/
+inline const uint32_t* TransformHierarchy::parent_ids() const noexcept
+{
+    return parents.data();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    World Transforms
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    update_world_transforms (TRS)
+-------------------------------------*/
+template <typename N>
+void update_world_transforms(
+    const TransformHierarchy& hierarchy,
+    const vec3_t<N>* positions,
+    const quat_t<N>* rotations,
+    const vec3_t<N>* scales,
+    uint8_t* dirtyFlags,
+    mat4_t<N>* outWorld,
+    unsigned numThreads) noexcept
+{
+    const uint32_t* const parents = hierarchy.parent_ids();
+
+    const auto local_transform = [&](std::size_t i) noexcept->mat4_t<N>
+    {
+        return compose_trs(positions[i], rotations[i], scales[i]);
+    };
+
+    impl::hierarchy_traverse(hierarchy, numThreads, [&](std::size_t first, std::size_t last)->void
+    {
+        impl::hierarchy_update_range(parents, dirtyFlags, outWorld, first, last, local_transform);
+    });
+}
+
+
+
+/*-------------------------------------
+    update_world_transforms (matrices)
+-------------------------------------*/
+template <typename N>
+void update_world_transforms(
+    const TransformHierarchy& hierarchy,
+    const mat4_t<N>* localTransforms,
+    uint8_t* dirtyFlags,
+    mat4_t<N>* outWorld,
+    unsigned numThreads) noexcept
+{
+    const uint32_t* const parents = hierarchy.parent_ids();
+
+    const auto local_transform = [&](std::size_t i) noexcept->const mat4_t<N>&
+    {
+        return localTransforms[i];
+    };
+
+    impl::hierarchy_traverse(hierarchy, numThreads, [&](std::size_t first, std::size_t last)->void
+    {
+        impl::hierarchy_update_range(parents, dirtyFlags, outWorld, first, last, local_transform);
+    });
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_HIERARCHY_IMPL_H */
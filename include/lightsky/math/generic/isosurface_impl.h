@@ -0,0 +1,490 @@
+
+#ifndef LS_MATH_ISOSURFACE_IMPL_H
+#define LS_MATH_ISOSURFACE_IMPL_H
+
+#include <algorithm> // std::lower_bound
+#include <type_traits> // std::is_invocable_v
+
+#include "lightsky/math/vec_utils.h"
+#include "lightsky/math/parallel.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    IsoMesh Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Clear
+-------------------------------------*/
+template <typename num_t>
+inline void IsoMesh<num_t>::clear() noexcept
+{
+    positions.clear();
+    normals.clear();
+    indices.clear();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Surface Nets
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Per-chunk extraction results
+-------------------------------------*/
+template <typename num_t>
+struct IsoChunk
+{
+    // first cell and number of cells within the chunk
+    vec3_t<unsigned> cellOrigin;
+    vec3_t<unsigned> dims;
+
+    // local, X-major, index of every cell which crosses the surface
+    std::vector<uint32_t> activeCells;
+    std::vector<uint8_t> activeMasks;
+
+    std::vector<vec3_t<num_t>> positions;
+    std::vector<vec3_t<num_t>> normals;
+    std::vector<uint32_t> indices;
+
+    std::size_t vertexOffset;
+    std::size_t indexOffset;
+};
+
+
+
+/*-------------------------------------
+    Place a vertex within a cell and calculate its normal
+-------------------------------------*/
+template <typename num_t>
+inline void iso_cell_vertex(
+    const num_t* c,
+    unsigned mask,
+    num_t isoValue,
+    const vec3_t<num_t>& cellPos,
+    const vec3_t<num_t>& cellSize,
+    vec3_t<num_t>& outPos,
+    vec3_t<num_t>& outNorm) noexcept
+{
+    // Pairs of corners connected by each of the 12 cell edges. Corner
+    // indices are encoded as (x | y << 1 | z << 2).
+    static constexpr unsigned char edges[12][2] = {
+        {0, 1}, {2, 3}, {4, 5}, {6, 7},
+        {0, 2}, {1, 3}, {4, 6}, {5, 7},
+        {0, 4}, {1, 5}, {2, 6}, {3, 7}
+    };
+
+    vec3_t<num_t> sum{num_t{0}};
+    unsigned numCrossings = 0;
+
+    for (unsigned e = 0; e < 12; ++e)
+    {
+        const unsigned a = edges[e][0];
+        const unsigned b = edges[e][1];
+
+        if (((mask >> a) ^ (mask >> b)) & 1u)
+        {
+            const num_t t = (isoValue - c[a]) / (c[b] - c[a]);
+            const vec3_t<num_t> pa{(num_t)(a & 1u), (num_t)((a >> 1u) & 1u), (num_t)(a >> 2u)};
+            const vec3_t<num_t> pb{(num_t)(b & 1u), (num_t)((b >> 1u) & 1u), (num_t)(b >> 2u)};
+
+            sum += pa + (pb - pa) * t;
+            ++numCrossings;
+        }
+    }
+
+    const vec3_t<num_t>&& local = sum * (num_t{1} / (num_t)numCrossings);
+    const num_t u = local[0];
+    const num_t v = local[1];
+    const num_t w = local[2];
+
+    // derivative of the trilinear interpolation of all corners
+    const vec3_t<num_t> grad{
+        (num_t{1}-v)*(num_t{1}-w)*(c[1]-c[0]) + v*(num_t{1}-w)*(c[3]-c[2]) + (num_t{1}-v)*w*(c[5]-c[4]) + v*w*(c[7]-c[6]),
+        (num_t{1}-u)*(num_t{1}-w)*(c[2]-c[0]) + u*(num_t{1}-w)*(c[3]-c[1]) + (num_t{1}-u)*w*(c[6]-c[4]) + u*w*(c[7]-c[5]),
+        (num_t{1}-u)*(num_t{1}-v)*(c[4]-c[0]) + u*(num_t{1}-v)*(c[5]-c[1]) + (num_t{1}-u)*v*(c[6]-c[2]) + u*v*(c[7]-c[3])
+    };
+
+    const vec3_t<num_t>&& n = grad / cellSize;
+    const num_t lenSq = math::length_squared(n);
+
+    outPos = cellPos + local * cellSize;
+    outNorm = (lenSq > num_t{0}) ? (n * (num_t{1} / std::sqrt(lenSq))) : vec3_t<num_t>{num_t{0}, num_t{0}, num_t{1}};
+}
+
+
+
+/*-------------------------------------
+    Sample a chunk and place all of its vertices
+-------------------------------------*/
+template <typename num_t, typename sampler_t>
+void iso_chunk_vertices(
+    IsoChunk<num_t>& chunk,
+    const sampler_t& sampler,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& cellSize,
+    num_t isoValue,
+    num_t* samples) noexcept
+{
+    const vec3_t<unsigned>& dims = chunk.dims;
+    const vec3_t<unsigned> sampleDims = dims + vec3_t<unsigned>{1u};
+    const std::size_t sliceLen = (std::size_t)sampleDims[0] * sampleDims[1];
+
+    sampler(samples, chunk.cellOrigin, sampleDims);
+
+    // offsets of each cell corner within the sample buffer
+    const std::size_t cornerOffsets[8] = {
+        0,
+        1,
+        sampleDims[0],
+        sampleDims[0] + 1,
+        sliceLen,
+        sliceLen + 1,
+        sliceLen + sampleDims[0],
+        sliceLen + sampleDims[0] + 1
+    };
+
+    for (unsigned z = 0, cellId = 0; z < dims[2]; ++z)
+    {
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            const num_t* row = samples + z * sliceLen + (std::size_t)y * sampleDims[0];
+
+            for (unsigned x = 0; x < dims[0]; ++x, ++cellId)
+            {
+                num_t c[8];
+                unsigned mask = 0;
+
+                for (unsigned i = 0; i < 8; ++i)
+                {
+                    c[i] = row[x + cornerOffsets[i]];
+                    mask |= (unsigned)(c[i] < isoValue) << i;
+                }
+
+                if (mask == 0u || mask == 0xFFu)
+                {
+                    continue;
+                }
+
+                const vec3_t<unsigned> cell = chunk.cellOrigin + vec3_t<unsigned>{x, y, z};
+                const vec3_t<num_t> cellPos = origin + cellSize * (vec3_t<num_t>)cell;
+                vec3_t<num_t> pos, norm;
+
+                iso_cell_vertex<num_t>(c, mask, isoValue, cellPos, cellSize, pos, norm);
+
+                chunk.activeCells.push_back(cellId);
+                chunk.activeMasks.push_back((uint8_t)mask);
+                chunk.positions.push_back(pos);
+                chunk.normals.push_back(norm);
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Generate the quads of all edges owned by a chunk
+-------------------------------------*/
+template <typename num_t>
+void iso_chunk_faces(
+    IsoChunk<num_t>& chunk,
+    const std::vector<IsoChunk<num_t>>& chunks,
+    const vec3_t<unsigned>& numChunks,
+    unsigned chunkSize,
+    uint32_t* localIndices) noexcept
+{
+    const vec3_t<unsigned>& dims = chunk.dims;
+    const std::size_t numActive = chunk.activeCells.size();
+
+    for (std::size_t i = 0; i < numActive; ++i)
+    {
+        localIndices[chunk.activeCells[i]] = (uint32_t)(chunk.vertexOffset + i);
+    }
+
+    // Vertices of cells within the current chunk come from a dense table.
+    // Cells on the boundary of neighboring chunks are found by a binary
+    // search through the neighbor's sorted list of active cells.
+    auto vertex_at = [&](const vec3_t<unsigned>& cell)->uint32_t
+    {
+        const vec3_t<unsigned>&& local = cell - chunk.cellOrigin;
+
+        if (local[0] < dims[0] && local[1] < dims[1] && local[2] < dims[2])
+        {
+            return localIndices[local[0] + dims[0] * (local[1] + dims[1] * local[2])];
+        }
+
+        const vec3_t<unsigned> c = cell / vec3_t<unsigned>{chunkSize};
+        const IsoChunk<num_t>& neighbor = chunks[c[0] + numChunks[0] * (c[1] + numChunks[1] * c[2])];
+        const vec3_t<unsigned>&& nl = cell - neighbor.cellOrigin;
+        const uint32_t cellId = nl[0] + neighbor.dims[0] * (nl[1] + neighbor.dims[1] * nl[2]);
+
+        const auto iter = std::lower_bound(neighbor.activeCells.begin(), neighbor.activeCells.end(), cellId);
+        return (uint32_t)(neighbor.vertexOffset + (std::size_t)(iter - neighbor.activeCells.begin()));
+    };
+
+    for (std::size_t i = 0; i < numActive; ++i)
+    {
+        const uint32_t cellId = chunk.activeCells[i];
+        const unsigned mask = chunk.activeMasks[i];
+        const vec3_t<unsigned> cell = chunk.cellOrigin + vec3_t<unsigned>{
+            cellId % dims[0],
+            (cellId / dims[0]) % dims[1],
+            cellId / (dims[0] * dims[1])
+        };
+
+        // Each cell owns the three edges leaving its minimum corner
+        for (unsigned a = 0; a < 3; ++a)
+        {
+            if (!(((mask >> (1u << a)) ^ mask) & 1u))
+            {
+                continue;
+            }
+
+            const unsigned b = (a + 1u) % 3u;
+            const unsigned c = (a + 2u) % 3u;
+
+            if (!cell[b] || !cell[c])
+            {
+                continue;
+            }
+
+            vec3_t<unsigned> cb = cell;
+            vec3_t<unsigned> cc = cell;
+            vec3_t<unsigned> cbc = cell;
+            cb[b] -= 1u;
+            cc[c] -= 1u;
+            cbc[b] -= 1u;
+            cbc[c] -= 1u;
+
+            const uint32_t v0 = vertex_at(cbc);
+            const uint32_t v1 = vertex_at(cc);
+            const uint32_t v2 = (uint32_t)(chunk.vertexOffset + i);
+            const uint32_t v3 = vertex_at(cb);
+
+            // Face away from the inside of the surface
+            if (mask & 1u)
+            {
+                chunk.indices.insert(chunk.indices.end(), {v0, v1, v2, v0, v2, v3});
+            }
+            else
+            {
+                chunk.indices.insert(chunk.indices.end(), {v0, v3, v2, v0, v2, v1});
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < numActive; ++i)
+    {
+        localIndices[chunk.activeCells[i]] = ~(uint32_t)0;
+    }
+}
+
+
+
+/*-------------------------------------
+    Chunked Surface Nets
+-------------------------------------*/
+template <typename num_t, typename sampler_t>
+void extract_isosurface_impl(
+    IsoMesh<num_t>& outMesh,
+    const sampler_t& sampler,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& cellSize,
+    const vec3_t<unsigned>& numCells,
+    num_t isoValue,
+    unsigned chunkSize,
+    unsigned numThreads) noexcept
+{
+    outMesh.clear();
+
+    if (!numCells[0] || !numCells[1] || !numCells[2])
+    {
+        return;
+    }
+
+    chunkSize = chunkSize ? chunkSize : 32u;
+    numThreads = parallel_thread_count(numThreads);
+
+    const vec3_t<unsigned> numChunks = (numCells + vec3_t<unsigned>{chunkSize - 1u}) / vec3_t<unsigned>{chunkSize};
+    const std::size_t totalChunks = (std::size_t)numChunks[0] * numChunks[1] * numChunks[2];
+    const std::size_t maxSamples = (std::size_t)(chunkSize + 1u) * (chunkSize + 1u) * (chunkSize + 1u);
+    const std::size_t maxCells = (std::size_t)chunkSize * chunkSize * chunkSize;
+
+    std::vector<IsoChunk<num_t>> chunks{totalChunks};
+    std::vector<std::vector<num_t>> scratch{numThreads};
+    std::vector<std::vector<uint32_t>> localIndices{numThreads};
+
+    for (std::size_t i = 0; i < totalChunks; ++i)
+    {
+        const vec3_t<unsigned> c{
+            (unsigned)(i % numChunks[0]),
+            (unsigned)((i / numChunks[0]) % numChunks[1]),
+            (unsigned)(i / ((std::size_t)numChunks[0] * numChunks[1]))
+        };
+
+        chunks[i].cellOrigin = c * vec3_t<unsigned>{chunkSize};
+        chunks[i].dims = math::min(vec3_t<unsigned>{chunkSize}, numCells - chunks[i].cellOrigin);
+    }
+
+    // Pass 1: sample the field and place one vertex per active cell
+    parallel_for(totalChunks, numThreads, [&](std::size_t chunkId, unsigned threadId)->void
+    {
+        std::vector<num_t>& samples = scratch[threadId];
+        if (samples.empty())
+        {
+            samples.resize(maxSamples);
+        }
+
+        iso_chunk_vertices<num_t>(chunks[chunkId], sampler, origin, cellSize, isoValue, samples.data());
+    });
+
+    std::size_t numVerts = 0;
+    for (IsoChunk<num_t>& chunk : chunks)
+    {
+        chunk.vertexOffset = numVerts;
+        numVerts += chunk.positions.size();
+    }
+
+    // Pass 2: connect the vertices of neighboring cells
+    parallel_for(totalChunks, numThreads, [&](std::size_t chunkId, unsigned threadId)->void
+    {
+        std::vector<uint32_t>& table = localIndices[threadId];
+        if (table.empty())
+        {
+            table.resize(maxCells, ~(uint32_t)0);
+        }
+
+        iso_chunk_faces<num_t>(chunks[chunkId], chunks, numChunks, chunkSize, table.data());
+    });
+
+    std::size_t numIndices = 0;
+    for (IsoChunk<num_t>& chunk : chunks)
+    {
+        chunk.indexOffset = numIndices;
+        numIndices += chunk.indices.size();
+    }
+
+    outMesh.positions.resize(numVerts);
+    outMesh.normals.resize(numVerts);
+    outMesh.indices.resize(numIndices);
+
+    // Pass 3: gather the results of each chunk
+    parallel_for(totalChunks, numThreads, [&](std::size_t chunkId, unsigned)->void
+    {
+        IsoChunk<num_t>& chunk = chunks[chunkId];
+
+        std::copy(chunk.positions.begin(), chunk.positions.end(), outMesh.positions.begin() + chunk.vertexOffset);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), outMesh.normals.begin() + chunk.vertexOffset);
+        std::copy(chunk.indices.begin(), chunk.indices.end(), outMesh.indices.begin() + chunk.indexOffset);
+
+        chunk = IsoChunk<num_t>{};
+    });
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    Extract an isosurface from a field function
+-------------------------------------*/
+template <typename num_t, typename field_func_t>
+void extract_isosurface(
+    IsoMesh<num_t>& outMesh,
+    const field_func_t& field,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& cellSize,
+    const vec3_t<unsigned>& numCells,
+    num_t isoValue,
+    unsigned chunkSize,
+    unsigned numThreads) noexcept
+{
+    if constexpr (std::is_invocable_v<const field_func_t&, const vec3_t<num_t>&>)
+    {
+        const auto sampler = [&](num_t* outValues, const vec3_t<unsigned>& firstPoint, const vec3_t<unsigned>& dims)->void
+        {
+            vec3_t<num_t> p;
+
+            for (unsigned z = 0; z < dims[2]; ++z)
+            {
+                p[2] = origin[2] + cellSize[2] * (num_t)(firstPoint[2] + z);
+
+                for (unsigned y = 0; y < dims[1]; ++y)
+                {
+                    p[1] = origin[1] + cellSize[1] * (num_t)(firstPoint[1] + y);
+
+                    for (unsigned x = 0; x < dims[0]; ++x)
+                    {
+                        p[0] = origin[0] + cellSize[0] * (num_t)(firstPoint[0] + x);
+                        *outValues++ = (num_t)field(p);
+                    }
+                }
+            }
+        };
+
+        impl::extract_isosurface_impl<num_t>(outMesh, sampler, origin, cellSize, numCells, isoValue, chunkSize, numThreads);
+    }
+    else
+    {
+        const auto sampler = [&](num_t* outValues, const vec3_t<unsigned>& firstPoint, const vec3_t<unsigned>& dims)->void
+        {
+            field(outValues, origin + cellSize * (vec3_t<num_t>)firstPoint, cellSize, dims);
+        };
+
+        impl::extract_isosurface_impl<num_t>(outMesh, sampler, origin, cellSize, numCells, isoValue, chunkSize, numThreads);
+    }
+}
+
+
+
+/*-------------------------------------
+    Extract an isosurface from a grid
+-------------------------------------*/
+template <typename num_t>
+void extract_isosurface_grid(
+    IsoMesh<num_t>& outMesh,
+    const num_t* grid,
+    const vec3_t<unsigned>& gridDims,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& cellSize,
+    num_t isoValue,
+    unsigned chunkSize,
+    unsigned numThreads) noexcept
+{
+    if (gridDims[0] < 2u || gridDims[1] < 2u || gridDims[2] < 2u)
+    {
+        outMesh.clear();
+        return;
+    }
+
+    const auto sampler = [&](num_t* outValues, const vec3_t<unsigned>& firstPoint, const vec3_t<unsigned>& dims)->void
+    {
+        for (unsigned z = 0; z < dims[2]; ++z)
+        {
+            for (unsigned y = 0; y < dims[1]; ++y)
+            {
+                const num_t* row = grid + firstPoint[0] + (std::size_t)gridDims[0] * ((firstPoint[1] + y) + (std::size_t)gridDims[1] * (firstPoint[2] + z));
+                std::copy(row, row + dims[0], outValues);
+                outValues += dims[0];
+            }
+        }
+    };
+
+    impl::extract_isosurface_impl<num_t>(outMesh, sampler, origin, cellSize, gridDims - vec3_t<unsigned>{1u}, isoValue, chunkSize, numThreads);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_ISOSURFACE_IMPL_H */
@@ -2,6 +2,8 @@
 #ifndef LS_MATH_MAT_UTILS_IMPL_H
 #define LS_MATH_MAT_UTILS_IMPL_H
 
+#include <utility> // std::integer_sequence
+
 #include "lightsky/setup/Api.h" // LS_INLINE
 
 namespace ls {
@@ -652,6 +654,82 @@ math::mat4_t<num_t> math::billboard(const vec3_t<num_t>& pos, const mat4_t<num_t
     };
 }
 
+/*-----------------------------------------------------------------------------
+    MxN Matrices
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    MxN Transpose
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+math::mat_t<C, R, num_t> math::transpose(const matMxN_t<R, C, num_t>& m) noexcept {
+    return [&]<unsigned... r>(std::integer_sequence<unsigned, r...>) {
+        const auto row = [&]<unsigned... c>(unsigned i, std::integer_sequence<unsigned, c...>) {
+            return vec_t<C, num_t>{m.m[c][i]...};
+        };
+
+        return mat_t<C, R, num_t>{row(r, std::make_integer_sequence<unsigned, C>{})...};
+    }(std::make_integer_sequence<unsigned, R>{});
+}
+
+/*-------------------------------------
+    MxN Determinant
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+num_t math::determinant(const matMxN_t<D, D, num_t>& m) noexcept {
+    const math::impl::MatNLU<D, num_t>&& lu = math::impl::matn_lu_decompose(m);
+
+    num_t ret = lu.sign;
+    for (unsigned i = 0; i < D; ++i)
+    {
+        ret *= lu.lu[i][i];
+    }
+
+    return ret;
+}
+
+/*-------------------------------------
+    MxN Inverse
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+math::matMxN_t<D, D, num_t> math::inverse(const matMxN_t<D, D, num_t>& m) noexcept {
+    const math::impl::MatNLU<D, num_t>&& lu = math::impl::matn_lu_decompose(m);
+    matMxN_t<D, D, num_t> ret{num_t{0}};
+
+    // Solve L*U*x = P*e[j] for each column of the identity matrix
+    for (unsigned j = 0; j < D; ++j)
+    {
+        num_t x[D] = {};
+        for (unsigned r = 0; r < D; ++r)
+        {
+            x[r] = (lu.perm[r] == j) ? num_t{1} : num_t{0};
+        }
+
+        for (unsigned k = 0; k < D; ++k)
+        {
+            for (unsigned r = k + 1; r < D; ++r)
+            {
+                x[r] -= lu.lu[k][r] * x[k];
+            }
+        }
+
+        for (unsigned k = D; k-- > 0;)
+        {
+            x[k] /= lu.lu[k][k];
+            for (unsigned r = 0; r < k; ++r)
+            {
+                x[r] -= lu.lu[k][r] * x[k];
+            }
+        }
+
+        for (unsigned r = 0; r < D; ++r)
+        {
+            ret.m[j][r] = x[r];
+        }
+    }
+
+    return ret;
+}
+
 } // end ls namespace
 
 #endif /* LS_MATH_MAT_UTILS_IMPL_H */
@@ -0,0 +1,316 @@
+
+#ifndef LS_MATH_MATMXN_IMPL_H
+#define LS_MATH_MATMXN_IMPL_H
+
+#include <utility> // std::integer_sequence
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+namespace impl {
+
+
+
+/*-----------------------------------------------------------------------------
+    MxN Matrix Kernels
+
+    Operations are unrolled over each column. Column arithmetic is performed
+    by the column's vector type, which selects its own SIMD registers.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Column "c" of a diagonal matrix
+-------------------------------------*/
+template <unsigned R, unsigned c, typename num_t, unsigned... r>
+constexpr LS_INLINE vec_t<R, num_t> matn_diagonal_column(num_t n, std::integer_sequence<unsigned, r...>) noexcept
+{
+    return vec_t<R, num_t>{((r == c) ? n : num_t{0})...};
+}
+
+
+
+/*-------------------------------------
+    Matrix-vector product, accumulated one column at a time
+-------------------------------------*/
+template <typename mat_type, typename vec_type, unsigned... c>
+constexpr LS_INLINE auto matn_mul_vec(const mat_type& m, const vec_type& v, std::integer_sequence<unsigned, c...>) noexcept
+{
+    return (... + (m[c] * v[c]));
+}
+
+
+
+/*-------------------------------------
+    Matrix-matrix product, one column of the right-hand side at a time
+-------------------------------------*/
+template <typename ret_t, typename lhs_t, typename rhs_t, unsigned... k>
+constexpr LS_INLINE ret_t matn_mul_mat(const lhs_t& a, const rhs_t& b, std::integer_sequence<unsigned, k...>) noexcept
+{
+    return ret_t{(a * b[k])...};
+}
+
+
+
+/*-------------------------------------
+    LU decomposition of a square matrix, with partial pivoting. Both
+    factors are stored in "lu", column-major, with the unit diagonal of L
+    omitted. Row "r" of the decomposition came from row "perm[r]" of the
+    input.
+-------------------------------------*/
+template <unsigned D, typename num_t>
+struct MatNLU
+{
+    num_t lu[D][D];
+    unsigned perm[D];
+    num_t sign;
+};
+
+template <unsigned D, typename num_t>
+constexpr MatNLU<D, num_t> matn_lu_decompose(const matMxN_t<D, D, num_t>& m) noexcept
+{
+    MatNLU<D, num_t> ret{};
+    ret.sign = num_t{1};
+
+    for (unsigned c = 0; c < D; ++c)
+    {
+        ret.perm[c] = c;
+        for (unsigned r = 0; r < D; ++r)
+        {
+            ret.lu[c][r] = m.m[c][r];
+        }
+    }
+
+    for (unsigned k = 0; k < D; ++k)
+    {
+        unsigned p = k;
+        num_t best = (ret.lu[k][k] < num_t{0}) ? -ret.lu[k][k] : ret.lu[k][k];
+
+        for (unsigned r = k + 1; r < D; ++r)
+        {
+            const num_t a = (ret.lu[k][r] < num_t{0}) ? -ret.lu[k][r] : ret.lu[k][r];
+            if (a > best)
+            {
+                best = a;
+                p = r;
+            }
+        }
+
+        if (p != k)
+        {
+            for (unsigned c = 0; c < D; ++c)
+            {
+                const num_t temp = ret.lu[c][k];
+                ret.lu[c][k] = ret.lu[c][p];
+                ret.lu[c][p] = temp;
+            }
+
+            const unsigned temp = ret.perm[k];
+            ret.perm[k] = ret.perm[p];
+            ret.perm[p] = temp;
+            ret.sign = -ret.sign;
+        }
+
+        // Singular matrices leave a zero on the diagonal of U
+        const num_t pivot = ret.lu[k][k];
+        if (pivot == num_t{0})
+        {
+            continue;
+        }
+
+        const num_t invPivot = num_t{1} / pivot;
+        for (unsigned r = k + 1; r < D; ++r)
+        {
+            ret.lu[k][r] *= invPivot;
+        }
+
+        // Columns are contiguous, so the inner loop can be vectorized
+        for (unsigned c = k + 1; c < D; ++c)
+        {
+            const num_t u = ret.lu[c][k];
+            for (unsigned r = k + 1; r < D; ++r)
+            {
+                ret.lu[c][r] -= ret.lu[k][r] * u;
+            }
+        }
+    }
+
+    return ret;
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+// Main Constructor
+template <unsigned R, unsigned C, typename num_t>
+template <typename... cols_t>
+constexpr LS_INLINE matMxN_t<R, C, num_t>::matMxN_t(const col_type& inX, const cols_t&... inRest) :
+    m{inX, inRest...}
+{
+    static_assert(sizeof...(cols_t) + 1 == C, "An MxN matrix must be constructed from exactly C columns.");
+}
+
+template <unsigned R, unsigned C, typename num_t>
+constexpr LS_INLINE matMxN_t<R, C, num_t>::matMxN_t(num_t n) :
+    matMxN_t{n, std::make_integer_sequence<unsigned, C>{}}
+{
+}
+
+template <unsigned R, unsigned C, typename num_t>
+template <unsigned... i>
+constexpr LS_INLINE matMxN_t<R, C, num_t>::matMxN_t(num_t n, std::integer_sequence<unsigned, i...>) :
+    m{impl::matn_diagonal_column<R, i>(n, std::make_integer_sequence<unsigned, R>{})...}
+{
+}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t>
+template <typename other_t>
+constexpr LS_INLINE matMxN_t<R, C, num_t>::operator matMxN_t<R, C, other_t>() const {
+    return [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) {
+        return matMxN_t<R, C, other_t>{((vec_t<R, other_t>)m[i])...};
+    }(std::make_integer_sequence<unsigned, C>{});
+}
+
+/*-------------------------------------
+    Subscripting Operators
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t>
+template <typename index_t>
+constexpr LS_INLINE const vec_t<R, num_t>& matMxN_t<R, C, num_t>::operator[](index_t i) const {
+    return m[i];
+}
+
+template <unsigned R, unsigned C, typename num_t>
+template <typename index_t>
+constexpr LS_INLINE vec_t<R, num_t>& matMxN_t<R, C, num_t>::operator[](index_t i) {
+    return m[i];
+}
+
+/*-------------------------------------
+    Matrix-Matrix Operators
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t> matMxN_t<R, C, num_t>::operator+(const matMxN_t<R, C, num_t>& input) const {
+    return [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) {
+        return matMxN_t<R, C, num_t>{(m[i] + input.m[i])...};
+    }(std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t> matMxN_t<R, C, num_t>::operator-(const matMxN_t<R, C, num_t>& input) const {
+    return [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) {
+        return matMxN_t<R, C, num_t>{(m[i] - input.m[i])...};
+    }(std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t> matMxN_t<R, C, num_t>::operator-() const {
+    return [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) {
+        return matMxN_t<R, C, num_t>{(-m[i])...};
+    }(std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t>& matMxN_t<R, C, num_t>::operator+=(const matMxN_t<R, C, num_t>& input) {
+    return *this = *this + input;
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t>& matMxN_t<R, C, num_t>::operator-=(const matMxN_t<R, C, num_t>& input) {
+    return *this = *this - input;
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+bool matMxN_t<R, C, num_t>::operator==(const matMxN_t<R, C, num_t>& input) const {
+    return [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) {
+        return (... && (m[i] == input.m[i]));
+    }(std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+bool matMxN_t<R, C, num_t>::operator!=(const matMxN_t<R, C, num_t>& input) const {
+    return !(*this == input);
+}
+
+template <unsigned R, unsigned C, typename num_t>
+template <unsigned K>
+constexpr LS_INLINE mat_t<R, K, num_t> matMxN_t<R, C, num_t>::operator*(const matMxN_t<C, K, num_t>& input) const {
+    return impl::matn_mul_mat<mat_t<R, K, num_t>>(*this, input, std::make_integer_sequence<unsigned, K>{});
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+mat_t<R, C, num_t> matMxN_t<R, C, num_t>::operator*(const mat_t<C, C, num_t>& input) const {
+    return impl::matn_mul_mat<mat_t<R, C, num_t>>(*this, input, std::make_integer_sequence<unsigned, C>{});
+}
+
+/*-------------------------------------
+    Matrix-Vector Operators
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+vec_t<R, num_t> matMxN_t<R, C, num_t>::operator*(const vec_t<C, num_t>& v) const {
+    return impl::matn_mul_vec(m, v, std::make_integer_sequence<unsigned, C>{});
+}
+
+/*-------------------------------------
+    Matrix-Scalar Operators
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t> matMxN_t<R, C, num_t>::operator*(num_t n) const {
+    return [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) {
+        return matMxN_t<R, C, num_t>{(m[i] * n)...};
+    }(std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t> matMxN_t<R, C, num_t>::operator/(num_t n) const {
+    return [&]<unsigned... i>(std::integer_sequence<unsigned, i...>) {
+        return matMxN_t<R, C, num_t>{(m[i] / n)...};
+    }(std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t>& matMxN_t<R, C, num_t>::operator*=(num_t n) {
+    return *this = *this * n;
+}
+
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t>& matMxN_t<R, C, num_t>::operator/=(num_t n) {
+    return *this = *this / n;
+}
+
+/*-------------------------------------
+    Non-Member Matrix-Scalar operations
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t> constexpr LS_INLINE
+matMxN_t<R, C, num_t> operator*(num_t n, const matMxN_t<R, C, num_t>& m) {
+    return m * n;
+}
+
+/*-------------------------------------
+    Non-Member Matrix-Matrix operations
+-------------------------------------*/
+template <unsigned C, typename num_t> constexpr LS_INLINE
+mat_t<2, C, num_t> operator*(const mat2_t<num_t>& a, const matMxN_t<2, C, num_t>& b) {
+    return impl::matn_mul_mat<mat_t<2, C, num_t>>(a, b, std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned C, typename num_t> constexpr LS_INLINE
+mat_t<3, C, num_t> operator*(const mat3_t<num_t>& a, const matMxN_t<3, C, num_t>& b) {
+    return impl::matn_mul_mat<mat_t<3, C, num_t>>(a, b, std::make_integer_sequence<unsigned, C>{});
+}
+
+template <unsigned C, typename num_t> constexpr LS_INLINE
+mat_t<4, C, num_t> operator*(const mat4_t<num_t>& a, const matMxN_t<4, C, num_t>& b) {
+    return impl::matn_mul_mat<mat_t<4, C, num_t>>(a, b, std::make_integer_sequence<unsigned, C>{});
+}
+
+} //end math namespace
+} //end ls namespace
+
+#endif /* LS_MATH_MATMXN_IMPL_H */
@@ -3,10 +3,13 @@
 #define LS_MATH_PERLIN_NOISE_IMPL_H
 
 #include <chrono>
+#include <limits> // std::numeric_limits
 #include <utility> // std::move
 
 #include "lightsky/utils/Copy.h"
 
+#include "lightsky/math/vec_utils.h"
+
 namespace ls
 {
 namespace math
@@ -22,6 +25,60 @@ enum : unsigned
 };
 
 
+
+/*-----------------------------------------------------------------------------
+    Shared Noise Helpers
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Shuffle a permutation table which hashes lattice coordinates. The
+    first 256 entries are repeated so lookups can be chained without
+    additional masking.
+-------------------------------------*/
+inline void shuffle_noise_permutations(utils::RandomNum& prng, int* permutations) noexcept
+{
+    // initialize all of the numbers between 0-255
+    for (int i = 0; i < 256; ++i)
+    {
+        permutations[i] = i;
+    }
+
+    // shuffle all of the numbers in the permutations list
+    for (unsigned i = 0; i < 256; ++i)
+    {
+        unsigned index = prng() % 256;
+        int a = permutations[i];
+        permutations[i] = permutations[index];
+        permutations[index] = a;
+    }
+
+    // repeat all of the numbers
+    for (unsigned i = 256, j = 0; i < MAX_PERMUTATIONS; ++i, ++j)
+    {
+        permutations[i] = permutations[j];
+    }
+}
+
+/*-------------------------------------
+    Wrap a lattice coordinate into the range [0, period).
+-------------------------------------*/
+constexpr LS_INLINE int wrap_noise_lattice(int i, int period) noexcept
+{
+    // Tiles are usually sampled within their first period
+    if ((unsigned)i < (unsigned)period)
+    {
+        return i;
+    }
+
+    const int r = i % period;
+    return r < 0 ? (r + period) : r;
+}
+
+} // end impl namespace
+
+
 /*-----------------------------------------------------------------------------
     Perlin Noise Class Definitions
 -----------------------------------------------------------------------------*/
@@ -114,27 +171,7 @@ template<typename num_t>
 void PerlinNoise<num_t>::seed(unsigned long s) noexcept
 {
     prng->seed(s);
-
-    // initialize all of the numbers between 0-255
-    for (int i = 0; i < 256; ++i)
-    {
-        permutations[i] = i;
-    }
-
-    // shuffle all of the numbers in the permutations list
-    for (unsigned i = 0; i < 256; ++i)
-    {
-        unsigned index = (*prng)() % 256;
-        int a = permutations[i];
-        permutations[i] = permutations[index];
-        permutations[index] = a;
-    }
-
-    // repeat all of the numbers
-    for (unsigned i = 256, j = 0; i < MAX_PERMUTATIONS; ++i, ++j)
-    {
-        permutations[i] = permutations[j];
-    }
+    impl::shuffle_noise_permutations(*prng, permutations);
 }
 
 /*-------------------------------------
@@ -194,6 +231,39 @@ double PerlinNoise<num_t>::grad(int hash, double x, double y, double z) noexcept
     return 0.0;
 }
 
+/*-------------------------------------
+    Blend the gradients of a lattice cell
+-------------------------------------*/
+template<typename num_t>
+inline double PerlinNoise<num_t>::lattice_noise(
+    int x0, int x1,
+    int y0, int y1,
+    int z0, int z1,
+    double xr, double yr, double zr) const noexcept
+{
+    // compute how each value fades across u/v/w
+    double u = fade(xr);
+    double v = fade(yr);
+    double w = fade(zr);
+
+    int ax = permutations[x0];
+    int bx = permutations[x1];
+    int aa = permutations[ax + y0];
+    int ab = permutations[ax + y1];
+    int ba = permutations[bx + y0];
+    int bb = permutations[bx + y1];
+
+    double x10 = lerp(grad(permutations[aa + z0], xr, yr, zr), grad(permutations[ba + z0], xr - 1, yr, zr), u);
+    double x11 = lerp(grad(permutations[ab + z0], xr, yr - 1, zr), grad(permutations[bb + z0], xr - 1, yr - 1, zr), u);
+    double x12 = lerp(grad(permutations[aa + z1], xr, yr, zr - 1), grad(permutations[ba + z1], xr - 1, yr, zr - 1), u);
+    double x13 = lerp(grad(permutations[ab + z1], xr, yr - 1, zr - 1), grad(permutations[bb + z1], xr - 1, yr - 1, zr - 1), u);
+
+    double y10 = lerp(x10, x11, v);
+    double y11 = lerp(x12, x13, v);
+
+    return lerp(y10, y11, w);
+}
+
 /*-------------------------------------
     Generate the noise function
 
@@ -207,36 +277,137 @@ template<typename num_t>
 template<typename point_t>
 num_t PerlinNoise<num_t>::get_noise(const vec3_t <point_t>& point) const noexcept
 {
+    const point_t fx = ls::math::floor(point[0]);
+    const point_t fy = ls::math::floor(point[1]);
+    const point_t fz = ls::math::floor(point[2]);
+
     // create coordinates for a "unit cube"
-    int xi = (int)ls::math::floor(point[0]) & 255;
-    int yi = (int)ls::math::floor(point[1]) & 255;
-    int zi = (int)ls::math::floor(point[2]) & 255;
+    int xi = (int)fx & 255;
+    int yi = (int)fy & 255;
+    int zi = (int)fz & 255;
 
-    double xr = point[0] - ls::math::floor(point[0]);
-    double yr = point[1] - ls::math::floor(point[1]);
-    double zr = point[2] - ls::math::floor(point[2]);
+    // The permutation table is repeated, so "i+1" never needs masking
+    return (num_t)lattice_noise(
+        xi, xi + 1,
+        yi, yi + 1,
+        zi, zi + 1,
+        point[0] - fx, point[1] - fy, point[2] - fz
+    );
+}
 
-    // compute how each value fades across u/v/w
-    double u = fade(xr);
-    double v = fade(yr);
-    double w = fade(zr);
+/*-------------------------------------
+    Generate periodic noise
 
-    int a0 = permutations[xi] + yi;
-    int a1 = permutations[a0] + zi;
-    int a2 = permutations[a0 + 1] + zi;
-    int b0 = permutations[xi + 1] + yi;
-    int b1 = permutations[b0] + zi;
-    int b2 = permutations[b0 + 1] + zi;
+    Wrapping the lattice coordinates before hashing them makes the
+    permutation table repeat every "period" cells. Periods larger than 256
+    remain valid since the wrapped coordinates are only masked after the
+    period is applied.
+-------------------------------------*/
+template<typename num_t>
+template<typename point_t>
+num_t PerlinNoise<num_t>::get_noise(const vec3_t <point_t>& point, const vec3_t<int>& period) const noexcept
+{
+    const point_t fx = ls::math::floor(point[0]);
+    const point_t fy = ls::math::floor(point[1]);
+    const point_t fz = ls::math::floor(point[2]);
 
-    double x10 = lerp(grad(permutations[a1], xr, yr, zr), grad(permutations[b1], xr - 1, yr, zr), u);
-    double x11 = lerp(grad(permutations[a2], xr, yr - 1, zr), grad(permutations[b2], xr - 1, yr - 1, zr), u);
-    double x12 = lerp(grad(permutations[a1 + 1], xr, yr, zr - 1), grad(permutations[b1 + 1], xr - 1, yr, zr - 1), u);
-    double x13 = lerp(grad(permutations[a2 + 1], xr, yr - 1, zr - 1), grad(permutations[b2 + 1], xr - 1, yr - 1, zr - 1), u);
+    const int x0 = impl::wrap_noise_lattice((int)fx, period[0]);
+    const int y0 = impl::wrap_noise_lattice((int)fy, period[1]);
+    const int z0 = impl::wrap_noise_lattice((int)fz, period[2]);
 
-    double y10 = lerp(x10, x11, v);
-    double y11 = lerp(x12, x13, v);
+    const int x1 = (x0 + 1 < period[0]) ? (x0 + 1) : 0;
+    const int y1 = (y0 + 1 < period[1]) ? (y0 + 1) : 0;
+    const int z1 = (z0 + 1 < period[2]) ? (z0 + 1) : 0;
+
+    return (num_t)lattice_noise(
+        x0 & 255, x1 & 255,
+        y0 & 255, y1 & 255,
+        z0 & 255, z1 & 255,
+        point[0] - fx, point[1] - fy, point[2] - fz
+    );
+}
+
+/*-------------------------------------
+    Generate noise for an array of points
+-------------------------------------*/
+template<typename num_t>
+void PerlinNoise<num_t>::get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count) const noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        outNoise[i] = this->get_noise(points[i]);
+    }
+}
+
+/*-------------------------------------
+    Generate periodic noise for an array of points
+-------------------------------------*/
+template<typename num_t>
+void PerlinNoise<num_t>::get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count, const vec3_t<int>& period) const noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        outNoise[i] = this->get_noise(points[i], period);
+    }
+}
+
+/*-------------------------------------
+    Generate noise over a grid of points
+-------------------------------------*/
+template<typename num_t>
+void PerlinNoise<num_t>::get_noise_grid(
+    num_t* outNoise,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& stride,
+    const vec3_t<unsigned>& dims) const noexcept
+{
+    vec3_t<num_t> p;
 
-    return (num_t)lerp(y10, y11, w);
+    for (unsigned z = 0; z < dims[2]; ++z)
+    {
+        p[2] = origin[2] + stride[2] * (num_t)z;
+
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            p[1] = origin[1] + stride[1] * (num_t)y;
+
+            for (unsigned x = 0; x < dims[0]; ++x)
+            {
+                p[0] = origin[0] + stride[0] * (num_t)x;
+                *outNoise++ = this->get_noise(p);
+            }
+        }
+    }
+}
+
+/*-------------------------------------
+    Generate periodic noise over a grid of points
+-------------------------------------*/
+template<typename num_t>
+void PerlinNoise<num_t>::get_noise_grid(
+    num_t* outNoise,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& stride,
+    const vec3_t<unsigned>& dims,
+    const vec3_t<int>& period) const noexcept
+{
+    vec3_t<num_t> p;
+
+    for (unsigned z = 0; z < dims[2]; ++z)
+    {
+        p[2] = origin[2] + stride[2] * (num_t)z;
+
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            p[1] = origin[1] + stride[1] * (num_t)y;
+
+            for (unsigned x = 0; x < dims[0]; ++x)
+            {
+                p[0] = origin[0] + stride[0] * (num_t)x;
+                *outNoise++ = this->get_noise(p, period);
+            }
+        }
+    }
 }
 
 /*-------------------------------------
@@ -264,6 +435,858 @@ num_t PerlinNoise<num_t>::get_octave_noise(const vec3_t <num_t>& point, unsigned
     return total / maxValue;
 }
 
+/*-------------------------------------
+    Generate periodic noise with several octaves.
+-------------------------------------*/
+template<typename num_t>
+num_t PerlinNoise<num_t>::get_octave_noise(const vec3_t <num_t>& point, unsigned octaves, num_t persistence, const vec3_t<int>& period) const noexcept
+{
+    num_t total = num_t{0};
+    num_t frequency = num_t{1};
+    num_t amplitude = num_t{1};
+    num_t maxValue = num_t{0};
+    vec3_t<int> octavePeriod = period;
+
+    for (unsigned i = 0; i < octaves; ++i)
+    {
+        total += get_noise(point * frequency, octavePeriod) * amplitude;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= num_t{2};
+        octavePeriod = octavePeriod * 2;
+    }
+
+    return maxValue > num_t{0} ? (total / maxValue) : num_t{0};
+}
+
+
+
+
+/*-----------------------------------------------------------------------------
+    Value Noise Class Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Destructor
+-------------------------------------*/
+template<typename num_t>
+ValueNoise<num_t>::~ValueNoise() noexcept
+{
+    delete prng;
+    delete[] permutations;
+    delete[] values;
+}
+
+/*-------------------------------------
+    Constructor
+-------------------------------------*/
+template<typename num_t>
+ValueNoise<num_t>::ValueNoise() noexcept :
+    ValueNoise{(long unsigned)std::chrono::system_clock::now().time_since_epoch().count()}
+{}
+
+/*-------------------------------------
+    Random Seed Constructor
+-------------------------------------*/
+template<typename num_t>
+ValueNoise<num_t>::ValueNoise(unsigned long s) noexcept :
+    prng{new utils::RandomNum{}},
+    permutations{new int[MAX_PERMUTATIONS]},
+    values{new num_t[256]}
+{
+    this->seed(s);
+}
+
+/*-------------------------------------
+    Copy Constructor
+-------------------------------------*/
+template<typename num_t>
+ValueNoise<num_t>::ValueNoise(const ValueNoise& vn) noexcept :
+    prng{new utils::RandomNum{*(vn.prng)}},
+    permutations{new int[MAX_PERMUTATIONS]},
+    values{new num_t[256]}
+{
+    ls::utils::fast_memcpy(permutations, vn.permutations, MAX_PERMUTATIONS * sizeof(int));
+    ls::utils::fast_memcpy(values, vn.values, 256 * sizeof(num_t));
+}
+
+/*-------------------------------------
+    Move Constructor
+-------------------------------------*/
+template<typename num_t>
+ValueNoise<num_t>::ValueNoise(ValueNoise&& vn) noexcept :
+    prng{vn.prng},
+    permutations{vn.permutations},
+    values{vn.values}
+{
+    vn.prng = nullptr;
+    vn.permutations = nullptr;
+    vn.values = nullptr;
+}
+
+/*-------------------------------------
+    Copy Operator
+-------------------------------------*/
+template<typename num_t>
+ValueNoise <num_t>& ValueNoise<num_t>::operator=(const ValueNoise& vn) noexcept
+{
+    *prng = *vn.prng;
+
+    ls::utils::fast_memcpy(permutations, vn.permutations, MAX_PERMUTATIONS * sizeof(int));
+    ls::utils::fast_memcpy(values, vn.values, 256 * sizeof(num_t));
+
+    return *this;
+}
+
+/*-------------------------------------
+    Move Operator
+-------------------------------------*/
+template<typename num_t>
+ValueNoise <num_t>& ValueNoise<num_t>::operator=(ValueNoise&& vn) noexcept
+{
+    delete prng;
+    prng = vn.prng;
+    vn.prng = nullptr;
+
+    delete[] permutations;
+    permutations = vn.permutations;
+    vn.permutations = nullptr;
+
+    delete[] values;
+    values = vn.values;
+    vn.values = nullptr;
+
+    return *this;
+}
+
+/*-------------------------------------
+    Regenerate the noise permutations and lattice values
+-------------------------------------*/
+template<typename num_t>
+void ValueNoise<num_t>::seed(unsigned long s) noexcept
+{
+    prng->seed(s);
+    impl::shuffle_noise_permutations(*prng, permutations);
+
+    for (unsigned i = 0; i < 256; ++i)
+    {
+        values[i] = (num_t)((*prng)() % 0x10000u) * num_t{2.0 / 65535.0} - num_t{1};
+    }
+}
+
+/*-------------------------------------
+    Regenerate the noise permutations and lattice values
+-------------------------------------*/
+template<typename num_t>
+void ValueNoise<num_t>::seed() noexcept
+{
+    this->seed((long unsigned)std::chrono::system_clock::now().time_since_epoch().count());
+}
+
+/*-------------------------------------
+    Blend the values of a lattice cell
+
+    The four X-axis interpolations of the cell corners are performed at
+    once, leaving two Y-axis and one Z-axis interpolation.
+-------------------------------------*/
+template<typename num_t>
+inline num_t ValueNoise<num_t>::lattice_noise(
+    int x0, int x1,
+    int y0, int y1,
+    int z0, int z1,
+    num_t xr, num_t yr, num_t zr) const noexcept
+{
+    const num_t u = math::impl::smootherstep_impl<num_t>(xr);
+    const num_t v = math::impl::smootherstep_impl<num_t>(yr);
+    const num_t w = math::impl::smootherstep_impl<num_t>(zr);
+
+    const int ax = permutations[x0];
+    const int bx = permutations[x1];
+    const int aa = permutations[ax + y0];
+    const int ab = permutations[ax + y1];
+    const int ba = permutations[bx + y0];
+    const int bb = permutations[bx + y1];
+
+    // corners are ordered as (y0z0, y1z0, y0z1, y1z1)
+    const vec4_t<num_t> c0{
+        values[permutations[aa + z0]],
+        values[permutations[ab + z0]],
+        values[permutations[aa + z1]],
+        values[permutations[ab + z1]]
+    };
+
+    const vec4_t<num_t> c1{
+        values[permutations[ba + z0]],
+        values[permutations[bb + z0]],
+        values[permutations[ba + z1]],
+        values[permutations[bb + z1]]
+    };
+
+    const vec4_t<num_t>&& xl = ls::math::fmadd(c1 - c0, vec4_t<num_t>{u}, c0);
+    const num_t yl0 = xl[0] + v * (xl[1] - xl[0]);
+    const num_t yl1 = xl[2] + v * (xl[3] - xl[2]);
+
+    return yl0 + w * (yl1 - yl0);
+}
+
+/*-------------------------------------
+    Generate the noise function
+-------------------------------------*/
+template<typename num_t>
+num_t ValueNoise<num_t>::get_noise(const vec3_t<num_t>& point) const noexcept
+{
+    const num_t fx = ls::math::floor(point[0]);
+    const num_t fy = ls::math::floor(point[1]);
+    const num_t fz = ls::math::floor(point[2]);
+
+    const int xi = (int)fx & 255;
+    const int yi = (int)fy & 255;
+    const int zi = (int)fz & 255;
+
+    return lattice_noise(
+        xi, xi + 1,
+        yi, yi + 1,
+        zi, zi + 1,
+        point[0] - fx, point[1] - fy, point[2] - fz
+    );
+}
+
+/*-------------------------------------
+    Generate periodic noise
+-------------------------------------*/
+template<typename num_t>
+num_t ValueNoise<num_t>::get_noise(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept
+{
+    const num_t fx = ls::math::floor(point[0]);
+    const num_t fy = ls::math::floor(point[1]);
+    const num_t fz = ls::math::floor(point[2]);
+
+    const int x0 = impl::wrap_noise_lattice((int)fx, period[0]);
+    const int y0 = impl::wrap_noise_lattice((int)fy, period[1]);
+    const int z0 = impl::wrap_noise_lattice((int)fz, period[2]);
+
+    const int x1 = (x0 + 1 < period[0]) ? (x0 + 1) : 0;
+    const int y1 = (y0 + 1 < period[1]) ? (y0 + 1) : 0;
+    const int z1 = (z0 + 1 < period[2]) ? (z0 + 1) : 0;
+
+    return lattice_noise(
+        x0 & 255, x1 & 255,
+        y0 & 255, y1 & 255,
+        z0 & 255, z1 & 255,
+        point[0] - fx, point[1] - fy, point[2] - fz
+    );
+}
+
+/*-------------------------------------
+    Generate noise for an array of points
+-------------------------------------*/
+template<typename num_t>
+void ValueNoise<num_t>::get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count) const noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        outNoise[i] = this->get_noise(points[i]);
+    }
+}
+
+/*-------------------------------------
+    Generate periodic noise for an array of points
+-------------------------------------*/
+template<typename num_t>
+void ValueNoise<num_t>::get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count, const vec3_t<int>& period) const noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        outNoise[i] = this->get_noise(points[i], period);
+    }
+}
+
+/*-------------------------------------
+    Generate noise over a grid of points
+-------------------------------------*/
+template<typename num_t>
+void ValueNoise<num_t>::get_noise_grid(
+    num_t* outNoise,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& stride,
+    const vec3_t<unsigned>& dims) const noexcept
+{
+    vec3_t<num_t> p;
+
+    for (unsigned z = 0; z < dims[2]; ++z)
+    {
+        p[2] = origin[2] + stride[2] * (num_t)z;
+
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            p[1] = origin[1] + stride[1] * (num_t)y;
+
+            for (unsigned x = 0; x < dims[0]; ++x)
+            {
+                p[0] = origin[0] + stride[0] * (num_t)x;
+                *outNoise++ = this->get_noise(p);
+            }
+        }
+    }
+}
+
+/*-------------------------------------
+    Generate periodic noise over a grid of points
+-------------------------------------*/
+template<typename num_t>
+void ValueNoise<num_t>::get_noise_grid(
+    num_t* outNoise,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& stride,
+    const vec3_t<unsigned>& dims,
+    const vec3_t<int>& period) const noexcept
+{
+    vec3_t<num_t> p;
+
+    for (unsigned z = 0; z < dims[2]; ++z)
+    {
+        p[2] = origin[2] + stride[2] * (num_t)z;
+
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            p[1] = origin[1] + stride[1] * (num_t)y;
+
+            for (unsigned x = 0; x < dims[0]; ++x)
+            {
+                p[0] = origin[0] + stride[0] * (num_t)x;
+                *outNoise++ = this->get_noise(p, period);
+            }
+        }
+    }
+}
+
+/*-------------------------------------
+    Generate a fractal sum of noise octaves.
+-------------------------------------*/
+template<typename num_t>
+num_t ValueNoise<num_t>::get_octave_noise(const vec3_t <num_t>& point, unsigned octaves, num_t persistence) const noexcept
+{
+    num_t total = num_t{0};
+    num_t frequency = num_t{1};
+    num_t amplitude = num_t{1};
+    num_t maxValue = num_t{0};
+
+    for (unsigned i = 0; i < octaves; ++i)
+    {
+        total += this->get_noise(point * frequency) * amplitude;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= num_t{2};
+    }
+
+    return maxValue > num_t{0} ? (total / maxValue) : num_t{0};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Worley Noise Class Definitions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Destructor
+-------------------------------------*/
+template<typename num_t>
+WorleyNoise<num_t>::~WorleyNoise() noexcept
+{
+    delete prng;
+    delete[] permutations;
+    delete[] features;
+}
+
+/*-------------------------------------
+    Constructor
+-------------------------------------*/
+template<typename num_t>
+WorleyNoise<num_t>::WorleyNoise() noexcept :
+    WorleyNoise{(long unsigned)std::chrono::system_clock::now().time_since_epoch().count()}
+{}
+
+/*-------------------------------------
+    Random Seed Constructor
+-------------------------------------*/
+template<typename num_t>
+WorleyNoise<num_t>::WorleyNoise(unsigned long s, DistanceMetric distanceMetric) noexcept :
+    prng{new utils::RandomNum{}},
+    permutations{new int[MAX_PERMUTATIONS]},
+    features{new num_t[768]},
+    metric{distanceMetric}
+{
+    this->seed(s);
+}
+
+/*-------------------------------------
+    Copy Constructor
+-------------------------------------*/
+template<typename num_t>
+WorleyNoise<num_t>::WorleyNoise(const WorleyNoise& wn) noexcept :
+    prng{new utils::RandomNum{*(wn.prng)}},
+    permutations{new int[MAX_PERMUTATIONS]},
+    features{new num_t[768]},
+    metric{wn.metric}
+{
+    ls::utils::fast_memcpy(permutations, wn.permutations, MAX_PERMUTATIONS * sizeof(int));
+    ls::utils::fast_memcpy(features, wn.features, 768 * sizeof(num_t));
+}
+
+/*-------------------------------------
+    Move Constructor
+-------------------------------------*/
+template<typename num_t>
+WorleyNoise<num_t>::WorleyNoise(WorleyNoise&& wn) noexcept :
+    prng{wn.prng},
+    permutations{wn.permutations},
+    features{wn.features},
+    metric{wn.metric}
+{
+    wn.prng = nullptr;
+    wn.permutations = nullptr;
+    wn.features = nullptr;
+}
+
+/*-------------------------------------
+    Copy Operator
+-------------------------------------*/
+template<typename num_t>
+WorleyNoise <num_t>& WorleyNoise<num_t>::operator=(const WorleyNoise& wn) noexcept
+{
+    *prng = *wn.prng;
+
+    ls::utils::fast_memcpy(permutations, wn.permutations, MAX_PERMUTATIONS * sizeof(int));
+    ls::utils::fast_memcpy(features, wn.features, 768 * sizeof(num_t));
+    metric = wn.metric;
+
+    return *this;
+}
+
+/*-------------------------------------
+    Move Operator
+-------------------------------------*/
+template<typename num_t>
+WorleyNoise <num_t>& WorleyNoise<num_t>::operator=(WorleyNoise&& wn) noexcept
+{
+    delete prng;
+    prng = wn.prng;
+    wn.prng = nullptr;
+
+    delete[] permutations;
+    permutations = wn.permutations;
+    wn.permutations = nullptr;
+
+    delete[] features;
+    features = wn.features;
+    wn.features = nullptr;
+
+    metric = wn.metric;
+
+    return *this;
+}
+
+/*-------------------------------------
+    Regenerate the noise permutations and feature points
+-------------------------------------*/
+template<typename num_t>
+void WorleyNoise<num_t>::seed(unsigned long s) noexcept
+{
+    prng->seed(s);
+    impl::shuffle_noise_permutations(*prng, permutations);
+
+    for (unsigned i = 0; i < 768; ++i)
+    {
+        features[i] = (num_t)((*prng)() % 0x10000u) * num_t{1.0 / 65536.0};
+    }
+}
+
+/*-------------------------------------
+    Regenerate the noise permutations and feature points
+-------------------------------------*/
+template<typename num_t>
+void WorleyNoise<num_t>::seed() noexcept
+{
+    this->seed((long unsigned)std::chrono::system_clock::now().time_since_epoch().count());
+}
+
+/*-------------------------------------
+    Set the distance metric
+-------------------------------------*/
+template<typename num_t>
+inline void WorleyNoise<num_t>::distance_metric(DistanceMetric distanceMetric) noexcept
+{
+    metric = distanceMetric;
+}
+
+/*-------------------------------------
+    Get the distance metric
+-------------------------------------*/
+template<typename num_t>
+inline typename WorleyNoise<num_t>::DistanceMetric WorleyNoise<num_t>::distance_metric() const noexcept
+{
+    return metric;
+}
+
+/*-------------------------------------
+    Feature-point search
+
+    The 27 neighboring cells are hashed up-front, then their feature points
+    are measured four at a time. A 28th candidate pads the final packet and
+    is placed far enough away that it can never be selected. Each SIMD lane
+    tracks its own (F1, F2) pair, which are merged once all packets have
+    been tested.
+-------------------------------------*/
+template<typename num_t>
+template<typename WorleyNoise<num_t>::DistanceMetric metric_type, bool periodic>
+inline vec2_t<num_t> WorleyNoise<num_t>::find_features(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept
+{
+    alignas(16) static constexpr num_t offsetX[28] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 1,
+        8
+    };
+
+    alignas(16) static constexpr num_t offsetY[28] = {
+        -1, -1, -1, 0, 0, 0, 1, 1, 1,
+        -1, -1, -1, 0, 0, 0, 1, 1, 1,
+        -1, -1, -1, 0, 0, 0, 1, 1, 1,
+        8
+    };
+
+    alignas(16) static constexpr num_t offsetZ[28] = {
+        -1, 0, 1, -1, 0, 1, -1, 0, 1,
+        -1, 0, 1, -1, 0, 1, -1, 0, 1,
+        -1, 0, 1, -1, 0, 1, -1, 0, 1,
+        8
+    };
+
+    const num_t fx = ls::math::floor(point[0]);
+    const num_t fy = ls::math::floor(point[1]);
+    const num_t fz = ls::math::floor(point[2]);
+
+    const int xi = (int)fx;
+    const int yi = (int)fy;
+    const int zi = (int)fz;
+
+    const vec4_t<num_t> rx{point[0] - fx};
+    const vec4_t<num_t> ry{point[1] - fy};
+    const vec4_t<num_t> rz{point[2] - fz};
+
+    int cellX[3], cellY[3], cellZ[3];
+    if constexpr (periodic)
+    {
+        const int cells[3] = {xi, yi, zi};
+        int* const wrapped[3] = {cellX, cellY, cellZ};
+
+        // Only the center cell needs a modulo, its neighbors wrap by one
+        for (int i = 0; i < 3; ++i)
+        {
+            const int c = impl::wrap_noise_lattice(cells[i], period[i]);
+            wrapped[i][0] = ((c > 0) ? (c - 1) : (period[i] - 1)) & 255;
+            wrapped[i][1] = c & 255;
+            wrapped[i][2] = ((c + 1 < period[i]) ? (c + 1) : 0) & 255;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            cellX[i] = (xi + i - 1) & 255;
+            cellY[i] = (yi + i - 1) & 255;
+            cellZ[i] = (zi + i - 1) & 255;
+        }
+    }
+
+    int hashes[28];
+    for (int i = 0, n = 0; i < 3; ++i)
+    {
+        const int a = permutations[cellX[i]];
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const int b = permutations[a + cellY[j]];
+
+            for (int k = 0; k < 3; ++k, ++n)
+            {
+                hashes[n] = permutations[b + cellZ[k]];
+            }
+        }
+    }
+    hashes[27] = hashes[26];
+
+    const num_t* const jx = features;
+    const num_t* const jy = features + 256;
+    const num_t* const jz = features + 512;
+
+    vec4_t<num_t> f1{std::numeric_limits<num_t>::max()};
+    vec4_t<num_t> f2{std::numeric_limits<num_t>::max()};
+
+    for (unsigned n = 0; n < 28; n += 4)
+    {
+        const int* h = hashes + n;
+
+        const vec4_t<num_t>&& dx = vec4_t<num_t>{jx[h[0]], jx[h[1]], jx[h[2]], jx[h[3]]} + vec4_t<num_t>{offsetX[n], offsetX[n+1], offsetX[n+2], offsetX[n+3]} - rx;
+        const vec4_t<num_t>&& dy = vec4_t<num_t>{jy[h[0]], jy[h[1]], jy[h[2]], jy[h[3]]} + vec4_t<num_t>{offsetY[n], offsetY[n+1], offsetY[n+2], offsetY[n+3]} - ry;
+        const vec4_t<num_t>&& dz = vec4_t<num_t>{jz[h[0]], jz[h[1]], jz[h[2]], jz[h[3]]} + vec4_t<num_t>{offsetZ[n], offsetZ[n+1], offsetZ[n+2], offsetZ[n+3]} - rz;
+
+        vec4_t<num_t> d;
+        if constexpr (metric_type == WORLEY_DIST_MANHATTAN)
+        {
+            d = ls::math::abs(dx) + ls::math::abs(dy) + ls::math::abs(dz);
+        }
+        else if constexpr (metric_type == WORLEY_DIST_CHEBYSHEV)
+        {
+            d = ls::math::max(ls::math::max(ls::math::abs(dx), ls::math::abs(dy)), ls::math::abs(dz));
+        }
+        else
+        {
+            d = ls::math::fmadd(dx, dx, ls::math::fmadd(dy, dy, dz * dz));
+        }
+
+        f2 = ls::math::min(f2, ls::math::max(f1, d));
+        f1 = ls::math::min(f1, d);
+    }
+
+    // Merge the sorted (F1, F2) pairs of each lane
+    num_t d1 = f1[0];
+    num_t d2 = f2[0];
+    for (unsigned i = 1; i < 4; ++i)
+    {
+        d2 = ls::math::min(ls::math::min(d2, f2[i]), ls::math::max(d1, f1[i]));
+        d1 = ls::math::min(d1, f1[i]);
+    }
+
+    if constexpr (metric_type == WORLEY_DIST_EUCLIDEAN)
+    {
+        return vec2_t<num_t>{std::sqrt(d1), std::sqrt(d2)};
+    }
+    else
+    {
+        return vec2_t<num_t>{d1, d2};
+    }
+}
+
+/*-------------------------------------
+    Get the F1 & F2 distances of a point
+-------------------------------------*/
+template<typename num_t>
+vec2_t<num_t> WorleyNoise<num_t>::get_features(const vec3_t<num_t>& point) const noexcept
+{
+    switch (metric)
+    {
+        case WORLEY_DIST_MANHATTAN: return this->find_features<WORLEY_DIST_MANHATTAN, false>(point, vec3_t<int>{256});
+        case WORLEY_DIST_CHEBYSHEV: return this->find_features<WORLEY_DIST_CHEBYSHEV, false>(point, vec3_t<int>{256});
+        default: break;
+    }
+
+    return this->find_features<WORLEY_DIST_EUCLIDEAN, false>(point, vec3_t<int>{256});
+}
+
+/*-------------------------------------
+    Get the periodic F1 & F2 distances of a point
+-------------------------------------*/
+template<typename num_t>
+vec2_t<num_t> WorleyNoise<num_t>::get_features(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept
+{
+    switch (metric)
+    {
+        case WORLEY_DIST_MANHATTAN: return this->find_features<WORLEY_DIST_MANHATTAN, true>(point, period);
+        case WORLEY_DIST_CHEBYSHEV: return this->find_features<WORLEY_DIST_CHEBYSHEV, true>(point, period);
+        default: break;
+    }
+
+    return this->find_features<WORLEY_DIST_EUCLIDEAN, true>(point, period);
+}
+
+/*-------------------------------------
+    Get the F1 & F2 distances of an array of points
+-------------------------------------*/
+template<typename num_t>
+void WorleyNoise<num_t>::get_features(const vec3_t<num_t>* points, vec2_t<num_t>* outFeatures, std::size_t count) const noexcept
+{
+    switch (metric)
+    {
+        case WORLEY_DIST_MANHATTAN:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outFeatures[i] = this->find_features<WORLEY_DIST_MANHATTAN, false>(points[i], vec3_t<int>{256});
+            }
+            break;
+
+        case WORLEY_DIST_CHEBYSHEV:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outFeatures[i] = this->find_features<WORLEY_DIST_CHEBYSHEV, false>(points[i], vec3_t<int>{256});
+            }
+            break;
+
+        default:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outFeatures[i] = this->find_features<WORLEY_DIST_EUCLIDEAN, false>(points[i], vec3_t<int>{256});
+            }
+    }
+}
+
+/*-------------------------------------
+    Get the F1 distance of a point
+-------------------------------------*/
+template<typename num_t>
+num_t WorleyNoise<num_t>::get_noise(const vec3_t<num_t>& point) const noexcept
+{
+    return this->get_features(point)[0];
+}
+
+/*-------------------------------------
+    Get the periodic F1 distance of a point
+-------------------------------------*/
+template<typename num_t>
+num_t WorleyNoise<num_t>::get_noise(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept
+{
+    return this->get_features(point, period)[0];
+}
+
+/*-------------------------------------
+    Get the F1 distance of an array of points
+-------------------------------------*/
+template<typename num_t>
+void WorleyNoise<num_t>::get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count) const noexcept
+{
+    switch (metric)
+    {
+        case WORLEY_DIST_MANHATTAN:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outNoise[i] = this->find_features<WORLEY_DIST_MANHATTAN, false>(points[i], vec3_t<int>{256})[0];
+            }
+            break;
+
+        case WORLEY_DIST_CHEBYSHEV:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outNoise[i] = this->find_features<WORLEY_DIST_CHEBYSHEV, false>(points[i], vec3_t<int>{256})[0];
+            }
+            break;
+
+        default:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outNoise[i] = this->find_features<WORLEY_DIST_EUCLIDEAN, false>(points[i], vec3_t<int>{256})[0];
+            }
+    }
+}
+
+/*-------------------------------------
+    Get the periodic F1 distance of an array of points
+-------------------------------------*/
+template<typename num_t>
+void WorleyNoise<num_t>::get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count, const vec3_t<int>& period) const noexcept
+{
+    switch (metric)
+    {
+        case WORLEY_DIST_MANHATTAN:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outNoise[i] = this->find_features<WORLEY_DIST_MANHATTAN, true>(points[i], period)[0];
+            }
+            break;
+
+        case WORLEY_DIST_CHEBYSHEV:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outNoise[i] = this->find_features<WORLEY_DIST_CHEBYSHEV, true>(points[i], period)[0];
+            }
+            break;
+
+        default:
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                outNoise[i] = this->find_features<WORLEY_DIST_EUCLIDEAN, true>(points[i], period)[0];
+            }
+    }
+}
+
+/*-------------------------------------
+    Get the F1 distance over a grid of points
+-------------------------------------*/
+template<typename num_t>
+void WorleyNoise<num_t>::get_noise_grid(
+    num_t* outNoise,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& stride,
+    const vec3_t<unsigned>& dims) const noexcept
+{
+    const std::size_t rowLen = dims[0];
+    vec3_t<num_t> row[64];
+
+    for (unsigned z = 0; z < dims[2]; ++z)
+    {
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            const vec3_t<num_t> rowStart{
+                origin[0],
+                origin[1] + stride[1] * (num_t)y,
+                origin[2] + stride[2] * (num_t)z
+            };
+
+            // Evaluate each row through the batch path in small blocks
+            for (std::size_t x = 0; x < rowLen; x += 64)
+            {
+                const std::size_t count = (rowLen - x) < 64 ? (rowLen - x) : 64;
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    row[i] = vec3_t<num_t>{rowStart[0] + stride[0] * (num_t)(x + i), rowStart[1], rowStart[2]};
+                }
+
+                this->get_noise(row, outNoise, count);
+                outNoise += count;
+            }
+        }
+    }
+}
+
+/*-------------------------------------
+    Get the periodic F1 distance over a grid of points
+-------------------------------------*/
+template<typename num_t>
+void WorleyNoise<num_t>::get_noise_grid(
+    num_t* outNoise,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& stride,
+    const vec3_t<unsigned>& dims,
+    const vec3_t<int>& period) const noexcept
+{
+    const std::size_t rowLen = dims[0];
+    vec3_t<num_t> row[64];
+
+    for (unsigned z = 0; z < dims[2]; ++z)
+    {
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            const vec3_t<num_t> rowStart{
+                origin[0],
+                origin[1] + stride[1] * (num_t)y,
+                origin[2] + stride[2] * (num_t)z
+            };
+
+            for (std::size_t x = 0; x < rowLen; x += 64)
+            {
+                const std::size_t count = (rowLen - x) < 64 ? (rowLen - x) : 64;
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    row[i] = vec3_t<num_t>{rowStart[0] + stride[0] * (num_t)(x + i), rowStart[1], rowStart[2]};
+                }
+
+                this->get_noise(row, outNoise, count, period);
+                outNoise += count;
+            }
+        }
+    }
+}
+
 } // end math namespace
 } // end ls namespace
 
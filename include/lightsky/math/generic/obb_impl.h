@@ -0,0 +1,341 @@
+
+#ifndef LS_MATH_OBB_IMPL_H
+#define LS_MATH_OBB_IMPL_H
+
+#include <limits>
+#include <vector>
+
+#include "lightsky/math/generic/simd_obb_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-------------------------------------
+    Points are processed in chunks. The chunk size is a multiple of every
+    SIMD width so only the final chunk contains a partial register.
+-------------------------------------*/
+constexpr std::size_t obb_chunk_size = 4096;
+
+// Number of parts whose axes are solved together by fit_obb_batch()
+constexpr std::size_t obb_batch_size = 64;
+
+
+
+/*-------------------------------------
+    Combine the moments of two sets of points (Chan et al.)
+-------------------------------------*/
+inline void point_moments_merge(PointMoments& a, const PointMoments& b) noexcept
+{
+    const double n = a.count + b.count;
+    if (n == 0.0)
+    {
+        return;
+    }
+
+    const double dx = b.mean[0] - a.mean[0];
+    const double dy = b.mean[1] - a.mean[1];
+    const double dz = b.mean[2] - a.mean[2];
+    const double wb = b.count / n;
+    const double wab = a.count * wb;
+
+    a.m2[0] += b.m2[0] + dx * dx * wab;
+    a.m2[1] += b.m2[1] + dy * dy * wab;
+    a.m2[2] += b.m2[2] + dz * dz * wab;
+    a.m2[3] += b.m2[3] + dx * dy * wab;
+    a.m2[4] += b.m2[4] + dx * dz * wab;
+    a.m2[5] += b.m2[5] + dy * dz * wab;
+
+    a.mean[0] += dx * wb;
+    a.mean[1] += dy * wb;
+    a.mean[2] += dz * wb;
+    a.count = n;
+}
+
+
+
+/*-------------------------------------
+    Sum the moments of a set of points, one chunk at a time
+-------------------------------------*/
+template <typename num_t, typename kernel_t>
+inline PointMoments point_moments_chunked(const vec3_t<num_t>* points, std::size_t count, const kernel_t& kernel) noexcept
+{
+    PointMoments ret{0.0, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+
+    for (std::size_t first = 0; first < count; first += obb_chunk_size)
+    {
+        const std::size_t n = (count - first < obb_chunk_size) ? (count - first) : obb_chunk_size;
+        PointMoments chunk;
+        kernel(points + first, n, chunk);
+        point_moments_merge(ret, chunk);
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Sum the moments of a set of points using multiple threads
+-------------------------------------*/
+template <typename num_t, typename kernel_t>
+PointMoments point_moments_parallel(
+    const vec3_t<num_t>* points,
+    std::size_t count,
+    unsigned numThreads,
+    const kernel_t& kernel) noexcept
+{
+    const std::size_t numChunks = (count + obb_chunk_size - 1) / obb_chunk_size;
+    if (numChunks <= 1)
+    {
+        return point_moments_chunked(points, count, kernel);
+    }
+
+    std::vector<PointMoments> chunks(numChunks);
+
+    parallel_for(numChunks, numThreads, [&](std::size_t chunkId, unsigned)->void
+    {
+        const std::size_t first = chunkId * obb_chunk_size;
+        const std::size_t n = (count - first < obb_chunk_size) ? (count - first) : obb_chunk_size;
+        kernel(points + first, n, chunks[chunkId]);
+    });
+
+    PointMoments ret = chunks[0];
+    for (std::size_t i = 1; i < numChunks; ++i)
+    {
+        point_moments_merge(ret, chunks[i]);
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Population covariance of a set of moments
+-------------------------------------*/
+template <typename num_t>
+inline mat3_t<num_t> point_moments_covariance(const PointMoments& m) noexcept
+{
+    const double s = (m.count > 0.0) ? (1.0 / m.count) : 0.0;
+    const num_t xx = (num_t)(m.m2[0] * s);
+    const num_t yy = (num_t)(m.m2[1] * s);
+    const num_t zz = (num_t)(m.m2[2] * s);
+    const num_t xy = (num_t)(m.m2[3] * s);
+    const num_t xz = (num_t)(m.m2[4] * s);
+    const num_t yz = (num_t)(m.m2[5] * s);
+
+    return mat3_t<num_t>{
+        xx, xy, xz,
+        xy, yy, yz,
+        xz, yz, zz
+    };
+}
+
+
+
+/*-------------------------------------
+    Build a box from the range of its points along each axis
+-------------------------------------*/
+template <typename num_t>
+inline OrientedBox<num_t> obb_from_extents(
+    const vec3_t<num_t>& origin,
+    const mat3_t<num_t>& axes,
+    const vec3_t<num_t>& lo,
+    const vec3_t<num_t>& hi) noexcept
+{
+    const vec3_t<num_t>&& mid = (lo + hi) * num_t{0.5};
+    return OrientedBox<num_t>{
+        origin + axes * mid,
+        axes,
+        (hi - lo) * num_t{0.5}
+    };
+}
+
+
+
+/*-------------------------------------
+    Calculate the covariance of a set of points
+-------------------------------------*/
+template <typename num_t, typename moments_t>
+void obb_covariance(
+    const vec3_t<num_t>* points,
+    std::size_t count,
+    vec3_t<num_t>& outMean,
+    mat3_t<num_t>& outCovariance,
+    unsigned numThreads,
+    const moments_t& momentsKernel) noexcept
+{
+    const PointMoments&& m = point_moments_parallel(points, count, numThreads, momentsKernel);
+
+    outMean = vec3_t<num_t>{(num_t)m.mean[0], (num_t)m.mean[1], (num_t)m.mean[2]};
+    outCovariance = point_moments_covariance<num_t>(m);
+}
+
+
+
+/*-------------------------------------
+    Fit a box to a single set of points
+-------------------------------------*/
+template <typename num_t, typename moments_t, typename extents_t>
+OrientedBox<num_t> obb_fit(
+    const vec3_t<num_t>* points,
+    std::size_t count,
+    unsigned numThreads,
+    const moments_t& momentsKernel,
+    const extents_t& extentsKernel) noexcept
+{
+    if (!count)
+    {
+        return OrientedBox<num_t>{vec3_t<num_t>{num_t{0}}, mat3_t<num_t>{num_t{1}}, vec3_t<num_t>{num_t{0}}};
+    }
+
+    const PointMoments&& m = point_moments_parallel(points, count, numThreads, momentsKernel);
+
+    // A single matrix is cheap to decompose, so the axes are always solved
+    // in double-precision.
+    vec3_t<double> variances;
+    mat3_t<double> axes;
+    eigen_symmetric(point_moments_covariance<double>(m), variances, axes);
+
+    // Points are projected relative to their mean to preserve precision
+    const vec3_t<num_t> origin{(num_t)m.mean[0], (num_t)m.mean[1], (num_t)m.mean[2]};
+    const mat3_t<num_t>&& boxAxes = (mat3_t<num_t>)axes;
+
+    const std::size_t numChunks = (count + obb_chunk_size - 1) / obb_chunk_size;
+    std::vector<vec3_t<num_t>> lo(numChunks, vec3_t<num_t>{std::numeric_limits<num_t>::max()});
+    std::vector<vec3_t<num_t>> hi(numChunks, vec3_t<num_t>{std::numeric_limits<num_t>::lowest()});
+
+    parallel_for(numChunks, numThreads, [&](std::size_t chunkId, unsigned)->void
+    {
+        const std::size_t first = chunkId * obb_chunk_size;
+        const std::size_t n = (count - first < obb_chunk_size) ? (count - first) : obb_chunk_size;
+        extentsKernel(points + first, n, origin, boxAxes, lo[chunkId], hi[chunkId]);
+    });
+
+    for (std::size_t i = 1; i < numChunks; ++i)
+    {
+        lo[0] = min(lo[0], lo[i]);
+        hi[0] = max(hi[0], hi[i]);
+    }
+
+    return obb_from_extents(origin, boxAxes, lo[0], hi[0]);
+}
+
+
+
+/*-------------------------------------
+    Fit boxes to many sets of points
+-------------------------------------*/
+template <typename num_t, typename moments_t, typename extents_t>
+void obb_fit_batch(
+    const vec3_t<num_t>* points,
+    const std::size_t* partOffsets,
+    std::size_t numParts,
+    OrientedBox<num_t>* outBoxes,
+    unsigned numThreads,
+    const moments_t& momentsKernel,
+    const extents_t& extentsKernel) noexcept
+{
+    const std::size_t numGroups = (numParts + obb_batch_size - 1) / obb_batch_size;
+
+    parallel_for(numGroups, numThreads, [&](std::size_t groupId, unsigned)->void
+    {
+        const std::size_t firstPart = groupId * obb_batch_size;
+        const std::size_t n = (numParts - firstPart < obb_batch_size) ? (numParts - firstPart) : obb_batch_size;
+
+        vec3_t<num_t> origins[obb_batch_size];
+        mat3_t<num_t> covariances[obb_batch_size];
+        vec3_t<num_t> variances[obb_batch_size];
+        mat3_t<num_t> axes[obb_batch_size];
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::size_t first = partOffsets[firstPart + i];
+            const PointMoments&& m = point_moments_chunked(points + first, partOffsets[firstPart + i + 1] - first, momentsKernel);
+
+            origins[i] = vec3_t<num_t>{(num_t)m.mean[0], (num_t)m.mean[1], (num_t)m.mean[2]};
+            covariances[i] = point_moments_covariance<num_t>(m);
+        }
+
+        eigen_symmetric_batch(covariances, variances, axes, n);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::size_t first = partOffsets[firstPart + i];
+            const std::size_t count = partOffsets[firstPart + i + 1] - first;
+
+            if (!count)
+            {
+                outBoxes[firstPart + i] = OrientedBox<num_t>{vec3_t<num_t>{num_t{0}}, mat3_t<num_t>{num_t{1}}, vec3_t<num_t>{num_t{0}}};
+                continue;
+            }
+
+            vec3_t<num_t> lo{std::numeric_limits<num_t>::max()};
+            vec3_t<num_t> hi{std::numeric_limits<num_t>::lowest()};
+            extentsKernel(points + first, count, origins[i], axes[i], lo, hi);
+
+            outBoxes[firstPart + i] = obb_from_extents(origins[i], axes[i], lo, hi);
+        }
+    });
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    covariance
+-------------------------------------*/
+template <typename num_t>
+inline void covariance(
+    const vec3_t<num_t>* points,
+    std::size_t count,
+    vec3_t<num_t>& outMean,
+    mat3_t<num_t>& outCovariance,
+    unsigned numThreads) noexcept
+{
+    impl::obb_covariance(points, count, outMean, outCovariance, numThreads, impl::point_moments<num_t>);
+}
+
+
+
+/*-------------------------------------
+    fit_obb
+-------------------------------------*/
+template <typename num_t>
+inline OrientedBox<num_t> fit_obb(
+    const vec3_t<num_t>* points,
+    std::size_t count,
+    unsigned numThreads) noexcept
+{
+    return impl::obb_fit(points, count, numThreads, impl::point_moments<num_t>, impl::point_extents<num_t>);
+}
+
+
+
+/*-------------------------------------
+    fit_obb_batch
+-------------------------------------*/
+template <typename num_t>
+inline void fit_obb_batch(
+    const vec3_t<num_t>* points,
+    const std::size_t* partOffsets,
+    std::size_t numParts,
+    OrientedBox<num_t>* outBoxes,
+    unsigned numThreads) noexcept
+{
+    impl::obb_fit_batch(points, partOffsets, numParts, outBoxes, numThreads, impl::point_moments<num_t>, impl::point_extents<num_t>);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_OBB_IMPL_H */
@@ -0,0 +1,63 @@
+
+#ifndef LS_MATH_OBBF_IMPL_H
+#define LS_MATH_OBBF_IMPL_H
+
+#include "lightsky/math/generic/simd_obb_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Point Covariance & Oriented Bounding Boxes
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    covariance
+-------------------------------------*/
+inline void covariance(
+    const vec3_t<float>* points,
+    std::size_t count,
+    vec3_t<float>& outMean,
+    mat3_t<float>& outCovariance,
+    unsigned numThreads = 0) noexcept
+{
+    impl::obb_covariance(points, count, outMean, outCovariance, numThreads, impl::simd_point_moments<impl::SimdTraits128>);
+}
+
+
+
+/*-------------------------------------
+    fit_obb
+-------------------------------------*/
+inline OrientedBox<float> fit_obb(
+    const vec3_t<float>* points,
+    std::size_t count,
+    unsigned numThreads = 0) noexcept
+{
+    return impl::obb_fit(points, count, numThreads, impl::simd_point_moments<impl::SimdTraits128>, impl::simd_point_extents<impl::SimdTraits128>);
+}
+
+
+
+/*-------------------------------------
+    fit_obb_batch
+-------------------------------------*/
+inline void fit_obb_batch(
+    const vec3_t<float>* points,
+    const std::size_t* partOffsets,
+    std::size_t numParts,
+    OrientedBox<float>* outBoxes,
+    unsigned numThreads = 0) noexcept
+{
+    impl::obb_fit_batch(points, partOffsets, numParts, outBoxes, numThreads, impl::simd_point_moments<impl::SimdTraits128>, impl::simd_point_extents<impl::SimdTraits128>);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_OBBF_IMPL_H */
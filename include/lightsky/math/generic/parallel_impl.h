@@ -0,0 +1,98 @@
+
+#ifndef LS_MATH_PARALLEL_IMPL_H
+#define LS_MATH_PARALLEL_IMPL_H
+
+#include <atomic>
+#include <new> // std::bad_alloc
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-------------------------------------
+    Determine the number of worker threads
+-------------------------------------*/
+inline unsigned parallel_thread_count(unsigned requestedThreads) noexcept
+{
+    if (requestedThreads)
+    {
+        return requestedThreads;
+    }
+
+    const unsigned hwThreads = std::thread::hardware_concurrency();
+    return hwThreads ? hwThreads : 1u;
+}
+
+
+
+/*-------------------------------------
+    Parallel For-Loop
+-------------------------------------*/
+template <typename func_t>
+void parallel_for(std::size_t numItems, unsigned numThreads, const func_t& func) noexcept
+{
+    numThreads = parallel_thread_count(numThreads);
+    if ((std::size_t)numThreads > numItems)
+    {
+        numThreads = (unsigned)numItems;
+    }
+
+    if (numThreads <= 1)
+    {
+        for (std::size_t i = 0; i < numItems; ++i)
+        {
+            func(i, 0u);
+        }
+        return;
+    }
+
+    std::atomic_size_t nextItem{0};
+
+    auto worker = [&](unsigned threadId)->void
+    {
+        for (std::size_t i = nextItem.fetch_add(1, std::memory_order_relaxed); i < numItems; i = nextItem.fetch_add(1, std::memory_order_relaxed))
+        {
+            func(i, threadId);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    // Items are handed out dynamically, so any work meant for threads which
+    // can't be created is picked up by the threads which already exist.
+    try
+    {
+        threads.reserve(numThreads - 1);
+
+        for (unsigned t = 1; t < numThreads; ++t)
+        {
+            threads.emplace_back(worker, t);
+        }
+    }
+    catch (const std::system_error&)
+    {
+    }
+    catch (const std::bad_alloc&)
+    {
+    }
+
+    worker(0);
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_PARALLEL_IMPL_H */
@@ -124,7 +124,7 @@ math::quat_t<num_t> math::slerp(const quat_t<num_t>& q1, const quat_t<num_t>& q2
     // interpolate between.
     if ((num_t{1} - cosTheta) < num_t{1e-9})
     {
-        return lerp(q1, q2, t);
+        return lerp(q1, q, t);
     }
 
     const num_t&&         theta = std::acos(cosTheta);
@@ -561,6 +561,117 @@ math::quat_t<num_t> math::mat_to_quat(const mat4_t<num_t>& m)
     return q;
 }
 
+/*-------------------------------------
+    Translation, Rotation, & Scale to a 4x4 Matrix
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::mat4_t<num_t> math::compose_trs(const vec3_t<num_t>& t, const quat_t<num_t>& r, const vec3_t<num_t>& s)
+{
+    const num_t x2 = r.q[0] + r.q[0];
+    const num_t y2 = r.q[1] + r.q[1];
+    const num_t z2 = r.q[2] + r.q[2];
+    const num_t xx = r.q[0] * x2;
+    const num_t yy = r.q[1] * y2;
+    const num_t zz = r.q[2] * z2;
+    const num_t xy = r.q[0] * y2;
+    const num_t xz = r.q[0] * z2;
+    const num_t yz = r.q[1] * z2;
+    const num_t wx = r.q[3] * x2;
+    const num_t wy = r.q[3] * y2;
+    const num_t wz = r.q[3] * z2;
+
+    return mat4_t<num_t>{
+        (num_t{1} - (yy + zz)) * s[0], (xy + wz) * s[0],              (xz - wy) * s[0],              num_t{0},
+        (xy - wz) * s[1],              (num_t{1} - (xx + zz)) * s[1], (yz + wx) * s[1],              num_t{0},
+        (xz + wy) * s[2],              (yz - wx) * s[2],              (num_t{1} - (xx + yy)) * s[2], num_t{0},
+        t[0],                          t[1],                          t[2],                          num_t{1}
+    };
+}
+
+/*-------------------------------------
+    4x4 Matrix to Translation, Rotation, & Scale
+-------------------------------------*/
+template <typename num_t> inline
+void math::decompose(const mat4_t<num_t>& m, vec3_t<num_t>& outT, quat_t<num_t>& outR, vec3_t<num_t>& outS)
+{
+    const vec3_t<num_t> c0{m.m[0][0], m.m[0][1], m.m[0][2]};
+    const vec3_t<num_t> c1{m.m[1][0], m.m[1][1], m.m[1][2]};
+    const vec3_t<num_t> c2{m.m[2][0], m.m[2][1], m.m[2][2]};
+
+    // A negative determinant means the matrix contains a reflection, which
+    // is moved into the scale of the X axis.
+    num_t sx = std::sqrt(dot(c0, c0));
+    const num_t sy = std::sqrt(dot(c1, c1));
+    const num_t sz = std::sqrt(dot(c2, c2));
+
+    if (dot(cross(c0, c1), c2) < num_t{0})
+    {
+        sx = -sx;
+    }
+
+    const num_t ix = (sx != num_t{0}) ? (num_t{1} / sx) : num_t{0};
+    const num_t iy = (sy != num_t{0}) ? (num_t{1} / sy) : num_t{0};
+    const num_t iz = (sz != num_t{0}) ? (num_t{1} / sz) : num_t{0};
+
+    vec3_t<num_t> a0 = c0 * ix;
+    vec3_t<num_t> a1 = c1 * iy;
+    vec3_t<num_t> a2 = c2 * iz;
+
+    // An axis with a scale of 0 has no direction, so it's rebuilt from the
+    // other two. Axes are rebuilt in order, so if two or more scales are 0
+    // every degenerate axis remains 0.
+    if (sx == num_t{0})
+    {
+        a0 = cross(a1, a2);
+    }
+
+    if (sy == num_t{0})
+    {
+        a1 = cross(a2, a0);
+    }
+
+    if (sz == num_t{0})
+    {
+        a2 = cross(a0, a1);
+    }
+
+    const num_t r00 = a0[0], r01 = a0[1], r02 = a0[2];
+    const num_t r10 = a1[0], r11 = a1[1], r12 = a1[2];
+    const num_t r20 = a2[0], r21 = a2[1], r22 = a2[2];
+
+    // Each candidate is a multiple of the rotation. The candidate with the
+    // largest trace is the best conditioned.
+    const num_t t0 = num_t{1} + r00 + r11 + r22;
+    const num_t t1 = num_t{1} + r00 - r11 - r22;
+    const num_t t2 = num_t{1} - r00 + r11 - r22;
+    const num_t t3 = num_t{1} - r00 - r11 + r22;
+    const num_t t01 = (t1 > t0) ? t1 : t0;
+    const num_t t23 = (t3 > t2) ? t3 : t2;
+
+    quat_t<num_t> q;
+    if (t23 > t01)
+    {
+        q = (t3 > t2)
+            ? quat_t<num_t>{r20 + r02, r12 + r21, t3, r01 - r10}
+            : quat_t<num_t>{r01 + r10, t2, r12 + r21, r20 - r02};
+    }
+    else
+    {
+        q = (t1 > t0)
+            ? quat_t<num_t>{t1, r01 + r10, r20 + r02, r12 - r21}
+            : quat_t<num_t>{r12 - r21, r20 - r02, r01 - r10, t0};
+    }
+
+    // Normalizing also discards shear. Results are kept in the hemisphere
+    // w >= 0 so identical rotations always decompose identically.
+    const num_t len = std::sqrt(dot(q, q));
+    const num_t invLen = (q.q[3] < num_t{0}) ? (num_t{-1} / len) : (num_t{1} / len);
+
+    outT = vec3_t<num_t>{m.m[3][0], m.m[3][1], m.m[3][2]};
+    outR = quat_t<num_t>{q.q[0] * invLen, q.q[1] * invLen, q.q[2] * invLen, q.q[3] * invLen};
+    outS = vec3_t<num_t>{sx, sy, sz};
+}
+
 
 
 /*-----------------------------------------------------------------------------
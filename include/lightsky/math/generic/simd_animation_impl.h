@@ -0,0 +1,262 @@
+
+#ifndef LS_MATH_SIMD_ANIMATION_IMPL_H
+#define LS_MATH_SIMD_ANIMATION_IMPL_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/animation.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    SIMD Pose Kernels
+
+    These kernels are written against the same "traits" types as the
+    trigonometric kernels in "simd_trig_impl.h", with the addition of
+    load_soa3, store_soa3, load_soa4, and store_soa4. Each lane
+    holds one bone. Bones which don't fill a register are processed by the
+    scalar functions in "animation_impl.h".
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Structure-of-arrays Hamilton product
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_pose_quat_mul(
+    typename traits_t::float_t ax, typename traits_t::float_t ay, typename traits_t::float_t az, typename traits_t::float_t aw,
+    typename traits_t::float_t bx, typename traits_t::float_t by, typename traits_t::float_t bz, typename traits_t::float_t bw,
+    typename traits_t::float_t& x, typename traits_t::float_t& y, typename traits_t::float_t& z, typename traits_t::float_t& w) noexcept
+{
+    typedef traits_t T;
+
+    x = T::sub(T::fmadd(aw, bx, T::fmadd(ax, bw, T::mul(ay, bz))), T::mul(az, by));
+    y = T::sub(T::fmadd(aw, by, T::fmadd(ay, bw, T::mul(az, bx))), T::mul(ax, bz));
+    z = T::sub(T::fmadd(aw, bz, T::fmadd(az, bw, T::mul(ax, by))), T::mul(ay, bx));
+    w = T::sub(T::sub(T::sub(T::mul(aw, bw), T::mul(ax, bx)), T::mul(ay, by)), T::mul(az, bz));
+}
+
+
+
+/*-------------------------------------
+    Normalize quaternions, replacing any of length 0 with the identity
+    rotation.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_pose_normalize(
+    typename traits_t::float_t& x,
+    typename traits_t::float_t& y,
+    typename traits_t::float_t& z,
+    typename traits_t::float_t& w) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t zero = T::set1(0.f);
+    const float_t len = T::sqrt(T::fmadd(w, w, T::fmadd(z, z, T::fmadd(y, y, T::mul(x, x)))));
+    const typename T::mask_t degenerate = T::cmp_eq(len, zero);
+
+    x = T::select(degenerate, zero, T::div(x, len));
+    y = T::select(degenerate, zero, T::div(y, len));
+    z = T::select(degenerate, zero, T::div(z, len));
+    w = T::select(degenerate, T::set1(1.f), T::div(w, len));
+}
+
+
+
+/*-------------------------------------
+    Weighted blend of several poses
+-------------------------------------*/
+template <typename traits_t>
+void simd_blend_poses(
+    const AnimationPose<float>* const* poses,
+    const float* weights,
+    const float* const* boneMasks,
+    unsigned numPoses,
+    AnimationPose<float>& outPose,
+    std::size_t numBones) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    static_assert(T::width == 4, "Pose blending requires 4-wide registers.");
+
+    const float_t zero = T::set1(0.f);
+    const float_t one = T::set1(1.f);
+    std::size_t b = 0;
+
+    for (; b + 4 <= numBones; b += 4)
+    {
+        float_t refX, refY, refZ, refW;
+        T::load_soa4(poses[0]->rotations[b].q, refX, refY, refZ, refW);
+
+        float_t px = zero, py = zero, pz = zero;
+        float_t rx = zero, ry = zero, rz = zero, rw = zero;
+        float_t sx = zero, sy = zero, sz = zero;
+        float_t total = zero;
+
+        for (unsigned p = 0; p < numPoses; ++p)
+        {
+            const AnimationPose<float>& pose = *poses[p];
+            float_t w = T::set1(weights[p]);
+            if (boneMasks && boneMasks[p])
+            {
+                w = T::mul(w, T::load(boneMasks[p] + b));
+            }
+
+            float_t x, y, z, qw;
+            T::load_soa3(pose.positions[b].v, x, y, z);
+            px = T::fmadd(x, w, px);
+            py = T::fmadd(y, w, py);
+            pz = T::fmadd(z, w, pz);
+
+            T::load_soa3(pose.scales[b].v, x, y, z);
+            sx = T::fmadd(x, w, sx);
+            sy = T::fmadd(y, w, sy);
+            sz = T::fmadd(z, w, sz);
+
+            // negate the weight of rotations opposite the first pose
+            T::load_soa4(pose.rotations[b].q, x, y, z, qw);
+            const float_t d = T::fmadd(qw, refW, T::fmadd(z, refZ, T::fmadd(y, refY, T::mul(x, refX))));
+            const float_t wr = T::bit_xor(w, T::sign(d));
+            rx = T::fmadd(x, wr, rx);
+            ry = T::fmadd(y, wr, ry);
+            rz = T::fmadd(z, wr, rz);
+            rw = T::fmadd(qw, wr, rw);
+
+            total = T::add(total, w);
+        }
+
+        const typename T::mask_t unweighted = T::cmp_eq(total, zero);
+        const float_t inv = T::div(one, total);
+        simd_pose_normalize<T>(rx, ry, rz, rw);
+
+        T::store_soa3(outPose.positions[b].v, T::select(unweighted, zero, T::mul(px, inv)), T::select(unweighted, zero, T::mul(py, inv)), T::select(unweighted, zero, T::mul(pz, inv)));
+        T::store_soa3(outPose.scales[b].v, T::select(unweighted, one, T::mul(sx, inv)), T::select(unweighted, one, T::mul(sy, inv)), T::select(unweighted, one, T::mul(sz, inv)));
+        T::store_soa4(
+            outPose.rotations[b].q,
+            T::select(unweighted, zero, rx),
+            T::select(unweighted, zero, ry),
+            T::select(unweighted, zero, rz),
+            T::select(unweighted, one, rw));
+    }
+
+    pose_blend_bones(poses, weights, boneMasks, numPoses, outPose, b, numBones);
+}
+
+
+
+/*-------------------------------------
+    Difference between a pose and a reference pose
+-------------------------------------*/
+template <typename traits_t>
+void simd_make_additive_pose(
+    const AnimationPose<float>& pose,
+    const AnimationPose<float>& reference,
+    AnimationPose<float>& outAdditive,
+    std::size_t numBones) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    static_assert(T::width == 4, "Additive poses require 4-wide registers.");
+
+    std::size_t b = 0;
+
+    for (; b + 4 <= numBones; b += 4)
+    {
+        float_t ax, ay, az, aw;
+        float_t bx, by, bz, bw;
+
+        T::load_soa3(pose.positions[b].v, ax, ay, az);
+        T::load_soa3(reference.positions[b].v, bx, by, bz);
+        T::store_soa3(outAdditive.positions[b].v, T::sub(ax, bx), T::sub(ay, by), T::sub(az, bz));
+
+        T::load_soa3(pose.scales[b].v, ax, ay, az);
+        T::load_soa3(reference.scales[b].v, bx, by, bz);
+        T::store_soa3(outAdditive.scales[b].v, T::div(ax, bx), T::div(ay, by), T::div(az, bz));
+
+        // conjugate(reference) * pose
+        const float_t negate = T::set1(-0.f);
+        T::load_soa4(reference.rotations[b].q, ax, ay, az, aw);
+        T::load_soa4(pose.rotations[b].q, bx, by, bz, bw);
+
+        float_t x, y, z, w;
+        simd_pose_quat_mul<T>(T::bit_xor(ax, negate), T::bit_xor(ay, negate), T::bit_xor(az, negate), aw, bx, by, bz, bw, x, y, z, w);
+        T::store_soa4(outAdditive.rotations[b].q, x, y, z, w);
+    }
+
+    pose_make_additive_bones(pose, reference, outAdditive, b, numBones);
+}
+
+
+
+/*-------------------------------------
+    Weighted application of an additive pose
+-------------------------------------*/
+template <typename traits_t>
+void simd_apply_additive_pose(
+    const AnimationPose<float>& base,
+    const AnimationPose<float>& additive,
+    float weight,
+    const float* boneMask,
+    AnimationPose<float>& outPose,
+    std::size_t numBones) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    static_assert(T::width == 4, "Additive poses require 4-wide registers.");
+
+    const float_t one = T::set1(1.f);
+    std::size_t b = 0;
+
+    for (; b + 4 <= numBones; b += 4)
+    {
+        const float_t w = boneMask ? T::mul(T::set1(weight), T::load(boneMask + b)) : T::set1(weight);
+        float_t ax, ay, az, aw;
+        float_t bx, by, bz, bw;
+
+        T::load_soa3(base.positions[b].v, ax, ay, az);
+        T::load_soa3(additive.positions[b].v, bx, by, bz);
+        const float_t px = T::fmadd(bx, w, ax);
+        const float_t py = T::fmadd(by, w, ay);
+        const float_t pz = T::fmadd(bz, w, az);
+
+        T::load_soa3(base.scales[b].v, ax, ay, az);
+        T::load_soa3(additive.scales[b].v, bx, by, bz);
+        const float_t sx = T::mul(ax, T::fmadd(T::sub(bx, one), w, one));
+        const float_t sy = T::mul(ay, T::fmadd(T::sub(by, one), w, one));
+        const float_t sz = T::mul(az, T::fmadd(T::sub(bz, one), w, one));
+
+        // nlerp from the identity rotation, taking the shortest path
+        T::load_soa4(additive.rotations[b].q, bx, by, bz, bw);
+        const float_t dw = T::bit_xor(w, T::sign(bw));
+        float_t x = T::mul(bx, dw);
+        float_t y = T::mul(by, dw);
+        float_t z = T::mul(bz, dw);
+        float_t qw = T::fmadd(bw, dw, T::sub(one, w));
+        simd_pose_normalize<T>(x, y, z, qw);
+
+        T::load_soa4(base.rotations[b].q, ax, ay, az, aw);
+        simd_pose_quat_mul<T>(ax, ay, az, aw, x, y, z, qw, x, y, z, qw);
+
+        T::store_soa3(outPose.positions[b].v, px, py, pz);
+        T::store_soa3(outPose.scales[b].v, sx, sy, sz);
+        T::store_soa4(outPose.rotations[b].q, x, y, z, qw);
+    }
+
+    pose_apply_additive_bones(base, additive, weight, boneMask, outPose, b, numBones);
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_ANIMATION_IMPL_H */
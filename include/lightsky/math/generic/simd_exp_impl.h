@@ -0,0 +1,228 @@
+
+#ifndef LS_MATH_SIMD_EXP_IMPL_H
+#define LS_MATH_SIMD_EXP_IMPL_H
+
+#include <limits> // std::numeric_limits
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/generic/simd_trig_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Width-Agnostic Exponential & Logarithm Kernels
+
+    Single-precision minimax polynomials from the Cephes math library,
+    evaluated against the same traits types as the trigonometric kernels.
+    All kernels handle zero, infinity, NaN, and subnormal inputs & outputs.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Multiply a number by 2^n. The exponent is applied in two steps so
+    results may become subnormal without n leaving the range of a biased
+    float exponent.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_ldexp(
+    typename traits_t::float_t x,
+    typename traits_t::int_t n) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::int_t int_t;
+
+    const int_t n1 = T::template ishr<1>(n);
+    const int_t n2 = T::isub(n, n1);
+    const int_t bias = T::iset1(127);
+
+    x = T::mul(x, T::as_float(T::template ishl<23>(T::iadd(n1, bias))));
+    return T::mul(x, T::as_float(T::template ishl<23>(T::iadd(n2, bias))));
+}
+
+
+
+/*-------------------------------------
+    exp
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_exp(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    // e^-104 is below the smallest subnormal and e^89 overflows
+    const float_t xc = T::min(T::max(x, T::set1(-104.f)), T::set1(89.f));
+    const float_t fx = simd_floor<traits_t>(T::fmadd(xc, T::set1(1.44269504088896341f), T::set1(0.5f)));
+
+    float_t r = T::fmadd(fx, T::set1(-0.693359375f), xc);
+    r = T::fmadd(fx, T::set1(2.12194440e-4f), r);
+
+    const float_t z = T::mul(r, r);
+
+    float_t p = T::set1(1.9875691500e-4f);
+    p = T::fmadd(p, r, T::set1(1.3981999507e-3f));
+    p = T::fmadd(p, r, T::set1(8.3334519073e-3f));
+    p = T::fmadd(p, r, T::set1(4.1665795894e-2f));
+    p = T::fmadd(p, r, T::set1(1.6666665459e-1f));
+    p = T::fmadd(p, r, T::set1(5.0000001201e-1f));
+    p = T::add(T::fmadd(p, z, r), T::set1(1.f));
+
+    const float_t ret = simd_ldexp<traits_t>(p, T::cvtt(fx));
+    return T::select(T::cmp_unord(x, x), x, ret);
+}
+
+
+
+/*-------------------------------------
+    exp2
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_exp2(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t xc = T::min(T::max(x, T::set1(-151.f)), T::set1(129.f));
+    const float_t i0 = simd_floor<traits_t>(T::add(xc, T::set1(0.5f)));
+    const float_t r  = T::sub(xc, i0);
+
+    float_t p = T::set1(1.535336188319500e-4f);
+    p = T::fmadd(p, r, T::set1(1.339887440266574e-3f));
+    p = T::fmadd(p, r, T::set1(9.618437357674640e-3f));
+    p = T::fmadd(p, r, T::set1(5.550332471162809e-2f));
+    p = T::fmadd(p, r, T::set1(2.402264791363012e-1f));
+    p = T::fmadd(p, r, T::set1(6.931472028550421e-1f));
+    p = T::fmadd(p, r, T::set1(1.f));
+
+    const float_t ret = simd_ldexp<traits_t>(p, T::cvtt(i0));
+    return T::select(T::cmp_unord(x, x), x, ret);
+}
+
+
+
+/*-------------------------------------
+    Split a number into a mantissa "m - 1" within [sqrt(0.5)-1, sqrt(2)-1],
+    and an exponent "e". Returns the polynomial approximation of
+    log(1 + m) - m.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_log_reduce(
+    typename traits_t::float_t x,
+    typename traits_t::float_t& outM,
+    typename traits_t::float_t& outE) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typedef typename traits_t::int_t   int_t;
+    typedef typename traits_t::mask_t  mask_t;
+
+    // scale subnormals into the normal range
+    const mask_t subnormal = T::cmp_lt(x, T::set1(1.17549435e-38f));
+    const float_t xs = T::select(subnormal, T::mul(x, T::set1(33554432.f)), x); // 2^25
+    const int_t xi = T::as_int(xs);
+
+    float_t e = T::cvt(T::isub(T::template ishr<23>(xi), T::iset1(126)));
+    e = T::select(subnormal, T::sub(e, T::set1(25.f)), e);
+
+    float_t m = T::as_float(T::ior(T::iand(xi, T::iset1(0x007FFFFF)), T::iset1(0x3F000000)));
+    const mask_t lt = T::cmp_lt(m, T::set1(0.707106781186547524f));
+    e = T::select(lt, T::sub(e, T::set1(1.f)), e);
+    m = T::sub(T::select(lt, T::add(m, m), m), T::set1(1.f));
+
+    const float_t z = T::mul(m, m);
+
+    float_t p = T::set1(7.0376836292e-2f);
+    p = T::fmadd(p, m, T::set1(-1.1514610310e-1f));
+    p = T::fmadd(p, m, T::set1(1.1676998740e-1f));
+    p = T::fmadd(p, m, T::set1(-1.2420140846e-1f));
+    p = T::fmadd(p, m, T::set1(1.4249322787e-1f));
+    p = T::fmadd(p, m, T::set1(-1.6668057665e-1f));
+    p = T::fmadd(p, m, T::set1(2.0000714765e-1f));
+    p = T::fmadd(p, m, T::set1(-2.4999993993e-1f));
+    p = T::fmadd(p, m, T::set1(3.3333331174e-1f));
+
+    outM = m;
+    outE = e;
+
+    return T::fmadd(z, T::set1(-0.5f), T::mul(T::mul(p, m), z));
+}
+
+
+
+/*-------------------------------------
+    Resolve logarithms of zero, negative numbers, infinity, and NaN
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_log_special(
+    typename traits_t::float_t x,
+    typename traits_t::float_t ret) noexcept
+{
+    typedef traits_t T;
+    const typename traits_t::float_t inf = T::set1(std::numeric_limits<float>::infinity());
+
+    ret = T::select(T::cmp_eq(x, T::set1(0.f)), T::set1(-std::numeric_limits<float>::infinity()), ret);
+    ret = T::select(T::cmp_lt(x, T::set1(0.f)), T::set1(std::numeric_limits<float>::quiet_NaN()), ret);
+    ret = T::select(T::cmp_eq(x, inf), inf, ret);
+
+    return T::select(T::cmp_unord(x, x), x, ret);
+}
+
+
+
+/*-------------------------------------
+    log
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_log(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    float_t m, e;
+    float_t y = simd_log_reduce<traits_t>(x, m, e);
+
+    y = T::fmadd(e, T::set1(-2.12194440e-4f), y);
+    float_t ret = T::add(m, y);
+    ret = T::fmadd(e, T::set1(0.693359375f), ret);
+
+    return simd_log_special<traits_t>(x, ret);
+}
+
+
+
+/*-------------------------------------
+    log2
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_log2(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    float_t m, e;
+    const float_t y = simd_log_reduce<traits_t>(x, m, e);
+
+    // log2(e) - 1, keeping the leading term exact
+    const float_t log2ea = T::set1(0.44269504088896340736f);
+    float_t ret = T::mul(y, log2ea);
+    ret = T::fmadd(m, log2ea, ret);
+    ret = T::add(ret, y);
+    ret = T::add(ret, m);
+    ret = T::add(ret, e);
+
+    return simd_log_special<traits_t>(x, ret);
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_EXP_IMPL_H */
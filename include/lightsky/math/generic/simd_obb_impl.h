@@ -0,0 +1,309 @@
+
+#ifndef LS_MATH_SIMD_OBB_IMPL_H
+#define LS_MATH_SIMD_OBB_IMPL_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/mat3.h"
+#include "lightsky/math/vec3.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Point Cloud Kernels
+
+    Each kernel processes one chunk of points. Moments are summed relative
+    to the first point of a chunk, rather than the origin, so coordinates
+    far from the origin don't cancel each other out when the sums are
+    converted to a covariance. Chunks are later combined in double-precision.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    The mean & sum of squared deviations of a set of points. Squared
+    deviations are stored in the order xx, yy, zz, xy, xz, yz.
+-------------------------------------*/
+struct PointMoments
+{
+    double count;
+    double mean[3];
+    double m2[6];
+};
+
+
+
+/*-------------------------------------
+    Convert sums of offsets from a reference point into moments
+-------------------------------------*/
+inline void point_moments_finish(
+    const double (&ref)[3],
+    const double (&s)[3],
+    const double (&ss)[6],
+    std::size_t n,
+    PointMoments& out) noexcept
+{
+    const double invN = 1.0 / (double)n;
+
+    out.count = (double)n;
+    out.mean[0] = ref[0] + s[0] * invN;
+    out.mean[1] = ref[1] + s[1] * invN;
+    out.mean[2] = ref[2] + s[2] * invN;
+
+    out.m2[0] = ss[0] - s[0] * s[0] * invN;
+    out.m2[1] = ss[1] - s[1] * s[1] * invN;
+    out.m2[2] = ss[2] - s[2] * s[2] * invN;
+    out.m2[3] = ss[3] - s[0] * s[1] * invN;
+    out.m2[4] = ss[4] - s[0] * s[2] * invN;
+    out.m2[5] = ss[5] - s[1] * s[2] * invN;
+}
+
+
+
+/*-------------------------------------
+    Moments of a chunk of points, at any precision
+-------------------------------------*/
+template <typename num_t>
+void point_moments(const vec3_t<num_t>* p, std::size_t n, PointMoments& out) noexcept
+{
+    const vec3_t<num_t> k = p[0];
+    num_t s[3] = {num_t{0}, num_t{0}, num_t{0}};
+    num_t ss[6] = {num_t{0}, num_t{0}, num_t{0}, num_t{0}, num_t{0}, num_t{0}};
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const num_t x = p[i][0] - k[0];
+        const num_t y = p[i][1] - k[1];
+        const num_t z = p[i][2] - k[2];
+
+        s[0] += x;
+        s[1] += y;
+        s[2] += z;
+        ss[0] += x * x;
+        ss[1] += y * y;
+        ss[2] += z * z;
+        ss[3] += x * y;
+        ss[4] += x * z;
+        ss[5] += y * z;
+    }
+
+    const double ref[3] = {(double)k[0], (double)k[1], (double)k[2]};
+    const double ds[3] = {(double)s[0], (double)s[1], (double)s[2]};
+    const double dss[6] = {(double)ss[0], (double)ss[1], (double)ss[2], (double)ss[3], (double)ss[4], (double)ss[5]};
+    point_moments_finish(ref, ds, dss, n, out);
+}
+
+
+
+/*-------------------------------------
+    Range of a chunk of points along three axes, relative to an origin, at
+    any precision. Results are merged into ioMin & ioMax.
+-------------------------------------*/
+template <typename num_t>
+void point_extents(
+    const vec3_t<num_t>* p,
+    std::size_t n,
+    const vec3_t<num_t>& origin,
+    const mat3_t<num_t>& axes,
+    vec3_t<num_t>& ioMin,
+    vec3_t<num_t>& ioMax) noexcept
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const vec3_t<num_t>&& d = p[i] - origin;
+
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            const num_t t = axes[c][0] * d[0] + axes[c][1] * d[1] + axes[c][2] * d[2];
+            ioMin[c] = (t < ioMin[c]) ? t : ioMin[c];
+            ioMax[c] = (t > ioMax[c]) ? t : ioMax[c];
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Moments of a chunk of points using SIMD registers.
+
+    Each lane sums an interleaved subset of the chunk into nine independent
+    accumulators, which is enough to hide the latency of each FMA. Partial
+    registers are padded with the reference point, which adds nothing to the
+    sums.
+-------------------------------------*/
+template <typename traits_t>
+void simd_point_moments(const vec3_t<float>* p, std::size_t n, PointMoments& out) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const vec3_t<float> k = p[0];
+    const float_t kx = T::set1(k[0]);
+    const float_t ky = T::set1(k[1]);
+    const float_t kz = T::set1(k[2]);
+
+    float_t sx, sy, sz, sxx, syy, szz, sxy, sxz, syz;
+    sx = sy = sz = sxx = syy = szz = sxy = sxz = syz = T::set1(0.f);
+
+    const auto accumulate = [&](const float* pts)->void
+    {
+        float_t x, y, z;
+        T::load_soa3(pts, x, y, z);
+        x = T::sub(x, kx);
+        y = T::sub(y, ky);
+        z = T::sub(z, kz);
+
+        sx = T::add(sx, x);
+        sy = T::add(sy, y);
+        sz = T::add(sz, z);
+        sxx = T::fmadd(x, x, sxx);
+        syy = T::fmadd(y, y, syy);
+        szz = T::fmadd(z, z, szz);
+        sxy = T::fmadd(x, y, sxy);
+        sxz = T::fmadd(x, z, sxz);
+        syz = T::fmadd(y, z, syz);
+    };
+
+    std::size_t i = 0;
+    for (; i + T::width <= n; i += T::width)
+    {
+        accumulate(p[i].v);
+    }
+
+    if (i < n)
+    {
+        vec3_t<float> tail[T::width];
+        for (unsigned j = 0; j < T::width; ++j)
+        {
+            tail[j] = (i + j < n) ? p[i + j] : k;
+        }
+        accumulate(tail[0].v);
+    }
+
+    const float_t* const sums[9] = {&sx, &sy, &sz, &sxx, &syy, &szz, &sxy, &sxz, &syz};
+    double totals[9];
+
+    for (unsigned s = 0; s < 9; ++s)
+    {
+        float lanes[T::width];
+        T::store(lanes, *sums[s]);
+
+        totals[s] = 0.0;
+        for (unsigned j = 0; j < T::width; ++j)
+        {
+            totals[s] += (double)lanes[j];
+        }
+    }
+
+    const double ref[3] = {(double)k[0], (double)k[1], (double)k[2]};
+    const double ds[3] = {totals[0], totals[1], totals[2]};
+    const double dss[6] = {totals[3], totals[4], totals[5], totals[6], totals[7], totals[8]};
+    point_moments_finish(ref, ds, dss, n, out);
+}
+
+
+
+/*-------------------------------------
+    Range of a chunk of points along three axes using SIMD registers.
+    Partial registers are padded with the last point, which can't change
+    the results.
+-------------------------------------*/
+template <typename traits_t>
+void simd_point_extents(
+    const vec3_t<float>* p,
+    std::size_t n,
+    const vec3_t<float>& origin,
+    const mat3_t<float>& axes,
+    vec3_t<float>& ioMin,
+    vec3_t<float>& ioMax) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t ox = T::set1(origin[0]);
+    const float_t oy = T::set1(origin[1]);
+    const float_t oz = T::set1(origin[2]);
+    const float_t a0x = T::set1(axes[0][0]);
+    const float_t a0y = T::set1(axes[0][1]);
+    const float_t a0z = T::set1(axes[0][2]);
+    const float_t a1x = T::set1(axes[1][0]);
+    const float_t a1y = T::set1(axes[1][1]);
+    const float_t a1z = T::set1(axes[1][2]);
+    const float_t a2x = T::set1(axes[2][0]);
+    const float_t a2y = T::set1(axes[2][1]);
+    const float_t a2z = T::set1(axes[2][2]);
+
+    // Each axis is kept in its own registers. Indexing arrays of registers
+    // in a loop forces them onto the stack.
+    float_t lo0 = T::set1(ioMin[0]);
+    float_t lo1 = T::set1(ioMin[1]);
+    float_t lo2 = T::set1(ioMin[2]);
+    float_t hi0 = T::set1(ioMax[0]);
+    float_t hi1 = T::set1(ioMax[1]);
+    float_t hi2 = T::set1(ioMax[2]);
+
+    const auto project = [&](const float* pts)->void
+    {
+        float_t x, y, z;
+        T::load_soa3(pts, x, y, z);
+        x = T::sub(x, ox);
+        y = T::sub(y, oy);
+        z = T::sub(z, oz);
+
+        const float_t t0 = T::fmadd(a0z, z, T::fmadd(a0y, y, T::mul(a0x, x)));
+        const float_t t1 = T::fmadd(a1z, z, T::fmadd(a1y, y, T::mul(a1x, x)));
+        const float_t t2 = T::fmadd(a2z, z, T::fmadd(a2y, y, T::mul(a2x, x)));
+        lo0 = T::min(lo0, t0);
+        lo1 = T::min(lo1, t1);
+        lo2 = T::min(lo2, t2);
+        hi0 = T::max(hi0, t0);
+        hi1 = T::max(hi1, t1);
+        hi2 = T::max(hi2, t2);
+    };
+
+    std::size_t i = 0;
+    for (; i + T::width <= n; i += T::width)
+    {
+        project(p[i].v);
+    }
+
+    if (i < n)
+    {
+        vec3_t<float> tail[T::width];
+        for (unsigned j = 0; j < T::width; ++j)
+        {
+            tail[j] = p[(i + j < n) ? (i + j) : (n - 1)];
+        }
+        project(tail[0].v);
+    }
+
+    const float_t lo[3] = {lo0, lo1, lo2};
+    const float_t hi[3] = {hi0, hi1, hi2};
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        float lanesLo[T::width], lanesHi[T::width];
+        T::store(lanesLo, lo[c]);
+        T::store(lanesHi, hi[c]);
+
+        for (unsigned j = 0; j < T::width; ++j)
+        {
+            ioMin[c] = (lanesLo[j] < ioMin[c]) ? lanesLo[j] : ioMin[c];
+            ioMax[c] = (lanesHi[j] > ioMax[c]) ? lanesHi[j] : ioMax[c];
+        }
+    }
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_OBB_IMPL_H */
@@ -0,0 +1,307 @@
+
+#ifndef LS_MATH_SIMD_SKINNING_IMPL_H
+#define LS_MATH_SIMD_SKINNING_IMPL_H
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+#include "lightsky/setup/Arch.h"
+
+#include "lightsky/math/dualquat.h"
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/vec3.h"
+#include "lightsky/math/vec4.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    SIMD Skinning Kernels
+
+    These kernels are written against the same "traits" types as the
+    trigonometric kernels in "simd_trig_impl.h". Bones are fetched by index,
+    so the dual quaternion kernel gathers one bone per lane while the matrix
+    kernel loads one bone column at a time.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Bone Weight Conversion
+
+    Floating-point and half-float weights are converted directly. Integer
+    weights are treated as unsigned-normalized values.
+-------------------------------------*/
+template <typename weight_t>
+struct SkinWeight
+{
+    template <typename num_t>
+    static inline LS_INLINE num_t convert(const weight_t& w) noexcept { return (num_t)w; }
+};
+
+template <>
+struct SkinWeight<uint8_t>
+{
+    template <typename num_t>
+    static inline LS_INLINE num_t convert(uint8_t w) noexcept { return (num_t)w * (num_t{1} / num_t{255}); }
+};
+
+template <>
+struct SkinWeight<uint16_t>
+{
+    template <typename num_t>
+    static inline LS_INLINE num_t convert(uint16_t w) noexcept { return (num_t)w * (num_t{1} / num_t{65535}); }
+};
+
+
+
+/*-------------------------------------
+    Dual Quaternion Linear Blending
+
+    The dual quaternion kernel skins one vertex per SIMD lane. Each bone is
+    loaded as a row and transposed in registers, one 128-bit lane at a time,
+    so every lane holds one vertex. Lanes past the end of an array use an
+    identity transform and are never written back, which lets the final
+    partial group use the same code path.
+-------------------------------------*/
+template <typename traits_t, typename index_t>
+inline void simd_dualquat_skin(
+    const dualquat_t<float>* palette,
+    const vec3_t<float>* positions,
+    const vec3_t<float>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<float>* weights,
+    vec3_t<float>* outPositions,
+    vec3_t<float>* outNormals,
+    std::size_t count) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    constexpr unsigned width = T::width;
+
+    const dualquat_t<float> identity{quat_t<float>{0.f, 0.f, 0.f, 1.f}, quat_t<float>{0.f, 0.f, 0.f, 0.f}};
+    const vec4_t<float> identityWeight{1.f, 0.f, 0.f, 0.f};
+
+    alignas(64) float p[3][width] = {{0.f}};
+    alignas(64) float n[3][width] = {{0.f}};
+
+    for (std::size_t i = 0; i < count; i += width)
+    {
+        const unsigned numLanes = (count - i < width) ? (unsigned)(count - i) : width;
+        const float* real[4][width];
+        const float* dual[4][width];
+        const float* wp[width];
+
+        for (unsigned j = 0; j < width; ++j)
+        {
+            if (j < numLanes)
+            {
+                const vec4_t<index_t>& ids = boneIds[i+j];
+                for (unsigned k = 0; k < 4; ++k)
+                {
+                    real[k][j] = palette[ids[k]].real.q;
+                    dual[k][j] = palette[ids[k]].dual.q;
+                }
+
+                wp[j] = weights[i+j].v;
+
+                for (unsigned c = 0; c < 3; ++c)
+                {
+                    p[c][j] = positions[i+j].v[c];
+                    n[c][j] = normals ? normals[i+j].v[c] : 0.f;
+                }
+            }
+            else
+            {
+                for (unsigned k = 0; k < 4; ++k)
+                {
+                    real[k][j] = identity.real.q;
+                    dual[k][j] = identity.dual.q;
+                }
+
+                wp[j] = identityWeight.v;
+            }
+        }
+
+        float_t w[4];
+        T::gather_soa4(wp, w[0], w[1], w[2], w[3]);
+
+        // b[0-3] holds the real part of the k-th bone of each lane and b[4-7]
+        // holds the dual part.
+        const auto load_bone = [&](unsigned k, float_t (&b)[8]) noexcept
+        {
+            T::gather_soa4(real[k], b[0], b[1], b[2], b[3]);
+            T::gather_soa4(dual[k], b[4], b[5], b[6], b[7]);
+        };
+
+        // Blend each bone into the first, flipping the sign of any bone
+        // whose rotation lies in the opposite hemisphere.
+        float_t pivot[8];
+        float_t blended[8];
+        load_bone(0, pivot);
+
+        for (unsigned c = 0; c < 8; ++c)
+        {
+            blended[c] = T::mul(w[0], pivot[c]);
+        }
+
+        for (unsigned k = 1; k < 4; ++k)
+        {
+            float_t b[8];
+            load_bone(k, b);
+
+            float_t d = T::mul(pivot[0], b[0]);
+            d = T::fmadd(pivot[1], b[1], d);
+            d = T::fmadd(pivot[2], b[2], d);
+            d = T::fmadd(pivot[3], b[3], d);
+
+            const float_t wk = T::bit_xor(w[k], T::sign(d));
+            for (unsigned c = 0; c < 8; ++c)
+            {
+                blended[c] = T::fmadd(wk, b[c], blended[c]);
+            }
+        }
+
+        // Normalize by the length of the real part
+        float_t len2 = T::mul(blended[0], blended[0]);
+        len2 = T::fmadd(blended[1], blended[1], len2);
+        len2 = T::fmadd(blended[2], blended[2], len2);
+        len2 = T::fmadd(blended[3], blended[3], len2);
+
+        const float_t magInv = T::div(T::set1(1.f), T::sqrt(len2));
+        for (unsigned c = 0; c < 8; ++c)
+        {
+            blended[c] = T::mul(blended[c], magInv);
+        }
+
+        const float_t rx = blended[0];
+        const float_t ry = blended[1];
+        const float_t rz = blended[2];
+        const float_t rw = blended[3];
+        const float_t dx = blended[4];
+        const float_t dy = blended[5];
+        const float_t dz = blended[6];
+        const float_t dw = blended[7];
+        const float_t two = T::set1(2.f);
+
+        // t = 2 * (rw*dv - dw*rv + cross(rv, dv))
+        const float_t tx = T::mul(two, T::add(T::sub(T::mul(rw, dx), T::mul(dw, rx)), T::sub(T::mul(ry, dz), T::mul(rz, dy))));
+        const float_t ty = T::mul(two, T::add(T::sub(T::mul(rw, dy), T::mul(dw, ry)), T::sub(T::mul(rz, dx), T::mul(rx, dz))));
+        const float_t tz = T::mul(two, T::add(T::sub(T::mul(rw, dz), T::mul(dw, rz)), T::sub(T::mul(rx, dy), T::mul(ry, dx))));
+
+        // v' = v + 2 * cross(rv, cross(rv, v) + rw*v)
+        const auto rotate = [&](float (&v)[3][width], const float_t& ox, const float_t& oy, const float_t& oz) noexcept
+        {
+            const float_t vx = T::load(v[0]);
+            const float_t vy = T::load(v[1]);
+            const float_t vz = T::load(v[2]);
+
+            const float_t cx = T::fmadd(rw, vx, T::sub(T::mul(ry, vz), T::mul(rz, vy)));
+            const float_t cy = T::fmadd(rw, vy, T::sub(T::mul(rz, vx), T::mul(rx, vz)));
+            const float_t cz = T::fmadd(rw, vz, T::sub(T::mul(rx, vy), T::mul(ry, vx)));
+
+            T::store(v[0], T::fmadd(two, T::sub(T::mul(ry, cz), T::mul(rz, cy)), T::add(vx, ox)));
+            T::store(v[1], T::fmadd(two, T::sub(T::mul(rz, cx), T::mul(rx, cz)), T::add(vy, oy)));
+            T::store(v[2], T::fmadd(two, T::sub(T::mul(rx, cy), T::mul(ry, cx)), T::add(vz, oz)));
+        };
+
+        rotate(p, tx, ty, tz);
+
+        if (normals)
+        {
+            const float_t zero = T::set1(0.f);
+            rotate(n, zero, zero, zero);
+        }
+
+        for (unsigned j = 0; j < numLanes; ++j)
+        {
+            outPositions[i+j] = vec3_t<float>{p[0][j], p[1][j], p[2][j]};
+
+            if (normals)
+            {
+                outNormals[i+j] = vec3_t<float>{n[0][j], n[1][j], n[2][j]};
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Matrix Linear Blending
+
+    Bone matrices are gathered one column at a time, so this kernel skins a
+    single vertex per iteration using 4-wide registers rather than one vertex
+    per lane.
+-------------------------------------*/
+template <typename traits_t, typename index_t, typename weight_t>
+inline void simd_matrix_skin(
+    const mat4_t<float>* palette,
+    const vec3_t<float>* positions,
+    const vec3_t<float>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<weight_t>* weights,
+    vec3_t<float>* outPositions,
+    vec3_t<float>* outNormals,
+    std::size_t count) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    static_assert(T::width == 4, "Matrix skinning requires 4-wide registers.");
+
+    alignas(16) float temp[4];
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const vec4_t<index_t>& ids = boneIds[i];
+        const vec4_t<weight_t>& w = weights[i];
+        const float* const m0 = palette[ids[0]].m[0].v;
+        const float* const m1 = palette[ids[1]].m[0].v;
+        const float* const m2 = palette[ids[2]].m[0].v;
+        const float* const m3 = palette[ids[3]].m[0].v;
+        const float_t w0 = T::set1(SkinWeight<weight_t>::template convert<float>(w[0]));
+        const float_t w1 = T::set1(SkinWeight<weight_t>::template convert<float>(w[1]));
+        const float_t w2 = T::set1(SkinWeight<weight_t>::template convert<float>(w[2]));
+        const float_t w3 = T::set1(SkinWeight<weight_t>::template convert<float>(w[3]));
+
+        float_t col[4];
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            col[c] = T::mul(w0, T::load(m0 + c*4));
+            col[c] = T::fmadd(w1, T::load(m1 + c*4), col[c]);
+            col[c] = T::fmadd(w2, T::load(m2 + c*4), col[c]);
+            col[c] = T::fmadd(w3, T::load(m3 + c*4), col[c]);
+        }
+
+        if (normals)
+        {
+            const vec3_t<float>& n = normals[i];
+            float_t r = T::mul(col[0], T::set1(n.v[0]));
+            r = T::fmadd(col[1], T::set1(n.v[1]), r);
+            r = T::fmadd(col[2], T::set1(n.v[2]), r);
+
+            T::store(temp, r);
+            outNormals[i] = vec3_t<float>{temp[0], temp[1], temp[2]};
+        }
+
+        const vec3_t<float>& p = positions[i];
+        float_t r = T::fmadd(col[0], T::set1(p.v[0]), col[3]);
+        r = T::fmadd(col[1], T::set1(p.v[1]), r);
+        r = T::fmadd(col[2], T::set1(p.v[2]), r);
+
+        T::store(temp, r);
+        outPositions[i] = vec3_t<float>{temp[0], temp[1], temp[2]};
+    }
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_SKINNING_IMPL_H */
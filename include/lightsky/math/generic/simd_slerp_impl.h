@@ -0,0 +1,235 @@
+
+#ifndef LS_MATH_SIMD_SLERP_IMPL_H
+#define LS_MATH_SIMD_SLERP_IMPL_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+#include "lightsky/setup/Arch.h"
+
+#include "lightsky/math/generic/simd_trig_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    SIMD Quaternion Interpolation Kernels
+
+    These kernels are written against the same "traits" types as the
+    trigonometric kernels in "simd_trig_impl.h", with the addition of
+    load_soa4 & store_soa4. Each lane interpolates one pair of quaternions.
+
+    The weight kernels receive the absolute value of the dot product between
+    two quaternions, along with the interpolation percentage, and return the
+    weights applied to each input quaternion. The sign of the dot product is
+    then applied to the second weight so interpolation always follows the
+    shortest path.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Spherical interpolation weights: sin((1-t)*theta) / sin(theta) and
+    sin(t*theta) / sin(theta), where theta = acos(d). Nearly-parallel
+    quaternions use linear weights to avoid dividing by zero.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_slerp_weights(
+    typename traits_t::float_t d,
+    typename traits_t::float_t t,
+    typename traits_t::float_t& w0,
+    typename traits_t::float_t& w1) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t one      = T::set1(1.f);
+    const float_t s        = T::sub(one, t);
+    const float_t cosTheta = T::min(d, one);
+    const float_t theta    = simd_acos<T>(cosTheta);
+
+    // (1-d)*(1+d) is exact for d >= 0.5, unlike 1-d*d
+    const float_t sinTheta = T::sqrt(T::mul(T::sub(one, cosTheta), T::add(one, cosTheta)));
+    const float_t sin0     = simd_sin<T>(T::mul(s, theta));
+    const float_t sin1     = simd_sin<T>(T::mul(t, theta));
+
+    const typename T::mask_t linear = T::cmp_gt(d, T::set1(1.f - 1.e-6f));
+    w0 = T::select(linear, s, T::div(sin0, sinTheta));
+    w1 = T::select(linear, t, T::div(sin1, sinTheta));
+}
+
+
+
+/*-------------------------------------
+    Polynomial approximation of the spherical interpolation weights, from
+    David Eberly's "A Fast and Accurate Algorithm for Computing SLERP"
+    (Journal of Graphics, GPU, and Game Tools, 2011).
+
+    sin(t*theta) / sin(theta) is expanded as a series in (cos(theta) - 1)
+    and truncated after 8 terms, with the last term scaled to minimize the
+    maximum error. The weights are within 2e-5 of the exact values for any
+    pair of quaternions, and within 1e-6 when d >= 0.5.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_fast_slerp_weights(
+    typename traits_t::float_t d,
+    typename traits_t::float_t t,
+    typename traits_t::float_t& w0,
+    typename traits_t::float_t& w1) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    // u[i] = 1 / (i*(2i+1)), v[i] = i / (2i+1), for i in [1, 8]
+    constexpr float mu = 1.85298109240830f;
+    constexpr float u[8] = {
+        1.f / (1.f*3.f),
+        1.f / (2.f*5.f),
+        1.f / (3.f*7.f),
+        1.f / (4.f*9.f),
+        1.f / (5.f*11.f),
+        1.f / (6.f*13.f),
+        1.f / (7.f*15.f),
+        mu  / (8.f*17.f)
+    };
+    constexpr float v[8] = {
+        1.f / 3.f,
+        2.f / 5.f,
+        3.f / 7.f,
+        4.f / 9.f,
+        5.f / 11.f,
+        6.f / 13.f,
+        7.f / 15.f,
+        mu * 8.f / 17.f
+    };
+
+    const float_t one = T::set1(1.f);
+    const float_t xm1 = T::sub(T::min(d, one), one);
+    const float_t s   = T::sub(one, t);
+    const float_t s2  = T::mul(s, s);
+    const float_t t2  = T::mul(t, t);
+
+    float_t c0 = one;
+    float_t c1 = one;
+
+    for (int i = 7; i >= 0; --i)
+    {
+        const float_t vi = T::set1(v[i]);
+        const float_t ui = T::set1(u[i]);
+        c0 = T::fmadd(T::mul(T::sub(T::mul(ui, s2), vi), xm1), c0, one);
+        c1 = T::fmadd(T::mul(T::sub(T::mul(ui, t2), vi), xm1), c1, one);
+    }
+
+    w0 = T::mul(s, c0);
+    w1 = T::mul(t, c1);
+}
+
+
+
+/*-------------------------------------
+    Linear interpolation weights, used for normalized lerp.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_lerp_weights(
+    typename traits_t::float_t,
+    typename traits_t::float_t t,
+    typename traits_t::float_t& w0,
+    typename traits_t::float_t& w1) noexcept
+{
+    w0 = traits_t::sub(traits_t::set1(1.f), t);
+    w1 = t;
+}
+
+
+
+/*-------------------------------------
+    Interpolate two arrays of quaternions using a weight kernel. Quaternions
+    at the end of an array which don't fill a register are copied to a
+    temporary buffer, padded with identity quaternions.
+-------------------------------------*/
+template <typename traits_t, bool normalize, typename kernel_t>
+inline void simd_quat_interpolate(
+    const float* a,
+    const float* b,
+    const float* t,
+    float* out,
+    std::size_t count,
+    kernel_t&& kernel) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    constexpr std::size_t width = T::width;
+
+    const auto interpolate = [&](const float* pA, const float* pB, const float* pT, float* pOut) noexcept
+    {
+        float_t ax, ay, az, aw;
+        float_t bx, by, bz, bw;
+        T::load_soa4(pA, ax, ay, az, aw);
+        T::load_soa4(pB, bx, by, bz, bw);
+
+        const float_t d = T::fmadd(aw, bw, T::fmadd(az, bz, T::fmadd(ay, by, T::mul(ax, bx))));
+
+        float_t w0, w1;
+        kernel(T::abs(d), T::load(pT), w0, w1);
+        w1 = T::bit_xor(w1, T::sign(d));
+
+        float_t x = T::fmadd(bx, w1, T::mul(ax, w0));
+        float_t y = T::fmadd(by, w1, T::mul(ay, w0));
+        float_t z = T::fmadd(bz, w1, T::mul(az, w0));
+        float_t w = T::fmadd(bw, w1, T::mul(aw, w0));
+
+        if (normalize)
+        {
+            const float_t len = T::sqrt(T::fmadd(w, w, T::fmadd(z, z, T::fmadd(y, y, T::mul(x, x)))));
+            x = T::div(x, len);
+            y = T::div(y, len);
+            z = T::div(z, len);
+            w = T::div(w, len);
+        }
+
+        T::store_soa4(pOut, x, y, z, w);
+    };
+
+    std::size_t i = 0;
+
+    for (; i + width <= count; i += width)
+    {
+        interpolate(a+i*4, b+i*4, t+i, out+i*4);
+    }
+
+    if (i < count)
+    {
+        const std::size_t n = count - i;
+        float tempA[width*4];
+        float tempB[width*4];
+        float tempT[width];
+
+        for (std::size_t j = 0; j < width; ++j)
+        {
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                tempA[j*4+k] = (j < n) ? a[(i+j)*4+k] : (k == 3 ? 1.f : 0.f);
+                tempB[j*4+k] = (j < n) ? b[(i+j)*4+k] : (k == 3 ? 1.f : 0.f);
+            }
+            tempT[j] = (j < n) ? t[i+j] : 0.f;
+        }
+
+        interpolate(tempA, tempB, tempT, tempA);
+
+        for (std::size_t j = 0; j < n*4; ++j)
+        {
+            out[i*4+j] = tempA[j];
+        }
+    }
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_SLERP_IMPL_H */
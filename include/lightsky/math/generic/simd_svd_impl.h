@@ -0,0 +1,672 @@
+
+#ifndef LS_MATH_SIMD_SVD_IMPL_H
+#define LS_MATH_SIMD_SVD_IMPL_H
+
+#include <cstddef> // std::size_t
+#include <limits>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/mat3.h"
+#include "lightsky/math/vec3.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    3x3 Singular Value Decomposition Kernels
+
+    An implementation of "Computing the Singular Value Decomposition of 3x3
+    matrices with minimal branching and elementary floating point operations"
+    by McAdams, Selle, Tamstorf, Teran, & Sifakis. The eigenvectors of A^T*A
+    are found using Jacobi iteration with approximate Givens rotations,
+    accumulated into a quaternion. The columns of A*V are then sorted by
+    length and a QR factorization of the result produces U & the singular
+    values. Symmetric matrices are diagonalized by the same Jacobi iteration
+    without forming A^T*A. Every decision is made using selects, so each lane
+    of a register may hold a different matrix.
+
+    These kernels only require the arithmetic, comparison, and select
+    functions of the "traits" types in "simd_trig_impl.h", so they may also
+    be evaluated on scalars of any precision. Matrices are indexed by
+    [column][row], matching mat3_t.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Jacobi rotation which removes the (p, q) element of a symmetric matrix.
+    Rotations are about the axis "k", where (p, q, k) is a cyclic
+    permutation of (0, 1, 2).
+
+    Elements smaller than "tiny" are replaced with 0, which turns the
+    rotation into an exact identity. Otherwise, squaring the remaining
+    elements of a converged matrix produces denormals, which are extremely
+    slow on most hardware.
+-------------------------------------*/
+template <typename traits_t, unsigned p, unsigned q, unsigned k>
+inline LS_INLINE void simd_svd_jacobi(
+    typename traits_t::float_t (&s)[3][3],
+    typename traits_t::float_t (&v)[4],
+    typename traits_t::float_t gamma,
+    typename traits_t::float_t cstar,
+    typename traits_t::float_t sstar,
+    typename traits_t::float_t tiny) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t zero = T::set1(0.f);
+    const float_t two = T::set1(2.f);
+    const float_t spp = s[p][p];
+    const float_t sqq = s[q][q];
+    const float_t spq = T::select(T::cmp_lt(T::abs(s[p][q]), tiny), zero, s[p][q]);
+    const float_t spk = s[p][k];
+    const float_t sqk = s[q][k];
+
+    // Approximate half-angle of the rotation. Angles too large to be
+    // approximated are clamped to pi/8.
+    float_t ch = T::mul(two, T::sub(spp, sqq));
+    float_t sh = spq;
+    const typename T::mask_t approx = T::cmp_lt(T::mul(gamma, T::mul(sh, sh)), T::mul(ch, ch));
+    const float_t w = T::div(T::set1(1.f), T::sqrt(T::fmadd(ch, ch, T::mul(sh, sh))));
+    ch = T::select(approx, T::mul(w, ch), cstar);
+    sh = T::select(approx, T::mul(w, sh), sstar);
+
+    const float_t c = T::sub(T::mul(ch, ch), T::mul(sh, sh));
+    const float_t sn = T::mul(two, T::mul(ch, sh));
+    const float_t cc = T::mul(c, c);
+    const float_t ss = T::mul(sn, sn);
+    const float_t cs = T::mul(c, sn);
+    const float_t cs2 = T::mul(two, T::mul(cs, spq));
+
+    // S = G^T * S * G
+    s[p][p] = T::add(T::fmadd(cc, spp, cs2), T::mul(ss, sqq));
+    s[q][q] = T::sub(T::fmadd(ss, spp, T::mul(cc, sqq)), cs2);
+    s[p][q] = s[q][p] = T::fmadd(cs, T::sub(sqq, spp), T::mul(T::sub(cc, ss), spq));
+    s[p][k] = s[k][p] = T::fmadd(c, spk, T::mul(sn, sqk));
+    s[q][k] = s[k][q] = T::sub(T::mul(c, sqk), T::mul(sn, spk));
+
+    // V = V * G
+    const float_t vp = v[p];
+    const float_t vq = v[q];
+    const float_t vk = v[k];
+    const float_t vw = v[3];
+    v[p] = T::fmadd(ch, vp, T::mul(sh, vq));
+    v[q] = T::sub(T::mul(ch, vq), T::mul(sh, vp));
+    v[k] = T::fmadd(ch, vk, T::mul(sh, vw));
+    v[3] = T::sub(T::mul(ch, vw), T::mul(sh, vk));
+}
+
+
+
+/*-------------------------------------
+    Swap two columns, negating one so a rotation remains a rotation.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_svd_swap(
+    typename traits_t::mask_t swap,
+    typename traits_t::float_t (&b)[3],
+    typename traits_t::float_t (&c)[3]) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t zero = T::set1(0.f);
+
+    for (unsigned r = 0; r < 3; ++r)
+    {
+        const float_t t = b[r];
+        b[r] = T::select(swap, c[r], t);
+        c[r] = T::select(swap, T::sub(zero, t), c[r]);
+    }
+}
+
+
+
+/*-------------------------------------
+    Swap two columns of B & V, along with their sort keys.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_svd_cond_swap(
+    typename traits_t::mask_t swap,
+    typename traits_t::float_t (&b)[3],
+    typename traits_t::float_t (&c)[3],
+    typename traits_t::float_t (&vb)[3],
+    typename traits_t::float_t (&vc)[3],
+    typename traits_t::float_t& lenB,
+    typename traits_t::float_t& lenC) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    simd_svd_swap<T>(swap, b, c);
+    simd_svd_swap<T>(swap, vb, vc);
+
+    const float_t tl = lenB;
+    lenB = T::select(swap, lenC, tl);
+    lenC = T::select(swap, tl, lenC);
+}
+
+
+
+/*-------------------------------------
+    Givens rotation which removes the (q, p) element of B, accumulating the
+    rotation into U.
+-------------------------------------*/
+template <typename traits_t, unsigned p, unsigned q>
+inline LS_INLINE void simd_svd_qr(
+    typename traits_t::float_t (&b)[3][3],
+    typename traits_t::float_t (&u)[3][3],
+    typename traits_t::float_t tiny) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t zero = T::set1(0.f);
+    const float_t two = T::set1(2.f);
+    const float_t a1 = b[p][p];
+    const float_t a2 = T::select(T::cmp_lt(T::abs(b[p][q]), tiny), zero, b[p][q]);
+
+    // The half-angle is computed in whichever form avoids cancellation
+    const float_t rho = T::sqrt(T::fmadd(a1, a1, T::mul(a2, a2)));
+    float_t sh = a2;
+    float_t ch = T::add(T::abs(a1), T::max(rho, tiny));
+
+    const typename T::mask_t negative = T::cmp_lt(a1, zero);
+    const float_t t = sh;
+    sh = T::select(negative, ch, sh);
+    ch = T::select(negative, t, ch);
+
+    const float_t w = T::div(T::set1(1.f), T::sqrt(T::fmadd(ch, ch, T::mul(sh, sh))));
+    ch = T::mul(ch, w);
+    sh = T::mul(sh, w);
+
+    const float_t c = T::sub(T::mul(ch, ch), T::mul(sh, sh));
+    const float_t s = T::mul(two, T::mul(ch, sh));
+
+    for (unsigned j = 0; j < 3; ++j)
+    {
+        // B = G^T * B
+        const float_t bp = b[j][p];
+        const float_t bq = b[j][q];
+        b[j][p] = T::fmadd(c, bp, T::mul(s, bq));
+        b[j][q] = T::sub(T::mul(c, bq), T::mul(s, bp));
+
+        // U = U * G
+        const float_t up = u[p][j];
+        const float_t uq = u[q][j];
+        u[p][j] = T::fmadd(c, up, T::mul(s, uq));
+        u[q][j] = T::sub(T::mul(c, uq), T::mul(s, up));
+    }
+}
+
+
+
+/*-------------------------------------
+    Jacobi eigen-decomposition of a symmetric matrix, S = V * D * V^T.
+    Off-diagonal elements of S are rotated towards 0, leaving the
+    eigenvalues on its diagonal.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_svd_eigen(
+    typename traits_t::float_t (&s)[3][3],
+    typename traits_t::float_t (&outV)[3][3],
+    unsigned numSweeps,
+    typename traits_t::float_t tiny) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t zero = T::set1(0.f);
+    const float_t one = T::set1(1.f);
+    const float_t two = T::set1(2.f);
+    const float_t half = T::set1(0.5f);
+    const float_t sqrt2 = T::sqrt(two);
+
+    // Constants are computed at the precision of "float_t"
+    const float_t gamma = T::fmadd(two, sqrt2, T::set1(3.f));
+    const float_t cstar = T::mul(half, T::sqrt(T::add(two, sqrt2)));
+    const float_t sstar = T::mul(half, T::sqrt(T::sub(two, sqrt2)));
+
+    float_t q[4] = {zero, zero, zero, one};
+    for (unsigned sweep = 0; sweep < numSweeps; ++sweep)
+    {
+        simd_svd_jacobi<T, 0, 1, 2>(s, q, gamma, cstar, sstar, tiny);
+        simd_svd_jacobi<T, 1, 2, 0>(s, q, gamma, cstar, sstar, tiny);
+        simd_svd_jacobi<T, 2, 0, 1>(s, q, gamma, cstar, sstar, tiny);
+    }
+
+    const float_t qLen = T::sqrt(T::fmadd(q[3], q[3], T::fmadd(q[2], q[2], T::fmadd(q[1], q[1], T::mul(q[0], q[0])))));
+    const float_t qScale = T::div(one, qLen);
+    const float_t x = T::mul(q[0], qScale);
+    const float_t y = T::mul(q[1], qScale);
+    const float_t z = T::mul(q[2], qScale);
+    const float_t w = T::mul(q[3], qScale);
+
+    const float_t x2 = T::add(x, x);
+    const float_t y2 = T::add(y, y);
+    const float_t z2 = T::add(z, z);
+    const float_t xx = T::mul(x, x2);
+    const float_t yy = T::mul(y, y2);
+    const float_t zz = T::mul(z, z2);
+    const float_t xy = T::mul(x, y2);
+    const float_t xz = T::mul(x, z2);
+    const float_t yz = T::mul(y, z2);
+    const float_t wx = T::mul(w, x2);
+    const float_t wy = T::mul(w, y2);
+    const float_t wz = T::mul(w, z2);
+
+    outV[0][0] = T::sub(one, T::add(yy, zz));
+    outV[0][1] = T::add(xy, wz);
+    outV[0][2] = T::sub(xz, wy);
+    outV[1][0] = T::sub(xy, wz);
+    outV[1][1] = T::sub(one, T::add(xx, zz));
+    outV[1][2] = T::add(yz, wx);
+    outV[2][0] = T::add(xz, wy);
+    outV[2][1] = T::sub(yz, wx);
+    outV[2][2] = T::sub(one, T::add(xx, yy));
+}
+
+
+
+/*-------------------------------------
+    Scale a matrix so its largest element is 1. This prevents products of
+    the matrix from overflowing and makes "tiny" relative to the matrix.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_svd_prescale(
+    const typename traits_t::float_t (&a)[3][3],
+    typename traits_t::float_t (&out)[3][3],
+    typename traits_t::float_t& outUnscale) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t zero = T::set1(0.f);
+    const float_t one = T::set1(1.f);
+
+    float_t maxElem = zero;
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            maxElem = T::max(maxElem, T::abs(a[c][r]));
+        }
+    }
+
+    const typename T::mask_t nonzero = T::cmp_gt(maxElem, zero);
+    const float_t scale = T::select(nonzero, T::div(one, maxElem), one);
+    outUnscale = T::select(nonzero, maxElem, one);
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            out[c][r] = T::mul(a[c][r], scale);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    A = U * diag(S) * V^T
+-------------------------------------*/
+template <typename traits_t>
+inline void simd_svd3(
+    const typename traits_t::float_t (&a)[3][3],
+    typename traits_t::float_t (&outU)[3][3],
+    typename traits_t::float_t (&outS)[3],
+    typename traits_t::float_t (&outV)[3][3],
+    unsigned numSweeps,
+    typename traits_t::float_t epsilon) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t zero = T::set1(0.f);
+    const float_t one = T::set1(1.f);
+
+    // Elements below epsilon^2 have no effect on the results
+    const float_t tiny = T::mul(epsilon, epsilon);
+
+    float_t m[3][3];
+    float_t unscale;
+    simd_svd_prescale<T>(a, m, unscale);
+
+    // Symmetric eigen-decomposition of A^T * A
+    float_t s[3][3];
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        for (unsigned j = i; j < 3; ++j)
+        {
+            s[i][j] = s[j][i] = T::fmadd(m[i][2], m[j][2], T::fmadd(m[i][1], m[j][1], T::mul(m[i][0], m[j][0])));
+        }
+    }
+
+    float_t v[3][3];
+    simd_svd_eigen<T>(s, v, numSweeps, tiny);
+
+    // B = A * V, with columns sorted by decreasing length
+    float_t b[3][3];
+    float_t len[3];
+    for (unsigned j = 0; j < 3; ++j)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            b[j][r] = T::fmadd(m[2][r], v[j][2], T::fmadd(m[1][r], v[j][1], T::mul(m[0][r], v[j][0])));
+        }
+        len[j] = T::fmadd(b[j][2], b[j][2], T::fmadd(b[j][1], b[j][1], T::mul(b[j][0], b[j][0])));
+    }
+
+    simd_svd_cond_swap<T>(T::cmp_lt(len[0], len[1]), b[0], b[1], v[0], v[1], len[0], len[1]);
+    simd_svd_cond_swap<T>(T::cmp_lt(len[0], len[2]), b[0], b[2], v[0], v[2], len[0], len[2]);
+    simd_svd_cond_swap<T>(T::cmp_lt(len[1], len[2]), b[1], b[2], v[1], v[2], len[1], len[2]);
+
+    // B = U * R, where R is upper-triangular
+    float_t u[3][3] = {
+        {one, zero, zero},
+        {zero, one, zero},
+        {zero, zero, one}
+    };
+
+    simd_svd_qr<T, 0, 1>(b, u, tiny);
+    simd_svd_qr<T, 0, 2>(b, u, tiny);
+    simd_svd_qr<T, 1, 2>(b, u, tiny);
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        outS[c] = T::mul(b[c][c], unscale);
+
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            outU[c][r] = u[c][r];
+            outV[c][r] = v[c][r];
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    A = R * P
+-------------------------------------*/
+template <typename traits_t>
+inline void simd_polar3(
+    const typename traits_t::float_t (&a)[3][3],
+    typename traits_t::float_t (&outR)[3][3],
+    typename traits_t::float_t (&outP)[3][3],
+    unsigned numSweeps,
+    typename traits_t::float_t epsilon) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    float_t u[3][3], s[3], v[3][3];
+    simd_svd3<T>(a, u, s, v, numSweeps, epsilon);
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = c; r < 3; ++r)
+        {
+            // R = U * V^T, P = V * diag(S) * V^T
+            outR[c][r] = T::fmadd(u[2][r], v[2][c], T::fmadd(u[1][r], v[1][c], T::mul(u[0][r], v[0][c])));
+            outR[r][c] = T::fmadd(u[2][c], v[2][r], T::fmadd(u[1][c], v[1][r], T::mul(u[0][c], v[0][r])));
+
+            outP[c][r] = outP[r][c] = T::fmadd(
+                T::mul(v[2][r], s[2]), v[2][c],
+                T::fmadd(T::mul(v[1][r], s[1]), v[1][c], T::mul(T::mul(v[0][r], s[0]), v[0][c])));
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Swap two eigenvectors along with their eigenvalues.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_eigen_cond_swap(
+    typename traits_t::float_t (&d)[3],
+    typename traits_t::float_t (&v)[3][3],
+    unsigned b,
+    unsigned c) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const typename T::mask_t swap = T::cmp_lt(d[b], d[c]);
+    simd_svd_swap<T>(swap, v[b], v[c]);
+
+    const float_t t = d[b];
+    d[b] = T::select(swap, d[c], t);
+    d[c] = T::select(swap, t, d[c]);
+}
+
+
+
+/*-------------------------------------
+    A = V * diag(D) * transpose(V), where A is symmetric
+-------------------------------------*/
+template <typename traits_t>
+inline void simd_eigen3(
+    const typename traits_t::float_t (&a)[3][3],
+    typename traits_t::float_t (&outD)[3],
+    typename traits_t::float_t (&outV)[3][3],
+    unsigned numSweeps,
+    typename traits_t::float_t epsilon) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t half = T::set1(0.5f);
+    const float_t tiny = T::mul(epsilon, epsilon);
+
+    float_t s[3][3];
+    float_t unscale;
+    simd_svd_prescale<T>(a, s, unscale);
+
+    // Only the symmetric part of A is decomposed
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        for (unsigned j = i + 1; j < 3; ++j)
+        {
+            s[i][j] = s[j][i] = T::mul(half, T::add(s[i][j], s[j][i]));
+        }
+    }
+
+    float_t v[3][3];
+    simd_svd_eigen<T>(s, v, numSweeps, tiny);
+
+    // Sort by decreasing eigenvalue
+    float_t d[3] = {s[0][0], s[1][1], s[2][2]};
+    simd_eigen_cond_swap<T>(d, v, 0, 1);
+    simd_eigen_cond_swap<T>(d, v, 0, 2);
+    simd_eigen_cond_swap<T>(d, v, 1, 2);
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        outD[c] = T::mul(d[c], unscale);
+
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            outV[c][r] = v[c][r];
+        }
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Decompositions
+
+    Matrices are transposed in & out of registers through the stack, so any
+    register width may be used. Partial registers are padded with zeroes.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Load up to "width" matrices
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_svd_load(const mat3_t<float>* m, unsigned n, typename traits_t::float_t (&out)[3][3]) noexcept
+{
+    float lanes[3][3][traits_t::width];
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            for (unsigned i = 0; i < traits_t::width; ++i)
+            {
+                lanes[c][r][i] = (i < n) ? m[i].m[c].v[r] : 0.f;
+            }
+            out[c][r] = traits_t::load(lanes[c][r]);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Store up to "width" matrices
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_svd_store(const typename traits_t::float_t (&in)[3][3], unsigned n, mat3_t<float>* m) noexcept
+{
+    float lanes[3][3][traits_t::width];
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            traits_t::store(lanes[c][r], in[c][r]);
+            for (unsigned i = 0; i < n; ++i)
+            {
+                m[i].m[c].v[r] = lanes[c][r][i];
+            }
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Store up to "width" vectors
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_svd_store(const typename traits_t::float_t (&in)[3], unsigned n, vec3_t<float>* v) noexcept
+{
+    float lanes[3][traits_t::width];
+
+    for (unsigned r = 0; r < 3; ++r)
+    {
+        traits_t::store(lanes[r], in[r]);
+        for (unsigned i = 0; i < n; ++i)
+        {
+            v[i].v[r] = lanes[r][i];
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Batched SVD
+-------------------------------------*/
+template <typename traits_t>
+void simd_svd_batch(
+    const mat3_t<float>* a,
+    mat3_t<float>* outU,
+    vec3_t<float>* outS,
+    mat3_t<float>* outV,
+    std::size_t count,
+    unsigned numSweeps) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t epsilon = T::set1(std::numeric_limits<float>::epsilon());
+
+    for (std::size_t i = 0; i < count; i += T::width)
+    {
+        const unsigned n = (count - i < T::width) ? (unsigned)(count - i) : T::width;
+        float_t m[3][3], u[3][3], s[3], v[3][3];
+
+        simd_svd_load<T>(a + i, n, m);
+        simd_svd3<T>(m, u, s, v, numSweeps, epsilon);
+        simd_svd_store<T>(u, n, outU + i);
+        simd_svd_store<T>(s, n, outS + i);
+        simd_svd_store<T>(v, n, outV + i);
+    }
+}
+
+
+
+/*-------------------------------------
+    Batched polar decomposition
+-------------------------------------*/
+template <typename traits_t>
+void simd_polar_batch(
+    const mat3_t<float>* a,
+    mat3_t<float>* outR,
+    mat3_t<float>* outP,
+    std::size_t count,
+    unsigned numSweeps) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t epsilon = T::set1(std::numeric_limits<float>::epsilon());
+
+    for (std::size_t i = 0; i < count; i += T::width)
+    {
+        const unsigned n = (count - i < T::width) ? (unsigned)(count - i) : T::width;
+        float_t m[3][3], r[3][3], p[3][3];
+
+        simd_svd_load<T>(a + i, n, m);
+        simd_polar3<T>(m, r, p, numSweeps, epsilon);
+        simd_svd_store<T>(r, n, outR + i);
+        simd_svd_store<T>(p, n, outP + i);
+    }
+}
+
+
+
+/*-------------------------------------
+    Batched symmetric eigen-decomposition
+-------------------------------------*/
+template <typename traits_t>
+void simd_eigen_batch(
+    const mat3_t<float>* a,
+    vec3_t<float>* outValues,
+    mat3_t<float>* outVectors,
+    std::size_t count,
+    unsigned numSweeps) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t epsilon = T::set1(std::numeric_limits<float>::epsilon());
+
+    for (std::size_t i = 0; i < count; i += T::width)
+    {
+        const unsigned n = (count - i < T::width) ? (unsigned)(count - i) : T::width;
+        float_t m[3][3], d[3], v[3][3];
+
+        simd_svd_load<T>(a + i, n, m);
+        simd_eigen3<T>(m, d, v, numSweeps, epsilon);
+        simd_svd_store<T>(d, n, outValues + i);
+        simd_svd_store<T>(v, n, outVectors + i);
+    }
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_SVD_IMPL_H */
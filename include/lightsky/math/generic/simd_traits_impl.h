@@ -0,0 +1,113 @@
+
+#ifndef LS_MATH_SIMD_TRAITS_IMPL_H
+#define LS_MATH_SIMD_TRAITS_IMPL_H
+
+#include <cmath> // std::sqrt, std::fma
+#include <cstdint>
+#include <cstring> // std::memcpy
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Scalar Register Traits (1 float)
+
+    Allows the SIMD kernels to evaluate a single float on any platform.
+    Integer arithmetic is performed on unsigned values to avoid undefined
+    behavior on overflow.
+-----------------------------------------------------------------------------*/
+struct SimdTraitsScalar
+{
+    typedef float   float_t;
+    typedef int32_t int_t;
+    typedef bool    mask_t;
+
+    static constexpr unsigned width = 1;
+
+    static LS_INLINE float_t set1(float x) noexcept { return x; }
+    static LS_INLINE float_t add(float_t a, float_t b) noexcept { return a + b; }
+    static LS_INLINE float_t sub(float_t a, float_t b) noexcept { return a - b; }
+    static LS_INLINE float_t mul(float_t a, float_t b) noexcept { return a * b; }
+    static LS_INLINE float_t div(float_t a, float_t b) noexcept { return a / b; }
+    static LS_INLINE float_t sqrt(float_t x) noexcept { return std::sqrt(x); }
+    static LS_INLINE float_t min(float_t a, float_t b) noexcept { return (a < b) ? a : b; }
+    static LS_INLINE float_t max(float_t a, float_t b) noexcept { return (a > b) ? a : b; }
+
+    // Fused only when the hardware supports it, matching the SIMD registers
+    static LS_INLINE float_t fmadd(float_t a, float_t b, float_t c) noexcept
+    {
+        #ifdef FP_FAST_FMAF
+            return std::fma(a, b, c);
+        #else
+            return a * b + c;
+        #endif
+    }
+
+    static LS_INLINE float_t as_float(int_t x) noexcept
+    {
+        float ret;
+        std::memcpy(&ret, &x, sizeof(float));
+        return ret;
+    }
+
+    static LS_INLINE int_t as_int(float_t x) noexcept
+    {
+        int_t ret;
+        std::memcpy(&ret, &x, sizeof(float));
+        return ret;
+    }
+
+    static LS_INLINE float_t abs(float_t x) noexcept { return as_float(as_int(x) & 0x7FFFFFFF); }
+    static LS_INLINE float_t sign(float_t x) noexcept { return as_float((int_t)((uint32_t)as_int(x) & 0x80000000u)); }
+    static LS_INLINE float_t bit_xor(float_t a, float_t b) noexcept { return as_float(as_int(a) ^ as_int(b)); }
+    static LS_INLINE float_t bit_or(float_t a, float_t b) noexcept { return as_float(as_int(a) | as_int(b)); }
+
+    static LS_INLINE mask_t cmp_lt(float_t a, float_t b) noexcept { return a < b; }
+    static LS_INLINE mask_t cmp_gt(float_t a, float_t b) noexcept { return a > b; }
+    static LS_INLINE mask_t cmp_eq(float_t a, float_t b) noexcept { return a == b; }
+    static LS_INLINE mask_t cmp_unord(float_t a, float_t b) noexcept { return (a != a) || (b != b); }
+    static LS_INLINE mask_t cmp_signbit(float_t x) noexcept { return as_int(x) < 0; }
+    static LS_INLINE float_t select(mask_t m, float_t a, float_t b) noexcept { return m ? a : b; }
+
+    // Out-of-range conversions produce INT_MIN, as SSE & AVX do
+    static LS_INLINE int_t cvtt(float_t x) noexcept
+    {
+        return (x > -2147483648.f && x < 2147483648.f) ? (int_t)x : (int_t)0x80000000u;
+    }
+
+    static LS_INLINE float_t cvt(int_t x) noexcept { return (float)x; }
+    static LS_INLINE int_t iset1(int x) noexcept { return (int_t)x; }
+    static LS_INLINE int_t iadd(int_t a, int_t b) noexcept { return (int_t)((uint32_t)a + (uint32_t)b); }
+    static LS_INLINE int_t isub(int_t a, int_t b) noexcept { return (int_t)((uint32_t)a - (uint32_t)b); }
+    static LS_INLINE int_t iand(int_t a, int_t b) noexcept { return a & b; }
+    static LS_INLINE int_t ior(int_t a, int_t b) noexcept { return a | b; }
+    static LS_INLINE mask_t ieq(int_t a, int_t b) noexcept { return a == b; }
+
+    template <int n>
+    static LS_INLINE int_t ishl(int_t x) noexcept { return (int_t)((uint32_t)x << n); }
+
+    template <int n>
+    static LS_INLINE int_t ishr(int_t x) noexcept { return (x < 0) ? ~(~x >> n) : (x >> n); }
+
+    static LS_INLINE float_t load(const float* p) noexcept { return *p; }
+    static LS_INLINE void store(float* p, float_t x) noexcept { *p = x; }
+    static LS_INLINE float reduce_add(float_t x) noexcept { return x; }
+    static LS_INLINE float_t load_partial(const float* p, unsigned n) noexcept { return n ? *p : 0.f; }
+    static LS_INLINE void store_partial(float* p, float_t x, unsigned n) noexcept { if (n) *p = x; }
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_TRAITS_IMPL_H */
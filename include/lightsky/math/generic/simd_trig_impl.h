@@ -0,0 +1,465 @@
+
+#ifndef LS_MATH_SIMD_TRIG_IMPL_H
+#define LS_MATH_SIMD_TRIG_IMPL_H
+
+#include <cstddef> // std::size_t
+#include <limits> // std::numeric_limits
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/constants.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Width-Agnostic Trigonometric Kernels
+
+    These kernels are written against a "traits" type which wraps a single
+    SIMD register of floats (SSE, AVX, AVX-512, or NEON). A traits type must
+    provide the following:
+
+        typedef float_t, int_t, mask_t
+        static constexpr unsigned width
+        set1, add, sub, mul, div, fmadd (a*b+c), sqrt, abs, min, max
+        sign (isolate the sign bit), bit_xor, bit_or
+        cmp_lt, cmp_gt, cmp_eq, cmp_unord, cmp_signbit, select (mask ? a : b)
+        cvtt (truncate to int), cvt (int to float), iset1, iadd, isub, iand,
+        ior, ishl<n>, ishr<n> (arithmetic), ieq, as_float & as_int (bitwise
+        casts)
+        load, store, load_partial, store_partial
+
+    The polynomials are the single-precision minimax approximations from the
+    Cephes math library and are accurate to within 2 ULP over their primary
+    domains. Sine & cosine use a three-step Cody-Waite range reduction, which
+    keeps them within 2 ULP for |x| <= pi and within 1.2e-7 absolute for
+    |x| < 8192.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    sincos
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE void simd_sincos(
+    typename traits_t::float_t x,
+    typename traits_t::float_t& outSin,
+    typename traits_t::float_t& outCos) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typedef typename traits_t::int_t   int_t;
+    typedef typename traits_t::mask_t  mask_t;
+
+    const float_t ax = T::abs(x);
+
+    // Octant selection. Odd octants are rounded up so the remainder lies
+    // within [-pi/4, pi/4].
+    int_t j = T::cvtt(T::mul(ax, T::set1(1.27323954473516f))); // 4/pi
+    j = T::iand(T::iadd(j, T::iset1(1)), T::iset1(~1));
+    const float_t y = T::cvt(j);
+
+    float_t r = T::fmadd(y, T::set1(-0.78515625f), ax);
+    r = T::fmadd(y, T::set1(-2.4187564849853515625e-4f), r);
+    r = T::fmadd(y, T::set1(-3.77489497744594108e-8f), r);
+
+    const float_t z = T::mul(r, r);
+
+    float_t pc = T::set1(2.443315711809948e-5f);
+    pc = T::fmadd(pc, z, T::set1(-1.388731625493765e-3f));
+    pc = T::fmadd(pc, z, T::set1(4.166664568298827e-2f));
+    pc = T::mul(T::mul(pc, z), z);
+    pc = T::add(T::fmadd(z, T::set1(-0.5f), pc), T::set1(1.f));
+
+    float_t ps = T::set1(-1.9515295891e-4f);
+    ps = T::fmadd(ps, z, T::set1(8.3321608736e-3f));
+    ps = T::fmadd(ps, z, T::set1(-1.6666654611e-1f));
+    ps = T::fmadd(T::mul(ps, z), r, r);
+
+    // Octants 2, 3, 6, and 7 swap the sine & cosine polynomials
+    const mask_t swap = T::ieq(T::iand(j, T::iset1(2)), T::iset1(2));
+    const float_t s = T::select(swap, pc, ps);
+    const float_t c = T::select(swap, ps, pc);
+
+    const float_t sinSign = T::bit_xor(T::sign(x), T::as_float(T::template ishl<29>(T::iand(j, T::iset1(4)))));
+    const float_t cosSign = T::as_float(T::template ishl<29>(T::iand(T::iadd(j, T::iset1(2)), T::iset1(4))));
+
+    outSin = T::bit_xor(s, sinSign);
+    outCos = T::bit_xor(c, cosSign);
+}
+
+
+
+/*-------------------------------------
+    sin
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_sin(typename traits_t::float_t x) noexcept
+{
+    typename traits_t::float_t s, c;
+    simd_sincos<traits_t>(x, s, c);
+    return s;
+}
+
+
+
+/*-------------------------------------
+    cos
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_cos(typename traits_t::float_t x) noexcept
+{
+    typename traits_t::float_t s, c;
+    simd_sincos<traits_t>(x, s, c);
+    return c;
+}
+
+
+
+/*-------------------------------------
+    tan
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_tan(typename traits_t::float_t x) noexcept
+{
+    typename traits_t::float_t s, c;
+    simd_sincos<traits_t>(x, s, c);
+    return traits_t::div(s, c);
+}
+
+
+
+/*-------------------------------------
+    Arc-tangent polynomial, evaluated for a reduced argument "x" and added
+    to the angle "y0".
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_atan_poly(
+    typename traits_t::float_t x,
+    typename traits_t::float_t y0) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t z = T::mul(x, x);
+
+    float_t p = T::set1(8.05374449538e-2f);
+    p = T::fmadd(p, z, T::set1(-1.38776856032e-1f));
+    p = T::fmadd(p, z, T::set1(1.99777106478e-1f));
+    p = T::fmadd(p, z, T::set1(-3.33329491539e-1f));
+    p = T::fmadd(T::mul(p, z), x, x);
+
+    return T::add(p, y0);
+}
+
+
+
+/*-------------------------------------
+    atan
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_atan(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typedef typename traits_t::mask_t  mask_t;
+
+    const float_t ax  = T::abs(x);
+    const float_t one = T::set1(1.f);
+    const mask_t  big = T::cmp_gt(ax, T::set1(2.414213562373095f)); // tan(3pi/8)
+    const mask_t  mid = T::cmp_gt(ax, T::set1(0.4142135623730950f)); // tan(pi/8)
+
+    // big:  -1/x
+    // mid:  (x-1)/(x+1)
+    // else: x
+    const float_t num = T::select(big, T::set1(-1.f), T::select(mid, T::sub(ax, one), ax));
+    const float_t den = T::select(big, ax, T::select(mid, T::add(ax, one), one));
+    const float_t y0  = T::select(big, T::set1((float)LS_PI_OVER_2), T::select(mid, T::set1((float)LS_PI_OVER_4), T::set1(0.f)));
+
+    const float_t ret = simd_atan_poly<traits_t>(T::div(num, den), y0);
+    return T::bit_xor(ret, T::sign(x));
+}
+
+
+
+/*-------------------------------------
+    atan2
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_atan2(
+    typename traits_t::float_t y,
+    typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typedef typename traits_t::mask_t  mask_t;
+
+    const float_t ax = T::abs(x);
+    const float_t ay = T::abs(y);
+    const float_t lo = T::min(ax, ay);
+    const float_t hi = T::max(ax, ay);
+
+    // The ratio lo/hi is within [0, 1]. 0/0 and inf/inf are resolved to
+    // match the quadrant rules of std::atan2().
+    float_t a = T::div(lo, hi);
+    a = T::select(T::cmp_eq(hi, T::set1(0.f)), T::set1(0.f), a);
+    a = T::select(T::cmp_eq(lo, T::set1(std::numeric_limits<float>::infinity())), T::set1(1.f), a);
+
+    const mask_t mid = T::cmp_gt(a, T::set1(0.4142135623730950f));
+    const float_t ar = T::select(mid, T::div(T::sub(a, T::set1(1.f)), T::add(a, T::set1(1.f))), a);
+    const float_t y0 = T::select(mid, T::set1((float)LS_PI_OVER_4), T::set1(0.f));
+
+    float_t r = simd_atan_poly<traits_t>(ar, y0);
+    r = T::select(T::cmp_gt(ay, ax), T::sub(T::set1((float)LS_PI_OVER_2), r), r);
+    r = T::select(T::cmp_signbit(x), T::sub(T::set1((float)LS_PI), r), r);
+    r = T::bit_or(r, T::sign(y));
+
+    return T::select(T::cmp_unord(x, y), T::add(x, y), r);
+}
+
+
+
+/*-------------------------------------
+    Arc-sine polynomial for |x|. Returns the partial result "p" and a mask
+    indicating if |x| > 0.5, in which case asin(|x|) = pi/2 - 2p.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_asin_poly(
+    typename traits_t::float_t ax,
+    typename traits_t::mask_t& outBig) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t half = T::set1(0.5f);
+    outBig = T::cmp_gt(ax, half);
+
+    const float_t z = T::select(outBig, T::mul(half, T::sub(T::set1(1.f), ax)), T::mul(ax, ax));
+    const float_t s = T::select(outBig, T::sqrt(z), ax);
+
+    float_t p = T::set1(4.2163199048e-2f);
+    p = T::fmadd(p, z, T::set1(2.4181311049e-2f));
+    p = T::fmadd(p, z, T::set1(4.5470025998e-2f));
+    p = T::fmadd(p, z, T::set1(7.4953002686e-2f));
+    p = T::fmadd(p, z, T::set1(1.6666752422e-1f));
+
+    return T::fmadd(T::mul(p, z), s, s);
+}
+
+
+
+/*-------------------------------------
+    asin
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_asin(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typename traits_t::mask_t big;
+
+    const float_t p = simd_asin_poly<traits_t>(T::abs(x), big);
+    const float_t r = T::select(big, T::fmadd(p, T::set1(-2.f), T::set1((float)LS_PI_OVER_2)), p);
+
+    return T::bit_xor(r, T::sign(x));
+}
+
+
+
+/*-------------------------------------
+    acos
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_acos(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typename traits_t::mask_t big;
+
+    const float_t p = simd_asin_poly<traits_t>(T::abs(x), big);
+
+    // |x| <= 0.5: pi/2 - asin(x)
+    // x > 0.5:    2*asin(sqrt((1-x)/2))
+    // x < -0.5:   pi - 2*asin(sqrt((1+x)/2))
+    const float_t p2    = T::add(p, p);
+    const float_t large = T::select(T::cmp_lt(x, T::set1(0.f)), T::sub(T::set1((float)LS_PI), p2), p2);
+    const float_t small = T::sub(T::set1((float)LS_PI_OVER_2), T::bit_xor(p, T::sign(x)));
+
+    return T::select(big, large, small);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Low-Precision Trigonometric Kernels
+
+    These are vectorized versions of the scalar approximations found in
+    scalar_utils.h, and produce the same results.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    floor, valid for all finite inputs
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_floor(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t t = T::cvt(T::cvtt(x));
+    const float_t f = T::select(T::cmp_gt(t, x), T::sub(t, T::set1(1.f)), t);
+
+    // floats larger than 2^23 are already integral
+    return T::select(T::cmp_lt(T::abs(x), T::set1(8388608.f)), f, x);
+}
+
+
+
+/*-------------------------------------
+    Fast cosine
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_fast_cos(typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+
+    const float_t x1 = T::mul(x, T::set1((float)(1.0 / LS_TWO_PI)));
+    const float_t x2 = T::sub(x1, T::add(T::set1(0.25f), simd_floor<traits_t>(T::add(x1, T::set1(0.25f)))));
+    const float_t x3 = T::mul(T::mul(x2, T::set1(16.f)), T::sub(T::abs(x2), T::set1(0.5f)));
+    const float_t x4 = T::mul(x3, T::sub(T::abs(x3), T::set1(1.f)));
+
+    return T::fmadd(T::set1(0.225f), x4, x3);
+}
+
+
+
+/*-------------------------------------
+    Fast sine
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_fast_sin(typename traits_t::float_t x) noexcept
+{
+    return simd_fast_cos<traits_t>(traits_t::sub(x, traits_t::set1((float)LS_PI_OVER_2)));
+}
+
+
+
+/*-------------------------------------
+    Fast arc-tangent, accurate to within 0.01 radians.
+-------------------------------------*/
+template <typename traits_t>
+inline LS_INLINE typename traits_t::float_t simd_fast_atan2(
+    typename traits_t::float_t y,
+    typename traits_t::float_t x) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typedef typename traits_t::mask_t  mask_t;
+
+    const float_t absY  = T::abs(y);
+    const float_t xy    = T::add(x, absY);
+    const mask_t  xNeg  = T::cmp_lt(x, T::set1(0.f));
+    const float_t num   = T::select(xNeg, xy, T::sub(x, absY));
+    const float_t den   = T::select(xNeg, T::sub(absY, x), xy);
+    const float_t theta = T::select(xNeg, T::set1((float)(3.0 * LS_PI_OVER_4)), T::set1((float)LS_PI_OVER_4));
+
+    const float_t r  = T::div(num, den);
+    const float_t r2 = T::fmadd(T::set1((float)(LS_PI / 16.0)), T::mul(r, r), T::set1((float)(-5.0 * LS_PI / 16.0)));
+    const float_t angle = T::fmadd(r, r2, theta);
+
+    return T::select(T::cmp_lt(y, T::set1(0.f)), T::bit_xor(angle, T::set1(-0.f)), angle);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Array Evaluation
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Apply a unary kernel to an array, using partial loads & stores for any
+    remaining elements.
+-------------------------------------*/
+template <typename traits_t, typename kernel_t>
+inline void simd_apply_unary(const float* x, float* out, std::size_t count, kernel_t&& kernel) noexcept
+{
+    typedef traits_t T;
+    constexpr std::size_t width = T::width;
+    std::size_t i = 0;
+
+    for (; i + width <= count; i += width)
+    {
+        T::store(out+i, kernel(T::load(x+i)));
+    }
+
+    if (i < count)
+    {
+        const unsigned n = (unsigned)(count - i);
+        T::store_partial(out+i, kernel(T::load_partial(x+i, n)), n);
+    }
+}
+
+
+
+/*-------------------------------------
+    Apply a binary kernel to two arrays
+-------------------------------------*/
+template <typename traits_t, typename kernel_t>
+inline void simd_apply_binary(const float* a, const float* b, float* out, std::size_t count, kernel_t&& kernel) noexcept
+{
+    typedef traits_t T;
+    constexpr std::size_t width = T::width;
+    std::size_t i = 0;
+
+    for (; i + width <= count; i += width)
+    {
+        T::store(out+i, kernel(T::load(a+i), T::load(b+i)));
+    }
+
+    if (i < count)
+    {
+        const unsigned n = (unsigned)(count - i);
+        T::store_partial(out+i, kernel(T::load_partial(a+i, n), T::load_partial(b+i, n)), n);
+    }
+}
+
+
+
+/*-------------------------------------
+    Sine & cosine of an array
+-------------------------------------*/
+template <typename traits_t>
+inline void simd_sincos_array(const float* x, float* outSin, float* outCos, std::size_t count) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    constexpr std::size_t width = T::width;
+    std::size_t i = 0;
+    float_t s, c;
+
+    for (; i + width <= count; i += width)
+    {
+        simd_sincos<traits_t>(T::load(x+i), s, c);
+        T::store(outSin+i, s);
+        T::store(outCos+i, c);
+    }
+
+    if (i < count)
+    {
+        const unsigned n = (unsigned)(count - i);
+        simd_sincos<traits_t>(T::load_partial(x+i, n), s, c);
+        T::store_partial(outSin+i, s, n);
+        T::store_partial(outCos+i, c, n);
+    }
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_TRIG_IMPL_H */
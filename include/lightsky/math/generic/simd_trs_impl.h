@@ -0,0 +1,218 @@
+
+#ifndef LS_MATH_SIMD_TRS_IMPL_H
+#define LS_MATH_SIMD_TRS_IMPL_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/quat_utils.h"
+#include "lightsky/math/vec3.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    SIMD Transform Composition Kernels
+
+    These kernels are written against the same "traits" types as the
+    trigonometric kernels in "simd_trig_impl.h", with the addition of
+    load_soa3, store_soa3, load_soa4, store_soa4, and transpose. Each lane
+    holds one transform, and the columns of four matrices are transposed
+    in or out of registers together. Transforms which don't fill a register
+    use the scalar compose_trs() and decompose() functions.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Translate * Rotate * Scale
+-------------------------------------*/
+template <typename traits_t>
+void simd_compose_trs(
+    const vec3_t<float>* t,
+    const quat_t<float>* r,
+    const vec3_t<float>* s,
+    mat4_t<float>* out,
+    std::size_t count) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    static_assert(T::width == 4, "Transform composition requires 4-wide registers.");
+
+    const float_t zero = T::set1(0.f);
+    const float_t one = T::set1(1.f);
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float_t x, y, z, w;
+        float_t px, py, pz;
+        float_t sx, sy, sz;
+        T::load_soa4(r[i].q, x, y, z, w);
+        T::load_soa3(t[i].v, px, py, pz);
+        T::load_soa3(s[i].v, sx, sy, sz);
+
+        const float_t x2 = T::add(x, x);
+        const float_t y2 = T::add(y, y);
+        const float_t z2 = T::add(z, z);
+        const float_t xx = T::mul(x, x2);
+        const float_t yy = T::mul(y, y2);
+        const float_t zz = T::mul(z, z2);
+        const float_t xy = T::mul(x, y2);
+        const float_t xz = T::mul(x, z2);
+        const float_t yz = T::mul(y, z2);
+        const float_t wx = T::mul(w, x2);
+        const float_t wy = T::mul(w, y2);
+        const float_t wz = T::mul(w, z2);
+
+        float_t cols[4][4] = {
+            {T::mul(T::sub(one, T::add(yy, zz)), sx), T::mul(T::add(xy, wz), sx), T::mul(T::sub(xz, wy), sx), zero},
+            {T::mul(T::sub(xy, wz), sy), T::mul(T::sub(one, T::add(xx, zz)), sy), T::mul(T::add(yz, wx), sy), zero},
+            {T::mul(T::add(xz, wy), sz), T::mul(T::sub(yz, wx), sz), T::mul(T::sub(one, T::add(xx, yy)), sz), zero},
+            {px, py, pz, one}
+        };
+
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            T::transpose(cols[c][0], cols[c][1], cols[c][2], cols[c][3]);
+            for (unsigned j = 0; j < 4; ++j)
+            {
+                T::store(out[i+j].m[c].v, cols[c][j]);
+            }
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        out[i] = compose_trs(t[i], r[i], s[i]);
+    }
+}
+
+
+
+/*-------------------------------------
+    Matrix decomposition, using the same method as decompose(). All four
+    candidate rotations are computed and the best conditioned one is
+    selected per lane.
+-------------------------------------*/
+template <typename traits_t>
+void simd_decompose_trs(
+    const mat4_t<float>* m,
+    vec3_t<float>* outT,
+    quat_t<float>* outR,
+    vec3_t<float>* outS,
+    std::size_t count) noexcept
+{
+    typedef traits_t T;
+    typedef typename traits_t::float_t float_t;
+    typedef typename traits_t::mask_t mask_t;
+    static_assert(T::width == 4, "Transform decomposition requires 4-wide registers.");
+
+    const float_t zero = T::set1(0.f);
+    const float_t one = T::set1(1.f);
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        // cols[c][r] holds row "r" of column "c" from four matrices
+        float_t cols[4][4];
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            for (unsigned j = 0; j < 4; ++j)
+            {
+                cols[c][j] = T::load(m[i+j].m[c].v);
+            }
+            T::transpose(cols[c][0], cols[c][1], cols[c][2], cols[c][3]);
+        }
+
+        const float_t(&c0)[4] = cols[0];
+        const float_t(&c1)[4] = cols[1];
+        const float_t(&c2)[4] = cols[2];
+
+        // reflections are moved into the X scale
+        const float_t crossX = T::sub(T::mul(c0[1], c1[2]), T::mul(c0[2], c1[1]));
+        const float_t crossY = T::sub(T::mul(c0[2], c1[0]), T::mul(c0[0], c1[2]));
+        const float_t crossZ = T::sub(T::mul(c0[0], c1[1]), T::mul(c0[1], c1[0]));
+        const float_t det = T::fmadd(crossZ, c2[2], T::fmadd(crossY, c2[1], T::mul(crossX, c2[0])));
+
+        const float_t lx = T::sqrt(T::fmadd(c0[2], c0[2], T::fmadd(c0[1], c0[1], T::mul(c0[0], c0[0]))));
+        const float_t sx = T::select(T::cmp_lt(det, zero), T::sub(zero, lx), lx);
+        const float_t sy = T::sqrt(T::fmadd(c1[2], c1[2], T::fmadd(c1[1], c1[1], T::mul(c1[0], c1[0]))));
+        const float_t sz = T::sqrt(T::fmadd(c2[2], c2[2], T::fmadd(c2[1], c2[1], T::mul(c2[0], c2[0]))));
+
+        const float_t ix = T::select(T::cmp_eq(sx, zero), zero, T::div(one, sx));
+        const float_t iy = T::select(T::cmp_eq(sy, zero), zero, T::div(one, sy));
+        const float_t iz = T::select(T::cmp_eq(sz, zero), zero, T::div(one, sz));
+
+        float_t a0[3] = {T::mul(c0[0], ix), T::mul(c0[1], ix), T::mul(c0[2], ix)};
+        float_t a1[3] = {T::mul(c1[0], iy), T::mul(c1[1], iy), T::mul(c1[2], iy)};
+        float_t a2[3] = {T::mul(c2[0], iz), T::mul(c2[1], iz), T::mul(c2[2], iz)};
+
+        // axes with a scale of 0 are rebuilt from the other two, in order
+        const auto rebuild_axis = [&](const float_t& scale, float_t (&axis)[3], const float_t (&u)[3], const float_t (&v)[3]) noexcept
+        {
+            const mask_t degenerate = T::cmp_eq(scale, zero);
+            axis[0] = T::select(degenerate, T::sub(T::mul(u[1], v[2]), T::mul(u[2], v[1])), axis[0]);
+            axis[1] = T::select(degenerate, T::sub(T::mul(u[2], v[0]), T::mul(u[0], v[2])), axis[1]);
+            axis[2] = T::select(degenerate, T::sub(T::mul(u[0], v[1]), T::mul(u[1], v[0])), axis[2]);
+        };
+
+        rebuild_axis(sx, a0, a1, a2);
+        rebuild_axis(sy, a1, a2, a0);
+        rebuild_axis(sz, a2, a0, a1);
+
+        const float_t r00 = a0[0], r01 = a0[1], r02 = a0[2];
+        const float_t r10 = a1[0], r11 = a1[1], r12 = a1[2];
+        const float_t r20 = a2[0], r21 = a2[1], r22 = a2[2];
+
+        const float_t t0 = T::add(T::add(one, r00), T::add(r11, r22));
+        const float_t t1 = T::sub(T::add(one, r00), T::add(r11, r22));
+        const float_t t2 = T::sub(T::add(one, r11), T::add(r00, r22));
+        const float_t t3 = T::sub(T::add(one, r22), T::add(r00, r11));
+
+        const float_t s01 = T::add(r01, r10);
+        const float_t s02 = T::add(r20, r02);
+        const float_t s12 = T::add(r12, r21);
+        const float_t d01 = T::sub(r01, r10);
+        const float_t d02 = T::sub(r20, r02);
+        const float_t d12 = T::sub(r12, r21);
+
+        const mask_t use1 = T::cmp_gt(t1, t0);
+        const mask_t use3 = T::cmp_gt(t3, t2);
+        const mask_t use23 = T::cmp_gt(T::select(use3, t3, t2), T::select(use1, t1, t0));
+
+        float_t x = T::select(use23, T::select(use3, s02, s01), T::select(use1, t1, d12));
+        float_t y = T::select(use23, T::select(use3, s12, t2), T::select(use1, s01, d02));
+        float_t z = T::select(use23, T::select(use3, t3, s12), T::select(use1, s02, d01));
+        float_t w = T::select(use23, T::select(use3, d01, d02), T::select(use1, d12, t0));
+
+        // normalize into the hemisphere w >= 0
+        const float_t len = T::bit_xor(T::sqrt(T::fmadd(w, w, T::fmadd(z, z, T::fmadd(y, y, T::mul(x, x))))), T::sign(w));
+        x = T::div(x, len);
+        y = T::div(y, len);
+        z = T::div(z, len);
+        w = T::div(w, len);
+
+        T::store_soa3(outT[i].v, cols[3][0], cols[3][1], cols[3][2]);
+        T::store_soa4(outR[i].q, x, y, z, w);
+        T::store_soa3(outS[i].v, sx, sy, sz);
+    }
+
+    for (; i < count; ++i)
+    {
+        decompose(m[i], outT[i], outR[i], outS[i]);
+    }
+}
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_TRS_IMPL_H */
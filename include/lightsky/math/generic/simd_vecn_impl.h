@@ -0,0 +1,181 @@
+
+#ifndef LS_MATH_SIMD_VECN_IMPL_H
+#define LS_MATH_SIMD_VECN_IMPL_H
+
+#include <utility> // std::integer_sequence
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/generic/simd_traits_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    N-Dimensional Vector SIMD Kernels
+
+    Each kernel processes as many components as possible using the widest
+    register selected by "select_t", then repeats itself on the remaining
+    components with a narrower register. The selector returns
+    "SimdTraitsScalar" once fewer components remain than the narrowest
+    register can hold. Registers are expanded from a pack of indices, rather
+    than a loop, as compilers won't always unroll loops at -O2. The results
+    of chained operations then stay in registers.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Element-wise vector-vector operation
+-------------------------------------*/
+template <typename traits_t, typename op_t, unsigned... i>
+inline LS_INLINE void simd_vecn_map_regs(const float* a, const float* b, float* out, std::integer_sequence<unsigned, i...>) noexcept
+{
+    typedef traits_t T;
+    (T::store(out + i * T::width, op_t::template simd<T>(T::load(a + i * T::width), T::load(b + i * T::width))), ...);
+}
+
+template <typename select_t, unsigned N, typename op_t>
+inline LS_INLINE void simd_vecn_map(const float* a, const float* b, float* out) noexcept
+{
+    typedef typename select_t::template traits<N> T;
+    constexpr unsigned n = N - (N % T::width);
+
+    simd_vecn_map_regs<T, op_t>(a, b, out, std::make_integer_sequence<unsigned, n / T::width>{});
+
+    if constexpr (n < N)
+    {
+        simd_vecn_map<select_t, N - n, op_t>(a + n, b + n, out + n);
+    }
+}
+
+
+
+/*-------------------------------------
+    Element-wise vector-scalar operation
+-------------------------------------*/
+template <typename traits_t, typename op_t, unsigned... i>
+inline LS_INLINE void simd_vecn_map_scalar_regs(const float* a, float b, float* out, std::integer_sequence<unsigned, i...>) noexcept
+{
+    typedef traits_t T;
+    const typename T::float_t s = T::set1(b);
+    (T::store(out + i * T::width, op_t::template simd<T>(T::load(a + i * T::width), s)), ...);
+}
+
+template <typename select_t, unsigned N, typename op_t>
+inline LS_INLINE void simd_vecn_map_scalar(const float* a, float b, float* out) noexcept
+{
+    typedef typename select_t::template traits<N> T;
+    constexpr unsigned n = N - (N % T::width);
+
+    simd_vecn_map_scalar_regs<T, op_t>(a, b, out, std::make_integer_sequence<unsigned, n / T::width>{});
+
+    if constexpr (n < N)
+    {
+        simd_vecn_map_scalar<select_t, N - n, op_t>(a + n, b, out + n);
+    }
+}
+
+
+
+/*-------------------------------------
+    Fused multiply-add
+-------------------------------------*/
+template <typename traits_t, unsigned... i>
+inline LS_INLINE void simd_vecn_fmadd_regs(const float* x, const float* m, const float* a, float* out, std::integer_sequence<unsigned, i...>) noexcept
+{
+    typedef traits_t T;
+    (T::store(out + i * T::width, T::fmadd(T::load(x + i * T::width), T::load(m + i * T::width), T::load(a + i * T::width))), ...);
+}
+
+template <typename select_t, unsigned N>
+inline LS_INLINE void simd_vecn_fmadd(const float* x, const float* m, const float* a, float* out) noexcept
+{
+    typedef typename select_t::template traits<N> T;
+    constexpr unsigned n = N - (N % T::width);
+
+    simd_vecn_fmadd_regs<T>(x, m, a, out, std::make_integer_sequence<unsigned, n / T::width>{});
+
+    if constexpr (n < N)
+    {
+        simd_vecn_fmadd<select_t, N - n>(x + n, m + n, a + n, out + n);
+    }
+}
+
+
+
+/*-------------------------------------
+    Dot product. Products are accumulated in one register, then its lanes
+    are summed.
+-------------------------------------*/
+template <typename traits_t, unsigned... i>
+inline LS_INLINE typename traits_t::float_t simd_vecn_dot_regs(const float* a, const float* b, std::integer_sequence<unsigned, i...>) noexcept
+{
+    typedef traits_t T;
+    typename T::float_t sum = T::set1(0.f);
+    ((sum = T::fmadd(T::load(a + i * T::width), T::load(b + i * T::width), sum)), ...);
+    return sum;
+}
+
+template <typename select_t, unsigned N>
+inline LS_INLINE float simd_vecn_dot(const float* a, const float* b) noexcept
+{
+    typedef typename select_t::template traits<N> T;
+    constexpr unsigned n = N - (N % T::width);
+
+    const typename T::float_t sum = simd_vecn_dot_regs<T>(a, b, std::make_integer_sequence<unsigned, n / T::width>{});
+    float ret = T::reduce_add(sum);
+
+    if constexpr (n < N)
+    {
+        ret += simd_vecn_dot<select_t, N - n>(a + n, b + n);
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Kernels for a single-precision vector, used to specialize "VecNSimd"
+-------------------------------------*/
+template <typename select_t>
+struct VecNSimdKernels
+{
+    static constexpr bool value = true;
+
+    template <unsigned N, typename op_t>
+    static LS_INLINE void map(const float* a, const float* b, float* out) noexcept
+    {
+        simd_vecn_map<select_t, N, op_t>(a, b, out);
+    }
+
+    template <unsigned N, typename op_t>
+    static LS_INLINE void map_scalar(const float* a, float b, float* out) noexcept
+    {
+        simd_vecn_map_scalar<select_t, N, op_t>(a, b, out);
+    }
+
+    template <unsigned N>
+    static LS_INLINE void fmadd(const float* x, const float* m, const float* a, float* out) noexcept
+    {
+        simd_vecn_fmadd<select_t, N>(x, m, a, out);
+    }
+
+    template <unsigned N>
+    static LS_INLINE float dot(const float* a, const float* b) noexcept
+    {
+        return simd_vecn_dot<select_t, N>(a, b);
+    }
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMD_VECN_IMPL_H */
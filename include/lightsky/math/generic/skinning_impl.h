@@ -0,0 +1,87 @@
+
+#ifndef LS_MATH_SKINNING_IMPL_H
+#define LS_MATH_SKINNING_IMPL_H
+
+#include "lightsky/math/generic/simd_skinning_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-------------------------------------
+    Split an array of vertices into chunks and skin each on a thread.
+
+    The chunk size is a multiple of every SIMD width so only the final chunk
+    contains a partial group of vertices.
+-------------------------------------*/
+constexpr std::size_t skin_chunk_size = 4096;
+
+template <typename kernel_t>
+inline void skin_chunks(std::size_t count, unsigned numThreads, const kernel_t& kernel) noexcept
+{
+    const std::size_t numChunks = (count + skin_chunk_size - 1) / skin_chunk_size;
+
+    parallel_for(numChunks, numThreads, [&](std::size_t chunkId, unsigned)->void
+    {
+        const std::size_t first = chunkId * skin_chunk_size;
+        const std::size_t n = (count - first < skin_chunk_size) ? (count - first) : skin_chunk_size;
+        kernel(first, n);
+    });
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    skin_vertices
+-------------------------------------*/
+template <typename num_t, typename index_t, typename weight_t>
+void skin_vertices(
+    const mat4_t<num_t>* palette,
+    const vec3_t<num_t>* positions,
+    const vec3_t<num_t>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<weight_t>* weights,
+    vec3_t<num_t>* outPositions,
+    vec3_t<num_t>* outNormals,
+    std::size_t count,
+    unsigned numThreads) noexcept
+{
+    impl::skin_chunks(count, numThreads, [&](std::size_t first, std::size_t n)->void
+    {
+        for (std::size_t i = first; i < first + n; ++i)
+        {
+            const vec4_t<index_t>& ids = boneIds[i];
+            const vec4_t<weight_t>& w = weights[i];
+
+            mat4_t<num_t> m = palette[ids[0]] * impl::SkinWeight<weight_t>::template convert<num_t>(w[0]);
+            m += palette[ids[1]] * impl::SkinWeight<weight_t>::template convert<num_t>(w[1]);
+            m += palette[ids[2]] * impl::SkinWeight<weight_t>::template convert<num_t>(w[2]);
+            m += palette[ids[3]] * impl::SkinWeight<weight_t>::template convert<num_t>(w[3]);
+
+            if (normals)
+            {
+                const vec3_t<num_t>& n3 = normals[i];
+                const vec4_t<num_t>&& n4 = m * vec4_t<num_t>{n3[0], n3[1], n3[2], num_t{0}};
+                outNormals[i] = vec3_t<num_t>{n4[0], n4[1], n4[2]};
+            }
+
+            const vec3_t<num_t>& p3 = positions[i];
+            const vec4_t<num_t>&& p4 = m * vec4_t<num_t>{p3[0], p3[1], p3[2], num_t{1}};
+            outPositions[i] = vec3_t<num_t>{p4[0], p4[1], p4[2]};
+        }
+    });
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SKINNING_IMPL_H */
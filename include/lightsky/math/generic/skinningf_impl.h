@@ -0,0 +1,54 @@
+
+#ifndef LS_MATH_SKINNINGF_IMPL_H
+#define LS_MATH_SKINNINGF_IMPL_H
+
+#include "lightsky/math/generic/simd_skinning_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Linear Blend Skinning
+
+    Shared by the x86 and NEON builds. Bones are blended one matrix column at
+    a time, so both use 128-bit registers.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    skin_vertices
+-------------------------------------*/
+template <typename index_t, typename weight_t>
+inline void skin_vertices(
+    const mat4_t<float>* palette,
+    const vec3_t<float>* positions,
+    const vec3_t<float>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<weight_t>* weights,
+    vec3_t<float>* outPositions,
+    vec3_t<float>* outNormals,
+    std::size_t count,
+    unsigned numThreads = 0) noexcept
+{
+    impl::skin_chunks(count, numThreads, [&](std::size_t first, std::size_t n)->void
+    {
+        impl::simd_matrix_skin<impl::SimdTraits128>(
+            palette,
+            positions + first,
+            normals ? normals + first : nullptr,
+            boneIds + first,
+            weights + first,
+            outPositions + first,
+            normals ? outNormals + first : nullptr,
+            n);
+    });
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SKINNINGF_IMPL_H */
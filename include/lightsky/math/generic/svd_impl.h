@@ -0,0 +1,203 @@
+
+#ifndef LS_MATH_SVD_IMPL_H
+#define LS_MATH_SVD_IMPL_H
+
+#include <cmath> // std::sqrt, std::fabs
+#include <limits>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/generic/simd_svd_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-------------------------------------
+    Scalar arithmetic for the decomposition kernels, at any precision.
+-------------------------------------*/
+template <typename num_t>
+struct SvdScalarTraits
+{
+    typedef num_t float_t;
+    typedef bool  mask_t;
+
+    static constexpr unsigned width = 1;
+
+    static LS_INLINE float_t set1(num_t x) noexcept { return x; }
+    static LS_INLINE float_t add(float_t a, float_t b) noexcept { return a + b; }
+    static LS_INLINE float_t sub(float_t a, float_t b) noexcept { return a - b; }
+    static LS_INLINE float_t mul(float_t a, float_t b) noexcept { return a * b; }
+    static LS_INLINE float_t div(float_t a, float_t b) noexcept { return a / b; }
+    static LS_INLINE float_t sqrt(float_t x) noexcept { return std::sqrt(x); }
+    static LS_INLINE float_t max(float_t a, float_t b) noexcept { return (a > b) ? a : b; }
+    static LS_INLINE float_t abs(float_t x) noexcept { return std::fabs(x); }
+    static LS_INLINE float_t fmadd(float_t a, float_t b, float_t c) noexcept { return a * b + c; }
+
+    static LS_INLINE mask_t cmp_lt(float_t a, float_t b) noexcept { return a < b; }
+    static LS_INLINE mask_t cmp_gt(float_t a, float_t b) noexcept { return a > b; }
+    static LS_INLINE float_t select(mask_t m, float_t a, float_t b) noexcept { return m ? a : b; }
+};
+
+
+
+/*-------------------------------------
+    Copy a matrix to or from the kernels
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE void svd_copy(const mat3_t<num_t>& m, num_t (&out)[3][3]) noexcept
+{
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            out[c][r] = m.m[c].v[r];
+        }
+    }
+}
+
+template <typename num_t>
+inline LS_INLINE void svd_copy(const num_t (&m)[3][3], mat3_t<num_t>& out) noexcept
+{
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            out.m[c].v[r] = m[c][r];
+        }
+    }
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    svd
+-------------------------------------*/
+template <typename num_t>
+inline void svd(
+    const mat3_t<num_t>& a,
+    mat3_t<num_t>& outU,
+    vec3_t<num_t>& outS,
+    mat3_t<num_t>& outV,
+    unsigned numSweeps) noexcept
+{
+    num_t m[3][3], u[3][3], s[3], v[3][3];
+
+    impl::svd_copy(a, m);
+    impl::simd_svd3<impl::SvdScalarTraits<num_t>>(m, u, s, v, numSweeps, std::numeric_limits<num_t>::epsilon());
+    impl::svd_copy(u, outU);
+    impl::svd_copy(v, outV);
+    outS = vec3_t<num_t>{s[0], s[1], s[2]};
+}
+
+
+
+/*-------------------------------------
+    polar_decompose
+-------------------------------------*/
+template <typename num_t>
+inline void polar_decompose(
+    const mat3_t<num_t>& a,
+    mat3_t<num_t>& outR,
+    mat3_t<num_t>& outP,
+    unsigned numSweeps) noexcept
+{
+    num_t m[3][3], r[3][3], p[3][3];
+
+    impl::svd_copy(a, m);
+    impl::simd_polar3<impl::SvdScalarTraits<num_t>>(m, r, p, numSweeps, std::numeric_limits<num_t>::epsilon());
+    impl::svd_copy(r, outR);
+    impl::svd_copy(p, outP);
+}
+
+
+
+/*-------------------------------------
+    eigen_symmetric
+-------------------------------------*/
+template <typename num_t>
+inline void eigen_symmetric(
+    const mat3_t<num_t>& a,
+    vec3_t<num_t>& outValues,
+    mat3_t<num_t>& outVectors,
+    unsigned numSweeps) noexcept
+{
+    num_t m[3][3], d[3], v[3][3];
+
+    impl::svd_copy(a, m);
+    impl::simd_eigen3<impl::SvdScalarTraits<num_t>>(m, d, v, numSweeps, std::numeric_limits<num_t>::epsilon());
+    impl::svd_copy(v, outVectors);
+    outValues = vec3_t<num_t>{d[0], d[1], d[2]};
+}
+
+
+
+/*-------------------------------------
+    svd_batch
+-------------------------------------*/
+template <typename num_t>
+void svd_batch(
+    const mat3_t<num_t>* a,
+    mat3_t<num_t>* outU,
+    vec3_t<num_t>* outS,
+    mat3_t<num_t>* outV,
+    std::size_t count,
+    unsigned numSweeps) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        svd(a[i], outU[i], outS[i], outV[i], numSweeps);
+    }
+}
+
+
+
+/*-------------------------------------
+    polar_decompose_batch
+-------------------------------------*/
+template <typename num_t>
+void polar_decompose_batch(
+    const mat3_t<num_t>* a,
+    mat3_t<num_t>* outR,
+    mat3_t<num_t>* outP,
+    std::size_t count,
+    unsigned numSweeps) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        polar_decompose(a[i], outR[i], outP[i], numSweeps);
+    }
+}
+
+
+
+
+/*-------------------------------------
+    eigen_symmetric_batch
+-------------------------------------*/
+template <typename num_t>
+void eigen_symmetric_batch(
+    const mat3_t<num_t>* a,
+    vec3_t<num_t>* outValues,
+    mat3_t<num_t>* outVectors,
+    std::size_t count,
+    unsigned numSweeps) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        eigen_symmetric(a[i], outValues[i], outVectors[i], numSweeps);
+    }
+}
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SVD_IMPL_H */
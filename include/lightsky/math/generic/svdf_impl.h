@@ -0,0 +1,66 @@
+
+#ifndef LS_MATH_SVDF_IMPL_H
+#define LS_MATH_SVDF_IMPL_H
+
+#include "lightsky/math/generic/simd_svd_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    3x3 Singular Value, Polar, & Symmetric Eigen Decompositions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    svd_batch
+-------------------------------------*/
+inline void svd_batch(
+    const mat3_t<float>* a,
+    mat3_t<float>* outU,
+    vec3_t<float>* outS,
+    mat3_t<float>* outV,
+    std::size_t count,
+    unsigned numSweeps = SvdSweeps<float>::value) noexcept
+{
+    impl::simd_svd_batch<impl::BatchTraits>(a, outU, outS, outV, count, numSweeps);
+}
+
+
+
+/*-------------------------------------
+    polar_decompose_batch
+-------------------------------------*/
+inline void polar_decompose_batch(
+    const mat3_t<float>* a,
+    mat3_t<float>* outR,
+    mat3_t<float>* outP,
+    std::size_t count,
+    unsigned numSweeps = SvdSweeps<float>::value) noexcept
+{
+    impl::simd_polar_batch<impl::BatchTraits>(a, outR, outP, count, numSweeps);
+}
+
+
+
+
+/*-------------------------------------
+    eigen_symmetric_batch
+-------------------------------------*/
+inline void eigen_symmetric_batch(
+    const mat3_t<float>* a,
+    vec3_t<float>* outValues,
+    mat3_t<float>* outVectors,
+    std::size_t count,
+    unsigned numSweeps = SvdSweeps<float>::value) noexcept
+{
+    impl::simd_eigen_batch<impl::BatchTraits>(a, outValues, outVectors, count, numSweeps);
+}
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SVDF_IMPL_H */
@@ -0,0 +1,333 @@
+
+#ifndef LS_MATH_VEC3A_IMPL_H
+#define LS_MATH_VEC3A_IMPL_H
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+// Main Constructor
+template <typename num_t>
+constexpr LS_INLINE vec3a_t<num_t>::vec3a_t(num_t inX, num_t inY, num_t inZ) :
+    v{inX, inY, inZ, num_t(0)}
+{
+}
+
+template <typename num_t>
+constexpr LS_INLINE vec3a_t<num_t>::vec3a_t(num_t n) :
+    v{n, n, n, num_t(0)}
+{
+}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template <typename num_t>
+template <typename other_t>
+constexpr LS_INLINE vec3a_t<num_t>::operator vec3a_t<other_t>() const {
+    return vec3a_t<other_t>{(other_t) v[0], (other_t) v[1], (other_t) v[2]};
+}
+
+template <typename num_t>
+constexpr LS_INLINE const num_t* vec3a_t<num_t>::operator&() const {
+    return v;
+}
+
+template <typename num_t>
+inline LS_INLINE num_t* vec3a_t<num_t>::operator&() {
+    return v;
+}
+
+/*-------------------------------------
+    Subscripting Operators
+-------------------------------------*/
+template <typename num_t>
+template <typename index_t>
+constexpr LS_INLINE num_t vec3a_t<num_t>::operator[](index_t i) const {
+    return v[i];
+}
+
+template <typename num_t>
+template <typename index_t>
+inline LS_INLINE num_t& vec3a_t<num_t>::operator[](index_t i) {
+    return v[i];
+}
+
+/*-------------------------------------
+    Vector-Vector Math Operations
+
+    Only the first three elements are operated on. Leaving the padding alone
+    keeps integral division from trapping on an uninitialized element.
+-------------------------------------*/
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator+(const vec3a_t<num_t>& input) const {
+    return vec3a_t<num_t>{
+        v[0] + input.v[0],
+        v[1] + input.v[1],
+        v[2] + input.v[2]
+    };
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator-(const vec3a_t<num_t>& input) const {
+    return vec3a_t<num_t>{
+        v[0] - input.v[0],
+        v[1] - input.v[1],
+        v[2] - input.v[2]
+    };
+}
+
+//for operations like "vectA = -vectB"
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator-() const {
+    return vec3a_t<num_t>{-v[0], -v[1], -v[2]};
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator*(const vec3a_t<num_t>& input) const {
+    return vec3a_t<num_t>{
+        v[0] * input.v[0],
+        v[1] * input.v[1],
+        v[2] * input.v[2]
+    };
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator/(const vec3a_t<num_t>& input) const {
+    return vec3a_t<num_t>{
+        v[0] / input.v[0],
+        v[1] / input.v[1],
+        v[2] / input.v[2]
+    };
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator+=(const vec3a_t<num_t>& input) {
+    v[0] += input.v[0];
+    v[1] += input.v[1];
+    v[2] += input.v[2];
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator-=(const vec3a_t<num_t>& input) {
+    v[0] -= input.v[0];
+    v[1] -= input.v[1];
+    v[2] -= input.v[2];
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator*=(const vec3a_t<num_t>& input) {
+    v[0] *= input.v[0];
+    v[1] *= input.v[1];
+    v[2] *= input.v[2];
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator/=(const vec3a_t<num_t>& input) {
+    v[0] /= input.v[0];
+    v[1] /= input.v[1];
+    v[2] /= input.v[2];
+    return *this;
+}
+
+// prefix operations
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator++() {
+    ++v[0];
+    ++v[1];
+    ++v[2];
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator--() {
+    --v[0];
+    --v[1];
+    --v[2];
+    return *this;
+}
+
+//postfix operations
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator++(int) {
+    const vec3a_t<num_t> ret = *this;
+    ++v[0];
+    ++v[1];
+    ++v[2];
+    return ret;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator--(int) {
+    const vec3a_t<num_t> ret = *this;
+    --v[0];
+    --v[1];
+    --v[2];
+    return ret;
+}
+
+//comparisons
+
+template <typename num_t> constexpr LS_INLINE
+bool vec3a_t<num_t>::operator==(const vec3a_t<num_t>& compare) const {
+    return
+    v[0] == compare.v[0] &&
+    v[1] == compare.v[1] &&
+    v[2] == compare.v[2];
+}
+
+template <typename num_t> constexpr LS_INLINE
+bool vec3a_t<num_t>::operator!=(const vec3a_t<num_t>& compare) const {
+    return
+    v[0] != compare.v[0] ||
+    v[1] != compare.v[1] ||
+    v[2] != compare.v[2];
+}
+
+template <typename num_t> constexpr LS_INLINE
+bool vec3a_t<num_t>::operator<(const vec3a_t<num_t>& compare) const {
+    return
+    v[0] < compare.v[0] &&
+    v[1] < compare.v[1] &&
+    v[2] < compare.v[2];
+}
+
+template <typename num_t> constexpr LS_INLINE
+bool vec3a_t<num_t>::operator>(const vec3a_t<num_t>& compare) const {
+    return
+    v[0] > compare.v[0] &&
+    v[1] > compare.v[1] &&
+    v[2] > compare.v[2];
+}
+
+template <typename num_t> constexpr LS_INLINE
+bool vec3a_t<num_t>::operator<=(const vec3a_t<num_t>& compare) const {
+    return
+    v[0] <= compare.v[0] &&
+    v[1] <= compare.v[1] &&
+    v[2] <= compare.v[2];
+}
+
+template <typename num_t> constexpr LS_INLINE
+bool vec3a_t<num_t>::operator>=(const vec3a_t<num_t>& compare) const {
+    return
+    v[0] >= compare.v[0] &&
+    v[1] >= compare.v[1] &&
+    v[2] >= compare.v[2];
+}
+
+/*-------------------------------------
+    Vector-Scalar Math Operations
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator=(num_t input) {
+    v[0] = input;
+    v[1] = input;
+    v[2] = input;
+    return *this;
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator+(num_t input) const {
+    return vec3a_t<num_t>{
+        (num_t)(v[0] + input),
+        (num_t)(v[1] + input),
+        (num_t)(v[2] + input)
+    };
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator-(num_t input) const {
+    return vec3a_t<num_t>{
+        (num_t)(v[0] - input),
+        (num_t)(v[1] - input),
+        (num_t)(v[2] - input)
+    };
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator*(num_t input) const {
+    return vec3a_t<num_t>{
+        (num_t)(v[0] * input),
+        (num_t)(v[1] * input),
+        (num_t)(v[2] * input)
+    };
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> vec3a_t<num_t>::operator/(num_t input) const {
+    return vec3a_t<num_t>{
+        (num_t)(v[0] / input),
+        (num_t)(v[1] / input),
+        (num_t)(v[2] / input)
+    };
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator+=(num_t input) {
+    v[0] += input;
+    v[1] += input;
+    v[2] += input;
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator-=(num_t input) {
+    v[0] -= input;
+    v[1] -= input;
+    v[2] -= input;
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator*=(num_t input) {
+    v[0] *= input;
+    v[1] *= input;
+    v[2] *= input;
+    return *this;
+}
+
+template <typename num_t> inline LS_INLINE
+vec3a_t<num_t>& vec3a_t<num_t>::operator/=(num_t input) {
+    v[0] /= input;
+    v[1] /= input;
+    v[2] /= input;
+    return *this;
+}
+
+/*-------------------------------------
+    Non-Member Vector-Scalar operations
+-------------------------------------*/
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> operator+(num_t n, const vec3a_t<num_t>& v) {
+    return v + n;
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> operator-(num_t n, const vec3a_t<num_t>& v) {
+    return vec3a_t<num_t>{
+        (num_t)(n - v.v[0]),
+        (num_t)(n - v.v[1]),
+        (num_t)(n - v.v[2])
+    };
+}
+
+template <typename num_t> constexpr LS_INLINE
+vec3a_t<num_t> operator*(num_t n, const vec3a_t<num_t>& v) {
+    return v * n;
+}
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_VEC3A_IMPL_H */
@@ -1410,6 +1410,567 @@ constexpr LS_INLINE math::vec4_t<num_t> math::fmsub(const vec4_t <num_t>& x, con
     return (x * m) - a;
 }
 
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE math::vec4_t<num_t> math::sin(const vec4_t<num_t>& x) noexcept
+{
+    return math::vec4_t<num_t>{
+        ls::math::sin(x.v[0]),
+        ls::math::sin(x.v[1]),
+        ls::math::sin(x.v[2]),
+        ls::math::sin(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE math::vec4_t<num_t> math::cos(const vec4_t<num_t>& x) noexcept
+{
+    return math::vec4_t<num_t>{
+        ls::math::cos(x.v[0]),
+        ls::math::cos(x.v[1]),
+        ls::math::cos(x.v[2]),
+        ls::math::cos(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    4D sincos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE void math::sincos(const vec4_t<num_t>& x, vec4_t<num_t>& outSin, vec4_t<num_t>& outCos) noexcept
+{
+    outSin = math::sin(x);
+    outCos = math::cos(x);
+}
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE math::vec4_t<num_t> math::tan(const vec4_t<num_t>& x) noexcept
+{
+    return math::vec4_t<num_t>{
+        ls::math::tan(x.v[0]),
+        ls::math::tan(x.v[1]),
+        ls::math::tan(x.v[2]),
+        ls::math::tan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE math::vec4_t<num_t> math::atan(const vec4_t<num_t>& x) noexcept
+{
+    return math::vec4_t<num_t>{
+        ls::math::atan(x.v[0]),
+        ls::math::atan(x.v[1]),
+        ls::math::atan(x.v[2]),
+        ls::math::atan(x.v[3])
+    };
+}
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE math::vec4_t<num_t> math::atan2(const vec4_t<num_t>& y, const vec4_t<num_t>& x) noexcept
+{
+    return math::vec4_t<num_t>{
+        ls::math::atan2(y.v[0], x.v[0]),
+        ls::math::atan2(y.v[1], x.v[1]),
+        ls::math::atan2(y.v[2], x.v[2]),
+        ls::math::atan2(y.v[3], x.v[3])
+    };
+}
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE math::vec4_t<num_t> math::asin(const vec4_t<num_t>& x) noexcept
+{
+    return math::vec4_t<num_t>{
+        ls::math::asin(x.v[0]),
+        ls::math::asin(x[1]),
+        ls::math::asin(x[2]),
+        ls::math::asin(x[3])
+    };
+}
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+template <typename num_t>
+inline LS_INLINE math::vec4_t<num_t> math::acos(const vec4_t<num_t>& x) noexcept
+{
+    return math::vec4_t<num_t>{
+        ls::math::acos(x[0]),
+        ls::math::acos(x[1]),
+        ls::math::acos(x[2]),
+        ls::math::acos(x[3])
+    };
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    3D Aligned Vectors
+
+    Element-wise functions defer to their packed 3D counterparts.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Aligned 3D Sum
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+num_t math::sum(const vec3a_t<num_t>& v) noexcept
+{
+    return v.v[0] + v.v[1] + v.v[2];
+}
+
+/*-------------------------------------
+    Aligned 3D Reciprocal Sum
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+num_t math::sum_inv(const vec3a_t<num_t>& v) noexcept
+{
+    return math::rcp<num_t>(v.v[0] + v.v[1] + v.v[2]);
+}
+
+/*-------------------------------------
+    Aligned 3D Dot
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+num_t math::dot(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2) noexcept
+{
+    return (v1.v[0] * v2.v[0]) + (v1.v[1] * v2.v[1]) + (v1.v[2] * v2.v[2]);
+}
+
+/*-------------------------------------
+    Aligned 3D Cross
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::cross(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2) noexcept
+{
+    return math::vec3a_t<num_t>{
+        (v1.v[1] * v2.v[2]) - (v1.v[2] * v2.v[1]),
+        (v1.v[2] * v2.v[0]) - (v1.v[0] * v2.v[2]),
+        (v1.v[0] * v2.v[1]) - (v1.v[1] * v2.v[0])
+    };
+}
+
+/*-------------------------------------
+    Aligned 3D Normalize
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::normalize(const vec3a_t<num_t>& v) noexcept
+{
+    return v / (num_t)std::sqrt(math::dot<num_t>(v, v));
+}
+
+/*-------------------------------------
+    Aligned 3D Magnitude (squared)
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+num_t math::length_squared(const vec3a_t<num_t>& v) noexcept
+{
+    return math::dot<num_t>(v, v);
+}
+
+/*-------------------------------------
+    Aligned 3D Magnitude
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+num_t math::length(const vec3a_t<num_t>& v) noexcept
+{
+    return (num_t)std::sqrt(math::dot<num_t>(v, v));
+}
+
+/*-------------------------------------
+    Aligned 3D Angle
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+num_t math::angle_between(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2) noexcept
+{
+    return (num_t)math::acos(
+        math::dot<num_t>(v1, v2) / (math::length<num_t>(v1) * math::length<num_t>(v2))
+    );
+}
+
+/*-------------------------------------
+    Aligned 3D Angle (with origin)
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+num_t math::angle_between(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2, const vec3a_t<num_t>& origin) noexcept
+{
+    return (num_t)math::acos(
+        math::dot<num_t>(v1 - origin, v2 - origin) / (math::length<num_t>(v1) * math::length<num_t>(v2))
+    );
+}
+
+/*-------------------------------------
+    Aligned 3D Min
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::min(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2) noexcept
+{
+    return math::vec3a_cast(math::min(math::vec3_cast(v1), math::vec3_cast(v2)));
+}
+
+/*-------------------------------------
+    Aligned 3D Mix
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::mix(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2, num_t percent) noexcept
+{
+    return v1 + ((v2 - v1) * percent);
+}
+
+/*-------------------------------------
+    Aligned 3D Max
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::max(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2) noexcept
+{
+    return math::vec3a_cast(math::max(math::vec3_cast(v1), math::vec3_cast(v2)));
+}
+
+/*-------------------------------------
+    Aligned 3D Clamp
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::clamp(const vec3a_t<num_t>& v, const vec3a_t<num_t>& minVals, const vec3a_t<num_t>& maxVals) noexcept
+{
+    return math::vec3a_cast(math::clamp(math::vec3_cast(v), math::vec3_cast(minVals), math::vec3_cast(maxVals)));
+}
+
+/*-------------------------------------
+    Aligned 3D Saturate
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::saturate(const vec3a_t<num_t>& v) noexcept
+{
+    return math::vec3a_cast(math::saturate(math::vec3_cast(v)));
+}
+
+/*-------------------------------------
+    Aligned 3D Projection
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::project(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2) noexcept
+{
+    const num_t v1Len = math::length(v1);
+    const num_t v2Len = math::length(v2);
+
+    const math::vec3a_t<num_t>&& v1Norm = v1 / v1Len;
+    const math::vec3a_t<num_t>&& v2Norm = v2 / v2Len;
+
+    const num_t cosTheta = math::dot(v1Norm, v2Norm);
+
+    return v2Norm * (cosTheta * v1Len);
+}
+
+/*-------------------------------------
+    Aligned 3D Reflect
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::reflect(const vec3a_t<num_t>& v, const vec3a_t<num_t>& norm) noexcept
+{
+    return v - norm * (num_t{2} * math::dot(v, norm));
+}
+
+/*-------------------------------------
+    Aligned 3D Mid
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::mid(const vec3a_t<num_t>& v1, const vec3a_t<num_t>& v2) noexcept
+{
+    return std::is_integral<num_t>::value
+           ? ((v1 + v2) / num_t{2})
+           : ((v1 + v2) * num_t{0.5});
+}
+
+/*-------------------------------------
+    Aligned 3D Step
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::step(const vec3a_t<num_t>& edge, const vec3a_t<num_t>& v) noexcept
+{
+    return math::vec3a_cast(math::step(math::vec3_cast(edge), math::vec3_cast(v)));
+}
+
+/*-------------------------------------
+    Aligned 3D Smoothstep
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::smoothstep(const vec3a_t<num_t>& a, const vec3a_t<num_t>& b, const vec3a_t<num_t>& x) noexcept
+{
+    return math::vec3a_cast(math::smoothstep(math::vec3_cast(a), math::vec3_cast(b), math::vec3_cast(x)));
+}
+
+/*-------------------------------------
+    Aligned 3D Reciprocal
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::rcp(const vec3a_t<num_t>& v) noexcept
+{
+    return math::vec3a_cast(math::rcp(math::vec3_cast(v)));
+}
+
+/*-------------------------------------
+    Aligned 3D Sign Bits
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+int math::sign_mask(const vec3a_t<num_t>& x) noexcept
+{
+    return math::sign_mask(math::vec3_cast(x));
+}
+
+/*-------------------------------------
+    Aligned 3D Sign
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::sign(const vec3a_t<num_t>& x) noexcept
+{
+    return math::vec3a_cast(math::sign(math::vec3_cast(x)));
+}
+
+/*-------------------------------------
+    Aligned 3D Copysign
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::copysign(const vec3a_t<num_t>& n, const vec3a_t<num_t>& s) noexcept
+{
+    return math::vec3a_cast(math::copysign(math::vec3_cast(n), math::vec3_cast(s)));
+}
+
+/*-------------------------------------
+    Aligned 3D Floor
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::floor(const vec3a_t<num_t>& v) noexcept
+{
+    return math::vec3a_cast(math::floor(math::vec3_cast(v)));
+}
+
+/*-------------------------------------
+    Aligned 3D Ceil
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::ceil(const vec3a_t<num_t>& v) noexcept
+{
+    return math::vec3a_cast(math::ceil(math::vec3_cast(v)));
+}
+
+/*-------------------------------------
+    Aligned 3D Round
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::round(const vec3a_t<num_t>& v) noexcept
+{
+    return math::vec3a_cast(math::round(math::vec3_cast(v)));
+}
+
+/*-------------------------------------
+    Aligned 3D Absolute Value
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::abs(const vec3a_t<num_t>& v) noexcept
+{
+    return math::vec3a_cast(math::abs(math::vec3_cast(v)));
+}
+
+/*-------------------------------------
+    Aligned 3D Log2
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::log2(const vec3a_t<num_t>& n) noexcept
+{
+    return math::vec3a_cast(math::log2(math::vec3_cast(n)));
+}
+
+/*-------------------------------------
+    Aligned 3D Log
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::log(const vec3a_t<num_t>& n) noexcept
+{
+    return math::vec3a_cast(math::log(math::vec3_cast(n)));
+}
+
+/*-------------------------------------
+    Aligned 3D Log10
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::log10(const vec3a_t<num_t>& n) noexcept
+{
+    return math::vec3a_cast(math::log10(math::vec3_cast(n)));
+}
+
+/*-------------------------------------
+    Aligned 3D LogN
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::logN(const vec3a_t<num_t>& baseN, const vec3a_t<num_t>& n) noexcept
+{
+    return math::vec3a_cast(math::logN(math::vec3_cast(baseN), math::vec3_cast(n)));
+}
+
+/*-------------------------------------
+    Aligned 3D Pow
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::pow(const vec3a_t<num_t>& x, const vec3a_t<num_t>& y) noexcept
+{
+    return math::vec3a_cast(math::pow(math::vec3_cast(x), math::vec3_cast(y)));
+}
+
+/*-------------------------------------
+    Aligned 3D Exp
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::exp(const vec3a_t<num_t>& x) noexcept
+{
+    return math::vec3a_cast(math::exp(math::vec3_cast(x)));
+}
+
+/*-------------------------------------
+    Aligned 3D Exp2
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::exp2(const vec3a_t<num_t>& x) noexcept
+{
+    return math::vec3a_cast(math::exp2(math::vec3_cast(x)));
+}
+
+/*-------------------------------------
+    Aligned 3D FMA
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::fmadd(const vec3a_t<num_t>& x, const vec3a_t<num_t>& m, const vec3a_t<num_t>& a) noexcept
+{
+    return math::vec3a_cast(math::fmadd(math::vec3_cast(x), math::vec3_cast(m), math::vec3_cast(a)));
+}
+
+/*-------------------------------------
+    Aligned 3D FMS
+-------------------------------------*/
+template <typename num_t> inline LS_INLINE
+math::vec3a_t<num_t> math::fmsub(const vec3a_t<num_t>& x, const vec3a_t<num_t>& m, const vec3a_t<num_t>& a) noexcept
+{
+    return math::vec3a_cast(math::fmsub(math::vec3_cast(x), math::vec3_cast(m), math::vec3_cast(a)));
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    N-Dimensional Vectors
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    N-D Sum
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+num_t math::sum(const vecN_t<D, num_t>& v) noexcept
+{
+    return math::impl::vecn_sum_unrolled(v, std::make_integer_sequence<unsigned, D>{});
+}
+
+/*-------------------------------------
+    N-D Dot
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+num_t math::dot(const vecN_t<D, num_t>& v1, const vecN_t<D, num_t>& v2) noexcept
+{
+    return math::impl::vecn_dot(v1, v2);
+}
+
+/*-------------------------------------
+    N-D Normalize
+-------------------------------------*/
+template <unsigned D, typename num_t> inline LS_INLINE
+math::vecN_t<D, num_t> math::normalize(const vecN_t<D, num_t>& v) noexcept
+{
+    return v / std::sqrt(math::impl::vecn_dot(v, v));
+}
+
+/*-------------------------------------
+    N-D Length Squared
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+num_t math::length_squared(const vecN_t<D, num_t>& v) noexcept
+{
+    return math::impl::vecn_dot(v, v);
+}
+
+/*-------------------------------------
+    N-D Length
+-------------------------------------*/
+template <unsigned D, typename num_t> inline LS_INLINE
+num_t math::length(const vecN_t<D, num_t>& v) noexcept
+{
+    return std::sqrt(math::impl::vecn_dot(v, v));
+}
+
+/*-------------------------------------
+    N-D Min
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+math::vecN_t<D, num_t> math::min(const vecN_t<D, num_t>& v1, const vecN_t<D, num_t>& v2) noexcept
+{
+    return math::impl::vecn_map<math::impl::VecNMin>(v1, v2);
+}
+
+/*-------------------------------------
+    N-D Max
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+math::vecN_t<D, num_t> math::max(const vecN_t<D, num_t>& v1, const vecN_t<D, num_t>& v2) noexcept
+{
+    return math::impl::vecn_map<math::impl::VecNMax>(v1, v2);
+}
+
+/*-------------------------------------
+    N-D Mix
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+math::vecN_t<D, num_t> math::mix(const vecN_t<D, num_t>& v1, const vecN_t<D, num_t>& v2, num_t percent) noexcept
+{
+    return math::impl::vecn_fmadd(v2 - v1, vecN_t<D, num_t>{percent}, v1);
+}
+
+/*-------------------------------------
+    N-D Clamp
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+math::vecN_t<D, num_t> math::clamp(const vecN_t<D, num_t>& v, const vecN_t<D, num_t>& minVals, const vecN_t<D, num_t>& maxVals) noexcept
+{
+    return math::min(math::max(v, minVals), maxVals);
+}
+
+/*-------------------------------------
+    N-D FMA
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+math::vecN_t<D, num_t> math::fmadd(const vecN_t<D, num_t>& x, const vecN_t<D, num_t>& m, const vecN_t<D, num_t>& a) noexcept
+{
+    return math::impl::vecn_fmadd(x, m, a);
+}
+
+/*-------------------------------------
+    N-D FMS
+-------------------------------------*/
+template <unsigned D, typename num_t> constexpr LS_INLINE
+math::vecN_t<D, num_t> math::fmsub(const vecN_t<D, num_t>& x, const vecN_t<D, num_t>& m, const vecN_t<D, num_t>& a) noexcept
+{
+    return math::impl::vecn_fmadd(x, m, -a);
+}
+
 
 
 /*-----------------------------------------------------------------------------
@@ -1470,6 +2031,39 @@ constexpr math::vec3_t<N> math::vec3_cast(const math::vec4_t<N>& v) noexcept
 
 
 
+/*-------------------------------------
+    3D Vector from Aligned 3D
+-------------------------------------*/
+template <typename N>
+inline LS_INLINE math::vec3_t<N> math::vec3_cast(const math::vec3a_t<N>& v) noexcept
+{
+    return math::vec3_t<N>{v.v[0], v.v[1], v.v[2]};
+}
+
+
+
+/*-------------------------------------
+    Aligned 3D Vector from 3D
+-------------------------------------*/
+template <typename N>
+inline LS_INLINE math::vec3a_t<N> math::vec3a_cast(const math::vec3_t<N>& v) noexcept
+{
+    return math::vec3a_t<N>{v.v[0], v.v[1], v.v[2]};
+}
+
+
+
+/*-------------------------------------
+    Aligned 3D Vector from 4D
+-------------------------------------*/
+template <typename N>
+inline LS_INLINE math::vec3a_t<N> math::vec3a_cast(const math::vec4_t<N>& v) noexcept
+{
+    return math::vec3a_t<N>{v.v[0], v.v[1], v.v[2]};
+}
+
+
+
 /*-------------------------------------
     4D Vector from 2D & Scalars
 -------------------------------------*/
@@ -1533,6 +2127,17 @@ constexpr math::vec4_t<N> math::vec4_cast(const N& s, const math::vec3_t<N>& v)
 {
     return math::vec4_t<N>{s, v.v[0], v.v[1], v.v[2]};
 }
+
+
+
+/*-------------------------------------
+    4D Vector from Aligned 3D & Scalar
+-------------------------------------*/
+template <typename N>
+inline LS_INLINE math::vec4_t<N> math::vec4_cast(const math::vec3a_t<N>& v, const N& s) noexcept
+{
+    return math::vec4_t<N>{v.v[0], v.v[1], v.v[2], s};
+}
 } // end ls namespace
 
 #endif /* LS_MATH_VEC_UTILS_IMPL_H */
@@ -0,0 +1,414 @@
+
+#ifndef LS_MATH_VECN_IMPL_H
+#define LS_MATH_VECN_IMPL_H
+
+#include <type_traits> // std::is_constant_evaluated
+#include <utility> // std::integer_sequence
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+namespace impl {
+
+
+
+/*-----------------------------------------------------------------------------
+    N-Dimensional Vector Kernels
+
+    Each operation is unrolled using a pack of component indices. Platforms
+    which can hold a type in SIMD registers specialize "VecNSimd" for that
+    type, which replaces the unrolled operations at run-time. Constant
+    expressions always use the unrolled operations.
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Element-wise operations, in both scalar and register forms
+-------------------------------------*/
+struct VecNAdd
+{
+    template <typename num_t>
+    static constexpr LS_INLINE num_t eval(num_t a, num_t b) noexcept { return a + b; }
+
+    template <typename traits_t>
+    static LS_INLINE typename traits_t::float_t simd(typename traits_t::float_t a, typename traits_t::float_t b) noexcept { return traits_t::add(a, b); }
+};
+
+struct VecNSub
+{
+    template <typename num_t>
+    static constexpr LS_INLINE num_t eval(num_t a, num_t b) noexcept { return a - b; }
+
+    template <typename traits_t>
+    static LS_INLINE typename traits_t::float_t simd(typename traits_t::float_t a, typename traits_t::float_t b) noexcept { return traits_t::sub(a, b); }
+};
+
+struct VecNMul
+{
+    template <typename num_t>
+    static constexpr LS_INLINE num_t eval(num_t a, num_t b) noexcept { return a * b; }
+
+    template <typename traits_t>
+    static LS_INLINE typename traits_t::float_t simd(typename traits_t::float_t a, typename traits_t::float_t b) noexcept { return traits_t::mul(a, b); }
+};
+
+struct VecNDiv
+{
+    template <typename num_t>
+    static constexpr LS_INLINE num_t eval(num_t a, num_t b) noexcept { return a / b; }
+
+    template <typename traits_t>
+    static LS_INLINE typename traits_t::float_t simd(typename traits_t::float_t a, typename traits_t::float_t b) noexcept { return traits_t::div(a, b); }
+};
+
+struct VecNMin
+{
+    template <typename num_t>
+    static constexpr LS_INLINE num_t eval(num_t a, num_t b) noexcept { return (a < b) ? a : b; }
+
+    template <typename traits_t>
+    static LS_INLINE typename traits_t::float_t simd(typename traits_t::float_t a, typename traits_t::float_t b) noexcept { return traits_t::min(a, b); }
+};
+
+struct VecNMax
+{
+    template <typename num_t>
+    static constexpr LS_INLINE num_t eval(num_t a, num_t b) noexcept { return (a > b) ? a : b; }
+
+    template <typename traits_t>
+    static LS_INLINE typename traits_t::float_t simd(typename traits_t::float_t a, typename traits_t::float_t b) noexcept { return traits_t::max(a, b); }
+};
+
+
+
+/*-------------------------------------
+    SIMD kernels for a type. Unspecialized types always use the unrolled
+    operations.
+-------------------------------------*/
+template <typename num_t>
+struct VecNSimd
+{
+    static constexpr bool value = false;
+};
+
+
+
+/*-------------------------------------
+    Unrolled operations
+-------------------------------------*/
+template <typename op_t, unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE vecN_t<N, num_t> vecn_map_unrolled(const vecN_t<N, num_t>& a, const vecN_t<N, num_t>& b, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return vecN_t<N, num_t>{op_t::eval(a.v[i], b.v[i])...};
+}
+
+template <typename op_t, unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE vecN_t<N, num_t> vecn_map_scalar_unrolled(const vecN_t<N, num_t>& a, num_t b, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return vecN_t<N, num_t>{op_t::eval(a.v[i], b)...};
+}
+
+template <unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE vecN_t<N, num_t> vecn_fmadd_unrolled(const vecN_t<N, num_t>& x, const vecN_t<N, num_t>& m, const vecN_t<N, num_t>& a, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return vecN_t<N, num_t>{(x.v[i] * m.v[i] + a.v[i])...};
+}
+
+template <unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE num_t vecn_dot_unrolled(const vecN_t<N, num_t>& a, const vecN_t<N, num_t>& b, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return (... + (a.v[i] * b.v[i]));
+}
+
+template <unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE num_t vecn_sum_unrolled(const vecN_t<N, num_t>& a, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return (... + a.v[i]);
+}
+
+template <unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE vecN_t<N, num_t> vecn_negate_unrolled(const vecN_t<N, num_t>& a, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return vecN_t<N, num_t>{(-a.v[i])...};
+}
+
+template <unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE bool vecn_equal_unrolled(const vecN_t<N, num_t>& a, const vecN_t<N, num_t>& b, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return (... && (a.v[i] == b.v[i]));
+}
+
+template <typename other_t, unsigned N, typename num_t, unsigned... i>
+constexpr LS_INLINE vecN_t<N, other_t> vecn_cast_unrolled(const vecN_t<N, num_t>& a, std::integer_sequence<unsigned, i...>) noexcept
+{
+    return vecN_t<N, other_t>{((other_t)a.v[i])...};
+}
+
+
+
+/*-------------------------------------
+    Element-wise vector-vector operation
+-------------------------------------*/
+template <typename op_t, unsigned N, typename num_t>
+constexpr LS_INLINE vecN_t<N, num_t> vecn_map(const vecN_t<N, num_t>& a, const vecN_t<N, num_t>& b) noexcept
+{
+    if constexpr (VecNSimd<num_t>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            vecN_t<N, num_t> ret;
+            VecNSimd<num_t>::template map<N, op_t>(a.v, b.v, ret.v);
+            return ret;
+        }
+    }
+
+    return vecn_map_unrolled<op_t>(a, b, std::make_integer_sequence<unsigned, N>{});
+}
+
+
+
+/*-------------------------------------
+    Element-wise vector-scalar operation
+-------------------------------------*/
+template <typename op_t, unsigned N, typename num_t>
+constexpr LS_INLINE vecN_t<N, num_t> vecn_map_scalar(const vecN_t<N, num_t>& a, num_t b) noexcept
+{
+    if constexpr (VecNSimd<num_t>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            vecN_t<N, num_t> ret;
+            VecNSimd<num_t>::template map_scalar<N, op_t>(a.v, b, ret.v);
+            return ret;
+        }
+    }
+
+    return vecn_map_scalar_unrolled<op_t>(a, b, std::make_integer_sequence<unsigned, N>{});
+}
+
+
+
+/*-------------------------------------
+    Fused multiply-add
+-------------------------------------*/
+template <unsigned N, typename num_t>
+constexpr LS_INLINE vecN_t<N, num_t> vecn_fmadd(const vecN_t<N, num_t>& x, const vecN_t<N, num_t>& m, const vecN_t<N, num_t>& a) noexcept
+{
+    if constexpr (VecNSimd<num_t>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            vecN_t<N, num_t> ret;
+            VecNSimd<num_t>::template fmadd<N>(x.v, m.v, a.v, ret.v);
+            return ret;
+        }
+    }
+
+    return vecn_fmadd_unrolled(x, m, a, std::make_integer_sequence<unsigned, N>{});
+}
+
+
+
+/*-------------------------------------
+    Dot product
+-------------------------------------*/
+template <unsigned N, typename num_t>
+constexpr LS_INLINE num_t vecn_dot(const vecN_t<N, num_t>& a, const vecN_t<N, num_t>& b) noexcept
+{
+    if constexpr (VecNSimd<num_t>::value)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            return VecNSimd<num_t>::template dot<N>(a.v, b.v);
+        }
+    }
+
+    return vecn_dot_unrolled(a, b, std::make_integer_sequence<unsigned, N>{});
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+// Main Constructor
+template <unsigned N, typename num_t>
+template <typename... args_t>
+constexpr LS_INLINE vecN_t<N, num_t>::vecN_t(num_t inX, num_t inY, args_t... inRest) :
+    v{inX, inY, static_cast<num_t>(inRest)...}
+{
+    static_assert(sizeof...(args_t) + 2 == N, "An N-dimensional vector must be constructed from exactly N components.");
+}
+
+template <unsigned N, typename num_t>
+constexpr LS_INLINE vecN_t<N, num_t>::vecN_t(num_t n) :
+    vecN_t{n, std::make_integer_sequence<unsigned, N>{}}
+{
+}
+
+template <unsigned N, typename num_t>
+template <unsigned... i>
+constexpr LS_INLINE vecN_t<N, num_t>::vecN_t(num_t n, std::integer_sequence<unsigned, i...>) :
+    v{((void)i, n)...}
+{
+}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template <unsigned N, typename num_t>
+template <typename other_t>
+constexpr LS_INLINE vecN_t<N, num_t>::operator vecN_t<N, other_t>() const {
+    return impl::vecn_cast_unrolled<other_t>(*this, std::make_integer_sequence<unsigned, N>{});
+}
+
+template <unsigned N, typename num_t>
+const num_t* vecN_t<N, num_t>::operator&() const {
+    return v;
+}
+
+template <unsigned N, typename num_t>
+inline LS_INLINE num_t* vecN_t<N, num_t>::operator&() {
+    return v;
+}
+
+/*-------------------------------------
+    Subscripting Operators
+-------------------------------------*/
+template <unsigned N, typename num_t>
+template <typename index_t>
+constexpr LS_INLINE num_t vecN_t<N, num_t>::operator[](index_t i) const {
+    return v[i];
+}
+
+template <unsigned N, typename num_t>
+template <typename index_t>
+constexpr LS_INLINE num_t& vecN_t<N, num_t>::operator[](index_t i) {
+    return v[i];
+}
+
+/*-------------------------------------
+    Vector-Vector Math Operations
+-------------------------------------*/
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator+(const vecN_t<N, num_t>& input) const {
+    return impl::vecn_map<impl::VecNAdd>(*this, input);
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator-(const vecN_t<N, num_t>& input) const {
+    return impl::vecn_map<impl::VecNSub>(*this, input);
+}
+
+//for operations like "vectA = -vectB"
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator-() const {
+    return impl::vecn_negate_unrolled(*this, std::make_integer_sequence<unsigned, N>{});
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator*(const vecN_t<N, num_t>& input) const {
+    return impl::vecn_map<impl::VecNMul>(*this, input);
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator/(const vecN_t<N, num_t>& input) const {
+    return impl::vecn_map<impl::VecNDiv>(*this, input);
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator+=(const vecN_t<N, num_t>& input) {
+    return *this = *this + input;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator-=(const vecN_t<N, num_t>& input) {
+    return *this = *this - input;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator*=(const vecN_t<N, num_t>& input) {
+    return *this = *this * input;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator/=(const vecN_t<N, num_t>& input) {
+    return *this = *this / input;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+bool vecN_t<N, num_t>::operator==(const vecN_t<N, num_t>& compare) const {
+    return impl::vecn_equal_unrolled(*this, compare, std::make_integer_sequence<unsigned, N>{});
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+bool vecN_t<N, num_t>::operator!=(const vecN_t<N, num_t>& compare) const {
+    return !impl::vecn_equal_unrolled(*this, compare, std::make_integer_sequence<unsigned, N>{});
+}
+
+/*-------------------------------------
+    Vector-Scalar Math Operations
+-------------------------------------*/
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator+(num_t input) const {
+    return impl::vecn_map_scalar<impl::VecNAdd>(*this, input);
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator-(num_t input) const {
+    return impl::vecn_map_scalar<impl::VecNSub>(*this, input);
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator*(num_t input) const {
+    return impl::vecn_map_scalar<impl::VecNMul>(*this, input);
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> vecN_t<N, num_t>::operator/(num_t input) const {
+    return impl::vecn_map_scalar<impl::VecNDiv>(*this, input);
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator+=(num_t input) {
+    return *this = *this + input;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator-=(num_t input) {
+    return *this = *this - input;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator*=(num_t input) {
+    return *this = *this * input;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t>& vecN_t<N, num_t>::operator/=(num_t input) {
+    return *this = *this / input;
+}
+
+/*-------------------------------------
+    Non-Member Vector-Scalar operations
+-------------------------------------*/
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> operator+(num_t n, const vecN_t<N, num_t>& v) {
+    return v + n;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> operator-(num_t n, const vecN_t<N, num_t>& v) {
+    return vecN_t<N, num_t>{n} - v;
+}
+
+template <unsigned N, typename num_t> constexpr LS_INLINE
+vecN_t<N, num_t> operator*(num_t n, const vecN_t<N, num_t>& v) {
+    return v * n;
+}
+
+} //end math namespace
+} //end ls namespace
+
+#endif /* LS_MATH_VECN_IMPL_H */
@@ -0,0 +1,259 @@
+
+#ifndef LS_MATH_HIERARCHY_H
+#define LS_MATH_HIERARCHY_H
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <vector>
+
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/parallel.h"
+#include "lightsky/math/quat.h"
+#include "lightsky/math/quat_utils.h"
+#include "lightsky/math/vec3.h"
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Transform Hierarchies
+
+    A hierarchy is stored as a flat array of parent indices, sorted by depth
+    so every parent precedes its children. World transforms are then
+    computed with a single pass over each array, from front to back, rather
+    than by recursing through a tree of nodes. Nodes of the same depth don't
+    depend on each other and are split into chunks which are distributed
+    across threads using "parallel_for()".
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Parent index of a node without a parent.
+ */
+enum HierarchyParent : uint32_t
+{
+    HIERARCHY_ROOT = 0xFFFFFFFFu
+};
+
+
+
+/**
+ * @brief Sort the nodes of a hierarchy by depth.
+ *
+ * Nodes of the same depth keep their relative order.
+ *
+ * @param parents
+ * An array of "count" parent indices, in any order. Root nodes should use a
+ * parent index of HIERARCHY_ROOT.
+ *
+ * @param count
+ * The number of nodes in the hierarchy.
+ *
+ * @param outOrder
+ * An array of "count" elements which will contain the original index of each
+ * sorted node.
+ *
+ * @param outParents
+ * An array of "count" elements which will contain the parent of each sorted
+ * node, as an index into the sorted array.
+ *
+ * @return TRUE if the nodes were sorted, or FALSE if the hierarchy contains a
+ * cycle or an out-of-range parent index.
+ */
+bool sort_hierarchy(const uint32_t* parents, std::size_t count, uint32_t* outOrder, uint32_t* outParents) noexcept;
+
+
+
+/**
+ * @brief The parent of every node in a hierarchy, along with the range of
+ * nodes at each depth.
+ */
+class TransformHierarchy
+{
+  private:
+    /**
+     * Parent index of each node.
+     */
+    std::vector<uint32_t> parents;
+
+    /**
+     * Index of the first node at each depth, followed by the total number of
+     * nodes.
+     */
+    std::vector<uint32_t> levels;
+
+  public:
+    /**
+     * Destructor
+     */
+    ~TransformHierarchy() noexcept = default;
+
+    /**
+     * Constructor
+     * Creates an empty hierarchy.
+     */
+    TransformHierarchy() noexcept = default;
+
+    /**
+     * Copy Constructor
+     */
+    TransformHierarchy(const TransformHierarchy&) = default;
+
+    /**
+     * Move Constructor
+     */
+    TransformHierarchy(TransformHierarchy&&) noexcept = default;
+
+    /**
+     * Copy Operator
+     */
+    TransformHierarchy& operator=(const TransformHierarchy&) = default;
+
+    /**
+     * Move Operator
+     */
+    TransformHierarchy& operator=(TransformHierarchy&&) noexcept = default;
+
+    /**
+     * @brief Copy the parent indices of a hierarchy into *this, replacing
+     * any previous contents.
+     *
+     * @param parentIds
+     * An array of "count" parent indices, sorted by depth such as with
+     * sort_hierarchy(). Root nodes should use a parent index of
+     * HIERARCHY_ROOT.
+     *
+     * @param count
+     * The number of nodes in the hierarchy.
+     *
+     * @return TRUE if the hierarchy was copied, or FALSE if a node precedes
+     * its parent or nodes are not sorted by depth. *this is left empty upon
+     * failure.
+     */
+    bool init(const uint32_t* parentIds, std::size_t count) noexcept;
+
+    /**
+     * @brief Remove all nodes from *this.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Retrieve the number of nodes in *this.
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @brief Retrieve the number of distinct node depths in *this.
+     */
+    unsigned num_levels() const noexcept;
+
+    /**
+     * @brief Retrieve the range of nodes at a single depth.
+     *
+     * @param level
+     * The depth of the nodes to retrieve, less than "num_levels()".
+     *
+     * @param outFirst
+     * The index of the first node at the requested depth.
+     *
+     * @param outLast
+     * The index following the last node at the requested depth.
+     */
+    void level_range(unsigned level, std::size_t& outFirst, std::size_t& outLast) const noexcept;
+
+    /**
+     * @brief Retrieve the parent index of every node.
+     */
+    const uint32_t* parent_ids() const noexcept;
+};
+
+
+
+/**
+ * @brief Compute the world transform of every node in a hierarchy from its
+ * local translation, rotation, and scale.
+ *
+ * Each world transform is equal to the world transform of its parent
+ * multiplied by translate * rotate * scale.
+ *
+ * @param hierarchy
+ * The parent of each node.
+ *
+ * @param positions
+ * An array of "hierarchy.size()" local translations.
+ *
+ * @param rotations
+ * An array of "hierarchy.size()" local rotations. Rotations must be unit
+ * quaternions.
+ *
+ * @param scales
+ * An array of "hierarchy.size()" local scales.
+ *
+ * @param dirtyFlags
+ * NULL to update every node, or an array of "hierarchy.size()" flags. A
+ * nonzero flag indicates a node's local transform has changed since its
+ * world transform was last computed. Only flagged nodes and their
+ * descendants are updated; every other world transform is left unmodified.
+ * Upon return, every updated node is flagged so callers may, for example,
+ * upload only the modified matrices. Flags must be cleared by the caller
+ * before the next update.
+ *
+ * @param outWorld
+ * An array of "hierarchy.size()" elements which will contain the world
+ * transform of each node. This must not alias any input.
+ *
+ * @param numThreads
+ * The maximum number of threads to use. A value of 0 uses all hardware
+ * threads.
+ */
+template <typename N>
+void update_world_transforms(
+    const TransformHierarchy& hierarchy,
+    const vec3_t<N>* positions,
+    const quat_t<N>* rotations,
+    const vec3_t<N>* scales,
+    uint8_t* dirtyFlags,
+    mat4_t<N>* outWorld,
+    unsigned numThreads = 0) noexcept;
+
+/**
+ * @brief Compute the world transform of every node in a hierarchy from its
+ * local transformation matrix.
+ *
+ * Each world transform is equal to the world transform of its parent
+ * multiplied by the node's local transform.
+ *
+ * @param hierarchy
+ * The parent of each node.
+ *
+ * @param localTransforms
+ * An array of "hierarchy.size()" local transformation matrices.
+ *
+ * @param dirtyFlags
+ * NULL to update every node, or an array of "hierarchy.size()" flags which
+ * are used as described in the TRS overload of this function.
+ *
+ * @param outWorld
+ * An array of "hierarchy.size()" elements which will contain the world
+ * transform of each node. This must not alias "localTransforms".
+ *
+ * @param numThreads
+ * The maximum number of threads to use. A value of 0 uses all hardware
+ * threads.
+ */
+template <typename N>
+void update_world_transforms(
+    const TransformHierarchy& hierarchy,
+    const mat4_t<N>* localTransforms,
+    uint8_t* dirtyFlags,
+    mat4_t<N>* outWorld,
+    unsigned numThreads = 0) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/hierarchy_impl.h"
+
+#endif /* LS_MATH_HIERARCHY_H */
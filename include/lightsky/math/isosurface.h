@@ -0,0 +1,146 @@
+
+#ifndef LS_MATH_ISOSURFACE_H
+#define LS_MATH_ISOSURFACE_H
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <vector>
+
+#include "lightsky/math/vec3.h"
+
+namespace ls {
+namespace math {
+
+
+
+/**
+ * @brief Triangle mesh generated by isosurface extraction.
+ *
+ * Every vertex has a position and a unit-length normal. Triangles are
+ * indexed with counter-clockwise winding when viewed from outside of the
+ * surface (where the scalar field is greater than the iso-value).
+ */
+template <typename num_t>
+struct IsoMesh
+{
+    std::vector<vec3_t<num_t>> positions;
+    std::vector<vec3_t<num_t>> normals;
+    std::vector<uint32_t> indices;
+
+    /**
+     * Remove all vertices and indices from the mesh.
+     */
+    void clear() noexcept;
+};
+
+
+
+/**
+ * @brief Extract an isosurface from a scalar field using Surface Nets.
+ *
+ * The volume is divided into cubic chunks of cells which are sampled and
+ * meshed in parallel. Each chunk reads the scalar field only once, allowing
+ * noise or density functions to be fed directly into the mesher without an
+ * intermediate volume. A single vertex is generated for every cell which
+ * crosses the surface, therefore vertices along chunk boundaries are shared
+ * and never duplicated. Output is deterministic regardless of the number of
+ * threads used.
+ *
+ * Vertex normals are calculated from the gradient of the trilinearly
+ * interpolated field within each cell.
+ *
+ * @param outMesh
+ * The mesh which will contain the extracted surface. Any previous contents
+ * are discarded.
+ *
+ * @param field
+ * The scalar field to triangulate. This can either be a function or function
+ * object with the signature "num_t(const vec3_t<num_t>& point)", or one which
+ * fills a regular grid of samples at once with the signature
+ * "void(num_t* outValues, const vec3_t<num_t>& origin,
+ * const vec3_t<num_t>& stride, const vec3_t<unsigned>& dims)", using
+ * X-major ordering (as PerlinNoise::get_noise_grid() does). The field is
+ * called concurrently from multiple threads.
+ *
+ * @param origin
+ * The position of the minimum corner of the volume.
+ *
+ * @param cellSize
+ * The size of each cell of the volume.
+ *
+ * @param numCells
+ * The number of cells along each axis of the volume. The field is sampled
+ * at (numCells + 1) points along each axis.
+ *
+ * @param isoValue
+ * The field value which will be triangulated. Field values less than this
+ * are considered to be inside of the surface.
+ *
+ * @param chunkSize
+ * The number of cells along each axis of a chunk.
+ *
+ * @param numThreads
+ * The number of threads to use. A value of 0 uses all hardware threads.
+ */
+template <typename num_t, typename field_func_t>
+void extract_isosurface(
+    IsoMesh<num_t>& outMesh,
+    const field_func_t& field,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& cellSize,
+    const vec3_t<unsigned>& numCells,
+    num_t isoValue = num_t{0},
+    unsigned chunkSize = 32,
+    unsigned numThreads = 0) noexcept;
+
+/**
+ * @brief Extract an isosurface from a pre-computed grid of scalar values.
+ *
+ * @param outMesh
+ * The mesh which will contain the extracted surface. Any previous contents
+ * are discarded.
+ *
+ * @param grid
+ * An array of (gridDims[0] * gridDims[1] * gridDims[2]) field values in
+ * X-major order.
+ *
+ * @param gridDims
+ * The number of samples along each axis of the grid. Each dimension must be
+ * at least 2.
+ *
+ * @param origin
+ * The position of the first grid sample.
+ *
+ * @param cellSize
+ * The distance between neighboring grid samples.
+ *
+ * @param isoValue
+ * The field value which will be triangulated.
+ *
+ * @param chunkSize
+ * The number of cells along each axis of a chunk.
+ *
+ * @param numThreads
+ * The number of threads to use. A value of 0 uses all hardware threads.
+ *
+ * @see extract_isosurface()
+ */
+template <typename num_t>
+void extract_isosurface_grid(
+    IsoMesh<num_t>& outMesh,
+    const num_t* grid,
+    const vec3_t<unsigned>& gridDims,
+    const vec3_t<num_t>& origin,
+    const vec3_t<num_t>& cellSize,
+    num_t isoValue = num_t{0},
+    unsigned chunkSize = 32,
+    unsigned numThreads = 0) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/isosurface_impl.h"
+
+#endif /* LS_MATH_ISOSURFACE_H */
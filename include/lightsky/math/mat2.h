@@ -2,6 +2,8 @@
 #ifndef LS_MATH_MAT2_H
 #define LS_MATH_MAT2_H
 
+#include "lightsky/setup/Arch.h"
+
 #include "lightsky/math/fixed.h"
 #include "lightsky/math/vec2.h"
 
@@ -122,4 +124,10 @@ typedef mat2_t<float> mat2;
 
 #include "lightsky/math/generic/mat2_impl.h"
 
+#ifdef LS_ARCH_X86
+    #include "lightsky/math/x86/mat2f_impl.h"
+#elif defined(LS_ARM_NEON)
+    #include "lightsky/math/arm/mat2f_impl.h"
+#endif
+
 #endif /*LS_MATH_MAT2_H*/
@@ -2,6 +2,8 @@
 #ifndef LS_MATH_MAT3_H
 #define LS_MATH_MAT3_H
 
+#include "lightsky/setup/Arch.h"
+
 #include "lightsky/math/fixed.h"
 #include "lightsky/math/vec3.h"
 
@@ -129,4 +131,10 @@ typedef mat3_t<float> mat3;
 
 #include "lightsky/math/generic/mat3_impl.h"
 
+#ifdef LS_ARCH_X86
+    #include "lightsky/math/x86/mat3f_impl.h"
+#elif defined(LS_ARM_NEON)
+    #include "lightsky/math/arm/mat3f_impl.h"
+#endif
+
 #endif /*LS_MATH_MAT3_H*/
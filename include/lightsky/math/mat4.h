@@ -136,8 +136,10 @@ typedef mat4_t<float> mat4;
 
 #ifdef LS_ARCH_X86
     #include "lightsky/math/x86/mat4f_impl.h"
+    #include "lightsky/math/x86/mat4d_impl.h"
 #elif defined(LS_ARM_NEON)
     #include "lightsky/math/arm/mat4f_impl.h"
+    #include "lightsky/math/arm/mat4d_impl.h"
 #endif
 
 #endif /*LS_MATH_MAT4_H*/
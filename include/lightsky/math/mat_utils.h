@@ -6,6 +6,7 @@
 #include "lightsky/math/mat2.h"
 #include "lightsky/math/mat3.h"
 #include "lightsky/math/mat4.h"
+#include "lightsky/math/matmxn.h"
 
 namespace ls {
 namespace math {
@@ -655,6 +656,49 @@ mat4_t<N> look_from(const vec3_t<N>& pos, const vec3_t<N>& target, const vec3_t<
 template <typename N> inline
 mat4_t<N> billboard(const vec3_t<N>& pos, const mat4_t<N>& viewMatrix) noexcept;
 
+/*-----------------------------------------------------------------------------
+    MxN Matrices
+-----------------------------------------------------------------------------*/
+/**
+ *  @brief transpose
+ *  Flip the values of an MxN matrix around its main diagonal.
+ *
+ *  @param m
+ *  A constant reference to a matrix with R rows and C columns.
+ *
+ *  @return A matrix with C rows and R columns. 2x2, 3x3, and 4x4 results
+ *  are returned as a mat2_t, mat3_t, or mat4_t.
+ */
+template <unsigned R, unsigned C, typename N> constexpr
+mat_t<C, R, N> transpose(const matMxN_t<R, C, N>& m) noexcept;
+
+/**
+ *  @brief determinant
+ *  Retrieve the determinant of a square MxN matrix using an LU
+ *  decomposition with partial pivoting.
+ *
+ *  @param m
+ *  A constant reference to a DxD matrix.
+ *
+ *  @return A scalar of type N, which contains the determinant of a matrix.
+ */
+template <unsigned D, typename N> constexpr
+N determinant(const matMxN_t<D, D, N>& m) noexcept;
+
+/**
+ *  @brief inverse
+ *  Invert a square MxN matrix using an LU decomposition with partial
+ *  pivoting.
+ *
+ *  @param m
+ *  A constant reference to a DxD matrix. The result is undefined if the
+ *  matrix is singular.
+ *
+ *  @return The inverse of m, such that m * inverse(m) = I.
+ */
+template <unsigned D, typename N> constexpr
+matMxN_t<D, D, N> inverse(const matMxN_t<D, D, N>& m) noexcept;
+
 } // end math namespace
 } // end ls namespace
 
@@ -662,8 +706,10 @@ mat4_t<N> billboard(const vec3_t<N>& pos, const mat4_t<N>& viewMatrix) noexcept;
 
 #ifdef LS_ARCH_X86
     #include "lightsky/math/x86/matf_utils_impl.h"
+    #include "lightsky/math/x86/matd_utils_impl.h"
 #elif defined(LS_ARM_NEON)
     #include "lightsky/math/arm/matf_utils_impl.h"
+    #include "lightsky/math/arm/matd_utils_impl.h"
 #endif
 
 #endif    /* LS_MATH_MAT_UTILS_H */
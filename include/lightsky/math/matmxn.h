@@ -0,0 +1,186 @@
+
+#ifndef LS_MATH_MATMXN_H
+#define LS_MATH_MATMXN_H
+
+#include <utility> // std::integer_sequence
+
+#include "lightsky/setup/Arch.h"
+
+#include "lightsky/math/mat2.h"
+#include "lightsky/math/mat3.h"
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/vecn.h"
+
+namespace ls {
+namespace math {
+
+template <unsigned R, unsigned C, typename num_t>
+struct matMxN_t;
+
+
+
+/*-------------------------------------
+    Matrix Type Selection
+-------------------------------------*/
+namespace impl
+{
+
+template <unsigned R, unsigned C, typename num_t>
+struct MatType
+{
+    typedef matMxN_t<R, C, num_t> type;
+};
+
+template <typename num_t>
+struct MatType<2, 2, num_t>
+{
+    typedef mat2_t<num_t> type;
+};
+
+template <typename num_t>
+struct MatType<3, 3, num_t>
+{
+    typedef mat3_t<num_t> type;
+};
+
+template <typename num_t>
+struct MatType<4, 4, num_t>
+{
+    typedef mat4_t<num_t> type;
+};
+
+} // end impl namespace
+
+/**
+ *  @brief A matrix with R rows and C columns.
+ *
+ *  2x2, 3x3, and 4x4 matrices resolve to mat2_t, mat3_t, and mat4_t. All
+ *  other sizes use matMxN_t.
+ */
+template <unsigned R, unsigned C, typename num_t>
+using mat_t = typename impl::MatType<R, C, num_t>::type;
+
+
+
+/**
+ *  @brief MxN Matrix Structure
+ *
+ *  Matrices of any size, such as the 3x4 affine transformations or 6x6
+ *  spatial inertia matrices used in rigid-body dynamics. Like all other
+ *  matrices, data is stored as an array of columns. Each column is a
+ *  "vec_t<R, num_t>", so matrices with 2, 3, or 4 rows use the SIMD
+ *  specializations of the existing vector types while larger columns use
+ *  vecN_t. Every operation is unrolled at compile-time.
+ *
+ *  Prefer the "mat_t" alias over this type so square 2x2, 3x3, and 4x4
+ *  matrices keep their own specializations.
+ *
+ *  @note
+ *  Orientation is as follows:
+ *      0[0-(R-1)] = first column
+ *      1[0-(R-1)] = second column
+ *      ...
+ */
+template <unsigned R, unsigned C, typename num_t>
+struct matMxN_t
+{
+    static_assert(R > 0 && C > 0, "Matrices require at least one row and column.");
+
+    typedef num_t value_type;
+    typedef vec_t<R, num_t> col_type;
+    static constexpr unsigned num_rows() noexcept { return R; }
+    static constexpr unsigned num_cols() noexcept { return C; }
+
+    // data
+    col_type m[C];
+
+    // Main Constructor
+    template <typename... cols_t>
+    constexpr matMxN_t(const col_type& inX, const cols_t&... inRest);
+
+    // Delegated Constructors
+    constexpr matMxN_t() = default;
+    constexpr matMxN_t(num_t);
+    constexpr matMxN_t(const matMxN_t<R, C, num_t>&) = default;
+    constexpr matMxN_t(matMxN_t<R, C, num_t>&&) = default;
+
+    ~matMxN_t() = default;
+
+    // Conversions & Casting
+    template <typename other_t>
+    constexpr explicit operator matMxN_t<R, C, other_t>() const;
+
+    //Subscripting operators
+    template <typename index_t>
+    constexpr const col_type& operator[](index_t i) const;
+
+    template <typename index_t>
+    constexpr col_type& operator[](index_t i);
+
+    //matrix-matrix operators
+    constexpr matMxN_t operator+(const matMxN_t<R, C, num_t>& input) const;
+    constexpr matMxN_t operator-(const matMxN_t<R, C, num_t>& input) const;
+    constexpr matMxN_t operator-() const;
+    constexpr matMxN_t& operator=(const matMxN_t<R, C, num_t>& input) = default;
+    constexpr matMxN_t& operator=(matMxN_t<R, C, num_t>&& input) = default;
+    constexpr matMxN_t& operator+=(const matMxN_t<R, C, num_t>& input);
+    constexpr matMxN_t& operator-=(const matMxN_t<R, C, num_t>& input);
+    constexpr bool operator==(const matMxN_t<R, C, num_t>& input) const;
+    constexpr bool operator!=(const matMxN_t<R, C, num_t>& input) const;
+
+    // (RxC) * (CxK) = (RxK)
+    template <unsigned K>
+    constexpr mat_t<R, K, num_t> operator*(const matMxN_t<C, K, num_t>& input) const;
+
+    // (RxC) * (CxC) = (RxC), when the right-hand side is a mat2_t, mat3_t, or
+    // mat4_t
+    constexpr mat_t<R, C, num_t> operator*(const mat_t<C, C, num_t>& input) const;
+
+    //matrix-vector operators
+    constexpr col_type operator*(const vec_t<C, num_t>&) const;
+
+    //matrix-scalar operators
+    constexpr matMxN_t operator*(num_t) const;
+    constexpr matMxN_t operator/(num_t) const;
+    constexpr matMxN_t& operator*=(num_t);
+    constexpr matMxN_t& operator/=(num_t);
+
+  private:
+    // Places a single value along the main diagonal
+    template <unsigned... i>
+    constexpr matMxN_t(num_t n, std::integer_sequence<unsigned, i...>);
+};
+
+/*-------------------------------------
+    Non-Member Matrix-Scalar operations
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t> constexpr
+matMxN_t<R, C, num_t> operator*(num_t n, const matMxN_t<R, C, num_t>& m);
+
+/*-------------------------------------
+    Non-Member Matrix-Matrix operations, for square matrices on the
+    left-hand side
+-------------------------------------*/
+template <unsigned C, typename num_t> constexpr
+mat_t<2, C, num_t> operator*(const mat2_t<num_t>& a, const matMxN_t<2, C, num_t>& b);
+
+template <unsigned C, typename num_t> constexpr
+mat_t<3, C, num_t> operator*(const mat3_t<num_t>& a, const matMxN_t<3, C, num_t>& b);
+
+template <unsigned C, typename num_t> constexpr
+mat_t<4, C, num_t> operator*(const mat4_t<num_t>& a, const matMxN_t<4, C, num_t>& b);
+
+/*-------------------------------------
+    MxN Matrix Specializations
+-------------------------------------*/
+typedef matMxN_t<6, 6, float>  mat6f;
+typedef matMxN_t<6, 6, double> mat6d;
+
+typedef matMxN_t<6, 6, float> mat6;
+
+} //end math namespace
+} //end ls namespace
+
+#include "lightsky/math/generic/matmxn_impl.h"
+
+#endif /* LS_MATH_MATMXN_H */
@@ -8,9 +8,13 @@
 #ifndef LS_MATH_NOISE_H
 #define LS_MATH_NOISE_H
 
+#include <cstddef> // std::size_t
+
 #include "lightsky/setup/Macros.h"
 
+#include "lightsky/math/vec2.h"
 #include "lightsky/math/vec3.h"
+#include "lightsky/math/vec4.h"
 #include "lightsky/utils/RandomNum.h"
 
 namespace ls {
@@ -82,6 +86,21 @@ class PerlinNoise
      */
     static double grad(int hash, double x, double y, double z) noexcept;
 
+    /**
+     * Blend the gradients at the eight corners of a lattice cell.
+     *
+     * @param x0, x1, y0, y1, z0, z1
+     * Permutation-table indices of the minimum and maximum corners of the
+     * cell along each axis.
+     *
+     * @param xr, yr, zr
+     * The position of a sample point relative to the minimum corner of the
+     * cell.
+     *
+     * @return A Perlin noise value within the range [-1,1].
+     */
+    double lattice_noise(int x0, int x1, int y0, int y1, int z0, int z1, double xr, double yr, double zr) const noexcept;
+
   public:
     /**
      * Destructor
@@ -167,6 +186,112 @@ class PerlinNoise
     template <typename point_t>
     num_t get_noise(const vec3_t<point_t>& point) const noexcept;
 
+    /**
+     * Get a periodic (tileable) noise value within a 3D Cartesian
+     * coordinate space.
+     *
+     * Lattice coordinates are wrapped by the period of each axis before
+     * being hashed through the permutation table, so the result repeats
+     * every "period" units at the same cost as regular 3D noise.
+     *
+     * @param point
+     * A point within a linear 3D space from which a noise value will be
+     * calculated.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the noise
+     * will repeat. Each component must be greater than 0.
+     *
+     * @return A Perlin noise value, calculated at the point specified by
+     * the input parameter. This value will be between [-1,1].
+     */
+    template <typename point_t>
+    num_t get_noise(const vec3_t<point_t>& point, const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Evaluate Perlin noise over an array of points.
+     *
+     * @param points
+     * A pointer to an array of points which will be sampled.
+     *
+     * @param outNoise
+     * A pointer to an array of at least "count" values which will contain the
+     * noise values calculated for each point.
+     *
+     * @param count
+     * The number of points to sample.
+     */
+    void get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count) const noexcept;
+
+    /**
+     * Evaluate periodic Perlin noise over an array of points.
+     *
+     * @param points
+     * A pointer to an array of points which will be sampled.
+     *
+     * @param outNoise
+     * A pointer to an array of at least "count" values which will contain the
+     * noise values calculated for each point.
+     *
+     * @param count
+     * The number of points to sample.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the noise
+     * will repeat. Each component must be greater than 0.
+     */
+    void get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count, const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Evaluate Perlin noise over a regularly spaced 3D grid.
+     *
+     * Noise values are written in X-major order (X varies fastest, then Y,
+     * then Z). Set the Z dimension to 1 in order to generate a 2D slice.
+     *
+     * @param outNoise
+     * A pointer to an array of at least (dims[0] * dims[1] * dims[2]) values.
+     *
+     * @param origin
+     * The point which will be sampled for the first output value.
+     *
+     * @param stride
+     * The distance between neighboring samples along each axis.
+     *
+     * @param dims
+     * The number of samples to generate along each axis.
+     */
+    void get_noise_grid(
+        num_t* outNoise,
+        const vec3_t<num_t>& origin,
+        const vec3_t<num_t>& stride,
+        const vec3_t<unsigned>& dims) const noexcept;
+
+    /**
+     * Evaluate periodic Perlin noise over a regularly spaced 3D grid.
+     *
+     * @param outNoise
+     * A pointer to an array of at least (dims[0] * dims[1] * dims[2]) values.
+     *
+     * @param origin
+     * The point which will be sampled for the first output value.
+     *
+     * @param stride
+     * The distance between neighboring samples along each axis.
+     *
+     * @param dims
+     * The number of samples to generate along each axis.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the noise
+     * will repeat. Each component must be greater than 0.
+     */
+    void get_noise_grid(
+        num_t* outNoise,
+        const vec3_t<num_t>& origin,
+        const vec3_t<num_t>& stride,
+        const vec3_t<unsigned>& dims,
+        const vec3_t<int>& period) const noexcept;
+
     /**
      * Get a [pseudo] randomly generated noise value within a 3D Cartesian
      * coordinate space. This value will be modified by a frequency
@@ -191,6 +316,31 @@ class PerlinNoise
      * the input parameter. This value will be between [-1,1].
      */
     num_t get_octave_noise(const vec3_t<num_t>& point, unsigned octaves, num_t persistance) const noexcept;
+
+    /**
+     * Get a fractal sum of several octaves of periodic noise.
+     *
+     * The period of each octave is doubled along with its frequency so the
+     * sum remains tileable over the base period.
+     *
+     * @param point
+     * A point within a linear 3D space from which a noise value will be
+     * calculated.
+     *
+     * @param octaves
+     * The number of times the noise function will be added onto itself.
+     *
+     * @param persistance
+     * The amplitude multiplier applied to each successive octave.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the base
+     * octave will repeat. Each component must be greater than 0.
+     *
+     * @return A Perlin noise value, calculated at the point specified by
+     * the input parameter. This value will be between [-1,1].
+     */
+    num_t get_octave_noise(const vec3_t<num_t>& point, unsigned octaves, num_t persistance, const vec3_t<int>& period) const noexcept;
 };
 
 /*-------------------------------------
@@ -199,6 +349,573 @@ class PerlinNoise
 LS_DECLARE_CLASS_TYPE(PerlinNoisef, PerlinNoise, float);
 LS_DECLARE_CLASS_TYPE(PerlinNoised, PerlinNoise, double);
 
+
+
+/**
+ * @brief Simple class to generate value (lattice) noise.
+ *
+ * Value noise assigns a random scalar to every integer lattice point and
+ * smoothly interpolates between the eight corners of the enclosing cell. It
+ * is cheaper than gradient noise and produces the soft, blobby shapes used
+ * for clouds and density fields.
+ */
+template <typename num_t = float>
+class ValueNoise
+{
+  private:
+    /**
+     * Pointer to a pseudo-random number generator that will be used to
+     * generate random noise.
+     */
+    utils::RandomNum* prng = nullptr;
+
+    /**
+     * An array of 512 randomly ordered integers that are used to hash
+     * lattice coordinates.
+     */
+    int* permutations = nullptr;
+
+    /**
+     * An array of 256 random values, within the range [-1, 1], which are
+     * assigned to each hashed lattice point.
+     */
+    num_t* values = nullptr;
+
+    /**
+     * Blend the values at the eight corners of a lattice cell.
+     *
+     * @param x0, x1, y0, y1, z0, z1
+     * Permutation-table indices of the minimum and maximum corners of the
+     * cell along each axis.
+     *
+     * @param xr, yr, zr
+     * The position of a sample point relative to the minimum corner of the
+     * cell.
+     *
+     * @return A value noise sample, within the range [-1,1].
+     */
+    num_t lattice_noise(int x0, int x1, int y0, int y1, int z0, int z1, num_t xr, num_t yr, num_t zr) const noexcept;
+
+  public:
+    /**
+     * Destructor
+     * Frees all memory used by *this.
+     */
+    ~ValueNoise() noexcept;
+
+    /**
+     * Constructor
+     */
+    ValueNoise() noexcept;
+
+    /**
+     * Seed Constructor
+     *
+     * @param s
+     * A long, unsigned integral value that will be used to seed the random
+     * number generator.
+     */
+    explicit ValueNoise(unsigned long s) noexcept;
+
+    /**
+     * Copy Constructor
+     *
+     * @param A constant reference to another value noise object
+     */
+    ValueNoise(const ValueNoise&) noexcept;
+
+    /**
+     * Move Constructor
+     *
+     * @param An R-Value reference to a value noise object that's about to
+     * go out of scope.
+     */
+    ValueNoise(ValueNoise&&) noexcept;
+
+    /**
+     * Copy Operator
+     *
+     * @param A constant reference to another value noise object
+     *
+     * @return A reference to *this.
+     */
+    ValueNoise& operator=(const ValueNoise&) noexcept;
+
+    /**
+     * Move Operator
+     *
+     * @param An R-Value reference to a value noise object that's about to
+     * go out of scope.
+     *
+     * @return A reference to *this.
+     */
+    ValueNoise& operator=(ValueNoise&&) noexcept;
+
+    /**
+     * Seed the random number generator in order to generate new noise.
+     */
+    void seed() noexcept;
+
+    /**
+     * Seed the random number generator in order to generate new noise.
+     *
+     * @param s
+     * A long, unsigned integral value that will be used to seed the random
+     * number generator.
+     */
+    void seed(unsigned long s) noexcept;
+
+    /**
+     * Get a [pseudo] randomly generated noise value within a 3D Cartesian
+     * coordinate space.
+     *
+     * @param point
+     * A point within a linear 3D space from which a noise value will be
+     * calculated.
+     *
+     * @return A value noise sample, within the range [-1,1].
+     */
+    num_t get_noise(const vec3_t<num_t>& point) const noexcept;
+
+    /**
+     * Get a periodic (tileable) noise value within a 3D Cartesian
+     * coordinate space.
+     *
+     * @param point
+     * A point within a linear 3D space from which a noise value will be
+     * calculated.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the noise
+     * will repeat. Each component must be greater than 0.
+     *
+     * @return A value noise sample, within the range [-1,1].
+     */
+    num_t get_noise(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Evaluate value noise over an array of points.
+     *
+     * @param points
+     * A pointer to an array of points which will be sampled.
+     *
+     * @param outNoise
+     * A pointer to an array of at least "count" values which will contain the
+     * noise values calculated for each point.
+     *
+     * @param count
+     * The number of points to sample.
+     */
+    void get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count) const noexcept;
+
+    /**
+     * Evaluate periodic value noise over an array of points.
+     *
+     * @param points
+     * A pointer to an array of points which will be sampled.
+     *
+     * @param outNoise
+     * A pointer to an array of at least "count" values which will contain the
+     * noise values calculated for each point.
+     *
+     * @param count
+     * The number of points to sample.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the noise
+     * will repeat. Each component must be greater than 0.
+     */
+    void get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count, const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Evaluate value noise over a regularly spaced 3D grid.
+     *
+     * Noise values are written in X-major order (X varies fastest, then Y,
+     * then Z). Set the Z dimension to 1 in order to generate a 2D slice.
+     *
+     * @param outNoise
+     * A pointer to an array of at least (dims[0] * dims[1] * dims[2]) values.
+     *
+     * @param origin
+     * The point which will be sampled for the first output value.
+     *
+     * @param stride
+     * The distance between neighboring samples along each axis.
+     *
+     * @param dims
+     * The number of samples to generate along each axis.
+     */
+    void get_noise_grid(
+        num_t* outNoise,
+        const vec3_t<num_t>& origin,
+        const vec3_t<num_t>& stride,
+        const vec3_t<unsigned>& dims) const noexcept;
+
+    /**
+     * Evaluate periodic value noise over a regularly spaced 3D grid.
+     *
+     * @param outNoise
+     * A pointer to an array of at least (dims[0] * dims[1] * dims[2]) values.
+     *
+     * @param origin
+     * The point which will be sampled for the first output value.
+     *
+     * @param stride
+     * The distance between neighboring samples along each axis.
+     *
+     * @param dims
+     * The number of samples to generate along each axis.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the noise
+     * will repeat. Each component must be greater than 0.
+     */
+    void get_noise_grid(
+        num_t* outNoise,
+        const vec3_t<num_t>& origin,
+        const vec3_t<num_t>& stride,
+        const vec3_t<unsigned>& dims,
+        const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Get a fractal sum of several octaves of value noise.
+     *
+     * @param point
+     * A point within a linear 3D space from which a noise value will be
+     * calculated.
+     *
+     * @param octaves
+     * The number of times the noise function will be added onto itself.
+     *
+     * @param persistance
+     * The amplitude multiplier applied to each successive octave.
+     *
+     * @return A value noise sample, within the range [-1,1].
+     */
+    num_t get_octave_noise(const vec3_t<num_t>& point, unsigned octaves, num_t persistance) const noexcept;
+};
+
+/*-------------------------------------
+    Value Noise Specializations
+-------------------------------------*/
+LS_DECLARE_CLASS_TYPE(ValueNoisef, ValueNoise, float);
+LS_DECLARE_CLASS_TYPE(ValueNoised, ValueNoise, double);
+
+
+
+/**
+ * @brief Simple class to generate Worley (cellular) noise.
+ *
+ * Every integer lattice cell contains a single, randomly placed feature
+ * point. Noise values are the distances from a sample point to the nearest
+ * (F1) and second-nearest (F2) feature points within the 3x3x3
+ * neighborhood of cells surrounding it.
+ *
+ * The neighborhood search evaluates all 27 candidate feature points in
+ * packets of four using vec4_t, which maps to SSE/NEON registers for
+ * single-precision noise, rather than through nested scalar loops.
+ *
+ * @see Steven Worley, "A Cellular Texture Basis Function", SIGGRAPH 1996.
+ */
+template <typename num_t = float>
+class WorleyNoise
+{
+  public:
+    /**
+     * @brief Distance functions available to measure the separation of a
+     * sample point and its feature points.
+     */
+    enum DistanceMetric : unsigned
+    {
+        WORLEY_DIST_EUCLIDEAN,
+        WORLEY_DIST_MANHATTAN,
+        WORLEY_DIST_CHEBYSHEV
+    };
+
+  private:
+    /**
+     * Pointer to a pseudo-random number generator that will be used to
+     * generate random noise.
+     */
+    utils::RandomNum* prng = nullptr;
+
+    /**
+     * An array of 512 randomly ordered integers that are used to hash
+     * lattice coordinates.
+     */
+    int* permutations = nullptr;
+
+    /**
+     * An array of 768 values within the range [0, 1), containing the X, Y,
+     * and Z offsets (stored consecutively in blocks of 256) of the feature
+     * point within each hashed lattice cell.
+     */
+    num_t* features = nullptr;
+
+    /**
+     * The distance function used when searching for feature points.
+     */
+    DistanceMetric metric;
+
+    /**
+     * Search the 27 cells surrounding a point for its two closest feature
+     * points. Neighboring cells are wrapped by "period" when "periodic" is
+     * true.
+     */
+    template <DistanceMetric metric_type, bool periodic>
+    vec2_t<num_t> find_features(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept;
+
+  public:
+    /**
+     * Destructor
+     * Frees all memory used by *this.
+     */
+    ~WorleyNoise() noexcept;
+
+    /**
+     * Constructor
+     */
+    WorleyNoise() noexcept;
+
+    /**
+     * Seed Constructor
+     *
+     * @param s
+     * A long, unsigned integral value that will be used to seed the random
+     * number generator.
+     *
+     * @param distanceMetric
+     * The distance function used to measure feature points.
+     */
+    explicit WorleyNoise(unsigned long s, DistanceMetric distanceMetric = WORLEY_DIST_EUCLIDEAN) noexcept;
+
+    /**
+     * Copy Constructor
+     *
+     * @param A constant reference to another Worley noise object
+     */
+    WorleyNoise(const WorleyNoise&) noexcept;
+
+    /**
+     * Move Constructor
+     *
+     * @param An R-Value reference to a Worley noise object that's about to
+     * go out of scope.
+     */
+    WorleyNoise(WorleyNoise&&) noexcept;
+
+    /**
+     * Copy Operator
+     *
+     * @param A constant reference to another Worley noise object
+     *
+     * @return A reference to *this.
+     */
+    WorleyNoise& operator=(const WorleyNoise&) noexcept;
+
+    /**
+     * Move Operator
+     *
+     * @param An R-Value reference to a Worley noise object that's about to
+     * go out of scope.
+     *
+     * @return A reference to *this.
+     */
+    WorleyNoise& operator=(WorleyNoise&&) noexcept;
+
+    /**
+     * Seed the random number generator in order to generate new noise.
+     */
+    void seed() noexcept;
+
+    /**
+     * Seed the random number generator in order to generate new noise.
+     *
+     * @param s
+     * A long, unsigned integral value that will be used to seed the random
+     * number generator.
+     */
+    void seed(unsigned long s) noexcept;
+
+    /**
+     * Set the distance function used to measure feature points.
+     *
+     * @param distanceMetric
+     * The distance function used when searching for feature points.
+     */
+    void distance_metric(DistanceMetric distanceMetric) noexcept;
+
+    /**
+     * Retrieve the distance function used to measure feature points.
+     *
+     * @return The distance function used when searching for feature points.
+     */
+    DistanceMetric distance_metric() const noexcept;
+
+    /**
+     * Get the distances to the closest (F1) and second-closest (F2) feature
+     * points surrounding a point in 3D space.
+     *
+     * @param point
+     * A point within a linear 3D space from which feature distances will be
+     * calculated.
+     *
+     * @return A 2D vector containing F1 in its X component and F2 in its Y
+     * component.
+     */
+    vec2_t<num_t> get_features(const vec3_t<num_t>& point) const noexcept;
+
+    /**
+     * Get the periodic F1 and F2 feature distances surrounding a point in 3D
+     * space.
+     *
+     * @param point
+     * A point within a linear 3D space from which feature distances will be
+     * calculated.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the feature
+     * points will repeat. Each component must be greater than 0.
+     *
+     * @return A 2D vector containing F1 in its X component and F2 in its Y
+     * component.
+     */
+    vec2_t<num_t> get_features(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Calculate the F1 and F2 feature distances for an array of points.
+     *
+     * @param points
+     * A pointer to an array of points which will be sampled.
+     *
+     * @param outFeatures
+     * A pointer to an array of at least "count" 2D vectors which will contain
+     * the F1 and F2 distances of each point.
+     *
+     * @param count
+     * The number of points to sample.
+     */
+    void get_features(const vec3_t<num_t>* points, vec2_t<num_t>* outFeatures, std::size_t count) const noexcept;
+
+    /**
+     * Get the distance to the closest feature point (F1) surrounding a point
+     * in 3D space.
+     *
+     * @param point
+     * A point within a linear 3D space from which a noise value will be
+     * calculated.
+     *
+     * @return The F1 distance of the input point. This value is always
+     * positive and is usually, though not strictly, less than 1.
+     */
+    num_t get_noise(const vec3_t<num_t>& point) const noexcept;
+
+    /**
+     * Get the periodic F1 distance surrounding a point in 3D space.
+     *
+     * @param point
+     * A point within a linear 3D space from which a noise value will be
+     * calculated.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the feature
+     * points will repeat. Each component must be greater than 0.
+     *
+     * @return The F1 distance of the input point.
+     */
+    num_t get_noise(const vec3_t<num_t>& point, const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Evaluate F1 Worley noise over an array of points.
+     *
+     * @param points
+     * A pointer to an array of points which will be sampled.
+     *
+     * @param outNoise
+     * A pointer to an array of at least "count" values which will contain the
+     * noise values calculated for each point.
+     *
+     * @param count
+     * The number of points to sample.
+     */
+    void get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count) const noexcept;
+
+    /**
+     * Evaluate periodic F1 Worley noise over an array of points.
+     *
+     * @param points
+     * A pointer to an array of points which will be sampled.
+     *
+     * @param outNoise
+     * A pointer to an array of at least "count" values which will contain the
+     * noise values calculated for each point.
+     *
+     * @param count
+     * The number of points to sample.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the feature
+     * points will repeat. Each component must be greater than 0.
+     */
+    void get_noise(const vec3_t<num_t>* points, num_t* outNoise, std::size_t count, const vec3_t<int>& period) const noexcept;
+
+    /**
+     * Evaluate F1 Worley noise over a regularly spaced 3D grid.
+     *
+     * Noise values are written in X-major order (X varies fastest, then Y,
+     * then Z). Set the Z dimension to 1 in order to generate a 2D slice.
+     *
+     * @param outNoise
+     * A pointer to an array of at least (dims[0] * dims[1] * dims[2]) values.
+     *
+     * @param origin
+     * The point which will be sampled for the first output value.
+     *
+     * @param stride
+     * The distance between neighboring samples along each axis.
+     *
+     * @param dims
+     * The number of samples to generate along each axis.
+     */
+    void get_noise_grid(
+        num_t* outNoise,
+        const vec3_t<num_t>& origin,
+        const vec3_t<num_t>& stride,
+        const vec3_t<unsigned>& dims) const noexcept;
+
+    /**
+     * Evaluate periodic F1 Worley noise over a regularly spaced 3D grid.
+     *
+     * @param outNoise
+     * A pointer to an array of at least (dims[0] * dims[1] * dims[2]) values.
+     *
+     * @param origin
+     * The point which will be sampled for the first output value.
+     *
+     * @param stride
+     * The distance between neighboring samples along each axis.
+     *
+     * @param dims
+     * The number of samples to generate along each axis.
+     *
+     * @param period
+     * The number of lattice cells, along each axis, after which the feature
+     * points will repeat. Each component must be greater than 0.
+     */
+    void get_noise_grid(
+        num_t* outNoise,
+        const vec3_t<num_t>& origin,
+        const vec3_t<num_t>& stride,
+        const vec3_t<unsigned>& dims,
+        const vec3_t<int>& period) const noexcept;
+};
+
+/*-------------------------------------
+    Worley Noise Specializations
+-------------------------------------*/
+LS_DECLARE_CLASS_TYPE(WorleyNoisef, WorleyNoise, float);
+LS_DECLARE_CLASS_TYPE(WorleyNoised, WorleyNoise, double);
+
 } // end math namespace
 } // end ls namespace
 
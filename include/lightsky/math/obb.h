@@ -0,0 +1,166 @@
+
+#ifndef LS_MATH_OBB_H
+#define LS_MATH_OBB_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86, LS_ARM_NEON
+
+#include "lightsky/math/mat3.h"
+#include "lightsky/math/parallel.h"
+#include "lightsky/math/svd.h"
+#include "lightsky/math/vec3.h"
+#include "lightsky/math/vec_utils.h"
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Point Covariance & Oriented Bounding Boxes
+
+    Boxes are fitted using principal component analysis: the eigenvectors of
+    the covariance of a set of points become the axes of the box, then every
+    point is projected onto those axes to find the tightest box with that
+    orientation.
+
+    Large point sets are split into chunks of a few thousand, which are
+    distributed across threads using "parallel_for()". Each chunk is summed
+    separately, then all chunks are combined in double-precision and in
+    order, so results don't depend on the number of threads used. Single-
+    precision points are summed and projected using SIMD registers.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief A box with an arbitrary orientation.
+ *
+ * A point "p" lies inside of the box if, for every axis "i",
+ * |dot(axes[i], p - center)| <= extents[i].
+ */
+template <typename num_t>
+struct OrientedBox
+{
+    /**
+     * The center of the box.
+     */
+    vec3_t<num_t> center;
+
+    /**
+     * The unit-length axes of the box, stored in each column. This is always
+     * a rotation.
+     */
+    mat3_t<num_t> axes;
+
+    /**
+     * Half of the width of the box along each axis.
+     */
+    vec3_t<num_t> extents;
+};
+
+
+
+/**
+ * @brief Calculate the mean and covariance of an array of points.
+ *
+ * The population covariance is returned, that is, the sum of each squared
+ * deviation from the mean divided by "count". Both outputs are zero if
+ * "count" is 0.
+ *
+ * @param points
+ * An array of at least "count" points.
+ *
+ * @param count
+ * The number of points to process.
+ *
+ * @param outMean
+ * The average of all points.
+ *
+ * @param outCovariance
+ * The symmetric covariance matrix of all points.
+ *
+ * @param numThreads
+ * The maximum number of threads to use. A value of 0 uses all hardware
+ * threads.
+ */
+template <typename N>
+void covariance(
+    const vec3_t<N>* points,
+    std::size_t count,
+    vec3_t<N>& outMean,
+    mat3_t<N>& outCovariance,
+    unsigned numThreads = 0) noexcept;
+
+/**
+ * @brief Fit an oriented bounding box to an array of points.
+ *
+ * The axes of the box are the eigenvectors of the covariance of all points,
+ * sorted by decreasing variance, so the first axis runs along the longest
+ * direction of the point cloud. The box contains every point and touches
+ * the most extreme point along each axis. If "count" is 0, the box has no
+ * volume, sits at the origin, and is aligned to the world axes.
+ *
+ * @param points
+ * An array of at least "count" points.
+ *
+ * @param count
+ * The number of points to bound.
+ *
+ * @param numThreads
+ * The maximum number of threads to use. A value of 0 uses all hardware
+ * threads.
+ *
+ * @return An oriented box which contains every point.
+ */
+template <typename N>
+OrientedBox<N> fit_obb(
+    const vec3_t<N>* points,
+    std::size_t count,
+    unsigned numThreads = 0) noexcept;
+
+/**
+ * @brief Fit oriented bounding boxes to many separate sets of points, such as
+ * the parts of a mesh.
+ *
+ * Each box is fitted in the same way as fit_obb(), but parts, rather than
+ * points, are distributed across threads and the axes of many boxes are
+ * solved at once using eigen_symmetric_batch(). Prefer this function when
+ * bounding a large number of small parts.
+ *
+ * @param points
+ * An array containing the points of every part.
+ *
+ * @param partOffsets
+ * An array of "numParts + 1" indices into "points". The points of part "i"
+ * occupy the range [partOffsets[i], partOffsets[i+1]).
+ *
+ * @param numParts
+ * The number of parts to bound.
+ *
+ * @param outBoxes
+ * An array of at least "numParts" elements which will contain the box of
+ * each part.
+ *
+ * @param numThreads
+ * The maximum number of threads to use. A value of 0 uses all hardware
+ * threads.
+ */
+template <typename N>
+void fit_obb_batch(
+    const vec3_t<N>* points,
+    const std::size_t* partOffsets,
+    std::size_t numParts,
+    OrientedBox<N>* outBoxes,
+    unsigned numThreads = 0) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/obb_impl.h"
+
+#if defined(LS_ARCH_X86) || defined(LS_ARM_NEON)
+    #include "lightsky/math/generic/obbf_impl.h"
+#endif
+
+#endif /* LS_MATH_OBB_H */
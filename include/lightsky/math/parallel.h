@@ -0,0 +1,62 @@
+
+#ifndef LS_MATH_PARALLEL_H
+#define LS_MATH_PARALLEL_H
+
+#include <cstddef> // std::size_t
+
+namespace ls {
+namespace math {
+
+
+
+/**
+ * @brief Retrieve the number of threads which should be used for bulk math
+ * operations.
+ *
+ * @param requestedThreads
+ * The number of threads requested by a caller. A value of 0 selects the
+ * number of hardware threads available.
+ *
+ * @return A thread count greater than or equal to 1.
+ */
+unsigned parallel_thread_count(unsigned requestedThreads = 0) noexcept;
+
+/**
+ * @brief Execute a function over a range of work items using multiple
+ * threads.
+ *
+ * Items are handed out dynamically so work of uneven cost remains balanced.
+ * The calling thread participates in the work and this function returns
+ * once all items have been processed.
+ *
+ * Worker threads are created on every call and joined before returning;
+ * there is no persistent thread pool. Thread creation typically costs tens
+ * of microseconds per thread, so callers which run every frame should
+ * submit all of their work through as few calls as possible, and small
+ * workloads should use a single thread. If the system cannot create a
+ * thread, the remaining items are processed by the threads which were
+ * already started, including the calling thread.
+ *
+ * @param numItems
+ * The number of work items to process.
+ *
+ * @param numThreads
+ * The maximum number of threads to use, including the calling thread. A value
+ * of 0 selects the number of hardware threads available.
+ *
+ * @param func
+ * A function, or function object, with the signature
+ * "void(std::size_t itemId, unsigned threadId)". Thread IDs are contiguous
+ * within the range [0, parallel_thread_count(numThreads)).
+ */
+template <typename func_t>
+void parallel_for(std::size_t numItems, unsigned numThreads, const func_t& func) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/parallel_impl.h"
+
+#endif /* LS_MATH_PARALLEL_H */
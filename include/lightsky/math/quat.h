@@ -2,6 +2,8 @@
 #ifndef LS_MATH_QUAT_H
 #define LS_MATH_QUAT_H
 
+#include "lightsky/setup/Arch.h"
+
 #include "lightsky/math/fixed.h"
 
 namespace ls {
@@ -24,7 +26,7 @@ struct half;
  *      3 = W   (real component)
  */
 template <typename num_t>
-struct alignas(sizeof(num_t)) quat_t
+union alignas(sizeof(num_t)) quat_t
 {
     // data
     num_t q[4];
@@ -110,4 +112,10 @@ typedef quat_t<float> quat;
 
 #include "lightsky/math/generic/quat_impl.h"
 
+#ifdef LS_ARCH_X86
+    #include "lightsky/math/x86/quatf_impl.h"
+#elif defined(LS_ARM_NEON)
+    #include "lightsky/math/arm/quatf_impl.h"
+#endif
+
 #endif /* LS_MATH_QUAT_H */
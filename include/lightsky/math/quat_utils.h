@@ -436,6 +436,53 @@ quat_t<N> mat_to_quat(const mat4_t<N>& m);
 
 
 
+/**
+ *  @brief Create a 4x4 matrix which applies a scale, then a rotation, then
+ *  a translation.
+ *
+ *  @param t
+ *  The translation of the matrix.
+ *
+ *  @param r
+ *  A unit quaternion containing the rotation of the matrix.
+ *
+ *  @param s
+ *  The scale of the matrix along each axis.
+ *
+ *  @return translate * rotate * scale, as a 4x4 matrix.
+ */
+template <typename N> inline
+mat4_t<N> compose_trs(const vec3_t<N>& t, const quat_t<N>& r, const vec3_t<N>& s);
+
+
+
+/**
+ *  @brief Split an affine 4x4 matrix into a translation, rotation, and scale,
+ *  such that compose_trs(outT, outR, outS) reproduces the matrix.
+ *
+ *  Matrices containing a reflection (a negative determinant) are given a
+ *  negative scale along the X axis. Rotations are normalized and lie in the
+ *  hemisphere w >= 0. Shear is discarded. If a single axis has a scale of 0,
+ *  its direction is taken from the other two axes. If two or more axes have
+ *  a scale of 0, they do not contribute to the rotation.
+ *
+ *  @param m
+ *  An affine transformation matrix.
+ *
+ *  @param outT
+ *  The translation of the matrix.
+ *
+ *  @param outR
+ *  The rotation of the matrix.
+ *
+ *  @param outS
+ *  The scale of the matrix along each axis.
+ */
+template <typename N> inline
+void decompose(const mat4_t<N>& m, vec3_t<N>& outT, quat_t<N>& outR, vec3_t<N>& outS);
+
+
+
 /*-----------------------------------------------------------------------------
     Quaternion  Casting
 -----------------------------------------------------------------------------*/
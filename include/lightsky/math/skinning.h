@@ -0,0 +1,99 @@
+
+#ifndef LS_MATH_SKINNING_H
+#define LS_MATH_SKINNING_H
+
+#include <cstddef> // std::size_t
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86, LS_ARM_NEON
+
+#include "lightsky/math/batch_utils.h"
+#include "lightsky/math/half.h"
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/parallel.h"
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Linear Blend Skinning
+
+    Skinning functions split their vertices into chunks of a few thousand,
+    which are distributed across threads using "parallel_for()". Single-
+    precision versions blend the columns of each bone matrix using SIMD
+    registers. Input and output arrays may alias each other exactly, but must
+    not otherwise overlap.
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Skin an array of vertices using linear blend skinning.
+ *
+ * The bone matrices of each vertex are summed by weight, then used to
+ * transform the vertex position and normal. Bones which do not influence a
+ * vertex should be given a weight of 0.
+ *
+ * Each palette matrix must be affine; the bottom row of each matrix is
+ * ignored. Normals are transformed by the upper 3x3 portion of the blended
+ * matrix and are not renormalized, so palettes containing non-uniform scale
+ * will require normals to be normalized by the caller.
+ *
+ * @param palette
+ * An array of bone matrices, each of which transforms a vertex from bind-pose
+ * into its skinned position.
+ *
+ * @param positions
+ * An array of at least "count" vertex positions.
+ *
+ * @param normals
+ * An array of at least "count" vertex normals, or NULL to skip transforming
+ * normals.
+ *
+ * @param boneIds
+ * An array of at least "count" sets of four indices into "palette". Indices
+ * may be 8 or 16-bit unsigned integers.
+ *
+ * @param weights
+ * An array of at least "count" sets of four bone weights, which should sum to
+ * 1 for each vertex. Weights may be stored as floating-point numbers, half-
+ * floats, or as 8 or 16-bit unsigned normalized integers, where the largest
+ * integer value represents 1.
+ *
+ * @param outPositions
+ * An array of at least "count" elements which will contain each skinned
+ * position.
+ *
+ * @param outNormals
+ * An array of at least "count" elements which will contain each skinned
+ * normal. This is ignored if "normals" is NULL.
+ *
+ * @param count
+ * The number of vertices to skin.
+ *
+ * @param numThreads
+ * The maximum number of threads to use. A value of 0 uses all hardware
+ * threads.
+ */
+template <typename N, typename index_t, typename weight_t>
+void skin_vertices(
+    const mat4_t<N>* palette,
+    const vec3_t<N>* positions,
+    const vec3_t<N>* normals,
+    const vec4_t<index_t>* boneIds,
+    const vec4_t<weight_t>* weights,
+    vec3_t<N>* outPositions,
+    vec3_t<N>* outNormals,
+    std::size_t count,
+    unsigned numThreads = 0) noexcept;
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#include "lightsky/math/generic/skinning_impl.h"
+
+#if defined(LS_ARCH_X86) || defined(LS_ARM_NEON)
+    #include "lightsky/math/generic/skinningf_impl.h"
+#endif
+
+#endif /* LS_MATH_SKINNING_H */
@@ -0,0 +1,137 @@
+
+#ifndef LS_MATH_VEC3A_H
+#define LS_MATH_VEC3A_H
+
+#include "lightsky/setup/Arch.h"
+
+#include "lightsky/math/fixed.h"
+#include "lightsky/math/vec3.h"
+
+namespace ls {
+namespace math {
+
+struct half;
+
+
+
+/**
+ *  @brief Aligned 3D Vector Structure
+ *
+ *  Stores a 3D vector in the space of a 4D vector so that every element fits
+ *  into a single SIMD register. Use this in place of vec3_t for data which is
+ *  operated on frequently, and vec3_t for data which is stored in bulk.
+ *
+ *  @note
+ *  Indexing is as follows:
+ *      0 = X
+ *      1 = Y
+ *      2 = Z
+ *      3 = Padding
+ *
+ *  The padding element is not part of the vector. Its value is unspecified
+ *  after any operation and it is ignored by comparisons and by all of the
+ *  functions in "vec_utils.h".
+ */
+template <typename num_t>
+union alignas(sizeof(num_t)*4) vec3a_t
+{
+    typedef num_t value_type;
+    static constexpr unsigned num_components() noexcept { return 3; }
+
+    // data
+    num_t v[4];
+
+    // Main Constructor
+    constexpr vec3a_t(num_t inX, num_t inY, num_t inZ);
+
+    // Delegated Constructors
+    vec3a_t() = default;
+    constexpr vec3a_t(num_t n);
+    constexpr vec3a_t(const vec3a_t<num_t>&) = default;
+    constexpr vec3a_t(vec3a_t<num_t>&&) = default;
+
+    ~vec3a_t() = default;
+
+    // Conversions & Casting
+    template <typename other_t>
+    constexpr explicit operator vec3a_t<other_t>() const;
+
+    constexpr const num_t* operator&() const;
+    inline num_t* operator&();
+
+    // Subscripting Operators
+    template <typename index_t>
+    constexpr num_t operator[](index_t i) const;
+
+    template <typename index_t>
+    inline num_t& operator[](index_t i);
+
+    //vector-vector operators
+    constexpr vec3a_t operator+(const vec3a_t<num_t>&) const;
+    constexpr vec3a_t operator-(const vec3a_t<num_t>&) const;
+    constexpr vec3a_t operator-() const;
+    constexpr vec3a_t operator*(const vec3a_t<num_t>&) const;
+    constexpr vec3a_t operator/(const vec3a_t<num_t>&) const;
+    vec3a_t& operator=(const vec3a_t<num_t>&) = default;
+    vec3a_t& operator=(vec3a_t<num_t>&&) = default;
+    vec3a_t& operator+=(const vec3a_t<num_t>&);
+    vec3a_t& operator-=(const vec3a_t<num_t>&);
+    vec3a_t& operator*=(const vec3a_t<num_t>&);
+    vec3a_t& operator/=(const vec3a_t<num_t>&);
+    vec3a_t& operator++(); //prefix operators
+    vec3a_t& operator--();
+    vec3a_t operator++(int); //postfix operators
+    vec3a_t operator--(int);
+    constexpr bool operator==(const vec3a_t<num_t>& compare) const; //comparisons
+    constexpr bool operator!=(const vec3a_t<num_t>& compare) const;
+    constexpr bool operator<(const vec3a_t<num_t>& compare) const;
+    constexpr bool operator>(const vec3a_t<num_t>& compare) const;
+    constexpr bool operator<=(const vec3a_t<num_t>& compare) const;
+    constexpr bool operator>=(const vec3a_t<num_t>& compare) const;
+
+    //vector-scalar operators
+    vec3a_t operator=(num_t);
+    constexpr vec3a_t operator+(num_t) const;
+    constexpr vec3a_t operator-(num_t) const;
+    constexpr vec3a_t operator*(num_t) const;
+    constexpr vec3a_t operator/(num_t) const;
+    vec3a_t& operator+=(num_t);
+    vec3a_t& operator-=(num_t);
+    vec3a_t& operator*=(num_t);
+    vec3a_t& operator/=(num_t);
+};
+
+/*-------------------------------------
+    Non-Member Vector-Scalar operations
+-------------------------------------*/
+template <typename num_t> constexpr
+vec3a_t<num_t> operator+(num_t n, const vec3a_t<num_t>& v);
+
+template <typename num_t> constexpr
+vec3a_t<num_t> operator-(num_t n, const vec3a_t<num_t>& v);
+
+template <typename num_t> constexpr
+vec3a_t<num_t> operator*(num_t n, const vec3a_t<num_t>& v);
+
+/*-------------------------------------
+    Aligned 3D Vector Specializations
+-------------------------------------*/
+typedef vec3a_t<float>    vec3af;
+typedef vec3a_t<double>   vec3ad;
+typedef vec3a_t<int>      vec3ai;
+typedef vec3a_t<unsigned> vec3au;
+
+typedef vec3a_t<float> vec3a;
+
+} //end math namespace
+} //end ls namespace
+
+#include "lightsky/math/generic/vec3a_impl.h"
+
+#ifdef LS_ARCH_X86
+    #include "lightsky/math/x86/vec3af_impl.h"
+#elif defined(LS_ARM_NEON)
+    #include "lightsky/math/arm/vec3af_impl.h"
+#endif
+
+#endif /* LS_MATH_VEC3A_H */
@@ -13,7 +13,9 @@
 #include "lightsky/math/scalar_utils.h"
 #include "lightsky/math/vec2.h"
 #include "lightsky/math/vec3.h"
+#include "lightsky/math/vec3a.h"
 #include "lightsky/math/vec4.h"
+#include "lightsky/math/vecn.h"
 
 namespace ls {
 namespace math {
@@ -1571,6 +1573,467 @@ constexpr vec4_t<N> fmadd(const vec4_t<N>& x, const vec4_t<N>& m, const vec4_t<N
 template <typename N>
 constexpr vec4_t<N> fmsub(const vec4_t<N>& x, const vec4_t<N>& m, const vec4_t<N>& a) noexcept;
 
+/**
+ * @brief sin
+ * Calculate the sine of each component of a vector.
+ *
+ * Single-precision SIMD implementations evaluate all four components at
+ * once and are accurate to within 2 ULP for |x| <= pi, and to within 1.2e-7
+ * absolute for |x| < 8192.
+ *
+ * @param x
+ * A vector of angles, in radians.
+ *
+ * @return The sine of each angle.
+ */
+template <typename N>
+inline vec4_t<N> sin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief cos
+ * Calculate the cosine of each component of a vector.
+ *
+ * @param x
+ * A vector of angles, in radians.
+ *
+ * @return The cosine of each angle.
+ */
+template <typename N>
+inline vec4_t<N> cos(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief sincos
+ * Calculate both the sine and cosine of each component of a vector. The
+ * single-precision SIMD implementations share the range reduction, making
+ * this cheaper than calling sin() and cos() separately.
+ *
+ * @param x
+ * A vector of angles, in radians.
+ *
+ * @param outSin
+ * The sine of each angle.
+ *
+ * @param outCos
+ * The cosine of each angle.
+ */
+template <typename N>
+inline void sincos(const vec4_t<N>& x, vec4_t<N>& outSin, vec4_t<N>& outCos) noexcept;
+
+/**
+ * @brief tan
+ * Calculate the tangent of each component of a vector.
+ *
+ * @param x
+ * A vector of angles, in radians.
+ *
+ * @return The tangent of each angle.
+ */
+template <typename N>
+inline vec4_t<N> tan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan
+ * Calculate the arc-tangent of each component of a vector.
+ *
+ * @param x
+ * A vector of tangent values.
+ *
+ * @return The arc-tangent of each component, within [-pi/2, pi/2].
+ */
+template <typename N>
+inline vec4_t<N> atan(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief atan2
+ * Calculate the arc-tangent of y/x for each pair of vector components,
+ * using the signs of both to determine the quadrant.
+ *
+ * Single-precision SIMD implementations follow the signed-zero, infinity,
+ * and NaN rules of std::atan2().
+ *
+ * @param y
+ * The lengths along the y-axis.
+ *
+ * @param x
+ * The lengths along the x-axis.
+ *
+ * @return The arc-tangent of each pair of lengths, within [-pi, pi].
+ */
+template <typename N>
+inline vec4_t<N> atan2(const vec4_t<N>& y, const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief asin
+ * Calculate the arc-sine of each component of a vector.
+ *
+ * @param x
+ * A vector of values within [-1, 1].
+ *
+ * @return The arc-sine of each component, within [-pi/2, pi/2].
+ */
+template <typename N>
+inline vec4_t<N> asin(const vec4_t<N>& x) noexcept;
+
+/**
+ * @brief acos
+ * Calculate the arc-cosine of each component of a vector.
+ *
+ * @param x
+ * A vector of values within [-1, 1].
+ *
+ * @return The arc-cosine of each component, within [0, pi].
+ */
+template <typename N>
+inline vec4_t<N> acos(const vec4_t<N>& x) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+    3D Aligned Vectors
+
+    These mirror the 3D vector functions. Only the X, Y, and Z components take
+    part in any calculation and the padding component of each result is
+    unspecified.
+-----------------------------------------------------------------------------*/
+/**
+ *  @brief sum
+ *  Retrieve the sum of the X, Y, and Z components of an aligned 3D vector.
+ */
+template <typename N> inline
+N sum(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief reciprocal sum
+ *  Retrieve the reciprocal of the sum of the X, Y, and Z components.
+ */
+template <typename N> inline
+N sum_inv(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief dot
+ *  Retrieve the dot product of two aligned 3D vectors.
+ */
+template <typename N> inline
+N dot(const vec3a_t<N>& v1, const vec3a_t<N>& v2) noexcept;
+
+/**
+ *  @brief cross
+ *  Retrieve the cross product of two aligned 3D vectors.
+ */
+template <typename N> inline
+vec3a_t<N> cross(const vec3a_t<N>& v1, const vec3a_t<N>& v2) noexcept;
+
+/**
+ *  @brief normalize
+ *  Scale an aligned 3D vector to a length of 1.
+ */
+template <typename N> inline
+vec3a_t<N> normalize(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief lengthSquared
+ *  Retrieve the squared magnitude of an aligned 3D vector.
+ */
+template <typename N> inline
+N length_squared(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief length
+ *  Retrieve the magnitude of an aligned 3D vector.
+ */
+template <typename N> inline
+N length(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief angleBetween
+ *  Retrieve the angle, in radians, between two aligned 3D vectors.
+ */
+template <typename N> inline
+N angle_between(const vec3a_t<N>& v1, const vec3a_t<N>& v2) noexcept;
+
+/**
+ *  @brief angleBetween
+ *  Retrieve the angle, in radians, between two aligned 3D vectors
+ *  relative to an origin point.
+ */
+template <typename N> inline
+N angle_between(const vec3a_t<N>& v1, const vec3a_t<N>& v2, const vec3a_t<N>& origin) noexcept;
+
+/**
+ *  @brief min
+ *  Retrieve the component-wise minimum of two aligned 3D vectors.
+ */
+template <typename N> inline
+vec3a_t<N> min(const vec3a_t<N>&, const vec3a_t<N>&) noexcept;
+
+/**
+ *  @brief mix
+ *  Linearly interpolate between two aligned 3D vectors.
+ */
+template <typename N> inline
+vec3a_t<N> mix(const vec3a_t<N>&, const vec3a_t<N>&, N) noexcept;
+
+/**
+ *  @brief max
+ *  Retrieve the component-wise maximum of two aligned 3D vectors.
+ */
+template <typename N> inline
+vec3a_t<N> max(const vec3a_t<N>&, const vec3a_t<N>&) noexcept;
+
+/**
+ *  @brief clamp
+ *  Clamp each component of an aligned 3D vector within a range.
+ */
+template <typename N> inline
+vec3a_t<N> clamp(const vec3a_t<N>& v, const vec3a_t<N>& minVals, const vec3a_t<N>& maxVals) noexcept;
+
+/**
+ *  @brief saturate
+ *  Clamp each component of an aligned 3D vector within [0, 1].
+ */
+template <typename N> inline
+vec3a_t<N> saturate(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief project
+ *  Project one aligned 3D vector onto another.
+ */
+template <typename N> inline
+vec3a_t<N> project(const vec3a_t<N>& v1, const vec3a_t<N>& v2) noexcept;
+
+/**
+ *  @brief reflect
+ *  Reflect an aligned 3D vector about a normal.
+ */
+template <typename N> inline
+vec3a_t<N> reflect(const vec3a_t<N>& v1, const vec3a_t<N>& norm) noexcept;
+
+/**
+ *  @brief mid
+ *  Retrieve the midpoint between two aligned 3D vectors.
+ */
+template <typename N> inline
+vec3a_t<N> mid(const vec3a_t<N>& v1, const vec3a_t<N>& v2) noexcept;
+
+/**
+ *  @brief step
+ *  Component-wise step function: 0 where v < edge, 1 otherwise.
+ */
+template <typename N> inline
+vec3a_t<N> step(const vec3a_t<N>& edge, const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief smoothstep
+ *  Component-wise Hermite interpolation of x between a and b.
+ */
+template <typename N> inline
+vec3a_t<N> smoothstep(const vec3a_t<N>& a, const vec3a_t<N>& b, const vec3a_t<N>& x) noexcept;
+
+/**
+ *  @brief rcp
+ *  Retrieve the component-wise reciprocal of an aligned 3D vector.
+ */
+template <typename N> inline
+vec3a_t<N> rcp(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief sign_mask
+ *  Retrieve the sign bits of the X, Y, and Z components in the lowest
+ *  three bits of an integer.
+ */
+template <typename N> inline
+int sign_mask(const vec3a_t<N>& x) noexcept;
+
+/**
+ *  @brief sign
+ *  Retrieve the component-wise signs of an aligned 3D vector.
+ */
+template <typename N> inline
+vec3a_t<N> sign(const vec3a_t<N>& x) noexcept;
+
+/**
+ *  @brief copysign
+ *  Copy the signs of one aligned 3D vector into another.
+ */
+template <typename N> inline
+vec3a_t<N> copysign(const vec3a_t<N>& n, const vec3a_t<N>& s) noexcept;
+
+/**
+ *  @brief floor
+ *  Round each component down to the nearest integer.
+ */
+template <typename N> inline
+vec3a_t<N> floor(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief ceil
+ *  Round each component up to the nearest integer.
+ */
+template <typename N> inline
+vec3a_t<N> ceil(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief round
+ *  Round each component to the nearest integer.
+ */
+template <typename N> inline
+vec3a_t<N> round(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief abs
+ *  Retrieve the absolute value of each component.
+ */
+template <typename N> inline
+vec3a_t<N> abs(const vec3a_t<N>& v) noexcept;
+
+/**
+ *  @brief log2
+ *  Component-wise base-2 logarithm.
+ */
+template <typename N> inline
+vec3a_t<N> log2(const vec3a_t<N>& n) noexcept;
+
+/**
+ *  @brief log
+ *  Component-wise natural logarithm.
+ */
+template <typename N> inline
+vec3a_t<N> log(const vec3a_t<N>& n) noexcept;
+
+/**
+ *  @brief log10
+ *  Component-wise base-10 logarithm.
+ */
+template <typename N> inline
+vec3a_t<N> log10(const vec3a_t<N>& n) noexcept;
+
+/**
+ *  @brief logN
+ *  Component-wise logarithm of n with an arbitrary base.
+ */
+template <typename N> inline
+vec3a_t<N> logN(const vec3a_t<N>& baseN, const vec3a_t<N>& n) noexcept;
+
+/**
+ *  @brief pow
+ *  Raise each component of x to the power of each component of y.
+ */
+template <typename N> inline
+vec3a_t<N> pow(const vec3a_t<N>& x, const vec3a_t<N>& y) noexcept;
+
+/**
+ *  @brief exp
+ *  Component-wise natural exponent.
+ */
+template <typename N> inline
+vec3a_t<N> exp(const vec3a_t<N>& x) noexcept;
+
+/**
+ *  @brief exp2
+ *  Component-wise base-2 exponent.
+ */
+template <typename N> inline
+vec3a_t<N> exp2(const vec3a_t<N>& x) noexcept;
+
+/**
+ *  @brief fmadd
+ *  Calculate (x*m)+a for each component.
+ */
+template <typename N> inline
+vec3a_t<N> fmadd(const vec3a_t<N>& x, const vec3a_t<N>& m, const vec3a_t<N>& a) noexcept;
+
+/**
+ *  @brief fmsub
+ *  Calculate (x*m)-a for each component.
+ */
+template <typename N> inline
+vec3a_t<N> fmsub(const vec3a_t<N>& x, const vec3a_t<N>& m, const vec3a_t<N>& a) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+    N-Dimensional Vectors
+
+    These mirror the 4D vector functions. Single-precision vectors are
+    processed using the widest SIMD registers which fit.
+-----------------------------------------------------------------------------*/
+/**
+ *  @brief sum
+ *  Retrieve the sum of all components in an N-dimensional vector.
+ */
+template <unsigned D, typename N> constexpr
+N sum(const vecN_t<D, N>& v) noexcept;
+
+/**
+ *  @brief dot
+ *  Retrieve the dot product of two N-dimensional vectors.
+ */
+template <unsigned D, typename N> constexpr
+N dot(const vecN_t<D, N>& v1, const vecN_t<D, N>& v2) noexcept;
+
+/**
+ *  @brief normalize
+ *  Scale an N-dimensional vector to a length of 1.
+ */
+template <unsigned D, typename N> inline
+vecN_t<D, N> normalize(const vecN_t<D, N>& v) noexcept;
+
+/**
+ *  @brief lengthSquared
+ *  Retrieve the squared magnitude of an N-dimensional vector.
+ */
+template <unsigned D, typename N> constexpr
+N length_squared(const vecN_t<D, N>& v) noexcept;
+
+/**
+ *  @brief length
+ *  Retrieve the magnitude of an N-dimensional vector.
+ */
+template <unsigned D, typename N> inline
+N length(const vecN_t<D, N>& v) noexcept;
+
+/**
+ *  @brief min
+ *  Component-wise minimum of two N-dimensional vectors.
+ */
+template <unsigned D, typename N> constexpr
+vecN_t<D, N> min(const vecN_t<D, N>& v1, const vecN_t<D, N>& v2) noexcept;
+
+/**
+ *  @brief max
+ *  Component-wise maximum of two N-dimensional vectors.
+ */
+template <unsigned D, typename N> constexpr
+vecN_t<D, N> max(const vecN_t<D, N>& v1, const vecN_t<D, N>& v2) noexcept;
+
+/**
+ *  @brief mix
+ *  Linearly interpolate between two N-dimensional vectors.
+ */
+template <unsigned D, typename N> constexpr
+vecN_t<D, N> mix(const vecN_t<D, N>& v1, const vecN_t<D, N>& v2, N percent) noexcept;
+
+/**
+ *  @brief clamp
+ *  Clamp each component of an N-dimensional vector within a range.
+ */
+template <unsigned D, typename N> constexpr
+vecN_t<D, N> clamp(const vecN_t<D, N>& v, const vecN_t<D, N>& minVals, const vecN_t<D, N>& maxVals) noexcept;
+
+/**
+ *  @brief fmadd
+ *  Calculate (x*m)+a for each component.
+ */
+template <unsigned D, typename N> constexpr
+vecN_t<D, N> fmadd(const vecN_t<D, N>& x, const vecN_t<D, N>& m, const vecN_t<D, N>& a) noexcept;
+
+/**
+ *  @brief fmsub
+ *  Calculate (x*m)-a for each component.
+ */
+template <unsigned D, typename N> constexpr
+vecN_t<D, N> fmsub(const vecN_t<D, N>& x, const vecN_t<D, N>& m, const vecN_t<D, N>& a) noexcept;
+
 
 
 /*-----------------------------------------------------------------------------
@@ -1651,6 +2114,44 @@ constexpr vec3_t<N> vec3_cast(const N& s, const vec2_t<N>& v) noexcept;
 template <typename N>
 constexpr vec3_t<N> vec3_cast(const vec4_t<N>& v) noexcept;
 
+/**
+ * @brief Perform a cast from an aligned 3D vector to a packed 3D vector.
+ *
+ * @param v
+ * An aligned 3D Vector of type N.
+ *
+ * @return A 3D Vector containing the X, Y, and Z elements of v.
+ */
+template <typename N>
+inline vec3_t<N> vec3_cast(const vec3a_t<N>& v) noexcept;
+
+
+
+/*-------------------------------------
+    Casts to Aligned 3D Vectors
+-------------------------------------*/
+/**
+ * @brief Perform a cast from a packed 3D vector to an aligned 3D vector.
+ *
+ * @param v
+ * A 3D Vector of type N.
+ *
+ * @return An aligned 3D Vector containing the X, Y, and Z elements of v.
+ */
+template <typename N>
+inline vec3a_t<N> vec3a_cast(const vec3_t<N>& v) noexcept;
+
+/**
+ * @brief Perform a truncating cast from a 4D vector to an aligned 3D vector.
+ *
+ * @param v
+ * A 4D Vector of type N.
+ *
+ * @return An aligned 3D Vector containing the X, Y, and Z elements of v.
+ */
+template <typename N>
+inline vec3a_t<N> vec3a_cast(const vec4_t<N>& v) noexcept;
+
 
 
 /*-------------------------------------
@@ -1765,6 +2266,23 @@ constexpr vec4_t<N> vec4_cast(const vec3_t<N>& v, const N& s) noexcept;
 template <typename N>
 constexpr vec4_t<N> vec4_cast(const N& s, const vec3_t<N>& v) noexcept;
 
+/**
+ * @brief Perform a concatenating cast of an aligned 3D vector and scalar
+ * into a 4D vector.
+ *
+ * @param v
+ * An aligned 3D vector of type N to be used for the X/Y/Z components of the
+ * output vector.
+ *
+ * @param s
+ * A scalar which will construct the W-component of the output vector.
+ *
+ * @return A 4D vector containing the X/Y/Z elements of v and W component from
+ * an input scalar.
+ */
+template <typename N>
+inline vec4_t<N> vec4_cast(const vec3a_t<N>& v, const N& s) noexcept;
+
 
 
 } // end math namespace
@@ -1774,8 +2292,10 @@ constexpr vec4_t<N> vec4_cast(const N& s, const vec3_t<N>& v) noexcept;
 
 #ifdef LS_ARCH_X86
     #include "lightsky/math/x86/vecf_utils_impl.h"
+    #include "lightsky/math/x86/vecd_utils_impl.h"
 #elif defined(LS_ARM_NEON)
     #include "lightsky/math/arm/vecf_utils_impl.h"
+    #include "lightsky/math/arm/vecd_utils_impl.h"
 #endif
 
 #endif /* LS_MATH_VEC_UTILS_H */
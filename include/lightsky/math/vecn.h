@@ -0,0 +1,173 @@
+
+#ifndef LS_MATH_VECN_H
+#define LS_MATH_VECN_H
+
+#include <utility> // std::integer_sequence
+
+#include "lightsky/setup/Arch.h"
+
+#include "lightsky/math/vec2.h"
+#include "lightsky/math/vec3.h"
+#include "lightsky/math/vec4.h"
+
+namespace ls {
+namespace math {
+
+
+
+/**
+ *  @brief N-Dimensional Vector Structure
+ *
+ *  Vectors of any size, such as the 6D spatial vectors used in rigid-body
+ *  dynamics. Every operation is unrolled at compile-time and can be used in
+ *  constant expressions. At run-time, single-precision vectors are processed
+ *  using the widest SIMD registers which fit, with any remaining components
+ *  processed individually.
+ *
+ *  Prefer the "vec_t" alias over this type. Aliases of 2D, 3D, and 4D vectors
+ *  resolve to vec2_t, vec3_t, and vec4_t so they keep their own SIMD
+ *  specializations.
+ */
+template <unsigned N, typename num_t>
+struct vecN_t
+{
+    static_assert(N > 0, "N-dimensional vectors require at least one component.");
+
+    typedef num_t value_type;
+    static constexpr unsigned num_components() noexcept { return N; }
+
+    // data
+    num_t v[N];
+
+    // Main Constructor
+    template <typename... args_t>
+    constexpr vecN_t(num_t inX, num_t inY, args_t... inRest);
+
+    // Delegated Constructors
+    constexpr vecN_t() = default;
+    constexpr vecN_t(num_t n);
+    constexpr vecN_t(const vecN_t<N, num_t>& input) = default;
+    constexpr vecN_t(vecN_t<N, num_t>&& input) = default;
+
+    ~vecN_t() = default;
+
+    // Conversions & Casting
+    template <typename other_t>
+    constexpr explicit operator vecN_t<N, other_t>() const;
+
+    const num_t* operator&() const;
+    inline num_t* operator&();
+
+    // Subscripting Operators
+    template <typename index_t>
+    constexpr num_t operator[](index_t i) const;
+
+    template <typename index_t>
+    constexpr num_t& operator[](index_t i);
+
+    // vector-vector operators
+    constexpr vecN_t operator+(const vecN_t<N, num_t>&) const;
+    constexpr vecN_t operator-(const vecN_t<N, num_t>&) const;
+    constexpr vecN_t operator-() const;
+    constexpr vecN_t operator*(const vecN_t<N, num_t>&) const;
+    constexpr vecN_t operator/(const vecN_t<N, num_t>&) const;
+    constexpr vecN_t& operator=(const vecN_t<N, num_t>&) = default;
+    constexpr vecN_t& operator=(vecN_t<N, num_t>&&) = default;
+    constexpr vecN_t& operator+=(const vecN_t<N, num_t>&);
+    constexpr vecN_t& operator-=(const vecN_t<N, num_t>&);
+    constexpr vecN_t& operator*=(const vecN_t<N, num_t>&);
+    constexpr vecN_t& operator/=(const vecN_t<N, num_t>&);
+    constexpr bool operator==(const vecN_t<N, num_t>& compare) const; //comparisons
+    constexpr bool operator!=(const vecN_t<N, num_t>& compare) const;
+
+    // vector-scalar operators
+    constexpr vecN_t operator+(num_t) const;
+    constexpr vecN_t operator-(num_t) const;
+    constexpr vecN_t operator*(num_t) const;
+    constexpr vecN_t operator/(num_t) const;
+    constexpr vecN_t& operator+=(num_t);
+    constexpr vecN_t& operator-=(num_t);
+    constexpr vecN_t& operator*=(num_t);
+    constexpr vecN_t& operator/=(num_t);
+
+  private:
+    // Fills every component with a single value
+    template <unsigned... i>
+    constexpr vecN_t(num_t n, std::integer_sequence<unsigned, i...>);
+};
+
+/*-------------------------------------
+    Non-Member Vector-Scalar operations
+-------------------------------------*/
+template <unsigned N, typename num_t> constexpr
+vecN_t<N, num_t> operator+(num_t n, const vecN_t<N, num_t>& v);
+
+template <unsigned N, typename num_t> constexpr
+vecN_t<N, num_t> operator-(num_t n, const vecN_t<N, num_t>& v);
+
+template <unsigned N, typename num_t> constexpr
+vecN_t<N, num_t> operator*(num_t n, const vecN_t<N, num_t>& v);
+
+
+
+/*-------------------------------------
+    Vector Type Selection
+-------------------------------------*/
+namespace impl
+{
+
+template <unsigned N, typename num_t>
+struct VecType
+{
+    typedef vecN_t<N, num_t> type;
+};
+
+template <typename num_t>
+struct VecType<2, num_t>
+{
+    typedef vec2_t<num_t> type;
+};
+
+template <typename num_t>
+struct VecType<3, num_t>
+{
+    typedef vec3_t<num_t> type;
+};
+
+template <typename num_t>
+struct VecType<4, num_t>
+{
+    typedef vec4_t<num_t> type;
+};
+
+} // end impl namespace
+
+/**
+ *  @brief A vector with N components.
+ *
+ *  2D, 3D, and 4D vectors resolve to vec2_t, vec3_t, and vec4_t. All other
+ *  sizes use vecN_t.
+ */
+template <unsigned N, typename num_t>
+using vec_t = typename impl::VecType<N, num_t>::type;
+
+/*-------------------------------------
+    N-Dimensional Vector Specializations
+-------------------------------------*/
+typedef vecN_t<6, float>  vec6f;
+typedef vecN_t<6, double> vec6d;
+
+typedef vecN_t<6, float> vec6;
+
+} //end math namespace
+} //end ls namespace
+
+#include "lightsky/math/generic/vecn_impl.h"
+
+#ifdef LS_ARCH_X86
+    #include "lightsky/math/x86/vecnf_impl.h"
+#elif defined(LS_ARM_NEON)
+    #include "lightsky/math/arm/vecnf_impl.h"
+#endif
+
+#endif /* LS_MATH_VECN_H */
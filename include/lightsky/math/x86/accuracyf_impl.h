@@ -0,0 +1,272 @@
+
+#ifndef LS_MATH_ACCURACYF_IMPL_H
+#define LS_MATH_ACCURACYF_IMPL_H
+
+#include <immintrin.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+#include "lightsky/math/generic/simd_exp_impl.h"
+#include "lightsky/math/x86/simdf_traits_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Fast Tier
+-----------------------------------------------------------------------------*/
+namespace fast
+{
+
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> sin(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_fast_sin<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> cos(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_fast_cos<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> tan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::SimdTraits128::div(impl::simd_fast_sin<impl::SimdTraits128>(x.simd), impl::simd_fast_cos<impl::SimdTraits128>(x.simd))};
+}
+
+
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> asin(const vec4_t<float>& x) noexcept
+{
+    const __m128 c = _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(x.simd, x.simd)));
+    return vec4_t<float>{impl::simd_fast_atan2<impl::SimdTraits128>(x.simd, c)};
+}
+
+
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> acos(const vec4_t<float>& x) noexcept
+{
+    const __m128 c = _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(x.simd, x.simd)));
+    return vec4_t<float>{impl::simd_fast_atan2<impl::SimdTraits128>(c, x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_fast_atan2<impl::SimdTraits128>(x.simd, _mm_set1_ps(1.f))};
+}
+
+
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan2(const vec4_t<float>& y, const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_fast_atan2<impl::SimdTraits128>(y.simd, x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D sqrt
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> sqrt(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{_mm_sqrt_ps(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D inversesqrt
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> inversesqrt(const vec4_t<float>& x) noexcept
+{
+    const __m128 r = _mm_rsqrt_ps(x.simd);
+    const __m128 h = _mm_mul_ps(_mm_mul_ps(x.simd, r), r);
+    return vec4_t<float>{_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), r), _mm_sub_ps(_mm_set1_ps(3.f), h))};
+}
+
+} // end fast namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Balanced Tier
+-----------------------------------------------------------------------------*/
+namespace balanced
+{
+
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> sin(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_sin<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> cos(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_cos<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> tan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_tan<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> asin(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_asin<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> acos(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_acos<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_atan<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan2(const vec4_t<float>& y, const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_atan2<impl::SimdTraits128>(y.simd, x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D exp
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> exp(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_exp<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D exp2
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> exp2(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_exp2<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D log
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> log(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_log<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D log2
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> log2(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_log2<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D sqrt
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> sqrt(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{_mm_sqrt_ps(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D inversesqrt
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> inversesqrt(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{_mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(x.simd))};
+}
+
+
+
+/*-------------------------------------
+    4D rcp
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> rcp(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{_mm_div_ps(_mm_set1_ps(1.f), x.simd)};
+}
+
+} // end balanced namespace
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_ACCURACYF_IMPL_H */
@@ -0,0 +1,260 @@
+
+#ifndef LS_MATH_BATCHF_UTILS_IMPL_H
+#define LS_MATH_BATCHF_UTILS_IMPL_H
+
+#include "lightsky/math/generic/simd_slerp_impl.h"
+#include "lightsky/math/generic/simd_trig_impl.h"
+#include "lightsky/math/generic/simd_trs_impl.h"
+#include "lightsky/math/x86/simdf_traits_impl.h"
+
+namespace ls
+{
+namespace math
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    Widest Available Registers
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+#if defined(LS_X86_AVX512F)
+    typedef SimdTraits512 BatchTraits;
+#elif defined(LS_X86_AVX2)
+    typedef SimdTraits256 BatchTraits;
+#else
+    typedef SimdTraits128 BatchTraits;
+#endif
+
+} // end impl namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Trigonometric Functions
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    sin_batch
+-------------------------------------*/
+inline void sin_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_sin<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    cos_batch
+-------------------------------------*/
+inline void cos_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_cos<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    sincos_batch
+-------------------------------------*/
+inline void sincos_batch(const float* x, float* outSin, float* outCos, std::size_t count) noexcept
+{
+    impl::simd_sincos_array<impl::BatchTraits>(x, outSin, outCos, count);
+}
+
+
+
+/*-------------------------------------
+    tan_batch
+-------------------------------------*/
+inline void tan_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_tan<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    atan_batch
+-------------------------------------*/
+inline void atan_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_atan<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    atan2_batch
+-------------------------------------*/
+inline void atan2_batch(const float* y, const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_binary<impl::BatchTraits>(y, x, out, count, [](impl::BatchTraits::float_t a, impl::BatchTraits::float_t b) noexcept
+    {
+        return impl::simd_atan2<impl::BatchTraits>(a, b);
+    });
+}
+
+
+
+/*-------------------------------------
+    asin_batch
+-------------------------------------*/
+inline void asin_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_asin<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-------------------------------------
+    acos_batch
+-------------------------------------*/
+inline void acos_batch(const float* x, float* out, std::size_t count) noexcept
+{
+    impl::simd_apply_unary<impl::BatchTraits>(x, out, count, [](impl::BatchTraits::float_t v) noexcept
+    {
+        return impl::simd_acos<impl::BatchTraits>(v);
+    });
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Matrix Operations
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    mat3_transform_batch
+-------------------------------------*/
+inline void mat3_transform_batch(const mat3_t<float>& m, const vec3_t<float>* v, vec3_t<float>* out, std::size_t count) noexcept
+{
+    const float* const pM = m.m[0].v;
+    const __m128 m00 = _mm_set1_ps(pM[0]);
+    const __m128 m01 = _mm_set1_ps(pM[1]);
+    const __m128 m02 = _mm_set1_ps(pM[2]);
+    const __m128 m10 = _mm_set1_ps(pM[3]);
+    const __m128 m11 = _mm_set1_ps(pM[4]);
+    const __m128 m12 = _mm_set1_ps(pM[5]);
+    const __m128 m20 = _mm_set1_ps(pM[6]);
+    const __m128 m21 = _mm_set1_ps(pM[7]);
+    const __m128 m22 = _mm_set1_ps(pM[8]);
+
+    const float* pIn = v[0].v;
+    float* pOut = out[0].v;
+    std::size_t i = 0;
+
+    // Four vectors occupy three registers. De-interleave them into X, Y, and
+    // Z registers, transform, then interleave the results.
+    for (; i+4 <= count; i += 4, pIn += 12, pOut += 12)
+    {
+        const __m128 a = _mm_loadu_ps(pIn);   // x0 y0 z0 x1
+        const __m128 b = _mm_loadu_ps(pIn+4); // y1 z1 x2 y2
+        const __m128 c = _mm_loadu_ps(pIn+8); // z2 x3 y3 z3
+
+        const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 1, 3, 0));
+        const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        #ifdef LS_X86_FMA
+            const __m128 rx = _mm_fmadd_ps(m20, z, _mm_fmadd_ps(m10, y, _mm_mul_ps(m00, x)));
+            const __m128 ry = _mm_fmadd_ps(m21, z, _mm_fmadd_ps(m11, y, _mm_mul_ps(m01, x)));
+            const __m128 rz = _mm_fmadd_ps(m22, z, _mm_fmadd_ps(m12, y, _mm_mul_ps(m02, x)));
+        #else
+            const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), _mm_mul_ps(m20, z));
+            const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m21, z));
+            const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, x), _mm_mul_ps(m12, y)), _mm_mul_ps(m22, z));
+        #endif
+
+        const __m128 outA = _mm_shuffle_ps(_mm_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 outB = _mm_shuffle_ps(_mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 outC = _mm_shuffle_ps(_mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        _mm_storeu_ps(pOut,   outA);
+        _mm_storeu_ps(pOut+4, outB);
+        _mm_storeu_ps(pOut+8, outC);
+    }
+
+    for (; i < count; ++i)
+    {
+        out[i] = m * v[i];
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Quaternion Interpolation
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    slerp_batch
+-------------------------------------*/
+inline void slerp_batch(const quat_t<float>* a, const quat_t<float>* b, const float* t, quat_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_quat_interpolate<impl::BatchTraits, false>(a->q, b->q, t, out->q, count, impl::simd_slerp_weights<impl::BatchTraits>);
+}
+
+
+
+/*-------------------------------------
+    fast_slerp_batch
+-------------------------------------*/
+inline void fast_slerp_batch(const quat_t<float>* a, const quat_t<float>* b, const float* t, quat_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_quat_interpolate<impl::BatchTraits, false>(a->q, b->q, t, out->q, count, impl::simd_fast_slerp_weights<impl::BatchTraits>);
+}
+
+
+
+/*-------------------------------------
+    nlerp_batch
+-------------------------------------*/
+inline void nlerp_batch(const quat_t<float>* a, const quat_t<float>* b, const float* t, quat_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_quat_interpolate<impl::BatchTraits, true>(a->q, b->q, t, out->q, count, impl::simd_lerp_weights<impl::BatchTraits>);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Batched Transform Composition
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    compose_trs_batch
+-------------------------------------*/
+inline void compose_trs_batch(const vec3_t<float>* t, const quat_t<float>* r, const vec3_t<float>* s, mat4_t<float>* out, std::size_t count) noexcept
+{
+    impl::simd_compose_trs<impl::SimdTraits128>(t, r, s, out, count);
+}
+
+
+
+/*-------------------------------------
+    decompose_batch
+-------------------------------------*/
+inline void decompose_batch(const mat4_t<float>* m, vec3_t<float>* outT, quat_t<float>* outR, vec3_t<float>* outS, std::size_t count) noexcept
+{
+    impl::simd_decompose_trs<impl::SimdTraits128>(m, outT, outR, outS, count);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_BATCHF_UTILS_IMPL_H */
@@ -0,0 +1,64 @@
+
+#ifndef LS_MATH_MAT2F_IMPL_H
+#define LS_MATH_MAT2F_IMPL_H
+
+#include <emmintrin.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+
+
+/*-------------------------------------
+    Matrix-Matrix Math Operations
+-------------------------------------*/
+template <>
+inline LS_INLINE mat2_t<float> mat2_t<float>::operator*(const mat2_t<float>& n) const
+{
+    mat2_t<float> ret;
+
+    // The whole matrix fits in a single register
+    const __m128 a = _mm_loadu_ps(this->m[0].v);
+    const __m128 b = _mm_loadu_ps(n.m[0].v);
+
+    const __m128 col0 = _mm_movelh_ps(a, a);
+    const __m128 col1 = _mm_movehl_ps(a, a);
+
+    #ifdef LS_X86_FMA
+        const __m128 r = _mm_fmadd_ps(col1, _mm_shuffle_ps(b, b, 0xF5), _mm_mul_ps(col0, _mm_shuffle_ps(b, b, 0xA0)));
+    #else
+        const __m128 r = _mm_add_ps(_mm_mul_ps(col1, _mm_shuffle_ps(b, b, 0xF5)), _mm_mul_ps(col0, _mm_shuffle_ps(b, b, 0xA0)));
+    #endif
+
+    _mm_storeu_ps(ret.m[0].v, r);
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Vector-Matrix Math Operations (Declared in the 2D Vector header)
+-------------------------------------*/
+template <>
+inline LS_INLINE vec2_t<float> mat2_t<float>::operator*(const vec2_t<float>& v) const
+{
+    vec2_t<float> ret;
+
+    const __m128 a = _mm_loadu_ps(this->m[0].v);
+    const __m128 s = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(v.v));
+
+    // (m00*x, m01*x, m10*y, m11*y), then add each half
+    const __m128 p = _mm_mul_ps(a, _mm_unpacklo_ps(s, s));
+    _mm_storel_pi(reinterpret_cast<__m64*>(ret.v), _mm_add_ps(p, _mm_movehl_ps(p, p)));
+
+    return ret;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MAT2F_IMPL_H */
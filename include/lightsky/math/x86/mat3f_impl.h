@@ -0,0 +1,109 @@
+
+#ifndef LS_MATH_MAT3F_IMPL_H
+#define LS_MATH_MAT3F_IMPL_H
+
+#include <emmintrin.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+
+    A 3x3 matrix occupies 9 contiguous floats. The first two columns are
+    loaded with 4 elements each, picking up the first element of the
+    following column in their W component. The last column is loaded from
+    one element earlier, then shifted, so no read extends past the end of
+    the matrix. The W component of any result is therefore meaningless and
+    never stored.
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Load the columns of a 3x3 matrix
+-------------------------------------*/
+inline LS_INLINE void mat3f_load(const mat3_t<float>& m, __m128& c0, __m128& c1, __m128& c2) noexcept
+{
+    c0 = _mm_loadu_ps(m.m[0].v);
+    c1 = _mm_loadu_ps(m.m[1].v);
+    c2 = _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(_mm_loadu_ps(m.m[1].v+2)), 4));
+}
+
+/*-------------------------------------
+    Store the XYZ components of a register
+-------------------------------------*/
+inline LS_INLINE void vec3f_store(float* p, __m128 v) noexcept
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+    _mm_store_ss(p+2, _mm_movehl_ps(v, v));
+}
+
+/*-------------------------------------
+    Linear combination of three columns
+-------------------------------------*/
+inline LS_INLINE __m128 mat3f_mul_vec(__m128 c0, __m128 c1, __m128 c2, __m128 x, __m128 y, __m128 z) noexcept
+{
+    #ifdef LS_X86_FMA
+        return _mm_fmadd_ps(c2, z, _mm_fmadd_ps(c1, y, _mm_mul_ps(c0, x)));
+    #else
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_mul_ps(c2, z));
+    #endif
+}
+
+} // end impl namespace
+
+
+
+/*-------------------------------------
+    Matrix-Matrix Math Operations
+-------------------------------------*/
+template <>
+inline LS_INLINE mat3_t<float> mat3_t<float>::operator*(const mat3_t<float>& n) const
+{
+    mat3_t<float> ret;
+    __m128 c0, c1, c2;
+    __m128 n0, n1, n2;
+
+    impl::mat3f_load(*this, c0, c1, c2);
+    impl::mat3f_load(n, n0, n1, n2);
+
+    const __m128 r0 = impl::mat3f_mul_vec(c0, c1, c2, _mm_shuffle_ps(n0, n0, 0x00), _mm_shuffle_ps(n0, n0, 0x55), _mm_shuffle_ps(n0, n0, 0xAA));
+    const __m128 r1 = impl::mat3f_mul_vec(c0, c1, c2, _mm_shuffle_ps(n1, n1, 0x00), _mm_shuffle_ps(n1, n1, 0x55), _mm_shuffle_ps(n1, n1, 0xAA));
+    const __m128 r2 = impl::mat3f_mul_vec(c0, c1, c2, _mm_shuffle_ps(n2, n2, 0x00), _mm_shuffle_ps(n2, n2, 0x55), _mm_shuffle_ps(n2, n2, 0xAA));
+
+    // The W component of each column is overwritten by the next store
+    _mm_storeu_ps(ret.m[0].v, r0);
+    _mm_storeu_ps(ret.m[1].v, r1);
+    impl::vec3f_store(ret.m[2].v, r2);
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Vector-Matrix Math Operations (Declared in the 3D Vector header)
+-------------------------------------*/
+template <>
+inline LS_INLINE vec3_t<float> mat3_t<float>::operator*(const vec3_t<float>& v) const
+{
+    vec3_t<float> ret;
+    __m128 c0, c1, c2;
+
+    impl::mat3f_load(*this, c0, c1, c2);
+    impl::vec3f_store(ret.v, impl::mat3f_mul_vec(c0, c1, c2, _mm_set1_ps(v.v[0]), _mm_set1_ps(v.v[1]), _mm_set1_ps(v.v[2])));
+
+    return ret;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MAT3F_IMPL_H */
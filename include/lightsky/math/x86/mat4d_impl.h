@@ -0,0 +1,84 @@
+
+#ifndef LS_MATH_MAT4D_IMPL_H
+#define LS_MATH_MAT4D_IMPL_H
+
+#include <immintrin.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls {
+namespace math {
+
+
+
+#if defined(LS_X86_AVX)
+
+/*-------------------------------------
+    Matrix-Matrix Math Operations
+-------------------------------------*/
+template <>
+inline LS_INLINE mat4_t<double> mat4_t<double>::operator*(const mat4_t<double>& n) const
+{
+    mat4_t<double> ret;
+
+    const __m256d col0 = _mm256_loadu_pd(this->m[0].v);
+    const __m256d col1 = _mm256_loadu_pd(this->m[1].v);
+    const __m256d col2 = _mm256_loadu_pd(this->m[2].v);
+    const __m256d col3 = _mm256_loadu_pd(this->m[3].v);
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        const double* const s = n.m[i].v;
+
+        #ifdef LS_X86_FMA
+            const __m256d r0 = _mm256_mul_pd(  col0, _mm256_broadcast_sd(s+0));
+            const __m256d r1 = _mm256_fmadd_pd(col1, _mm256_broadcast_sd(s+1), r0);
+            const __m256d r2 = _mm256_mul_pd(  col2, _mm256_broadcast_sd(s+2));
+            const __m256d r3 = _mm256_fmadd_pd(col3, _mm256_broadcast_sd(s+3), r2);
+        #else
+            const __m256d r0 = _mm256_mul_pd(col0, _mm256_broadcast_sd(s+0));
+            const __m256d r1 = _mm256_add_pd(_mm256_mul_pd(col1, _mm256_broadcast_sd(s+1)), r0);
+            const __m256d r2 = _mm256_mul_pd(col2, _mm256_broadcast_sd(s+2));
+            const __m256d r3 = _mm256_add_pd(_mm256_mul_pd(col3, _mm256_broadcast_sd(s+3)), r2);
+        #endif
+
+        _mm256_storeu_pd(ret.m[i].v, _mm256_add_pd(r1, r3));
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Vector-Matrix Math Operations (Declared in the 4D Vector header)
+-------------------------------------*/
+template <> inline LS_INLINE
+vec4_t<double> mat4_t<double>::operator*(const vec4_t<double>& v) const
+{
+    vec4_t<double> ret;
+
+    #ifdef LS_X86_FMA
+        const __m256d v0 = _mm256_mul_pd(  _mm256_loadu_pd(this->m[0].v), _mm256_broadcast_sd(v.v+0));
+        const __m256d v1 = _mm256_fmadd_pd(_mm256_loadu_pd(this->m[1].v), _mm256_broadcast_sd(v.v+1), v0);
+        const __m256d v2 = _mm256_mul_pd(  _mm256_loadu_pd(this->m[2].v), _mm256_broadcast_sd(v.v+2));
+        const __m256d v3 = _mm256_fmadd_pd(_mm256_loadu_pd(this->m[3].v), _mm256_broadcast_sd(v.v+3), v2);
+    #else
+        const __m256d v0 = _mm256_mul_pd(_mm256_loadu_pd(this->m[0].v), _mm256_broadcast_sd(v.v+0));
+        const __m256d v1 = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(this->m[1].v), _mm256_broadcast_sd(v.v+1)), v0);
+        const __m256d v2 = _mm256_mul_pd(_mm256_loadu_pd(this->m[2].v), _mm256_broadcast_sd(v.v+2));
+        const __m256d v3 = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(this->m[3].v), _mm256_broadcast_sd(v.v+3)), v2);
+    #endif
+
+    _mm256_storeu_pd(ret.v, _mm256_add_pd(v1, v3));
+    return ret;
+}
+
+#endif /* LS_X86_AVX */
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MAT4D_IMPL_H */
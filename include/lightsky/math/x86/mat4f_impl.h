@@ -15,7 +15,28 @@ namespace math {
 template <>
 inline LS_INLINE mat4_t<float> mat4_t<float>::operator*(const mat4_t<float>& n) const
 {
-    #ifdef LS_X86_AVX2
+    #if defined(LS_X86_AVX512F)
+        // Each 128-bit lane computes one column of the product, so all four
+        // column products share a single register. Zero-masked intrinsics
+        // are used for the reasons given in SimdTraits512.
+        alignas(sizeof(__m128)) mat4_t<float> ret;
+
+        const __m512 col0 = _mm512_maskz_broadcast_f32x4((__mmask16)0xFFFF, m[0].simd);
+        const __m512 col1 = _mm512_maskz_broadcast_f32x4((__mmask16)0xFFFF, m[1].simd);
+        const __m512 col2 = _mm512_maskz_broadcast_f32x4((__mmask16)0xFFFF, m[2].simd);
+        const __m512 col3 = _mm512_maskz_broadcast_f32x4((__mmask16)0xFFFF, m[3].simd);
+        const __m512 temp = _mm512_loadu_ps(n.m[0].v);
+
+        __m512 r;
+        r = _mm512_mul_ps(  col0, _mm512_maskz_permute_ps((__mmask16)0xFFFF, temp, 0x00));
+        r = _mm512_fmadd_ps(col1, _mm512_maskz_permute_ps((__mmask16)0xFFFF, temp, 0x55), r);
+        r = _mm512_fmadd_ps(col2, _mm512_maskz_permute_ps((__mmask16)0xFFFF, temp, 0xAA), r);
+        r = _mm512_fmadd_ps(col3, _mm512_maskz_permute_ps((__mmask16)0xFFFF, temp, 0xFF), r);
+        _mm512_storeu_ps(ret.m[0].v, r);
+
+        return ret;
+
+    #elif defined(LS_X86_AVX2)
         alignas(sizeof(__m256)) mat4_t<float> ret;
 
         const __m256 col0 = _mm256_insertf128_ps(_mm256_castps128_ps256(m[0].simd), m[0].simd, 1);
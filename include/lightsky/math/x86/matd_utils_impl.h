@@ -0,0 +1,206 @@
+
+#ifndef LS_MATH_MATD_UTILS_IMPL_H
+#define LS_MATH_MATD_UTILS_IMPL_H
+
+#include <immintrin.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+namespace math
+{
+
+
+
+#if defined(LS_X86_AVX)
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+
+    The 4x4 inverse and determinant treat a matrix as four 2x2 blocks, each
+    packed into one register as (m00, m01, m10, m11):
+        | A B |
+        | C D |
+    Inverting the transpose of a matrix yields the transpose of its inverse,
+    so the same code works on columns as well as rows.
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    2x2 Matrix Multiply: A*B
+-------------------------------------*/
+inline LS_INLINE __m256d mat2d_mul(__m256d a, __m256d b) noexcept
+{
+    const __m256d t = _mm256_mul_pd(permute4_pd<1, 0, 3, 2>(a), permute4_pd<2, 1, 2, 1>(b));
+
+    #ifdef LS_X86_FMA
+        return _mm256_fmadd_pd(a, permute4_pd<0, 3, 0, 3>(b), t);
+    #else
+        return _mm256_add_pd(_mm256_mul_pd(a, permute4_pd<0, 3, 0, 3>(b)), t);
+    #endif
+}
+
+/*-------------------------------------
+    2x2 Adjugate Multiply: adj(A)*B
+-------------------------------------*/
+inline LS_INLINE __m256d mat2d_adj_mul(__m256d a, __m256d b) noexcept
+{
+    const __m256d t = _mm256_mul_pd(permute4_pd<1, 1, 2, 2>(a), permute4_pd<2, 3, 0, 1>(b));
+
+    #ifdef LS_X86_FMA
+        return _mm256_fmsub_pd(permute4_pd<3, 3, 0, 0>(a), b, t);
+    #else
+        return _mm256_sub_pd(_mm256_mul_pd(permute4_pd<3, 3, 0, 0>(a), b), t);
+    #endif
+}
+
+/*-------------------------------------
+    2x2 Multiply Adjugate: A*adj(B)
+-------------------------------------*/
+inline LS_INLINE __m256d mat2d_mul_adj(__m256d a, __m256d b) noexcept
+{
+    const __m256d t = _mm256_mul_pd(permute4_pd<1, 0, 3, 2>(a), permute4_pd<2, 1, 2, 1>(b));
+
+    #ifdef LS_X86_FMA
+        return _mm256_fmsub_pd(a, permute4_pd<3, 0, 3, 0>(b), t);
+    #else
+        return _mm256_sub_pd(_mm256_mul_pd(a, permute4_pd<3, 0, 3, 0>(b)), t);
+    #endif
+}
+
+/*-------------------------------------
+    Determinants of all four 2x2 blocks, as (|A|, |C|, |B|, |D|)
+-------------------------------------*/
+inline LS_INLINE __m256d mat2d_block_dets(__m256d r0, __m256d r1, __m256d r2, __m256d r3) noexcept
+{
+    const __m256d a = _mm256_mul_pd(_mm256_unpacklo_pd(r0, r2), _mm256_unpackhi_pd(r1, r3));
+    const __m256d b = _mm256_mul_pd(_mm256_unpackhi_pd(r0, r2), _mm256_unpacklo_pd(r1, r3));
+    return _mm256_sub_pd(a, b);
+}
+
+} // end impl namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    4x4 Matrices
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    4x4 Determinant
+-------------------------------------*/
+inline LS_INLINE double determinant(const mat4_t<double>& m4x4) noexcept
+{
+    const __m256d r0 = _mm256_loadu_pd(m4x4.m[0].v);
+    const __m256d r1 = _mm256_loadu_pd(m4x4.m[1].v);
+    const __m256d r2 = _mm256_loadu_pd(m4x4.m[2].v);
+    const __m256d r3 = _mm256_loadu_pd(m4x4.m[3].v);
+
+    const __m256d a = _mm256_permute2f128_pd(r0, r1, 0x20);
+    const __m256d b = _mm256_permute2f128_pd(r0, r1, 0x31);
+    const __m256d c = _mm256_permute2f128_pd(r2, r3, 0x20);
+    const __m256d d = _mm256_permute2f128_pd(r2, r3, 0x31);
+
+    // |M| = |A|*|D| + |B|*|C| - tr(adj(A)*B * adj(D)*C)
+    const __m256d dets = impl::mat2d_block_dets(r0, r1, r2, r3);
+    const __m256d dc   = impl::mat2d_adj_mul(d, c);
+    const __m256d ab   = impl::mat2d_adj_mul(a, b);
+    const __m256d tr   = _mm256_mul_pd(ab, impl::permute4_pd<0, 2, 1, 3>(dc));
+
+    // (|A|*|D|, |C|*|B|, ...)
+    const __m256d detProducts = _mm256_mul_pd(dets, impl::permute4_pd<3, 2, 1, 0>(dets));
+    const __m128d detSum = _mm_add_sd(_mm256_castpd256_pd128(detProducts), _mm_unpackhi_pd(_mm256_castpd256_pd128(detProducts), _mm256_castpd256_pd128(detProducts)));
+
+    return _mm_cvtsd_f64(detSum) - _mm_cvtsd_f64(_mm256_castpd256_pd128(impl::sum4_pd(tr)));
+}
+
+/*-------------------------------------
+    4x4 Inverse
+-------------------------------------*/
+inline LS_INLINE mat4_t<double> inverse(const mat4_t<double>& m4x4) noexcept
+{
+    mat4_t<double> ret;
+
+    const __m256d r0 = _mm256_loadu_pd(m4x4.m[0].v);
+    const __m256d r1 = _mm256_loadu_pd(m4x4.m[1].v);
+    const __m256d r2 = _mm256_loadu_pd(m4x4.m[2].v);
+    const __m256d r3 = _mm256_loadu_pd(m4x4.m[3].v);
+
+    const __m256d a = _mm256_permute2f128_pd(r0, r1, 0x20);
+    const __m256d b = _mm256_permute2f128_pd(r0, r1, 0x31);
+    const __m256d c = _mm256_permute2f128_pd(r2, r3, 0x20);
+    const __m256d d = _mm256_permute2f128_pd(r2, r3, 0x31);
+
+    const __m256d dets = impl::mat2d_block_dets(r0, r1, r2, r3);
+    const __m256d detA = impl::permute4_pd<0, 0, 0, 0>(dets);
+    const __m256d detC = impl::permute4_pd<1, 1, 1, 1>(dets);
+    const __m256d detB = impl::permute4_pd<2, 2, 2, 2>(dets);
+    const __m256d detD = impl::permute4_pd<3, 3, 3, 3>(dets);
+
+    const __m256d dc = impl::mat2d_adj_mul(d, c);
+    const __m256d ab = impl::mat2d_adj_mul(a, b);
+
+    // Adjugates of each block of the inverse
+    __m256d x = _mm256_sub_pd(_mm256_mul_pd(detD, a), impl::mat2d_mul(b, dc));
+    __m256d w = _mm256_sub_pd(_mm256_mul_pd(detA, d), impl::mat2d_mul(c, ab));
+    __m256d y = _mm256_sub_pd(_mm256_mul_pd(detB, c), impl::mat2d_mul_adj(d, ab));
+    __m256d z = _mm256_sub_pd(_mm256_mul_pd(detC, b), impl::mat2d_mul_adj(a, dc));
+
+    // |M| = |A|*|D| + |B|*|C| - tr(adj(A)*B * adj(D)*C)
+    const __m256d tr = impl::sum4_pd(_mm256_mul_pd(ab, impl::permute4_pd<0, 2, 1, 3>(dc)));
+    const __m256d detM = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(detA, detD), _mm256_mul_pd(detB, detC)), tr);
+    const __m256d rDetM = _mm256_div_pd(_mm256_setr_pd(1.0, -1.0, -1.0, 1.0), detM);
+
+    x = _mm256_mul_pd(x, rDetM);
+    y = _mm256_mul_pd(y, rDetM);
+    z = _mm256_mul_pd(z, rDetM);
+    w = _mm256_mul_pd(w, rDetM);
+
+    // Undo the adjugate of each block while interleaving them into rows
+    const __m256d xy0 = _mm256_permute2f128_pd(x, y, 0x20);
+    const __m256d xy1 = _mm256_permute2f128_pd(x, y, 0x31);
+    const __m256d zw0 = _mm256_permute2f128_pd(z, w, 0x20);
+    const __m256d zw1 = _mm256_permute2f128_pd(z, w, 0x31);
+
+    _mm256_storeu_pd(ret.m[0].v, _mm256_unpackhi_pd(xy1, xy0));
+    _mm256_storeu_pd(ret.m[1].v, _mm256_unpacklo_pd(xy1, xy0));
+    _mm256_storeu_pd(ret.m[2].v, _mm256_unpackhi_pd(zw1, zw0));
+    _mm256_storeu_pd(ret.m[3].v, _mm256_unpacklo_pd(zw1, zw0));
+
+    return ret;
+}
+
+/*-------------------------------------
+    4x4 Transpose
+-------------------------------------*/
+inline LS_INLINE mat4_t<double> transpose(const mat4_t<double>& m4x4) noexcept
+{
+    mat4_t<double> ret;
+
+    const __m256d r0 = _mm256_loadu_pd(m4x4.m[0].v);
+    const __m256d r1 = _mm256_loadu_pd(m4x4.m[1].v);
+    const __m256d r2 = _mm256_loadu_pd(m4x4.m[2].v);
+    const __m256d r3 = _mm256_loadu_pd(m4x4.m[3].v);
+
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(ret.m[0].v, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(ret.m[1].v, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(ret.m[2].v, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(ret.m[3].v, _mm256_permute2f128_pd(t1, t3, 0x31));
+
+    return ret;
+}
+
+#endif /* LS_X86_AVX */
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_MATD_UTILS_IMPL_H */
@@ -284,7 +284,13 @@ inline LS_INLINE mat4_t<float> mat_row_mul(const mat4_t<float>& m, const vec4_t<
 -------------------------------------*/
 inline LS_INLINE mat4_t<float> transpose(const mat4_t<float>& m)
 {
-    #if 1
+    #if defined(LS_X86_AVX512F)
+        alignas(sizeof(__m128)) mat4_t<float> ret;
+        const __m512i indices = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+        _mm512_storeu_ps(ret.m[0].v, _mm512_maskz_permutexvar_ps((__mmask16)0xFFFF, indices, _mm512_loadu_ps(m.m[0].v)));
+        return ret;
+
+    #elif 1
         const __m128 m0 = _mm_loadu_ps(&m[0]);
         const __m128 m1 = _mm_loadu_ps(&m[1]);
         const __m128 m2 = _mm_loadu_ps(&m[2]);
@@ -0,0 +1,304 @@
+
+#ifndef LS_MATH_QUATF_IMPL_H
+#define LS_MATH_QUATF_IMPL_H
+
+#include <type_traits>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+extern "C" {
+    #include <immintrin.h>
+}
+
+
+
+namespace ls
+{
+namespace math
+{
+
+
+
+template<>
+union alignas(alignof(__m128)) quat_t<float>
+{
+    // data
+    __m128 simd;
+
+    float q[4];
+
+    ~quat_t() = default;
+
+    quat_t() = default;
+
+    constexpr quat_t(float inX, float inY, float inZ, float inW);
+
+    constexpr quat_t(float xyz, float w);
+
+    explicit constexpr quat_t(__m128 n);
+
+    quat_t(const quat_t<float>&) = default;
+
+    quat_t(quat_t<float>&&) = default;
+
+    // Conversions & Casting
+    template <typename other_t>
+    inline explicit operator quat_t<other_t>() const;
+
+    inline const float* operator&() const;
+
+    inline float* operator&();
+
+    // Subscripting Operators
+    template <typename index_t>
+    constexpr float operator[](index_t i) const;
+
+    template <typename index_t>
+    inline float& operator[](index_t i);
+
+    //quaternion-quaternion operators
+    quat_t& operator++(); //prefix operators
+    quat_t& operator--();
+    quat_t operator++(int); //postfix operators
+    quat_t operator--(int);
+    quat_t operator-() const;
+    quat_t operator+(const quat_t<float>& input) const;
+    quat_t operator-(const quat_t<float>& input) const;
+    quat_t operator*(const quat_t<float>& input) const;
+    quat_t& operator=(const quat_t<float>&) = default;
+    quat_t& operator=(quat_t<float>&&) = default;
+    quat_t& operator+=(const quat_t<float>& input);
+    quat_t& operator-=(const quat_t<float>& input);
+    quat_t& operator*=(const quat_t<float>& input);
+    bool operator==(const quat_t<float>& input) const;
+    bool operator!=(const quat_t<float>& input) const;
+
+    //quaternion-scalar operators
+    quat_t operator+(float) const;
+    quat_t operator-(float) const;
+    quat_t operator*(float) const;
+    quat_t operator/(float) const;
+    quat_t& operator=(float);
+    quat_t& operator+=(float);
+    quat_t& operator-=(float);
+    quat_t& operator*=(float);
+    quat_t& operator/=(float);
+};
+
+static_assert(std::is_trivial<quat_t<float>>::value, "Quatf must be trivial.");
+
+
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+constexpr LS_INLINE quat_t<float>::quat_t(float inX, float inY, float inZ, float inW) :
+    q{inX, inY, inZ, inW}
+{}
+
+constexpr LS_INLINE quat_t<float>::quat_t(float xyz, float w) :
+    q{xyz, xyz, xyz, w}
+{}
+
+constexpr LS_INLINE quat_t<float>::quat_t(__m128 n) :
+    simd(n)
+{}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template <typename other_t>
+inline LS_INLINE quat_t<float>::operator quat_t<other_t>() const
+{
+    return quat_t<other_t>{(other_t)q[0], (other_t)q[1], (other_t)q[2], (other_t)q[3]};
+}
+
+inline LS_INLINE const float* quat_t<float>::operator&() const
+{
+    return q;
+}
+
+inline LS_INLINE float* quat_t<float>::operator&()
+{
+    return q;
+}
+
+/*-------------------------------------
+    Subscripting Operators
+-------------------------------------*/
+template <typename index_t>
+constexpr LS_INLINE float quat_t<float>::operator[](index_t i) const
+{
+    return q[i];
+}
+
+template <typename index_t>
+inline LS_INLINE float& quat_t<float>::operator[](index_t i)
+{
+    return q[i];
+}
+
+/*-------------------------------------
+    Quaternion-Quaternion Operators
+-------------------------------------*/
+// prefix operators
+inline LS_INLINE quat_t<float>& quat_t<float>::operator++()
+{
+    simd = _mm_add_ps(simd, _mm_set1_ps(1.f));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator--()
+{
+    simd = _mm_sub_ps(simd, _mm_set1_ps(1.f));
+    return *this;
+}
+
+// postfix operators, which match the generic implementation by returning
+// the modified value
+inline LS_INLINE quat_t<float> quat_t<float>::operator++(int)
+{
+    simd = _mm_add_ps(simd, _mm_set1_ps(1.f));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator--(int)
+{
+    simd = _mm_sub_ps(simd, _mm_set1_ps(1.f));
+    return *this;
+}
+
+// conjugate
+inline LS_INLINE quat_t<float> quat_t<float>::operator-() const
+{
+    return quat_t<float>{_mm_xor_ps(simd, _mm_set_ps(0.f, -0.f, -0.f, -0.f))};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator+(const quat_t<float>& input) const
+{
+    return quat_t<float>{_mm_add_ps(simd, input.simd)};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator-(const quat_t<float>& input) const
+{
+    return quat_t<float>{_mm_sub_ps(simd, input.simd)};
+}
+
+// Hamilton product. Each lane of the left-hand quaternion is broadcast and
+// multiplied by a permutation of the right-hand quaternion with its signs
+// flipped to match the scalar expansion.
+inline LS_INLINE quat_t<float> quat_t<float>::operator*(const quat_t<float>& input) const
+{
+    const __m128 a = simd;
+    const __m128 b = input.simd;
+
+    const __m128 wzyx = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-0.f, 0.f, -0.f, 0.f));
+    const __m128 zwxy = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-0.f, -0.f, 0.f, 0.f));
+    const __m128 yxwz = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-0.f, 0.f, 0.f, -0.f));
+
+    const __m128 x = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 y = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 w = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+
+    #ifdef LS_X86_FMA
+        __m128 ret = _mm_mul_ps(w, b);
+        ret = _mm_fmadd_ps(x, wzyx, ret);
+        ret = _mm_fmadd_ps(y, zwxy, ret);
+        ret = _mm_fmadd_ps(z, yxwz, ret);
+    #else
+        __m128 ret = _mm_mul_ps(w, b);
+        ret = _mm_add_ps(ret, _mm_mul_ps(x, wzyx));
+        ret = _mm_add_ps(ret, _mm_mul_ps(y, zwxy));
+        ret = _mm_add_ps(ret, _mm_mul_ps(z, yxwz));
+    #endif
+
+    return quat_t<float>{ret};
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator+=(const quat_t<float>& input)
+{
+    simd = _mm_add_ps(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator-=(const quat_t<float>& input)
+{
+    simd = _mm_sub_ps(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator*=(const quat_t<float>& input)
+{
+    return *this = *this * input;
+}
+
+inline LS_INLINE bool quat_t<float>::operator==(const quat_t<float>& compare) const
+{
+    return _mm_movemask_ps(_mm_cmpeq_ps(simd, compare.simd)) == 0x0F;
+}
+
+inline LS_INLINE bool quat_t<float>::operator!=(const quat_t<float>& compare) const
+{
+    return _mm_movemask_ps(_mm_cmpneq_ps(simd, compare.simd)) != 0;
+}
+
+/*-------------------------------------
+    Quaternion-Scalar Operators
+-------------------------------------*/
+inline LS_INLINE quat_t<float> quat_t<float>::operator+(float input) const
+{
+    return quat_t<float>{_mm_add_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator-(float input) const
+{
+    return quat_t<float>{_mm_sub_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator*(float input) const
+{
+    return quat_t<float>{_mm_mul_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE quat_t<float> quat_t<float>::operator/(float input) const
+{
+    return quat_t<float>{_mm_div_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator=(float input)
+{
+    simd = _mm_set1_ps(input);
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator+=(float input)
+{
+    simd = _mm_add_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator-=(float input)
+{
+    simd = _mm_sub_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator*=(float input)
+{
+    simd = _mm_mul_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+inline LS_INLINE quat_t<float>& quat_t<float>::operator/=(float input)
+{
+    simd = _mm_div_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_QUATF_IMPL_H */
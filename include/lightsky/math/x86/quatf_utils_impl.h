@@ -12,15 +12,18 @@ namespace math
 
 
 /*-----------------------------------------------------------------------------
-    Quaternion Utilities
+    Internal Helpers
 -----------------------------------------------------------------------------*/
+namespace impl
+{
+
 /*-------------------------------------
-    4D Dot
+    4D dot product, broadcast to every element
 -------------------------------------*/
-inline LS_INLINE float dot(const quat_t<float>& q1, const quat_t<float>& q2)
+inline LS_INLINE __m128 quatf_dot(const __m128 q1, const __m128 q2) noexcept
 {
     // horizontal add
-    const __m128 a = _mm_mul_ps(_mm_loadu_ps(q1.q), _mm_loadu_ps(q2.q));
+    const __m128 a = _mm_mul_ps(q1, q2);
 
     // swap the words of each vector
     const __m128 b = _mm_shuffle_ps(a, a, 0xB1);
@@ -28,31 +31,145 @@ inline LS_INLINE float dot(const quat_t<float>& q1, const quat_t<float>& q2)
 
     // swap each half of the vector
     const __m128 d = _mm_shuffle_ps(c, c, 0x0F);
-    const __m128 e = _mm_add_ps(c, d);
+    return _mm_add_ps(c, d);
+}
+
+/*-------------------------------------
+    Rotate the XYZ elements of a vector by a quaternion
 
-    return _mm_cvtss_f32(e);
+    v' = v + w*t + cross(q, t), where t = cross(2q, v)
+-------------------------------------*/
+inline LS_INLINE __m128 quatf_rotate(const __m128 v, const __m128 q) noexcept
+{
+    const __m128 u = _mm_and_ps(q, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+    const __m128 w = _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128 t = math::cross(vec4_t<float>{_mm_add_ps(u, u)}, vec4_t<float>{v}).simd;
+    const __m128 ut = math::cross(vec4_t<float>{u}, vec4_t<float>{t}).simd;
+
+    #ifdef LS_X86_FMA
+        return _mm_add_ps(_mm_fmadd_ps(w, t, v), ut);
+    #else
+        return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(w, t)), ut);
+    #endif
 }
 
 /*-------------------------------------
-    4D Magnitude-Squared
+    Columns of a rotation matrix. The W element of each column is
+    meaningless.
 -------------------------------------*/
-inline LS_INLINE float length_squared(const quat_t<float>& q)
+inline LS_INLINE void quatf_to_cols(const __m128 q, __m128& c0, __m128& c1, __m128& c2) noexcept
 {
-    // cache
-    const __m128 s = _mm_loadu_ps(q.q);
+    const __m128 q2 = _mm_add_ps(q, q);
 
-    // horizontal add
-    const __m128 a = _mm_mul_ps(s, s);
+    // c0 = (1, 0, 0) + (-y, x, x)*(2y, 2y, 2z) + (-z, w, -w)*(2z, 2z, 2y)
+    const __m128 a0 = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 0, 1)), _mm_set_ps(0.f, 0.f, 0.f, -0.f));
+    const __m128 b0 = _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 1, 1));
+    const __m128 e0 = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 2)), _mm_set_ps(0.f, -0.f, 0.f, -0.f));
+    const __m128 f0 = _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 2, 2));
+
+    // c1 = (0, 1, 0) + (x, -x, y)*(2y, 2x, 2z) + (-z, -z, x)*(2w, 2z, 2w)
+    const __m128 a1 = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 0, 0)), _mm_set_ps(0.f, 0.f, -0.f, 0.f));
+    const __m128 b1 = _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 0, 1));
+    const __m128 e1 = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 2, 2)), _mm_set_ps(0.f, 0.f, -0.f, -0.f));
+    const __m128 f1 = _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 3, 2, 3));
+
+    // c2 = (0, 0, 1) + (x, y, -x)*(2z, 2z, 2x) + (y, -x, -y)*(2w, 2w, 2y)
+    const __m128 a2 = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 1, 0)), _mm_set_ps(0.f, -0.f, 0.f, 0.f));
+    const __m128 b2 = _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 2));
+    const __m128 e2 = _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 0, 1)), _mm_set_ps(0.f, -0.f, -0.f, 0.f));
+    const __m128 f2 = _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 3, 3));
+
+    #ifdef LS_X86_FMA
+        c0 = _mm_fmadd_ps(a0, b0, _mm_fmadd_ps(e0, f0, _mm_set_ps(0.f, 0.f, 0.f, 1.f)));
+        c1 = _mm_fmadd_ps(a1, b1, _mm_fmadd_ps(e1, f1, _mm_set_ps(0.f, 0.f, 1.f, 0.f)));
+        c2 = _mm_fmadd_ps(a2, b2, _mm_fmadd_ps(e2, f2, _mm_set_ps(0.f, 1.f, 0.f, 0.f)));
+    #else
+        c0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(e0, f0)), _mm_set_ps(0.f, 0.f, 0.f, 1.f));
+        c1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a1, b1), _mm_mul_ps(e1, f1)), _mm_set_ps(0.f, 0.f, 1.f, 0.f));
+        c2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(e2, f2)), _mm_set_ps(0.f, 1.f, 0.f, 0.f));
+    #endif
+}
+
+/*-------------------------------------
+    Quaternion from the columns of a rotation matrix
+
+    The branch taken matches the generic implementation. Each branch
+    gathers one of the four candidate quaternions (scaled by 4 times its
+    largest element) from the sums and differences of opposing elements.
+-------------------------------------*/
+inline LS_INLINE __m128 quatf_from_cols(const __m128 c0, const __m128 c1, const __m128 c2) noexcept
+{
+    // a = (m12, m20, m01), b = (m21, m02, m10)
+    const __m128 a = _mm_shuffle_ps(_mm_shuffle_ps(c1, c2, _MM_SHUFFLE(0, 0, 2, 2)), c0, _MM_SHUFFLE(1, 1, 2, 0));
+    const __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(c2, c0, _MM_SHUFFLE(2, 2, 1, 1)), c1, _MM_SHUFFLE(0, 0, 2, 0));
+    const __m128 d = _mm_sub_ps(a, b);
+    const __m128 s = _mm_add_ps(a, b);
+
+    // t = 1 + (m00 - m11 - m22, m11 - m00 - m22, m22 - m00 - m11, m00 + m11 + m22)
+    const __m128 d0 = _mm_xor_ps(_mm_shuffle_ps(c0, c0, _MM_SHUFFLE(0, 0, 0, 0)), _mm_set_ps(0.f, -0.f, -0.f, 0.f));
+    const __m128 d1 = _mm_xor_ps(_mm_shuffle_ps(c1, c1, _MM_SHUFFLE(1, 1, 1, 1)), _mm_set_ps(0.f, -0.f, 0.f, -0.f));
+    const __m128 d2 = _mm_xor_ps(_mm_shuffle_ps(c2, c2, _MM_SHUFFLE(2, 2, 2, 2)), _mm_set_ps(0.f, 0.f, -0.f, -0.f));
+    const __m128 t = _mm_add_ps(_mm_add_ps(d0, d1), _mm_add_ps(d2, _mm_set1_ps(1.f)));
+
+    const float m00 = _mm_cvtss_f32(c0);
+    const float m11 = _mm_cvtss_f32(_mm_shuffle_ps(c1, c1, _MM_SHUFFLE(1, 1, 1, 1)));
+    const float m22 = _mm_cvtss_f32(_mm_shuffle_ps(c2, c2, _MM_SHUFFLE(2, 2, 2, 2)));
+    __m128 lo, hi, ti;
+
+    if (m00 + m11 + m22 > 0.f)
+    {
+        // (d0, d1, d2, tw)
+        lo = _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 1, 0, 0));
+        hi = _mm_shuffle_ps(d, t, _MM_SHUFFLE(3, 3, 2, 2));
+        ti = _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    else if (m22 > m00 && m22 > m11)
+    {
+        // (s1, s0, tz, d2)
+        lo = _mm_shuffle_ps(s, s, _MM_SHUFFLE(0, 0, 1, 1));
+        hi = _mm_shuffle_ps(t, d, _MM_SHUFFLE(2, 2, 2, 2));
+        ti = _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2));
+    }
+    else if (m11 > m00)
+    {
+        // (s2, ty, s0, d1)
+        lo = _mm_shuffle_ps(s, t, _MM_SHUFFLE(1, 1, 2, 2));
+        hi = _mm_shuffle_ps(s, d, _MM_SHUFFLE(1, 1, 0, 0));
+        ti = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1));
+    }
+    else
+    {
+        // (tx, s2, s1, d0)
+        lo = _mm_shuffle_ps(t, s, _MM_SHUFFLE(2, 2, 0, 0));
+        hi = _mm_shuffle_ps(s, d, _MM_SHUFFLE(0, 0, 1, 1));
+        ti = _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0));
+    }
+
+    const __m128 q = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    return _mm_div_ps(_mm_mul_ps(q, _mm_set1_ps(0.5f)), _mm_sqrt_ps(ti));
+}
+
+} // end impl namespace
 
-    // swap the words of each vector
-    const __m128 b = _mm_shuffle_ps(a, a, 0xB1);
-    const __m128 c = _mm_add_ps(a, b);
 
-    // swap each half of the vector
-    const __m128 d = _mm_shuffle_ps(c, c, 0x0F);
-    const __m128 e = _mm_add_ps(c, d);
 
-    return _mm_cvtss_f32(e);
+/*-----------------------------------------------------------------------------
+    Quaternion Utilities
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    4D Dot
+-------------------------------------*/
+inline LS_INLINE float dot(const quat_t<float>& q1, const quat_t<float>& q2)
+{
+    return _mm_cvtss_f32(impl::quatf_dot(q1.simd, q2.simd));
+}
+
+/*-------------------------------------
+    4D Magnitude-Squared
+-------------------------------------*/
+inline LS_INLINE float length_squared(const quat_t<float>& q)
+{
+    return _mm_cvtss_f32(impl::quatf_dot(q.simd, q.simd));
 }
 
 /*-------------------------------------
@@ -60,48 +177,136 @@ inline LS_INLINE float length_squared(const quat_t<float>& q)
 -------------------------------------*/
 inline LS_INLINE float length(const quat_t<float>& q)
 {
-    // cache
-    const __m128 s = _mm_loadu_ps(q.q);
+    return _mm_cvtss_f32(_mm_sqrt_ss(impl::quatf_dot(q.simd, q.simd)));
+}
 
-    // horizontal add
-    const __m128 a = _mm_mul_ps(s, s);
+/*-------------------------------------
+    Inverse
+-------------------------------------*/
+inline LS_INLINE quat_t<float> inverse(const quat_t<float>& q)
+{
+    const __m128 conj = _mm_xor_ps(q.simd, _mm_set_ps(0.f, -0.f, -0.f, -0.f));
+    return quat_t<float>{_mm_div_ps(conj, impl::quatf_dot(q.simd, q.simd))};
+}
 
-    // swap the words of each vector
-    const __m128 b = _mm_shuffle_ps(a, a, 0xB1);
-    const __m128 c = _mm_add_ps(a, b);
+/*-------------------------------------
+    Conjugate
+-------------------------------------*/
+inline LS_INLINE quat_t<float> conjugate(const quat_t<float>& q)
+{
+    return quat_t<float>{_mm_xor_ps(q.simd, _mm_set_ps(0.f, -0.f, -0.f, -0.f))};
+}
+
+/*-------------------------------------
+    4D Normalize
+-------------------------------------*/
+inline LS_INLINE quat_t<float> normalize(const quat_t<float>& q)
+{
+    // Full-precision square root & division. The reciprocal estimate
+    // previously used here was only accurate to about 12 bits.
+    return quat_t<float>{_mm_div_ps(q.simd, _mm_sqrt_ps(impl::quatf_dot(q.simd, q.simd)))};
+}
 
-    // swap each half of the vector
-    const __m128 d = _mm_shuffle_ps(c, c, 0x0F);
-    const __m128 e = _mm_add_ps(c, d);
 
-    return _mm_cvtss_f32(_mm_sqrt_ps(e));
+
+/*-----------------------------------------------------------------------------
+    Quaternions & Vectors
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    reorient
+-------------------------------------*/
+inline LS_INLINE vec3_t<float> reorient(const quat_t<float>& q, const vec3_t<float>& v)
+{
+    vec3_t<float> ret;
+    impl::vec3f_store(ret.v, impl::quatf_rotate(_mm_set_ps(0.f, v.v[2], v.v[1], v.v[0]), q.simd));
+    return ret;
 }
 
 /*-------------------------------------
-    4D Normalize
+    reorient
 -------------------------------------*/
-inline LS_INLINE math::quat_t<float> normalize(const quat_t<float>& q)
+inline LS_INLINE vec3_t<float> reorient(const vec3_t<float>& v, const quat_t<float>& q)
 {
-    // cache
-    const __m128 s = _mm_loadu_ps(q.q);
+    return math::reorient(math::inverse(q), v);
+}
 
-    // horizontal add
-    const __m128 a = _mm_mul_ps(s, s);
+/*-------------------------------------
+    Vector rotation using a Quaternion
+-------------------------------------*/
+inline LS_INLINE vec3_t<float> rotate(const vec3_t<float>& v, const quat_t<float>& q)
+{
+    vec3_t<float> ret;
+    impl::vec3f_store(ret.v, impl::quatf_rotate(_mm_set_ps(0.f, v.v[2], v.v[1], v.v[0]), q.simd));
+    return ret;
+}
 
-    // swap the words of each vector
-    const __m128 b = _mm_shuffle_ps(a, a, 0xB1);
-    const __m128 c = _mm_add_ps(a, b);
+/*-------------------------------------
+    Vector rotation using a Quaternion
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> rotate(const vec4_t<float>& v, const quat_t<float>& q)
+{
+    return vec4_t<float>{impl::quatf_rotate(v.simd, q.simd)};
+}
 
-    // swap each half of the vector
-    const __m128 d = _mm_shuffle_ps(c, c, 0x0F);
-    const __m128 e = _mm_add_ps(c, d);
 
-    // normalization
-    alignas(sizeof(__m128)) quat_t<float> ret;
-    _mm_store_ps(ret.q, _mm_mul_ps(s, _mm_rcp_ps(_mm_sqrt_ps(e))));
+
+/*-----------------------------------------------------------------------------
+    Quaternions & Matrices
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Quaternion to 3x3 Matrix
+-------------------------------------*/
+inline LS_INLINE mat3_t<float> quat_to_mat3(const quat_t<float>& q)
+{
+    mat3_t<float> ret;
+    __m128 c0, c1, c2;
+
+    impl::quatf_to_cols(q.simd, c0, c1, c2);
+
+    // The W component of each column is overwritten by the next store
+    _mm_storeu_ps(ret.m[0].v, c0);
+    _mm_storeu_ps(ret.m[1].v, c1);
+    impl::vec3f_store(ret.m[2].v, c2);
+
     return ret;
 }
 
+/*-------------------------------------
+    Quaternion to 4x4 Matrix
+-------------------------------------*/
+inline LS_INLINE mat4_t<float> quat_to_mat4(const quat_t<float>& q)
+{
+    const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 c0, c1, c2;
+
+    impl::quatf_to_cols(q.simd, c0, c1, c2);
+
+    return mat4_t<float>{
+        vec4_t<float>{_mm_and_ps(c0, mask)},
+        vec4_t<float>{_mm_and_ps(c1, mask)},
+        vec4_t<float>{_mm_and_ps(c2, mask)},
+        vec4_t<float>{_mm_set_ps(1.f, 0.f, 0.f, 0.f)}
+    };
+}
+
+/*-------------------------------------
+    3x3 Matrix to Quaternion
+-------------------------------------*/
+inline LS_INLINE quat_t<float> mat_to_quat(const mat3_t<float>& m)
+{
+    __m128 c0, c1, c2;
+    impl::mat3f_load(m, c0, c1, c2);
+    return quat_t<float>{impl::quatf_from_cols(c0, c1, c2)};
+}
+
+/*-------------------------------------
+    4x4 Matrix to Quaternion
+-------------------------------------*/
+inline LS_INLINE quat_t<float> mat_to_quat(const mat4_t<float>& m)
+{
+    return quat_t<float>{impl::quatf_from_cols(m.m[0].simd, m.m[1].simd, m.m[2].simd)};
+}
+
 
 
 } // end math namespace
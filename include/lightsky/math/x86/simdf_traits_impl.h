@@ -0,0 +1,461 @@
+
+#ifndef LS_MATH_SIMDF_TRAITS_IMPL_H
+#define LS_MATH_SIMDF_TRAITS_IMPL_H
+
+#include <immintrin.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-----------------------------------------------------------------------------
+    SSE Register Traits (4 floats)
+-----------------------------------------------------------------------------*/
+struct SimdTraits128
+{
+    typedef __m128  float_t;
+    typedef __m128i int_t;
+    typedef __m128  mask_t;
+
+    static constexpr unsigned width = 4;
+
+    static LS_INLINE float_t set1(float x) noexcept { return _mm_set1_ps(x); }
+    static LS_INLINE float_t add(float_t a, float_t b) noexcept { return _mm_add_ps(a, b); }
+    static LS_INLINE float_t sub(float_t a, float_t b) noexcept { return _mm_sub_ps(a, b); }
+    static LS_INLINE float_t mul(float_t a, float_t b) noexcept { return _mm_mul_ps(a, b); }
+    static LS_INLINE float_t div(float_t a, float_t b) noexcept { return _mm_div_ps(a, b); }
+    static LS_INLINE float_t sqrt(float_t x) noexcept { return _mm_sqrt_ps(x); }
+    static LS_INLINE float_t min(float_t a, float_t b) noexcept { return _mm_min_ps(a, b); }
+    static LS_INLINE float_t max(float_t a, float_t b) noexcept { return _mm_max_ps(a, b); }
+
+    static LS_INLINE float_t fmadd(float_t a, float_t b, float_t c) noexcept
+    {
+        #ifdef LS_X86_FMA
+            return _mm_fmadd_ps(a, b, c);
+        #else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+        #endif
+    }
+
+    static LS_INLINE float_t abs(float_t x) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.f), x); }
+    static LS_INLINE float_t sign(float_t x) noexcept { return _mm_and_ps(_mm_set1_ps(-0.f), x); }
+    static LS_INLINE float_t bit_xor(float_t a, float_t b) noexcept { return _mm_xor_ps(a, b); }
+    static LS_INLINE float_t bit_or(float_t a, float_t b) noexcept { return _mm_or_ps(a, b); }
+
+    static LS_INLINE mask_t cmp_lt(float_t a, float_t b) noexcept { return _mm_cmplt_ps(a, b); }
+    static LS_INLINE mask_t cmp_gt(float_t a, float_t b) noexcept { return _mm_cmpgt_ps(a, b); }
+    static LS_INLINE mask_t cmp_eq(float_t a, float_t b) noexcept { return _mm_cmpeq_ps(a, b); }
+    static LS_INLINE mask_t cmp_unord(float_t a, float_t b) noexcept { return _mm_cmpunord_ps(a, b); }
+    static LS_INLINE mask_t cmp_signbit(float_t x) noexcept { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31)); }
+
+    static LS_INLINE float_t select(mask_t m, float_t a, float_t b) noexcept
+    {
+        #ifdef LS_X86_SSE4_1
+            return _mm_blendv_ps(b, a, m);
+        #else
+            return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+        #endif
+    }
+
+    static LS_INLINE int_t cvtt(float_t x) noexcept { return _mm_cvttps_epi32(x); }
+    static LS_INLINE float_t cvt(int_t x) noexcept { return _mm_cvtepi32_ps(x); }
+    static LS_INLINE int_t iset1(int x) noexcept { return _mm_set1_epi32(x); }
+    static LS_INLINE int_t iadd(int_t a, int_t b) noexcept { return _mm_add_epi32(a, b); }
+    static LS_INLINE int_t isub(int_t a, int_t b) noexcept { return _mm_sub_epi32(a, b); }
+    static LS_INLINE int_t iand(int_t a, int_t b) noexcept { return _mm_and_si128(a, b); }
+    static LS_INLINE int_t ior(int_t a, int_t b) noexcept { return _mm_or_si128(a, b); }
+    static LS_INLINE mask_t ieq(int_t a, int_t b) noexcept { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+    static LS_INLINE float_t as_float(int_t x) noexcept { return _mm_castsi128_ps(x); }
+    static LS_INLINE int_t as_int(float_t x) noexcept { return _mm_castps_si128(x); }
+
+    template <int n>
+    static LS_INLINE int_t ishl(int_t x) noexcept { return _mm_slli_epi32(x, n); }
+
+    template <int n>
+    static LS_INLINE int_t ishr(int_t x) noexcept { return _mm_srai_epi32(x, n); }
+
+    static LS_INLINE float_t load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static LS_INLINE void store(float* p, float_t x) noexcept { _mm_storeu_ps(p, x); }
+
+    static LS_INLINE float reduce_add(float_t x) noexcept
+    {
+        const __m128 s = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    // Transpose four registers as rows of a 4x4 matrix
+    static LS_INLINE void transpose(float_t& a, float_t& b, float_t& c, float_t& d) noexcept { _MM_TRANSPOSE4_PS(a, b, c, d); }
+
+    // Load "width" 4-component vectors from separate addresses, transposed so
+    // each register holds one component
+    static LS_INLINE void gather_soa4(const float* const* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        a = _mm_loadu_ps(p[0]);
+        b = _mm_loadu_ps(p[1]);
+        c = _mm_loadu_ps(p[2]);
+        d = _mm_loadu_ps(p[3]);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+    }
+
+    // Load "width" consecutive 4-component vectors, transposed so each
+    // register holds one component
+    static LS_INLINE void load_soa4(const float* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        a = _mm_loadu_ps(p);
+        b = _mm_loadu_ps(p+4);
+        c = _mm_loadu_ps(p+8);
+        d = _mm_loadu_ps(p+12);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+    }
+
+    static LS_INLINE void store_soa4(float* p, float_t a, float_t b, float_t c, float_t d) noexcept
+    {
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_storeu_ps(p,    a);
+        _mm_storeu_ps(p+4,  b);
+        _mm_storeu_ps(p+8,  c);
+        _mm_storeu_ps(p+12, d);
+    }
+
+    // Load four consecutive 3-component vectors, de-interleaved so each
+    // register holds one component
+    static LS_INLINE void load_soa3(const float* p, float_t& x, float_t& y, float_t& z) noexcept
+    {
+        const __m128 a = _mm_loadu_ps(p);   // x0 y0 z0 x1
+        const __m128 b = _mm_loadu_ps(p+4); // y1 z1 x2 y2
+        const __m128 c = _mm_loadu_ps(p+8); // z2 x3 y3 z3
+
+        x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 1, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    static LS_INLINE void store_soa3(float* p, float_t x, float_t y, float_t z) noexcept
+    {
+        _mm_storeu_ps(p,   _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(p+4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(p+8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    static LS_INLINE float_t load_partial(const float* p, unsigned n) noexcept
+    {
+        alignas(16) float temp[4] = {0.f, 0.f, 0.f, 0.f};
+        for (unsigned i = 0; i < n; ++i)
+        {
+            temp[i] = p[i];
+        }
+        return _mm_load_ps(temp);
+    }
+
+    static LS_INLINE void store_partial(float* p, float_t x, unsigned n) noexcept
+    {
+        alignas(16) float temp[4];
+        _mm_store_ps(temp, x);
+        for (unsigned i = 0; i < n; ++i)
+        {
+            p[i] = temp[i];
+        }
+    }
+};
+
+
+
+/*-----------------------------------------------------------------------------
+    AVX2 Register Traits (8 floats)
+-----------------------------------------------------------------------------*/
+#ifdef LS_X86_AVX2
+
+struct SimdTraits256
+{
+    typedef __m256  float_t;
+    typedef __m256i int_t;
+    typedef __m256  mask_t;
+
+    static constexpr unsigned width = 8;
+
+    static LS_INLINE float_t set1(float x) noexcept { return _mm256_set1_ps(x); }
+    static LS_INLINE float_t add(float_t a, float_t b) noexcept { return _mm256_add_ps(a, b); }
+    static LS_INLINE float_t sub(float_t a, float_t b) noexcept { return _mm256_sub_ps(a, b); }
+    static LS_INLINE float_t mul(float_t a, float_t b) noexcept { return _mm256_mul_ps(a, b); }
+    static LS_INLINE float_t div(float_t a, float_t b) noexcept { return _mm256_div_ps(a, b); }
+    static LS_INLINE float_t sqrt(float_t x) noexcept { return _mm256_sqrt_ps(x); }
+    static LS_INLINE float_t min(float_t a, float_t b) noexcept { return _mm256_min_ps(a, b); }
+    static LS_INLINE float_t max(float_t a, float_t b) noexcept { return _mm256_max_ps(a, b); }
+
+    static LS_INLINE float_t fmadd(float_t a, float_t b, float_t c) noexcept
+    {
+        #ifdef LS_X86_FMA
+            return _mm256_fmadd_ps(a, b, c);
+        #else
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+        #endif
+    }
+
+    static LS_INLINE float_t abs(float_t x) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), x); }
+    static LS_INLINE float_t sign(float_t x) noexcept { return _mm256_and_ps(_mm256_set1_ps(-0.f), x); }
+    static LS_INLINE float_t bit_xor(float_t a, float_t b) noexcept { return _mm256_xor_ps(a, b); }
+    static LS_INLINE float_t bit_or(float_t a, float_t b) noexcept { return _mm256_or_ps(a, b); }
+
+    static LS_INLINE mask_t cmp_lt(float_t a, float_t b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static LS_INLINE mask_t cmp_gt(float_t a, float_t b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static LS_INLINE mask_t cmp_eq(float_t a, float_t b) noexcept { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static LS_INLINE mask_t cmp_unord(float_t a, float_t b) noexcept { return _mm256_cmp_ps(a, b, _CMP_UNORD_Q); }
+    static LS_INLINE mask_t cmp_signbit(float_t x) noexcept { return _mm256_castsi256_ps(_mm256_srai_epi32(_mm256_castps_si256(x), 31)); }
+    static LS_INLINE float_t select(mask_t m, float_t a, float_t b) noexcept { return _mm256_blendv_ps(b, a, m); }
+
+    static LS_INLINE int_t cvtt(float_t x) noexcept { return _mm256_cvttps_epi32(x); }
+    static LS_INLINE float_t cvt(int_t x) noexcept { return _mm256_cvtepi32_ps(x); }
+    static LS_INLINE int_t iset1(int x) noexcept { return _mm256_set1_epi32(x); }
+    static LS_INLINE int_t iadd(int_t a, int_t b) noexcept { return _mm256_add_epi32(a, b); }
+    static LS_INLINE int_t isub(int_t a, int_t b) noexcept { return _mm256_sub_epi32(a, b); }
+    static LS_INLINE int_t iand(int_t a, int_t b) noexcept { return _mm256_and_si256(a, b); }
+    static LS_INLINE int_t ior(int_t a, int_t b) noexcept { return _mm256_or_si256(a, b); }
+    static LS_INLINE mask_t ieq(int_t a, int_t b) noexcept { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+    static LS_INLINE float_t as_float(int_t x) noexcept { return _mm256_castsi256_ps(x); }
+    static LS_INLINE int_t as_int(float_t x) noexcept { return _mm256_castps_si256(x); }
+
+    template <int n>
+    static LS_INLINE int_t ishl(int_t x) noexcept { return _mm256_slli_epi32(x, n); }
+
+    template <int n>
+    static LS_INLINE int_t ishr(int_t x) noexcept { return _mm256_srai_epi32(x, n); }
+
+    static LS_INLINE float_t load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    static LS_INLINE void store(float* p, float_t x) noexcept { _mm256_storeu_ps(p, x); }
+    static LS_INLINE float reduce_add(float_t x) noexcept { return SimdTraits128::reduce_add(_mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1))); }
+
+    // Transpose each 128-bit lane of four registers as rows of a 4x4 matrix
+    static LS_INLINE void transpose_lanes(float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        const __m256 ab0 = _mm256_unpacklo_ps(a, b);
+        const __m256 ab1 = _mm256_unpackhi_ps(a, b);
+        const __m256 cd0 = _mm256_unpacklo_ps(c, d);
+        const __m256 cd1 = _mm256_unpackhi_ps(c, d);
+        a = _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(1, 0, 1, 0));
+        b = _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(3, 2, 3, 2));
+        c = _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(1, 0, 1, 0));
+        d = _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    // Load "width" consecutive 4-component vectors, transposed so each
+    // register holds one component. Vectors i and i+4 are paired into the
+    // same register first so the results remain in order.
+    static LS_INLINE void load_soa4(const float* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        const __m256 v01 = _mm256_loadu_ps(p);
+        const __m256 v23 = _mm256_loadu_ps(p+8);
+        const __m256 v45 = _mm256_loadu_ps(p+16);
+        const __m256 v67 = _mm256_loadu_ps(p+24);
+        a = _mm256_permute2f128_ps(v01, v45, 0x20);
+        b = _mm256_permute2f128_ps(v01, v45, 0x31);
+        c = _mm256_permute2f128_ps(v23, v67, 0x20);
+        d = _mm256_permute2f128_ps(v23, v67, 0x31);
+        transpose_lanes(a, b, c, d);
+    }
+
+    static LS_INLINE void store_soa4(float* p, float_t a, float_t b, float_t c, float_t d) noexcept
+    {
+        transpose_lanes(a, b, c, d);
+        _mm256_storeu_ps(p,    _mm256_permute2f128_ps(a, b, 0x20));
+        _mm256_storeu_ps(p+8,  _mm256_permute2f128_ps(c, d, 0x20));
+        _mm256_storeu_ps(p+16, _mm256_permute2f128_ps(a, b, 0x31));
+        _mm256_storeu_ps(p+24, _mm256_permute2f128_ps(c, d, 0x31));
+    }
+
+    // Load "width" 4-component vectors from separate addresses, transposed so
+    // each register holds one component
+    static LS_INLINE void gather_soa4(const float* const* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[0])), _mm_loadu_ps(p[4]), 1);
+        b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[1])), _mm_loadu_ps(p[5]), 1);
+        c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[2])), _mm_loadu_ps(p[6]), 1);
+        d = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[3])), _mm_loadu_ps(p[7]), 1);
+        transpose_lanes(a, b, c, d);
+    }
+
+    static LS_INLINE int_t partial_mask(unsigned n) noexcept
+    {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    static LS_INLINE float_t load_partial(const float* p, unsigned n) noexcept { return _mm256_maskload_ps(p, partial_mask(n)); }
+    static LS_INLINE void store_partial(float* p, float_t x, unsigned n) noexcept { _mm256_maskstore_ps(p, partial_mask(n), x); }
+};
+
+#endif /* LS_X86_AVX2 */
+
+
+
+/*-----------------------------------------------------------------------------
+    AVX-512 Register Traits (16 floats)
+-----------------------------------------------------------------------------*/
+#ifdef LS_X86_AVX512F
+
+// GCC implements many unmasked AVX-512 intrinsics by merging into an
+// undefined register, which it reports as uninitialized once inlined into
+// larger kernels. Their zero-masked forms, given a full mask, compile to the
+// same instructions without the warning.
+struct SimdTraits512
+{
+    typedef __m512    float_t;
+    typedef __m512i   int_t;
+    typedef __mmask16 mask_t;
+
+    static constexpr unsigned width = 16;
+
+    static LS_INLINE float_t set1(float x) noexcept { return _mm512_set1_ps(x); }
+    static LS_INLINE float_t add(float_t a, float_t b) noexcept { return _mm512_add_ps(a, b); }
+    static LS_INLINE float_t sub(float_t a, float_t b) noexcept { return _mm512_sub_ps(a, b); }
+    static LS_INLINE float_t mul(float_t a, float_t b) noexcept { return _mm512_mul_ps(a, b); }
+    static LS_INLINE float_t div(float_t a, float_t b) noexcept { return _mm512_div_ps(a, b); }
+    static LS_INLINE float_t sqrt(float_t x) noexcept { return _mm512_maskz_sqrt_ps((__mmask16)0xFFFF, x); }
+    static LS_INLINE float_t min(float_t a, float_t b) noexcept { return _mm512_maskz_min_ps((__mmask16)0xFFFF, a, b); }
+    static LS_INLINE float_t max(float_t a, float_t b) noexcept { return _mm512_maskz_max_ps((__mmask16)0xFFFF, a, b); }
+    static LS_INLINE float_t fmadd(float_t a, float_t b, float_t c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+
+    // AVX-512F lacks floating-point bitwise operations (those require DQ)
+    static LS_INLINE float_t abs(float_t x) noexcept
+    {
+        return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(0x7FFFFFFF)));
+    }
+
+    static LS_INLINE float_t sign(float_t x) noexcept
+    {
+        return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32((int)0x80000000)));
+    }
+
+    static LS_INLINE float_t bit_xor(float_t a, float_t b) noexcept
+    {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    static LS_INLINE float_t bit_or(float_t a, float_t b) noexcept
+    {
+        return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    static LS_INLINE mask_t cmp_lt(float_t a, float_t b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static LS_INLINE mask_t cmp_gt(float_t a, float_t b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static LS_INLINE mask_t cmp_eq(float_t a, float_t b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static LS_INLINE mask_t cmp_unord(float_t a, float_t b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q); }
+    static LS_INLINE mask_t cmp_signbit(float_t x) noexcept { return _mm512_test_epi32_mask(_mm512_castps_si512(x), _mm512_set1_epi32((int)0x80000000)); }
+    static LS_INLINE float_t select(mask_t m, float_t a, float_t b) noexcept { return _mm512_mask_blend_ps(m, b, a); }
+
+    static LS_INLINE int_t cvtt(float_t x) noexcept { return _mm512_maskz_cvttps_epi32((__mmask16)0xFFFF, x); }
+    static LS_INLINE float_t cvt(int_t x) noexcept { return _mm512_maskz_cvtepi32_ps((__mmask16)0xFFFF, x); }
+    static LS_INLINE int_t iset1(int x) noexcept { return _mm512_set1_epi32(x); }
+    static LS_INLINE int_t iadd(int_t a, int_t b) noexcept { return _mm512_add_epi32(a, b); }
+    static LS_INLINE int_t isub(int_t a, int_t b) noexcept { return _mm512_sub_epi32(a, b); }
+    static LS_INLINE int_t iand(int_t a, int_t b) noexcept { return _mm512_and_si512(a, b); }
+    static LS_INLINE int_t ior(int_t a, int_t b) noexcept { return _mm512_or_si512(a, b); }
+    static LS_INLINE mask_t ieq(int_t a, int_t b) noexcept { return _mm512_cmpeq_epi32_mask(a, b); }
+    static LS_INLINE float_t as_float(int_t x) noexcept { return _mm512_castsi512_ps(x); }
+    static LS_INLINE int_t as_int(float_t x) noexcept { return _mm512_castps_si512(x); }
+
+    template <int n>
+    static LS_INLINE int_t ishl(int_t x) noexcept { return _mm512_maskz_slli_epi32((__mmask16)0xFFFF, x, n); }
+
+    template <int n>
+    static LS_INLINE int_t ishr(int_t x) noexcept { return _mm512_maskz_srai_epi32((__mmask16)0xFFFF, x, n); }
+
+    static LS_INLINE float_t load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+    static LS_INLINE void store(float* p, float_t x) noexcept { _mm512_storeu_ps(p, x); }
+
+    static LS_INLINE float reduce_add(float_t x) noexcept
+    {
+        const __m512d d = _mm512_castps_pd(x);
+        const __m256 lo = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd((__mmask8)0xF, d, 0));
+        const __m256 hi = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd((__mmask8)0xF, d, 1));
+        return SimdTraits256::reduce_add(_mm256_add_ps(lo, hi));
+    }
+
+    // Transpose each 128-bit lane of four registers as rows of a 4x4 matrix
+    static LS_INLINE void transpose_lanes(float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        const __m512 ab0 = _mm512_maskz_unpacklo_ps((__mmask16)0xFFFF, a, b);
+        const __m512 ab1 = _mm512_maskz_unpackhi_ps((__mmask16)0xFFFF, a, b);
+        const __m512 cd0 = _mm512_maskz_unpacklo_ps((__mmask16)0xFFFF, c, d);
+        const __m512 cd1 = _mm512_maskz_unpackhi_ps((__mmask16)0xFFFF, c, d);
+        a = _mm512_shuffle_ps(ab0, cd0, _MM_SHUFFLE(1, 0, 1, 0));
+        b = _mm512_shuffle_ps(ab0, cd0, _MM_SHUFFLE(3, 2, 3, 2));
+        c = _mm512_shuffle_ps(ab1, cd1, _MM_SHUFFLE(1, 0, 1, 0));
+        d = _mm512_shuffle_ps(ab1, cd1, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    // Transpose the 128-bit lanes of four registers
+    static LS_INLINE void transpose_blocks(float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        const __m512 ab0 = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, a, b, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m512 ab1 = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, a, b, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m512 cd0 = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, c, d, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m512 cd1 = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, c, d, _MM_SHUFFLE(3, 2, 3, 2));
+        a = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, ab0, cd0, _MM_SHUFFLE(2, 0, 2, 0));
+        b = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, ab0, cd0, _MM_SHUFFLE(3, 1, 3, 1));
+        c = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, ab1, cd1, _MM_SHUFFLE(2, 0, 2, 0));
+        d = _mm512_maskz_shuffle_f32x4((__mmask16)0xFFFF, ab1, cd1, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+
+    // Load "width" consecutive 4-component vectors, transposed so each
+    // register holds one component. Vectors i, i+4, i+8, and i+12 are
+    // gathered into the same register first so the results remain in order.
+    static LS_INLINE void load_soa4(const float* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        a = _mm512_loadu_ps(p);
+        b = _mm512_loadu_ps(p+16);
+        c = _mm512_loadu_ps(p+32);
+        d = _mm512_loadu_ps(p+48);
+        transpose_blocks(a, b, c, d);
+        transpose_lanes(a, b, c, d);
+    }
+
+    static LS_INLINE void store_soa4(float* p, float_t a, float_t b, float_t c, float_t d) noexcept
+    {
+        transpose_lanes(a, b, c, d);
+        transpose_blocks(a, b, c, d);
+        _mm512_storeu_ps(p,    a);
+        _mm512_storeu_ps(p+16, b);
+        _mm512_storeu_ps(p+32, c);
+        _mm512_storeu_ps(p+48, d);
+    }
+
+    // Load "width" 4-component vectors from separate addresses, transposed so
+    // each register holds one component. Vectors i, i+4, i+8, and i+12 are
+    // broadcast into the 128-bit lanes of the same register first.
+    static LS_INLINE void gather_soa4(const float* const* p, float_t& a, float_t& b, float_t& c, float_t& d) noexcept
+    {
+        const auto gather_row = [p](unsigned r) noexcept -> float_t
+        {
+            float_t x = _mm512_maskz_broadcast_f32x4((__mmask16)0x000F, _mm_loadu_ps(p[r]));
+            x = _mm512_mask_broadcast_f32x4(x, (__mmask16)0x00F0, _mm_loadu_ps(p[r+4]));
+            x = _mm512_mask_broadcast_f32x4(x, (__mmask16)0x0F00, _mm_loadu_ps(p[r+8]));
+            return _mm512_mask_broadcast_f32x4(x, (__mmask16)0xF000, _mm_loadu_ps(p[r+12]));
+        };
+
+        a = gather_row(0);
+        b = gather_row(1);
+        c = gather_row(2);
+        d = gather_row(3);
+        transpose_lanes(a, b, c, d);
+    }
+
+    static LS_INLINE mask_t partial_mask(unsigned n) noexcept { return (mask_t)((1u << n) - 1u); }
+    static LS_INLINE float_t load_partial(const float* p, unsigned n) noexcept { return _mm512_maskz_loadu_ps(partial_mask(n), p); }
+    static LS_INLINE void store_partial(float* p, float_t x, unsigned n) noexcept { _mm512_mask_storeu_ps(p, partial_mask(n), x); }
+};
+
+#endif /* LS_X86_AVX512F */
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_SIMDF_TRAITS_IMPL_H */
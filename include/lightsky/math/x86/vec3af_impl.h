@@ -0,0 +1,386 @@
+
+#ifndef LS_MATH_VEC3AF_IMPL_H
+#define LS_MATH_VEC3AF_IMPL_H
+
+#include <type_traits>
+
+#include "lightsky/setup/Compiler.h"
+
+extern "C" {
+    #include <immintrin.h>
+}
+
+
+
+namespace ls
+{
+namespace math
+{
+
+
+
+template<>
+union alignas(alignof(__m128)) vec3a_t<float>
+{
+    typedef float value_type;
+    static constexpr unsigned num_components() noexcept { return 3; }
+
+    // data
+    __m128 simd;
+
+    float v[4];
+
+    // Main Constructor
+    constexpr vec3a_t(float inX, float inY, float inZ);
+
+    // Delegated Constructors
+    vec3a_t() = default;
+
+    explicit constexpr vec3a_t(__m128 n);
+
+    vec3a_t(float n);
+
+    vec3a_t(const vec3a_t<float>& input) = default;
+
+    vec3a_t(vec3a_t<float>&& input) = default;
+
+    ~vec3a_t() = default;
+
+    // Conversions & Casting
+    template<typename other_t>
+    inline explicit operator vec3a_t<other_t>() const;
+
+    const float* operator&() const;
+
+    inline float* operator&();
+
+    // Subscripting Operators
+    template <typename index_t>
+    inline float operator[](index_t i) const;
+
+    template <typename index_t>
+    inline float& operator[](index_t i);
+
+    // vector-vector operators
+    vec3a_t operator+(const vec3a_t<float>&) const;
+
+    vec3a_t operator-(const vec3a_t<float>&) const;
+
+    vec3a_t operator-() const;
+
+    vec3a_t operator*(const vec3a_t<float>&) const;
+
+    vec3a_t operator/(const vec3a_t<float>&) const;
+
+    vec3a_t& operator=(const vec3a_t<float>&) noexcept = default;
+
+    vec3a_t& operator=(vec3a_t<float>&&) noexcept = default;
+
+    vec3a_t& operator+=(const vec3a_t<float>&);
+
+    vec3a_t& operator-=(const vec3a_t<float>&);
+
+    vec3a_t& operator*=(const vec3a_t<float>&);
+
+    vec3a_t& operator/=(const vec3a_t<float>&);
+
+    vec3a_t& operator++(); //prefix operators
+    vec3a_t& operator--();
+
+    vec3a_t operator++(int); //postfix operators
+    vec3a_t operator--(int);
+
+    inline bool operator==(const vec3a_t<float>& compare) const; //comparisons
+
+    inline bool operator!=(const vec3a_t<float>& compare) const;
+
+    inline bool operator<(const vec3a_t<float>& compare) const;
+
+    inline bool operator>(const vec3a_t<float>& compare) const;
+
+    inline bool operator<=(const vec3a_t<float>& compare) const;
+
+    inline bool operator>=(const vec3a_t<float>& compare) const;
+
+    // vector-scalar operators
+    vec3a_t operator=(float);
+
+    inline vec3a_t operator+(float) const;
+
+    inline vec3a_t operator-(float) const;
+
+    inline vec3a_t operator*(float) const;
+
+    inline vec3a_t operator/(float) const;
+
+    vec3a_t& operator+=(float);
+
+    vec3a_t& operator-=(float);
+
+    vec3a_t& operator*=(float);
+
+    vec3a_t& operator/=(float);
+};
+
+static_assert(std::is_trivial<vec3a_t<float>>::value, "Vec3af must be trivial.");
+static_assert(sizeof(vec3a_t<float>) == sizeof(__m128), "Vec3af must fill a SIMD register.");
+
+/*-------------------------------------
+    Constructors
+-------------------------------------*/
+// Main Constructor
+constexpr LS_INLINE vec3a_t<float>::vec3a_t(float inX, float inY, float inZ) :
+    v{inX, inY, inZ, 0.f}
+{
+}
+
+inline LS_INLINE vec3a_t<float>::vec3a_t(float n) :
+    simd(_mm_set1_ps(n))
+{
+}
+
+constexpr LS_INLINE vec3a_t<float>::vec3a_t(const __m128 n) :
+    simd(n)
+{
+}
+
+/*-------------------------------------
+    Conversions & Casting
+-------------------------------------*/
+template<typename other_t>
+inline LS_INLINE vec3a_t<float>::operator vec3a_t<other_t>() const
+{
+    return vec3a_t<other_t>{(other_t)v[0], (other_t)v[1], (other_t)v[2]};
+}
+
+inline LS_INLINE const float* vec3a_t<float>::operator&() const
+{
+    return reinterpret_cast<const float*>(this);
+}
+
+inline LS_INLINE float* vec3a_t<float>::operator&()
+{
+    return reinterpret_cast<float*>(this);
+}
+
+/*-------------------------------------
+    Subscripting Operators
+-------------------------------------*/
+template <typename index_t>
+inline LS_INLINE float vec3a_t<float>::operator[](index_t i) const
+{
+    return v[i];
+}
+
+template <typename index_t>
+inline LS_INLINE float& vec3a_t<float>::operator[](index_t i)
+{
+    return v[i];
+}
+
+/*-------------------------------------
+    Vector-Vector Math Operations
+-------------------------------------*/
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator+(const vec3a_t<float>& input) const
+{
+    return vec3a_t{_mm_add_ps(simd, input.simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator-(const vec3a_t<float>& input) const
+{
+    return vec3a_t{_mm_sub_ps(simd, input.simd)};
+}
+
+//for operations like "vectA = -vectB"
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator-() const
+{
+    return vec3a_t{_mm_xor_ps(_mm_castsi128_ps(_mm_set1_epi32(0x80000000)), simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator*(const vec3a_t<float>& input) const
+{
+    return vec3a_t{_mm_mul_ps(simd, input.simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator/(const vec3a_t<float>& input) const
+{
+    return vec3a_t{_mm_div_ps(simd, input.simd)};
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator+=(const vec3a_t<float>& input)
+{
+    this->simd = _mm_add_ps(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator-=(const vec3a_t<float>& input)
+{
+    this->simd = _mm_sub_ps(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator*=(const vec3a_t<float>& input)
+{
+    this->simd = _mm_mul_ps(simd, input.simd);
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator/=(const vec3a_t<float>& input)
+{
+    this->simd = _mm_div_ps(simd, input.simd);
+    return *this;
+}
+
+// prefix operations
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator++()
+{
+    this->simd = _mm_add_ps(simd, _mm_set1_ps(1.f));
+    return *this;
+}
+
+inline LS_INLINE
+vec3a_t<float>& vec3a_t<float>::operator--()
+{
+    this->simd = _mm_sub_ps(simd, _mm_set1_ps(1.f));
+    return *this;
+}
+
+//postfix operations
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator++(int)
+{
+    const __m128 ret = simd;
+    this->simd = _mm_add_ps(simd, _mm_set1_ps(1.f));
+    return vec3a_t<float>{ret};
+}
+
+inline LS_INLINE
+vec3a_t<float> vec3a_t<float>::operator--(int)
+{
+    const __m128 ret = simd;
+    this->simd = _mm_sub_ps(simd, _mm_set1_ps(1.f));
+    return vec3a_t<float>{ret};
+}
+
+//comparisons, with the padding element masked off
+
+inline LS_INLINE bool vec3a_t<float>::operator==(const vec3a_t<float>& compare) const
+{
+    return (_mm_movemask_ps(_mm_cmpeq_ps(simd, compare.simd)) & 0x07) == 0x07;
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator!=(const vec3a_t<float>& compare) const
+{
+    return (_mm_movemask_ps(_mm_cmpneq_ps(simd, compare.simd)) & 0x07) != 0;
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator<(const vec3a_t<float>& compare) const
+{
+    return (_mm_movemask_ps(_mm_cmplt_ps(simd, compare.simd)) & 0x07) == 0x07;
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator>(const vec3a_t<float>& compare) const
+{
+    return (_mm_movemask_ps(_mm_cmpgt_ps(simd, compare.simd)) & 0x07) == 0x07;
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator<=(const vec3a_t<float>& compare) const
+{
+    return (_mm_movemask_ps(_mm_cmple_ps(simd, compare.simd)) & 0x07) == 0x07;
+}
+
+inline LS_INLINE bool vec3a_t<float>::operator>=(const vec3a_t<float>& compare) const
+{
+    return (_mm_movemask_ps(_mm_cmpge_ps(simd, compare.simd)) & 0x07) == 0x07;
+}
+
+/*-------------------------------------
+    Vector-Scalar Math Operations
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator=(float input)
+{
+    this->simd = _mm_set1_ps(input);
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator+(float input) const
+{
+    return vec3a_t<float>{_mm_add_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator-(float input) const
+{
+    return vec3a_t<float>{_mm_sub_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator*(float input) const
+{
+    return vec3a_t<float>{_mm_mul_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE vec3a_t<float> vec3a_t<float>::operator/(float input) const
+{
+    return vec3a_t<float>{_mm_div_ps(simd, _mm_set1_ps(input))};
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator+=(float input)
+{
+    this->simd = _mm_add_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator-=(float input)
+{
+    this->simd = _mm_sub_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator*=(float input)
+{
+    this->simd = _mm_mul_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+inline LS_INLINE vec3a_t<float>& vec3a_t<float>::operator/=(float input)
+{
+    this->simd = _mm_div_ps(simd, _mm_set1_ps(input));
+    return *this;
+}
+
+/*-------------------------------------
+    Non-Member Vector-Scalar operations
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> operator+(float n, const vec3a_t<float>& v)
+{
+    return v + n;
+}
+
+inline LS_INLINE vec3a_t<float> operator-(float n, const vec3a_t<float>& v)
+{
+    return vec3a_t<float>{_mm_sub_ps(_mm_set1_ps(n), v.simd)};
+}
+
+inline LS_INLINE vec3a_t<float> operator*(float n, const vec3a_t<float>& v)
+{
+    return v * n;
+}
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_VEC3AF_IMPL_H */
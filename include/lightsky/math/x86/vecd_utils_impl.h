@@ -0,0 +1,129 @@
+
+#ifndef LS_MATH_VECD_UTILS_IMPL_H
+#define LS_MATH_VECD_UTILS_IMPL_H
+
+#include <immintrin.h>
+
+#include "lightsky/setup/Api.h" // LS_INLINE
+
+namespace ls
+{
+namespace math
+{
+
+
+
+#if defined(LS_X86_AVX)
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Arbitrary permutation of 4 doubles
+-------------------------------------*/
+template <int i0, int i1, int i2, int i3>
+inline LS_INLINE __m256d permute4_pd(__m256d v) noexcept
+{
+    #if defined(LS_X86_AVX2)
+        return _mm256_permute4x64_pd(v, i0 | (i1 << 2) | (i2 << 4) | (i3 << 6));
+
+    #else
+        // AVX1 can only permute within 128-bit lanes. Select from copies of
+        // the low and high halves, then blend the results.
+        const __m256d lo = _mm256_permute2f128_pd(v, v, 0x00);
+        const __m256d hi = _mm256_permute2f128_pd(v, v, 0x11);
+        constexpr int sel = (i0 & 1) | ((i1 & 1) << 1) | ((i2 & 1) << 2) | ((i3 & 1) << 3);
+        constexpr int blend = (i0 >> 1) | ((i1 >> 1) << 1) | ((i2 >> 1) << 2) | ((i3 >> 1) << 3);
+        return _mm256_blend_pd(_mm256_permute_pd(lo, sel), _mm256_permute_pd(hi, sel), blend);
+    #endif
+}
+
+/*-------------------------------------
+    Horizontal sum, broadcast to all elements
+-------------------------------------*/
+inline LS_INLINE __m256d sum4_pd(__m256d v) noexcept
+{
+    const __m256d a = _mm256_add_pd(v, _mm256_permute_pd(v, 0x5));
+    return _mm256_add_pd(a, _mm256_permute2f128_pd(a, a, 0x01));
+}
+
+} // end impl namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    4D Vectors
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    4D Cross
+-------------------------------------*/
+inline LS_INLINE vec4_t<double> cross(const vec4_t<double>& v1, const vec4_t<double>& v2) noexcept
+{
+    vec4_t<double> ret;
+
+    const __m256d a = _mm256_loadu_pd(v1.v);
+    const __m256d b = _mm256_loadu_pd(v2.v);
+    const __m256d yzxA = impl::permute4_pd<1, 2, 0, 3>(a);
+    const __m256d yzxB = impl::permute4_pd<1, 2, 0, 3>(b);
+
+    #ifdef LS_X86_FMA
+        const __m256d c = _mm256_fmsub_pd(a, yzxB, _mm256_mul_pd(yzxA, b));
+    #else
+        const __m256d c = _mm256_sub_pd(_mm256_mul_pd(a, yzxB), _mm256_mul_pd(yzxA, b));
+    #endif
+
+    _mm256_storeu_pd(ret.v, impl::permute4_pd<1, 2, 0, 3>(c));
+    return ret;
+}
+
+/*-------------------------------------
+    4D Dot
+-------------------------------------*/
+inline LS_INLINE double dot(const vec4_t<double>& v1, const vec4_t<double>& v2) noexcept
+{
+    const __m256d a = _mm256_mul_pd(_mm256_loadu_pd(v1.v), _mm256_loadu_pd(v2.v));
+    const __m256d b = _mm256_add_pd(a, _mm256_permute_pd(a, 0x5));
+    const __m128d c = _mm_add_sd(_mm256_castpd256_pd128(b), _mm256_extractf128_pd(b, 1));
+    return _mm_cvtsd_f64(c);
+}
+
+/*-------------------------------------
+    4D Magnitude (squared)
+-------------------------------------*/
+inline LS_INLINE double length_squared(const vec4_t<double>& v) noexcept
+{
+    return math::dot(v, v);
+}
+
+/*-------------------------------------
+    4D Magnitude
+-------------------------------------*/
+inline LS_INLINE double length(const vec4_t<double>& v) noexcept
+{
+    const __m128d l2 = _mm_set_sd(math::dot(v, v));
+    return _mm_cvtsd_f64(_mm_sqrt_sd(l2, l2));
+}
+
+/*-------------------------------------
+    4D Normalize
+-------------------------------------*/
+inline LS_INLINE vec4_t<double> normalize(const vec4_t<double>& v) noexcept
+{
+    // Full-precision square root & division, matching the generic version
+    vec4_t<double> ret;
+    const __m256d a = _mm256_loadu_pd(v.v);
+    _mm256_storeu_pd(ret.v, _mm256_div_pd(a, _mm256_sqrt_pd(impl::sum4_pd(_mm256_mul_pd(a, a)))));
+    return ret;
+}
+
+#endif /* LS_X86_AVX */
+
+
+
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_VECD_UTILS_IMPL_H */
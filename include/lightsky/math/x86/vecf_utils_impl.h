@@ -4,6 +4,9 @@
 
 #include <pmmintrin.h>
 
+#include "lightsky/math/generic/simd_trig_impl.h"
+#include "lightsky/math/x86/simdf_traits_impl.h"
+
 
 
 namespace ls
@@ -587,6 +590,403 @@ inline LS_INLINE vec4_t<float> fmsub(const vec4_t<float>& x, const vec4_t<float>
 }
 
 
+/*-------------------------------------
+    4D sin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> sin(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_sin<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D cos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> cos(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_cos<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D sincos
+-------------------------------------*/
+inline LS_INLINE void sincos(const vec4_t<float>& x, vec4_t<float>& outSin, vec4_t<float>& outCos) noexcept
+{
+    impl::simd_sincos<impl::SimdTraits128>(x.simd, outSin.simd, outCos.simd);
+}
+
+
+
+/*-------------------------------------
+    4D tan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> tan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_tan<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D atan
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_atan<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D atan2
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> atan2(const vec4_t<float>& y, const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_atan2<impl::SimdTraits128>(y.simd, x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D asin
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> asin(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_asin<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-------------------------------------
+    4D acos
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> acos(const vec4_t<float>& x) noexcept
+{
+    return vec4_t<float>{impl::simd_acos<impl::SimdTraits128>(x.simd)};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    3D Aligned Vectors
+
+    The padding element of each register must be masked out of horizontal
+    operations. Element-wise operations reuse the 4D implementations.
+-----------------------------------------------------------------------------*/
+namespace impl
+{
+
+/*-------------------------------------
+    Sum of the X, Y, and Z elements, stored in the lowest element
+-------------------------------------*/
+inline LS_INLINE __m128 vec3af_sum(const __m128 a) noexcept
+{
+    const __m128 y = _mm_movehdup_ps(a);
+    const __m128 z = _mm_movehl_ps(a, a);
+    return _mm_add_ss(_mm_add_ss(a, y), z);
+}
+
+} // end impl namespace
+
+/*-------------------------------------
+    Aligned 3D Sum
+-------------------------------------*/
+inline LS_INLINE float sum(const vec3a_t<float>& v) noexcept
+{
+    return _mm_cvtss_f32(impl::vec3af_sum(v.simd));
+}
+
+/*-------------------------------------
+    Aligned 3D Reciprocal Sum
+-------------------------------------*/
+inline LS_INLINE float sum_inv(const vec3a_t<float>& v) noexcept
+{
+    return _mm_cvtss_f32(_mm_rcp_ss(impl::vec3af_sum(v.simd)));
+}
+
+/*-------------------------------------
+    Aligned 3D Dot
+-------------------------------------*/
+inline LS_INLINE float dot(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return _mm_cvtss_f32(impl::vec3af_sum(_mm_mul_ps(v1.simd, v2.simd)));
+}
+
+/*-------------------------------------
+    Aligned 3D Cross
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> cross(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return vec3a_t<float>{math::cross(vec4_t<float>{v1.simd}, vec4_t<float>{v2.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Magnitude (squared)
+-------------------------------------*/
+inline LS_INLINE float length_squared(const vec3a_t<float>& v) noexcept
+{
+    return _mm_cvtss_f32(impl::vec3af_sum(_mm_mul_ps(v.simd, v.simd)));
+}
+
+/*-------------------------------------
+    Aligned 3D Magnitude
+-------------------------------------*/
+inline LS_INLINE float length(const vec3a_t<float>& v) noexcept
+{
+    return _mm_cvtss_f32(_mm_sqrt_ss(impl::vec3af_sum(_mm_mul_ps(v.simd, v.simd))));
+}
+
+/*-------------------------------------
+    Aligned 3D Normalize
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> normalize(const vec3a_t<float>& v) noexcept
+{
+    // Full-precision square root & division, matching the packed 3D version
+    const __m128 l2 = impl::vec3af_sum(_mm_mul_ps(v.simd, v.simd));
+    return vec3a_t<float>{_mm_div_ps(v.simd, _mm_sqrt_ps(_mm_shuffle_ps(l2, l2, _MM_SHUFFLE(0, 0, 0, 0))))};
+}
+
+/*-------------------------------------
+    Aligned 3D Reflect
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> reflect(const vec3a_t<float>& v, const vec3a_t<float>& norm) noexcept
+{
+    const __m128 d = impl::vec3af_sum(_mm_mul_ps(v.simd, norm.simd));
+    const __m128 d2 = _mm_shuffle_ps(d, d, _MM_SHUFFLE(0, 0, 0, 0));
+
+    #ifdef LS_X86_FMA
+        return vec3a_t<float>{_mm_fnmadd_ps(norm.simd, _mm_add_ps(d2, d2), v.simd)};
+    #else
+        return vec3a_t<float>{_mm_sub_ps(v.simd, _mm_mul_ps(norm.simd, _mm_add_ps(d2, d2)))};
+    #endif
+}
+
+/*-------------------------------------
+    Aligned 3D Sign Bits
+-------------------------------------*/
+inline LS_INLINE int sign_mask(const vec3a_t<float>& x) noexcept
+{
+    return _mm_movemask_ps(x.simd) & 0x07;
+}
+
+/*-------------------------------------
+    Aligned 3D Min
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> min(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return vec3a_t<float>{math::min(vec4_t<float>{v1.simd}, vec4_t<float>{v2.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Max
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> max(const vec3a_t<float>& v1, const vec3a_t<float>& v2) noexcept
+{
+    return vec3a_t<float>{math::max(vec4_t<float>{v1.simd}, vec4_t<float>{v2.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Clamp
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> clamp(const vec3a_t<float>& v, const vec3a_t<float>& minVals, const vec3a_t<float>& maxVals) noexcept
+{
+    return vec3a_t<float>{math::clamp(vec4_t<float>{v.simd}, vec4_t<float>{minVals.simd}, vec4_t<float>{maxVals.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Saturate
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> saturate(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::saturate(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Step
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> step(const vec3a_t<float>& edge, const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::step(vec4_t<float>{edge.simd}, vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Smoothstep
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> smoothstep(const vec3a_t<float>& a, const vec3a_t<float>& b, const vec3a_t<float>& x) noexcept
+{
+    return vec3a_t<float>{math::smoothstep(vec4_t<float>{a.simd}, vec4_t<float>{b.simd}, vec4_t<float>{x.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D RCP
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> rcp(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::rcp(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Sign
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> sign(const vec3a_t<float>& x) noexcept
+{
+    return vec3a_t<float>{math::sign(vec4_t<float>{x.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Copysign
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> copysign(const vec3a_t<float>& n, const vec3a_t<float>& s) noexcept
+{
+    return vec3a_t<float>{math::copysign(vec4_t<float>{n.simd}, vec4_t<float>{s.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D floor
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> floor(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::floor(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D ceil
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> ceil(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::ceil(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D round
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> round(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::round(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D abs
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> abs(const vec3a_t<float>& v) noexcept
+{
+    return vec3a_t<float>{math::abs(vec4_t<float>{v.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D log2
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> log2(const vec3a_t<float>& n) noexcept
+{
+    return vec3a_t<float>{math::log2(vec4_t<float>{n.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D log
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> log(const vec3a_t<float>& n) noexcept
+{
+    return vec3a_t<float>{math::log(vec4_t<float>{n.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D log10
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> log10(const vec3a_t<float>& n) noexcept
+{
+    return vec3a_t<float>{math::log10(vec4_t<float>{n.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D logN
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> logN(const vec3a_t<float>& baseN, const vec3a_t<float>& n) noexcept
+{
+    return vec3a_t<float>{math::logN(vec4_t<float>{baseN.simd}, vec4_t<float>{n.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D pow
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> pow(const vec3a_t<float>& x, const vec3a_t<float>& y) noexcept
+{
+    return vec3a_t<float>{math::pow(vec4_t<float>{x.simd}, vec4_t<float>{y.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D exp
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> exp(const vec3a_t<float>& x) noexcept
+{
+    return vec3a_t<float>{math::exp(vec4_t<float>{x.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D exp2
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> exp2(const vec3a_t<float>& x) noexcept
+{
+    return vec3a_t<float>{math::exp2(vec4_t<float>{x.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D FMA
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> fmadd(const vec3a_t<float>& x, const vec3a_t<float>& m, const vec3a_t<float>& a) noexcept
+{
+    return vec3a_t<float>{math::fmadd(vec4_t<float>{x.simd}, vec4_t<float>{m.simd}, vec4_t<float>{a.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D FMS
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> fmsub(const vec3a_t<float>& x, const vec3a_t<float>& m, const vec3a_t<float>& a) noexcept
+{
+    return vec3a_t<float>{math::fmsub(vec4_t<float>{x.simd}, vec4_t<float>{m.simd}, vec4_t<float>{a.simd}).simd};
+}
+
+/*-------------------------------------
+    Aligned 3D Vector from 3D
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> vec3a_cast(const vec3_t<float>& v) noexcept
+{
+    const __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(v.v));
+    return vec3a_t<float>{_mm_movelh_ps(xy, _mm_load_ss(v.v+2))};
+}
+
+/*-------------------------------------
+    Aligned 3D Vector from 4D
+-------------------------------------*/
+inline LS_INLINE vec3a_t<float> vec3a_cast(const vec4_t<float>& v) noexcept
+{
+    return vec3a_t<float>{v.simd};
+}
+
+/*-------------------------------------
+    3D Vector from Aligned 3D
+-------------------------------------*/
+inline LS_INLINE vec3_t<float> vec3_cast(const vec3a_t<float>& v) noexcept
+{
+    vec3_t<float> ret;
+    _mm_storel_pi(reinterpret_cast<__m64*>(ret.v), v.simd);
+    _mm_store_ss(ret.v+2, _mm_movehl_ps(v.simd, v.simd));
+    return ret;
+}
+
+/*-------------------------------------
+    4D Vector from Aligned 3D & Scalar
+-------------------------------------*/
+inline LS_INLINE vec4_t<float> vec4_cast(const vec3a_t<float>& v, const float& s) noexcept
+{
+    // (z, s, _, s)
+    const __m128 zw = _mm_unpackhi_ps(v.simd, _mm_set1_ps(s));
+    return vec4_t<float>{_mm_shuffle_ps(v.simd, zw, _MM_SHUFFLE(1, 0, 1, 0))};
+}
+
+
 
 } // end math namespace
 } // end ls namespace
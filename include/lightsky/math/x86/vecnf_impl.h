@@ -0,0 +1,55 @@
+
+#ifndef LS_MATH_VECNF_IMPL_H
+#define LS_MATH_VECNF_IMPL_H
+
+#include <type_traits> // std::conditional_t
+
+#include "lightsky/math/generic/simd_vecn_impl.h"
+#include "lightsky/math/x86/simdf_traits_impl.h"
+
+namespace ls
+{
+namespace math
+{
+namespace impl
+{
+
+
+
+/*-------------------------------------
+    Select the widest register which fits within N floats
+-------------------------------------*/
+struct VecNSelectf
+{
+#if defined(LS_X86_AVX512F)
+    template <unsigned N>
+    using traits = std::conditional_t<(N >= 16), SimdTraits512,
+                   std::conditional_t<(N >= 8), SimdTraits256,
+                   std::conditional_t<(N >= 4), SimdTraits128, SimdTraitsScalar>>>;
+#elif defined(LS_X86_AVX2)
+    template <unsigned N>
+    using traits = std::conditional_t<(N >= 8), SimdTraits256,
+                   std::conditional_t<(N >= 4), SimdTraits128, SimdTraitsScalar>>;
+#else
+    template <unsigned N>
+    using traits = std::conditional_t<(N >= 4), SimdTraits128, SimdTraitsScalar>;
+#endif
+};
+
+
+
+/*-------------------------------------
+    Single-precision N-dimensional vectors
+-------------------------------------*/
+template <>
+struct VecNSimd<float> : VecNSimdKernels<VecNSelectf>
+{
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
+
+#endif /* LS_MATH_VECNF_IMPL_H */
@@ -0,0 +1,473 @@
+
+#include <atomic>
+#include <cstdlib> // std::getenv
+#include <cstring> // std::strcmp
+
+#include "lightsky/setup/Arch.h"
+#include "lightsky/setup/Compiler.h"
+
+#include "lightsky/math/dispatch.h"
+#include "lightsky/math/half.h"
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/vec_utils.h"
+
+#if defined(LS_ARCH_X86)
+    #if defined(LS_COMPILER_MSC)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace ls {
+namespace math {
+
+
+
+/*-----------------------------------------------------------------------------
+    Generic Kernels
+
+    These forward to the inline library functions and are compiled with the
+    same instruction set as the rest of the library.
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+    Matrix Multiplication
+-------------------------------------*/
+void generic_mat4_mul(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    const mat4_t<float>* pA = reinterpret_cast<const mat4_t<float>*>(a);
+    const mat4_t<float>* pB = reinterpret_cast<const mat4_t<float>*>(b);
+    mat4_t<float>* pOut = reinterpret_cast<mat4_t<float>*>(out);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pOut[i] = pA[i] * pB[i];
+    }
+}
+
+/*-------------------------------------
+    Vector Transformation
+-------------------------------------*/
+void generic_mat4_transform(const float* m, const float* v, float* out, std::size_t count) noexcept
+{
+    const mat4_t<float> mat = *reinterpret_cast<const mat4_t<float>*>(m);
+    const vec4_t<float>* pV = reinterpret_cast<const vec4_t<float>*>(v);
+    vec4_t<float>* pOut = reinterpret_cast<vec4_t<float>*>(out);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pOut[i] = mat * pV[i];
+    }
+}
+
+/*-------------------------------------
+    Vector Normalization
+-------------------------------------*/
+void generic_vec4_normalize(const float* v, float* out, std::size_t count) noexcept
+{
+    const vec4_t<float>* pV = reinterpret_cast<const vec4_t<float>*>(v);
+    vec4_t<float>* pOut = reinterpret_cast<vec4_t<float>*>(out);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pOut[i] = pV[i] / math::length(pV[i]);
+    }
+}
+
+/*-------------------------------------
+    Dot Products
+-------------------------------------*/
+void generic_vec4_dot(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    const vec4_t<float>* pA = reinterpret_cast<const vec4_t<float>*>(a);
+    const vec4_t<float>* pB = reinterpret_cast<const vec4_t<float>*>(b);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = math::dot(pA[i], pB[i]);
+    }
+}
+
+/*-------------------------------------
+    Float to Half Conversion
+-------------------------------------*/
+void generic_half_from_float(const float* in, uint16_t* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = half{in[i]}.bits;
+    }
+}
+
+/*-------------------------------------
+    Half to Float Conversion
+-------------------------------------*/
+void generic_float_from_half(const uint16_t* in, float* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        half h;
+        h.bits = in[i];
+        out[i] = (float)h;
+    }
+}
+
+#if defined(LS_ARM_NEON)
+    constexpr SimdLevel SIMD_LEVEL_BASELINE = SIMD_LEVEL_NEON;
+#else
+    constexpr SimdLevel SIMD_LEVEL_BASELINE = SIMD_LEVEL_GENERIC;
+#endif
+
+const impl::SimdDispatchTable SIMD_DISPATCH_GENERIC = {
+    SIMD_LEVEL_BASELINE,
+    &generic_mat4_mul,
+    &generic_mat4_transform,
+    &generic_vec4_normalize,
+    &generic_vec4_dot,
+    &generic_half_from_float,
+    &generic_float_from_half
+};
+
+
+
+/*-----------------------------------------------------------------------------
+    CPU Detection
+-----------------------------------------------------------------------------*/
+#if defined(LS_ARCH_X86)
+
+/*-------------------------------------
+    CPUID
+-------------------------------------*/
+void x86_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) noexcept
+{
+    #if defined(LS_COMPILER_MSC)
+        int r[4];
+        __cpuidex(r, (int)leaf, (int)subleaf);
+        regs[0] = (uint32_t)r[0];
+        regs[1] = (uint32_t)r[1];
+        regs[2] = (uint32_t)r[2];
+        regs[3] = (uint32_t)r[3];
+    #else
+        if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]))
+        {
+            regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        }
+    #endif
+}
+
+/*-------------------------------------
+    Extended Control Register 0 (OS-enabled register state)
+-------------------------------------*/
+uint64_t x86_xgetbv() noexcept
+{
+    #if defined(LS_COMPILER_MSC)
+        return (uint64_t)_xgetbv(0);
+    #else
+        uint32_t eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((uint64_t)edx << 32u) | (uint64_t)eax;
+    #endif
+}
+
+#endif /* LS_ARCH_X86 */
+
+/*-------------------------------------
+    Feature Detection
+-------------------------------------*/
+uint32_t detect_cpu_features() noexcept
+{
+    uint32_t features = 0;
+
+    #if defined(LS_ARCH_X86)
+        uint32_t leaf1[4];
+        uint32_t leaf7[4];
+
+        x86_cpuid(1, 0, leaf1);
+        x86_cpuid(7, 0, leaf7);
+
+        const bool osxsave = (leaf1[2] & (1u << 27u)) != 0;
+        const uint64_t xcr0 = osxsave ? x86_xgetbv() : 0;
+
+        // XMM & YMM state, then opmask & upper ZMM state
+        const bool osAvx    = (xcr0 & 0x06u) == 0x06u;
+        const bool osAvx512 = osAvx && (xcr0 & 0xE0u) == 0xE0u;
+
+        if (leaf1[3] & (1u << 26u)) features |= CPU_FEATURE_SSE2;
+        if (leaf1[2] & (1u << 19u)) features |= CPU_FEATURE_SSE4_1;
+
+        if (osAvx)
+        {
+            if (leaf1[2] & (1u << 28u)) features |= CPU_FEATURE_AVX;
+            if (leaf1[2] & (1u << 12u)) features |= CPU_FEATURE_FMA;
+            if (leaf1[2] & (1u << 29u)) features |= CPU_FEATURE_F16C;
+            if (leaf7[1] & (1u << 5u))  features |= CPU_FEATURE_AVX2;
+        }
+
+        if (osAvx512)
+        {
+            if (leaf7[1] & (1u << 16u)) features |= CPU_FEATURE_AVX512F;
+            if (leaf7[1] & (1u << 17u)) features |= CPU_FEATURE_AVX512DQ;
+            if (leaf7[1] & (1u << 30u)) features |= CPU_FEATURE_AVX512BW;
+            if (leaf7[1] & (1u << 31u)) features |= CPU_FEATURE_AVX512VL;
+            if (leaf7[3] & (1u << 23u)) features |= CPU_FEATURE_AVX512_FP16;
+        }
+
+    #elif defined(LS_ARM_NEON)
+        features |= CPU_FEATURE_NEON;
+    #endif
+
+    return features;
+}
+
+/*-------------------------------------
+    Kernel table lookup
+-------------------------------------*/
+const impl::SimdDispatchTable* find_dispatch_table(SimdLevel level) noexcept
+{
+    const uint32_t features = cpu_features();
+    constexpr uint32_t avx2Features = CPU_FEATURE_AVX | CPU_FEATURE_AVX2 | CPU_FEATURE_FMA | CPU_FEATURE_F16C;
+    constexpr uint32_t avx512Features = avx2Features | CPU_FEATURE_AVX512F | CPU_FEATURE_AVX512VL | CPU_FEATURE_AVX512BW | CPU_FEATURE_AVX512DQ;
+
+    switch (level)
+    {
+        #if defined(LS_ARCH_X86)
+            case SIMD_LEVEL_GENERIC:
+                return &SIMD_DISPATCH_GENERIC;
+
+            case SIMD_LEVEL_SSE2:
+                return (features & CPU_FEATURE_SSE2) ? &impl::SIMD_DISPATCH_SSE2 : nullptr;
+
+            case SIMD_LEVEL_SSE4_1:
+                return (features & CPU_FEATURE_SSE4_1) ? &impl::SIMD_DISPATCH_SSE4_1 : nullptr;
+
+            case SIMD_LEVEL_AVX2:
+                return ((features & avx2Features) == avx2Features) ? &impl::SIMD_DISPATCH_AVX2 : nullptr;
+
+            case SIMD_LEVEL_AVX512:
+                return ((features & avx512Features) == avx512Features) ? &impl::SIMD_DISPATCH_AVX512 : nullptr;
+        #else
+            case SIMD_LEVEL_BASELINE:
+                (void)features;
+                (void)avx512Features;
+                return &SIMD_DISPATCH_GENERIC;
+        #endif
+
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+/*-------------------------------------
+    Select the best table available, optionally capped by the environment
+-------------------------------------*/
+const impl::SimdDispatchTable* select_dispatch_table() noexcept
+{
+    SimdLevel maxLevel = simd_level_max();
+    const char* const envLevel = std::getenv("LS_MATH_SIMD_LEVEL");
+
+    if (envLevel)
+    {
+        for (unsigned level = SIMD_LEVEL_GENERIC; level <= SIMD_LEVEL_NEON; ++level)
+        {
+            if (std::strcmp(envLevel, simd_level_name((SimdLevel)level)) == 0 && find_dispatch_table((SimdLevel)level))
+            {
+                maxLevel = (SimdLevel)level;
+                break;
+            }
+        }
+    }
+
+    return find_dispatch_table(maxLevel);
+}
+
+std::atomic<const impl::SimdDispatchTable*> gDispatchTable{nullptr};
+
+/*-------------------------------------
+    Retrieve the active table, selecting one on first use
+-------------------------------------*/
+inline const impl::SimdDispatchTable* dispatch_table() noexcept
+{
+    const impl::SimdDispatchTable* pTable = gDispatchTable.load(std::memory_order_acquire);
+
+    if (!pTable)
+    {
+        static const impl::SimdDispatchTable* const pInitialTable = []() noexcept->const impl::SimdDispatchTable*
+        {
+            const impl::SimdDispatchTable* pSelected = select_dispatch_table();
+            gDispatchTable.store(pSelected, std::memory_order_release);
+            return pSelected;
+        }();
+
+        pTable = gDispatchTable.load(std::memory_order_acquire);
+        (void)pInitialTable;
+    }
+
+    return pTable;
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Query API
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    CPU Features
+-------------------------------------*/
+uint32_t cpu_features() noexcept
+{
+    static const uint32_t features = detect_cpu_features();
+    return features;
+}
+
+/*-------------------------------------
+    Active SIMD Level
+-------------------------------------*/
+SimdLevel simd_level() noexcept
+{
+    return dispatch_table()->level;
+}
+
+/*-------------------------------------
+    Maximum SIMD Level
+-------------------------------------*/
+SimdLevel simd_level_max() noexcept
+{
+    for (unsigned level = SIMD_LEVEL_NEON+1; level-- > SIMD_LEVEL_GENERIC;)
+    {
+        if (find_dispatch_table((SimdLevel)level))
+        {
+            return (SimdLevel)level;
+        }
+    }
+
+    return SIMD_LEVEL_BASELINE;
+}
+
+/*-------------------------------------
+    Level Support
+-------------------------------------*/
+bool simd_level_supported(SimdLevel level) noexcept
+{
+    return find_dispatch_table(level) != nullptr;
+}
+
+/*-------------------------------------
+    Change the active level
+-------------------------------------*/
+bool set_simd_level(SimdLevel level) noexcept
+{
+    const impl::SimdDispatchTable* pTable = find_dispatch_table(level);
+    if (!pTable)
+    {
+        return false;
+    }
+
+    // Ensure the startup selection can't overwrite this one
+    (void)dispatch_table();
+
+    gDispatchTable.store(pTable, std::memory_order_release);
+    return true;
+}
+
+/*-------------------------------------
+    Level Names
+-------------------------------------*/
+const char* simd_level_name(SimdLevel level) noexcept
+{
+    switch (level)
+    {
+        case SIMD_LEVEL_GENERIC: return "generic";
+        case SIMD_LEVEL_SSE2:    return "sse2";
+        case SIMD_LEVEL_SSE4_1:  return "sse4.1";
+        case SIMD_LEVEL_AVX2:    return "avx2";
+        case SIMD_LEVEL_AVX512:  return "avx512";
+        case SIMD_LEVEL_NEON:    return "neon";
+    }
+
+    return "unknown";
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Dispatched Batch Kernels
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Matrix Multiplication
+-------------------------------------*/
+void mat4_mul_batch(
+    const mat4_t<float>* a,
+    const mat4_t<float>* b,
+    mat4_t<float>* out,
+    std::size_t count) noexcept
+{
+    dispatch_table()->mat4_mul(
+        reinterpret_cast<const float*>(a),
+        reinterpret_cast<const float*>(b),
+        reinterpret_cast<float*>(out),
+        count);
+}
+
+/*-------------------------------------
+    Vector Transformation
+-------------------------------------*/
+void mat4_transform_batch(
+    const mat4_t<float>& m,
+    const vec4_t<float>* v,
+    vec4_t<float>* out,
+    std::size_t count) noexcept
+{
+    dispatch_table()->mat4_transform(
+        reinterpret_cast<const float*>(&m),
+        reinterpret_cast<const float*>(v),
+        reinterpret_cast<float*>(out),
+        count);
+}
+
+/*-------------------------------------
+    Vector Normalization
+-------------------------------------*/
+void vec4_normalize_batch(const vec4_t<float>* v, vec4_t<float>* out, std::size_t count) noexcept
+{
+    dispatch_table()->vec4_normalize(reinterpret_cast<const float*>(v), reinterpret_cast<float*>(out), count);
+}
+
+/*-------------------------------------
+    Dot Products
+-------------------------------------*/
+void vec4_dot_batch(
+    const vec4_t<float>* a,
+    const vec4_t<float>* b,
+    float* out,
+    std::size_t count) noexcept
+{
+    dispatch_table()->vec4_dot(reinterpret_cast<const float*>(a), reinterpret_cast<const float*>(b), out, count);
+}
+
+/*-------------------------------------
+    Float to Half Conversion
+-------------------------------------*/
+void half_from_float_batch(const float* in, half* out, std::size_t count) noexcept
+{
+    dispatch_table()->half_from_float(in, reinterpret_cast<uint16_t*>(out), count);
+}
+
+/*-------------------------------------
+    Half to Float Conversion
+-------------------------------------*/
+void float_from_half_batch(const half* in, float* out, std::size_t count) noexcept
+{
+    dispatch_table()->float_from_half(reinterpret_cast<const uint16_t*>(in), out, count);
+}
+
+
+
+} // end math namespace
+} // end ls namespace
@@ -10,5 +10,17 @@ namespace math {
 LS_DEFINE_CLASS_TYPE(PerlinNoise, float);
 LS_DEFINE_CLASS_TYPE(PerlinNoise, double);
 
+/*-------------------------------------
+    Value Noise Specializations
+-------------------------------------*/
+LS_DEFINE_CLASS_TYPE(ValueNoise, float);
+LS_DEFINE_CLASS_TYPE(ValueNoise, double);
+
+/*-------------------------------------
+    Worley Noise Specializations
+-------------------------------------*/
+LS_DEFINE_CLASS_TYPE(WorleyNoise, float);
+LS_DEFINE_CLASS_TYPE(WorleyNoise, double);
+
 } /* End math namespace */
 } /* End ls namespace */
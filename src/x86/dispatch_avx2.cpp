@@ -0,0 +1,213 @@
+
+/*
+ * AVX2, FMA, and F16C batch kernels for runtime dispatch.
+ *
+ * This file is compiled with AVX2 code generation. It must only include
+ * system headers and dispatch.h so no inline library code is emitted using
+ * instructions the rest of the library wasn't built for.
+ */
+#include <immintrin.h>
+
+#include "lightsky/math/dispatch.h"
+
+namespace ls {
+namespace math {
+namespace impl {
+namespace avx2 {
+
+
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+    Horizontal sum of each 128-bit lane, broadcast within the lane
+-------------------------------------*/
+inline __m256 sum4x2(__m256 a) noexcept
+{
+    const __m256 b = _mm256_add_ps(a, _mm256_permute_ps(a, 0xB1));
+    return _mm256_add_ps(b, _mm256_permute_ps(b, 0x4E));
+}
+
+/*-------------------------------------
+    Transform two vectors, one per 128-bit lane
+-------------------------------------*/
+inline __m256 transform2(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) noexcept
+{
+    const __m256 s0 = _mm256_fmadd_ps(c1, _mm256_permute_ps(v, 0x55), _mm256_mul_ps(c0, _mm256_permute_ps(v, 0x00)));
+    const __m256 s1 = _mm256_fmadd_ps(c3, _mm256_permute_ps(v, 0xFF), _mm256_mul_ps(c2, _mm256_permute_ps(v, 0xAA)));
+    return _mm256_add_ps(s0, s1);
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Kernels
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Matrix Multiplication
+-------------------------------------*/
+void mat4_mul(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i, a += 16, b += 16, out += 16)
+    {
+        const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+        const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a+4));
+        const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a+8));
+        const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a+12));
+
+        const __m256 n01 = _mm256_loadu_ps(b);
+        const __m256 n23 = _mm256_loadu_ps(b+8);
+
+        const __m256 r01 = transform2(c0, c1, c2, c3, n01);
+        const __m256 r23 = transform2(c0, c1, c2, c3, n23);
+
+        _mm256_storeu_ps(out,   r01);
+        _mm256_storeu_ps(out+8, r23);
+    }
+}
+
+/*-------------------------------------
+    Vector Transformation
+-------------------------------------*/
+void mat4_transform(const float* m, const float* v, float* out, std::size_t count) noexcept
+{
+    const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+    const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m+4));
+    const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m+8));
+    const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m+12));
+    std::size_t i = 0;
+
+    for (; i+4 <= count; i += 4, v += 16, out += 16)
+    {
+        const __m256 r01 = transform2(c0, c1, c2, c3, _mm256_loadu_ps(v));
+        const __m256 r23 = transform2(c0, c1, c2, c3, _mm256_loadu_ps(v+8));
+        _mm256_storeu_ps(out,   r01);
+        _mm256_storeu_ps(out+8, r23);
+    }
+
+    for (; i < count; ++i, v += 4, out += 4)
+    {
+        const __m256 r = transform2(c0, c1, c2, c3, _mm256_castps128_ps256(_mm_loadu_ps(v)));
+        _mm_storeu_ps(out, _mm256_castps256_ps128(r));
+    }
+}
+
+/*-------------------------------------
+    Vector Normalization
+-------------------------------------*/
+void vec4_normalize(const float* v, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+2 <= count; i += 2, v += 8, out += 8)
+    {
+        const __m256 n = _mm256_loadu_ps(v);
+        _mm256_storeu_ps(out, _mm256_div_ps(n, _mm256_sqrt_ps(sum4x2(_mm256_mul_ps(n, n)))));
+    }
+
+    if (i < count)
+    {
+        const __m128 n = _mm_loadu_ps(v);
+        const __m128 d = _mm256_castps256_ps128(sum4x2(_mm256_castps128_ps256(_mm_mul_ps(n, n))));
+        _mm_storeu_ps(out, _mm_div_ps(n, _mm_sqrt_ps(d)));
+    }
+}
+
+/*-------------------------------------
+    Dot Products
+-------------------------------------*/
+void vec4_dot(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+8 <= count; i += 8, a += 32, b += 32)
+    {
+        const __m256 p01 = _mm256_mul_ps(_mm256_loadu_ps(a),    _mm256_loadu_ps(b));
+        const __m256 p23 = _mm256_mul_ps(_mm256_loadu_ps(a+8),  _mm256_loadu_ps(b+8));
+        const __m256 p45 = _mm256_mul_ps(_mm256_loadu_ps(a+16), _mm256_loadu_ps(b+16));
+        const __m256 p67 = _mm256_mul_ps(_mm256_loadu_ps(a+24), _mm256_loadu_ps(b+24));
+
+        // Lane 0 contains the even dot products, lane 1 the odd ones
+        const __m256 d = _mm256_hadd_ps(_mm256_hadd_ps(p01, p23), _mm256_hadd_ps(p45, p67));
+        const __m128 even = _mm256_castps256_ps128(d);
+        const __m128 odd = _mm256_extractf128_ps(d, 1);
+
+        _mm_storeu_ps(out+i,   _mm_unpacklo_ps(even, odd));
+        _mm_storeu_ps(out+i+4, _mm_unpackhi_ps(even, odd));
+    }
+
+    for (; i < count; ++i, a += 4, b += 4)
+    {
+        _mm_store_ss(out+i, _mm_dp_ps(_mm_loadu_ps(a), _mm_loadu_ps(b), 0xF1));
+    }
+}
+
+/*-------------------------------------
+    Float to Half Conversion
+-------------------------------------*/
+void half_from_float(const float* in, uint16_t* out, std::size_t count) noexcept
+{
+    constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+    std::size_t i = 0;
+
+    for (; i+8 <= count; i += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in+i), rounding);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out+i), h);
+    }
+
+    for (; i < count; ++i)
+    {
+        out[i] = (uint16_t)_mm_cvtsi128_si32(_mm_cvtps_ph(_mm_set_ss(in[i]), rounding));
+    }
+}
+
+/*-------------------------------------
+    Half to Float Conversion
+-------------------------------------*/
+void float_from_half(const uint16_t* in, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+8 <= count; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in+i));
+        _mm256_storeu_ps(out+i, _mm256_cvtph_ps(h));
+    }
+
+    for (; i < count; ++i)
+    {
+        out[i] = _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128((int)in[i])));
+    }
+}
+
+
+
+} // end avx2 namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Dispatch Table
+-----------------------------------------------------------------------------*/
+const SimdDispatchTable SIMD_DISPATCH_AVX2 = {
+    SIMD_LEVEL_AVX2,
+    &avx2::mat4_mul,
+    &avx2::mat4_transform,
+    &avx2::vec4_normalize,
+    &avx2::vec4_dot,
+    &avx2::half_from_float,
+    &avx2::float_from_half
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
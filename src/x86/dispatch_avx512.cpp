@@ -0,0 +1,279 @@
+
+/*
+ * AVX-512 (F, VL, BW, DQ) batch kernels for runtime dispatch.
+ *
+ * This file is compiled with AVX-512 code generation. It must only include
+ * system headers and dispatch.h so no inline library code is emitted using
+ * instructions the rest of the library wasn't built for.
+ */
+#include <immintrin.h>
+
+#include "lightsky/math/dispatch.h"
+
+namespace ls {
+namespace math {
+namespace impl {
+namespace avx512 {
+
+
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+    Full register masks
+
+    GCC implements many unmasked AVX-512 intrinsics by merging into an
+    undefined register, then warns about it once they're inlined. Their
+    zero-masked forms compile to the same instructions when given a full
+    mask.
+-------------------------------------*/
+constexpr __mmask16 all_floats = (__mmask16)0xFFFF;
+constexpr __mmask8 all_doubles = (__mmask8)0xFF;
+
+/*-------------------------------------
+    Mask of the first "n" 4D vectors in a register
+-------------------------------------*/
+inline __mmask16 vec4_mask(std::size_t n) noexcept
+{
+    return (__mmask16)((1u << (n*4u)) - 1u);
+}
+
+/*-------------------------------------
+    Horizontal sum of each 128-bit lane, broadcast within the lane
+-------------------------------------*/
+inline __m512 sum4x4(__m512 a) noexcept
+{
+    const __m512 b = _mm512_add_ps(a, _mm512_maskz_permute_ps(all_floats, a, 0xB1));
+    return _mm512_add_ps(b, _mm512_maskz_permute_ps(all_floats, b, 0x4E));
+}
+
+/*-------------------------------------
+    Transform four vectors, one per 128-bit lane
+-------------------------------------*/
+inline __m512 transform4(__m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v) noexcept
+{
+    const __m512 s0 = _mm512_fmadd_ps(c1, _mm512_maskz_permute_ps(all_floats, v, 0x55), _mm512_mul_ps(c0, _mm512_maskz_permute_ps(all_floats, v, 0x00)));
+    const __m512 s1 = _mm512_fmadd_ps(c3, _mm512_maskz_permute_ps(all_floats, v, 0xFF), _mm512_mul_ps(c2, _mm512_maskz_permute_ps(all_floats, v, 0xAA)));
+    return _mm512_add_ps(s0, s1);
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Kernels
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Matrix Multiplication
+-------------------------------------*/
+void mat4_mul(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    // Each product fills one register: the columns of "a" are broadcast to
+    // all lanes, and each lane holds one column of "b". Four independent
+    // products are kept in flight to hide FMA latency.
+    std::size_t i = 0;
+
+    for (; i+4 <= count; i += 4, a += 64, b += 64, out += 64)
+    {
+        __m512 r[4];
+
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            const float* const pA = a + j*16;
+            const __m512 c0 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(pA));
+            const __m512 c1 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(pA+4));
+            const __m512 c2 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(pA+8));
+            const __m512 c3 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(pA+12));
+
+            r[j] = transform4(c0, c1, c2, c3, _mm512_loadu_ps(b + j*16));
+        }
+
+        _mm512_storeu_ps(out,    r[0]);
+        _mm512_storeu_ps(out+16, r[1]);
+        _mm512_storeu_ps(out+32, r[2]);
+        _mm512_storeu_ps(out+48, r[3]);
+    }
+
+    for (; i < count; ++i, a += 16, b += 16, out += 16)
+    {
+        const __m512 c0 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(a));
+        const __m512 c1 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(a+4));
+        const __m512 c2 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(a+8));
+        const __m512 c3 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(a+12));
+
+        _mm512_storeu_ps(out, transform4(c0, c1, c2, c3, _mm512_loadu_ps(b)));
+    }
+}
+
+
+
+/*-------------------------------------
+    Vector Transformation
+-------------------------------------*/
+void mat4_transform(const float* m, const float* v, float* out, std::size_t count) noexcept
+{
+    const __m512 c0 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(m));
+    const __m512 c1 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(m+4));
+    const __m512 c2 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(m+8));
+    const __m512 c3 = _mm512_maskz_broadcast_f32x4(all_floats, _mm_loadu_ps(m+12));
+    std::size_t i = 0;
+
+    // 16 vectors per iteration, then up to 4 masked iterations
+    for (; i+16 <= count; i += 16, v += 64, out += 64)
+    {
+        const __m512 r0 = transform4(c0, c1, c2, c3, _mm512_loadu_ps(v));
+        const __m512 r1 = transform4(c0, c1, c2, c3, _mm512_loadu_ps(v+16));
+        const __m512 r2 = transform4(c0, c1, c2, c3, _mm512_loadu_ps(v+32));
+        const __m512 r3 = transform4(c0, c1, c2, c3, _mm512_loadu_ps(v+48));
+
+        _mm512_storeu_ps(out,    r0);
+        _mm512_storeu_ps(out+16, r1);
+        _mm512_storeu_ps(out+32, r2);
+        _mm512_storeu_ps(out+48, r3);
+    }
+
+    for (; i < count; i += 4, v += 16, out += 16)
+    {
+        const __mmask16 mask = vec4_mask((count-i < 4) ? (count-i) : 4);
+        const __m512 r = transform4(c0, c1, c2, c3, _mm512_maskz_loadu_ps(mask, v));
+        _mm512_mask_storeu_ps(out, mask, r);
+    }
+}
+
+
+
+/*-------------------------------------
+    Vector Normalization
+-------------------------------------*/
+void vec4_normalize(const float* v, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+16 <= count; i += 16, v += 64, out += 64)
+    {
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            const __m512 n = _mm512_loadu_ps(v + j*16);
+            _mm512_storeu_ps(out + j*16, _mm512_div_ps(n, _mm512_maskz_sqrt_ps(all_floats, sum4x4(_mm512_mul_ps(n, n)))));
+        }
+    }
+
+    for (; i < count; i += 4, v += 16, out += 16)
+    {
+        const __mmask16 mask = vec4_mask((count-i < 4) ? (count-i) : 4);
+        const __m512 n = _mm512_maskz_loadu_ps(mask, v);
+        _mm512_mask_storeu_ps(out, mask, _mm512_div_ps(n, _mm512_maskz_sqrt_ps(all_floats, sum4x4(_mm512_mul_ps(n, n)))));
+    }
+}
+
+
+
+/*-------------------------------------
+    Dot Products
+-------------------------------------*/
+void vec4_dot(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    // Element "4L+k" of the transposed sum holds dot product "4k+L"
+    const __m512i order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    std::size_t i = 0;
+
+    for (; i < count; i += 16, a += 64, b += 64)
+    {
+        const std::size_t n = (count-i < 16) ? (count-i) : 16;
+        __m512 p[4];
+
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            const std::size_t numVecs = (n > j*4u) ? (n - j*4u) : 0u;
+            const __mmask16 mask = vec4_mask(numVecs < 4u ? numVecs : 4u);
+            p[j] = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a+j*16), _mm512_maskz_loadu_ps(mask, b+j*16));
+        }
+
+        // Transpose the 4x4 blocks in each 128-bit lane, then sum the rows
+        const __m512 t0 = _mm512_maskz_unpacklo_ps(all_floats, p[0], p[1]);
+        const __m512 t1 = _mm512_maskz_unpacklo_ps(all_floats, p[2], p[3]);
+        const __m512 t2 = _mm512_maskz_unpackhi_ps(all_floats, p[0], p[1]);
+        const __m512 t3 = _mm512_maskz_unpackhi_ps(all_floats, p[2], p[3]);
+
+        const __m512 r0 = _mm512_castpd_ps(_mm512_maskz_unpacklo_pd(all_doubles, _mm512_castps_pd(t0), _mm512_castps_pd(t1)));
+        const __m512 r1 = _mm512_castpd_ps(_mm512_maskz_unpackhi_pd(all_doubles, _mm512_castps_pd(t0), _mm512_castps_pd(t1)));
+        const __m512 r2 = _mm512_castpd_ps(_mm512_maskz_unpacklo_pd(all_doubles, _mm512_castps_pd(t2), _mm512_castps_pd(t3)));
+        const __m512 r3 = _mm512_castpd_ps(_mm512_maskz_unpackhi_pd(all_doubles, _mm512_castps_pd(t2), _mm512_castps_pd(t3)));
+
+        const __m512 sum = _mm512_add_ps(_mm512_add_ps(r0, r1), _mm512_add_ps(r2, r3));
+        _mm512_mask_storeu_ps(out+i, (__mmask16)((1u << n) - 1u), _mm512_maskz_permutexvar_ps(all_floats, order, sum));
+    }
+}
+
+/*-------------------------------------
+    Float to Half Conversion
+-------------------------------------*/
+void half_from_float(const float* in, uint16_t* out, std::size_t count) noexcept
+{
+    constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+    std::size_t i = 0;
+
+    for (; i+16 <= count; i += 16)
+    {
+        const __m256i h = _mm512_maskz_cvtps_ph(all_floats, _mm512_loadu_ps(in+i), rounding);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+i), h);
+    }
+
+    if (i < count)
+    {
+        const __mmask16 mask = (__mmask16)((1u << (count-i)) - 1u);
+        const __m256i h = _mm512_maskz_cvtps_ph(all_floats, _mm512_maskz_loadu_ps(mask, in+i), rounding);
+        _mm256_mask_storeu_epi16(out+i, mask, h);
+    }
+}
+
+/*-------------------------------------
+    Half to Float Conversion
+-------------------------------------*/
+void float_from_half(const uint16_t* in, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+16 <= count; i += 16)
+    {
+        const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in+i));
+        _mm512_storeu_ps(out+i, _mm512_maskz_cvtph_ps(all_floats, h));
+    }
+
+    if (i < count)
+    {
+        const __mmask16 mask = (__mmask16)((1u << (count-i)) - 1u);
+        const __m256i h = _mm256_maskz_loadu_epi16(mask, in+i);
+        _mm512_mask_storeu_ps(out+i, mask, _mm512_maskz_cvtph_ps(all_floats, h));
+    }
+}
+
+
+
+} // end avx512 namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Dispatch Table
+-----------------------------------------------------------------------------*/
+const SimdDispatchTable SIMD_DISPATCH_AVX512 = {
+    SIMD_LEVEL_AVX512,
+    &avx512::mat4_mul,
+    &avx512::mat4_transform,
+    &avx512::vec4_normalize,
+    &avx512::vec4_dot,
+    &avx512::half_from_float,
+    &avx512::float_from_half
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
@@ -0,0 +1,301 @@
+
+/*
+ * SSE2 batch kernels for runtime dispatch.
+ *
+ * This file is compiled with SSE2 code generation. It must only include
+ * system headers and dispatch.h so no inline library code is emitted using
+ * instructions the rest of the library wasn't built for.
+ */
+#include <emmintrin.h>
+
+#include "lightsky/math/dispatch.h"
+
+namespace ls {
+namespace math {
+namespace impl {
+namespace sse2 {
+
+
+
+/*-----------------------------------------------------------------------------
+    Internal Helpers
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+    Convert 4 floats to halves, in the low 16 bits of each 32-bit lane.
+    Mirrors Float16Converter::single_to_half().
+-------------------------------------*/
+inline __m128i half_from_float4(__m128 f) noexcept
+{
+    const __m128i w       = _mm_castps_si128(f);
+    const __m128i sign    = _mm_and_si128(w, _mm_set1_epi32((int)0x80000000u));
+    const __m128i absW    = _mm_and_si128(w, _mm_set1_epi32(0x7FFFFFFF));
+    const __m128  toInf   = _mm_castsi128_ps(_mm_set1_epi32(0x77800000));
+    const __m128  toZero  = _mm_castsi128_ps(_mm_set1_epi32(0x08800000));
+    const __m128  scaled  = _mm_mul_ps(_mm_mul_ps(_mm_castsi128_ps(absW), toInf), toZero);
+
+    // Clamp the exponent so subnormal halves round correctly
+    __m128i exponent = _mm_srli_epi32(absW, 23);
+    const __m128i minExp = _mm_set1_epi32(0x71);
+    const __m128i tooSmall = _mm_cmplt_epi32(exponent, minExp);
+    exponent = _mm_or_si128(_mm_and_si128(tooSmall, minExp), _mm_andnot_si128(tooSmall, exponent));
+
+    const __m128 bias = _mm_castsi128_ps(_mm_add_epi32(_mm_slli_epi32(exponent, 23), _mm_set1_epi32(0x07800000)));
+    const __m128i bits = _mm_castps_si128(_mm_add_ps(bias, scaled));
+
+    const __m128i expBits  = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(0x00007C00));
+    const __m128i mantBits = _mm_and_si128(bits, _mm_set1_epi32(0x00000FFF));
+    const __m128i nonsign  = _mm_add_epi32(expBits, mantBits);
+
+    const __m128i isNan  = _mm_cmpgt_epi32(absW, _mm_set1_epi32(0x7F800000));
+    const __m128i result = _mm_or_si128(
+        _mm_and_si128(isNan, _mm_set1_epi32(0x00007E00)),
+        _mm_andnot_si128(isNan, nonsign));
+
+    return _mm_or_si128(_mm_srli_epi32(sign, 16), result);
+}
+
+/*-------------------------------------
+    Convert 4 halves, in the upper 16 bits of each 32-bit lane, to floats.
+-------------------------------------*/
+inline __m128 float_from_half4(__m128i w) noexcept
+{
+    const __m128i sign = _mm_and_si128(w, _mm_set1_epi32((int)0x80000000u));
+    const __m128i twoW = _mm_add_epi32(w, w);
+
+    // Rebias the exponent of normal numbers (2^-112 == 0x07800000)
+    const __m128i normBits = _mm_add_epi32(_mm_srli_epi32(twoW, 4), _mm_set1_epi32(0x70000000));
+    const __m128  normal   = _mm_mul_ps(_mm_castsi128_ps(normBits), _mm_castsi128_ps(_mm_set1_epi32(0x07800000)));
+
+    // Subnormal halves are normalized using a magic number, 0.5f
+    const __m128i magic     = _mm_set1_epi32(126 << 23);
+    const __m128  subnormal = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(twoW, 17), magic)), _mm_set1_ps(0.5f));
+
+    const __m128i isSubnormal = _mm_cmpeq_epi32(_mm_srli_epi32(twoW, 27), _mm_setzero_si128());
+    const __m128i result = _mm_or_si128(
+        _mm_and_si128(isSubnormal, _mm_castps_si128(subnormal)),
+        _mm_andnot_si128(isSubnormal, _mm_castps_si128(normal)));
+
+    return _mm_castsi128_ps(_mm_or_si128(sign, result));
+}
+
+/*-------------------------------------
+    Convert 8 floats to halves
+-------------------------------------*/
+inline void half_from_float8(const float* in, uint16_t* out) noexcept
+{
+    const __m128i lo = half_from_float4(_mm_loadu_ps(in));
+    const __m128i hi = half_from_float4(_mm_loadu_ps(in+4));
+
+    // sign-extend so signed saturation leaves each value intact
+    const __m128i packed = _mm_packs_epi32(
+        _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+        _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+}
+
+/*-------------------------------------
+    Convert 8 halves to floats
+-------------------------------------*/
+inline void float_from_half8(const uint16_t* in, float* out) noexcept
+{
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    const __m128i zero = _mm_setzero_si128();
+
+    const __m128 lo = float_from_half4(_mm_unpacklo_epi16(zero, h));
+    const __m128 hi = float_from_half4(_mm_unpackhi_epi16(zero, h));
+
+    _mm_storeu_ps(out, lo);
+    _mm_storeu_ps(out+4, hi);
+}
+
+/*-------------------------------------
+    Horizontal sum, broadcast to all lanes
+-------------------------------------*/
+inline __m128 sum4(__m128 a) noexcept
+{
+    const __m128 b = _mm_add_ps(a, _mm_shuffle_ps(a, a, 0xB1));
+    return _mm_add_ps(b, _mm_shuffle_ps(b, b, 0x4E));
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Kernels
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Matrix Multiplication
+-------------------------------------*/
+void mat4_mul(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i, a += 16, b += 16, out += 16)
+    {
+        const __m128 c0 = _mm_loadu_ps(a);
+        const __m128 c1 = _mm_loadu_ps(a+4);
+        const __m128 c2 = _mm_loadu_ps(a+8);
+        const __m128 c3 = _mm_loadu_ps(a+12);
+        __m128 r[4];
+
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            const __m128 n = _mm_loadu_ps(b+j*4);
+            __m128 s;
+            s = _mm_mul_ps(c0, _mm_shuffle_ps(n, n, 0x00));
+            s = _mm_add_ps(_mm_mul_ps(c1, _mm_shuffle_ps(n, n, 0x55)), s);
+            s = _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(n, n, 0xAA)), s);
+            r[j] = _mm_add_ps(_mm_mul_ps(c3, _mm_shuffle_ps(n, n, 0xFF)), s);
+        }
+
+        _mm_storeu_ps(out,    r[0]);
+        _mm_storeu_ps(out+4,  r[1]);
+        _mm_storeu_ps(out+8,  r[2]);
+        _mm_storeu_ps(out+12, r[3]);
+    }
+}
+
+/*-------------------------------------
+    Vector Transformation
+-------------------------------------*/
+void mat4_transform(const float* m, const float* v, float* out, std::size_t count) noexcept
+{
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m+4);
+    const __m128 c2 = _mm_loadu_ps(m+8);
+    const __m128 c3 = _mm_loadu_ps(m+12);
+
+    for (std::size_t i = 0; i < count; ++i, v += 4, out += 4)
+    {
+        const __m128 n = _mm_loadu_ps(v);
+        const __m128 s0 = _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(n, n, 0x00)), _mm_mul_ps(c1, _mm_shuffle_ps(n, n, 0x55)));
+        const __m128 s1 = _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(n, n, 0xAA)), _mm_mul_ps(c3, _mm_shuffle_ps(n, n, 0xFF)));
+        _mm_storeu_ps(out, _mm_add_ps(s0, s1));
+    }
+}
+
+/*-------------------------------------
+    Vector Normalization
+-------------------------------------*/
+void vec4_normalize(const float* v, float* out, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i, v += 4, out += 4)
+    {
+        const __m128 n = _mm_loadu_ps(v);
+        _mm_storeu_ps(out, _mm_div_ps(n, _mm_sqrt_ps(sum4(_mm_mul_ps(n, n)))));
+    }
+}
+
+/*-------------------------------------
+    Dot Products
+-------------------------------------*/
+void vec4_dot(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+4 <= count; i += 4, a += 16, b += 16)
+    {
+        __m128 p0 = _mm_mul_ps(_mm_loadu_ps(a),    _mm_loadu_ps(b));
+        __m128 p1 = _mm_mul_ps(_mm_loadu_ps(a+4),  _mm_loadu_ps(b+4));
+        __m128 p2 = _mm_mul_ps(_mm_loadu_ps(a+8),  _mm_loadu_ps(b+8));
+        __m128 p3 = _mm_mul_ps(_mm_loadu_ps(a+12), _mm_loadu_ps(b+12));
+
+        _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+        _mm_storeu_ps(out+i, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+    }
+
+    for (; i < count; ++i, a += 4, b += 4)
+    {
+        _mm_store_ss(out+i, sum4(_mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))));
+    }
+}
+
+/*-------------------------------------
+    Float to Half Conversion
+-------------------------------------*/
+void half_from_float(const float* in, uint16_t* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+8 <= count; i += 8)
+    {
+        half_from_float8(in+i, out+i);
+    }
+
+    if (i < count)
+    {
+        float temp[8] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+        uint16_t result[8];
+
+        for (std::size_t j = i; j < count; ++j)
+        {
+            temp[j-i] = in[j];
+        }
+
+        half_from_float8(temp, result);
+
+        for (std::size_t j = i; j < count; ++j)
+        {
+            out[j] = result[j-i];
+        }
+    }
+}
+
+/*-------------------------------------
+    Half to Float Conversion
+-------------------------------------*/
+void float_from_half(const uint16_t* in, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+8 <= count; i += 8)
+    {
+        float_from_half8(in+i, out+i);
+    }
+
+    if (i < count)
+    {
+        uint16_t temp[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        float result[8];
+
+        for (std::size_t j = i; j < count; ++j)
+        {
+            temp[j-i] = in[j];
+        }
+
+        float_from_half8(temp, result);
+
+        for (std::size_t j = i; j < count; ++j)
+        {
+            out[j] = result[j-i];
+        }
+    }
+}
+
+
+
+} // end sse2 namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Dispatch Table
+-----------------------------------------------------------------------------*/
+const SimdDispatchTable SIMD_DISPATCH_SSE2 = {
+    SIMD_LEVEL_SSE2,
+    &sse2::mat4_mul,
+    &sse2::mat4_transform,
+    &sse2::vec4_normalize,
+    &sse2::vec4_dot,
+    &sse2::half_from_float,
+    &sse2::float_from_half
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
@@ -0,0 +1,86 @@
+
+/*
+ * SSE4.1 batch kernels for runtime dispatch.
+ *
+ * This file is compiled with SSE4.1 code generation. It must only include
+ * system headers and dispatch.h so no inline library code is emitted using
+ * instructions the rest of the library wasn't built for.
+ */
+#include <smmintrin.h>
+
+#include "lightsky/math/dispatch.h"
+
+namespace ls {
+namespace math {
+namespace impl {
+
+
+
+/*-----------------------------------------------------------------------------
+    Kernels shared with the SSE2 variant
+-----------------------------------------------------------------------------*/
+namespace sse2
+{
+
+void mat4_mul(const float* a, const float* b, float* out, std::size_t count) noexcept;
+
+void mat4_transform(const float* m, const float* v, float* out, std::size_t count) noexcept;
+
+// DPPS is slower than shuffles & adds for a single horizontal sum
+void vec4_normalize(const float* v, float* out, std::size_t count) noexcept;
+
+void half_from_float(const float* in, uint16_t* out, std::size_t count) noexcept;
+
+void float_from_half(const uint16_t* in, float* out, std::size_t count) noexcept;
+
+} // end sse2 namespace
+
+
+
+namespace sse4_1 {
+
+/*-------------------------------------
+    Dot Products
+-------------------------------------*/
+void vec4_dot(const float* a, const float* b, float* out, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i+4 <= count; i += 4, a += 16, b += 16)
+    {
+        const __m128 p0 = _mm_mul_ps(_mm_loadu_ps(a),    _mm_loadu_ps(b));
+        const __m128 p1 = _mm_mul_ps(_mm_loadu_ps(a+4),  _mm_loadu_ps(b+4));
+        const __m128 p2 = _mm_mul_ps(_mm_loadu_ps(a+8),  _mm_loadu_ps(b+8));
+        const __m128 p3 = _mm_mul_ps(_mm_loadu_ps(a+12), _mm_loadu_ps(b+12));
+
+        _mm_storeu_ps(out+i, _mm_hadd_ps(_mm_hadd_ps(p0, p1), _mm_hadd_ps(p2, p3)));
+    }
+
+    for (; i < count; ++i, a += 4, b += 4)
+    {
+        _mm_store_ss(out+i, _mm_dp_ps(_mm_loadu_ps(a), _mm_loadu_ps(b), 0xF1));
+    }
+}
+
+} // end sse4_1 namespace
+
+
+
+/*-----------------------------------------------------------------------------
+    Dispatch Table
+-----------------------------------------------------------------------------*/
+const SimdDispatchTable SIMD_DISPATCH_SSE4_1 = {
+    SIMD_LEVEL_SSE4_1,
+    &sse2::mat4_mul,
+    &sse2::mat4_transform,
+    &sse2::vec4_normalize,
+    &sse4_1::vec4_dot,
+    &sse2::half_from_float,
+    &sse2::float_from_half
+};
+
+
+
+} // end impl namespace
+} // end math namespace
+} // end ls namespace
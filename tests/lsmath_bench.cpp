@@ -0,0 +1,876 @@
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#elif defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#endif
+
+#define GLM_ENABLE_EXPERIMENTAL 1
+#define GLM_FORCE_XYZW_ONLY 1
+#include "glm/glm.hpp"
+#include "glm/gtc/noise.hpp"
+#include "glm/gtc/packing.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "lightsky/math/dispatch.h"
+#include "lightsky/math/half.h"
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/mat_utils.h"
+#include "lightsky/math/noise.h"
+#include "lightsky/math/quat.h"
+#include "lightsky/math/quat_utils.h"
+#include "lightsky/math/vec4.h"
+#include "lightsky/math/vec_utils.h"
+
+
+
+namespace chrono = std::chrono;
+typedef chrono::steady_clock::time_point hr_time;
+typedef chrono::nanoseconds hr_prec;
+
+namespace math = ls::math;
+
+
+
+/*-----------------------------------------------------------------------------
+    Benchmark Options
+-----------------------------------------------------------------------------*/
+struct BenchArgs
+{
+    unsigned samples = 31;
+    std::size_t batchSize = 4096;
+    double minSampleMs = 2.0;
+    double warmupMs = 100.0;
+    int cpu = 0;
+    const char* filter = nullptr;
+    const char* jsonFile = nullptr;
+    const char* csvFile = nullptr;
+};
+
+struct BenchResult
+{
+    const char* op;
+    const char* library;
+    const char* mode;
+    unsigned long long opsPerSample;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double stddevNs;
+    double p95Ns;
+};
+
+
+
+/*-------------------------------------
+    Print the program usage
+-------------------------------------*/
+void print_usage(const char* programName) noexcept
+{
+    std::cout
+        << "Usage: " << programName << " [options]\n"
+        << "\nMeasures the throughput & latency of LightMath operations against GLM and"
+        << "\nthe C++ standard library. Runtime-dispatched batch kernels are measured at"
+        << "\nevery SIMD level supported by the CPU, reported in the \"mode\" column."
+        << "\n\nOptions:"
+        << "\n\t-f, --filter <text>     Only run operations whose name contains <text>."
+        << "\n\t-n, --samples <n>       Number of timed samples per benchmark (default: 31)."
+        << "\n\t-b, --batch <n>         Number of inputs per throughput sample (default: 4096)."
+        << "\n\t-m, --min-time <ms>     Minimum duration of each sample (default: 2)."
+        << "\n\t-w, --warmup <ms>       Warm-up time before each benchmark (default: 100)."
+        << "\n\t-c, --cpu <n>           Pin the benchmark thread to a CPU, or -1 to disable"
+        << "\n\t                        pinning (default: 0)."
+        << "\n\t-j, --json <file>       Write results to a JSON file."
+        << "\n\t-o, --csv <file>        Write results to a CSV file."
+        << "\n\t--help                  Print this message."
+        << std::endl;
+}
+
+
+
+/*-------------------------------------
+    Parse command-line arguments
+-------------------------------------*/
+int parse_args(int argc, char** argv, BenchArgs& args) noexcept
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* opt = argv[i];
+
+        if (!std::strcmp(opt, "--help"))
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for option " << opt << std::endl;
+            return -1;
+        }
+
+        const char* val = argv[++i];
+        bool valid = true;
+
+        if (!std::strcmp(opt, "-f") || !std::strcmp(opt, "--filter"))
+        {
+            args.filter = val;
+        }
+        else if (!std::strcmp(opt, "-n") || !std::strcmp(opt, "--samples"))
+        {
+            args.samples = (unsigned)std::strtoul(val, nullptr, 10);
+            valid = args.samples > 0;
+        }
+        else if (!std::strcmp(opt, "-b") || !std::strcmp(opt, "--batch"))
+        {
+            args.batchSize = (std::size_t)std::strtoull(val, nullptr, 10);
+            valid = args.batchSize > 0;
+        }
+        else if (!std::strcmp(opt, "-m") || !std::strcmp(opt, "--min-time"))
+        {
+            args.minSampleMs = std::strtod(val, nullptr);
+            valid = args.minSampleMs > 0.0;
+        }
+        else if (!std::strcmp(opt, "-w") || !std::strcmp(opt, "--warmup"))
+        {
+            args.warmupMs = std::strtod(val, nullptr);
+            valid = args.warmupMs >= 0.0;
+        }
+        else if (!std::strcmp(opt, "-c") || !std::strcmp(opt, "--cpu"))
+        {
+            args.cpu = (int)std::strtol(val, nullptr, 10);
+        }
+        else if (!std::strcmp(opt, "-j") || !std::strcmp(opt, "--json"))
+        {
+            args.jsonFile = val;
+        }
+        else if (!std::strcmp(opt, "-o") || !std::strcmp(opt, "--csv"))
+        {
+            args.csvFile = val;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << opt << std::endl;
+            return -1;
+        }
+
+        if (!valid)
+        {
+            std::cerr << "Invalid value for option " << opt << ": " << val << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Pin the calling thread to a single CPU
+-------------------------------------*/
+bool pin_thread(int cpu) noexcept
+{
+    #if defined(__linux__)
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) == 0;
+
+    #elif defined(_WIN32)
+        return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << (unsigned)cpu) != 0;
+
+    #else
+        (void)cpu;
+        return false;
+    #endif
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Measurement
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Prevent the compiler from discarding a result
+-------------------------------------*/
+template <typename data_t>
+inline void do_not_optimize(const data_t& x) noexcept
+{
+    #if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&x) : "memory");
+    #else
+        const volatile char sink = *reinterpret_cast<const volatile char*>(&x);
+        (void)sink;
+    #endif
+}
+
+
+
+/*-------------------------------------
+    Summarize the time of each sample
+-------------------------------------*/
+BenchResult summarize(const char* op, const char* library, const char* mode, unsigned long long opsPerSample, std::vector<double>& nsPerOp) noexcept
+{
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    const std::size_t n = nsPerOp.size();
+    double mean = 0.0;
+    for (double t : nsPerOp)
+    {
+        mean += t;
+    }
+    mean /= (double)n;
+
+    double variance = 0.0;
+    for (double t : nsPerOp)
+    {
+        variance += (t - mean) * (t - mean);
+    }
+    variance = (n > 1) ? variance / (double)(n - 1) : 0.0;
+
+    const double median = (n & 1) ? nsPerOp[n / 2] : 0.5 * (nsPerOp[n / 2 - 1] + nsPerOp[n / 2]);
+    const double p95 = nsPerOp[math::min<std::size_t>(n - 1, (std::size_t)std::ceil(0.95 * (double)n) - 1)];
+
+    return BenchResult{op, library, mode, opsPerSample, nsPerOp[0], median, mean, std::sqrt(variance), p95};
+}
+
+
+
+/*-------------------------------------
+    Time a function which performs "opsPerRun" operations. The number of
+    runs per sample is calibrated so each sample lasts at least the minimum
+    sample time, which keeps timer resolution out of the results.
+-------------------------------------*/
+template <typename run_func_t>
+BenchResult run_benchmark(
+    const BenchArgs& args,
+    const char* op,
+    const char* library,
+    const char* mode,
+    std::size_t opsPerRun,
+    run_func_t&& runFunc) noexcept
+{
+    const double minSampleNs = args.minSampleMs * 1.0e6;
+    const double warmupNs = args.warmupMs * 1.0e6;
+
+    // Warm-up caches, branch predictors, and CPU frequency scaling
+    std::size_t runsPerSample = 1;
+    double elapsed = 0.0;
+    double warmupElapsed = 0.0;
+
+    do
+    {
+        const hr_time t0 = chrono::steady_clock::now();
+        for (std::size_t r = 0; r < runsPerSample; ++r)
+        {
+            runFunc();
+        }
+        elapsed = (double)chrono::duration_cast<hr_prec>(chrono::steady_clock::now() - t0).count();
+        warmupElapsed += elapsed;
+
+        if (elapsed < minSampleNs)
+        {
+            runsPerSample *= 2;
+        }
+    }
+    while (elapsed < minSampleNs || warmupElapsed < warmupNs);
+
+    std::vector<double> nsPerOp;
+    nsPerOp.reserve(args.samples);
+
+    for (unsigned s = 0; s < args.samples; ++s)
+    {
+        const hr_time t0 = chrono::steady_clock::now();
+        for (std::size_t r = 0; r < runsPerSample; ++r)
+        {
+            runFunc();
+        }
+        const double ns = (double)chrono::duration_cast<hr_prec>(chrono::steady_clock::now() - t0).count();
+        nsPerOp.push_back(ns / (double)(runsPerSample * opsPerRun));
+    }
+
+    return summarize(op, library, mode, (unsigned long long)(runsPerSample * opsPerRun), nsPerOp);
+}
+
+
+
+/*-------------------------------------
+    Measure throughput by applying an operation to an array of independent
+    inputs.
+-------------------------------------*/
+template <typename in_t, typename out_t, typename op_func_t>
+void bench_throughput(
+    const BenchArgs& args,
+    const char* op,
+    const char* library,
+    const std::vector<in_t>& inputs,
+    op_func_t&& opFunc,
+    std::vector<BenchResult>& outResults) noexcept
+{
+    std::vector<out_t> outputs(inputs.size());
+
+    outResults.push_back(run_benchmark(args, op, library, "throughput", inputs.size(), [&]()->void
+    {
+        const in_t* const in = inputs.data();
+        out_t* const out = outputs.data();
+
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            out[i] = opFunc(in[i]);
+        }
+
+        do_not_optimize(outputs[0]);
+    }));
+}
+
+
+
+/*-------------------------------------
+    Measure latency by feeding the result of each operation into the next.
+-------------------------------------*/
+template <typename data_t, typename op_func_t>
+void bench_latency(
+    const BenchArgs& args,
+    const char* op,
+    const char* library,
+    const data_t& seed,
+    op_func_t&& opFunc,
+    std::vector<BenchResult>& outResults) noexcept
+{
+    constexpr std::size_t chainLength = 256;
+
+    outResults.push_back(run_benchmark(args, op, library, "latency", chainLength, [&]()->void
+    {
+        data_t x = seed;
+
+        for (std::size_t i = 0; i < chainLength; ++i)
+        {
+            x = opFunc(x);
+        }
+
+        do_not_optimize(x);
+    }));
+}
+
+
+
+/*-------------------------------------
+    Determine if an operation should be measured
+-------------------------------------*/
+inline bool is_selected(const BenchArgs& args, const char* op) noexcept
+{
+    return !args.filter || std::strstr(op, args.filter) != nullptr;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Input Generation
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Deterministic pseudo-random numbers within [lo, hi)
+-------------------------------------*/
+struct InputRng
+{
+    uint32_t state = 0x9E3779B9u;
+
+    float next(float lo, float hi) noexcept
+    {
+        state ^= state << 13u;
+        state ^= state >> 17u;
+        state ^= state << 5u;
+        return lo + (hi - lo) * ((float)(state >> 8u) * (1.f / 16777216.f));
+    }
+};
+
+template <typename gen_func_t>
+auto make_inputs(std::size_t count, gen_func_t&& genFunc) noexcept -> std::vector<decltype(genFunc())>
+{
+    std::vector<decltype(genFunc())> ret;
+    ret.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ret.push_back(genFunc());
+    }
+
+    return ret;
+}
+
+inline glm::mat4 to_glm(const math::mat4f& m) noexcept
+{
+    glm::mat4 ret;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        ret[i] = glm::vec4{m[i][0], m[i][1], m[i][2], m[i][3]};
+    }
+    return ret;
+}
+
+inline glm::quat to_glm(const math::quatf& q) noexcept
+{
+    // GLM's constructor is ordered (w, x, y, z)
+    return glm::quat{q[3], q[0], q[1], q[2]};
+}
+
+inline glm::vec4 to_glm(const math::vec4f& v) noexcept
+{
+    return glm::vec4{v[0], v[1], v[2], v[3]};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Benchmarks
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    4x4 Matrices
+-------------------------------------*/
+void bench_mat4(const BenchArgs& args, std::vector<BenchResult>& results) noexcept
+{
+    InputRng rng;
+    const std::vector<math::mat4f> ls = make_inputs(args.batchSize, [&]()->math::mat4f
+    {
+        // Well-conditioned affine transforms keep inverse() stable
+        const math::quatf q = math::normalize(math::quatf{rng.next(-1.f, 1.f), rng.next(-1.f, 1.f), rng.next(-1.f, 1.f), rng.next(0.1f, 1.f)});
+        math::mat4f m = math::quat_to_mat4(q);
+        m[3] = math::vec4f{rng.next(-10.f, 10.f), rng.next(-10.f, 10.f), rng.next(-10.f, 10.f), 1.f};
+        return m;
+    });
+
+    std::vector<glm::mat4> gl;
+    for (const math::mat4f& m : ls)
+    {
+        gl.push_back(to_glm(m));
+    }
+
+    const math::mat4f lsB = ls[ls.size() / 2];
+    const glm::mat4 glB = gl[gl.size() / 2];
+
+    if (is_selected(args, "mat4_mul"))
+    {
+        bench_throughput<math::mat4f, math::mat4f>(args, "mat4_mul", "lightmath", ls, [&](const math::mat4f& m)->math::mat4f {return m * lsB;}, results);
+        bench_throughput<glm::mat4, glm::mat4>(args, "mat4_mul", "glm", gl, [&](const glm::mat4& m)->glm::mat4 {return m * glB;}, results);
+        bench_latency(args, "mat4_mul", "lightmath", ls[0], [&](const math::mat4f& m)->math::mat4f {return m * lsB;}, results);
+        bench_latency(args, "mat4_mul", "glm", gl[0], [&](const glm::mat4& m)->glm::mat4 {return m * glB;}, results);
+    }
+
+    if (is_selected(args, "mat4_inverse"))
+    {
+        bench_throughput<math::mat4f, math::mat4f>(args, "mat4_inverse", "lightmath", ls, [](const math::mat4f& m)->math::mat4f {return math::inverse(m);}, results);
+        bench_throughput<glm::mat4, glm::mat4>(args, "mat4_inverse", "glm", gl, [](const glm::mat4& m)->glm::mat4 {return glm::inverse(m);}, results);
+        bench_latency(args, "mat4_inverse", "lightmath", ls[0], [](const math::mat4f& m)->math::mat4f {return math::inverse(m);}, results);
+        bench_latency(args, "mat4_inverse", "glm", gl[0], [](const glm::mat4& m)->glm::mat4 {return glm::inverse(m);}, results);
+    }
+
+    if (is_selected(args, "mat4_transpose"))
+    {
+        bench_throughput<math::mat4f, math::mat4f>(args, "mat4_transpose", "lightmath", ls, [](const math::mat4f& m)->math::mat4f {return math::transpose(m);}, results);
+        bench_throughput<glm::mat4, glm::mat4>(args, "mat4_transpose", "glm", gl, [](const glm::mat4& m)->glm::mat4 {return glm::transpose(m);}, results);
+        bench_latency(args, "mat4_transpose", "lightmath", ls[0], [](const math::mat4f& m)->math::mat4f {return math::transpose(m);}, results);
+        bench_latency(args, "mat4_transpose", "glm", gl[0], [](const glm::mat4& m)->glm::mat4 {return glm::transpose(m);}, results);
+    }
+}
+
+
+
+/*-------------------------------------
+    Quaternions & Vectors
+-------------------------------------*/
+void bench_quat_vec(const BenchArgs& args, std::vector<BenchResult>& results) noexcept
+{
+    InputRng rng;
+    const std::vector<math::quatf> lsQ = make_inputs(args.batchSize, [&]()->math::quatf
+    {
+        return math::normalize(math::quatf{rng.next(-1.f, 1.f), rng.next(-1.f, 1.f), rng.next(-1.f, 1.f), rng.next(-1.f, 1.f)});
+    });
+
+    const std::vector<math::vec4f> lsV = make_inputs(args.batchSize, [&]()->math::vec4f
+    {
+        return math::vec4f{rng.next(-100.f, 100.f), rng.next(-100.f, 100.f), rng.next(-100.f, 100.f), rng.next(-100.f, 100.f)};
+    });
+
+    std::vector<glm::quat> glQ;
+    std::vector<glm::vec4> glV;
+    for (std::size_t i = 0; i < args.batchSize; ++i)
+    {
+        glQ.push_back(to_glm(lsQ[i]));
+        glV.push_back(to_glm(lsV[i]));
+    }
+
+    const math::quatf lsTarget = lsQ[lsQ.size() / 2];
+    const glm::quat glTarget = glQ[glQ.size() / 2];
+
+    if (is_selected(args, "quat_slerp"))
+    {
+        bench_throughput<math::quatf, math::quatf>(args, "quat_slerp", "lightmath", lsQ, [&](const math::quatf& q)->math::quatf {return math::slerp(q, lsTarget, 0.37f);}, results);
+        bench_throughput<glm::quat, glm::quat>(args, "quat_slerp", "glm", glQ, [&](const glm::quat& q)->glm::quat {return glm::slerp(q, glTarget, 0.37f);}, results);
+        bench_latency(args, "quat_slerp", "lightmath", lsQ[0], [&](const math::quatf& q)->math::quatf {return math::slerp(q, lsTarget, 0.37f);}, results);
+        bench_latency(args, "quat_slerp", "glm", glQ[0], [&](const glm::quat& q)->glm::quat {return glm::slerp(q, glTarget, 0.37f);}, results);
+    }
+
+    if (is_selected(args, "vec4_normalize"))
+    {
+        bench_throughput<math::vec4f, math::vec4f>(args, "vec4_normalize", "lightmath", lsV, [](const math::vec4f& v)->math::vec4f {return math::normalize(v);}, results);
+        bench_throughput<glm::vec4, glm::vec4>(args, "vec4_normalize", "glm", glV, [](const glm::vec4& v)->glm::vec4 {return glm::normalize(v);}, results);
+        bench_throughput<math::vec4f, math::vec4f>(args, "vec4_normalize", "std", lsV, [](const math::vec4f& v)->math::vec4f
+        {
+            const float len = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2] + v[3]*v[3]);
+            return math::vec4f{v[0] / len, v[1] / len, v[2] / len, v[3] / len};
+        }, results);
+        bench_latency(args, "vec4_normalize", "lightmath", lsV[0], [](const math::vec4f& v)->math::vec4f {return math::normalize(v);}, results);
+        bench_latency(args, "vec4_normalize", "glm", glV[0], [](const glm::vec4& v)->glm::vec4 {return glm::normalize(v);}, results);
+    }
+
+    if (is_selected(args, "quat_normalize"))
+    {
+        bench_throughput<math::quatf, math::quatf>(args, "quat_normalize", "lightmath", lsQ, [](const math::quatf& q)->math::quatf {return math::normalize(q);}, results);
+        bench_throughput<glm::quat, glm::quat>(args, "quat_normalize", "glm", glQ, [](const glm::quat& q)->glm::quat {return glm::normalize(q);}, results);
+        bench_latency(args, "quat_normalize", "lightmath", lsQ[0], [](const math::quatf& q)->math::quatf {return math::normalize(q);}, results);
+        bench_latency(args, "quat_normalize", "glm", glQ[0], [](const glm::quat& q)->glm::quat {return glm::normalize(q);}, results);
+    }
+}
+
+
+
+/*-------------------------------------
+    Transcendental Functions
+-------------------------------------*/
+#define LS_BENCH_TRANSCENDENTAL(opName, lsFunc, glmFunc, stdFunc, lo, hi) \
+    if (is_selected(args, opName)) \
+    { \
+        InputRng rng; \
+        const std::vector<math::vec4f> lsV = make_inputs(args.batchSize, [&]()->math::vec4f {return math::vec4f{rng.next(lo, hi), rng.next(lo, hi), rng.next(lo, hi), rng.next(lo, hi)};}); \
+        std::vector<glm::vec4> glV; \
+        for (const math::vec4f& v : lsV) glV.push_back(to_glm(v)); \
+        \
+        bench_throughput<math::vec4f, math::vec4f>(args, opName, "lightmath", lsV, [](const math::vec4f& v)->math::vec4f {return lsFunc(v);}, results); \
+        bench_throughput<glm::vec4, glm::vec4>(args, opName, "glm", glV, [](const glm::vec4& v)->glm::vec4 {return glmFunc(v);}, results); \
+        bench_throughput<math::vec4f, math::vec4f>(args, opName, "std", lsV, [](const math::vec4f& v)->math::vec4f {return math::vec4f{stdFunc(v[0]), stdFunc(v[1]), stdFunc(v[2]), stdFunc(v[3])};}, results); \
+        bench_latency(args, opName, "lightmath", lsV[0], [](const math::vec4f& v)->math::vec4f {return lsFunc(v);}, results); \
+        bench_latency(args, opName, "glm", glV[0], [](const glm::vec4& v)->glm::vec4 {return glmFunc(v);}, results); \
+        bench_latency(args, opName, "std", lsV[0], [](const math::vec4f& v)->math::vec4f {return math::vec4f{stdFunc(v[0]), stdFunc(v[1]), stdFunc(v[2]), stdFunc(v[3])};}, results); \
+    }
+
+void bench_transcendentals(const BenchArgs& args, std::vector<BenchResult>& results) noexcept
+{
+    // Latency chains stay within each function's domain since sin, cos,
+    // atan, exp(x<=0), and log(x>=1) map their ranges onto themselves
+    LS_BENCH_TRANSCENDENTAL("vec4_sin",  math::sin,  glm::sin,  std::sin,  -10.f, 10.f)
+    LS_BENCH_TRANSCENDENTAL("vec4_cos",  math::cos,  glm::cos,  std::cos,  -10.f, 10.f)
+    LS_BENCH_TRANSCENDENTAL("vec4_atan", math::atan, glm::atan, std::atan, -10.f, 10.f)
+    LS_BENCH_TRANSCENDENTAL("vec4_exp",  math::exp,  glm::exp,  std::exp,  -10.f, 0.f)
+    LS_BENCH_TRANSCENDENTAL("vec4_log",  math::log,  glm::log,  std::log,  1.f,   100.f)
+}
+
+#undef LS_BENCH_TRANSCENDENTAL
+
+
+
+/*-------------------------------------
+    Half-Float Conversion
+-------------------------------------*/
+void bench_half(const BenchArgs& args, std::vector<BenchResult>& results) noexcept
+{
+    InputRng rng;
+    const std::vector<float> floats = make_inputs(args.batchSize, [&]()->float {return rng.next(-1000.f, 1000.f);});
+
+    std::vector<uint16_t> halfs;
+    for (float f : floats)
+    {
+        halfs.push_back(math::half{f}.bits);
+    }
+
+    if (is_selected(args, "half_from_float"))
+    {
+        bench_throughput<float, uint16_t>(args, "half_from_float", "lightmath", floats, [](float f)->uint16_t {return math::half{f}.bits;}, results);
+        bench_throughput<float, uint16_t>(args, "half_from_float", "glm", floats, [](float f)->uint16_t {return glm::packHalf1x16(f);}, results);
+    }
+
+    if (is_selected(args, "half_to_float"))
+    {
+        bench_throughput<uint16_t, float>(args, "half_to_float", "lightmath", halfs, [](uint16_t h)->float
+        {
+            math::half ret;
+            ret.bits = h;
+            return (float)ret;
+        }, results);
+        bench_throughput<uint16_t, float>(args, "half_to_float", "glm", halfs, [](uint16_t h)->float {return glm::unpackHalf1x16(h);}, results);
+    }
+
+    if (is_selected(args, "half_roundtrip"))
+    {
+        bench_latency(args, "half_roundtrip", "lightmath", floats[0], [](float f)->float {return (float)math::half{f};}, results);
+        bench_latency(args, "half_roundtrip", "glm", floats[0], [](float f)->float {return glm::unpackHalf1x16(glm::packHalf1x16(f));}, results);
+    }
+}
+
+
+
+/*-------------------------------------
+    Noise
+-------------------------------------*/
+void bench_noise(const BenchArgs& args, std::vector<BenchResult>& results) noexcept
+{
+    if (!is_selected(args, "perlin_noise"))
+    {
+        return;
+    }
+
+    InputRng rng;
+    const std::vector<math::vec3f> lsP = make_inputs(args.batchSize, [&]()->math::vec3f
+    {
+        return math::vec3f{rng.next(-64.f, 64.f), rng.next(-64.f, 64.f), rng.next(-64.f, 64.f)};
+    });
+
+    std::vector<glm::vec3> glP;
+    for (const math::vec3f& p : lsP)
+    {
+        glP.push_back(glm::vec3{p[0], p[1], p[2]});
+    }
+
+    const math::PerlinNoise<float> noise{0};
+
+    bench_throughput<math::vec3f, float>(args, "perlin_noise", "lightmath", lsP, [&](const math::vec3f& p)->float {return noise.get_noise(p);}, results);
+    bench_throughput<glm::vec3, float>(args, "perlin_noise", "glm", glP, [](const glm::vec3& p)->float {return glm::perlin(p);}, results);
+
+    std::vector<float> out(lsP.size());
+    results.push_back(run_benchmark(args, "perlin_noise", "lightmath", "batch", lsP.size(), [&]()->void
+    {
+        noise.get_noise(lsP.data(), out.data(), lsP.size());
+        do_not_optimize(out[0]);
+    }));
+}
+
+
+
+/*-------------------------------------
+    Runtime-Dispatched Batch Kernels, measured at every supported SIMD level
+-------------------------------------*/
+void bench_dispatch(const BenchArgs& args, std::vector<BenchResult>& results) noexcept
+{
+    InputRng rng;
+    const std::vector<math::mat4f> mats = make_inputs(args.batchSize, [&]()->math::mat4f
+    {
+        math::mat4f m;
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            m[i/4][i%4] = rng.next(-1.f, 1.f);
+        }
+        return m;
+    });
+
+    const std::vector<math::vec4f> vecs = make_inputs(args.batchSize, [&]()->math::vec4f
+    {
+        return math::vec4f{rng.next(-10.f, 10.f), rng.next(-10.f, 10.f), rng.next(-10.f, 10.f), rng.next(-10.f, 10.f)};
+    });
+
+    const std::vector<float> floats = make_inputs(args.batchSize, [&]()->float {return rng.next(-1000.f, 1000.f);});
+
+    std::vector<math::mat4f> outMats(mats.size());
+    std::vector<math::vec4f> outVecs(vecs.size());
+    std::vector<math::half> outHalfs(floats.size());
+    std::vector<float> outFloats(floats.size());
+
+    const math::SimdLevel startLevel = math::simd_level();
+
+    for (unsigned i = math::SIMD_LEVEL_GENERIC; i <= math::SIMD_LEVEL_NEON; ++i)
+    {
+        const math::SimdLevel level = (math::SimdLevel)i;
+        if (!math::set_simd_level(level))
+        {
+            continue;
+        }
+
+        const char* const levelName = math::simd_level_name(level);
+
+        if (is_selected(args, "mat4_mul_batch"))
+        {
+            results.push_back(run_benchmark(args, "mat4_mul_batch", "lightmath", levelName, mats.size(), [&]()->void
+            {
+                math::mat4_mul_batch(mats.data(), mats.data(), outMats.data(), mats.size());
+                do_not_optimize(outMats[0]);
+            }));
+        }
+
+        if (is_selected(args, "mat4_xform_batch"))
+        {
+            results.push_back(run_benchmark(args, "mat4_xform_batch", "lightmath", levelName, vecs.size(), [&]()->void
+            {
+                math::mat4_transform_batch(mats[0], vecs.data(), outVecs.data(), vecs.size());
+                do_not_optimize(outVecs[0]);
+            }));
+        }
+
+        if (is_selected(args, "vec4_norm_batch"))
+        {
+            results.push_back(run_benchmark(args, "vec4_norm_batch", "lightmath", levelName, vecs.size(), [&]()->void
+            {
+                math::vec4_normalize_batch(vecs.data(), outVecs.data(), vecs.size());
+                do_not_optimize(outVecs[0]);
+            }));
+        }
+
+        if (is_selected(args, "half_batch"))
+        {
+            results.push_back(run_benchmark(args, "half_batch", "lightmath", levelName, floats.size(), [&]()->void
+            {
+                math::half_from_float_batch(floats.data(), outHalfs.data(), floats.size());
+                math::float_from_half_batch(outHalfs.data(), outFloats.data(), floats.size());
+                do_not_optimize(outFloats[0]);
+            }));
+        }
+    }
+
+    math::set_simd_level(startLevel);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Reporting
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Print a table of results
+-------------------------------------*/
+void print_results(const std::vector<BenchResult>& results) noexcept
+{
+    std::printf("%-18s %-10s %-11s %12s %12s %12s %12s %14s\n", "operation", "library", "mode", "min (ns)", "median (ns)", "stddev (ns)", "p95 (ns)", "Mops/s");
+
+    for (const BenchResult& r : results)
+    {
+        std::printf(
+            "%-18s %-10s %-11s %12.3f %12.3f %12.3f %12.3f %14.2f\n",
+            r.op, r.library, r.mode, r.minNs, r.medianNs, r.stddevNs, r.p95Ns, 1.0e3 / r.medianNs);
+    }
+}
+
+
+
+/*-------------------------------------
+    Write a JSON file
+-------------------------------------*/
+bool write_json(const char* path, const BenchArgs& args, const std::vector<BenchResult>& results) noexcept
+{
+    std::FILE* f = std::fopen(path, "w");
+    if (!f)
+    {
+        return false;
+    }
+
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"samples\": %u,\n", args.samples);
+    std::fprintf(f, "  \"batch_size\": %llu,\n", (unsigned long long)args.batchSize);
+    std::fprintf(f, "  \"pinned_cpu\": %d,\n", args.cpu);
+    std::fprintf(f, "  \"results\": [\n");
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult& r = results[i];
+        std::fprintf(
+            f,
+            "    {\"operation\": \"%s\", \"library\": \"%s\", \"mode\": \"%s\", \"ops_per_sample\": %llu, "
+            "\"min_ns\": %.4f, \"median_ns\": %.4f, \"mean_ns\": %.4f, \"stddev_ns\": %.4f, \"p95_ns\": %.4f, "
+            "\"mops_per_sec\": %.4f}%s\n",
+            r.op, r.library, r.mode, r.opsPerSample,
+            r.minNs, r.medianNs, r.meanNs, r.stddevNs, r.p95Ns,
+            1.0e3 / r.medianNs,
+            (i + 1 < results.size()) ? "," : "");
+    }
+
+    std::fprintf(f, "  ]\n}\n");
+    std::fclose(f);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Write a CSV file
+-------------------------------------*/
+bool write_csv(const char* path, const std::vector<BenchResult>& results) noexcept
+{
+    std::FILE* f = std::fopen(path, "w");
+    if (!f)
+    {
+        return false;
+    }
+
+    std::fprintf(f, "operation,library,mode,ops_per_sample,min_ns,median_ns,mean_ns,stddev_ns,p95_ns,mops_per_sec\n");
+
+    for (const BenchResult& r : results)
+    {
+        std::fprintf(
+            f,
+            "%s,%s,%s,%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+            r.op, r.library, r.mode, r.opsPerSample,
+            r.minNs, r.medianNs, r.meanNs, r.stddevNs, r.p95Ns,
+            1.0e3 / r.medianNs);
+    }
+
+    std::fclose(f);
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Main
+-----------------------------------------------------------------------------*/
+int main(int argc, char** argv)
+{
+    BenchArgs args;
+    const int argStatus = parse_args(argc, argv, args);
+    if (argStatus)
+    {
+        return argStatus > 0 ? 0 : -1;
+    }
+
+    if (args.cpu >= 0 && !pin_thread(args.cpu))
+    {
+        std::cerr << "Unable to pin the benchmark thread to CPU " << args.cpu << ". Results may be noisy." << std::endl;
+        args.cpu = -1;
+    }
+
+    std::vector<BenchResult> results;
+
+    bench_mat4(args, results);
+    bench_quat_vec(args, results);
+    bench_transcendentals(args, results);
+    bench_half(args, results);
+    bench_noise(args, results);
+    bench_dispatch(args, results);
+
+    print_results(results);
+
+    if (args.jsonFile && !write_json(args.jsonFile, args, results))
+    {
+        std::cerr << "Unable to write " << args.jsonFile << std::endl;
+        return -1;
+    }
+
+    if (args.csvFile && !write_csv(args.csvFile, results))
+    {
+        std::cerr << "Unable to write " << args.csvFile << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
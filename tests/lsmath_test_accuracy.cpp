@@ -0,0 +1,255 @@
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#include "lightsky/math/accuracy.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Error Measurements
+-------------------------------------*/
+enum class ErrorType
+{
+    ULP,
+    ABSOLUTE,
+    RELATIVE
+};
+
+
+
+/*-------------------------------------
+    Distance between two floats, in units of least precision
+-------------------------------------*/
+double ulp_distance(float a, float b) noexcept
+{
+    if (std::isnan(a) || std::isnan(b))
+    {
+        return (std::isnan(a) && std::isnan(b)) ? 0.0 : HUGE_VAL;
+    }
+
+    int32_t ia, ib;
+    std::memcpy(&ia, &a, sizeof(float));
+    std::memcpy(&ib, &b, sizeof(float));
+
+    // map to a monotonic integer line
+    ia = (ia < 0) ? (int32_t)(0x80000000u - (uint32_t)ia) : ia;
+    ib = (ib < 0) ? (int32_t)(0x80000000u - (uint32_t)ib) : ib;
+
+    const int64_t diff = (int64_t)ia - (int64_t)ib;
+    return (double)(diff < 0 ? -diff : diff);
+}
+
+
+
+/*-------------------------------------
+    Error of a single result
+-------------------------------------*/
+double measure_error(ErrorType type, float x, double ref) noexcept
+{
+    switch (type)
+    {
+        case ErrorType::ABSOLUTE:
+            return std::fabs((double)x - ref);
+
+        case ErrorType::RELATIVE:
+            return (ref != 0.0) ? std::fabs(((double)x - ref) / ref) : std::fabs((double)x);
+
+        case ErrorType::ULP:
+        default:
+            break;
+    }
+
+    return ulp_distance(x, (float)ref);
+}
+
+
+
+/*-------------------------------------
+    Measure the error of a scalar function and its vec4 equivalent over a
+    2D grid of inputs, against a double-precision reference. Unary
+    functions ignore their "y" input.
+-------------------------------------*/
+template <typename scalar_func_t, typename vec_func_t, typename ref_func_t>
+int test_function(
+    const char* tier,
+    const char* name,
+    float xLo, float xHi, bool xLog,
+    float yLo, float yHi,
+    ErrorType errType,
+    double maxError,
+    scalar_func_t&& scalarFunc,
+    vec_func_t&& vecFunc,
+    ref_func_t&& refFunc) noexcept
+{
+    constexpr unsigned numX = 100003;
+    const unsigned numY = (yLo != yHi) ? 41 : 1;
+    double scalarErr = 0.0;
+    double vecErr = 0.0;
+
+    for (unsigned j = 0; j < numY; ++j)
+    {
+        const float y = (numY > 1) ? (yLo + (yHi - yLo) * ((float)j / (float)(numY - 1))) : yLo;
+
+        for (unsigned i = 0; i < numX; i += 4)
+        {
+            float x[4];
+            for (unsigned k = 0; k < 4; ++k)
+            {
+                const double t = (double)math::min(i + k, numX - 1) / (double)(numX - 1);
+                x[k] = xLog
+                    ? (float)std::exp(std::log((double)xLo) + (std::log((double)xHi) - std::log((double)xLo)) * t)
+                    : (float)((double)xLo + ((double)xHi - (double)xLo) * t);
+            }
+
+            const math::vec4f v = vecFunc(math::vec4f{x[0], x[1], x[2], x[3]}, math::vec4f{y});
+
+            for (unsigned k = 0; k < 4; ++k)
+            {
+                const double ref = refFunc((double)x[k], (double)y);
+                scalarErr = math::max(scalarErr, measure_error(errType, scalarFunc(x[k], y), ref));
+                vecErr = math::max(vecErr, measure_error(errType, v[k], ref));
+            }
+        }
+    }
+
+    const char* const units = (errType == ErrorType::ULP) ? " ULP" : (errType == ErrorType::ABSOLUTE ? " absolute" : " relative");
+
+    std::cout
+        << tier << "::" << name
+        << "\n\tMax Error (scalar): " << scalarErr << units
+        << "\n\tMax Error (vec4):   " << vecErr << units
+        << std::endl;
+
+    if (scalarErr > maxError || vecErr > maxError)
+    {
+        std::cerr << tier << "::" << name << " exceeded its documented error of " << maxError << units << '.' << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Test all functions within a tier
+-------------------------------------*/
+#define LS_TEST_UNARY(tier, func, lo, hi, isLog, errType, maxErr, ref) \
+    test_function( \
+        #tier, #func, lo, hi, isLog, 0.f, 0.f, errType, maxErr, \
+        [](float x, float)->float { return math::tier::func(x); }, \
+        [](const math::vec4f& x, const math::vec4f&)->math::vec4f { return math::tier::func(x); }, \
+        [](double x, double)->double { return ref; })
+
+#define LS_TEST_BINARY(tier, func, xLo, xHi, isLog, yLo, yHi, errType, maxErr, ref) \
+    test_function( \
+        #tier, #func, xLo, xHi, isLog, yLo, yHi, errType, maxErr, \
+        [](float x, float y)->float { return math::tier::func(x, y); }, \
+        [](const math::vec4f& x, const math::vec4f& y)->math::vec4f { return math::tier::func(x, y); }, \
+        [](double x, double y)->double { return ref; })
+
+
+
+int test_precise() noexcept
+{
+    constexpr ErrorType ulp = ErrorType::ULP;
+    int ret = 0;
+
+    ret |= LS_TEST_UNARY(precise, sin,         -8192.f,  8192.f,  false, ulp, 1.0, std::sin(x));
+    ret |= LS_TEST_UNARY(precise, cos,         -8192.f,  8192.f,  false, ulp, 1.0, std::cos(x));
+    ret |= LS_TEST_UNARY(precise, tan,         -1.5f,    1.5f,    false, ulp, 1.0, std::tan(x));
+    ret |= LS_TEST_UNARY(precise, asin,        -1.f,     1.f,     false, ulp, 1.0, std::asin(x));
+    ret |= LS_TEST_UNARY(precise, acos,        -1.f,     1.f,     false, ulp, 1.0, std::acos(x));
+    ret |= LS_TEST_UNARY(precise, atan,        -1000.f,  1000.f,  false, ulp, 1.0, std::atan(x));
+    ret |= LS_TEST_UNARY(precise, exp,         -87.f,    88.f,    false, ulp, 1.0, std::exp(x));
+    ret |= LS_TEST_UNARY(precise, exp2,        -126.f,   127.f,   false, ulp, 1.0, std::exp2(x));
+    ret |= LS_TEST_UNARY(precise, log,         1.0e-30f, 1.0e30f, true,  ulp, 1.0, std::log(x));
+    ret |= LS_TEST_UNARY(precise, log2,        1.0e-30f, 1.0e30f, true,  ulp, 1.0, std::log2(x));
+    ret |= LS_TEST_UNARY(precise, sqrt,        1.0e-30f, 1.0e30f, true,  ulp, 0.0, std::sqrt(x));
+    ret |= LS_TEST_UNARY(precise, inversesqrt, 1.0e-30f, 1.0e30f, true,  ulp, 1.0, 1.0 / std::sqrt(x));
+    ret |= LS_TEST_UNARY(precise, rcp,         1.0e-30f, 1.0e30f, true,  ulp, 0.0, 1.0 / x);
+
+    ret |= LS_TEST_BINARY(precise, atan2, -10.f, 10.f, false, -10.f, 10.f, ulp, 1.0, std::atan2(x, y));
+    ret |= LS_TEST_BINARY(precise, pow,   0.01f, 100.f, true, -10.f, 10.f, ulp, 1.0, std::pow(x, y));
+
+    return ret;
+}
+
+
+
+int test_balanced() noexcept
+{
+    constexpr ErrorType ulp = ErrorType::ULP;
+    int ret = 0;
+
+    // Skip the roots of periodic functions, where ULP are not meaningful
+    ret |= LS_TEST_UNARY(balanced, sin,         -8192.f,  8192.f,  false, ErrorType::ABSOLUTE, 1.2e-7, std::sin(x));
+    ret |= LS_TEST_UNARY(balanced, cos,         -8192.f,  8192.f,  false, ErrorType::ABSOLUTE, 1.2e-7, std::cos(x));
+    ret |= LS_TEST_UNARY(balanced, sin,         -3.14159f, 3.14159f, false, ulp, 2.0, std::sin(x));
+    ret |= LS_TEST_UNARY(balanced, cos,         -3.14159f, 3.14159f, false, ulp, 2.0, std::cos(x));
+    ret |= LS_TEST_UNARY(balanced, tan,         -1.5f,    1.5f,    false, ulp, 4.0, std::tan(x));
+    ret |= LS_TEST_UNARY(balanced, asin,        -1.f,     1.f,     false, ulp, 3.0, std::asin(x));
+    ret |= LS_TEST_UNARY(balanced, acos,        -1.f,     1.f,     false, ulp, 3.0, std::acos(x));
+    ret |= LS_TEST_UNARY(balanced, atan,        -1000.f,  1000.f,  false, ulp, 4.0, std::atan(x));
+    ret |= LS_TEST_UNARY(balanced, exp,         -87.f,    88.f,    false, ulp, 2.0, std::exp(x));
+    ret |= LS_TEST_UNARY(balanced, exp2,        -126.f,   127.f,   false, ulp, 2.0, std::exp2(x));
+    ret |= LS_TEST_UNARY(balanced, log,         1.0e-30f, 1.0e30f, true,  ulp, 2.0, std::log(x));
+    ret |= LS_TEST_UNARY(balanced, log2,        1.0e-30f, 1.0e30f, true,  ulp, 2.0, std::log2(x));
+    ret |= LS_TEST_UNARY(balanced, sqrt,        1.0e-30f, 1.0e30f, true,  ulp, 0.0, std::sqrt(x));
+    ret |= LS_TEST_UNARY(balanced, inversesqrt, 1.0e-30f, 1.0e30f, true,  ulp, 1.0, 1.0 / std::sqrt(x));
+    ret |= LS_TEST_UNARY(balanced, rcp,         1.0e-30f, 1.0e30f, true,  ulp, 0.0, 1.0 / x);
+
+    ret |= LS_TEST_BINARY(balanced, atan2, -10.f, 10.f, false, -10.f, 10.f, ulp, 4.0, std::atan2(x, y));
+    ret |= LS_TEST_BINARY(balanced, pow,   0.01f, 100.f, true, -10.f, 10.f, ulp, 1.0, std::pow(x, y));
+
+    return ret;
+}
+
+
+
+int test_fast() noexcept
+{
+    constexpr ErrorType abs = ErrorType::ABSOLUTE;
+    constexpr ErrorType rel = ErrorType::RELATIVE;
+    int ret = 0;
+
+    ret |= LS_TEST_UNARY(fast, sin,         -8192.f,  8192.f,  false, abs, 2.0e-3, std::sin(x));
+    ret |= LS_TEST_UNARY(fast, cos,         -8192.f,  8192.f,  false, abs, 2.0e-3, std::cos(x));
+    ret |= LS_TEST_UNARY(fast, tan,         -1.5f,    1.5f,    false, rel, 0.02,   std::tan(x));
+    ret |= LS_TEST_UNARY(fast, asin,        -1.f,     1.f,     false, abs, 0.011,  std::asin(x));
+    ret |= LS_TEST_UNARY(fast, acos,        -1.f,     1.f,     false, abs, 0.011,  std::acos(x));
+    ret |= LS_TEST_UNARY(fast, atan,        -1000.f,  1000.f,  false, abs, 0.011,  std::atan(x));
+    ret |= LS_TEST_UNARY(fast, exp,         -87.f,    88.f,    false, rel, 0.06,   std::exp(x));
+    ret |= LS_TEST_UNARY(fast, exp2,        -126.f,   127.f,   false, rel, 0.06,   std::exp2(x));
+    ret |= LS_TEST_UNARY(fast, log,         1.0e-30f, 1.0e30f, true,  abs, 1.0e-3, std::log(x));
+    ret |= LS_TEST_UNARY(fast, log2,        1.0e-30f, 1.0e30f, true,  abs, 1.0e-3, std::log2(x));
+    ret |= LS_TEST_UNARY(fast, sqrt,        1.0e-30f, 1.0e30f, true,  ErrorType::ULP, 0.0, std::sqrt(x));
+    ret |= LS_TEST_UNARY(fast, inversesqrt, 1.0e-30f, 1.0e30f, true,  ErrorType::ULP, 6.0, 1.0 / std::sqrt(x));
+    ret |= LS_TEST_UNARY(fast, rcp,         1.0e-30f, 1.0e30f, true,  rel, 4.0e-4, 1.0 / x);
+
+    ret |= LS_TEST_BINARY(fast, atan2, -10.f, 10.f, false, -10.f, 10.f, abs, 0.011, std::atan2(x, y));
+    ret |= LS_TEST_BINARY(fast, pow,   0.01f, 100.f, true, -10.f, 10.f, rel, 0.06,  std::pow(x, y));
+
+    return ret;
+}
+
+
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_precise();
+    ret |= test_balanced();
+    ret |= test_fast();
+
+    return ret ? -1 : 0;
+}
@@ -0,0 +1,549 @@
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/animation.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of floats
+-------------------------------------*/
+template <typename num_t>
+bool nearly_equal(num_t a, double b, double tolerance) noexcept
+{
+    const double scale = std::fabs(b) > 1.0 ? std::fabs(b) : 1.0;
+    return std::fabs((double)a - b) <= tolerance * scale;
+}
+
+template <unsigned N, typename a_type, typename b_type>
+bool nearly_equal(const a_type& a, const b_type& b, double tolerance) noexcept
+{
+    for (unsigned i = 0; i < N; ++i)
+    {
+        if (!nearly_equal(a[i], (double)b[i], tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Unsorted keyframes of a single track
+-------------------------------------*/
+template <typename key_t>
+struct TestTrack
+{
+    std::vector<double> times;
+    std::vector<key_t> keys;
+    math::AnimInterpolation interpolation;
+};
+
+
+
+/*-------------------------------------
+    Double-precision reference, using a linear search over sorted keys
+-------------------------------------*/
+template <typename key_t>
+key_t align(const key_t&, const key_t& k) noexcept
+{
+    return k;
+}
+
+math::quatd align(const math::quatd& ref, const math::quatd& q) noexcept
+{
+    return (math::dot(ref, q) < 0.0) ? (q * -1.0) : q;
+}
+
+// Linear rotation tracks are slerped, and cubic rotations are renormalized
+math::vec3d interpolate(const math::vec3d& a, const math::vec3d& b, double t) noexcept
+{
+    return math::mix(a, b, t);
+}
+
+math::quatd interpolate(const math::quatd& a, const math::quatd& b, double t) noexcept
+{
+    return math::slerp(a, b, t);
+}
+
+math::vec3d renormalize(const math::vec3d& v) noexcept
+{
+    return v;
+}
+
+math::quatd renormalize(const math::quatd& q) noexcept
+{
+    return math::normalize(q);
+}
+
+template <typename key_t>
+bool reference_sample(TestTrack<key_t> track, double t, key_t& out) noexcept
+{
+    const std::size_t n = track.times.size();
+    if (!n)
+    {
+        return false;
+    }
+
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return track.times[a] < track.times[b]; });
+
+    std::vector<double> times(n);
+    std::vector<key_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        times[i] = track.times[order[i]];
+        keys[i] = track.keys[order[i]];
+    }
+
+    std::size_t k = 0;
+    while (k+1 < n && times[k+1] <= t)
+    {
+        ++k;
+    }
+
+    if (k+1 >= n || t <= times[k] || track.interpolation == math::ANIM_INTERP_STEP)
+    {
+        out = keys[k];
+        return true;
+    }
+
+    const double u = (t - times[k]) / (times[k+1] - times[k]);
+    const key_t p1 = keys[k];
+    const key_t p2 = align(p1, keys[k+1]);
+
+    if (track.interpolation == math::ANIM_INTERP_LINEAR)
+    {
+        out = interpolate(p1, p2, u);
+        return true;
+    }
+
+    const double dt = times[k+1] - times[k];
+    const key_t m1 = (k > 0) ? (p2 - align(p1, keys[k-1])) * (dt / (times[k+1] - times[k-1])) : (p2 - p1);
+    const key_t m2 = (k+2 < n) ? (align(p2, keys[k+2]) - p1) * (dt / (times[k+2] - times[k])) : (p2 - p1);
+
+    out = renormalize(
+        p1 * (2.0*u*u*u - 3.0*u*u + 1.0)
+        + m1 * (u*u*u - 2.0*u*u + u)
+        + p2 * (-2.0*u*u*u + 3.0*u*u)
+        + m2 * (u*u*u - u*u));
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Sample a clip at many times, comparing against the reference
+-------------------------------------*/
+template <typename num_t>
+int test_clip(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr unsigned numBones = 37;
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    std::uniform_int_distribution<unsigned> keyDist{0, 12};
+    std::uniform_int_distribution<unsigned> interpDist{0, 2};
+
+    std::vector<TestTrack<math::vec3d>> posTracks(numBones), scaleTracks(numBones);
+    std::vector<TestTrack<math::quatd>> rotTracks(numBones);
+
+    const auto make_track = [&](auto& track, auto&& gen)
+    {
+        const unsigned numKeys = keyDist(prng);
+        track.interpolation = (math::AnimInterpolation)interpDist(prng);
+
+        // keys are unevenly spaced and their times are stored out of order
+        double time = dist(prng) * 0.5;
+        for (unsigned k = 0; k < numKeys; ++k)
+        {
+            time += 0.05 + 0.5 * (dist(prng) + 1.0);
+            track.times.push_back(time);
+            track.keys.push_back(gen());
+        }
+        std::shuffle(track.times.begin(), track.times.end(), prng);
+    };
+
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        make_track(posTracks[i], [&]() { return math::vec3d{dist(prng), dist(prng), dist(prng)} * 10.0; });
+        make_track(rotTracks[i], [&]() { return math::normalize(math::quatd{dist(prng), dist(prng), dist(prng), dist(prng)}); });
+        make_track(scaleTracks[i], [&]() { return math::vec3d{dist(prng), dist(prng), dist(prng)} + 2.0; });
+    }
+
+    // the last bone is left without any rotation tracks
+    rotTracks.back().times.clear();
+    rotTracks.back().keys.clear();
+
+    // Convert to the clip's precision
+    std::vector<std::vector<num_t>> times;
+    std::vector<std::vector<math::vec3_t<num_t>>> posKeys, scaleKeys;
+    std::vector<std::vector<math::quat_t<num_t>>> rotKeys;
+    std::vector<math::AnimationChannel<num_t, math::vec3_t<num_t>>> posChannels(numBones), scaleChannels(numBones);
+    std::vector<math::AnimationChannel<num_t, math::quat_t<num_t>>> rotChannels(numBones);
+
+    // Tracks are rounded to the clip's precision so the reference sees the
+    // same inputs
+    const auto convert_track = [&](auto& track, auto& outKeys, auto& channel)
+    {
+        typedef typename std::decay<decltype(track.keys[0])>::type double_key_t;
+        typedef typename std::decay<decltype(outKeys[0][0])>::type key_t;
+
+        times.emplace_back();
+        outKeys.emplace_back();
+        for (std::size_t k = 0; k < track.times.size(); ++k)
+        {
+            times.back().push_back((num_t)track.times[k]);
+            outKeys.back().push_back((key_t)track.keys[k]);
+            track.times[k] = (double)times.back()[k];
+            track.keys[k] = (double_key_t)outKeys.back()[k];
+        }
+        channel.times = times.back().data();
+        channel.keys = outKeys.back().data();
+        channel.count = track.times.size();
+        channel.interpolation = track.interpolation;
+    };
+
+    times.reserve(numBones * 3);
+    posKeys.reserve(numBones);
+    rotKeys.reserve(numBones);
+    scaleKeys.reserve(numBones);
+
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        convert_track(posTracks[i], posKeys, posChannels[i]);
+        convert_track(rotTracks[i], rotKeys, rotChannels[i]);
+        convert_track(scaleTracks[i], scaleKeys, scaleChannels[i]);
+    }
+
+    math::AnimationClip<num_t> clip;
+    clip.init(numBones, posChannels.data(), rotChannels.data(), scaleChannels.data());
+
+    int numErrors = 0;
+    double maxTime = 0.0;
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        for (const auto* track : {&posTracks[i].times, &rotTracks[i].times, &scaleTracks[i].times})
+        {
+            for (double time : *track)
+            {
+                maxTime = std::max(maxTime, time);
+            }
+        }
+    }
+
+    if (!nearly_equal(clip.duration(), maxTime, 1.e-6) || clip.num_bones() != numBones)
+    {
+        std::cerr << "Clip duration or bone count mismatch." << std::endl;
+        ++numErrors;
+    }
+
+    std::vector<math::vec3_t<num_t>> positions(numBones), scales(numBones);
+    std::vector<math::quat_t<num_t>> rotations(numBones);
+    math::AnimationCursor<num_t> cursor;
+
+    const auto check_time = [&](double t)
+    {
+        clip.sample((num_t)t, cursor, positions.data(), rotations.data(), scales.data());
+        t = (double)(num_t)t;
+
+        for (unsigned i = 0; i < numBones; ++i)
+        {
+            math::vec3d expectedPos{0.0}, expectedScale{1.0};
+            math::quatd expectedRot{0.0, 0.0, 0.0, 1.0};
+            reference_sample(posTracks[i], t, expectedPos);
+            reference_sample(scaleTracks[i], t, expectedScale);
+            reference_sample(rotTracks[i], t, expectedRot);
+
+            if (!nearly_equal<3>(positions[i], expectedPos, tolerance)
+            || !nearly_equal<3>(scales[i], expectedScale, tolerance)
+            || !nearly_equal<4>(rotations[i], expectedRot, tolerance))
+            {
+                std::cerr << "Sample mismatch for bone " << i << " at time " << t << '.' << std::endl;
+                ++numErrors;
+            }
+        }
+    };
+
+    // sequential playback, looping twice, then random seeks
+    for (unsigned loop = 0; loop < 2; ++loop)
+    {
+        for (double t = -0.5; t < maxTime + 0.5; t += 1.0 / 60.0)
+        {
+            check_time(t);
+        }
+    }
+
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        check_time((dist(prng) + 1.0) * 0.5 * maxTime);
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Double-precision pose blending reference
+-------------------------------------*/
+template <typename num_t, typename in_t>
+math::AnimationPose<num_t> convert_pose(const math::AnimationPose<in_t>& pose) noexcept
+{
+    math::AnimationPose<num_t> ret;
+    ret.resize(pose.num_bones());
+
+    for (unsigned i = 0; i < pose.num_bones(); ++i)
+    {
+        ret.positions[i] = (math::vec3_t<num_t>)pose.positions[i];
+        ret.rotations[i] = (math::quat_t<num_t>)pose.rotations[i];
+        ret.scales[i] = (math::vec3_t<num_t>)pose.scales[i];
+    }
+
+    return ret;
+}
+
+template <typename num_t>
+bool pose_matches(const math::AnimationPose<num_t>& pose, const math::AnimationPose<double>& expected, double tolerance) noexcept
+{
+    if (pose.num_bones() != expected.num_bones())
+    {
+        std::cerr << "Pose size mismatch." << std::endl;
+        return false;
+    }
+
+    bool ret = true;
+    for (unsigned i = 0; i < pose.num_bones(); ++i)
+    {
+        if (!nearly_equal<3>(pose.positions[i], expected.positions[i], tolerance)
+        || !nearly_equal<4>(pose.rotations[i], expected.rotations[i], tolerance)
+        || !nearly_equal<3>(pose.scales[i], expected.scales[i], tolerance))
+        {
+            std::cerr << "Pose mismatch for bone " << i << '.' << std::endl;
+            ret = false;
+        }
+    }
+
+    return ret;
+}
+
+// math::normalize() is only single-precision
+math::quatd exact_normalize(const math::quatd& q) noexcept
+{
+    return q * (1.0 / std::sqrt(math::dot(q, q)));
+}
+
+math::AnimationPose<double> reference_blend(
+    const std::vector<math::AnimationPose<double>>& poses,
+    const std::vector<double>& weights,
+    const std::vector<const std::vector<double>*>& masks) noexcept
+{
+    const unsigned numBones = poses[0].num_bones();
+    math::AnimationPose<double> ret;
+    ret.resize(numBones);
+
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        math::vec3d pos{0.0}, scale{0.0};
+        math::quatd rot{0.0, 0.0, 0.0, 0.0};
+        double total = 0.0;
+
+        for (std::size_t p = 0; p < poses.size(); ++p)
+        {
+            const double w = weights[p] * (masks[p] ? (*masks[p])[i] : 1.0);
+            pos += poses[p].positions[i] * w;
+            scale += poses[p].scales[i] * w;
+            rot += align(poses[0].rotations[i], poses[p].rotations[i]) * w;
+            total += w;
+        }
+
+        if (total != 0.0)
+        {
+            ret.positions[i] = pos / total;
+            ret.rotations[i] = exact_normalize(rot);
+            ret.scales[i] = scale / total;
+        }
+    }
+
+    return ret;
+}
+
+math::AnimationPose<double> reference_additive(
+    const math::AnimationPose<double>& base,
+    const math::AnimationPose<double>& pose,
+    const math::AnimationPose<double>& reference,
+    double weight,
+    const std::vector<double>& mask) noexcept
+{
+    math::AnimationPose<double> ret;
+    ret.resize(base.num_bones());
+
+    for (unsigned i = 0; i < base.num_bones(); ++i)
+    {
+        const double w = weight * mask[i];
+        const math::quatd delta = align(math::quatd{0.0, 0.0, 0.0, 1.0}, math::conjugate(reference.rotations[i]) * pose.rotations[i]);
+
+        ret.positions[i] = base.positions[i] + (pose.positions[i] - reference.positions[i]) * w;
+        ret.rotations[i] = base.rotations[i] * exact_normalize(math::lerp(math::quatd{0.0, 0.0, 0.0, 1.0}, delta, w));
+        ret.scales[i] = base.scales[i] * math::mix(math::vec3d{1.0}, pose.scales[i] / reference.scales[i], w);
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Blend, layer, and convert poses, comparing against the reference
+-------------------------------------*/
+template <typename num_t>
+int test_pose_blending(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr unsigned numBones = 23;
+    constexpr unsigned numPoses = 3;
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+
+    // Random poses, rounded to the tested precision
+    std::vector<math::AnimationPose<double>> poses(numPoses);
+    std::vector<math::AnimationPose<num_t>> testPoses(numPoses);
+    for (unsigned p = 0; p < numPoses; ++p)
+    {
+        math::AnimationPose<double> pose;
+        pose.resize(numBones);
+
+        for (unsigned i = 0; i < numBones; ++i)
+        {
+            pose.positions[i] = math::vec3d{dist(prng), dist(prng), dist(prng)} * 10.0;
+            pose.rotations[i] = exact_normalize(math::quatd{dist(prng), dist(prng), dist(prng), dist(prng)});
+            pose.scales[i] = math::vec3d{dist(prng), dist(prng), dist(prng)} + 2.0;
+        }
+
+        testPoses[p] = convert_pose<num_t>(pose);
+        poses[p] = convert_pose<double>(testPoses[p]);
+    }
+
+    // Bone 5 has no weight in any pose, and bone 6 only uses the last pose
+    std::vector<double> mask0(numBones), mask2(numBones);
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        mask0[i] = (double)(num_t)((dist(prng) + 1.0) * 0.5);
+        mask2[i] = (double)(num_t)((dist(prng) + 1.0) * 0.5);
+    }
+    mask0[5] = mask0[6] = mask2[5] = 0.0;
+    mask2[6] = 1.0;
+
+    const std::vector<num_t> testMask0{mask0.begin(), mask0.end()};
+    const std::vector<num_t> testMask2{mask2.begin(), mask2.end()};
+    const std::vector<double> weights{0.5, 0.0, 0.25};
+    const std::vector<num_t> testWeights{weights.begin(), weights.end()};
+
+    const math::AnimationPose<num_t>* posePtrs[numPoses] = {&testPoses[0], &testPoses[1], &testPoses[2]};
+    const num_t* maskPtrs[numPoses] = {testMask0.data(), nullptr, testMask2.data()};
+
+    int numErrors = 0;
+    math::AnimationPose<num_t> result;
+
+    // unmasked blending
+    math::blend_poses(posePtrs, testWeights.data(), nullptr, numPoses, result);
+    if (!pose_matches(result, reference_blend(poses, weights, {nullptr, nullptr, nullptr}), tolerance))
+    {
+        std::cerr << "Unmasked pose blending failed." << std::endl;
+        ++numErrors;
+    }
+
+    // masked blending, including bones without any weight
+    const math::AnimationPose<double> expectedBlend = reference_blend(poses, weights, {&mask0, nullptr, &mask2});
+    math::blend_poses(posePtrs, testWeights.data(), maskPtrs, numPoses, result);
+    if (!pose_matches(result, expectedBlend, tolerance))
+    {
+        std::cerr << "Masked pose blending failed." << std::endl;
+        ++numErrors;
+    }
+
+    // blending in-place
+    math::AnimationPose<num_t> aliased = testPoses[0];
+    const math::AnimationPose<num_t>* aliasedPtrs[numPoses] = {&aliased, &testPoses[1], &testPoses[2]};
+    math::blend_poses(aliasedPtrs, testWeights.data(), maskPtrs, numPoses, aliased);
+    if (!pose_matches(aliased, expectedBlend, tolerance))
+    {
+        std::cerr << "In-place pose blending failed." << std::endl;
+        ++numErrors;
+    }
+
+    // additive layers reproduce their source pose at full weight
+    math::AnimationPose<num_t> additive;
+    math::make_additive_pose(testPoses[1], testPoses[2], additive);
+    math::apply_additive_pose(testPoses[2], additive, num_t{1}, nullptr, result);
+    math::align_hemispheres(testPoses[1].rotations.data(), result.rotations.data(), numBones);
+    if (!pose_matches(result, poses[1], tolerance * 10.0))
+    {
+        std::cerr << "Additive pose round-trip failed." << std::endl;
+        ++numErrors;
+    }
+
+    // partial, masked layers applied in-place
+    aliased = testPoses[0];
+    math::apply_additive_pose(aliased, additive, num_t{0.75}, testMask0.data(), aliased);
+    math::AnimationPose<double> expectedAdditive = reference_additive(poses[0], poses[1], poses[2], (double)num_t{0.75}, mask0);
+    if (!pose_matches(aliased, expectedAdditive, tolerance * 10.0))
+    {
+        std::cerr << "Partial additive pose failed." << std::endl;
+        ++numErrors;
+    }
+
+    // matrices
+    std::vector<math::mat4_t<num_t>> matrices(numBones);
+    math::pose_to_matrices(testPoses[0], matrices.data());
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        math::mat4d expected = math::quat_to_mat4(poses[0].rotations[i]);
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            expected[c] = expected[c] * poses[0].scales[i][c];
+        }
+        expected[3] = math::vec4d{poses[0].positions[i][0], poses[0].positions[i][1], poses[0].positions[i][2], 1.0};
+
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            if (!nearly_equal<4>(matrices[i][c], expected[c], tolerance))
+            {
+                std::cerr << "Pose matrix mismatch for bone " << i << '.' << std::endl;
+                ++numErrors;
+                break;
+            }
+        }
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    std::mt19937 prng{5678};
+    int numErrors = 0;
+
+    numErrors += test_clip<float>(prng, 1.e-4);
+    numErrors += test_clip<double>(prng, 1.e-9);
+    numErrors += test_pose_blending<float>(prng, 1.e-5);
+    numErrors += test_pose_blending<double>(prng, 1.e-12);
+
+    std::cout << "Tested animation clips & poses: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
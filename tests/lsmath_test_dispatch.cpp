@@ -0,0 +1,211 @@
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/dispatch.h"
+#include "lightsky/math/half.h"
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/vec_utils.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of floats
+-------------------------------------*/
+bool nearly_equal(float a, float b, float tolerance = 1.e-5f) noexcept
+{
+    const float scale = std::fabs(a) > 1.f ? std::fabs(a) : 1.f;
+    return std::fabs(a - b) <= tolerance * scale;
+}
+
+
+
+/*-------------------------------------
+    Test every kernel for the active SIMD level.
+    Odd counts exercise the tail of each kernel.
+-------------------------------------*/
+int test_level(math::SimdLevel level) noexcept
+{
+    constexpr std::size_t count = 37;
+    std::mt19937 prng{1234};
+    std::uniform_real_distribution<float> dist{-10.f, 10.f};
+    int numErrors = 0;
+
+    std::vector<math::mat4> matsA(count), matsB(count), matsOut(count);
+    std::vector<math::vec4> vecsA(count), vecsB(count), vecsOut(count);
+    std::vector<float> dots(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (unsigned j = 0; j < 16; ++j)
+        {
+            matsA[i][j/4][j%4] = dist(prng);
+            matsB[i][j/4][j%4] = dist(prng);
+        }
+
+        vecsA[i] = math::vec4{dist(prng), dist(prng), dist(prng), dist(prng)};
+        vecsB[i] = math::vec4{dist(prng), dist(prng), dist(prng), dist(prng)};
+    }
+
+    math::mat4_mul_batch(matsA.data(), matsB.data(), matsOut.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const math::mat4 expected = matsA[i] * matsB[i];
+        for (unsigned j = 0; j < 16; ++j)
+        {
+            if (!nearly_equal(matsOut[i][j/4][j%4], expected[j/4][j%4], 1.e-4f))
+            {
+                std::cerr << "mat4_mul_batch mismatch at " << i << '[' << j << "]." << std::endl;
+                ++numErrors;
+                break;
+            }
+        }
+    }
+
+    math::mat4_transform_batch(matsA[0], vecsA.data(), vecsOut.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const math::vec4 expected = matsA[0] * vecsA[i];
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            if (!nearly_equal(vecsOut[i][j], expected[j], 1.e-4f))
+            {
+                std::cerr << "mat4_transform_batch mismatch at " << i << '[' << j << "]." << std::endl;
+                ++numErrors;
+                break;
+            }
+        }
+    }
+
+    math::vec4_normalize_batch(vecsA.data(), vecsOut.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const math::vec4 expected = vecsA[i] / math::length(vecsA[i]);
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            if (!nearly_equal(vecsOut[i][j], expected[j]))
+            {
+                std::cerr << "vec4_normalize_batch mismatch at " << i << '[' << j << "]." << std::endl;
+                ++numErrors;
+                break;
+            }
+        }
+    }
+
+    math::vec4_dot_batch(vecsA.data(), vecsB.data(), dots.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!nearly_equal(dots[i], math::dot(vecsA[i], vecsB[i]), 1.e-4f))
+        {
+            std::cerr << "vec4_dot_batch mismatch at " << i << '.' << std::endl;
+            ++numErrors;
+        }
+    }
+
+    // Every finite half must survive a round trip through floats, and match
+    // the scalar conversions.
+    std::vector<math::half> halves;
+    std::vector<float> floats;
+    std::vector<math::half> roundTrip;
+
+    for (uint32_t i = 0; i < 0x10000u; ++i)
+    {
+        if ((i & 0x7C00u) != 0x7C00u)
+        {
+            math::half h;
+            h.bits = (uint16_t)i;
+            halves.push_back(h);
+        }
+    }
+
+    // odd length to exercise tails
+    halves.pop_back();
+    floats.resize(halves.size());
+    roundTrip.resize(halves.size());
+
+    math::float_from_half_batch(halves.data(), floats.data(), halves.size());
+    math::half_from_float_batch(floats.data(), roundTrip.data(), floats.size());
+
+    for (std::size_t i = 0; i < halves.size(); ++i)
+    {
+        if (floats[i] != (float)halves[i] || roundTrip[i].bits != halves[i].bits)
+        {
+            std::cerr << "Half conversion mismatch for 0x" << std::hex << halves[i].bits << std::dec << '.' << std::endl;
+            ++numErrors;
+            break;
+        }
+    }
+
+    // Rounding, overflow, and underflow
+    const float specials[] = {
+        1.00048828125f, 1.00146484375f, 65504.f, 65520.f, 1.e6f, -1.e6f,
+        5.96046448e-8f, 2.98023224e-8f, 1.e-10f, -0.f, INFINITY, -INFINITY, 0.1f
+    };
+    constexpr std::size_t numSpecials = sizeof(specials) / sizeof(float);
+    math::half specialHalves[numSpecials];
+
+    math::half_from_float_batch(specials, specialHalves, numSpecials);
+    for (std::size_t i = 0; i < numSpecials; ++i)
+    {
+        if (specialHalves[i].bits != math::half{specials[i]}.bits)
+        {
+            std::cerr << "Half conversion mismatch for " << specials[i] << '.' << std::endl;
+            ++numErrors;
+        }
+    }
+
+    std::cout << "Tested " << math::simd_level_name(level) << ": " << numErrors << " errors." << std::endl;
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    const uint32_t features = math::cpu_features();
+
+    std::cout
+        << "CPU features: 0x" << std::hex << features << std::dec
+        << "\nStartup SIMD level: " << math::simd_level_name(math::simd_level())
+        << "\nMaximum SIMD level: " << math::simd_level_name(math::simd_level_max())
+        << std::endl;
+
+    int numErrors = 0;
+
+    for (unsigned i = math::SIMD_LEVEL_GENERIC; i <= math::SIMD_LEVEL_NEON; ++i)
+    {
+        const math::SimdLevel level = (math::SimdLevel)i;
+
+        if (!math::simd_level_supported(level))
+        {
+            if (math::set_simd_level(level))
+            {
+                std::cerr << "Able to select unsupported SIMD level " << math::simd_level_name(level) << '.' << std::endl;
+                ++numErrors;
+            }
+            continue;
+        }
+
+        if (!math::set_simd_level(level) || math::simd_level() != level)
+        {
+            std::cerr << "Unable to select SIMD level " << math::simd_level_name(level) << '.' << std::endl;
+            ++numErrors;
+            continue;
+        }
+
+        numErrors += test_level(level);
+    }
+
+    return numErrors ? -1 : 0;
+}
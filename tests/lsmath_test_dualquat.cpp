@@ -0,0 +1,198 @@
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/dualquat_utils.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of floats
+-------------------------------------*/
+bool nearly_equal(float a, float b, float tolerance = 1.e-4f) noexcept
+{
+    const float scale = std::fabs(a) > 1.f ? std::fabs(a) : 1.f;
+    return std::fabs(a - b) <= tolerance * scale;
+}
+
+template <unsigned N, typename vec_type>
+bool nearly_equal(const vec_type& a, const vec_type& b, float tolerance = 1.e-4f) noexcept
+{
+    for (unsigned i = 0; i < N; ++i)
+    {
+        if (!nearly_equal(a[i], b[i], tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool nearly_equal(const math::mat4& a, const math::mat4& b) noexcept
+{
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (!nearly_equal<4>(a[i], b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Random rigid transformations
+-------------------------------------*/
+template <typename prng_t, typename dist_t>
+math::dualquat random_dualquat(prng_t& prng, dist_t& dist) noexcept
+{
+    const math::quat r = math::normalize<float>(math::quat{dist(prng), dist(prng), dist(prng), dist(prng)});
+    const math::vec3 t{dist(prng), dist(prng), dist(prng)};
+    return math::quat_to_dualquat(r, t);
+}
+
+
+
+/*-------------------------------------
+    Compare the SIMD skinning kernel against the scalar one
+
+    Explicit template arguments select the generic implementation.
+-------------------------------------*/
+template <typename index_t, typename prng_t, typename dist_t>
+int test_skinning(prng_t& prng, dist_t& dist, const std::vector<math::dualquat>& palette) noexcept
+{
+    std::uniform_int_distribution<unsigned> boneDist{0, (unsigned)palette.size()-1};
+    std::uniform_real_distribution<float> weightDist{0.f, 1.f};
+    int numErrors = 0;
+
+    for (std::size_t count = 0; count < 37; ++count)
+    {
+        std::vector<math::vec3> positions(count), normals(count);
+        std::vector<math::vec4_t<index_t>> ids(count);
+        std::vector<math::vec4> weights(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            positions[i] = math::vec3{dist(prng), dist(prng), dist(prng)};
+            normals[i] = math::normalize(math::vec3{dist(prng), dist(prng), dist(prng)});
+
+            // Leave some bones unused to exercise zero weights
+            const unsigned numBones = 1u + (unsigned)(i % 4u);
+            float total = 0.f;
+
+            for (unsigned k = 0; k < 4; ++k)
+            {
+                ids[i][k] = (index_t)boneDist(prng);
+                weights[i][k] = (k < numBones) ? weightDist(prng) + 0.01f : 0.f;
+                total += weights[i][k];
+            }
+
+            weights[i] /= total;
+        }
+
+        std::vector<math::vec3> expectedPos(count), expectedNorm(count);
+        math::dualquat_skin_batch<float, index_t>(palette.data(), positions.data(), normals.data(), ids.data(), weights.data(), expectedPos.data(), expectedNorm.data(), count);
+
+        // Skin in-place to exercise aliasing
+        std::vector<math::vec3> outPos = positions, outNorm = normals;
+        math::dualquat_skin_batch(palette.data(), outPos.data(), outNorm.data(), ids.data(), weights.data(), outPos.data(), outNorm.data(), count);
+
+        std::vector<math::vec3> posOnly(count, math::vec3{0.f});
+        math::dualquat_skin_batch(palette.data(), positions.data(), (const math::vec3*)nullptr, ids.data(), weights.data(), posOnly.data(), (math::vec3*)nullptr, count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!nearly_equal<3>(outPos[i], expectedPos[i]) || !nearly_equal<3>(posOnly[i], expectedPos[i]))
+            {
+                std::cerr << "Skinned position mismatch at " << i << " of " << count << '.' << std::endl;
+                ++numErrors;
+            }
+
+            if (!nearly_equal<3>(outNorm[i], expectedNorm[i]))
+            {
+                std::cerr << "Skinned normal mismatch at " << i << " of " << count << '.' << std::endl;
+                ++numErrors;
+            }
+        }
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    constexpr unsigned numTests = 1000;
+    std::mt19937 prng{2468};
+    std::uniform_real_distribution<float> dist{-10.f, 10.f};
+    int numErrors = 0;
+
+    const auto check = [&](bool result, const char* what, unsigned t) noexcept
+    {
+        if (!result)
+        {
+            std::cerr << what << " mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+    };
+
+    for (unsigned t = 0; t < numTests; ++t)
+    {
+        const math::quat r = math::normalize<float>(math::quat{dist(prng), dist(prng), dist(prng), dist(prng)});
+        const math::vec3 v{dist(prng), dist(prng), dist(prng)};
+        const math::vec3 p{dist(prng), dist(prng), dist(prng)};
+        const math::dualquat a = math::quat_to_dualquat(r, v);
+        const math::dualquat b = random_dualquat(prng, dist);
+
+        math::mat4 expected = math::quat_to_mat4(r);
+        expected[3] = math::vec4{v[0], v[1], v[2], 1.f};
+
+        const math::vec4 xformed = expected * math::vec4{p[0], p[1], p[2], 1.f};
+        check(nearly_equal<3>(math::transform_point(p, a), math::vec3{xformed[0], xformed[1], xformed[2]}), "Point transformation", t);
+        check(nearly_equal<3>(math::transform_normal(p, a), math::rotate(p, r)), "Normal transformation", t);
+        check(nearly_equal<3>(math::get_translation(a), v), "Translation", t);
+        check(math::get_rotation(a) == r, "Rotation", t);
+        check(nearly_equal(math::dualquat_to_mat4(a), expected), "Matrix conversion", t);
+
+        const math::dualquat c = math::mat_to_dualquat(expected);
+        const float s = math::dot(a, c) < 0.f ? -1.f : 1.f;
+        check(nearly_equal<4>(c.real * s, a.real) && nearly_equal<4>(c.dual * s, a.dual), "Matrix round-trip", t);
+
+        check(nearly_equal<3>(math::transform_point(p, a * b), math::transform_point(math::transform_point(p, b), a)), "Composition", t);
+
+        const math::dualquat identity = a * math::conjugate(a);
+        check(nearly_equal<4>(identity.real, math::quat{0.f, 0.f, 0.f, 1.f}) && nearly_equal<4>(identity.dual, math::quat{0.f, 0.f}), "Conjugate", t);
+
+        const math::dualquat n = math::normalize(a * 3.f);
+        check(nearly_equal<4>(n.real, a.real) && nearly_equal<4>(n.dual, a.dual), "Normalization", t);
+
+        // Blending a transform with a negated copy of itself must not change it
+        const math::dualquat blended = math::nlerp(a, a * -1.f, 0.5f);
+        check(nearly_equal<3>(math::transform_point(p, blended), math::transform_point(p, a)), "Antipodal blend", t);
+    }
+
+    std::vector<math::dualquat> palette(24);
+    for (math::dualquat& dq : palette)
+    {
+        dq = random_dualquat(prng, dist);
+    }
+
+    numErrors += test_skinning<uint8_t>(prng, dist, palette);
+    numErrors += test_skinning<uint16_t>(prng, dist, palette);
+
+    std::cout << "Tested " << numTests << " dual quaternions: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
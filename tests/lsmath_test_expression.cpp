@@ -0,0 +1,331 @@
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "lightsky/math/expression.h"
+#include "lightsky/math/fixed.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Expressions are only created when lazy() is used
+-------------------------------------*/
+static_assert(std::is_same<decltype(math::vec4f{} * math::vec4f{} + math::vec4f{}), math::vec4f>::value, "Regular vector operators must not be lazy.");
+static_assert(std::is_same<decltype(math::eval(math::lazy(math::vec4f{}) * math::vec4f{} + 1.f)), math::vec4f>::value, "Lazy vector expressions must produce a vector.");
+static_assert(std::is_same<decltype(math::eval(2.0 * math::lazy(math::mat3d{}) - math::mat3d{})), math::mat3d>::value, "Lazy matrix expressions must produce a matrix.");
+static_assert(std::is_same<decltype(math::eval(-math::lazy(math::matMxN_t<3, 4, float>{}))), math::matMxN_t<3, 4, float>>::value, "Lazy MxN matrix expressions must produce an MxN matrix.");
+
+
+
+/*-------------------------------------
+    Random values
+-------------------------------------*/
+template <typename num_t, typename value_t>
+value_t random_value(std::mt19937& prng) noexcept
+{
+    std::uniform_real_distribution<float> dist{0.5f, 4.f};
+    std::bernoulli_distribution sign{0.5};
+    num_t n[sizeof(value_t) / sizeof(num_t)];
+
+    for (num_t& x : n)
+    {
+        x = (num_t)(sign(prng) ? -dist(prng) : dist(prng));
+    }
+
+    value_t ret;
+    std::memcpy((void*)&ret, n, sizeof(value_t));
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Fused multiply-add of each component
+-------------------------------------*/
+template <typename num_t, typename value_t>
+value_t fused(const value_t& x, const value_t& m, const value_t& a, num_t sign) noexcept
+{
+    num_t nx[sizeof(value_t) / sizeof(num_t)];
+    num_t nm[sizeof(value_t) / sizeof(num_t)];
+    num_t na[sizeof(value_t) / sizeof(num_t)];
+    std::memcpy(nx, &x, sizeof(value_t));
+    std::memcpy(nm, &m, sizeof(value_t));
+    std::memcpy(na, &a, sizeof(value_t));
+
+    for (unsigned i = 0; i < sizeof(value_t) / sizeof(num_t); ++i)
+    {
+        na[i] = math::fmadd(nx[i], nm[i], na[i] * sign);
+    }
+
+    value_t ret;
+    std::memcpy((void*)&ret, na, sizeof(value_t));
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Compare every component of two vectors or matrices
+-------------------------------------*/
+template <typename num_t, typename value_t>
+int compare(const char* name, unsigned test, const value_t& result, const value_t& expected, double tolerance) noexcept
+{
+    num_t r[sizeof(value_t) / sizeof(num_t)];
+    num_t e[sizeof(value_t) / sizeof(num_t)];
+    std::memcpy(r, &result, sizeof(value_t));
+    std::memcpy(e, &expected, sizeof(value_t));
+
+    int numErrors = 0;
+    for (unsigned i = 0; i < sizeof(value_t) / sizeof(num_t); ++i)
+    {
+        const double a = (double)r[i];
+        const double b = (double)e[i];
+
+        if (tolerance ? (std::fabs(a - b) > tolerance * (1.0 + std::fabs(b))) : !(r[i] == e[i]))
+        {
+            std::cerr << "Mismatch in expression " << test << " of a " << name << ", component " << i << ": " << a << " != " << b << std::endl;
+            ++numErrors;
+        }
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Vector expressions match the regular operators
+-------------------------------------*/
+template <typename num_t, typename vec_t>
+int test_vector(std::mt19937& prng, const char* name, double tolerance) noexcept
+{
+    int numErrors = 0;
+
+    for (unsigned iter = 0; iter < 100; ++iter)
+    {
+        const vec_t a = random_value<num_t, vec_t>(prng);
+        const vec_t b = random_value<num_t, vec_t>(prng);
+        const vec_t c = random_value<num_t, vec_t>(prng);
+        const vec_t d = random_value<num_t, vec_t>(prng);
+        const vec_t e = random_value<num_t, vec_t>(prng);
+
+        const vec_t results[] = {
+            math::lazy(a) * b + math::lazy(c) * d - e,
+            math::lazy(a) - b * math::lazy(c),
+            -math::lazy(a) / b + c * (num_t)2,
+            (math::lazy(a) + b) * (math::lazy(c) - d),
+            math::lazy(a) * (num_t)0.5 + math::lazy(b) * (num_t)0.25 + math::lazy(c) * (num_t)0.25,
+            math::eval(math::lazy(a)),
+        };
+
+        const vec_t expected[] = {
+            a * b + c * d - e,
+            a - b * c,
+            -a / b + c * (num_t)2,
+            (a + b) * (c - d),
+            a * (num_t)0.5 + b * (num_t)0.25 + c * (num_t)0.25,
+            a,
+        };
+
+        for (unsigned r = 0; r < sizeof(results) / sizeof(results[0]); ++r)
+        {
+            numErrors += compare<num_t>(name, r, results[r], expected[r], tolerance);
+        }
+
+        // Products are fused with the following addition or subtraction
+        numErrors += compare<num_t>(name, 100, math::eval(math::lazy(a) * b + c), fused(a, b, c, (num_t)1), 0.0);
+        numErrors += compare<num_t>(name, 101, math::eval(math::lazy(a) * b - c), fused(a, b, c, (num_t)-1), 0.0);
+        numErrors += compare<num_t>(name, 102, math::eval(c + math::lazy(a) * b), fused(a, b, c, (num_t)1), 0.0);
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Matrix expressions match the regular operators
+-------------------------------------*/
+template <typename num_t, typename mat_t>
+int test_matrix(std::mt19937& prng, const char* name, double tolerance) noexcept
+{
+    int numErrors = 0;
+
+    for (unsigned iter = 0; iter < 100; ++iter)
+    {
+        const mat_t a = random_value<num_t, mat_t>(prng);
+        const mat_t b = random_value<num_t, mat_t>(prng);
+        const mat_t c = random_value<num_t, mat_t>(prng);
+
+        const mat_t results[] = {
+            math::lazy(a) * (num_t)2 + b - c,
+            -math::lazy(a) + b * (num_t)0.5 - c / (num_t)4,
+            (num_t)0.2 * math::lazy(a) + (num_t)0.3 * math::lazy(b) + (num_t)0.5 * math::lazy(c),
+        };
+
+        const mat_t expected[] = {
+            a * (num_t)2 + b - c,
+            -a + b * (num_t)0.5 - c / (num_t)4,
+            a * (num_t)0.2 + b * (num_t)0.3 + c * (num_t)0.5,
+        };
+
+        for (unsigned r = 0; r < sizeof(results) / sizeof(results[0]); ++r)
+        {
+            numErrors += compare<num_t>(name, r, results[r], expected[r], tolerance);
+        }
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Non-SIMD types are evaluated once per component
+-------------------------------------*/
+int test_components(std::mt19937& prng) noexcept
+{
+    typedef math::vec4_t<math::half> vec4h;
+    typedef math::vec3_t<math::medp_t> vec3x;
+    int numErrors = 0;
+
+    for (unsigned iter = 0; iter < 100; ++iter)
+    {
+        const math::vec4f fa = random_value<float, math::vec4f>(prng);
+        const math::vec4f fb = random_value<float, math::vec4f>(prng);
+        const math::vec4f fc = random_value<float, math::vec4f>(prng);
+        const vec4h a{fa[0], fa[1], fa[2], fa[3]};
+        const vec4h b{fb[0], fb[1], fb[2], fb[3]};
+        const vec4h c{fc[0], fc[1], fc[2], fc[3]};
+
+        // Half-floats are only rounded once, after evaluating in
+        // single-precision
+        const vec4h result = math::lazy(a) * b - math::lazy(b) * c + a;
+        vec4h expected;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            expected[i] = math::half{math::fmsub((float)a[i], (float)b[i], (float)b[i] * (float)c[i]) + (float)a[i]};
+        }
+
+        numErrors += compare<math::half>("half vec4", 0, result, expected, 0.0);
+
+        // Fixed-point numbers produce identical results
+        const vec3x x{math::medp_t{fa[0]}, math::medp_t{fa[1]}, math::medp_t{fa[2]}};
+        const vec3x y{math::medp_t{fb[0]}, math::medp_t{fb[1]}, math::medp_t{fb[2]}};
+        const vec3x z{math::medp_t{fc[0]}, math::medp_t{fc[1]}, math::medp_t{fc[2]}};
+
+        numErrors += compare<math::medp_t>("fixed vec3", 1, vec3x{math::lazy(x) * y + math::lazy(y) * z - x}, vec3x{x * y + y * z - x}, 0.0);
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Batched expressions match single evaluations
+-------------------------------------*/
+template <typename num_t, typename value_t, bool products>
+int test_batch(std::mt19937& prng, const char* name, std::size_t count, double tolerance) noexcept
+{
+    std::vector<value_t> a, b, c, out;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        a.push_back(random_value<num_t, value_t>(prng));
+        b.push_back(random_value<num_t, value_t>(prng));
+        c.push_back(random_value<num_t, value_t>(prng));
+    }
+
+    const value_t s = random_value<num_t, value_t>(prng);
+    out.resize(count + 1, s);
+
+    int numErrors = 0;
+
+    // Matrices can only be multiplied by scalars
+    if constexpr (products)
+    {
+        math::eval_batch(math::lazy_batch(a.data()) * math::lazy_batch(b.data()) - math::lazy_batch(c.data()) * (num_t)3 + s, out.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const value_t expected = math::lazy(a[i]) * b[i] - math::lazy(c[i]) * (num_t)3 + s;
+            numErrors += compare<num_t>(name, (unsigned)count, out[i], expected, tolerance);
+        }
+    }
+    else
+    {
+        math::eval_batch(math::lazy_batch(a.data()) * (num_t)2 - math::lazy_batch(c.data()) * (num_t)3 + s, out.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const value_t expected = math::lazy(a[i]) * (num_t)2 - math::lazy(c[i]) * (num_t)3 + s;
+            numErrors += compare<num_t>(name, (unsigned)count, out[i], expected, tolerance);
+        }
+    }
+
+    // Nothing may be written past the end of the output array
+    numErrors += compare<num_t>(name, (unsigned)count, out[count], s, 0.0);
+
+    // The output may alias an input
+    std::vector<value_t> expected = a;
+    math::eval_batch(-math::lazy_batch(a.data()) + math::lazy_batch(b.data()) / (num_t)4 + math::lazy_batch(c.data()), expected.data(), count);
+    math::eval_batch(-math::lazy_batch(a.data()) + math::lazy_batch(b.data()) / (num_t)4 + math::lazy_batch(c.data()), a.data(), count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        numErrors += compare<num_t>(name, (unsigned)count, a[i], expected[i], 0.0);
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Main
+-------------------------------------*/
+int main()
+{
+    std::mt19937 prng{1234};
+    int numErrors = 0;
+
+    numErrors += test_vector<float, math::vec2f>(prng, "vec2f", 1.e-5);
+    numErrors += test_vector<float, math::vec3f>(prng, "vec3f", 1.e-5);
+    numErrors += test_vector<float, math::vec4f>(prng, "vec4f", 1.e-5);
+    numErrors += test_vector<double, math::vec3d>(prng, "vec3d", 1.e-12);
+    numErrors += test_vector<double, math::vec4d>(prng, "vec4d", 1.e-12);
+    numErrors += test_vector<float, math::vec6f>(prng, "vec6f", 1.e-5);
+    numErrors += test_vector<float, math::vecN_t<13, float>>(prng, "vec13f", 1.e-5);
+    numErrors += test_vector<double, math::vecN_t<5, double>>(prng, "vec5d", 1.e-12);
+
+    numErrors += test_matrix<float, math::mat2f>(prng, "mat2f", 1.e-5);
+    numErrors += test_matrix<float, math::mat3f>(prng, "mat3f", 1.e-5);
+    numErrors += test_matrix<float, math::mat4f>(prng, "mat4f", 1.e-5);
+    numErrors += test_matrix<double, math::mat3d>(prng, "mat3d", 1.e-12);
+    numErrors += test_matrix<double, math::mat4d>(prng, "mat4d", 1.e-12);
+    numErrors += test_matrix<float, math::matMxN_t<3, 4, float>>(prng, "3x4 matrix", 1.e-5);
+    numErrors += test_matrix<float, math::mat6f>(prng, "mat6f", 1.e-5);
+
+    numErrors += test_components(prng);
+
+    for (std::size_t count : {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 1000})
+    {
+        numErrors += test_batch<float, float, true>(prng, "float array", count, 1.e-6);
+    }
+
+    numErrors += test_batch<double, double, true>(prng, "double array", 37, 0.0);
+    numErrors += test_batch<float, math::vec4f, true>(prng, "vec4f array", 37, 0.0);
+    numErrors += test_batch<float, math::mat4f, false>(prng, "mat4f array", 13, 0.0);
+    numErrors += test_batch<double, math::vec3d, true>(prng, "vec3d array", 13, 0.0);
+
+    std::cout << "Tested lazy expressions: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
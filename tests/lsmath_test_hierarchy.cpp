@@ -0,0 +1,302 @@
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/hierarchy.h"
+#include "lightsky/math/quat_utils.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of matrices
+-------------------------------------*/
+template <typename num_t>
+bool nearly_equal(const math::mat4_t<num_t>& a, const math::mat4d& b, double tolerance) noexcept
+{
+    for (unsigned c = 0; c < 4; ++c)
+    {
+        for (unsigned r = 0; r < 4; ++r)
+        {
+            const double scale = std::fabs(b[c][r]) > 1.0 ? std::fabs(b[c][r]) : 1.0;
+            if (std::fabs((double)a[c][r] - b[c][r]) > tolerance * scale)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Double-precision reference, using recursion over the unsorted nodes
+-------------------------------------*/
+math::mat4d reference_local(const math::vec3d& p, const math::quatd& q, const math::vec3d& s) noexcept
+{
+    math::mat4d m = math::quat_to_mat4(q);
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        m[c] = m[c] * s[c];
+    }
+    m[3] = math::vec4d{p[0], p[1], p[2], 1.0};
+    return m;
+}
+
+const math::mat4d& reference_world(
+    const std::vector<uint32_t>& parents,
+    const std::vector<math::mat4d>& locals,
+    std::vector<math::mat4d>& world,
+    std::vector<bool>& visited,
+    uint32_t i) noexcept
+{
+    if (!visited[i])
+    {
+        world[i] = (parents[i] == math::HIERARCHY_ROOT) ? locals[i] : (reference_world(parents, locals, world, visited, parents[i]) * locals[i]);
+        visited[i] = true;
+    }
+    return world[i];
+}
+
+
+
+/*-------------------------------------
+    Invalid hierarchies
+-------------------------------------*/
+int test_validation() noexcept
+{
+    int numErrors = 0;
+    math::TransformHierarchy hierarchy;
+    uint32_t order[4];
+    uint32_t sorted[4];
+
+    const uint32_t childFirst[] = {1, math::HIERARCHY_ROOT};
+    const uint32_t unsortedDepths[] = {math::HIERARCHY_ROOT, 0, math::HIERARCHY_ROOT};
+    const uint32_t cycle[] = {math::HIERARCHY_ROOT, 2, 3, 1};
+    const uint32_t outOfRange[] = {math::HIERARCHY_ROOT, 0, 7};
+    const uint32_t valid[] = {math::HIERARCHY_ROOT, math::HIERARCHY_ROOT, 0, 1};
+    const uint32_t parentAfterChild[] = {math::HIERARCHY_ROOT, 0, 0, 5};
+
+    if (hierarchy.init(childFirst, 2) || hierarchy.init(unsortedDepths, 3) || hierarchy.size())
+    {
+        std::cerr << "Failed to reject an unsorted hierarchy." << std::endl;
+        ++numErrors;
+    }
+
+    if (math::sort_hierarchy(cycle, 4, order, sorted) || math::sort_hierarchy(outOfRange, 3, order, sorted))
+    {
+        std::cerr << "Failed to reject an invalid hierarchy." << std::endl;
+        ++numErrors;
+    }
+
+    std::size_t first, last;
+    if (!hierarchy.init(valid, 4) || hierarchy.size() != 4 || hierarchy.num_levels() != 2)
+    {
+        std::cerr << "Failed to initialize a valid hierarchy." << std::endl;
+        ++numErrors;
+    }
+    else
+    {
+        hierarchy.level_range(1, first, last);
+        if (first != 2 || last != 4)
+        {
+            std::cerr << "Incorrect hierarchy levels." << std::endl;
+            ++numErrors;
+        }
+    }
+
+    if (hierarchy.init(parentAfterChild, 4) || hierarchy.size() || hierarchy.num_levels())
+    {
+        std::cerr << "Failed to clear a rejected hierarchy." << std::endl;
+        ++numErrors;
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Sort, update, and partially update a random forest
+-------------------------------------*/
+template <typename num_t>
+int test_hierarchy(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr uint32_t numNodes = 20000;
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    std::uniform_int_distribution<uint32_t> nearDist{1, 64};
+
+    // Parents are either close by, creating deep chains, or anywhere before
+    // each node. Nodes are then shuffled so parents may follow children.
+    std::vector<uint32_t> parents(numNodes);
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        const double r = dist(prng);
+        if (!i || r < -0.9)
+        {
+            parents[i] = math::HIERARCHY_ROOT;
+        }
+        else if (r < 0.0)
+        {
+            parents[i] = i - std::min(i, nearDist(prng));
+        }
+        else
+        {
+            parents[i] = std::uniform_int_distribution<uint32_t>{0, i-1}(prng);
+        }
+    }
+
+    std::vector<uint32_t> shuffle(numNodes), unshuffle(numNodes);
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        shuffle[i] = i;
+    }
+    std::shuffle(shuffle.begin(), shuffle.end(), prng);
+
+    std::vector<uint32_t> unsortedParents(numNodes);
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        unshuffle[shuffle[i]] = i;
+    }
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        const uint32_t p = parents[shuffle[i]];
+        unsortedParents[i] = (p == math::HIERARCHY_ROOT) ? p : unshuffle[p];
+    }
+
+    int numErrors = 0;
+    std::vector<uint32_t> order(numNodes), sortedParents(numNodes);
+    math::TransformHierarchy hierarchy;
+
+    if (!math::sort_hierarchy(unsortedParents.data(), numNodes, order.data(), sortedParents.data())
+    || !hierarchy.init(sortedParents.data(), numNodes))
+    {
+        std::cerr << "Failed to sort a hierarchy." << std::endl;
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        const uint32_t p = sortedParents[i];
+        if ((p == math::HIERARCHY_ROOT) != (unsortedParents[order[i]] == math::HIERARCHY_ROOT)
+        || (p != math::HIERARCHY_ROOT && order[p] != unsortedParents[order[i]]))
+        {
+            std::cerr << "Sorted parent mismatch for node " << i << '.' << std::endl;
+            ++numErrors;
+        }
+    }
+
+    // Local transforms, in sorted order, rounded to the tested precision
+    std::vector<math::vec3_t<num_t>> positions(numNodes), scales(numNodes);
+    std::vector<math::quat_t<num_t>> rotations(numNodes);
+    std::vector<math::mat4_t<num_t>> locals(numNodes);
+    std::vector<math::mat4d> referenceLocals(numNodes);
+
+    const auto randomize = [&](uint32_t i)
+    {
+        positions[i] = (math::vec3_t<num_t>)math::vec3d{dist(prng), dist(prng), dist(prng)};
+        rotations[i] = (math::quat_t<num_t>)math::normalize(math::quatd{dist(prng), dist(prng), dist(prng), dist(prng)});
+        scales[i] = (math::vec3_t<num_t>)(math::vec3d{dist(prng), dist(prng), dist(prng)} * 0.1 + 1.0);
+
+        referenceLocals[order[i]] = reference_local((math::vec3d)positions[i], (math::quatd)rotations[i], (math::vec3d)scales[i]);
+        locals[i] = (math::mat4_t<num_t>)referenceLocals[order[i]];
+    };
+
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        randomize(i);
+    }
+
+    const auto check_world = [&](const std::vector<math::mat4_t<num_t>>& world, const char* name)
+    {
+        std::vector<math::mat4d> expected(numNodes);
+        std::vector<bool> visited(numNodes, false);
+
+        for (uint32_t i = 0; i < numNodes; ++i)
+        {
+            if (!nearly_equal(world[i], reference_world(unsortedParents, referenceLocals, expected, visited, order[i]), tolerance))
+            {
+                std::cerr << name << " mismatch for node " << i << '.' << std::endl;
+                ++numErrors;
+                return;
+            }
+        }
+    };
+
+    // full updates on one & many threads produce identical results
+    std::vector<math::mat4_t<num_t>> world(numNodes), threadedWorld(numNodes), matrixWorld(numNodes);
+    math::update_world_transforms(hierarchy, positions.data(), rotations.data(), scales.data(), nullptr, world.data(), 1);
+    math::update_world_transforms(hierarchy, positions.data(), rotations.data(), scales.data(), nullptr, threadedWorld.data(), 4);
+    math::update_world_transforms(hierarchy, locals.data(), nullptr, matrixWorld.data(), 4);
+
+    check_world(world, "TRS hierarchy");
+    check_world(matrixWorld, "Matrix hierarchy");
+
+    if (std::memcmp(world.data(), threadedWorld.data(), sizeof(world[0]) * numNodes) != 0)
+    {
+        std::cerr << "Multithreaded hierarchy update mismatch." << std::endl;
+        ++numErrors;
+    }
+
+    // partial updates only touch modified nodes & their descendants
+    std::vector<uint8_t> dirty(numNodes, 0), expectedDirty(numNodes, 0);
+    std::uniform_int_distribution<uint32_t> nodeDist{0, numNodes-1};
+    for (unsigned k = 0; k < 20; ++k)
+    {
+        const uint32_t i = nodeDist(prng);
+        randomize(i);
+        dirty[i] = expectedDirty[i] = 1;
+    }
+
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        const uint32_t p = sortedParents[i];
+        expectedDirty[i] |= (p != math::HIERARCHY_ROOT) ? expectedDirty[p] : 0;
+    }
+
+    math::update_world_transforms(hierarchy, positions.data(), rotations.data(), scales.data(), dirty.data(), threadedWorld.data(), 4);
+    math::update_world_transforms(hierarchy, positions.data(), rotations.data(), scales.data(), nullptr, world.data(), 1);
+
+    if (dirty != expectedDirty)
+    {
+        std::cerr << "Dirty flags were not propagated to descendants." << std::endl;
+        ++numErrors;
+    }
+
+    if (std::memcmp(world.data(), threadedWorld.data(), sizeof(world[0]) * numNodes) != 0)
+    {
+        std::cerr << "Partial hierarchy update mismatch." << std::endl;
+        ++numErrors;
+    }
+
+    check_world(world, "Updated hierarchy");
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    std::mt19937 prng{4321};
+    int numErrors = 0;
+
+    numErrors += test_validation();
+    numErrors += test_hierarchy<float>(prng, 1.e-3);
+    numErrors += test_hierarchy<double>(prng, 1.e-9);
+
+    std::cout << "Tested transform hierarchies: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
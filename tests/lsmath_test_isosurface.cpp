@@ -0,0 +1,177 @@
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <utility>
+
+#include "lightsky/math/isosurface.h"
+#include "lightsky/math/noise.h"
+
+
+
+namespace chrono = std::chrono;
+typedef chrono::steady_clock::time_point hr_time;
+typedef chrono::nanoseconds hr_prec;
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Ensure every edge of a closed mesh is shared by exactly two triangles
+    with opposite winding.
+-------------------------------------*/
+bool is_closed_manifold(const math::IsoMesh<float>& mesh) noexcept
+{
+    std::map<std::pair<uint32_t, uint32_t>, int> edges;
+
+    for (std::size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        for (unsigned e = 0; e < 3; ++e)
+        {
+            const uint32_t a = mesh.indices[i + e];
+            const uint32_t b = mesh.indices[i + (e + 1) % 3];
+            ++edges[std::make_pair(a, b)];
+        }
+    }
+
+    for (const auto& edge : edges)
+    {
+        const auto opposite = edges.find(std::make_pair(edge.first.second, edge.first.first));
+        if (edge.second != 1 || opposite == edges.end() || opposite->second != 1)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Mesh a sphere and validate its topology and normals
+-------------------------------------*/
+int test_sphere() noexcept
+{
+    const auto sphere = [](const math::vec3f& p)->float
+    {
+        return math::length(p) - 10.f;
+    };
+
+    const math::vec3f origin{-16.f};
+    const math::vec3f cellSize{0.5f};
+    const math::vec3u numCells{64u};
+
+    math::IsoMesh<float> reference;
+    math::extract_isosurface(reference, sphere, origin, cellSize, numCells, 0.f, 64u, 1u);
+
+    if (reference.indices.empty() || !is_closed_manifold(reference))
+    {
+        std::cerr << "Sphere mesh is not a closed manifold." << std::endl;
+        return -1;
+    }
+
+    for (std::size_t i = 0; i < reference.positions.size(); ++i)
+    {
+        const math::vec3f& p = reference.positions[i];
+        const float radialError = math::abs(math::length(p) - 10.f);
+        const float normalError = 1.f - math::dot(reference.normals[i], math::normalize(p));
+
+        if (radialError > 0.1f || normalError > 0.01f)
+        {
+            std::cerr << "Invalid sphere vertex: " << p[0] << ", " << p[1] << ", " << p[2] << std::endl;
+            return -1;
+        }
+    }
+
+    // Chunking and threading must not change the output
+    const unsigned chunkSizes[] = {7u, 16u, 32u};
+    for (unsigned chunkSize : chunkSizes)
+    {
+        math::IsoMesh<float> chunked;
+        math::extract_isosurface(chunked, sphere, origin, cellSize, numCells, 0.f, chunkSize, 4u);
+
+        if (chunked.positions.size() != reference.positions.size()
+        || chunked.indices.size() != reference.indices.size()
+        || !is_closed_manifold(chunked))
+        {
+            std::cerr << "Chunk size " << chunkSize << " produced a different mesh." << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << "Sphere: " << reference.positions.size() << " vertices, " << reference.indices.size() / 3 << " triangles." << std::endl;
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Measure the throughput of noise-based terrain
+-------------------------------------*/
+int bench_terrain(unsigned numThreads) noexcept
+{
+    const math::PerlinNoisef noise{0xC0FFEE};
+    constexpr unsigned chunkSize = 32;
+    const math::vec3u numCells{256u, 128u, 256u};
+    const math::vec3f cellSize{1.f};
+
+    // density = height above ground plus noise
+    const auto density = [&](float* outValues, const math::vec3f& origin, const math::vec3f& stride, const math::vec3u& dims)->void
+    {
+        noise.get_noise_grid(outValues, origin * 0.03125f, stride * 0.03125f, dims);
+
+        for (unsigned z = 0, i = 0; z < dims[2]; ++z)
+        {
+            for (unsigned y = 0; y < dims[1]; ++y)
+            {
+                const float height = (origin[1] + stride[1] * (float)y - 64.f) * (1.f / 32.f);
+
+                for (unsigned x = 0; x < dims[0]; ++x, ++i)
+                {
+                    outValues[i] += height;
+                }
+            }
+        }
+    };
+
+    math::IsoMesh<float> mesh;
+
+    const hr_time t1 = chrono::steady_clock::now();
+    math::extract_isosurface(mesh, density, math::vec3f{0.f}, cellSize, numCells, 0.f, chunkSize, numThreads);
+    const hr_time t2 = chrono::steady_clock::now();
+
+    const double seconds = (double)chrono::duration_cast<hr_prec>(t2 - t1).count() * 1.0e-9;
+    const double numChunks = (double)((numCells[0] / chunkSize) * (numCells[1] / chunkSize) * (numCells[2] / chunkSize));
+    const unsigned cores = math::parallel_thread_count(numThreads);
+
+    std::cout
+        << "Terrain (" << cores << " threads):"
+        << "\n\tVertices:         " << mesh.positions.size()
+        << "\n\tTriangles:        " << mesh.indices.size() / 3
+        << "\n\tTime (ms):        " << seconds * 1.0e3
+        << "\n\tChunks/sec:       " << numChunks / seconds
+        << "\n\tChunks/sec/core:  " << numChunks / seconds / (double)cores
+        << std::endl;
+
+    return mesh.indices.empty() ? -1 : 0;
+}
+
+
+
+int main()
+{
+    if (test_sphere() != 0)
+    {
+        return -1;
+    }
+
+    if (bench_terrain(1u) != 0 || bench_terrain(0u) != 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,187 @@
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/batch_utils.h"
+#include "lightsky/math/mat2.h"
+#include "lightsky/math/mat3.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of floats
+-------------------------------------*/
+bool nearly_equal(float a, float b, float tolerance = 1.e-5f) noexcept
+{
+    const float scale = std::fabs(a) > 1.f ? std::fabs(a) : 1.f;
+    return std::fabs(a - b) <= tolerance * scale;
+}
+
+template <unsigned N, typename vec_type>
+bool nearly_equal(const vec_type& a, const vec_type& b) noexcept
+{
+    for (unsigned i = 0; i < N; ++i)
+    {
+        if (!nearly_equal(a[i], b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Scalar references, in column-major order
+-------------------------------------*/
+template <unsigned N, typename mat_type>
+mat_type reference_mul(const mat_type& a, const mat_type& b) noexcept
+{
+    mat_type ret{0.f};
+
+    for (unsigned i = 0; i < N; ++i)
+    {
+        for (unsigned j = 0; j < N; ++j)
+        {
+            for (unsigned k = 0; k < N; ++k)
+            {
+                ret[i][j] += a[k][j] * b[i][k];
+            }
+        }
+    }
+
+    return ret;
+}
+
+template <unsigned N, typename mat_type, typename vec_type>
+vec_type reference_xform(const mat_type& m, const vec_type& v) noexcept
+{
+    vec_type ret{0.f};
+
+    for (unsigned i = 0; i < N; ++i)
+    {
+        for (unsigned j = 0; j < N; ++j)
+        {
+            ret[j] += m[i][j] * v[i];
+        }
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    constexpr unsigned numTests = 1000;
+    std::mt19937 prng{5678};
+    std::uniform_real_distribution<float> dist{-10.f, 10.f};
+    int numErrors = 0;
+
+    for (unsigned t = 0; t < numTests; ++t)
+    {
+        math::mat2 a2, b2;
+        math::mat3 a3, b3;
+        math::vec2 v2;
+        math::vec3 v3;
+
+        for (unsigned i = 0; i < 9; ++i)
+        {
+            a3[i/3][i%3] = dist(prng);
+            b3[i/3][i%3] = dist(prng);
+        }
+
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            a2[i/2][i%2] = dist(prng);
+            b2[i/2][i%2] = dist(prng);
+        }
+
+        v2 = math::vec2{dist(prng), dist(prng)};
+        v3 = math::vec3{dist(prng), dist(prng), dist(prng)};
+
+        const math::mat2 p2 = a2 * b2;
+        const math::mat2 r2 = reference_mul<2>(a2, b2);
+        if (!nearly_equal<2>(p2[0], r2[0]) || !nearly_equal<2>(p2[1], r2[1]))
+        {
+            std::cerr << "2x2 matrix multiplication mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal<2>(a2 * v2, reference_xform<2>(a2, v2)))
+        {
+            std::cerr << "2x2 matrix-vector multiplication mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        const math::mat3 p3 = a3 * b3;
+        const math::mat3 r3 = reference_mul<3>(a3, b3);
+        if (!nearly_equal<3>(p3[0], r3[0]) || !nearly_equal<3>(p3[1], r3[1]) || !nearly_equal<3>(p3[2], r3[2]))
+        {
+            std::cerr << "3x3 matrix multiplication mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal<3>(a3 * v3, reference_xform<3>(a3, v3)))
+        {
+            std::cerr << "3x3 matrix-vector multiplication mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+    }
+
+    // Batches of every length up to a few SIMD widths, transformed in-place
+    // to exercise aliasing and tails.
+    for (std::size_t count = 0; count < 37; ++count)
+    {
+        std::vector<math::mat3> mats(count), products(count);
+        std::vector<math::vec3> vecs(count), xforms(count);
+        math::mat3 m;
+
+        for (unsigned i = 0; i < 9; ++i)
+        {
+            m[i/3][i%3] = dist(prng);
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (unsigned j = 0; j < 9; ++j)
+            {
+                mats[i][j/3][j%3] = dist(prng);
+            }
+            vecs[i] = math::vec3{dist(prng), dist(prng), dist(prng)};
+        }
+
+        xforms = vecs;
+        math::mat3_transform_batch(m, xforms.data(), xforms.data(), count);
+        math::mat3_mul_batch(mats.data(), mats.data(), products.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!nearly_equal<3>(xforms[i], reference_xform<3>(m, vecs[i])))
+            {
+                std::cerr << "mat3_transform_batch mismatch at " << i << " of " << count << '.' << std::endl;
+                ++numErrors;
+            }
+
+            const math::mat3 r = reference_mul<3>(mats[i], mats[i]);
+            if (!nearly_equal<3>(products[i][0], r[0]) || !nearly_equal<3>(products[i][1], r[1]) || !nearly_equal<3>(products[i][2], r[2]))
+            {
+                std::cerr << "mat3_mul_batch mismatch at " << i << " of " << count << '.' << std::endl;
+                ++numErrors;
+            }
+        }
+    }
+
+    std::cout << "Tested 2x2 and 3x3 matrices: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
@@ -0,0 +1,151 @@
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "lightsky/math/mat4.h"
+#include "lightsky/math/mat_utils.h"
+#include "lightsky/math/vec_utils.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of doubles
+-------------------------------------*/
+bool nearly_equal(double a, double b, double tolerance = 1.e-10) noexcept
+{
+    const double scale = std::fabs(a) > 1.0 ? std::fabs(a) : 1.0;
+    return std::fabs(a - b) <= tolerance * scale;
+}
+
+bool nearly_equal(const math::vec4d& a, const math::vec4d& b, double tolerance = 1.e-10) noexcept
+{
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (!nearly_equal(a[i], b[i], tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool nearly_equal(const math::mat4d& a, const math::mat4d& b, double tolerance = 1.e-10) noexcept
+{
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (!nearly_equal(a[i], b[i], tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/*-------------------------------------
+    main
+
+    Explicit template arguments select the generic implementations, which
+    the platform-specific overloads are compared against.
+-------------------------------------*/
+int main()
+{
+    constexpr unsigned numTests = 1000;
+    std::mt19937 prng{4321};
+    std::uniform_real_distribution<double> dist{-10.0, 10.0};
+    const math::mat4d identity{1.0};
+    int numErrors = 0;
+
+    for (unsigned t = 0; t < numTests; ++t)
+    {
+        math::mat4d a, b;
+        math::vec4d u, v;
+
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            a[i/4][i%4] = dist(prng);
+            b[i/4][i%4] = dist(prng);
+        }
+
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            u[i] = dist(prng);
+            v[i] = dist(prng);
+        }
+
+        math::mat4d expectedProduct{0.0};
+        math::vec4d expectedXform{0.0};
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            for (unsigned j = 0; j < 4; ++j)
+            {
+                expectedXform[j] += a[i][j] * u[i];
+
+                for (unsigned k = 0; k < 4; ++k)
+                {
+                    expectedProduct[i][j] += a[k][j] * b[i][k];
+                }
+            }
+        }
+
+        if (!nearly_equal(a * b, expectedProduct))
+        {
+            std::cerr << "Matrix-matrix multiplication mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal(a * u, expectedXform))
+        {
+            std::cerr << "Matrix-vector multiplication mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal(math::transpose(a), math::transpose<double>(a), 0.0))
+        {
+            std::cerr << "Transpose mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal(math::determinant(a), math::determinant<double>(a), 1.e-9))
+        {
+            std::cerr << "Determinant mismatch in test " << t << ": " << math::determinant(a) << " vs " << math::determinant<double>(a) << std::endl;
+            ++numErrors;
+        }
+
+        const math::mat4d inv = math::inverse(a);
+        if (!nearly_equal(inv, math::inverse<double>(a), 1.e-8) || !nearly_equal(a * inv, identity, 1.e-8))
+        {
+            std::cerr << "Inverse mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal(math::dot(u, v), math::dot<double>(u, v))
+        || !nearly_equal(math::length(u), math::length<double>(u))
+        || !nearly_equal(math::length_squared(u), math::length_squared<double>(u)))
+        {
+            std::cerr << "Dot product mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal(math::normalize(u), math::normalize<double>(u)))
+        {
+            std::cerr << "Normalization mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+
+        if (!nearly_equal(math::cross(u, v), math::cross<double>(u, v)))
+        {
+            std::cerr << "Cross product mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+    }
+
+    std::cout << "Tested " << numTests << " double-precision matrices: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
@@ -0,0 +1,304 @@
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <type_traits>
+
+#include "lightsky/math/mat_utils.h"
+#include "lightsky/math/vec_utils.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Aliases resolve to the existing vector & matrix types
+-------------------------------------*/
+static_assert(std::is_same<math::vec_t<2, float>, math::vec2_t<float>>::value, "vec_t<2> must be a vec2_t.");
+static_assert(std::is_same<math::vec_t<3, float>, math::vec3_t<float>>::value, "vec_t<3> must be a vec3_t.");
+static_assert(std::is_same<math::vec_t<4, float>, math::vec4_t<float>>::value, "vec_t<4> must be a vec4_t.");
+static_assert(std::is_same<math::vec_t<6, float>, math::vecN_t<6, float>>::value, "vec_t<6> must be a vecN_t.");
+static_assert(std::is_same<math::mat_t<3, 3, double>, math::mat3_t<double>>::value, "mat_t<3, 3> must be a mat3_t.");
+static_assert(std::is_same<math::mat_t<4, 4, double>, math::mat4_t<double>>::value, "mat_t<4, 4> must be a mat4_t.");
+static_assert(std::is_same<math::mat_t<3, 4, double>, math::matMxN_t<3, 4, double>>::value, "mat_t<3, 4> must be a matMxN_t.");
+static_assert(std::is_same<math::matMxN_t<3, 4, float>::col_type, math::vec3_t<float>>::value, "Columns with 3 rows must be a vec3_t.");
+static_assert(std::is_same<decltype(math::matMxN_t<3, 4, float>{} * math::matMxN_t<4, 3, float>{}), math::mat3_t<float>>::value, "(3x4) * (4x3) must be a mat3_t.");
+static_assert(std::is_same<decltype(math::transpose(math::matMxN_t<3, 4, float>{})), math::matMxN_t<4, 3, float>>::value, "Transposing a 3x4 matrix must be 4x3.");
+
+
+
+/*-------------------------------------
+    Everything can be evaluated at compile-time
+-------------------------------------*/
+constexpr math::vecN_t<5, double> ct_a{1.0, 2.0, 3.0, 4.0, 5.0};
+constexpr math::vecN_t<5, double> ct_b{5.0, 4.0, 3.0, 2.0, 1.0};
+
+static_assert(ct_a + ct_b == math::vecN_t<5, double>{6.0}, "Compile-time addition failed.");
+static_assert((ct_a * 2.0 - ct_b)[4] == 9.0, "Compile-time vector-scalar operations failed.");
+static_assert(math::dot(ct_a, ct_b) == 35.0, "Compile-time dot product failed.");
+static_assert(math::sum(ct_a) == 15.0, "Compile-time sum failed.");
+static_assert(math::max(ct_a, ct_b) == math::vecN_t<5, double>{5.0, 4.0, 3.0, 4.0, 5.0}, "Compile-time max failed.");
+static_assert(math::fmadd(ct_a, ct_b, ct_a)[1] == 10.0, "Compile-time fmadd failed.");
+
+constexpr math::matMxN_t<5, 5, double> ct_m{
+    math::vecN_t<5, double>{2.0, 1.0, 0.0, 0.0, 0.0},
+    math::vecN_t<5, double>{0.0, 4.0, 0.0, 1.0, 0.0},
+    math::vecN_t<5, double>{0.0, 0.0, 1.0, 0.0, 0.0},
+    math::vecN_t<5, double>{0.0, 0.0, 0.0, 0.0, 8.0},
+    math::vecN_t<5, double>{0.0, 0.0, 0.0, 2.0, 0.0}
+};
+
+static_assert(math::determinant(ct_m) == 2.0 * 4.0 * 1.0 * -16.0, "Compile-time determinant failed.");
+static_assert(ct_m * math::inverse(ct_m) == math::matMxN_t<5, 5, double>{1.0}, "Compile-time inverse failed.");
+static_assert(math::transpose(math::transpose(ct_m)) == ct_m, "Compile-time transpose failed.");
+static_assert((ct_m * ct_a)[4] == 32.0, "Compile-time matrix-vector product failed.");
+
+
+
+/*-------------------------------------
+    Compare single-precision SIMD vectors against double-precision
+-------------------------------------*/
+template <unsigned N>
+int test_vector(std::mt19937& prng) noexcept
+{
+    std::uniform_real_distribution<double> dist{-10.0, 10.0};
+    math::vecN_t<N, float> a, b, c;
+    math::vecN_t<N, double> da, db, dc;
+
+    for (unsigned i = 0; i < N; ++i)
+    {
+        da[i] = (double)(a[i] = (float)dist(prng));
+        db[i] = (double)(b[i] = (float)dist(prng));
+        dc[i] = (double)(c[i] = (float)dist(prng));
+        db[i] = (double)(b[i] = (b[i] == 0.f) ? 1.f : b[i]);
+    }
+
+    const math::vecN_t<N, float> results[] = {
+        a + b,
+        a - b,
+        a * b,
+        a / b,
+        -a,
+        a * 3.f,
+        a / 3.f,
+        2.f - a,
+        math::min(a, b),
+        math::max(a, b),
+        math::fmadd(a, b, c),
+        math::fmsub(a, b, c),
+        math::mix(a, b, 0.25f),
+    };
+
+    const math::vecN_t<N, double> expected[] = {
+        da + db,
+        da - db,
+        da * db,
+        da / db,
+        -da,
+        da * 3.0,
+        da / 3.0,
+        2.0 - da,
+        math::min(da, db),
+        math::max(da, db),
+        math::fmadd(da, db, dc),
+        math::fmsub(da, db, dc),
+        math::mix(da, db, 0.25),
+    };
+
+    int numErrors = 0;
+    for (unsigned r = 0; r < sizeof(results) / sizeof(results[0]); ++r)
+    {
+        for (unsigned i = 0; i < N; ++i)
+        {
+            if (std::fabs((double)results[r][i] - expected[r][i]) > 1.e-5 * (1.0 + std::fabs(expected[r][i])))
+            {
+                std::cerr << "Vector mismatch in operation " << r << " of a " << N << "D vector, component " << i << ": " << results[r][i] << " != " << expected[r][i] << std::endl;
+                ++numErrors;
+            }
+        }
+    }
+
+    if (std::fabs((double)math::dot(a, b) - math::dot(da, db)) > 1.e-4 * N * 100.0)
+    {
+        std::cerr << "Dot product mismatch in a " << N << "D vector." << std::endl;
+        ++numErrors;
+    }
+
+    if (std::fabs((double)math::length(math::normalize(a)) - 1.0) > 1.e-5)
+    {
+        std::cerr << "Normalization mismatch in a " << N << "D vector." << std::endl;
+        ++numErrors;
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Random matrix
+-------------------------------------*/
+template <unsigned R, unsigned C, typename num_t>
+math::mat_t<R, C, num_t> random_matrix(std::mt19937& prng) noexcept
+{
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    math::mat_t<R, C, num_t> ret{num_t{0}};
+
+    for (unsigned c = 0; c < C; ++c)
+    {
+        for (unsigned r = 0; r < R; ++r)
+        {
+            ret[c][r] = (num_t)dist(prng);
+        }
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Compare matrix elements against a reference product
+-------------------------------------*/
+template <unsigned R, unsigned C, unsigned K, typename lhs_t, typename rhs_t, typename result_t>
+bool check_product(const lhs_t& a, const rhs_t& b, const result_t& ab, double tolerance) noexcept
+{
+    for (unsigned k = 0; k < K; ++k)
+    {
+        for (unsigned r = 0; r < R; ++r)
+        {
+            double expected = 0.0;
+            for (unsigned c = 0; c < C; ++c)
+            {
+                expected += (double)a[c][r] * (double)b[k][c];
+            }
+
+            if (std::fabs((double)ab[k][r] - expected) > tolerance)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Matrix products, transposition, & inversion
+-------------------------------------*/
+template <typename num_t>
+int test_matrix(std::mt19937& prng, double tolerance) noexcept
+{
+    int numErrors = 0;
+    const char* const typeName = (sizeof(num_t) == sizeof(float)) ? "float" : "double";
+    const auto check = [&](bool result, const char* name)->void
+    {
+        if (!result)
+        {
+            std::cerr << name << " mismatch in " << typeName << " test." << std::endl;
+            ++numErrors;
+        }
+    };
+
+    const math::matMxN_t<3, 4, num_t>&& a34 = random_matrix<3, 4, num_t>(prng);
+    const math::matMxN_t<4, 3, num_t>&& a43 = random_matrix<4, 3, num_t>(prng);
+    const math::mat3_t<num_t>&& a33 = random_matrix<3, 3, num_t>(prng);
+    const math::mat4_t<num_t>&& a44 = random_matrix<4, 4, num_t>(prng);
+    const math::matMxN_t<6, 6, num_t>&& a66 = random_matrix<6, 6, num_t>(prng);
+    const math::matMxN_t<6, 5, num_t>&& a65 = random_matrix<6, 5, num_t>(prng);
+
+    check(check_product<3, 4, 3>(a34, a43, a34 * a43, tolerance), "(3x4) * (4x3)");
+    check(check_product<4, 3, 4>(a43, a34, a43 * a34, tolerance), "(4x3) * (3x4)");
+    check(check_product<4, 3, 3>(a43, a33, a43 * a33, tolerance), "(4x3) * (3x3)");
+    check(check_product<3, 3, 4>(a33, a34, a33 * a34, tolerance), "(3x3) * (3x4)");
+    check(check_product<4, 4, 3>(a44, a43, a44 * a43, tolerance), "(4x4) * (4x3)");
+    check(check_product<6, 6, 5>(a66, a65, a66 * a65, tolerance), "(6x6) * (6x5)");
+    check(check_product<6, 6, 6>(a66, a66, a66 * a66, tolerance), "(6x6) * (6x6)");
+
+    const math::vecN_t<6, num_t>&& v6 = a66 * a65[2];
+    const math::matMxN_t<6, 1, num_t> col{a65[2]};
+    check(check_product<6, 6, 1>(a66, col, math::matMxN_t<6, 1, num_t>{v6}, tolerance), "(6x6) * 6D");
+
+    const math::vec3_t<num_t>&& v3 = a34 * a44[1];
+    check(check_product<3, 4, 1>(a34, math::matMxN_t<4, 1, num_t>{a44[1]}, math::matMxN_t<3, 1, num_t>{v3}, tolerance), "(3x4) * 4D");
+
+    const math::matMxN_t<4, 3, num_t>&& t34 = math::transpose(a34);
+    for (unsigned c = 0; c < 4; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            check(t34[r][c] == a34[c][r], "Transpose");
+        }
+    }
+
+    // (A*B)^T = B^T * A^T
+    const math::matMxN_t<6, 5, num_t>&& ab = a66 * a65;
+    check(check_product<5, 6, 6>(math::transpose(a65), math::transpose(a66), math::transpose(ab), tolerance), "Transposed product");
+
+    // Diagonally-dominant matrices are well-conditioned
+    const math::matMxN_t<6, 6, num_t>&& m = a66 + math::matMxN_t<6, 6, num_t>{num_t{4}};
+    const math::matMxN_t<6, 6, num_t>&& identity = m * math::inverse(m);
+    const math::matMxN_t<6, 6, num_t>&& leftIdentity = math::inverse(m) * m;
+
+    for (unsigned c = 0; c < 6; ++c)
+    {
+        for (unsigned r = 0; r < 6; ++r)
+        {
+            const double expected = (r == c) ? 1.0 : 0.0;
+            check(std::fabs((double)identity[c][r] - expected) < tolerance, "Right inverse");
+            check(std::fabs((double)leftIdentity[c][r] - expected) < tolerance, "Left inverse");
+        }
+    }
+
+    // The determinant of a matrix product is the product of its determinants
+    const num_t detA = math::determinant(m);
+    const num_t detB = math::determinant(a66);
+    const num_t detAB = math::determinant(m * a66);
+    check(std::fabs((double)detAB - (double)detA * (double)detB) < tolerance * std::fabs((double)detAB) * 10.0, "Determinant");
+
+    // Pivoting is required when the leading element is zero
+    math::matMxN_t<5, 5, num_t> p{num_t{0}};
+    for (unsigned i = 0; i < 5; ++i)
+    {
+        p[i][(i + 1) % 5] = num_t{2};
+    }
+
+    check(math::inverse(p) * p == math::matMxN_t<5, 5, num_t>{num_t{1}}, "Permutation inverse");
+    check(math::determinant(p) == num_t{32}, "Permutation determinant");
+
+    math::matMxN_t<5, 5, num_t> singular = random_matrix<5, 5, num_t>(prng);
+    singular[3] = singular[1];
+    check(std::fabs((double)math::determinant(singular)) < tolerance, "Singular determinant");
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    std::mt19937 prng{1234};
+    int numErrors = 0;
+
+    numErrors += test_vector<1>(prng);
+    numErrors += test_vector<5>(prng);
+    numErrors += test_vector<6>(prng);
+    numErrors += test_vector<7>(prng);
+    numErrors += test_vector<8>(prng);
+    numErrors += test_vector<12>(prng);
+    numErrors += test_vector<13>(prng);
+    numErrors += test_vector<16>(prng);
+    numErrors += test_vector<31>(prng);
+    numErrors += test_matrix<float>(prng, 1.e-5);
+    numErrors += test_matrix<double>(prng, 1.e-12);
+
+    std::cout << "Tested N-dimensional vectors & MxN matrices: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
@@ -0,0 +1,293 @@
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "lightsky/math/noise.h"
+
+
+
+namespace chrono = std::chrono;
+typedef chrono::steady_clock::time_point hr_time;
+typedef chrono::nanoseconds hr_prec;
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Print throughput, in millions of samples per second
+-------------------------------------*/
+void print_throughput(const char* name, std::size_t numSamples, uint64_t nanos, float checksum) noexcept
+{
+    const double seconds = (double)nanos * 1.0e-9;
+    const double msps = ((double)numSamples / seconds) * 1.0e-6;
+
+    std::cout
+        << name
+        << "\n\tTime (ms):      " << (double)nanos * 1.0e-6
+        << "\n\tSamples/sec(M): " << msps
+        << "\n\tChecksum:       " << checksum
+        << std::endl;
+}
+
+
+
+/*-------------------------------------
+    Benchmark a noise type through its single-point, batch, and grid paths
+-------------------------------------*/
+template <typename noise_type>
+int bench_noise(const char* name, const noise_type& noise, const math::vec3_t<unsigned>& dims) noexcept
+{
+    const std::size_t numSamples = (std::size_t)dims[0] * dims[1] * dims[2];
+    const math::vec3f origin{-17.25f, 3.5f, 101.125f};
+    const math::vec3f stride{0.0625f, 0.0625f, 0.0625f};
+
+    std::unique_ptr<math::vec3f[]> points{new math::vec3f[numSamples]};
+    std::unique_ptr<float[]> single{new float[numSamples]};
+    std::unique_ptr<float[]> batch{new float[numSamples]};
+    std::unique_ptr<float[]> grid{new float[numSamples]};
+
+    for (unsigned z = 0, i = 0; z < dims[2]; ++z)
+    {
+        for (unsigned y = 0; y < dims[1]; ++y)
+        {
+            for (unsigned x = 0; x < dims[0]; ++x, ++i)
+            {
+                points[i] = origin + stride * math::vec3f{(float)x, (float)y, (float)z};
+            }
+        }
+    }
+
+    hr_time t1, t2;
+    float checksum;
+
+    std::cout << "----------------------------------------\n" << name << std::endl;
+
+    t1 = chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        single[i] = noise.get_noise(points[i]);
+    }
+    t2 = chrono::steady_clock::now();
+
+    checksum = 0.f;
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        checksum += single[i];
+    }
+    print_throughput("Single Point:", numSamples, chrono::duration_cast<hr_prec>(t2 - t1).count(), checksum);
+
+    t1 = chrono::steady_clock::now();
+    noise.get_noise(points.get(), batch.get(), numSamples);
+    t2 = chrono::steady_clock::now();
+
+    checksum = 0.f;
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        checksum += batch[i];
+    }
+    print_throughput("Batch:", numSamples, chrono::duration_cast<hr_prec>(t2 - t1).count(), checksum);
+
+    t1 = chrono::steady_clock::now();
+    noise.get_noise_grid(grid.get(), origin, stride, dims);
+    t2 = chrono::steady_clock::now();
+
+    checksum = 0.f;
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        checksum += grid[i];
+    }
+    print_throughput("Grid:", numSamples, chrono::duration_cast<hr_prec>(t2 - t1).count(), checksum);
+
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        if (single[i] != batch[i] || math::abs(single[i] - grid[i]) > 1.0e-4f)
+        {
+            std::cerr << "Noise mismatch at sample " << i << ": " << single[i] << ' ' << batch[i] << ' ' << grid[i] << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Ensure F1 <= F2 for all metrics
+-------------------------------------*/
+int validate_worley(math::WorleyNoisef& noise) noexcept
+{
+    for (unsigned metric = math::WorleyNoisef::WORLEY_DIST_EUCLIDEAN; metric <= math::WorleyNoisef::WORLEY_DIST_CHEBYSHEV; ++metric)
+    {
+        noise.distance_metric((math::WorleyNoisef::DistanceMetric)metric);
+
+        for (int i = -1000; i < 1000; ++i)
+        {
+            const math::vec3f p{(float)i * 0.173f, (float)i * -0.0371f, (float)i * 0.5113f};
+            const math::vec2f f = noise.get_features(p);
+
+            if (f[0] < 0.f || f[0] > f[1])
+            {
+                std::cerr << "Invalid Worley features at " << p[0] << ", " << p[1] << ", " << p[2] << ": " << f[0] << ' ' << f[1] << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    noise.distance_metric(math::WorleyNoisef::WORLEY_DIST_EUCLIDEAN);
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Ensure periodic noise wraps around its period
+-------------------------------------*/
+template <typename noise_type>
+int validate_periodic(const char* name, const noise_type& noise, const math::vec3i& period) noexcept
+{
+    const math::vec3f offset{(float)period[0], (float)period[1], (float)period[2]};
+
+    for (int i = -1000; i < 1000; ++i)
+    {
+        const math::vec3f p{(float)i * 0.173f, (float)i * -0.0371f, (float)i * 0.5113f};
+        const float a = noise.get_noise(p, period);
+        const float b = noise.get_noise(p + offset, period);
+        const float c = noise.get_noise(p - math::vec3f{offset[0], 0.f, offset[2]}, period);
+
+        if (math::abs(a - b) > 1.0e-3f || math::abs(a - c) > 1.0e-3f)
+        {
+            std::cerr << name << " is not periodic at " << p[0] << ", " << p[1] << ", " << p[2] << ": " << a << ' ' << b << ' ' << c << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Compare the cost of periodic and non-periodic grids
+-------------------------------------*/
+template <typename noise_type>
+void bench_periodic(const char* name, const noise_type& noise, const math::vec3_t<unsigned>& dims, const math::vec3i& period) noexcept
+{
+    const std::size_t numSamples = (std::size_t)dims[0] * dims[1] * dims[2];
+    const math::vec3f origin{0.f};
+    const math::vec3f stride{(float)period[0] / (float)dims[0], (float)period[1] / (float)dims[1], 1.f};
+    std::unique_ptr<float[]> grid{new float[numSamples]};
+    hr_time t1, t2;
+    float checksum;
+
+    std::cout << "----------------------------------------\n" << name << " (Tiled " << period[0] << 'x' << period[1] << 'x' << period[2] << ')' << std::endl;
+
+    t1 = chrono::steady_clock::now();
+    noise.get_noise_grid(grid.get(), origin, stride, dims);
+    t2 = chrono::steady_clock::now();
+
+    checksum = 0.f;
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        checksum += grid[i];
+    }
+    print_throughput("Regular Grid:", numSamples, chrono::duration_cast<hr_prec>(t2 - t1).count(), checksum);
+
+    t1 = chrono::steady_clock::now();
+    noise.get_noise_grid(grid.get(), origin, stride, dims, period);
+    t2 = chrono::steady_clock::now();
+
+    checksum = 0.f;
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        checksum += grid[i];
+    }
+    print_throughput("Periodic Grid:", numSamples, chrono::duration_cast<hr_prec>(t2 - t1).count(), checksum);
+}
+
+
+
+int main()
+{
+    constexpr unsigned long seed = 0xDEADBEEF;
+    const math::vec3_t<unsigned> dims{256u, 256u, 16u};
+
+    math::PerlinNoisef perlin{seed};
+    math::ValueNoisef value{seed};
+    math::WorleyNoisef worley{seed};
+
+    if (validate_worley(worley) != 0)
+    {
+        return -1;
+    }
+
+    const math::vec3i period{5, 17, 300};
+    if (validate_periodic("Perlin Noise", perlin, period) != 0
+    || validate_periodic("Value Noise", value, period) != 0
+    || validate_periodic("Worley Noise", worley, period) != 0)
+    {
+        return -1;
+    }
+
+    // A period of 256 must reproduce the regular noise lattice
+    for (int i = -1000; i < 1000; ++i)
+    {
+        const math::vec3f p{(float)i * 0.173f, (float)i * -0.0371f, (float)i * 0.5113f};
+        if (perlin.get_noise(p) != perlin.get_noise(p, math::vec3i{256}) || value.get_noise(p) != value.get_noise(p, math::vec3i{256}))
+        {
+            std::cerr << "Periodic noise does not match the regular lattice at " << p[0] << ", " << p[1] << ", " << p[2] << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << "Perlin Noise (reference):" << std::endl;
+    {
+        const std::size_t numSamples = (std::size_t)dims[0] * dims[1] * dims[2];
+        float checksum = 0.f;
+
+        hr_time t1 = chrono::steady_clock::now();
+        for (unsigned z = 0; z < dims[2]; ++z)
+        {
+            for (unsigned y = 0; y < dims[1]; ++y)
+            {
+                for (unsigned x = 0; x < dims[0]; ++x)
+                {
+                    checksum += perlin.get_noise(math::vec3f{(float)x, (float)y, (float)z} * 0.0625f);
+                }
+            }
+        }
+        hr_time t2 = chrono::steady_clock::now();
+
+        print_throughput("Single Point:", numSamples, chrono::duration_cast<hr_prec>(t2 - t1).count(), checksum);
+    }
+
+    if (bench_noise("Value Noise", value, dims) != 0)
+    {
+        return -1;
+    }
+
+    if (bench_noise("Worley Noise (Euclidean)", worley, dims) != 0)
+    {
+        return -1;
+    }
+
+    worley.distance_metric(math::WorleyNoisef::WORLEY_DIST_MANHATTAN);
+    if (bench_noise("Worley Noise (Manhattan)", worley, dims) != 0)
+    {
+        return -1;
+    }
+
+    worley.distance_metric(math::WorleyNoisef::WORLEY_DIST_CHEBYSHEV);
+    if (bench_noise("Worley Noise (Chebyshev)", worley, dims) != 0)
+    {
+        return -1;
+    }
+
+    bench_periodic("Perlin Noise", perlin, dims, math::vec3i{16, 16, 16});
+    bench_periodic("Value Noise", value, dims, math::vec3i{16, 16, 16});
+    bench_periodic("Worley Noise", worley, dims, math::vec3i{16, 16, 16});
+
+    return 0;
+}
@@ -0,0 +1,325 @@
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/mat_utils.h"
+#include "lightsky/math/obb.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Random rotation
+-------------------------------------*/
+template <typename num_t>
+math::mat3_t<num_t> random_rotation(std::mt19937& prng) noexcept
+{
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    math::mat3_t<num_t> m, u, v;
+    math::vec3_t<num_t> s;
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        m[c] = math::vec3_t<num_t>{(num_t)dist(prng), (num_t)dist(prng), (num_t)dist(prng)};
+    }
+
+    math::svd(m, u, s, v);
+    return u;
+}
+
+
+
+/*-------------------------------------
+    Points distributed through a rotated, translated box. The corners of the
+    box are always included.
+-------------------------------------*/
+template <typename num_t>
+std::vector<math::vec3_t<num_t>> make_box_points(
+    std::mt19937& prng,
+    std::size_t count,
+    const math::vec3_t<num_t>& center,
+    const math::mat3_t<num_t>& axes,
+    const math::vec3_t<num_t>& extents) noexcept
+{
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    std::vector<math::vec3_t<num_t>> ret(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        math::vec3_t<num_t> local;
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            const double t = (i < 8) ? ((i >> c) & 1 ? 1.0 : -1.0) : dist(prng);
+            local[c] = (num_t)(t * (double)extents[c]);
+        }
+        ret[i] = center + axes * local;
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Check that every point is within a box
+-------------------------------------*/
+template <typename num_t>
+bool contains(const math::OrientedBox<num_t>& box, const math::vec3_t<num_t>* points, std::size_t count, double tolerance) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            double d = 0.0;
+            for (unsigned r = 0; r < 3; ++r)
+            {
+                d += (double)box.axes[c][r] * ((double)points[i][r] - (double)box.center[r]);
+            }
+
+            if (std::fabs(d) > (double)box.extents[c] + tolerance)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Compare the covariance of points against a two-pass reference
+-------------------------------------*/
+template <typename num_t>
+int test_covariance(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr std::size_t count = 100003;
+    const math::vec3_t<num_t> center{(num_t)1000, (num_t)-2000, (num_t)500};
+    const math::vec3_t<num_t> extents{(num_t)4, (num_t)2, (num_t)1};
+    const std::vector<math::vec3_t<num_t>> points = make_box_points(prng, count, center, random_rotation<num_t>(prng), extents);
+
+    double mean[3] = {0.0, 0.0, 0.0};
+    double cov[3][3] = {{0.0}};
+
+    for (const math::vec3_t<num_t>& p : points)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            mean[r] += (double)p[r] / (double)count;
+        }
+    }
+
+    for (const math::vec3_t<num_t>& p : points)
+    {
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            for (unsigned r = 0; r < 3; ++r)
+            {
+                cov[c][r] += ((double)p[c] - mean[c]) * ((double)p[r] - mean[r]) / (double)count;
+            }
+        }
+    }
+
+    int numErrors = 0;
+    const char* const typeName = (sizeof(num_t) == sizeof(float)) ? "float" : "double";
+
+    math::vec3_t<num_t> outMean, singleMean;
+    math::mat3_t<num_t> outCov, singleCov;
+    math::covariance(points.data(), count, outMean, outCov, 4);
+    math::covariance(points.data(), count, singleMean, singleCov, 1);
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        if (std::fabs((double)outMean[c] - mean[c]) > tolerance * 2000.0)
+        {
+            std::cerr << "Mean mismatch in " << typeName << " component " << c << ": " << outMean[c] << " != " << mean[c] << std::endl;
+            ++numErrors;
+        }
+
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            // The largest variance is 16/3
+            if (std::fabs((double)outCov[c][r] - cov[c][r]) > tolerance * 16.0)
+            {
+                std::cerr << "Covariance mismatch in " << typeName << " element (" << c << ", " << r << "): " << outCov[c][r] << " != " << cov[c][r] << std::endl;
+                ++numErrors;
+            }
+        }
+    }
+
+    // Results don't depend on the number of threads
+    if (!(singleMean == outMean) || !(singleCov == outCov))
+    {
+        std::cerr << "Threaded covariance mismatch in " << typeName << '.' << std::endl;
+        ++numErrors;
+    }
+
+    math::covariance(points.data(), 0, outMean, outCov);
+    if (!(outMean == math::vec3_t<num_t>{(num_t)0}) || !(outCov == math::mat3_t<num_t>{(num_t)0}))
+    {
+        std::cerr << "Empty covariance mismatch in " << typeName << '.' << std::endl;
+        ++numErrors;
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Fit a box to points sampled from a known box
+-------------------------------------*/
+template <typename num_t>
+int test_fit_obb(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr std::size_t count = 100003;
+    const math::vec3_t<num_t> center{(num_t)-30, (num_t)75, (num_t)12};
+    const math::vec3_t<num_t> extents{(num_t)4, (num_t)2, (num_t)1};
+    const math::mat3_t<num_t>&& axes = random_rotation<num_t>(prng);
+    const std::vector<math::vec3_t<num_t>> points = make_box_points(prng, count, center, axes, extents);
+
+    int numErrors = 0;
+    const char* const typeName = (sizeof(num_t) == sizeof(float)) ? "float" : "double";
+    const auto check = [&](bool result, const char* name)->void
+    {
+        if (!result)
+        {
+            std::cerr << name << " mismatch in " << typeName << " test." << std::endl;
+            ++numErrors;
+        }
+    };
+
+    const math::OrientedBox<num_t>&& box = math::fit_obb(points.data(), count);
+
+    // Sampling noise tilts the axes slightly, so the fitted box is only
+    // approximately the same as the original.
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        check(std::fabs(std::fabs((double)math::dot(box.axes[c], axes[c])) - 1.0) < 1.e-4, "Box axis");
+        check(std::fabs((double)box.extents[c] - (double)extents[c]) < 1.e-2, "Box extent");
+        check(std::fabs((double)box.center[c] - (double)center[c]) < 1.e-2, "Box center");
+    }
+
+    check(std::fabs((double)math::determinant(box.axes) - 1.0) < tolerance, "Box rotation");
+    check(contains(box, points.data(), count, tolerance * 100.0), "Box containment");
+
+    // The box touches the extreme points along each axis
+    const math::OrientedBox<num_t> inner{box.center, box.axes, box.extents - math::vec3_t<num_t>{(num_t)1.e-3}};
+    check(!contains(inner, points.data(), count, 0.0), "Tight box");
+
+    const math::OrientedBox<num_t>&& single = math::fit_obb(points.data(), count, 1);
+    check(single.center == box.center && single.axes == box.axes && single.extents == box.extents, "Threaded box");
+
+    const math::OrientedBox<num_t>&& empty = math::fit_obb(points.data(), 0);
+    check(empty.center == math::vec3_t<num_t>{(num_t)0}
+        && empty.axes == math::mat3_t<num_t>{(num_t)1}
+        && empty.extents == math::vec3_t<num_t>{(num_t)0}, "Empty box");
+
+    const math::OrientedBox<num_t>&& point = math::fit_obb(points.data(), 1);
+    check(point.center == points[0] && point.extents == math::vec3_t<num_t>{(num_t)0}, "Single-point box");
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Fit boxes to many parts at once
+-------------------------------------*/
+template <typename num_t>
+int test_fit_obb_batch(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr std::size_t numParts = 301;
+    std::uniform_real_distribution<double> dist{-100.0, 100.0};
+    std::vector<math::vec3_t<num_t>> points;
+    std::vector<std::size_t> offsets{0};
+
+    for (std::size_t i = 0; i < numParts; ++i)
+    {
+        // Include empty, single-point, & multi-chunk parts
+        const std::size_t count = (i == 7) ? 10000 : (i % 23);
+        const math::vec3_t<num_t> center{(num_t)dist(prng), (num_t)dist(prng), (num_t)dist(prng)};
+        const math::vec3_t<num_t> extents{(num_t)8, (num_t)3, (num_t)1};
+        const std::vector<math::vec3_t<num_t>>&& part = make_box_points(prng, count, center, random_rotation<num_t>(prng), extents);
+
+        points.insert(points.end(), part.begin(), part.end());
+        offsets.push_back(points.size());
+    }
+
+    std::vector<math::OrientedBox<num_t>> boxes(numParts);
+    math::fit_obb_batch(points.data(), offsets.data(), numParts, boxes.data());
+
+    int numErrors = 0;
+    for (std::size_t i = 0; i < numParts; ++i)
+    {
+        const math::vec3_t<num_t>* const part = points.data() + offsets[i];
+        const std::size_t count = offsets[i+1] - offsets[i];
+        const math::OrientedBox<num_t>& box = boxes[i];
+        const math::OrientedBox<num_t>&& single = math::fit_obb(part, count);
+
+        bool result = contains(box, part, count, tolerance * 100.0)
+            && std::fabs((double)math::determinant(box.axes) - 1.0) < tolerance;
+
+        // Batches solve their axes at the precision of the input. Boxes
+        // only match when each axis is well-defined.
+        math::vec3_t<num_t> mean;
+        math::mat3_t<num_t> cov, axes;
+        math::vec3_t<num_t> variances;
+        math::covariance(part, count, mean, cov, 1);
+        math::eigen_symmetric(cov, variances, axes);
+
+        if (variances[0] - variances[1] > (num_t)0.1 * variances[0] && variances[1] - variances[2] > (num_t)0.1 * variances[0])
+        {
+            for (unsigned c = 0; c < 3; ++c)
+            {
+                result = result
+                    && std::fabs((double)box.extents[c] - (double)single.extents[c]) < 1.e-3
+                    && std::fabs((double)box.center[c] - (double)single.center[c]) < 1.e-3;
+            }
+        }
+
+        if (!count)
+        {
+            result = result
+                && box.center == math::vec3_t<num_t>{(num_t)0}
+                && box.axes == math::mat3_t<num_t>{(num_t)1}
+                && box.extents == math::vec3_t<num_t>{(num_t)0};
+        }
+
+        if (!result)
+        {
+            std::cerr << "Batched box mismatch in " << (sizeof(num_t) == sizeof(float) ? "float" : "double") << " part " << i << '.' << std::endl;
+            ++numErrors;
+        }
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    std::mt19937 prng{4321};
+    int numErrors = 0;
+
+    numErrors += test_covariance<float>(prng, 1.e-5);
+    numErrors += test_covariance<double>(prng, 1.e-12);
+    numErrors += test_fit_obb<float>(prng, 1.e-5);
+    numErrors += test_fit_obb<double>(prng, 1.e-12);
+    numErrors += test_fit_obb_batch<float>(prng, 1.e-5);
+    numErrors += test_fit_obb_batch<double>(prng, 1.e-12);
+
+    std::cout << "Tested point covariance & oriented bounding boxes: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
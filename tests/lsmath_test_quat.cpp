@@ -0,0 +1,290 @@
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/batch_utils.h"
+#include "lightsky/math/quat_utils.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of floats
+-------------------------------------*/
+bool nearly_equal(float a, double b, float tolerance = 1.e-5f) noexcept
+{
+    const double scale = std::fabs(b) > 1.0 ? std::fabs(b) : 1.0;
+    return std::fabs((double)a - b) <= tolerance * scale;
+}
+
+template <unsigned N, typename a_type, typename b_type>
+bool nearly_equal(const a_type& a, const b_type& b, float tolerance = 1.e-5f) noexcept
+{
+    for (unsigned i = 0; i < N; ++i)
+    {
+        if (!nearly_equal(a[i], b[i], tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <unsigned N, typename a_type, typename b_type>
+bool nearly_equal_mat(const a_type& a, const b_type& b) noexcept
+{
+    for (unsigned i = 0; i < N; ++i)
+    {
+        if (!nearly_equal<N>(a[i], b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// q and -q represent the same rotation
+bool same_rotation(const math::quat& a, const math::quatd& b) noexcept
+{
+    return nearly_equal<4>(a, b) || nearly_equal<4>(a * -1.f, b);
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    constexpr unsigned numTests = 1000;
+    std::mt19937 prng{4321};
+    std::uniform_real_distribution<float> dist{-1.f, 1.f};
+    int numErrors = 0;
+
+    static_assert(alignof(math::quat) == 4*sizeof(float), "Single-precision quaternions must be 16-byte aligned.");
+
+    const auto check = [&](bool result, const char* what, unsigned t) noexcept
+    {
+        if (!result)
+        {
+            std::cerr << what << " mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+    };
+
+    for (unsigned t = 0; t < numTests; ++t)
+    {
+        math::quat a{dist(prng), dist(prng), dist(prng), dist(prng)};
+        math::quat b{dist(prng), dist(prng), dist(prng), dist(prng)};
+
+        // Exercise each branch of the matrix-to-quaternion conversion,
+        // including rotations of 180 degrees about each axis.
+        if (t < 4)
+        {
+            a = math::quat{0.f, 0.f};
+            a[t] = 1.f;
+        }
+        else if (t % 8 < 4)
+        {
+            a[t % 8] *= 8.f;
+        }
+
+        const math::vec3 v{dist(prng) * 10.f, dist(prng) * 10.f, dist(prng) * 10.f};
+        const math::vec4 v4{v[0], v[1], v[2], dist(prng)};
+        const math::quatd da = (math::quatd)a;
+        const math::quatd db = (math::quatd)b;
+        const math::vec3d dv = (math::vec3d)v;
+        const math::vec4d dv4 = (math::vec4d)v4;
+
+        check(nearly_equal<4>(a * b, da * db), "Hamilton product", t);
+        check(nearly_equal<4>(math::quat{a} *= b, da * db), "Compound product", t);
+        check(math::conjugate(a) == (math::quat)math::conjugate(da) && -a == math::conjugate(a), "Conjugate", t);
+        check(nearly_equal<4>(math::inverse(a), math::inverse(da)), "Inverse", t);
+        check(nearly_equal(math::dot(a, b), math::dot(da, db)), "Dot product", t);
+        check(nearly_equal(math::length(a), math::length(da)), "Length", t);
+        check(a == a && !(a != a) && a != b, "Comparison", t);
+
+        const math::quat na = math::normalize(a);
+        const math::quatd dna = math::normalize(da);
+        check(nearly_equal<4>(na, dna, 1.e-6f), "Normalize", t);
+
+        check(nearly_equal<3>(math::rotate(v, na), math::rotate(dv, dna), 1.e-4f), "3D rotation", t);
+        check(nearly_equal<4>(math::rotate(v4, na), math::rotate(dv4, dna), 1.e-4f), "4D rotation", t);
+        check(nearly_equal<3>(math::reorient(na, v), math::reorient(dna, dv), 1.e-4f), "Reorientation", t);
+        check(nearly_equal<3>(math::reorient(v, na), math::reorient(dv, dna), 1.e-4f), "Inverse reorientation", t);
+
+        const math::mat3 m3 = math::quat_to_mat3(na);
+        const math::mat4 m4 = math::quat_to_mat4(na);
+        check(nearly_equal_mat<3>(m3, math::quat_to_mat3(dna)), "3x3 matrix conversion", t);
+        check(nearly_equal_mat<4>(m4, math::quat_to_mat4(dna)), "4x4 matrix conversion", t);
+        check(same_rotation(math::mat_to_quat(m3), dna), "3x3 matrix round-trip", t);
+        check(same_rotation(math::mat_to_quat(m4), dna), "4x4 matrix round-trip", t);
+
+        // Explicit template arguments select the generic implementation
+        check(nearly_equal<4>(math::mat_to_quat(m4), (math::quatd)math::mat_to_quat<float>(m4)), "Generic matrix conversion", t);
+    }
+
+    // Batched interpolation, using array lengths which leave a partial SIMD
+    // register at the end. Every other pair points in opposite hemispheres
+    // to exercise the shortest-path correction.
+    for (unsigned count : {1u, 7u, 37u, 1000u})
+    {
+        std::vector<math::quat> a(count), b(count), slerped(count), fast(count), nlerped(count);
+        std::vector<float> t(count);
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            a[i] = math::normalize(math::quat{dist(prng), dist(prng), dist(prng), dist(prng)});
+            b[i] = math::normalize(math::quat{dist(prng), dist(prng), dist(prng), dist(prng)});
+            t[i] = dist(prng) * 0.5f + 0.5f;
+
+            // nearly-parallel & identical rotations
+            if (i % 5 == 1)
+            {
+                b[i] = math::normalize(a[i] + math::quat{1.e-4f, 0.f, 0.f, 0.f});
+            }
+            else if (i % 5 == 3)
+            {
+                b[i] = a[i] * -1.f;
+            }
+        }
+
+        // "out" may alias either input
+        slerped = a;
+        math::slerp_batch(slerped.data(), b.data(), t.data(), slerped.data(), count);
+        math::fast_slerp_batch(a.data(), b.data(), t.data(), fast.data(), count);
+        math::nlerp_batch(a.data(), b.data(), t.data(), nlerped.data(), count);
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            const math::quatd da = (math::quatd)a[i];
+            const math::quatd db = (math::quatd)b[i];
+            const math::quatd expected = math::slerp(da, db, (double)t[i]);
+            const math::quatd nl = math::normalize(math::lerp(da, math::dot(da, db) < 0.0 ? db * -1.0 : db, (double)t[i]));
+            const float fastTolerance = (std::fabs(math::dot(da, db)) >= 0.5) ? 2.e-6f : 3.e-5f;
+
+            check(nearly_equal<4>(slerped[i], expected, 1.e-6f), "Batched slerp", i);
+            check(nearly_equal<4>(fast[i], expected, fastTolerance), "Batched fast slerp", i);
+            check(nearly_equal<4>(nlerped[i], nl, 1.e-6f), "Batched nlerp", i);
+
+            // Explicit template arguments select the generic implementation
+            math::quat generic[1];
+            math::fast_slerp_batch<float>(a.data()+i, b.data()+i, t.data()+i, generic, 1);
+            check(nearly_equal<4>(generic[0], expected, fastTolerance), "Generic fast slerp", i);
+            math::nlerp_batch<float>(a.data()+i, b.data()+i, t.data()+i, generic, 1);
+            check(nearly_equal<4>(generic[0], nl, 1.e-6f), "Generic nlerp", i);
+        }
+    }
+
+    // Transform composition & decomposition, including reflections,
+    // 180-degree rotations, and a partial register at the end of each batch
+    {
+        constexpr unsigned count = numTests + 3;
+        std::vector<math::vec3> positions(count), scales(count), outPositions(count), outScales(count);
+        std::vector<math::quat> rotations(count), outRotations(count);
+        std::vector<math::mat4> matrices(count);
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            positions[i] = math::vec3{dist(prng), dist(prng), dist(prng)} * 10.f;
+            rotations[i] = math::normalize(math::quat{dist(prng), dist(prng), dist(prng), dist(prng)});
+            scales[i] = math::vec3{dist(prng), dist(prng), dist(prng)} * 2.f;
+
+            if (i < 4)
+            {
+                rotations[i] = math::quat{0.f, 0.f};
+                rotations[i][i] = 1.f;
+            }
+
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                scales[i][k] += (scales[i][k] < 0.f) ? -0.25f : 0.25f;
+            }
+        }
+
+        math::compose_trs_batch(positions.data(), rotations.data(), scales.data(), matrices.data(), count);
+        math::decompose_batch(matrices.data(), outPositions.data(), outRotations.data(), outScales.data(), count);
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            const math::mat4d expected = math::compose_trs((math::vec3d)positions[i], (math::quatd)rotations[i], (math::vec3d)scales[i]);
+            check(nearly_equal_mat<4>(matrices[i], expected), "TRS composition", i);
+            check(nearly_equal_mat<4>(math::compose_trs(outPositions[i], outRotations[i], outScales[i]), expected), "TRS round-trip", i);
+
+            const bool reflected = ((scales[i][0] < 0.f) != (scales[i][1] < 0.f)) != (scales[i][2] < 0.f);
+            check(outRotations[i][3] >= 0.f && nearly_equal(math::length(outRotations[i]), 1.0), "Decomposed rotation", i);
+            check(nearly_equal(outScales[i][0], std::fabs(scales[i][0]) * (reflected ? -1.0 : 1.0))
+                && nearly_equal(outScales[i][1], std::fabs(scales[i][1]))
+                && nearly_equal(outScales[i][2], std::fabs(scales[i][2])), "Decomposed scale", i);
+
+            if (scales[i][0] > 0.f && scales[i][1] > 0.f && scales[i][2] > 0.f)
+            {
+                check(same_rotation(outRotations[i], (math::quatd)rotations[i]), "Decomposed rotation", i);
+            }
+
+            // Explicit template arguments select the generic implementation.
+            // Rotations of 180 degrees may land on either side of w == 0.
+            math::vec3 t[1], s[1];
+            math::quat r[1];
+            math::decompose_batch<float>(matrices.data()+i, t, r, s, 1);
+            check(nearly_equal<3>(t[0], (math::vec3d)outPositions[i])
+                && same_rotation(r[0], (math::quatd)outRotations[i])
+                && nearly_equal<3>(s[0], (math::vec3d)outScales[i]), "Generic decomposition", i);
+        }
+
+    }
+
+    // A single axis without any scale still round-trips, and the batched
+    // decomposition matches the scalar one
+    {
+        constexpr unsigned count = 3*4 + 1;
+        std::vector<math::vec3> positions(count), scales(count), outPositions(count), outScales(count);
+        std::vector<math::quat> rotations(count), outRotations(count);
+        std::vector<math::mat4> matrices(count);
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            positions[i] = math::vec3{dist(prng), dist(prng), dist(prng)} * 10.f;
+            rotations[i] = math::normalize(math::quat{dist(prng), dist(prng), dist(prng), dist(prng)});
+            scales[i] = math::vec3{dist(prng), dist(prng), dist(prng)} * 2.f;
+
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                scales[i][k] += (scales[i][k] < 0.f) ? -0.25f : 0.25f;
+            }
+
+            scales[i][i % 3] = 0.f;
+            matrices[i] = math::compose_trs(positions[i], rotations[i], scales[i]);
+        }
+
+        math::decompose_batch(matrices.data(), outPositions.data(), outRotations.data(), outScales.data(), count);
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            const math::mat4d expected = math::compose_trs((math::vec3d)positions[i], (math::quatd)rotations[i], (math::vec3d)scales[i]);
+            check(nearly_equal_mat<4>(math::compose_trs(outPositions[i], outRotations[i], outScales[i]), expected), "Zero-scale round-trip", i);
+            check(outScales[i][i % 3] == 0.f && outRotations[i][3] >= 0.f && nearly_equal(math::length(outRotations[i]), 1.0), "Zero-scale decomposition", i);
+
+            math::vec3 t, s;
+            math::quat r;
+            math::decompose(matrices[i], t, r, s);
+            check(nearly_equal<3>(t, (math::vec3d)outPositions[i])
+                && same_rotation(r, (math::quatd)outRotations[i])
+                && nearly_equal<3>(s, (math::vec3d)outScales[i]), "Zero-scale batched decomposition", i);
+        }
+
+        // Two axes without any scale don't produce NaNs
+        matrices[0][1] = math::vec4{0.f};
+        matrices[0][2] = math::vec4{0.f};
+        math::decompose_batch(matrices.data(), outPositions.data(), outRotations.data(), outScales.data(), 4);
+        check(math::length(outRotations[0]) == math::length(outRotations[0]), "Degenerate decomposition", 0);
+    }
+
+    std::cout << "Tested " << numTests << " quaternions: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
@@ -0,0 +1,186 @@
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/skinning.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of floats
+-------------------------------------*/
+bool nearly_equal(float a, float b, float tolerance = 1.e-4f) noexcept
+{
+    const float scale = std::fabs(a) > 1.f ? std::fabs(a) : 1.f;
+    return std::fabs(a - b) <= tolerance * scale;
+}
+
+bool nearly_equal(const math::vec3& a, const math::vec3& b) noexcept
+{
+    return nearly_equal(a[0], b[0]) && nearly_equal(a[1], b[1]) && nearly_equal(a[2], b[2]);
+}
+
+
+
+/*-------------------------------------
+    Conversions from each weight format
+-------------------------------------*/
+double to_double(float w) noexcept { return w; }
+double to_double(math::half w) noexcept { return (float)w; }
+double to_double(uint8_t w) noexcept { return w / 255.0; }
+double to_double(uint16_t w) noexcept { return w / 65535.0; }
+
+template <typename weight_t>
+weight_t from_float(float w) noexcept { return (weight_t)w; }
+
+template <>
+uint8_t from_float<uint8_t>(float w) noexcept { return (uint8_t)std::lround(w * 255.f); }
+
+template <>
+uint16_t from_float<uint16_t>(float w) noexcept { return (uint16_t)std::lround(w * 65535.f); }
+
+
+
+/*-------------------------------------
+    Double-precision reference
+-------------------------------------*/
+template <typename index_t, typename weight_t>
+math::vec3 reference_skin(const std::vector<math::mat4>& palette, const math::vec3& v, double homogenous, const math::vec4_t<index_t>& ids, const math::vec4_t<weight_t>& weights) noexcept
+{
+    double ret[3] = {0.0, 0.0, 0.0};
+
+    for (unsigned k = 0; k < 4; ++k)
+    {
+        const math::mat4& m = palette[ids[k]];
+        const double w = to_double(weights[k]);
+
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            ret[r] += w * ((double)m[0][r]*v[0] + (double)m[1][r]*v[1] + (double)m[2][r]*v[2] + (double)m[3][r]*homogenous);
+        }
+    }
+
+    return math::vec3{(float)ret[0], (float)ret[1], (float)ret[2]};
+}
+
+
+
+/*-------------------------------------
+    Skin a mesh with one combination of index & weight types
+-------------------------------------*/
+template <typename index_t, typename weight_t, typename prng_t>
+int test_skinning(prng_t& prng, const std::vector<math::mat4>& palette, const char* name) noexcept
+{
+    std::uniform_real_distribution<float> dist{-10.f, 10.f};
+    std::uniform_real_distribution<float> weightDist{0.f, 1.f};
+    std::uniform_int_distribution<unsigned> boneDist{0, (unsigned)palette.size()-1};
+    int numErrors = 0;
+
+    const auto run = [&](std::size_t count, unsigned numThreads)->void
+    {
+        std::vector<math::vec3> positions(count), normals(count);
+        std::vector<math::vec4_t<index_t>> ids(count);
+        std::vector<math::vec4_t<weight_t>> weights(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            positions[i] = math::vec3{dist(prng), dist(prng), dist(prng)};
+            normals[i] = math::vec3{dist(prng), dist(prng), dist(prng)};
+
+            // Leave some bones unused to exercise zero weights
+            const unsigned numBones = 1u + (unsigned)(i % 4u);
+            float w[4];
+            float total = 0.f;
+
+            for (unsigned k = 0; k < 4; ++k)
+            {
+                w[k] = (k < numBones) ? weightDist(prng) + 0.01f : 0.f;
+                total += w[k];
+            }
+
+            for (unsigned k = 0; k < 4; ++k)
+            {
+                ids[i][k] = (index_t)boneDist(prng);
+                weights[i][k] = from_float<weight_t>(w[k] / total);
+            }
+        }
+
+        // Skin in-place to exercise aliasing
+        std::vector<math::vec3> outPos = positions, outNorm = normals;
+        math::skin_vertices(palette.data(), outPos.data(), outNorm.data(), ids.data(), weights.data(), outPos.data(), outNorm.data(), count, numThreads);
+
+        // Explicit template arguments select the generic implementation
+        std::vector<math::vec3> genericPos(count);
+        math::skin_vertices<float, index_t, weight_t>(palette.data(), positions.data(), nullptr, ids.data(), weights.data(), genericPos.data(), nullptr, count, numThreads);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const math::vec3 expectedPos = reference_skin(palette, positions[i], 1.0, ids[i], weights[i]);
+            const math::vec3 expectedNorm = reference_skin(palette, normals[i], 0.0, ids[i], weights[i]);
+
+            if (!nearly_equal(outPos[i], expectedPos) || !nearly_equal(genericPos[i], expectedPos))
+            {
+                std::cerr << name << ": skinned position mismatch at " << i << " of " << count << '.' << std::endl;
+                ++numErrors;
+            }
+
+            if (!nearly_equal(outNorm[i], expectedNorm))
+            {
+                std::cerr << name << ": skinned normal mismatch at " << i << " of " << count << '.' << std::endl;
+                ++numErrors;
+            }
+        }
+    };
+
+    for (std::size_t count = 0; count < 37; ++count)
+    {
+        run(count, 1);
+    }
+
+    // Several chunks plus a partial one, across multiple threads
+    run(3*4096 + 37, 4);
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    std::mt19937 prng{1357};
+    std::uniform_real_distribution<float> dist{-1.f, 1.f};
+    int numErrors = 0;
+
+    // Affine bones containing rotation, scale, shear, and translation
+    std::vector<math::mat4> palette(40);
+    for (math::mat4& m : palette)
+    {
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            m[c] = math::vec4{dist(prng), dist(prng), dist(prng), 0.f};
+        }
+
+        m[3] = m[3] * 10.f;
+        m[3][3] = 1.f;
+    }
+
+    numErrors += test_skinning<uint8_t, float>(prng, palette, "uint8/float");
+    numErrors += test_skinning<uint16_t, float>(prng, palette, "uint16/float");
+    numErrors += test_skinning<uint8_t, math::half>(prng, palette, "uint8/half");
+    numErrors += test_skinning<uint16_t, math::half>(prng, palette, "uint16/half");
+    numErrors += test_skinning<uint8_t, uint8_t>(prng, palette, "uint8/unorm8");
+    numErrors += test_skinning<uint16_t, uint16_t>(prng, palette, "uint16/unorm16");
+
+    std::cout << "Tested linear blend skinning: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
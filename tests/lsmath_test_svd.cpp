@@ -0,0 +1,241 @@
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lightsky/math/mat_utils.h"
+#include "lightsky/math/svd.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Largest absolute difference between two matrices
+-------------------------------------*/
+template <typename num_t>
+double max_difference(const math::mat3_t<num_t>& a, const math::mat3_t<num_t>& b) noexcept
+{
+    double ret = 0.0;
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        for (unsigned r = 0; r < 3; ++r)
+        {
+            const double d = std::fabs((double)a[c][r] - (double)b[c][r]);
+            ret = (d > ret) ? d : ret;
+        }
+    }
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Rotations are orthonormal with a determinant of +1
+-------------------------------------*/
+template <typename num_t>
+bool is_rotation(const math::mat3_t<num_t>& m, double tolerance) noexcept
+{
+    return max_difference(math::transpose(m) * m, math::mat3_t<num_t>{(num_t)1}) <= tolerance
+        && std::fabs((double)math::determinant(m) - 1.0) <= tolerance;
+}
+
+
+
+/*-------------------------------------
+    Random matrices, including reflections, rank-deficient matrices, and
+    matrices with repeated singular values
+-------------------------------------*/
+template <typename num_t>
+std::vector<math::mat3_t<num_t>> make_matrices(std::mt19937& prng, unsigned count) noexcept
+{
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    std::vector<math::mat3_t<num_t>> ret(count);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        math::mat3_t<num_t>& m = ret[i];
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            m[c] = math::vec3_t<num_t>{(num_t)dist(prng), (num_t)dist(prng), (num_t)dist(prng)};
+        }
+
+        switch (i % 8)
+        {
+            case 0: // rank 2
+                m[2] = m[0] * (num_t)0.5 - m[1];
+                break;
+
+            case 1: // rank 1
+                m[1] = m[0] * (num_t)-2;
+                m[2] = m[0] * (num_t)3;
+                break;
+
+            case 2: // uniform scale, with or without a reflection
+                m = math::mat3_t<num_t>{(num_t)dist(prng) * (num_t)100};
+                break;
+
+            case 3: // large & small magnitudes
+                m = m * (num_t)((i & 16) ? 1.e12 : 1.e-12);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    ret[0] = math::mat3_t<num_t>{(num_t)0};
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Check the properties of each decomposition
+-------------------------------------*/
+template <typename num_t>
+int test_svd(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr unsigned count = 1003;
+    const std::vector<math::mat3_t<num_t>> matrices = make_matrices<num_t>(prng, count);
+
+    std::vector<math::mat3_t<num_t>> u(count), v(count), r(count), p(count);
+    std::vector<math::vec3_t<num_t>> s(count);
+    math::svd_batch(matrices.data(), u.data(), s.data(), v.data(), count);
+    math::polar_decompose_batch(matrices.data(), r.data(), p.data(), count);
+
+    int numErrors = 0;
+    const auto check = [&](bool result, const char* name, unsigned i)->void
+    {
+        if (!result)
+        {
+            std::cerr << name << " mismatch in " << (sizeof(num_t) == sizeof(float) ? "float" : "double") << " test " << i << '.' << std::endl;
+            ++numErrors;
+        }
+    };
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const math::mat3_t<num_t>& a = matrices[i];
+        const double scale = std::fabs((double)s[i][0]) > 0.0 ? std::fabs((double)s[i][0]) : 1.0;
+        const math::mat3_t<num_t> sigma{
+            s[i][0], (num_t)0, (num_t)0,
+            (num_t)0, s[i][1], (num_t)0,
+            (num_t)0, (num_t)0, s[i][2]
+        };
+
+        check(is_rotation(u[i], tolerance) && is_rotation(v[i], tolerance), "SVD rotation", i);
+        check(max_difference(u[i] * sigma * math::transpose(v[i]), a) <= tolerance * scale, "SVD reconstruction", i);
+        check(s[i][0] >= s[i][1] && (double)s[i][1] >= std::fabs((double)s[i][2]) - tolerance * scale, "Singular value order", i);
+        check((double)s[i][2] * (double)math::determinant(a) >= 0.0 || std::fabs(s[i][2]) <= tolerance * scale, "Singular value sign", i);
+
+        check(is_rotation(r[i], tolerance), "Polar rotation", i);
+        check(max_difference(p[i], math::transpose(p[i])) == 0.0, "Polar symmetry", i);
+        check(max_difference(r[i] * p[i], a) <= tolerance * scale, "Polar reconstruction", i);
+
+        // Single matrices use the same method. Singular vectors aren't unique,
+        // so results are only compared by their singular values.
+        math::mat3_t<num_t> su, sv, sr, sp;
+        math::vec3_t<num_t> ss;
+        math::svd(a, su, ss, sv);
+        math::polar_decompose(a, sr, sp);
+        check(std::fabs((double)ss[0] - (double)s[i][0]) <= tolerance * scale
+            && std::fabs((double)ss[1] - (double)s[i][1]) <= tolerance * scale
+            && std::fabs((double)ss[2] - (double)s[i][2]) <= tolerance * scale, "Scalar SVD", i);
+        check(max_difference(sr * sp, a) <= tolerance * scale, "Scalar polar decomposition", i);
+    }
+
+    // Inputs may alias outputs
+    std::vector<math::mat3_t<num_t>> aliased = matrices;
+    math::polar_decompose_batch(aliased.data(), aliased.data(), p.data(), count);
+    check(aliased == r, "Aliased polar decomposition", 0);
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    Check the eigen-decomposition of symmetric matrices
+-------------------------------------*/
+template <typename num_t>
+int test_eigen(std::mt19937& prng, double tolerance) noexcept
+{
+    constexpr unsigned count = 1003;
+    std::vector<math::mat3_t<num_t>> matrices = make_matrices<num_t>(prng, count);
+
+    // Positive semi-definite, indefinite, and asymmetric matrices
+    for (unsigned i = 0; i < count; ++i)
+    {
+        math::mat3_t<num_t>& m = matrices[i];
+        switch (i % 3)
+        {
+            case 0: m = math::transpose(m) * m; break;
+            case 1: m = m + math::transpose(m); break;
+            default: break;
+        }
+    }
+
+    std::vector<math::mat3_t<num_t>> vectors(count);
+    std::vector<math::vec3_t<num_t>> values(count);
+    math::eigen_symmetric_batch(matrices.data(), values.data(), vectors.data(), count);
+
+    int numErrors = 0;
+    const auto check = [&](bool result, const char* name, unsigned i)->void
+    {
+        if (!result)
+        {
+            std::cerr << name << " mismatch in " << (sizeof(num_t) == sizeof(float) ? "float" : "double") << " test " << i << '.' << std::endl;
+            ++numErrors;
+        }
+    };
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const math::mat3_t<num_t> a = (matrices[i] + math::transpose(matrices[i])) * (num_t)0.5;
+        const math::vec3_t<num_t>& d = values[i];
+        const math::mat3_t<num_t>& v = vectors[i];
+        const double largest = std::fabs((double)d[0]) > std::fabs((double)d[2]) ? std::fabs((double)d[0]) : std::fabs((double)d[2]);
+        const double scale = largest > 0.0 ? largest : 1.0;
+        const math::mat3_t<num_t> lambda{
+            d[0], (num_t)0, (num_t)0,
+            (num_t)0, d[1], (num_t)0,
+            (num_t)0, (num_t)0, d[2]
+        };
+
+        check(is_rotation(v, tolerance), "Eigenvector rotation", i);
+        check(max_difference(v * lambda * math::transpose(v), a) <= tolerance * scale, "Eigen reconstruction", i);
+        check(d[0] >= d[1] && d[1] >= d[2], "Eigenvalue order", i);
+
+        math::mat3_t<num_t> sv;
+        math::vec3_t<num_t> sd;
+        math::eigen_symmetric(matrices[i], sd, sv);
+        check(std::fabs((double)sd[0] - (double)d[0]) <= tolerance * scale
+            && std::fabs((double)sd[1] - (double)d[1]) <= tolerance * scale
+            && std::fabs((double)sd[2] - (double)d[2]) <= tolerance * scale, "Scalar eigen-decomposition", i);
+    }
+
+    return numErrors;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    std::mt19937 prng{8765};
+    int numErrors = 0;
+
+    numErrors += test_svd<float>(prng, 2.e-5);
+    numErrors += test_svd<double>(prng, 1.e-13);
+    numErrors += test_eigen<float>(prng, 2.e-5);
+    numErrors += test_eigen<double>(prng, 1.e-13);
+
+    std::cout << "Tested 3x3 singular value & eigen decompositions: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
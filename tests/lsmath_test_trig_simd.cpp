@@ -0,0 +1,282 @@
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+
+#include "lightsky/math/batch_utils.h"
+#include "lightsky/math/vec_utils.h"
+
+
+
+namespace chrono = std::chrono;
+typedef chrono::steady_clock::time_point hr_time;
+typedef chrono::nanoseconds hr_prec;
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Distance between two floats, in units of least precision
+-------------------------------------*/
+uint32_t ulp_distance(float a, float b) noexcept
+{
+    if (std::isnan(a) || std::isnan(b))
+    {
+        return (std::isnan(a) && std::isnan(b)) ? 0u : 0xFFFFFFFFu;
+    }
+
+    int32_t ia, ib;
+    std::memcpy(&ia, &a, sizeof(float));
+    std::memcpy(&ib, &b, sizeof(float));
+
+    // map to a monotonic integer line
+    ia = (ia < 0) ? (int32_t)(0x80000000u - (uint32_t)ia) : ia;
+    ib = (ib < 0) ? (int32_t)(0x80000000u - (uint32_t)ib) : ib;
+
+    const int64_t diff = (int64_t)ia - (int64_t)ib;
+    return (uint32_t)(diff < 0 ? -diff : diff);
+}
+
+
+
+/*-------------------------------------
+    Measure the error of a vec4 function, its batch equivalent, and the
+    throughput of both compared to the standard library. Relative error is
+    not meaningful near the roots of periodic functions, so results smaller
+    than "minMagnitude" are skipped.
+-------------------------------------*/
+template <typename vec_func_t, typename batch_func_t, typename std_func_t>
+int test_unary(
+    const char* name,
+    float lo,
+    float hi,
+    float minMagnitude,
+    uint32_t maxUlps,
+    vec_func_t&& vecFunc,
+    batch_func_t&& batchFunc,
+    std_func_t&& stdFunc) noexcept
+{
+    constexpr std::size_t numSamples = 1000003; // not a multiple of any SIMD width
+    std::unique_ptr<float[]> x{new float[numSamples]};
+    std::unique_ptr<float[]> ref{new float[numSamples]};
+    std::unique_ptr<float[]> batch{new float[numSamples]};
+
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        x[i] = lo + (hi - lo) * ((float)i / (float)(numSamples - 1));
+    }
+
+    hr_time t0 = chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        ref[i] = stdFunc(x[i]);
+    }
+
+    hr_time t1 = chrono::steady_clock::now();
+    for (std::size_t i = 0; i + 4 <= numSamples; i += 4)
+    {
+        const math::vec4f v = vecFunc(math::vec4f{x[i], x[i+1], x[i+2], x[i+3]});
+        batch[i+0] = v[0];
+        batch[i+1] = v[1];
+        batch[i+2] = v[2];
+        batch[i+3] = v[3];
+    }
+
+    hr_time t2 = chrono::steady_clock::now();
+    uint32_t vecUlps = 0;
+    for (std::size_t i = 0; i + 4 <= numSamples; i += 4)
+    {
+        for (std::size_t j = i; j < i + 4; ++j)
+        {
+            if (math::abs(ref[j]) >= minMagnitude)
+            {
+                vecUlps = math::max(vecUlps, ulp_distance(batch[j], ref[j]));
+            }
+        }
+    }
+
+    hr_time t3 = chrono::steady_clock::now();
+    batchFunc(x.get(), batch.get(), numSamples);
+    hr_time t4 = chrono::steady_clock::now();
+
+    uint32_t batchUlps = 0;
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        if (math::abs(ref[i]) >= minMagnitude)
+        {
+            batchUlps = math::max(batchUlps, ulp_distance(batch[i], ref[i]));
+        }
+    }
+
+    std::cout
+        << name << " [" << lo << ", " << hi << "]:"
+        << "\n\tMax ULP (vec4):   " << vecUlps
+        << "\n\tMax ULP (batch):  " << batchUlps
+        << "\n\tstd:: (ms):       " << (double)chrono::duration_cast<hr_prec>(t1 - t0).count() * 1.0e-6
+        << "\n\tvec4 (ms):        " << (double)chrono::duration_cast<hr_prec>(t2 - t1).count() * 1.0e-6
+        << "\n\tbatch (ms):       " << (double)chrono::duration_cast<hr_prec>(t4 - t3).count() * 1.0e-6
+        << std::endl;
+
+    if (vecUlps > maxUlps || batchUlps > maxUlps)
+    {
+        std::cerr << name << " exceeded " << maxUlps << " ULP of error." << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Validate sincos against separate calls
+-------------------------------------*/
+int test_sincos() noexcept
+{
+    constexpr std::size_t numSamples = 4099;
+    float x[numSamples];
+    float s[numSamples];
+    float c[numSamples];
+    float s2[numSamples];
+    float c2[numSamples];
+
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        x[i] = -1000.f + (float)i * 0.4871f;
+    }
+
+    math::sincos_batch(x, s, c, numSamples);
+    math::sin_batch(x, s2, numSamples);
+    math::cos_batch(x, c2, numSamples);
+
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        if (s[i] != s2[i] || c[i] != c2[i])
+        {
+            std::cerr << "sincos_batch() mismatch at " << x[i] << std::endl;
+            return -1;
+        }
+    }
+
+    math::vec4f vs, vc;
+    math::sincos(math::vec4f{x[0], x[1], x[2], x[3]}, vs, vc);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (vs[i] != s[i] || vc[i] != c[i])
+        {
+            std::cerr << "sincos() does not match sincos_batch() at " << x[i] << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+    Validate atan2 over a grid and at special values
+-------------------------------------*/
+int test_atan2() noexcept
+{
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    const float specials[] = {0.f, -0.f, 1.f, -1.f, 1.0e-30f, -1.0e-30f, 3.5e30f, -3.5e30f, inf, -inf};
+    constexpr std::size_t numSpecials = sizeof(specials) / sizeof(float);
+    constexpr std::size_t numSamples = 1001 * 1001 + numSpecials * numSpecials;
+
+    std::unique_ptr<float[]> y{new float[numSamples]};
+    std::unique_ptr<float[]> x{new float[numSamples]};
+    std::unique_ptr<float[]> batch{new float[numSamples]};
+
+    std::size_t n = 0;
+    for (int i = -500; i <= 500; ++i)
+    {
+        for (int j = -500; j <= 500; ++j, ++n)
+        {
+            y[n] = (float)i * 0.0173f;
+            x[n] = (float)j * 0.0291f;
+        }
+    }
+
+    for (float a : specials)
+    {
+        for (float b : specials)
+        {
+            y[n] = a;
+            x[n++] = b;
+        }
+    }
+
+    math::atan2_batch(y.get(), x.get(), batch.get(), numSamples);
+
+    uint32_t maxUlps = 0;
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        const float ref = std::atan2(y[i], x[i]);
+        const float v = math::atan2(math::vec4f{y[i]}, math::vec4f{x[i]})[0];
+
+        if (v != batch[i] || std::signbit(v) != std::signbit(ref))
+        {
+            std::cerr << "atan2(" << y[i] << ", " << x[i] << ") = " << v << ", expected " << ref << std::endl;
+            return -1;
+        }
+
+        maxUlps = math::max(maxUlps, ulp_distance(v, ref));
+    }
+
+    std::cout << "atan2:\n\tMax ULP:          " << maxUlps << std::endl;
+    return (maxUlps > 4) ? -1 : 0;
+}
+
+
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_unary(
+        "sin", -100.f * (float)LS_PI, 100.f * (float)LS_PI, 1.0e-3f, 3,
+        [](const math::vec4f& v)->math::vec4f { return math::sin(v); },
+        [](const float* x, float* out, std::size_t n)->void { math::sin_batch(x, out, n); },
+        [](float x)->float { return std::sin(x); });
+
+    ret |= test_unary(
+        "cos", -100.f * (float)LS_PI, 100.f * (float)LS_PI, 1.0e-3f, 3,
+        [](const math::vec4f& v)->math::vec4f { return math::cos(v); },
+        [](const float* x, float* out, std::size_t n)->void { math::cos_batch(x, out, n); },
+        [](float x)->float { return std::cos(x); });
+
+    ret |= test_unary(
+        "tan", -1.5f, 1.5f, 1.0e-3f, 4,
+        [](const math::vec4f& v)->math::vec4f { return math::tan(v); },
+        [](const float* x, float* out, std::size_t n)->void { math::tan_batch(x, out, n); },
+        [](float x)->float { return std::tan(x); });
+
+    ret |= test_unary(
+        "atan", -1000.f, 1000.f, 0.f, 3,
+        [](const math::vec4f& v)->math::vec4f { return math::atan(v); },
+        [](const float* x, float* out, std::size_t n)->void { math::atan_batch(x, out, n); },
+        [](float x)->float { return std::atan(x); });
+
+    ret |= test_unary(
+        "asin", -1.f, 1.f, 0.f, 3,
+        [](const math::vec4f& v)->math::vec4f { return math::asin(v); },
+        [](const float* x, float* out, std::size_t n)->void { math::asin_batch(x, out, n); },
+        [](float x)->float { return std::asin(x); });
+
+    ret |= test_unary(
+        "acos", -1.f, 1.f, 0.f, 3,
+        [](const math::vec4f& v)->math::vec4f { return math::acos(v); },
+        [](const float* x, float* out, std::size_t n)->void { math::acos_batch(x, out, n); },
+        [](float x)->float { return std::acos(x); });
+
+    ret |= test_sincos();
+    ret |= test_atan2();
+
+    return ret ? -1 : 0;
+}
@@ -0,0 +1,114 @@
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+#include "lightsky/math/vec_utils.h"
+
+
+
+namespace math = ls::math;
+
+
+
+/*-------------------------------------
+    Relative comparison of floats
+-------------------------------------*/
+bool nearly_equal(float a, float b, float tolerance = 1.e-5f) noexcept
+{
+    const float scale = std::fabs(a) > 1.f ? std::fabs(a) : 1.f;
+    return std::fabs(a - b) <= tolerance * scale;
+}
+
+bool nearly_equal(const math::vec3a& a, const math::vec3& b, float tolerance = 1.e-5f) noexcept
+{
+    return nearly_equal(a[0], b[0], tolerance)
+        && nearly_equal(a[1], b[1], tolerance)
+        && nearly_equal(a[2], b[2], tolerance);
+}
+
+
+
+/*-------------------------------------
+    Poison the padding element so any function which reads it fails.
+-------------------------------------*/
+math::vec3a padded(const math::vec3& v) noexcept
+{
+    math::vec3a ret = math::vec3a_cast(v);
+    ret[3] = std::numeric_limits<float>::quiet_NaN();
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    main
+-------------------------------------*/
+int main()
+{
+    constexpr unsigned numTests = 1000;
+    std::mt19937 prng{8765};
+    std::uniform_real_distribution<float> dist{-10.f, 10.f};
+    int numErrors = 0;
+
+    static_assert(sizeof(math::vec3a) == 4*sizeof(float), "Aligned 3D vectors must be padded.");
+    static_assert(alignof(math::vec3a) == 4*sizeof(float), "Aligned 3D vectors must be 16-byte aligned.");
+
+    const auto check = [&](bool result, const char* what, unsigned t) noexcept
+    {
+        if (!result)
+        {
+            std::cerr << what << " mismatch in test " << t << '.' << std::endl;
+            ++numErrors;
+        }
+    };
+
+    for (unsigned t = 0; t < numTests; ++t)
+    {
+        const math::vec3 a{dist(prng), dist(prng), dist(prng)};
+        const math::vec3 b{dist(prng), dist(prng), dist(prng)};
+        const math::vec3 c{dist(prng), dist(prng), dist(prng)};
+        const math::vec3a pa = padded(a);
+        const math::vec3a pb = padded(b);
+        const math::vec3a pc = padded(c);
+
+        check(math::vec3_cast(pa) == a, "Round-trip cast", t);
+        check(math::vec4_cast(pa, 1.f) == math::vec4_cast(a, 1.f), "4D cast", t);
+        check(pa == math::vec3a_cast(a) && !(pa != math::vec3a_cast(a)), "Equality", t);
+        check((pa < pa + 1.f) && (pa + 1.f > pa) && (pa <= pa) && (pa >= pa), "Ordering", t);
+
+        check(nearly_equal(pa + pb, a + b), "Addition", t);
+        check(nearly_equal(pa - pb, a - b), "Subtraction", t);
+        check(nearly_equal(pa * pb, a * b), "Multiplication", t);
+        check(nearly_equal(pa / pb, a / b), "Division", t);
+        check(nearly_equal(2.f - pa, math::vec3{2.f} - a), "Scalar subtraction", t);
+        check(nearly_equal(-pa, -a), "Negation", t);
+
+        check(nearly_equal(math::sum(pa), math::sum(a)), "Sum", t);
+        check(nearly_equal(math::dot(pa, pb), math::dot(a, b)), "Dot product", t);
+        check(nearly_equal(math::length_squared(pa), math::length_squared(a)), "Squared length", t);
+        check(nearly_equal(math::length(pa), math::length(a)), "Length", t);
+        check(nearly_equal(math::normalize(pa), math::normalize(a)), "Normalization", t);
+        check(nearly_equal(math::cross(pa, pb), math::cross(a, b)), "Cross product", t);
+        check(nearly_equal(math::reflect(pa, pb), math::reflect(a, b), 1.e-3f), "Reflection", t);
+        check(nearly_equal(math::project(pa, pb), math::project(a, b), 1.e-4f), "Projection", t);
+        check(nearly_equal(math::mid(pa, pb), math::mid(a, b)), "Midpoint", t);
+        check(nearly_equal(math::mix(pa, pb, 0.25f), math::mix(a, b, 0.25f)), "Mix", t);
+        check(nearly_equal(math::angle_between(pa, pb), math::angle_between(a, b), 1.e-3f), "Angle", t);
+
+        check(nearly_equal(math::min(pa, pb), math::min(a, b)), "Min", t);
+        check(nearly_equal(math::max(pa, pb), math::max(a, b)), "Max", t);
+        check(nearly_equal(math::clamp(pa, math::min(pb, pc), math::max(pb, pc)), math::clamp(a, math::min(b, c), math::max(b, c))), "Clamp", t);
+        check(nearly_equal(math::step(pb, pa), math::step(b, a)), "Step", t);
+        check(nearly_equal(math::floor(pa), math::floor(a)), "Floor", t);
+        check(nearly_equal(math::ceil(pa), math::ceil(a)), "Ceil", t);
+        check(nearly_equal(math::abs(pa), math::abs(a)), "Absolute value", t);
+        check(nearly_equal(math::fmadd(pa, pb, pc), math::fmadd(a, b, c)), "Multiply-add", t);
+        check(nearly_equal(math::fmsub(pa, pb, pc), math::fmsub(a, b, c)), "Multiply-subtract", t);
+        check(math::sign_mask(pa) == math::sign_mask(a), "Sign mask", t);
+    }
+
+    std::cout << "Tested " << numTests << " aligned 3D vectors: " << numErrors << " errors." << std::endl;
+    return numErrors ? -1 : 0;
+}
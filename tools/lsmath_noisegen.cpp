@@ -0,0 +1,644 @@
+
+#include <algorithm> // std::fill
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "lightsky/math/noise.h"
+
+
+
+namespace chrono = std::chrono;
+typedef chrono::steady_clock::time_point hr_time;
+typedef chrono::milliseconds hr_prec;
+
+namespace math = ls::math;
+
+
+
+/*-----------------------------------------------------------------------------
+    Generator Options
+-----------------------------------------------------------------------------*/
+enum NoiseType : unsigned
+{
+    NOISE_PERLIN,
+    NOISE_VALUE,
+    NOISE_WORLEY
+};
+
+enum FileFormat : unsigned
+{
+    FORMAT_RAW,
+    FORMAT_PGM,
+    FORMAT_PFM
+};
+
+struct NoiseGenArgs
+{
+    std::size_t width = 1024;
+    std::size_t height = 1024;
+    std::size_t depth = 1;
+
+    NoiseType noiseType = NOISE_PERLIN;
+    math::WorleyNoisef::DistanceMetric metric = math::WorleyNoisef::WORLEY_DIST_EUCLIDEAN;
+
+    unsigned long seed = 0;
+    unsigned octaves = 1;
+    float persistence = 0.5f;
+    math::vec3f frequency = math::vec3f{1.f / 64.f};
+    math::vec3f offset = math::vec3f{0.f};
+
+    bool periodic = false;
+    bool tileable = false;
+    math::vec3i period = math::vec3i{256};
+
+    FileFormat format = FORMAT_PGM;
+    unsigned bits = 8;
+    std::size_t memoryBudget = 256u * 1024u * 1024u;
+    unsigned numThreads = 0;
+    const char* outFile = nullptr;
+};
+
+
+
+/*-------------------------------------
+    Print the program usage
+-------------------------------------*/
+void print_usage(const char* programName) noexcept
+{
+    std::cout
+        << "Usage: " << programName << " [options] -o <output file>\n"
+        << "\nGenerates a 2D heightmap or 3D volume of noise, streaming tiles of rows"
+        << "\nto disk so arbitrarily large outputs fit within a bounded amount of memory."
+        << "\n\nOptions:"
+        << "\n\t-o, --out <file>        Output file path."
+        << "\n\t-w, --width <n>         Number of samples along the X axis (default: 1024)."
+        << "\n\t-h, --height <n>        Number of samples along the Y axis (default: 1024)."
+        << "\n\t-d, --depth <n>         Number of samples along the Z axis (default: 1). Values"
+        << "\n\t                        greater than 1 produce a volume and require --format raw."
+        << "\n\t-n, --noise <type>      perlin, value, or worley (default: perlin)."
+        << "\n\t--metric <type>         Worley distance metric: euclidean, manhattan, or"
+        << "\n\t                        chebyshev (default: euclidean)."
+        << "\n\t-s, --seed <n>          Seed for the noise generator (default: 0)."
+        << "\n\t--octaves <n>           Number of fractal octaves (default: 1)."
+        << "\n\t--persistence <f>       Amplitude multiplier of each octave (default: 0.5)."
+        << "\n\t--frequency <x[,y[,z]]> Lattice cells per sample of the base octave (default: 1/64)."
+        << "\n\t--offset <x,y,z>        Translation applied to the sampled noise lattice."
+        << "\n\t--period <x[,y[,z]]>    Repeat the base octave every N lattice cells."
+        << "\n\t--tileable              Choose a period which makes the output wrap seamlessly."
+        << "\n\t-f, --format <type>     raw, pgm, or pfm (default: pgm)."
+        << "\n\t-b, --bits <n>          Bits per raw/pgm sample: 8, 16, or 32 (32-bit is raw"
+        << "\n\t                        floating-point only, default: 8)."
+        << "\n\t-m, --memory <MiB>      Memory budget for tile buffers (default: 256)."
+        << "\n\t-t, --threads <n>       Number of compute threads (default: all cores)."
+        << "\n\t--help                  Print this message."
+        << "\n\nOutput is deterministic for any given set of options, regardless of the"
+        << "\nmemory budget or thread count."
+        << std::endl;
+}
+
+
+
+/*-------------------------------------
+    Parse a comma-separated vector
+-------------------------------------*/
+template <typename num_t, typename parse_func_t>
+bool parse_vec3(const char* arg, math::vec3_t<num_t>& out, parse_func_t parse) noexcept
+{
+    char* end = nullptr;
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        out[i] = parse(arg, &end);
+        if (end == arg)
+        {
+            return false;
+        }
+
+        if (*end != ',')
+        {
+            // Broadcast the last value to any remaining components
+            for (unsigned j = i + 1; j < 3; ++j)
+            {
+                out[j] = out[i];
+            }
+            return *end == '\0';
+        }
+
+        arg = end + 1;
+    }
+
+    return *end == '\0';
+}
+
+
+
+/*-------------------------------------
+    Parse command-line arguments
+-------------------------------------*/
+int parse_args(int argc, char** argv, NoiseGenArgs& args) noexcept
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* opt = argv[i];
+
+        if (!std::strcmp(opt, "--help"))
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        if (!std::strcmp(opt, "--tileable"))
+        {
+            args.tileable = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for option " << opt << std::endl;
+            return -1;
+        }
+
+        const char* val = argv[++i];
+        bool valid = true;
+
+        if (!std::strcmp(opt, "-o") || !std::strcmp(opt, "--out"))
+        {
+            args.outFile = val;
+        }
+        else if (!std::strcmp(opt, "-w") || !std::strcmp(opt, "--width"))
+        {
+            args.width = std::strtoull(val, nullptr, 10);
+            valid = args.width > 0;
+        }
+        else if (!std::strcmp(opt, "-h") || !std::strcmp(opt, "--height"))
+        {
+            args.height = std::strtoull(val, nullptr, 10);
+            valid = args.height > 0;
+        }
+        else if (!std::strcmp(opt, "-d") || !std::strcmp(opt, "--depth"))
+        {
+            args.depth = std::strtoull(val, nullptr, 10);
+            valid = args.depth > 0;
+        }
+        else if (!std::strcmp(opt, "-n") || !std::strcmp(opt, "--noise"))
+        {
+            if (!std::strcmp(val, "perlin"))      args.noiseType = NOISE_PERLIN;
+            else if (!std::strcmp(val, "value"))  args.noiseType = NOISE_VALUE;
+            else if (!std::strcmp(val, "worley")) args.noiseType = NOISE_WORLEY;
+            else valid = false;
+        }
+        else if (!std::strcmp(opt, "--metric"))
+        {
+            if (!std::strcmp(val, "euclidean"))      args.metric = math::WorleyNoisef::WORLEY_DIST_EUCLIDEAN;
+            else if (!std::strcmp(val, "manhattan")) args.metric = math::WorleyNoisef::WORLEY_DIST_MANHATTAN;
+            else if (!std::strcmp(val, "chebyshev")) args.metric = math::WorleyNoisef::WORLEY_DIST_CHEBYSHEV;
+            else valid = false;
+        }
+        else if (!std::strcmp(opt, "-s") || !std::strcmp(opt, "--seed"))
+        {
+            args.seed = std::strtoul(val, nullptr, 0);
+        }
+        else if (!std::strcmp(opt, "--octaves"))
+        {
+            args.octaves = (unsigned)std::strtoul(val, nullptr, 10);
+            valid = args.octaves > 0 && args.octaves <= 16;
+        }
+        else if (!std::strcmp(opt, "--persistence"))
+        {
+            args.persistence = std::strtof(val, nullptr);
+        }
+        else if (!std::strcmp(opt, "--frequency"))
+        {
+            valid = parse_vec3(val, args.frequency, [](const char* s, char** e)->float {return std::strtof(s, e);});
+            valid = valid && args.frequency[0] > 0.f && args.frequency[1] > 0.f && args.frequency[2] > 0.f;
+        }
+        else if (!std::strcmp(opt, "--offset"))
+        {
+            valid = parse_vec3(val, args.offset, [](const char* s, char** e)->float {return std::strtof(s, e);});
+        }
+        else if (!std::strcmp(opt, "--period"))
+        {
+            args.periodic = true;
+            valid = parse_vec3(val, args.period, [](const char* s, char** e)->int {return (int)std::strtol(s, e, 10);});
+            valid = valid && args.period[0] > 0 && args.period[1] > 0 && args.period[2] > 0;
+        }
+        else if (!std::strcmp(opt, "-f") || !std::strcmp(opt, "--format"))
+        {
+            if (!std::strcmp(val, "raw"))      args.format = FORMAT_RAW;
+            else if (!std::strcmp(val, "pgm")) args.format = FORMAT_PGM;
+            else if (!std::strcmp(val, "pfm")) args.format = FORMAT_PFM;
+            else valid = false;
+        }
+        else if (!std::strcmp(opt, "-b") || !std::strcmp(opt, "--bits"))
+        {
+            args.bits = (unsigned)std::strtoul(val, nullptr, 10);
+            valid = args.bits == 8 || args.bits == 16 || args.bits == 32;
+        }
+        else if (!std::strcmp(opt, "-m") || !std::strcmp(opt, "--memory"))
+        {
+            args.memoryBudget = (std::size_t)std::strtoull(val, nullptr, 10) * 1024u * 1024u;
+            valid = args.memoryBudget > 0;
+        }
+        else if (!std::strcmp(opt, "-t") || !std::strcmp(opt, "--threads"))
+        {
+            args.numThreads = (unsigned)std::strtoul(val, nullptr, 10);
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << opt << std::endl;
+            return -1;
+        }
+
+        if (!valid)
+        {
+            std::cerr << "Invalid value for option " << opt << ": " << val << std::endl;
+            return -1;
+        }
+    }
+
+    if (!args.outFile)
+    {
+        std::cerr << "No output file specified." << std::endl;
+        return -1;
+    }
+
+    if (args.format == FORMAT_PFM)
+    {
+        args.bits = 32;
+    }
+    else if (args.format == FORMAT_PGM && args.bits == 32)
+    {
+        std::cerr << "PGM files only support 8 or 16 bits per sample." << std::endl;
+        return -1;
+    }
+
+    if (args.depth > 1 && args.format != FORMAT_RAW)
+    {
+        std::cerr << "3D volumes can only be written to raw files." << std::endl;
+        return -1;
+    }
+
+    if (args.tileable)
+    {
+        const std::size_t dims[3] = {args.width, args.height, args.depth};
+        args.periodic = true;
+
+        // Adjust the frequency of each axis so an integral number of cells
+        // spans the output
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            const float cells = (float)dims[i] * args.frequency[i];
+            args.period[i] = cells < 1.f ? 1 : (int)(cells + 0.5f);
+            args.frequency[i] = (float)args.period[i] / (float)dims[i];
+        }
+    }
+
+    if (!args.numThreads)
+    {
+        args.numThreads = std::thread::hardware_concurrency();
+        args.numThreads = args.numThreads ? args.numThreads : 1;
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Tile Generation
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Compute a single row of fractal noise
+-------------------------------------*/
+template <typename noise_type>
+void compute_row(
+    const noise_type& noise,
+    const NoiseGenArgs& args,
+    std::size_t y,
+    std::size_t z,
+    float* outRow,
+    float* octaveRow) noexcept
+{
+    const math::vec3_t<unsigned> dims{(unsigned)args.width, 1u, 1u};
+    math::vec3f frequency = args.frequency;
+    float amplitude = 1.f;
+    float maxValue = 0.f;
+    math::vec3i period = args.period;
+
+    std::fill(outRow, outRow + args.width, 0.f);
+
+    for (unsigned octave = 0; octave < args.octaves; ++octave)
+    {
+        const math::vec3f origin = math::vec3f{0.f, (float)y * frequency[1], (float)z * frequency[2]} + args.offset * (float)(1u << octave);
+        const math::vec3f stride{frequency[0], 0.f, 0.f};
+
+        if (args.periodic)
+        {
+            noise.get_noise_grid(octaveRow, origin, stride, dims, period);
+        }
+        else
+        {
+            noise.get_noise_grid(octaveRow, origin, stride, dims);
+        }
+
+        for (std::size_t x = 0; x < args.width; ++x)
+        {
+            outRow[x] += octaveRow[x] * amplitude;
+        }
+
+        maxValue += amplitude;
+        amplitude *= args.persistence;
+        frequency = frequency * 2.f;
+        period = period * 2;
+    }
+
+    const float scale = 1.f / maxValue;
+    for (std::size_t x = 0; x < args.width; ++x)
+    {
+        outRow[x] *= scale;
+    }
+}
+
+
+
+/*-------------------------------------
+    Convert a row of noise into its file representation
+-------------------------------------*/
+void encode_row(const NoiseGenArgs& args, const float* samples, unsigned char* outBytes) noexcept
+{
+    if (args.bits == 32)
+    {
+        // PFM and raw floats are stored in little-endian order
+        for (std::size_t x = 0; x < args.width; ++x)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, samples + x, sizeof(float));
+
+            outBytes[x * 4 + 0] = (unsigned char)(bits);
+            outBytes[x * 4 + 1] = (unsigned char)(bits >> 8u);
+            outBytes[x * 4 + 2] = (unsigned char)(bits >> 16u);
+            outBytes[x * 4 + 3] = (unsigned char)(bits >> 24u);
+        }
+        return;
+    }
+
+    // Gradient noise is signed while Worley distances are not
+    const float bias = (args.noiseType == NOISE_WORLEY) ? 0.f : 1.f;
+    const float scale = (args.noiseType == NOISE_WORLEY) ? 1.f : 0.5f;
+
+    if (args.bits == 16)
+    {
+        // PGM samples are big-endian while raw data is little-endian
+        const bool bigEndian = args.format == FORMAT_PGM;
+
+        for (std::size_t x = 0; x < args.width; ++x)
+        {
+            const float n = math::clamp((samples[x] + bias) * scale, 0.f, 1.f);
+            const unsigned v = (unsigned)(n * 65535.f + 0.5f);
+
+            outBytes[x * 2 + 0] = (unsigned char)(bigEndian ? (v >> 8u) : v);
+            outBytes[x * 2 + 1] = (unsigned char)(bigEndian ? v : (v >> 8u));
+        }
+        return;
+    }
+
+    for (std::size_t x = 0; x < args.width; ++x)
+    {
+        const float n = math::clamp((samples[x] + bias) * scale, 0.f, 1.f);
+        outBytes[x] = (unsigned char)(n * 255.f + 0.5f);
+    }
+}
+
+
+
+/*-------------------------------------
+    Compute a band of rows across several threads
+-------------------------------------*/
+template <typename noise_type>
+void compute_band(
+    const noise_type& noise,
+    const NoiseGenArgs& args,
+    std::size_t firstRow,
+    std::size_t numRows,
+    float* samples,
+    float* octaveRows,
+    unsigned char* outBytes) noexcept
+{
+    const std::size_t bytesPerRow = args.width * (args.bits / 8u);
+    const unsigned numThreads = (unsigned)math::min<std::size_t>(args.numThreads, numRows);
+
+    auto worker = [&](unsigned threadId)->void
+    {
+        float* const octaveRow = octaveRows + args.width * threadId;
+
+        // Rows are interleaved across threads; each row is independent of
+        // the thread which computes it, keeping the output deterministic.
+        for (std::size_t r = threadId; r < numRows; r += numThreads)
+        {
+            const std::size_t fileRow = firstRow + r;
+            const std::size_t z = fileRow / args.height;
+            std::size_t y = fileRow % args.height;
+
+            // PFM images are stored from the bottom row to the top
+            if (args.format == FORMAT_PFM)
+            {
+                y = args.height - y - 1;
+            }
+
+            compute_row(noise, args, y, z, samples + r * args.width, octaveRow);
+            encode_row(args, samples + r * args.width, outBytes + r * bytesPerRow);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+
+    for (unsigned t = 1; t < numThreads; ++t)
+    {
+        threads.emplace_back(worker, t);
+    }
+
+    worker(0);
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+
+
+/*-------------------------------------
+    Write the file header
+-------------------------------------*/
+bool write_header(const NoiseGenArgs& args, std::FILE* file) noexcept
+{
+    switch (args.format)
+    {
+        case FORMAT_PGM:
+            return std::fprintf(file, "P5\n%zu %zu\n%u\n", args.width, args.height, args.bits == 16 ? 65535u : 255u) > 0;
+
+        case FORMAT_PFM:
+            // A negative scale indicates little-endian samples
+            return std::fprintf(file, "Pf\n%zu %zu\n-1.0\n", args.width, args.height) > 0;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Stream all tiles to disk
+
+    Two tile buffers are used so computation of tile N+1 can overlap with
+    the write of tile N.
+-------------------------------------*/
+template <typename noise_type>
+int generate(const noise_type& noise, const NoiseGenArgs& args, std::FILE* file) noexcept
+{
+    const std::size_t bytesPerRow = args.width * (args.bits / 8u);
+    const std::size_t totalRows = args.height * args.depth;
+    const std::size_t scratchBytes = args.width * sizeof(float) * args.numThreads;
+    const std::size_t rowBytes = 2u * (args.width * sizeof(float) + bytesPerRow);
+
+    if (args.memoryBudget < scratchBytes + rowBytes)
+    {
+        std::cerr << "Memory budget is too small to hold a single row of output." << std::endl;
+        return -1;
+    }
+
+    const std::size_t rowsPerTile = math::min<std::size_t>(totalRows, (args.memoryBudget - scratchBytes) / rowBytes);
+
+    std::unique_ptr<float[]> octaveRows{new(std::nothrow) float[args.width * args.numThreads]};
+    std::unique_ptr<float[]> samples[2] = {
+        std::unique_ptr<float[]>{new(std::nothrow) float[args.width * rowsPerTile]},
+        std::unique_ptr<float[]>{new(std::nothrow) float[args.width * rowsPerTile]}
+    };
+    std::unique_ptr<unsigned char[]> tiles[2] = {
+        std::unique_ptr<unsigned char[]>{new(std::nothrow) unsigned char[bytesPerRow * rowsPerTile]},
+        std::unique_ptr<unsigned char[]>{new(std::nothrow) unsigned char[bytesPerRow * rowsPerTile]}
+    };
+
+    if (!octaveRows || !samples[0] || !samples[1] || !tiles[0] || !tiles[1])
+    {
+        std::cerr << "Unable to allocate tile buffers." << std::endl;
+        return -1;
+    }
+
+    if (!write_header(args, file))
+    {
+        std::cerr << "Unable to write the file header." << std::endl;
+        return -1;
+    }
+
+    std::future<bool> pendingWrite;
+    unsigned tileId = 0;
+
+    for (std::size_t row = 0; row < totalRows; row += rowsPerTile, tileId ^= 1u)
+    {
+        const std::size_t numRows = math::min<std::size_t>(rowsPerTile, totalRows - row);
+
+        compute_band(noise, args, row, numRows, samples[tileId].get(), octaveRows.get(), tiles[tileId].get());
+
+        // The previous write used the other buffer and must complete before
+        // it can be reused.
+        if (pendingWrite.valid() && !pendingWrite.get())
+        {
+            std::cerr << "Unable to write to the output file." << std::endl;
+            return -1;
+        }
+
+        const unsigned char* tile = tiles[tileId].get();
+        const std::size_t numBytes = numRows * bytesPerRow;
+
+        pendingWrite = std::async(std::launch::async, [file, tile, numBytes]()->bool
+        {
+            return std::fwrite(tile, 1, numBytes, file) == numBytes;
+        });
+    }
+
+    if (pendingWrite.valid() && !pendingWrite.get())
+    {
+        std::cerr << "Unable to write to the output file." << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Main
+-----------------------------------------------------------------------------*/
+int main(int argc, char** argv)
+{
+    NoiseGenArgs args;
+    const int argStatus = parse_args(argc, argv, args);
+
+    if (argStatus != 0)
+    {
+        if (argStatus < 0)
+        {
+            print_usage(argv[0]);
+        }
+        return argStatus < 0 ? -1 : 0;
+    }
+
+    std::FILE* file = std::fopen(args.outFile, "wb");
+    if (!file)
+    {
+        std::cerr << "Unable to open " << args.outFile << " for writing." << std::endl;
+        return -1;
+    }
+
+    int result;
+    const hr_time t1 = chrono::steady_clock::now();
+
+    switch (args.noiseType)
+    {
+        case NOISE_VALUE:
+            result = generate(math::ValueNoisef{args.seed}, args, file);
+            break;
+
+        case NOISE_WORLEY:
+            result = generate(math::WorleyNoisef{args.seed, args.metric}, args, file);
+            break;
+
+        default:
+            result = generate(math::PerlinNoisef{args.seed}, args, file);
+    }
+
+    const hr_time t2 = chrono::steady_clock::now();
+
+    if (std::fclose(file) != 0)
+    {
+        result = -1;
+    }
+
+    if (result == 0)
+    {
+        const std::size_t numSamples = args.width * args.height * args.depth;
+        const long long millis = chrono::duration_cast<hr_prec>(t2 - t1).count();
+
+        std::cout
+            << "Generated " << args.width << 'x' << args.height << 'x' << args.depth
+            << " samples in " << millis << "ms ("
+            << ((double)numSamples / ((double)millis * 1.0e3 + 1.0e-3)) << " M samples/sec)."
+            << std::endl;
+    }
+
+    return result;
+}
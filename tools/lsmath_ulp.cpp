@@ -0,0 +1,846 @@
+
+#include <algorithm> // std::fill
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "lightsky/math/accuracy.h"
+#include "lightsky/math/parallel.h"
+
+
+
+namespace chrono = std::chrono;
+typedef chrono::steady_clock::time_point hr_time;
+typedef chrono::duration<double> hr_prec;
+
+namespace math = ls::math;
+
+
+
+/*-----------------------------------------------------------------------------
+    Function Registry
+-----------------------------------------------------------------------------*/
+enum Tier : unsigned
+{
+    TIER_DEFAULT,
+    TIER_FAST,
+    TIER_BALANCED,
+    TIER_PRECISE,
+
+    TIER_COUNT
+};
+
+enum Variant : unsigned
+{
+    VARIANT_SCALAR,
+    VARIANT_VEC4,
+
+    VARIANT_COUNT
+};
+
+static const char* const TIER_NAMES[TIER_COUNT] = {"default", "fast", "balanced", "precise"};
+static const char* const VARIANT_NAMES[VARIANT_COUNT] = {"scalar", "vec4"};
+
+typedef float (*ScalarFunc)(float, float);
+typedef math::vec4f (*VectorFunc)(const math::vec4f&, const math::vec4f&);
+typedef long double (*ReferenceFunc)(long double, long double);
+
+struct MathFunction
+{
+    const char* name;
+    unsigned arity;
+
+    // Grid ranges of two-argument functions
+    float xLo, xHi;
+    float yLo, yHi;
+
+    ReferenceFunc reference;
+    ScalarFunc scalar[TIER_COUNT];
+    VectorFunc vector[TIER_COUNT];
+};
+
+#define LS_REF(expr) [](long double x, long double y)->long double { (void)y; return expr; }
+#define LS_SCALAR(expr) [](float x, float y)->float { (void)y; return expr; }
+#define LS_VEC4(expr) [](const math::vec4f& x, const math::vec4f& y)->math::vec4f { (void)y; return expr; }
+
+#define LS_TIERED_SCALAR(func, defaultFunc) { \
+    LS_SCALAR(defaultFunc(x)), \
+    LS_SCALAR(math::fast::func(x)), \
+    LS_SCALAR(math::balanced::func(x)), \
+    LS_SCALAR(math::precise::func(x)) }
+
+#define LS_TIERED_VEC4(func, defaultFunc) { \
+    defaultFunc, \
+    LS_VEC4(math::fast::func(x)), \
+    LS_VEC4(math::balanced::func(x)), \
+    LS_VEC4(math::precise::func(x)) }
+
+#define LS_TIERED_UNARY(func, ref, defaultScalar, defaultVec) \
+    {#func, 1, 0.f, 0.f, 0.f, 0.f, LS_REF(ref), LS_TIERED_SCALAR(func, defaultScalar), LS_TIERED_VEC4(func, defaultVec)}
+
+constexpr float FLT_MAX_VAL = std::numeric_limits<float>::max();
+
+static const MathFunction FUNCTIONS[] = {
+    LS_TIERED_UNARY(sin,         std::sin(x),          math::sin,         LS_VEC4(math::sin(x))),
+    LS_TIERED_UNARY(cos,         std::cos(x),          math::cos,         LS_VEC4(math::cos(x))),
+    LS_TIERED_UNARY(tan,         std::tan(x),          math::tan,         LS_VEC4(math::tan(x))),
+    LS_TIERED_UNARY(asin,        std::asin(x),         math::asin,        LS_VEC4(math::asin(x))),
+    LS_TIERED_UNARY(acos,        std::acos(x),         math::acos,        LS_VEC4(math::acos(x))),
+    LS_TIERED_UNARY(atan,        std::atan(x),         math::atan,        LS_VEC4(math::atan(x))),
+    LS_TIERED_UNARY(exp,         std::exp(x),          math::exp,         LS_VEC4(math::exp(x))),
+    LS_TIERED_UNARY(exp2,        std::exp2(x),         math::exp2,        LS_VEC4(math::exp2(x))),
+    LS_TIERED_UNARY(log,         std::log(x),          math::log,         LS_VEC4(math::log(x))),
+    LS_TIERED_UNARY(log2,        std::log2(x),         math::log2,        LS_VEC4(math::log2(x))),
+    LS_TIERED_UNARY(sqrt,        std::sqrt(x),         math::fast_sqrt,   nullptr),
+    LS_TIERED_UNARY(inversesqrt, 1.0L / std::sqrt(x),  math::inversesqrt, nullptr),
+    LS_TIERED_UNARY(rcp,         1.0L / x,             math::rcp,         LS_VEC4(math::rcp(x))),
+
+    {
+        "atan2", 2, -FLT_MAX_VAL, FLT_MAX_VAL, -FLT_MAX_VAL, FLT_MAX_VAL,
+        LS_REF(std::atan2(x, y)),
+        {LS_SCALAR(math::atan2(x, y)), LS_SCALAR(math::fast::atan2(x, y)), LS_SCALAR(math::balanced::atan2(x, y)), LS_SCALAR(math::precise::atan2(x, y))},
+        {LS_VEC4(math::atan2(x, y)), LS_VEC4(math::fast::atan2(x, y)), LS_VEC4(math::balanced::atan2(x, y)), LS_VEC4(math::precise::atan2(x, y))}
+    },
+    {
+        "pow", 2, 0.f, FLT_MAX_VAL, -128.f, 128.f,
+        LS_REF(std::pow(x, y)),
+        {LS_SCALAR(math::pow(x, y)), LS_SCALAR(math::fast::pow(x, y)), LS_SCALAR(math::balanced::pow(x, y)), LS_SCALAR(math::precise::pow(x, y))},
+        {LS_VEC4(math::pow(x, y)), LS_VEC4(math::fast::pow(x, y)), LS_VEC4(math::balanced::pow(x, y)), LS_VEC4(math::precise::pow(x, y))}
+    }
+};
+
+constexpr std::size_t NUM_FUNCTIONS = sizeof(FUNCTIONS) / sizeof(MathFunction);
+
+
+
+/*-----------------------------------------------------------------------------
+    Error Statistics
+-----------------------------------------------------------------------------*/
+enum InputClass : unsigned
+{
+    INPUT_NORMAL,
+    INPUT_SUBNORMAL,
+    INPUT_ZERO,
+    INPUT_INFINITY,
+    INPUT_NAN,
+
+    INPUT_CLASS_COUNT
+};
+
+static const char* const INPUT_CLASS_NAMES[INPUT_CLASS_COUNT] = {"normal", "subnormal", "zero", "infinity", "nan"};
+
+// Bucket 0 counts exact results, bucket "i" counts errors within
+// (2^(i-2), 2^(i-1)] ULP, and the last bucket counts anything larger.
+constexpr unsigned NUM_HISTOGRAM_BUCKETS = 26;
+
+struct ClassStats
+{
+    uint64_t samples = 0;
+    uint64_t maxUlp = 0;
+    uint64_t nanMismatches = 0;
+    uint64_t signMismatches = 0;
+};
+
+struct UlpStats
+{
+    uint64_t samples = 0;
+    uint64_t maxUlp = 0;
+    float maxUlpX = 0.f;
+    float maxUlpY = 0.f;
+    long double sumUlp = 0.L;
+    uint64_t nanMismatches = 0;
+    uint64_t signMismatches = 0;
+    uint64_t histogram[NUM_HISTOGRAM_BUCKETS] = {0};
+    ClassStats classes[INPUT_CLASS_COUNT];
+
+    void merge(const UlpStats& s) noexcept;
+};
+
+
+
+/*-------------------------------------
+    Combine the results of two threads
+-------------------------------------*/
+void UlpStats::merge(const UlpStats& s) noexcept
+{
+    if (s.maxUlp > maxUlp || !samples)
+    {
+        maxUlp = s.maxUlp;
+        maxUlpX = s.maxUlpX;
+        maxUlpY = s.maxUlpY;
+    }
+
+    samples += s.samples;
+    sumUlp += s.sumUlp;
+    nanMismatches += s.nanMismatches;
+    signMismatches += s.signMismatches;
+
+    for (unsigned i = 0; i < NUM_HISTOGRAM_BUCKETS; ++i)
+    {
+        histogram[i] += s.histogram[i];
+    }
+
+    for (unsigned i = 0; i < INPUT_CLASS_COUNT; ++i)
+    {
+        classes[i].samples += s.classes[i].samples;
+        classes[i].maxUlp = math::max(classes[i].maxUlp, s.classes[i].maxUlp);
+        classes[i].nanMismatches += s.classes[i].nanMismatches;
+        classes[i].signMismatches += s.classes[i].signMismatches;
+    }
+}
+
+
+
+/*-------------------------------------
+    Map a float onto a monotonic integer line
+-------------------------------------*/
+inline int64_t float_ordinal(float f) noexcept
+{
+    int32_t i;
+    std::memcpy(&i, &f, sizeof(float));
+    return (i < 0) ? -(int64_t)(i & 0x7FFFFFFF) : (int64_t)i;
+}
+
+inline float ordinal_float(int64_t o) noexcept
+{
+    const int32_t i = (o < 0) ? (int32_t)((uint32_t)(-o) | 0x80000000u) : (int32_t)o;
+    float f;
+    std::memcpy(&f, &i, sizeof(float));
+    return f;
+}
+
+
+
+/*-------------------------------------
+    Classify an input
+-------------------------------------*/
+inline InputClass classify(float f) noexcept
+{
+    switch (std::fpclassify(f))
+    {
+        case FP_NAN:       return INPUT_NAN;
+        case FP_INFINITE:  return INPUT_INFINITY;
+        case FP_ZERO:      return INPUT_ZERO;
+        case FP_SUBNORMAL: return INPUT_SUBNORMAL;
+        default:           break;
+    }
+
+    return INPUT_NORMAL;
+}
+
+
+
+/*-------------------------------------
+    Accumulate the error of a single result
+-------------------------------------*/
+inline void accumulate(UlpStats& stats, float x, float y, InputClass inputClass, float result, float ref) noexcept
+{
+    ClassStats& cs = stats.classes[inputClass];
+    ++cs.samples;
+
+    const bool resultNan = std::isnan(result);
+    const bool refNan = std::isnan(ref);
+
+    if (resultNan || refNan)
+    {
+        if (resultNan != refNan)
+        {
+            ++stats.nanMismatches;
+            ++cs.nanMismatches;
+            ++stats.histogram[NUM_HISTOGRAM_BUCKETS - 1];
+        }
+        else
+        {
+            ++stats.samples;
+            ++stats.histogram[0];
+        }
+        return;
+    }
+
+    if (ref == 0.f && result == 0.f && std::signbit(ref) != std::signbit(result))
+    {
+        ++stats.signMismatches;
+        ++cs.signMismatches;
+    }
+
+    const int64_t diff = float_ordinal(result) - float_ordinal(ref);
+    const uint64_t ulp = (uint64_t)(diff < 0 ? -diff : diff);
+
+    unsigned bucket = 0;
+    if (ulp)
+    {
+        bucket = 1;
+        while (bucket < NUM_HISTOGRAM_BUCKETS - 1 && (1ull << (bucket - 1)) < ulp)
+        {
+            ++bucket;
+        }
+    }
+
+    ++stats.histogram[bucket];
+    ++stats.samples;
+    stats.sumUlp += (long double)ulp;
+    cs.maxUlp = math::max(cs.maxUlp, ulp);
+
+    if (ulp > stats.maxUlp || stats.samples == 1)
+    {
+        stats.maxUlp = ulp;
+        stats.maxUlpX = x;
+        stats.maxUlpY = y;
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Program Options
+-----------------------------------------------------------------------------*/
+struct UlpArgs
+{
+    bool functions[NUM_FUNCTIONS];
+    bool tiers[TIER_COUNT];
+    bool variants[VARIANT_COUNT];
+    uint64_t step = 1;
+    unsigned gridSize = 4096;
+    unsigned numThreads = 0;
+    const char* outFile = nullptr;
+
+    UlpArgs() noexcept
+    {
+        std::fill(functions, functions + NUM_FUNCTIONS, true);
+        std::fill(tiers, tiers + TIER_COUNT, true);
+        std::fill(variants, variants + VARIANT_COUNT, true);
+    }
+};
+
+
+
+/*-------------------------------------
+    Print the program usage
+-------------------------------------*/
+void print_usage(const char* programName) noexcept
+{
+    std::cout
+        << "Usage: " << programName << " [options]\n"
+        << "\nMeasures the error of LightMath functions, in units of least precision (ULP),"
+        << "\nagainst a long double reference. One-argument functions are evaluated at every"
+        << "\nsingle-precision input, two-argument functions over a dense grid. Results are"
+        << "\nwritten as JSON."
+        << "\n\nOptions:"
+        << "\n\t-o, --out <file>        Output file path (default: stdout)."
+        << "\n\t-f, --functions <list>  Comma-separated functions to measure (default: all)."
+        << "\n\t                        sin, cos, tan, asin, acos, atan, exp, exp2, log, log2,"
+        << "\n\t                        sqrt, inversesqrt, rcp, atan2, pow."
+        << "\n\t-T, --tiers <list>      Comma-separated accuracy tiers (default: all)."
+        << "\n\t                        default, fast, balanced, precise."
+        << "\n\t-V, --variants <list>   Comma-separated variants (default: all)."
+        << "\n\t                        scalar, vec4."
+        << "\n\t-s, --step <n>          Evaluate every Nth bit pattern of one-argument functions"
+        << "\n\t                        (default: 1, exhaustive)."
+        << "\n\t-g, --grid <n>          Samples per axis of two-argument functions, in addition"
+        << "\n\t                        to special values (default: 4096)."
+        << "\n\t-t, --threads <n>       Number of compute threads (default: all cores)."
+        << "\n\t--help                  Print this message."
+        << std::endl;
+}
+
+
+
+/*-------------------------------------
+    Parse a comma-separated list of names
+-------------------------------------*/
+bool parse_list(const char* arg, bool* outFlags, const char* const* names, std::size_t numNames) noexcept
+{
+    std::fill(outFlags, outFlags + numNames, false);
+
+    while (*arg)
+    {
+        const char* end = std::strchr(arg, ',');
+        const std::size_t len = end ? (std::size_t)(end - arg) : std::strlen(arg);
+        bool found = false;
+
+        for (std::size_t i = 0; i < numNames; ++i)
+        {
+            if (std::strlen(names[i]) == len && !std::strncmp(arg, names[i], len))
+            {
+                outFlags[i] = true;
+                found = true;
+            }
+        }
+
+        if (!found)
+        {
+            return false;
+        }
+
+        arg += len + (end ? 1 : 0);
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+    Parse command-line arguments
+-------------------------------------*/
+int parse_args(int argc, char** argv, UlpArgs& args) noexcept
+{
+    const char* functionNames[NUM_FUNCTIONS];
+    for (std::size_t i = 0; i < NUM_FUNCTIONS; ++i)
+    {
+        functionNames[i] = FUNCTIONS[i].name;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* opt = argv[i];
+
+        if (!std::strcmp(opt, "--help"))
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for option " << opt << std::endl;
+            return -1;
+        }
+
+        const char* val = argv[++i];
+        bool valid = true;
+
+        if (!std::strcmp(opt, "-o") || !std::strcmp(opt, "--out"))
+        {
+            args.outFile = val;
+        }
+        else if (!std::strcmp(opt, "-f") || !std::strcmp(opt, "--functions"))
+        {
+            valid = parse_list(val, args.functions, functionNames, NUM_FUNCTIONS);
+        }
+        else if (!std::strcmp(opt, "-T") || !std::strcmp(opt, "--tiers"))
+        {
+            valid = parse_list(val, args.tiers, TIER_NAMES, TIER_COUNT);
+        }
+        else if (!std::strcmp(opt, "-V") || !std::strcmp(opt, "--variants"))
+        {
+            valid = parse_list(val, args.variants, VARIANT_NAMES, VARIANT_COUNT);
+        }
+        else if (!std::strcmp(opt, "-s") || !std::strcmp(opt, "--step"))
+        {
+            args.step = std::strtoull(val, nullptr, 10);
+            valid = args.step > 0;
+        }
+        else if (!std::strcmp(opt, "-g") || !std::strcmp(opt, "--grid"))
+        {
+            args.gridSize = (unsigned)std::strtoul(val, nullptr, 10);
+            valid = args.gridSize > 1;
+        }
+        else if (!std::strcmp(opt, "-t") || !std::strcmp(opt, "--threads"))
+        {
+            args.numThreads = (unsigned)std::strtoul(val, nullptr, 10);
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << opt << std::endl;
+            return -1;
+        }
+
+        if (!valid)
+        {
+            std::cerr << "Invalid value for option " << opt << ": " << val << std::endl;
+            return -1;
+        }
+    }
+
+    args.numThreads = math::parallel_thread_count(args.numThreads);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Measurement
+-----------------------------------------------------------------------------*/
+constexpr std::size_t CHUNK_SIZE = 1u << 16u;
+
+struct ChunkBuffers
+{
+    std::unique_ptr<float[]> x{new float[CHUNK_SIZE]};
+    std::unique_ptr<float[]> y{new float[CHUNK_SIZE]};
+    std::unique_ptr<float[]> ref{new float[CHUNK_SIZE]};
+    std::unique_ptr<float[]> out{new float[CHUNK_SIZE]};
+    std::unique_ptr<InputClass[]> inputClass{new InputClass[CHUNK_SIZE]};
+};
+
+struct Implementation
+{
+    Tier tier;
+    Variant variant;
+    ScalarFunc scalar;
+    VectorFunc vector;
+};
+
+
+
+/*-------------------------------------
+    Evaluate all implementations of a function over one chunk of inputs
+-------------------------------------*/
+void evaluate_chunk(
+    const MathFunction& func,
+    const std::vector<Implementation>& impls,
+    ChunkBuffers& buffers,
+    std::size_t count,
+    UlpStats* outStats) noexcept
+{
+    const float* const x = buffers.x.get();
+    const float* const y = buffers.y.get();
+    float* const ref = buffers.ref.get();
+    float* const out = buffers.out.get();
+    InputClass* const inputClass = buffers.inputClass.get();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ref[i] = (float)func.reference((long double)x[i], (long double)y[i]);
+        inputClass[i] = classify(x[i]);
+
+        if (func.arity > 1)
+        {
+            inputClass[i] = (InputClass)math::max((unsigned)inputClass[i], (unsigned)classify(y[i]));
+        }
+    }
+
+    for (std::size_t f = 0; f < impls.size(); ++f)
+    {
+        const Implementation& impl = impls[f];
+
+        if (impl.variant == VARIANT_SCALAR)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                out[i] = impl.scalar(x[i], y[i]);
+            }
+        }
+        else
+        {
+            // Chunks are always a multiple of 4 elements except for the
+            // final one, so inputs are padded by repeating the last element
+            for (std::size_t i = 0; i < count; i += 4)
+            {
+                math::vec4f vx, vy;
+                for (std::size_t j = 0; j < 4; ++j)
+                {
+                    const std::size_t k = math::min(i + j, count - 1);
+                    vx[j] = x[k];
+                    vy[j] = y[k];
+                }
+
+                const math::vec4f v = impl.vector(vx, vy);
+                for (std::size_t j = 0; j < 4 && i + j < count; ++j)
+                {
+                    out[i + j] = v[j];
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            accumulate(outStats[f], x[i], y[i], inputClass[i], out[i], ref[i]);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+    Generate the samples along one axis of a 2D grid
+-------------------------------------*/
+std::vector<float> grid_axis(float lo, float hi, unsigned count) noexcept
+{
+    const float specials[] = {
+        0.f, -0.f, 1.f, -1.f,
+        std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    std::vector<float> ret;
+    ret.reserve(count + sizeof(specials) / sizeof(float));
+
+    // Samples are evenly spaced in ULP, rather than by value, so every
+    // binade within the range is covered
+    const int64_t oLo = float_ordinal(lo);
+    const int64_t oHi = float_ordinal(hi);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        ret.push_back(ordinal_float(oLo + (int64_t)((long double)(oHi - oLo) * (long double)i / (long double)(count - 1))));
+    }
+
+    for (float f : specials)
+    {
+        ret.push_back(f);
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+    Measure a function
+-------------------------------------*/
+std::vector<UlpStats> measure_function(const MathFunction& func, const std::vector<Implementation>& impls, const UlpArgs& args) noexcept
+{
+    const unsigned numThreads = args.numThreads;
+    std::vector<ChunkBuffers> buffers(numThreads);
+    std::vector<std::vector<UlpStats>> threadStats(numThreads, std::vector<UlpStats>(impls.size()));
+
+    if (func.arity == 1)
+    {
+        const uint64_t numSamples = ((1ull << 32ull) + args.step - 1) / args.step;
+        const std::size_t numChunks = (std::size_t)((numSamples + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+        math::parallel_for(numChunks, numThreads, [&](std::size_t chunkId, unsigned threadId)->void
+        {
+            ChunkBuffers& b = buffers[threadId];
+            const uint64_t first = (uint64_t)chunkId * CHUNK_SIZE;
+            const std::size_t count = (std::size_t)math::min<uint64_t>(CHUNK_SIZE, numSamples - first);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const uint32_t bits = (uint32_t)((first + i) * args.step);
+                std::memcpy(b.x.get() + i, &bits, sizeof(float));
+                b.y[i] = 0.f;
+            }
+
+            evaluate_chunk(func, impls, b, count, threadStats[threadId].data());
+        });
+    }
+    else
+    {
+        const std::vector<float> xs = grid_axis(func.xLo, func.xHi, args.gridSize);
+        const std::vector<float> ys = grid_axis(func.yLo, func.yHi, args.gridSize);
+
+        math::parallel_for(xs.size(), numThreads, [&](std::size_t row, unsigned threadId)->void
+        {
+            ChunkBuffers& b = buffers[threadId];
+
+            for (std::size_t first = 0; first < ys.size(); first += CHUNK_SIZE)
+            {
+                const std::size_t count = math::min<std::size_t>(CHUNK_SIZE, ys.size() - first);
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    b.x[i] = xs[row];
+                    b.y[i] = ys[first + i];
+                }
+
+                evaluate_chunk(func, impls, b, count, threadStats[threadId].data());
+            }
+        });
+    }
+
+    std::vector<UlpStats> ret(impls.size());
+    for (const std::vector<UlpStats>& s : threadStats)
+    {
+        for (std::size_t i = 0; i < impls.size(); ++i)
+        {
+            ret[i].merge(s[i]);
+        }
+    }
+
+    return ret;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    JSON Output
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+    Write a float, using strings for values JSON can not represent
+-------------------------------------*/
+void write_float(std::FILE* f, float x) noexcept
+{
+    if (std::isnan(x))
+    {
+        std::fputs("\"nan\"", f);
+    }
+    else if (std::isinf(x))
+    {
+        std::fputs(x < 0.f ? "\"-inf\"" : "\"inf\"", f);
+    }
+    else
+    {
+        std::fprintf(f, "%.9g", (double)x);
+    }
+}
+
+
+
+/*-------------------------------------
+    Write the results of one implementation
+-------------------------------------*/
+void write_result(std::FILE* f, const MathFunction& func, const Implementation& impl, const UlpStats& s, double seconds) noexcept
+{
+    const double meanUlp = s.samples ? (double)(s.sumUlp / (long double)s.samples) : 0.0;
+
+    std::fprintf(f, "    {\n");
+    std::fprintf(f, "      \"function\": \"%s\",\n", func.name);
+    std::fprintf(f, "      \"tier\": \"%s\",\n", TIER_NAMES[impl.tier]);
+    std::fprintf(f, "      \"variant\": \"%s\",\n", VARIANT_NAMES[impl.variant]);
+    std::fprintf(f, "      \"samples\": %llu,\n", (unsigned long long)(s.samples + s.nanMismatches));
+    std::fprintf(f, "      \"max_ulp\": %llu,\n", (unsigned long long)s.maxUlp);
+    std::fprintf(f, "      \"max_ulp_input\": [");
+    write_float(f, s.maxUlpX);
+
+    if (func.arity > 1)
+    {
+        std::fputs(", ", f);
+        write_float(f, s.maxUlpY);
+    }
+
+    std::fprintf(f, "],\n");
+    std::fprintf(f, "      \"mean_ulp\": %.6g,\n", meanUlp);
+    std::fprintf(f, "      \"nan_mismatches\": %llu,\n", (unsigned long long)s.nanMismatches);
+    std::fprintf(f, "      \"zero_sign_mismatches\": %llu,\n", (unsigned long long)s.signMismatches);
+    std::fprintf(f, "      \"seconds\": %.3f,\n", seconds);
+    std::fprintf(f, "      \"histogram\": [\n");
+
+    for (unsigned i = 0; i < NUM_HISTOGRAM_BUCKETS; ++i)
+    {
+        const unsigned long long lo = (i < 2) ? i : (1ull << (i - 2)) + 1ull;
+        const char* const sep = (i + 1 < NUM_HISTOGRAM_BUCKETS) ? "," : "";
+
+        if (i + 1 < NUM_HISTOGRAM_BUCKETS)
+        {
+            const unsigned long long hi = i ? (1ull << (i - 1)) : 0ull;
+            std::fprintf(f, "        {\"min_ulp\": %llu, \"max_ulp\": %llu, \"count\": %llu}%s\n", lo, hi, (unsigned long long)s.histogram[i], sep);
+        }
+        else
+        {
+            std::fprintf(f, "        {\"min_ulp\": %llu, \"max_ulp\": null, \"count\": %llu}%s\n", lo, (unsigned long long)s.histogram[i], sep);
+        }
+    }
+
+    std::fprintf(f, "      ],\n");
+    std::fprintf(f, "      \"inputs\": {\n");
+
+    for (unsigned i = 0; i < INPUT_CLASS_COUNT; ++i)
+    {
+        const ClassStats& cs = s.classes[i];
+        std::fprintf(
+            f,
+            "        \"%s\": {\"samples\": %llu, \"max_ulp\": %llu, \"nan_mismatches\": %llu, \"zero_sign_mismatches\": %llu}%s\n",
+            INPUT_CLASS_NAMES[i],
+            (unsigned long long)cs.samples,
+            (unsigned long long)cs.maxUlp,
+            (unsigned long long)cs.nanMismatches,
+            (unsigned long long)cs.signMismatches,
+            (i + 1 < INPUT_CLASS_COUNT) ? "," : "");
+    }
+
+    std::fprintf(f, "      }\n");
+    std::fprintf(f, "    }");
+}
+
+
+
+/*-----------------------------------------------------------------------------
+    Main
+-----------------------------------------------------------------------------*/
+int main(int argc, char** argv)
+{
+    UlpArgs args;
+    const int argStatus = parse_args(argc, argv, args);
+    if (argStatus)
+    {
+        return argStatus > 0 ? 0 : -1;
+    }
+
+    std::FILE* f = args.outFile ? std::fopen(args.outFile, "w") : stdout;
+    if (!f)
+    {
+        std::cerr << "Unable to open " << args.outFile << " for writing." << std::endl;
+        return -1;
+    }
+
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"reference\": \"long double\",\n");
+    std::fprintf(f, "  \"step\": %llu,\n", (unsigned long long)args.step);
+    std::fprintf(f, "  \"grid\": %u,\n", args.gridSize);
+    std::fprintf(f, "  \"threads\": %u,\n", args.numThreads);
+    std::fprintf(f, "  \"results\": [\n");
+
+    bool firstResult = true;
+
+    for (std::size_t funcId = 0; funcId < NUM_FUNCTIONS; ++funcId)
+    {
+        const MathFunction& func = FUNCTIONS[funcId];
+        if (!args.functions[funcId])
+        {
+            continue;
+        }
+
+        std::vector<Implementation> impls;
+        for (unsigned t = 0; t < TIER_COUNT; ++t)
+        {
+            if (!args.tiers[t])
+            {
+                continue;
+            }
+
+            if (args.variants[VARIANT_SCALAR] && func.scalar[t])
+            {
+                impls.push_back(Implementation{(Tier)t, VARIANT_SCALAR, func.scalar[t], nullptr});
+            }
+
+            if (args.variants[VARIANT_VEC4] && func.vector[t])
+            {
+                impls.push_back(Implementation{(Tier)t, VARIANT_VEC4, nullptr, func.vector[t]});
+            }
+        }
+
+        if (impls.empty())
+        {
+            continue;
+        }
+
+        std::cerr << "Measuring " << func.name << "()..." << std::flush;
+
+        const hr_time t0 = chrono::steady_clock::now();
+        const std::vector<UlpStats> stats = measure_function(func, impls, args);
+        const double seconds = chrono::duration_cast<hr_prec>(chrono::steady_clock::now() - t0).count();
+
+        std::cerr << " done (" << seconds << "s)" << std::endl;
+
+        for (std::size_t i = 0; i < impls.size(); ++i)
+        {
+            if (!firstResult)
+            {
+                std::fprintf(f, ",\n");
+            }
+
+            write_result(f, func, impls[i], stats[i], seconds);
+            firstResult = false;
+        }
+    }
+
+    std::fprintf(f, "\n  ]\n}\n");
+
+    if (f != stdout)
+    {
+        std::fclose(f);
+    }
+
+    return 0;
+}